@@ -46,6 +46,27 @@ EbBool is a 32 bit quantity and is aligned on a 32 bit word boundary.
 #define EB_FALSE  0
 #define EB_TRUE   1
 
+#define EB_FRAME_STATS_STAGE_COUNT      8
+
+    // Statistics of an output frame, see EbSvtAv1EncConfiguration::frame_stats.
+    //   Times are in microseconds from the arrival of the input picture.
+    typedef struct EbSvtFrameStats
+    {
+        uint64_t picture_number;        // display order
+        uint64_t decode_order;
+        uint32_t temporal_layer;
+        uint32_t qp;
+        uint64_t bits;                  // bits of the frame, all its parts, show existing header included
+        uint64_t latency;               // until the packet is output
+        // end of each stage: picture analysis, picture decision, motion estimation,
+        //   rate control, encdec, loop filters, entropy coding, packetization
+        uint64_t stage_time[EB_FRAME_STATS_STAGE_COUNT];
+        // frame_stats 2 only, else 0: sum of squared errors and PSNR of the Y, Cb and
+        //   Cr planes of the reconstructed frame, PSNR capped at 100 dB
+        uint64_t sse[3];
+        double   psnr[3];
+    } EbSvtFrameStats;
+
     typedef struct EbBufferHeaderType
     {
         // EbBufferHeaderType size
@@ -71,6 +92,10 @@ EbBool is a 32 bit quantity and is aligned on a 32 bit word boundary.
 
         // pic flags
         uint32_t flags;
+
+        // statistics of the frame, on the output packets holding a frame or its last
+        //   part when frame_stats is on, else NULL. Valid until the packet is released.
+        EbSvtFrameStats *frame_stats;
     } EbBufferHeaderType;
 
     typedef struct EbComponentType
@@ -99,6 +124,8 @@ EbBool is a 32 bit quantity and is aligned on a 32 bit word boundary.
 
 #define EB_BUFFERFLAG_EOS           0x00000001  // signals the last packet of the stream
 #define EB_BUFFERFLAG_SHOW_EXT      0x00000002  // signals that the packet contains a show existing frame at the end
+#define EB_BUFFERFLAG_FRAME_PART    0x00000004  // signals that the packet holds a part of a frame: its headers or one tile group
+#define EB_BUFFERFLAG_FRAME_END     0x00000008  // signals the last part of a frame
 
     // For 8-bit and 10-bit packed inputs, the luma, cb, and cr fields should be used
     //   for the three input picture planes.  However, for 10-bit unpacked planes the
@@ -122,6 +149,64 @@ EbBool is a 32 bit quantity and is aligned on a 32 bit word boundary.
 
     } EbSvtEncInput;
 
+    // Plane layout of the pictures read in place by eb_svt_enc_send_picture_zero_copy.
+    //   luma, cb and cr point to the first sample of the picture, the padding around
+    //   each plane must be writable as the library extends the picture into it.
+    typedef struct EbSvtInputLayout
+    {
+        uint32_t left_padding;          // luma samples on each side of the picture, halved for chroma
+        uint32_t right_padding;
+        uint32_t top_padding;           // luma rows above and below the picture, halved for chroma
+        uint32_t bot_padding;
+        uint32_t luma_stride;           // required yStride
+        uint32_t chroma_stride;         // required cbStride and crStride
+        uint32_t alignment;             // byte alignment of the first padding sample of each plane
+    } EbSvtInputLayout;
+
+    // Called once the library no longer reads the planes of a zero copy input,
+    //   from one of the encoder threads.
+    typedef void (*EbInputReleaseCallback)(
+        void                *release_ctx,
+        EbBufferHeaderType  *p_buffer);
+
+    // Memory and OS objects held by one encoder instance
+    typedef struct EbSvtMemoryUsage
+    {
+        uint64_t total_lib_memory;      // bytes allocated by the library for this instance
+        uint32_t malloc_count;
+        uint32_t thread_count;
+        uint32_t semaphore_count;
+        uint32_t mutex_count;
+        uint64_t local_memory;          // resident bytes on the NUMA nodes the instance runs on (Linux)
+        uint64_t remote_memory;         // resident bytes on the other nodes (Linux)
+    } EbSvtMemoryUsage;
+
+#define EB_MAX_PIPELINE_STAGE_COUNT     16
+
+    // Profile of one pipeline stage, cumulated since eb_init_encoder. Times are in
+    //   microseconds, summed over the threads of the stage.
+    typedef struct EbSvtStageStats
+    {
+        const char *name;
+        uint32_t    thread_count;
+        uint64_t    task_count;         // objects taken from the input fifo
+        uint64_t    busy_time;          // processing, output wait excluded
+        uint64_t    input_wait_time;    // blocked on an empty input fifo
+        uint64_t    output_wait_time;   // blocked on an empty buffer of the next stage
+        uint32_t    fifo_depth;         // objects in the input fifo now
+        uint32_t    fifo_depth_max;
+        double      fifo_depth_mean;    // sampled on each object posted
+    } EbSvtStageStats;
+
+    typedef struct EbSvtPipelineStats
+    {
+        uint64_t        elapsed_time;   // microseconds since eb_init_encoder
+        uint32_t        stage_count;
+        EbSvtStageStats stage[EB_MAX_PIPELINE_STAGE_COUNT];
+        uint64_t        rate_table_hits;    // pictures finding their MD rate tables estimated
+        uint64_t        rate_table_misses;  // pictures estimating them
+    } EbSvtPipelineStats;
+
 // Will contain the EbEncApi which will live in the EncHandle class
 // Only modifiable during config-time.
 typedef struct EbSvtAv1EncConfiguration
@@ -184,6 +269,38 @@ typedef struct EbSvtAv1EncConfiguration
      *
      * Default is 0. */
     uint32_t                 base_layer_switch_mode;
+    /* Latency mode.
+     *
+     * 0 = normal latency.
+     * 1 = low latency: the pictures are coded in display order with a flat
+     *     prediction structure, no look-ahead and no scene change detection.
+     * 2 = same as 1, with a single tile, and each superblock row leaves the
+     *     encdec for the entropy coder as soon as it is coded, while the rest
+     *     of the picture is still being encoded. The other stages still hand
+     *     the pictures over whole. The superblock syntax cannot wait for the
+     *     in-loop filters, so loop restoration is turned off and CDEF signals
+     *     a single strength per frame, at some cost in quality.
+     *
+     * Default is 0. */
+    uint32_t                 low_latency;
+
+    /* Output each frame in parts as soon as they are coded: a first packet
+     * with the temporal unit, sequence and frame headers, then one packet per
+     * tile, in tile order, holding a tile group OBU. Every part is flagged
+     * EB_BUFFERFLAG_FRAME_PART and the last one EB_BUFFERFLAG_FRAME_END; the
+     * concatenation of the parts is the temporal unit of the frame.
+     *
+     * Default is 0. */
+    EbBool                   tile_group_output;
+
+    /* Frame context adaptation: each reference frame keeps the CDFs adapted
+     * over its first tile, and the frames after it start their entropy coding
+     * from the CDFs kept by one of their references, signalled as the primary
+     * reference frame, instead of the default CDFs. The entropy coding of a
+     * frame only waits for the first tile of that reference.
+     *
+     * Default is 0. */
+    EbBool                   frame_context_adaptation;
 
     // Input Info
     /* The width of input source in units of picture luma pixels.
@@ -254,6 +371,19 @@ typedef struct EbSvtAv1EncConfiguration
     * Default is 4. */
     uint32_t                 partition_depth;
 
+    // Tiles
+    /* Log2 of the number of tile columns. The value is clipped to the range
+    * allowed by the picture width, each tile column being coded in its own
+    * entropy coding task.
+    *
+    * Default is 0. */
+    uint32_t                 tile_columns;
+    /* Log2 of the number of tile rows, clipped to the range allowed by the
+    * picture height.
+    *
+    * Default is 0. */
+    uint32_t                 tile_rows;
+
     // Quantization
     /* Initial quantization parameter for the Intra pictures used under constant
      * qp rate control mode.
@@ -277,6 +407,15 @@ typedef struct EbSvtAv1EncConfiguration
      * Default is 0. */
     EbBool                   disable_dlf_flag;
 
+    /* Method picking the deblocking filter levels of each picture.
+     *
+     * 0 = search, the picture is filtered and measured at each trial level.
+     * 1 = same search over every other superblock row.
+     * 2 = levels predicted from the quantizer and the frame type, no trial.
+     *
+     * Default is 0. */
+    uint32_t                 loop_filter_search;
+
     /* Denoise the input picture when noise levels are too high
     * Flag to enable the denoising
     *
@@ -367,6 +506,7 @@ typedef struct EbSvtAv1EncConfiguration
      *
      * 0 = Constant QP.
      * 1 = Average BitRate.
+     * 2 = Constant BitRate, with a decoder buffer (VBV) model and no look ahead.
      *
      * Default is 0. */
     uint32_t                 rate_control_mode;
@@ -382,7 +522,7 @@ typedef struct EbSvtAv1EncConfiguration
     uint32_t                 look_ahead_distance;
 
     /* Target bitrate in bits/second, only apllicable when rate control mode is
-     * set to 1.
+     * set to 1 or 2.
      *
      * Default is 7000000. */
     uint32_t                 target_bit_rate;
@@ -396,6 +536,17 @@ typedef struct EbSvtAv1EncConfiguration
      *
      * Default is 0. */
     uint32_t                 min_qp_allowed;
+    /* Size in bits of the decoder buffer (VBV) of the constant bitrate mode. No
+     * frame is larger than the buffer level when it is decoded, and the QP steers
+     * the level back to its initial value. 0 means one second of target_bit_rate.
+     *
+     * Default is 0. */
+    uint32_t                 vbv_buffer_size;
+    /* Level of the decoder buffer when the first frame is decoded, in percent of
+     * vbv_buffer_size.
+     *
+     * Default is 90. */
+    uint32_t                 vbv_initial_fullness;
 
     // Tresholds
     /* Flag to signal that the input yuv is HDR10 BT2020 using SMPTE ST2048, requires
@@ -458,6 +609,44 @@ typedef struct EbSvtAv1EncConfiguration
     *
     * Default is 1. */
     uint32_t                 asm_type;
+
+    // Threads management
+
+    /* Total number of threads given to the parallel stages of the encoder
+    * (picture analysis, motion estimation, source based operations, mode
+    * decision configuration, encdec, loop filter and entropy coding). The
+    * budget is split across the stages following their relative cost, each
+    * stage getting at least one thread, so it must cover one thread per
+    * stage plus the per stage thread counts.
+    *
+    * 0 = default stage sizes, derived from the number of logical cores.
+    *
+    * Default is 0. */
+    uint32_t                 thread_count;
+    /* Number of threads of one parallel stage, taken out of thread_count
+    * before the remaining budget is split across the other stages.
+    *
+    * 0 = share of thread_count.
+    *
+    * Default is 0. */
+    uint32_t                 picture_analysis_thread_count;
+    uint32_t                 motion_estimation_thread_count;
+    uint32_t                 source_based_operations_thread_count;
+    uint32_t                 mode_decision_configuration_thread_count;
+    uint32_t                 enc_dec_thread_count;
+    uint32_t                 filter_thread_count;
+    uint32_t                 entropy_coding_thread_count;
+    /* Run the kernels as tasks of a pool of worker threads shared by all the
+    * encoder instances of the process instead of dedicated threads. Idle
+    * workers steal the queued tasks of the busy ones, and a kernel waiting
+    * for input leaves its worker to another task. The pool is created by
+    * the first instance with thread_count workers (number of logical cores
+    * when 0), and each stage without a thread count of its own gets as many
+    * tasks as the pool has workers.
+    *
+    * Default is 0. */
+    EbBool                   use_thread_pool;
+
     // Application Specific parameters
 
     /* ID assigned to each channel when multiple instances are running within the
@@ -467,6 +656,16 @@ typedef struct EbSvtAv1EncConfiguration
 
     uint32_t                 stat_report;
 
+    /* Statistics attached to each output packet in EbBufferHeaderType::frame_stats.
+     *
+     * 0 = off, nothing is measured.
+     * 1 = picture number, temporal layer, QP, bits and stage times.
+     * 2 = same as 1, plus SSE and PSNR per plane. Every picture is then
+     *     reconstructed and loop filtered, references or not.
+     *
+     * Default is 0. */
+    uint32_t                 frame_stats;
+
     /* Flag to enable the Speed Control functionality to achieve the real-time
     * encoding speed defined by dynamically changing the encoding preset to meet
     * the average speed defined in injectorFrameRate. When this parameter is set
@@ -479,8 +678,29 @@ typedef struct EbSvtAv1EncConfiguration
     *
     * Default is 60. */
     int32_t                  injector_frame_rate;
+
+    /* Spread the channels over the processor groups on Windows, over the NUMA
+    * nodes on Linux (channel_id modulo the node count) when target_socket is
+    * -1 and no cpu_list is given.
+    *
+    * Default is 0. */
     EbBool                   use_round_robin_thread_assignment;
 
+    /* Linux only: NUMA node the channel runs on. eb_init_encoder builds the
+    * channel from the CPUs of the node, so its buffers are first touched in
+    * the node's memory and its kernel threads stay on the node. -1 leaves the
+    * placement to the OS. The workers of a shared thread pool are not pinned.
+    *
+    * Default is -1. */
+    int32_t                  target_socket;
+
+    /* Linux only: CPUs the channel runs on, as a list of ranges such as
+    * "0-7,16-23". Takes precedence over target_socket. The string is read by
+    * eb_init_encoder.
+    *
+    * Default is NULL. */
+    const char              *cpu_list;
+
     // Debug tools
 
     /* Output reconstructed yuv used for debug purposes. The value is set through
@@ -548,6 +768,29 @@ typedef struct EbSvtAv1EncConfiguration
         EbComponentType      *svt_enc_component,
         EbBufferHeaderType   *p_buffer);
 
+    /* STEP 4 (alternative): Send the picture without copying it.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *p_buffer           Header pointer, picture buffer laid out as returned by eb_svt_enc_get_input_layout.
+     * @ release_cb          Called once the picture buffer can be reused, p_buffer must stay valid until then.
+     * @ *release_ctx        Passed back to release_cb.
+     * Inputs that do not match the layout, and 10 bit inputs, are copied and released before the call returns. */
+    EB_API EbErrorType eb_svt_enc_send_picture_zero_copy(
+        EbComponentType        *svt_enc_component,
+        EbBufferHeaderType     *p_buffer,
+        EbInputReleaseCallback  release_cb,
+        void                   *release_ctx);
+
+    /* Layout of the pictures accepted by eb_svt_enc_send_picture_zero_copy, valid after eb_svt_enc_set_parameter.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *layout             Returned plane layout. */
+    EB_API EbErrorType eb_svt_enc_get_input_layout(
+        EbComponentType      *svt_enc_component,
+        EbSvtInputLayout     *layout);
+
     /* STEP 5: Receive packet.
      * Parameter:
     * @ *svt_enc_component  Encoder handler.
@@ -559,6 +802,17 @@ typedef struct EbSvtAv1EncConfiguration
         EbBufferHeaderType  **p_buffer,
         uint8_t                pic_send_done);
 
+    /* STEP 5 (alternative): Receive packet, waiting for one.
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ **p_buffer          Header pointer to return packet with.
+     * @ timeout_ms          Longest wait for a packet, in milliseconds.
+     * Blocking call, returns EB_ErrorMax for an encode error, EB_NoErrorEmptyQueue when no packet came within timeout_ms.*/
+    EB_API EbErrorType eb_svt_get_packet_timeout(
+        EbComponentType      *svt_enc_component,
+        EbBufferHeaderType  **p_buffer,
+        uint32_t              timeout_ms);
+
     /* STEP 5-1: Release output buffer back into the pool.
      *
      * Parameter:
@@ -575,6 +829,44 @@ typedef struct EbSvtAv1EncConfiguration
         EbComponentType      *svt_enc_component,
         EbBufferHeaderType   *p_buffer);
 
+    /* OPTIONAL: Get the memory and the OS objects (threads, semaphores, mutexes)
+     * held by the encoder instance. Each handle tracks its own allocations, so
+     * several handles can live in one process. On Linux, the pages of the
+     * allocations are looked up to split them between local and remote NUMA
+     * memory, which takes a few milliseconds per GB.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *usage_ptr          Filled with the counters of the instance. */
+    EB_API EbErrorType eb_svt_get_memory_usage(
+        EbComponentType      *svt_enc_component,
+        EbSvtMemoryUsage     *usage_ptr);
+
+    /* OPTIONAL: Get the profile of the pipeline stages, in pipeline order. The
+     * counters are kept up to date by the library at all times, a caller wanting
+     * a profile over an interval takes the difference of two calls. A stage with
+     * little busy time and much input wait is starved by the stages before it;
+     * output wait means the stage after it is the bottleneck.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *stats_ptr          Filled with the counters of the instance. */
+    EB_API EbErrorType eb_svt_get_pipeline_stats(
+        EbComponentType      *svt_enc_component,
+        EbSvtPipelineStats   *stats_ptr);
+
+    /* OPTIONAL: End the current stream and get the handle ready for the next
+     * one with the same configuration, keeping the kernel threads and the
+     * buffer pools. An EOS is sent if the caller did not send one, then the
+     * pipeline is drained; packets and recon pictures not retrieved yet are
+     * dropped. All the packets retrieved must have been released and no
+     * picture may be sent while the call runs.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler. */
+    EB_API EbErrorType eb_svt_enc_reset(
+        EbComponentType *svt_enc_component);
+
     /* STEP 6: Deinitialize encoder library.
      *
      * Parameter:
@@ -46,12 +46,20 @@
 #define PROFILE_TOKEN                   "-profile"
 #define TIER_TOKEN                      "-tier"
 #define LEVEL_TOKEN                     "-level"
-#define LATENCY_MODE                    "-latency-mode" // no Eval
+#define LATENCY_MODE                    "-latency-mode"
+#define STATS_INTERVAL_TOKEN            "-stats-interval"
+#define FRAME_STATS_TOKEN               "-frame-stats"
+#define STATS_FILE_TOKEN                "-stats-file"
 #define FILM_GRAIN_TOKEN                "-film-grain"
 #define INTERLACED_VIDEO_TOKEN          "-interlaced-video"
 #define SEPERATE_FILDS_TOKEN            "-separate-fields"
 #define INTRA_REFRESH_TYPE_TOKEN        "-irefresh-type" // no Eval
 #define LOOP_FILTER_DISABLE_TOKEN       "-dlf"
+#define LOOP_FILTER_SEARCH_TOKEN        "-dlf-search"
+#define TILE_COLUMNS_TOKEN              "-tile-columns"
+#define TILE_ROWS_TOKEN                 "-tile-rows"
+#define TILE_GROUP_OUTPUT_TOKEN         "-tile-group-output"
+#define FRAME_CONTEXT_ADAPTATION_TOKEN  "-frame-ctx-adapt"
 #define LOCAL_WARPED_ENABLE_TOKEN       "-local-warp"
 #define USE_DEFAULT_ME_HME_TOKEN        "-use-default-me-hme"
 #define HME_ENABLE_TOKEN                "-hme"
@@ -86,6 +94,8 @@
 #define TARGET_BIT_RATE_TOKEN           "-tbr"
 #define MAX_QP_TOKEN                    "-max-qp"
 #define MIN_QP_TOKEN                    "-min-qp"
+#define VBV_BUFFER_SIZE_TOKEN           "-vbv-bufsize"
+#define VBV_INITIAL_FULLNESS_TOKEN      "-vbv-init"
 #define TEMPORAL_ID                        "-temporal-id" // no Eval
 #define LOOK_AHEAD_DIST_TOKEN           "-lad"
 #define SUPER_BLOCK_SIZE_TOKEN          "-sb-size"
@@ -94,8 +104,11 @@
 #define INJECTOR_FRAMERATE_TOKEN        "-inj-frm-rt" // no Eval
 #define SPEED_CONTROL_TOKEN             "-speed-ctrl"
 #define ASM_TYPE_TOKEN                  "-asm"
+#define THREAD_COUNT_TOKEN              "-thread-count"
+#define THREAD_POOL_TOKEN               "-thread-pool"
 #define RR_THREAD_MGMNT                    "-rr"
 #define TARGET_SOCKET                    "-ss"
+#define CPU_LIST_TOKEN                  "-cpu-list"
 #define CONFIG_FILE_COMMENT_CHAR    '#'
 #define CONFIG_FILE_NEWLINE_CHAR    '\n'
 #define CONFIG_FILE_RETURN_CHAR     '\r'
@@ -152,6 +165,11 @@ static void SetCfgReconFile                     (const char *value, EbConfig_t *
     if (cfg->reconFile) { fclose(cfg->reconFile); }
     FOPEN(cfg->reconFile,value, "wb");
 };
+static void SetCfgStatsFile                     (const char *value, EbConfig_t *cfg)
+{
+    if (cfg->statsFile) { fclose(cfg->statsFile); }
+    FOPEN(cfg->statsFile,value, "w");
+};
 static void SetCfgQpFile                        (const char *value, EbConfig_t *cfg)
 {
     if (cfg->qpFile) { fclose(cfg->qpFile); }
@@ -186,6 +204,11 @@ static void SetCfgQp                            (const char *value, EbConfig_t *
 static void SetCfgUseQpFile                     (const char *value, EbConfig_t *cfg) {cfg->use_qp_file = (EbBool)strtol(value, NULL, 0); };
 //static void SetCfgFilmGrain(const char *value, EbConfig_t *cfg) { cfg->film_grain_denoise_strength = strtol(value, NULL, 0); };  //not bool to enable possible algorithm extension in the future
 static void SetDisableDlfFlag                   (const char *value, EbConfig_t *cfg) {cfg->disable_dlf_flag = (EbBool)strtoul(value, NULL, 0);};
+static void SetLoopFilterSearch                 (const char *value, EbConfig_t *cfg) {cfg->loop_filter_search = (uint32_t)strtoul(value, NULL, 0);};
+static void SetTileColumns                      (const char *value, EbConfig_t *cfg) {cfg->tile_columns = strtoul(value, NULL, 0);};
+static void SetTileRows                         (const char *value, EbConfig_t *cfg) {cfg->tile_rows = strtoul(value, NULL, 0);};
+static void SetTileGroupOutput                  (const char *value, EbConfig_t *cfg) {cfg->tile_group_output = (EbBool)strtoul(value, NULL, 0);};
+static void SetFrameContextAdaptation           (const char *value, EbConfig_t *cfg) {cfg->frame_context_adaptation = (EbBool)strtoul(value, NULL, 0);};
 static void SetEnableLocalWarpedMotionFlag      (const char *value, EbConfig_t *cfg) {cfg->enable_warped_motion = (EbBool)strtoul(value, NULL, 0);};
 static void SetEnableHmeFlag                    (const char *value, EbConfig_t *cfg) {cfg->enableHmeFlag = (EbBool)strtoul(value, NULL, 0);};
 static void SetEnableHmeLevel0Flag              (const char *value, EbConfig_t *cfg) {cfg->enableHmeLevel0Flag = (EbBool)strtoul(value, NULL, 0);};
@@ -195,6 +218,8 @@ static void SetRateControlMode                  (const char *value, EbConfig_t *
 static void SetTargetBitRate                    (const char *value, EbConfig_t *cfg) {cfg->targetBitRate = strtoul(value, NULL, 0);};
 static void SetMaxQpAllowed                     (const char *value, EbConfig_t *cfg) {cfg->max_qp_allowed = strtoul(value, NULL, 0);};
 static void SetMinQpAllowed                     (const char *value, EbConfig_t *cfg) {cfg->min_qp_allowed = strtoul(value, NULL, 0);};
+static void SetVbvBufferSize                    (const char *value, EbConfig_t *cfg) {cfg->vbvBufferSize = strtoul(value, NULL, 0);};
+static void SetVbvInitialFullness               (const char *value, EbConfig_t *cfg) {cfg->vbvInitialFullness = strtoul(value, NULL, 0);};
 static void SetEnableHmeLevel1Flag              (const char *value, EbConfig_t *cfg) {cfg->enableHmeLevel1Flag  = (EbBool)strtoul(value, NULL, 0);};
 static void SetEnableHmeLevel2Flag              (const char *value, EbConfig_t *cfg) {cfg->enableHmeLevel2Flag  = (EbBool)strtoul(value, NULL, 0);};
 static void SetCfgSearchAreaWidth               (const char *value, EbConfig_t *cfg) {cfg->searchAreaWidth = strtoul(value, NULL, 0);};
@@ -242,8 +267,14 @@ static void SetInjectorFrameRate                (const char *value, EbConfig_t *
     }
 }
 static void SetLatencyMode                      (const char *value, EbConfig_t *cfg)  {cfg->latencyMode               = (uint8_t)strtol(value, NULL, 0);};
+static void SetStatsInterval                    (const char *value, EbConfig_t *cfg)  {cfg->statsInterval             = (uint32_t)strtoul(value, NULL, 0);};
+static void SetFrameStats                       (const char *value, EbConfig_t *cfg)  {cfg->frameStats                = (uint32_t)strtoul(value, NULL, 0);};
 static void SetAsmType                          (const char *value, EbConfig_t *cfg)  {cfg->asmType                  = (uint32_t)strtoul(value, NULL, 0);};
+static void SetThreadCount                      (const char *value, EbConfig_t *cfg)  {cfg->threadCount              = (uint32_t)strtoul(value, NULL, 0);};
+static void SetUseThreadPool                    (const char *value, EbConfig_t *cfg)  {cfg->useThreadPool            = (EbBool)strtoul(value, NULL, 0);};
 static void SetTargetSocket                     (const char *value, EbConfig_t *cfg)  {cfg->targetSocket              = (int32_t)strtol(value, NULL, 0);};
+static void SetUseRoundRobinThreadAssignment    (const char *value, EbConfig_t *cfg)  {cfg->useRoundRobinThreadAssignment = (EbBool)strtoul(value, NULL, 0);};
+static void SetCpuList                          (const char *value, EbConfig_t *cfg)  {EB_STRCPY(cfg->cpuList, sizeof(cfg->cpuList), value);};
 
 enum cfg_type{
     SINGLE_INPUT,   // Configuration parameters that have only 1 value input
@@ -304,9 +335,18 @@ config_entry_t config_entry[] = {
     { SINGLE_INPUT, TARGET_BIT_RATE_TOKEN, "TargetBitRate", SetTargetBitRate },
     { SINGLE_INPUT, MAX_QP_TOKEN, "MaxQpAllowed", SetMaxQpAllowed },
     { SINGLE_INPUT, MIN_QP_TOKEN, "MinQpAllowed", SetMinQpAllowed },
+    { SINGLE_INPUT, VBV_BUFFER_SIZE_TOKEN, "VbvBufferSize", SetVbvBufferSize },
+    { SINGLE_INPUT, VBV_INITIAL_FULLNESS_TOKEN, "VbvInitialFullness", SetVbvInitialFullness },
 
     // DLF
     { SINGLE_INPUT, LOOP_FILTER_DISABLE_TOKEN, "LoopFilterDisable", SetDisableDlfFlag },
+    { SINGLE_INPUT, LOOP_FILTER_SEARCH_TOKEN, "LoopFilterSearch", SetLoopFilterSearch },
+
+    // TILES
+    { SINGLE_INPUT, TILE_COLUMNS_TOKEN, "TileColumns", SetTileColumns },
+    { SINGLE_INPUT, TILE_ROWS_TOKEN, "TileRows", SetTileRows },
+    { SINGLE_INPUT, TILE_GROUP_OUTPUT_TOKEN, "TileGroupOutput", SetTileGroupOutput },
+    { SINGLE_INPUT, FRAME_CONTEXT_ADAPTATION_TOKEN, "FrameContextAdaptation", SetFrameContextAdaptation },
 
     // LOCAL WARPED MOTION
     { SINGLE_INPUT, LOCAL_WARPED_ENABLE_TOKEN, "LocalWarpedMotion", SetEnableLocalWarpedMotionFlag },
@@ -336,6 +376,8 @@ config_entry_t config_entry[] = {
     // Thread Management
 //    { SINGLE_INPUT, THREAD_MGMNT, "logicalProcessors", SetLogicalProcessors },
     { SINGLE_INPUT, TARGET_SOCKET, "TargetSocket", SetTargetSocket },
+    { SINGLE_INPUT, RR_THREAD_MGMNT, "UseRoundRobinThreadAssignment", SetUseRoundRobinThreadAssignment },
+    { SINGLE_INPUT, CPU_LIST_TOKEN, "CpuList", SetCpuList },
 
     // Optional Features
 
@@ -360,10 +402,17 @@ config_entry_t config_entry[] = {
     { SINGLE_INPUT, TIER_TOKEN, "Tier", SetTier },
     { SINGLE_INPUT, LEVEL_TOKEN, "Level", SetLevel },
     { SINGLE_INPUT, LATENCY_MODE, "LatencyMode", SetLatencyMode },
+    { SINGLE_INPUT, STATS_INTERVAL_TOKEN, "StatsInterval", SetStatsInterval },
+    { SINGLE_INPUT, FRAME_STATS_TOKEN, "FrameStats", SetFrameStats },
+    { SINGLE_INPUT, STATS_FILE_TOKEN, "StatsFile", SetCfgStatsFile },
 
     // Asm Type
     { SINGLE_INPUT, ASM_TYPE_TOKEN, "AsmType", SetAsmType },
 
+    // Thread Management
+    { SINGLE_INPUT, THREAD_COUNT_TOKEN, "ThreadCount", SetThreadCount },
+    { SINGLE_INPUT, THREAD_POOL_TOKEN, "UseThreadPool", SetUseThreadPool },
+
     // HME
     { ARRAY_INPUT,HME_LEVEL0_WIDTH, "HmeLevel0SearchAreaInWidth", SetHmeLevel0SearchAreaInWidthArray },
     { ARRAY_INPUT,HME_LEVEL0_HEIGHT, "HmeLevel0SearchAreaInHeight", SetHmeLevel0SearchAreaInHeightArray },
@@ -384,6 +433,7 @@ void EbConfigCtor(EbConfig_t *config_ptr)
     config_ptr->inputFile                            = NULL;
     config_ptr->bitstreamFile                        = NULL;
     config_ptr->reconFile                            = NULL;
+    config_ptr->statsFile                            = NULL;
     config_ptr->errorLogFile                         = stderr;
     config_ptr->qpFile                               = NULL;
 
@@ -401,6 +451,8 @@ void EbConfigCtor(EbConfig_t *config_ptr)
     config_ptr->bufferedInput                        = -1;
     config_ptr->sequenceBuffer                       = 0;
     config_ptr->latencyMode                          = 0;
+    config_ptr->statsInterval                        = 0;
+    config_ptr->frameStats                           = 0;
 
     // Interlaced Video
     config_ptr->interlacedVideo                      = EB_FALSE;
@@ -414,6 +466,8 @@ void EbConfigCtor(EbConfig_t *config_ptr)
     config_ptr->targetBitRate                        = 7000000;
     config_ptr->max_qp_allowed                       = 63;
     config_ptr->min_qp_allowed                       = 0;
+    config_ptr->vbvBufferSize                        = 0;
+    config_ptr->vbvInitialFullness                   = 90;
     config_ptr->base_layer_switch_mode               = 0;
     config_ptr->encMode                              = 3;
     config_ptr->intraPeriod                          = -2;
@@ -421,6 +475,11 @@ void EbConfigCtor(EbConfig_t *config_ptr)
     config_ptr->hierarchicalLevels                   = 3;
     config_ptr->predStructure                        = 2;
     config_ptr->disable_dlf_flag                     = EB_FALSE;
+    config_ptr->loop_filter_search                   = 0;
+    config_ptr->tile_columns                         = 0;
+    config_ptr->tile_rows                            = 0;
+    config_ptr->tile_group_output                    = EB_FALSE;
+    config_ptr->frame_context_adaptation             = EB_FALSE;
     config_ptr->enable_warped_motion                 = EB_FALSE;
     config_ptr->ext_block_flag                       = EB_FALSE;
     config_ptr->in_loop_me_flag                      = EB_TRUE;
@@ -504,8 +563,18 @@ void EbConfigCtor(EbConfig_t *config_ptr)
     // ASM Type
     config_ptr->asmType                              = 1;
 
+    // Thread Management
+    config_ptr->threadCount                          = 0;
+    config_ptr->useThreadPool                        = EB_FALSE;
+
     config_ptr->stopEncoder                          = 0;
+#ifdef _WIN32
     config_ptr->targetSocket                         = 1;
+#else
+    config_ptr->targetSocket                         = -1;
+#endif
+    config_ptr->useRoundRobinThreadAssignment        = EB_FALSE;
+    config_ptr->cpuList[0]                           = 0;
     config_ptr->processedFrameCount                  = 0;
     config_ptr->processedByteCount                   = 0;
 
@@ -539,6 +608,11 @@ void EbConfigDtor(EbConfig_t *config_ptr)
         config_ptr->reconFile = (FILE *)NULL;
     }
 
+    if (config_ptr->statsFile) {
+        fclose(config_ptr->statsFile);
+        config_ptr->statsFile = (FILE *)NULL;
+    }
+
     if (config_ptr->errorLogFile) {
         fclose(config_ptr->errorLogFile);
         config_ptr->errorLogFile = (FILE *) NULL;
@@ -819,11 +893,23 @@ static EbErrorType VerifySettings(EbConfig_t *config, uint32_t channelNumber)
         return_error = EB_ErrorBadParameter;
     }
 
-    // TargetSocket
+    // TargetSocket, a NUMA node on Linux
+#ifdef _WIN32
     if (config->targetSocket != -1 && config->targetSocket != 0 && config->targetSocket != 1) {
         fprintf(config->errorLogFile, "Error instance %u: Invalid TargetSocket [-1 - 1], your input: %d\n", channelNumber + 1, config->targetSocket);
         return_error = EB_ErrorBadParameter;
     }
+#else
+    if (config->targetSocket < -1) {
+        fprintf(config->errorLogFile, "Error instance %u: Invalid TargetSocket [-1 - NUMA nodes - 1], your input: %d\n", channelNumber + 1, config->targetSocket);
+        return_error = EB_ErrorBadParameter;
+    }
+#endif
+
+    if (config->useRoundRobinThreadAssignment != 0 && config->useRoundRobinThreadAssignment != 1) {
+        fprintf(config->errorLogFile, "Error instance %u: Invalid UseRoundRobinThreadAssignment [0 - 1], your input: %d\n", channelNumber + 1, config->useRoundRobinThreadAssignment);
+        return_error = EB_ErrorBadParameter;
+    }
 
     // Local Warped Motion
     if (config->enable_warped_motion != 0 && config->enable_warped_motion != 1) {
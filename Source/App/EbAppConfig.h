@@ -212,6 +212,7 @@ typedef struct EbConfig_s
     FILE                    *inputFile;
     FILE                    *bitstreamFile;
     FILE                    *reconFile;
+    FILE                    *statsFile;
     FILE                    *errorLogFile;
     FILE                    *bufferFile;
 
@@ -242,6 +243,8 @@ typedef struct EbConfig_s
     uint8_t                **sequenceBuffer;
 
     uint8_t                  latencyMode;
+    uint32_t                 statsInterval;     // ms between two dumps of the pipeline stats, 0 for none
+    uint32_t                 frameStats;        // 0 none, 1 bits and timing, 2 with PSNR, written to statsFile
 
     /****************************************
      * // Interlaced Video
@@ -273,6 +276,19 @@ typedef struct EbConfig_s
      * DLF
      ****************************************/
     EbBool                  disable_dlf_flag;
+    uint32_t                loop_filter_search;
+
+    /****************************************
+     * Tiles
+     ****************************************/
+    uint32_t                tile_columns;
+    uint32_t                tile_rows;
+    EbBool                  tile_group_output;
+
+    /****************************************
+     * Entropy Coding
+     ****************************************/
+    EbBool                  frame_context_adaptation;
 
     /****************************************
      * Local Warped Motion
@@ -331,6 +347,8 @@ typedef struct EbConfig_s
     uint32_t                 targetBitRate;
     uint32_t                 max_qp_allowed;
     uint32_t                 min_qp_allowed;
+    uint32_t                 vbvBufferSize;
+    uint32_t                 vbvInitialFullness;
 
     /****************************************
      * Optional Features
@@ -364,6 +382,12 @@ typedef struct EbConfig_s
     ****************************************/
     uint32_t                  asmType;
 
+    /****************************************
+    * Thread Management
+    ****************************************/
+    uint32_t                  threadCount;
+    EbBool                    useThreadPool;
+
     /****************************************
      * Computational Performance Data
      ****************************************/
@@ -376,6 +400,8 @@ typedef struct EbConfig_s
     uint32_t                active_channel_count;
     uint32_t                logicalProcessors;
     int32_t                 targetSocket;
+    EbBool                  useRoundRobinThreadAssignment;
+    char                    cpuList[256];
     EbBool                 stopEncoder;         // to signal CTRL+C Event, need to stop encoding.
 
     uint64_t                processedFrameCount;
@@ -181,9 +181,16 @@ EbErrorType CopyConfigurationParameters(
     callbackData->ebEncParameters.target_bit_rate = config->targetBitRate;
     callbackData->ebEncParameters.max_qp_allowed = config->max_qp_allowed;
     callbackData->ebEncParameters.min_qp_allowed = config->min_qp_allowed;
+    callbackData->ebEncParameters.vbv_buffer_size = config->vbvBufferSize;
+    callbackData->ebEncParameters.vbv_initial_fullness = config->vbvInitialFullness;
     callbackData->ebEncParameters.qp = config->qp;
     callbackData->ebEncParameters.use_qp_file = (EbBool)config->use_qp_file;
     callbackData->ebEncParameters.disable_dlf_flag = (EbBool)config->disable_dlf_flag;
+    callbackData->ebEncParameters.loop_filter_search = config->loop_filter_search;
+    callbackData->ebEncParameters.tile_columns = config->tile_columns;
+    callbackData->ebEncParameters.tile_rows = config->tile_rows;
+    callbackData->ebEncParameters.tile_group_output = config->tile_group_output;
+    callbackData->ebEncParameters.frame_context_adaptation = config->frame_context_adaptation;
     callbackData->ebEncParameters.enable_warped_motion = (EbBool)config->enable_warped_motion;
     callbackData->ebEncParameters.use_default_me_hme = (EbBool)config->use_default_me_hme;
     callbackData->ebEncParameters.enable_hme_flag = (EbBool)config->enableHmeFlag;
@@ -215,7 +222,14 @@ EbErrorType CopyConfigurationParameters(
     callbackData->ebEncParameters.level = config->level;
     callbackData->ebEncParameters.injector_frame_rate = config->injector_frame_rate;
     callbackData->ebEncParameters.speed_control_flag = config->speed_control_flag;
+    callbackData->ebEncParameters.low_latency = config->latencyMode;
+    callbackData->ebEncParameters.frame_stats = config->frameStats ? config->frameStats : (config->statsFile ? 1 : 0);
     callbackData->ebEncParameters.asm_type = config->asmType;
+    callbackData->ebEncParameters.thread_count = config->threadCount;
+    callbackData->ebEncParameters.use_thread_pool = config->useThreadPool;
+    callbackData->ebEncParameters.use_round_robin_thread_assignment = config->useRoundRobinThreadAssignment;
+    callbackData->ebEncParameters.target_socket = config->targetSocket;
+    callbackData->ebEncParameters.cpu_list = config->cpuList[0] ? config->cpuList : (const char*)NULL;
     callbackData->ebEncParameters.recon_enabled = config->reconFile ? EB_TRUE : EB_FALSE;
 
     for (hmeRegionIndex = 0; hmeRegionIndex < callbackData->ebEncParameters.number_hme_search_region_in_width; ++hmeRegionIndex) {
@@ -375,6 +389,7 @@ EbErrorType AllocateOutputBuffers(
         EB_APP_MALLOC(uint8_t*, callbackData->streamBufferPool->p_buffer, outputStreamBufferSize, EB_N_PTR, EB_ErrorInsufficientResources);
 
         callbackData->streamBufferPool->n_alloc_len = outputStreamBufferSize;
+        callbackData->streamBufferPool->n_filled_len = 0;
         callbackData->streamBufferPool->p_app_private = NULL;
         callbackData->streamBufferPool->pic_type = EB_INVALID_PICTURE;
     }
@@ -18,6 +18,7 @@
  ***************************************/
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <signal.h>
 #include <stdint.h>
 #include "EbAppConfig.h"
@@ -50,10 +51,245 @@ extern APPEXITCONDITIONTYPE ProcessOutputReconBuffer(
 extern APPEXITCONDITIONTYPE ProcessOutputStreamBuffer(
     EbConfig_t             *config,
     EbAppContext_t         *appCallBack,
-    uint8_t           pic_send_done);
+    uint32_t                timeout_ms);
 
 volatile int32_t keepRunning = 1;
 
+#define OUTPUT_WAIT_TIMEOUT_MS  100 // longest wait of the writer thread for a packet
+#define RECON_POLL_TIMEOUT_MS   1   // wait for a packet while recon frames are pending
+
+// Flags shared by the reader and writer threads of a channel
+#ifdef _WIN32
+#define APP_ATOMIC_LOAD(ptr)            InterlockedCompareExchange((volatile LONG*)(ptr), 0, 0)
+#define APP_ATOMIC_STORE(ptr, value)    InterlockedExchange((volatile LONG*)(ptr), (LONG)(value))
+#else
+#define APP_ATOMIC_LOAD(ptr)            __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define APP_ATOMIC_STORE(ptr, value)    __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#endif
+
+/***************************************
+ * Channel Threads
+ *   Each channel has a reader thread feeding the encoder and a writer
+ *   thread draining it. The reader blocks in eb_svt_enc_send_picture
+ *   once the library input pool is exhausted, the writer blocks in
+ *   eb_svt_get_packet_timeout while no packet is ready.
+ ***************************************/
+typedef struct ChannelContext_s {
+    EbConfig_t                     *config;
+    EbAppContext_t                 *appCallBack;
+    APPEXITCONDITIONTYPE            exitConditionInput;     // written by the reader, atomic
+    uint32_t                        stopInput;              // set by the writer on error, atomic
+    APPEXITCONDITIONTYPE            exitConditionOutput;
+    APPEXITCONDITIONTYPE            exitConditionRecon;
+    EbSvtPipelineStats              pipelineStats;      // stats of the last dump
+#ifdef _WIN32
+    HANDLE                          inputThread;
+    HANDLE                          outputThread;
+#else
+    pthread_t                       inputThread;
+    pthread_t                       outputThread;
+#endif
+} ChannelContext_t;
+
+// Ends the stream early so that the encoder flushes the pictures already sent
+static void SendEndOfStream(ChannelContext_t *channelPtr)
+{
+    EbBufferHeaderType *headerPtr = channelPtr->appCallBack->inputBufferPool;
+
+    headerPtr->n_alloc_len   = 0;
+    headerPtr->n_filled_len  = 0;
+    headerPtr->n_tick_count  = 0;
+    headerPtr->p_app_private = NULL;
+    headerPtr->flags         = EB_BUFFERFLAG_EOS;
+    headerPtr->p_buffer      = NULL;
+    headerPtr->pic_type      = EB_INVALID_PICTURE;
+
+    eb_svt_enc_send_picture(channelPtr->appCallBack->svtEncoderHandle, headerPtr);
+}
+
+static void* InputThread(void *contextPtr)
+{
+    ChannelContext_t     *channelPtr = (ChannelContext_t*)contextPtr;
+    APPEXITCONDITIONTYPE  exitCondition = APP_ExitConditionNone;
+
+    while (exitCondition == APP_ExitConditionNone) {
+        if (APP_ATOMIC_LOAD(&channelPtr->stopInput)) {
+            SendEndOfStream(channelPtr);
+            exitCondition = APP_ExitConditionError;
+        }
+        else
+            exitCondition = ProcessInputBuffer(
+                channelPtr->config,
+                channelPtr->appCallBack);
+        APP_ATOMIC_STORE(&channelPtr->exitConditionInput, exitCondition);
+    }
+
+    return NULL;
+}
+
+// Releases the packets and recon frames of a channel whose writer failed,
+// so that a reader blocked on a full encoder gets to send the end of stream,
+// then flushes the encoder up to that end of stream
+static void DrainChannel(ChannelContext_t *channelPtr)
+{
+    EbComponentType    *componentHandle = channelPtr->appCallBack->svtEncoderHandle;
+    EbBufferHeaderType *headerPtr;
+    EbErrorType         streamStatus = EB_ErrorNone;
+    EbBool              endOfStream = EB_FALSE;
+
+    while (!endOfStream && streamStatus != EB_ErrorMax) {
+        if (channelPtr->config->reconFile)
+            eb_svt_get_recon(componentHandle, channelPtr->appCallBack->reconBuffer);
+        streamStatus = eb_svt_get_packet_timeout(componentHandle, &headerPtr, RECON_POLL_TIMEOUT_MS);
+        if (streamStatus != EB_NoErrorEmptyQueue) {
+            // the reader does not send any picture past the end of stream
+            endOfStream = (headerPtr->flags & EB_BUFFERFLAG_EOS) ? EB_TRUE : EB_FALSE;
+            eb_svt_release_out_buffer(&headerPtr);
+        }
+    }
+}
+
+// The intervals in progress are estimated by the library, a counter may
+// step back a little between two reads
+static uint64_t StatsDelta(uint64_t value, uint64_t lastValue)
+{
+    return value > lastValue ? value - lastValue : 0;
+}
+
+/***************************************
+ * Pipeline stats over the interval since the last dump. The times are shares
+ * of the interval, on average over the threads of each stage
+ ***************************************/
+static void PrintPipelineStats(ChannelContext_t *channelPtr, const EbSvtPipelineStats *statsPtr)
+{
+    const EbSvtPipelineStats *lastPtr = &channelPtr->pipelineStats;
+    uint64_t                  interval = statsPtr->elapsed_time - lastPtr->elapsed_time;
+    uint32_t                  stageIndex;
+
+    printf("\nPipeline stats of channel %u over %.0f ms\n", channelPtr->config->channel_id + 1, interval / 1000.0);
+    printf("%-22s %7s %8s %7s %7s %7s   %s\n", "Stage", "Threads", "Tasks", "Busy", "InWait", "OutWait", "Fifo now / max / mean");
+    for (stageIndex = 0; stageIndex < statsPtr->stage_count; ++stageIndex) {
+        const EbSvtStageStats *stagePtr = &statsPtr->stage[stageIndex];
+        const EbSvtStageStats *lastStagePtr = &lastPtr->stage[stageIndex];
+        double                 stageTime = (double)interval * (stagePtr->thread_count ? stagePtr->thread_count : 1) / 100;
+
+        if (stageTime == 0)
+            stageTime = 1;
+        printf("%-22s %7u %8llu %6.1f%% %6.1f%% %6.1f%%   %u / %u / %.1f\n",
+            stagePtr->name,
+            stagePtr->thread_count,
+            (unsigned long long)StatsDelta(stagePtr->task_count, lastStagePtr->task_count),
+            StatsDelta(stagePtr->busy_time, lastStagePtr->busy_time) / stageTime,
+            StatsDelta(stagePtr->input_wait_time, lastStagePtr->input_wait_time) / stageTime,
+            StatsDelta(stagePtr->output_wait_time, lastStagePtr->output_wait_time) / stageTime,
+            stagePtr->fifo_depth,
+            stagePtr->fifo_depth_max,
+            stagePtr->fifo_depth_mean);
+    }
+    printf("%-22s %llu hits / %llu misses\n", "MD rate tables",
+        (unsigned long long)StatsDelta(statsPtr->rate_table_hits, lastPtr->rate_table_hits),
+        (unsigned long long)StatsDelta(statsPtr->rate_table_misses, lastPtr->rate_table_misses));
+    fflush(stdout);
+
+    channelPtr->pipelineStats = *statsPtr;
+}
+
+static void DumpPipelineStats(ChannelContext_t *channelPtr, EbBool force)
+{
+    EbSvtPipelineStats stats;
+
+    if (channelPtr->config->statsInterval == 0 ||
+        eb_svt_get_pipeline_stats(channelPtr->appCallBack->svtEncoderHandle, &stats) != EB_ErrorNone)
+        return;
+    if (force || stats.elapsed_time - channelPtr->pipelineStats.elapsed_time >= (uint64_t)channelPtr->config->statsInterval * 1000)
+        PrintPipelineStats(channelPtr, &stats);
+}
+
+static void* OutputThread(void *contextPtr)
+{
+    ChannelContext_t *channelPtr = (ChannelContext_t*)contextPtr;
+
+    while (APP_ATOMIC_LOAD(&channelPtr->exitConditionInput) != APP_ExitConditionError &&
+          (channelPtr->exitConditionOutput == APP_ExitConditionNone || channelPtr->exitConditionRecon == APP_ExitConditionNone)) {
+
+        if (channelPtr->exitConditionRecon == APP_ExitConditionNone)
+            channelPtr->exitConditionRecon = ProcessOutputReconBuffer(
+                channelPtr->config,
+                channelPtr->appCallBack);
+
+        if (channelPtr->exitConditionOutput == APP_ExitConditionNone)
+            channelPtr->exitConditionOutput = ProcessOutputStreamBuffer(
+                channelPtr->config,
+                channelPtr->appCallBack,
+                channelPtr->exitConditionRecon == APP_ExitConditionNone ? RECON_POLL_TIMEOUT_MS : OUTPUT_WAIT_TIMEOUT_MS);
+        else if (channelPtr->exitConditionRecon == APP_ExitConditionNone)
+            EbSleep(RECON_POLL_TIMEOUT_MS);
+
+        // Stop the reader as well, and keep the encoder moving until it has
+        // sent the end of stream
+        if (channelPtr->exitConditionOutput == APP_ExitConditionError ||
+           (channelPtr->exitConditionRecon == APP_ExitConditionError && channelPtr->config->reconFile)) {
+            APP_ATOMIC_STORE(&channelPtr->stopInput, 1);
+            DrainChannel(channelPtr);
+            break;
+        }
+
+        DumpPipelineStats(channelPtr, EB_FALSE);
+    }
+
+    // Over the end of the stream
+    DumpPipelineStats(channelPtr, EB_TRUE);
+
+    return NULL;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI InputThreadEntry(LPVOID contextPtr) { InputThread(contextPtr); return 0; }
+static DWORD WINAPI OutputThreadEntry(LPVOID contextPtr) { OutputThread(contextPtr); return 0; }
+#endif
+
+static EbErrorType StartChannelThreads(ChannelContext_t *channelPtr)
+{
+#ifdef _WIN32
+    channelPtr->inputThread = CreateThread(NULL, 0, InputThreadEntry, channelPtr, 0, NULL);
+    if (channelPtr->inputThread == NULL)
+        return EB_ErrorInsufficientResources;
+    channelPtr->outputThread = CreateThread(NULL, 0, OutputThreadEntry, channelPtr, 0, NULL);
+    if (channelPtr->outputThread == NULL) {
+        APP_ATOMIC_STORE(&channelPtr->stopInput, 1);
+        DrainChannel(channelPtr);
+        WaitForSingleObject(channelPtr->inputThread, INFINITE);
+        CloseHandle(channelPtr->inputThread);
+        return EB_ErrorInsufficientResources;
+    }
+#else
+    if (pthread_create(&channelPtr->inputThread, NULL, InputThread, channelPtr))
+        return EB_ErrorInsufficientResources;
+    if (pthread_create(&channelPtr->outputThread, NULL, OutputThread, channelPtr)) {
+        APP_ATOMIC_STORE(&channelPtr->stopInput, 1);
+        DrainChannel(channelPtr);
+        pthread_join(channelPtr->inputThread, NULL);
+        return EB_ErrorInsufficientResources;
+    }
+#endif
+    return EB_ErrorNone;
+}
+
+// The writer is joined first: on error it stops the reader and keeps the
+// encoder moving until the reader is done
+static void JoinChannelThreads(ChannelContext_t *channelPtr)
+{
+#ifdef _WIN32
+    WaitForSingleObject(channelPtr->outputThread, INFINITE);
+    CloseHandle(channelPtr->outputThread);
+    WaitForSingleObject(channelPtr->inputThread, INFINITE);
+    CloseHandle(channelPtr->inputThread);
+#else
+    pthread_join(channelPtr->outputThread, NULL);
+    pthread_join(channelPtr->inputThread, NULL);
+#endif
+}
+
 void EventHandler(int32_t dummy) {
     (void)dummy;
     keepRunning = 0;
@@ -76,6 +312,24 @@ void AssignAppThreadGroup(uint8_t targetSocket) {
 #endif
 }
 
+/***************************************
+ * Share of the channel memory living on other NUMA nodes than the channel
+ * threads, reported when the placement was asked for
+ ***************************************/
+static void PrintNumaPlacement(EbConfig_t *config, EbAppContext_t *appCallback)
+{
+    EbSvtMemoryUsage usage;
+    uint64_t         residentMemory;
+
+    if (config->targetSocket == -1 && config->cpuList[0] == 0 && config->useRoundRobinThreadAssignment == EB_FALSE)
+        return;
+    if (eb_svt_get_memory_usage(appCallback->svtEncoderHandle, &usage) != EB_ErrorNone)
+        return;
+    residentMemory = usage.local_memory + usage.remote_memory;
+    if (residentMemory)
+        printf("Remote Memory:\t\t%.1f%% of %.0f MB\n", 100.0 * usage.remote_memory / residentMemory, residentMemory / 1048576.0);
+}
+
 /***************************************
  * Encoder App Main
  ***************************************/
@@ -87,7 +341,6 @@ int32_t main(int32_t argc, char* argv[])
 #endif
     // GLOBAL VARIABLES
     EbErrorType            return_error = EB_ErrorNone;            // Error Handling
-    APPEXITCONDITIONTYPE    exitCondition = APP_ExitConditionNone;    // Processing loop exit condition
 
     EbErrorType            return_errors[MAX_CHANNEL_NUMBER];          // Error Handling
     APPEXITCONDITIONTYPE    exitConditions[MAX_CHANNEL_NUMBER];          // Processing loop exit condition
@@ -97,6 +350,7 @@ int32_t main(int32_t argc, char* argv[])
 
 
     EbBool                 channelActive[MAX_CHANNEL_NUMBER];
+    ChannelContext_t        channels[MAX_CHANNEL_NUMBER];           // Reader / writer threads of each channel
 
     EbConfig_t             *configs[MAX_CHANNEL_NUMBER];        // Encoder Configuration
 
@@ -193,37 +447,37 @@ int32_t main(int32_t argc, char* argv[])
                 printf("Encoding          ");
                 fflush(stdout);
 
-                while (exitCondition == APP_ExitConditionNone) {
-                    exitCondition = APP_ExitConditionFinished;
-                    for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
-                        if (channelActive[instanceCount] == EB_TRUE) {
-                            if (exitConditionsInput[instanceCount] == APP_ExitConditionNone)
-                                exitConditionsInput[instanceCount] = ProcessInputBuffer(
-                                                                            configs[instanceCount],
-                                                                            appCallbacks[instanceCount]);
-                            if (exitConditionsRecon[instanceCount] == APP_ExitConditionNone)
-                                exitConditionsRecon[instanceCount] = ProcessOutputReconBuffer(
-                                                                            configs[instanceCount],
-                                                                            appCallbacks[instanceCount]);
-                            if (exitConditionsOutput[instanceCount] == APP_ExitConditionNone)
-                                exitConditionsOutput[instanceCount] = ProcessOutputStreamBuffer(
-                                                                            configs[instanceCount],
-                                                                            appCallbacks[instanceCount],
-                                                                            (exitConditionsInput[instanceCount] == APP_ExitConditionNone) || (exitConditionsRecon[instanceCount] == APP_ExitConditionNone)? 0 : 1);
-                            if (((exitConditionsRecon[instanceCount] == APP_ExitConditionFinished || !configs[instanceCount]->reconFile)  && exitConditionsOutput[instanceCount] == APP_ExitConditionFinished && exitConditionsInput[instanceCount] == APP_ExitConditionFinished)||
-                                ((exitConditionsRecon[instanceCount] == APP_ExitConditionError && configs[instanceCount]->reconFile) || exitConditionsOutput[instanceCount] == APP_ExitConditionError || exitConditionsInput[instanceCount] == APP_ExitConditionError)){
-                                channelActive[instanceCount] = EB_FALSE;
-                                if (configs[instanceCount]->reconFile)
-                                    exitConditions[instanceCount] = (APPEXITCONDITIONTYPE)(exitConditionsRecon[instanceCount] | exitConditionsOutput[instanceCount] | exitConditionsInput[instanceCount]);
-                                else
-                                    exitConditions[instanceCount] = (APPEXITCONDITIONTYPE)(exitConditionsOutput[instanceCount] | exitConditionsInput[instanceCount]);
-                            }
+                // Start the reader and writer threads of the channels
+                for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
+                    if (channelActive[instanceCount] == EB_TRUE) {
+                        channels[instanceCount].config              = configs[instanceCount];
+                        channels[instanceCount].appCallBack         = appCallbacks[instanceCount];
+                        channels[instanceCount].exitConditionInput  = exitConditionsInput[instanceCount];
+                        channels[instanceCount].stopInput           = 0;
+                        channels[instanceCount].exitConditionOutput = exitConditionsOutput[instanceCount];
+                        channels[instanceCount].exitConditionRecon  = exitConditionsRecon[instanceCount];
+                        memset(&channels[instanceCount].pipelineStats, 0, sizeof(EbSvtPipelineStats));
+                        if (StartChannelThreads(&channels[instanceCount]) != EB_ErrorNone) {
+                            printf("Could not start the threads of channel %u\n", instanceCount + 1);
+                            channelActive[instanceCount] = EB_FALSE;
+                            exitConditions[instanceCount] = APP_ExitConditionError;
                         }
                     }
-                    // check if all channels are inactive
-                    for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
-                        if (channelActive[instanceCount] == EB_TRUE)
-                            exitCondition = APP_ExitConditionNone;
+                }
+
+                // Wait for the channels to finish
+                for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
+                    if (channelActive[instanceCount] == EB_TRUE) {
+                        JoinChannelThreads(&channels[instanceCount]);
+                        channelActive[instanceCount] = EB_FALSE;
+
+                        exitConditionsInput[instanceCount]  = channels[instanceCount].exitConditionInput;
+                        exitConditionsOutput[instanceCount] = channels[instanceCount].exitConditionOutput;
+                        exitConditionsRecon[instanceCount]  = channels[instanceCount].exitConditionRecon;
+                        if (configs[instanceCount]->reconFile)
+                            exitConditions[instanceCount] = (APPEXITCONDITIONTYPE)(exitConditionsRecon[instanceCount] | exitConditionsOutput[instanceCount] | exitConditionsInput[instanceCount]);
+                        else
+                            exitConditions[instanceCount] = (APPEXITCONDITIONTYPE)(exitConditionsOutput[instanceCount] | exitConditionsInput[instanceCount]);
                     }
                 }
 
@@ -289,6 +543,7 @@ int32_t main(int32_t argc, char* argv[])
                                 (uint32_t)(configs[instanceCount]->performanceContext.maxLatency));
 
                         }
+                        PrintNumaPlacement(configs[instanceCount], appCallbacks[instanceCount]);
                     }
                     else {
                         printf("\nChannel %u Encoding Interrupted\n", (uint32_t)(instanceCount + 1));
@@ -1314,12 +1314,40 @@ static void write_ivf_frame_header(EbConfig_t *config, uint32_t byte_count){
     if (config->bitstreamFile)
         fwrite(header, 1, 12, config->bitstreamFile);
 }
+
+/***************************************
+* Write the statistics of a frame, one line per frame
+***************************************/
+static void WriteFrameStats(FILE *statsFile, const EbSvtFrameStats *frameStats)
+{
+    static const char *stageNames[EB_FRAME_STATS_STAGE_COUNT] = { "PA", "PD", "ME", "RC", "ED", "LF", "EC", "PK" };
+    int32_t stage;
+
+    fprintf(statsFile, "POC %llu DEC %llu TL %u QP %u BITS %llu OUT %.3f ms |",
+        (unsigned long long)frameStats->picture_number,
+        (unsigned long long)frameStats->decode_order,
+        frameStats->temporal_layer,
+        frameStats->qp,
+        (unsigned long long)frameStats->bits,
+        frameStats->latency / 1000.0);
+    for (stage = 0; stage < EB_FRAME_STATS_STAGE_COUNT; ++stage)
+        fprintf(statsFile, " %s %.3f", stageNames[stage], frameStats->stage_time[stage] / 1000.0);
+    // PSNR is 0 unless requested, at least 100 dB for a lossless frame
+    if (frameStats->psnr[0] != 0.0)
+        fprintf(statsFile, " | PSNR Y %.4f U %.4f V %.4f SSE %llu %llu %llu",
+            frameStats->psnr[0], frameStats->psnr[1], frameStats->psnr[2],
+            (unsigned long long)frameStats->sse[0],
+            (unsigned long long)frameStats->sse[1],
+            (unsigned long long)frameStats->sse[2]);
+    fprintf(statsFile, "\n");
+}
+
 #define OBU_FRAME_HEADER_SIZE   3
 #define TD_SPS_SIZE             17
 APPEXITCONDITIONTYPE ProcessOutputStreamBuffer(
     EbConfig_t             *config,
     EbAppContext_t         *appCallBack,
-    uint8_t                 pic_send_done)
+    uint32_t                timeout_ms)
 {
     APPPORTACTIVETYPE      *portState       = &appCallBack->outputStreamPortActive;
     EbBufferHeaderType     *headerPtr;
@@ -1338,9 +1366,12 @@ APPEXITCONDITIONTYPE ProcessOutputStreamBuffer(
     // Local variables
     uint64_t                finishsTime     = 0;
     uint64_t                finishuTime     = 0;
+    EbBufferHeaderType     *framePtr        = appCallBack->streamBufferPool;
+    uint8_t                *frameData;
+    uint32_t                frameSize;
 
-    // non-blocking call until all input frames are sent
-    stream_status = eb_svt_get_packet(componentHandle, &headerPtr, pic_send_done);
+    // waits at most timeout_ms for a packet
+    stream_status = eb_svt_get_packet_timeout(componentHandle, &headerPtr, timeout_ms);
 
     if (stream_status == EB_ErrorMax) {
         printf("\n");
@@ -1350,6 +1381,29 @@ APPEXITCONDITIONTYPE ProcessOutputStreamBuffer(
         return APP_ExitConditionError;
     }
     else if (stream_status != EB_NoErrorEmptyQueue) {
+        frameData = headerPtr->p_buffer;
+        frameSize = headerPtr->n_filled_len;
+
+        // A frame output in parts is gathered, and accounted for with its last part
+        if (headerPtr->flags & EB_BUFFERFLAG_FRAME_PART) {
+            if (framePtr->n_filled_len + headerPtr->n_filled_len > framePtr->n_alloc_len) {
+                printf("\nSVT [Error]: frame larger than the output stream buffer\n");
+                eb_svt_release_out_buffer(&headerPtr);
+                return APP_ExitConditionError;
+            }
+            memcpy(framePtr->p_buffer + framePtr->n_filled_len, headerPtr->p_buffer, headerPtr->n_filled_len);
+            framePtr->n_filled_len += headerPtr->n_filled_len;
+
+            if (!(headerPtr->flags & EB_BUFFERFLAG_FRAME_END)) {
+                eb_svt_release_out_buffer(&headerPtr);
+                return APP_ExitConditionNone;
+            }
+
+            frameData = framePtr->p_buffer;
+            frameSize = framePtr->n_filled_len;
+            framePtr->n_filled_len = 0;
+        }
+
         ++(config->performanceContext.frameCount);
         *totalLatency += (uint64_t)headerPtr->n_tick_count;
         *maxLatency = (headerPtr->n_tick_count > *maxLatency) ? headerPtr->n_tick_count : *maxLatency;
@@ -1380,22 +1434,25 @@ APPEXITCONDITIONTYPE ProcessOutputStreamBuffer(
             }
 
             if (headerPtr->flags & EB_BUFFERFLAG_SHOW_EXT){
-                write_ivf_frame_header(config, headerPtr->n_filled_len - OBU_FRAME_HEADER_SIZE);
-                fwrite(headerPtr->p_buffer, 1, headerPtr->n_filled_len - OBU_FRAME_HEADER_SIZE, streamFile);
+                write_ivf_frame_header(config, frameSize - OBU_FRAME_HEADER_SIZE);
+                fwrite(frameData, 1, frameSize - OBU_FRAME_HEADER_SIZE, streamFile);
                 write_ivf_frame_header(config, OBU_FRAME_HEADER_SIZE);
-                fwrite(headerPtr->p_buffer + headerPtr->n_filled_len - OBU_FRAME_HEADER_SIZE, 1, OBU_FRAME_HEADER_SIZE, streamFile);
+                fwrite(frameData + frameSize - OBU_FRAME_HEADER_SIZE, 1, OBU_FRAME_HEADER_SIZE, streamFile);
             }else{
-                write_ivf_frame_header(config, headerPtr->n_filled_len);
+                write_ivf_frame_header(config, frameSize);
 #else
             }
 #endif
 
-                fwrite(headerPtr->p_buffer, 1, headerPtr->n_filled_len, streamFile);
+                fwrite(frameData, 1, frameSize, streamFile);
 #if !IVF_FRAME_HEADER_IN_LIB
             }
 #endif
         }
-        config->performanceContext.byteCount += headerPtr->n_filled_len;
+        config->performanceContext.byteCount += frameSize;
+
+        if (config->statsFile && headerPtr->frame_stats)
+            WriteFrameStats(config->statsFile, headerPtr->frame_stats);
 
         // Update Output Port Activity State
         *portState = (headerPtr->flags & EB_BUFFERFLAG_EOS) ? APP_PortInactive : *portState;
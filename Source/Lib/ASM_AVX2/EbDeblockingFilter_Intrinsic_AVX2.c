@@ -0,0 +1,599 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <immintrin.h>
+
+#include "EbDefinitions.h"
+#include "aom_dsp_rtcd.h"
+
+/*****************************************************************************
+ * Loop filter of 4 adjacent segments of an edge, 16 samples along the edge.
+ *
+ * The samples are widened to 16 bit lanes, one register per distance to the
+ * edge, so that the same filter code serves the 8 and the 10 bit kernels:
+ * shift is bd - 8. The lanes follow the arithmetic of the C kernels, the sums
+ * of the smoothing filters are below 2^16 up to 12 bit and are shifted as
+ * unsigned values.
+ *****************************************************************************/
+
+typedef struct LpfLimits_s
+{
+    __m256i blimit;
+    __m256i limit;
+    __m256i thresh;
+} LpfLimits;
+
+static INLINE void lpf_load_limits(const uint8_t *blimit, const uint8_t *limit,
+    const uint8_t *thresh, int32_t shift, LpfLimits *limits) {
+    limits->blimit = _mm256_set1_epi16((int16_t)(*blimit << shift));
+    limits->limit = _mm256_set1_epi16((int16_t)(*limit << shift));
+    limits->thresh = _mm256_set1_epi16((int16_t)(*thresh << shift));
+}
+
+static INLINE __m256i abs_diff_epi16(__m256i a, __m256i b) {
+    return _mm256_abs_epi16(_mm256_sub_epi16(a, b));
+}
+
+// All ones in the lanes to filter: filter_mask* of the C kernels, from the
+// largest step among the inner samples
+static INLINE __m256i lpf_filter_mask(const __m256i *p, const __m256i *q,
+    __m256i max_step, const LpfLimits *limits) {
+    const __m256i edge = _mm256_add_epi16(_mm256_slli_epi16(abs_diff_epi16(p[0], q[0]), 1),
+        _mm256_srli_epi16(abs_diff_epi16(p[1], q[1]), 1));
+    const __m256i off = _mm256_or_si256(_mm256_cmpgt_epi16(max_step, limits->limit),
+        _mm256_cmpgt_epi16(edge, limits->blimit));
+    return _mm256_xor_si256(off, _mm256_set1_epi16(-1));
+}
+
+// All ones where the n samples on each side are within 1 << shift of p0, q0
+static INLINE __m256i lpf_flat_mask(const __m256i *p, const __m256i *q,
+    int32_t first, int32_t n, int32_t shift) {
+    __m256i max = _mm256_max_epi16(abs_diff_epi16(p[first], p[0]), abs_diff_epi16(q[first], q[0]));
+    int32_t i;
+    for (i = first + 1; i < first + n; ++i)
+        max = _mm256_max_epi16(max, _mm256_max_epi16(abs_diff_epi16(p[i], p[0]), abs_diff_epi16(q[i], q[0])));
+    return _mm256_xor_si256(_mm256_cmpgt_epi16(max, _mm256_set1_epi16((int16_t)(1 << shift))),
+        _mm256_set1_epi16(-1));
+}
+
+static INLINE __m256i lpf_clamp(__m256i v, __m256i min, __m256i max) {
+    return _mm256_min_epi16(_mm256_max_epi16(v, min), max);
+}
+
+// filter4 of the C kernels on p1, p0, q0, q1
+static AOM_FORCE_INLINE void lpf_filter4(__m256i *p, __m256i *q, __m256i mask,
+    __m256i hev, int32_t shift) {
+    const __m256i offset = _mm256_set1_epi16((int16_t)(0x80 << shift));
+    const __m256i min = _mm256_set1_epi16((int16_t)(-(0x80 << shift)));
+    const __m256i max = _mm256_set1_epi16((int16_t)((0x80 << shift) - 1));
+    const __m256i ps1 = _mm256_sub_epi16(p[1], offset);
+    const __m256i ps0 = _mm256_sub_epi16(p[0], offset);
+    const __m256i qs0 = _mm256_sub_epi16(q[0], offset);
+    const __m256i qs1 = _mm256_sub_epi16(q[1], offset);
+    const __m256i d = _mm256_sub_epi16(qs0, ps0);
+    __m256i filter, filter1, filter2;
+
+    filter = _mm256_and_si256(lpf_clamp(_mm256_sub_epi16(ps1, qs1), min, max), hev);
+    filter = _mm256_add_epi16(filter, _mm256_add_epi16(d, _mm256_add_epi16(d, d)));
+    filter = _mm256_and_si256(lpf_clamp(filter, min, max), mask);
+
+    filter1 = _mm256_srai_epi16(lpf_clamp(_mm256_add_epi16(filter, _mm256_set1_epi16(4)), min, max), 3);
+    filter2 = _mm256_srai_epi16(lpf_clamp(_mm256_add_epi16(filter, _mm256_set1_epi16(3)), min, max), 3);
+    q[0] = _mm256_add_epi16(lpf_clamp(_mm256_sub_epi16(qs0, filter1), min, max), offset);
+    p[0] = _mm256_add_epi16(lpf_clamp(_mm256_add_epi16(ps0, filter2), min, max), offset);
+
+    filter = _mm256_andnot_si256(hev, _mm256_srai_epi16(_mm256_add_epi16(filter1, _mm256_set1_epi16(1)), 1));
+    q[1] = _mm256_add_epi16(lpf_clamp(_mm256_sub_epi16(qs1, filter), min, max), offset);
+    p[1] = _mm256_add_epi16(lpf_clamp(_mm256_add_epi16(ps1, filter), min, max), offset);
+}
+
+static INLINE __m256i lpf_hev_mask(__m256i step_p, __m256i step_q, const LpfLimits *limits) {
+    return _mm256_cmpgt_epi16(_mm256_max_epi16(step_p, step_q), limits->thresh);
+}
+
+static INLINE __m256i lpf_round(__m256i sum, int32_t bits) {
+    return _mm256_srli_epi16(sum, bits);
+}
+
+// Sliding sums of the smoothing filters; with the rounding term included
+// each sum is a sample times 2^bits
+static INLINE __m256i lpf_slide(__m256i sum, __m256i out0, __m256i out1, __m256i in0, __m256i in1) {
+    return _mm256_sub_epi16(_mm256_add_epi16(sum, _mm256_add_epi16(in0, in1)), _mm256_add_epi16(out0, out1));
+}
+
+// 5-tap [1, 2, 2, 2, 1] on p1, p0, q0, q1
+static INLINE void lpf_smooth6(const __m256i *p, const __m256i *q, __m256i *op, __m256i *oq) {
+    __m256i sum = _mm256_add_epi16(_mm256_add_epi16(p[2], p[1]), p[0]);
+    sum = _mm256_add_epi16(_mm256_add_epi16(sum, sum), _mm256_add_epi16(p[2], q[0]));
+    sum = _mm256_add_epi16(sum, _mm256_set1_epi16(4));
+    op[1] = lpf_round(sum, 3);
+    sum = lpf_slide(sum, p[2], p[2], q[0], q[1]);
+    op[0] = lpf_round(sum, 3);
+    sum = lpf_slide(sum, p[2], p[1], q[1], q[2]);
+    oq[0] = lpf_round(sum, 3);
+    sum = lpf_slide(sum, p[1], p[0], q[2], q[2]);
+    oq[1] = lpf_round(sum, 3);
+}
+
+// 7-tap [1, 1, 1, 2, 1, 1, 1] on p2 to q2
+static INLINE void lpf_smooth8(const __m256i *p, const __m256i *q, __m256i *op, __m256i *oq) {
+    __m256i sum = _mm256_add_epi16(_mm256_add_epi16(p[3], p[3]), _mm256_add_epi16(p[3], p[2]));
+    sum = _mm256_add_epi16(sum, _mm256_add_epi16(_mm256_add_epi16(p[2], p[1]), _mm256_add_epi16(p[0], q[0])));
+    sum = _mm256_add_epi16(sum, _mm256_set1_epi16(4));
+    op[2] = lpf_round(sum, 3);
+    sum = lpf_slide(sum, p[3], p[2], p[1], q[1]);
+    op[1] = lpf_round(sum, 3);
+    sum = lpf_slide(sum, p[3], p[1], p[0], q[2]);
+    op[0] = lpf_round(sum, 3);
+    sum = lpf_slide(sum, p[3], p[0], q[0], q[3]);
+    oq[0] = lpf_round(sum, 3);
+    sum = lpf_slide(sum, p[2], q[0], q[1], q[3]);
+    oq[1] = lpf_round(sum, 3);
+    sum = lpf_slide(sum, p[1], q[1], q[2], q[3]);
+    oq[2] = lpf_round(sum, 3);
+}
+
+// 13-tap [1, 1, 1, 1, 1, 2, 2, 2, 1, 1, 1, 1, 1] on p5 to q5
+static INLINE void lpf_smooth14(const __m256i *p, const __m256i *q, __m256i *op, __m256i *oq) {
+    const __m256i p6x2 = _mm256_add_epi16(p[6], p[6]);
+    const __m256i p6x4 = _mm256_add_epi16(p6x2, p6x2);
+    __m256i sum = _mm256_add_epi16(_mm256_add_epi16(p6x4, p6x2), p[6]);
+    sum = _mm256_add_epi16(sum, _mm256_slli_epi16(_mm256_add_epi16(p[5], p[4]), 1));
+    sum = _mm256_add_epi16(sum, _mm256_add_epi16(_mm256_add_epi16(p[3], p[2]), _mm256_add_epi16(p[1], p[0])));
+    sum = _mm256_add_epi16(sum, _mm256_add_epi16(q[0], _mm256_set1_epi16(8)));
+    op[5] = lpf_round(sum, 4);
+    sum = lpf_slide(sum, p[6], p[6], p[3], q[1]);
+    op[4] = lpf_round(sum, 4);
+    sum = lpf_slide(sum, p[6], p[5], p[2], q[2]);
+    op[3] = lpf_round(sum, 4);
+    sum = lpf_slide(sum, p[6], p[4], p[1], q[3]);
+    op[2] = lpf_round(sum, 4);
+    sum = lpf_slide(sum, p[6], p[3], p[0], q[4]);
+    op[1] = lpf_round(sum, 4);
+    sum = lpf_slide(sum, p[6], p[2], q[0], q[5]);
+    op[0] = lpf_round(sum, 4);
+    sum = lpf_slide(sum, p[6], p[1], q[1], q[6]);
+    oq[0] = lpf_round(sum, 4);
+    sum = lpf_slide(sum, p[5], p[0], q[2], q[6]);
+    oq[1] = lpf_round(sum, 4);
+    sum = lpf_slide(sum, p[4], q[0], q[3], q[6]);
+    oq[2] = lpf_round(sum, 4);
+    sum = lpf_slide(sum, p[3], q[1], q[4], q[6]);
+    oq[3] = lpf_round(sum, 4);
+    sum = lpf_slide(sum, p[2], q[2], q[5], q[6]);
+    oq[4] = lpf_round(sum, 4);
+    sum = lpf_slide(sum, p[1], q[3], q[6], q[6]);
+    oq[5] = lpf_round(sum, 4);
+}
+
+static INLINE void lpf_blend(__m256i *dst, const __m256i *src, __m256i mask, int32_t n) {
+    int32_t i;
+    for (i = 0; i < n; ++i)
+        dst[i] = _mm256_blendv_epi8(dst[i], src[i], mask);
+}
+
+// The filters below return 0 when no lane is filtered, the samples being
+// left as they are
+
+static AOM_FORCE_INLINE int32_t lpf_4(__m256i *p, __m256i *q, const LpfLimits *limits, int32_t shift) {
+    const __m256i step_p = abs_diff_epi16(p[1], p[0]);
+    const __m256i step_q = abs_diff_epi16(q[1], q[0]);
+    const __m256i mask = lpf_filter_mask(p, q, _mm256_max_epi16(step_p, step_q), limits);
+
+    if (_mm256_testz_si256(mask, mask))
+        return 0;
+    lpf_filter4(p, q, mask, lpf_hev_mask(step_p, step_q, limits), shift);
+    return 1;
+}
+
+static AOM_FORCE_INLINE int32_t lpf_6(__m256i *p, __m256i *q, const LpfLimits *limits, int32_t shift) {
+    const __m256i step_p = abs_diff_epi16(p[1], p[0]);
+    const __m256i step_q = abs_diff_epi16(q[1], q[0]);
+    const __m256i max_step = _mm256_max_epi16(_mm256_max_epi16(step_p, step_q),
+        _mm256_max_epi16(abs_diff_epi16(p[2], p[1]), abs_diff_epi16(q[2], q[1])));
+    const __m256i mask = lpf_filter_mask(p, q, max_step, limits);
+    __m256i flat, op[2], oq[2];
+
+    if (_mm256_testz_si256(mask, mask))
+        return 0;
+    flat = _mm256_and_si256(lpf_flat_mask(p, q, 1, 2, shift), mask);
+    if (!_mm256_testz_si256(flat, flat))
+        lpf_smooth6(p, q, op, oq);
+    lpf_filter4(p, q, mask, lpf_hev_mask(step_p, step_q, limits), shift);
+    if (!_mm256_testz_si256(flat, flat)) {
+        lpf_blend(p, op, flat, 2);
+        lpf_blend(q, oq, flat, 2);
+    }
+    return 1;
+}
+
+static AOM_FORCE_INLINE int32_t lpf_8(__m256i *p, __m256i *q, const LpfLimits *limits, int32_t shift) {
+    const __m256i step_p = abs_diff_epi16(p[1], p[0]);
+    const __m256i step_q = abs_diff_epi16(q[1], q[0]);
+    __m256i max_step = _mm256_max_epi16(_mm256_max_epi16(step_p, step_q),
+        _mm256_max_epi16(abs_diff_epi16(p[2], p[1]), abs_diff_epi16(q[2], q[1])));
+    __m256i mask, flat, op[3], oq[3];
+
+    max_step = _mm256_max_epi16(max_step, _mm256_max_epi16(abs_diff_epi16(p[3], p[2]), abs_diff_epi16(q[3], q[2])));
+    mask = lpf_filter_mask(p, q, max_step, limits);
+    if (_mm256_testz_si256(mask, mask))
+        return 0;
+    flat = _mm256_and_si256(lpf_flat_mask(p, q, 1, 3, shift), mask);
+    if (!_mm256_testz_si256(flat, flat))
+        lpf_smooth8(p, q, op, oq);
+    lpf_filter4(p, q, mask, lpf_hev_mask(step_p, step_q, limits), shift);
+    if (!_mm256_testz_si256(flat, flat)) {
+        lpf_blend(p, op, flat, 3);
+        lpf_blend(q, oq, flat, 3);
+    }
+    return 1;
+}
+
+static AOM_FORCE_INLINE int32_t lpf_14(__m256i *p, __m256i *q, const LpfLimits *limits, int32_t shift) {
+    const __m256i step_p = abs_diff_epi16(p[1], p[0]);
+    const __m256i step_q = abs_diff_epi16(q[1], q[0]);
+    __m256i max_step = _mm256_max_epi16(_mm256_max_epi16(step_p, step_q),
+        _mm256_max_epi16(abs_diff_epi16(p[2], p[1]), abs_diff_epi16(q[2], q[1])));
+    __m256i mask, flat, flat2, op[6], oq[6];
+
+    max_step = _mm256_max_epi16(max_step, _mm256_max_epi16(abs_diff_epi16(p[3], p[2]), abs_diff_epi16(q[3], q[2])));
+    mask = lpf_filter_mask(p, q, max_step, limits);
+    if (_mm256_testz_si256(mask, mask))
+        return 0;
+    flat = _mm256_and_si256(lpf_flat_mask(p, q, 1, 3, shift), mask);
+    if (_mm256_testz_si256(flat, flat)) {
+        lpf_filter4(p, q, mask, lpf_hev_mask(step_p, step_q, limits), shift);
+        return 1;
+    }
+    flat2 = _mm256_and_si256(lpf_flat_mask(p, q, 4, 3, shift), flat);
+    if (!_mm256_testz_si256(flat2, flat2))
+        lpf_smooth14(p, q, op, oq);
+    else
+        lpf_smooth8(p, q, op, oq);
+    {
+        // The 7-tap outputs where flat2 is off
+        __m256i op8[3], oq8[3];
+        if (!_mm256_testz_si256(flat2, flat2)) {
+            lpf_smooth8(p, q, op8, oq8);
+            lpf_blend(op8, op, flat2, 3);
+            lpf_blend(oq8, oq, flat2, 3);
+        }
+        else {
+            op8[0] = op[0]; op8[1] = op[1]; op8[2] = op[2];
+            oq8[0] = oq[0]; oq8[1] = oq[1]; oq8[2] = oq[2];
+        }
+        lpf_filter4(p, q, mask, lpf_hev_mask(step_p, step_q, limits), shift);
+        lpf_blend(p, op8, flat, 3);
+        lpf_blend(q, oq8, flat, 3);
+        if (!_mm256_testz_si256(flat2, flat2)) {
+            lpf_blend(p + 3, op + 3, flat2, 3);
+            lpf_blend(q + 3, oq + 3, flat2, 3);
+        }
+    }
+    return 1;
+}
+
+/*****************************************************************************
+ * Loads and stores
+ *****************************************************************************/
+
+// 8x8 transpose of 16 bit samples in each 128 bit lane
+static INLINE void transpose_16bit_8x8_lanes(const __m256i *in, __m256i *out) {
+    const __m256i a0 = _mm256_unpacklo_epi16(in[0], in[1]);
+    const __m256i a1 = _mm256_unpackhi_epi16(in[0], in[1]);
+    const __m256i a2 = _mm256_unpacklo_epi16(in[2], in[3]);
+    const __m256i a3 = _mm256_unpackhi_epi16(in[2], in[3]);
+    const __m256i a4 = _mm256_unpacklo_epi16(in[4], in[5]);
+    const __m256i a5 = _mm256_unpackhi_epi16(in[4], in[5]);
+    const __m256i a6 = _mm256_unpacklo_epi16(in[6], in[7]);
+    const __m256i a7 = _mm256_unpackhi_epi16(in[6], in[7]);
+    const __m256i b0 = _mm256_unpacklo_epi32(a0, a2);
+    const __m256i b1 = _mm256_unpackhi_epi32(a0, a2);
+    const __m256i b2 = _mm256_unpacklo_epi32(a1, a3);
+    const __m256i b3 = _mm256_unpackhi_epi32(a1, a3);
+    const __m256i b4 = _mm256_unpacklo_epi32(a4, a6);
+    const __m256i b5 = _mm256_unpackhi_epi32(a4, a6);
+    const __m256i b6 = _mm256_unpacklo_epi32(a5, a7);
+    const __m256i b7 = _mm256_unpackhi_epi32(a5, a7);
+    out[0] = _mm256_unpacklo_epi64(b0, b4);
+    out[1] = _mm256_unpackhi_epi64(b0, b4);
+    out[2] = _mm256_unpacklo_epi64(b1, b5);
+    out[3] = _mm256_unpackhi_epi64(b1, b5);
+    out[4] = _mm256_unpacklo_epi64(b2, b6);
+    out[5] = _mm256_unpackhi_epi64(b2, b6);
+    out[6] = _mm256_unpacklo_epi64(b3, b7);
+    out[7] = _mm256_unpackhi_epi64(b3, b7);
+}
+
+// Rows -n to n - 1 around a horizontal edge, p[i] being row -1 - i
+static INLINE void lpf_load_horz(const uint8_t *s, int32_t pitch, int32_t n, __m256i *p, __m256i *q) {
+    int32_t i;
+    for (i = 0; i < n; ++i) {
+        p[i] = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(s - (i + 1) * pitch)));
+        q[i] = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(s + i * pitch)));
+    }
+}
+
+static INLINE void lpf_store_row(uint8_t *s, __m256i v) {
+    _mm_storeu_si128((__m128i *)s, _mm_packus_epi16(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+}
+
+static INLINE void lpf_store_horz(uint8_t *s, int32_t pitch, int32_t n, const __m256i *p, const __m256i *q) {
+    int32_t i;
+    for (i = 0; i < n; ++i) {
+        lpf_store_row(s - (i + 1) * pitch, p[i]);
+        lpf_store_row(s + i * pitch, q[i]);
+    }
+}
+
+static INLINE void highbd_lpf_load_horz(const uint16_t *s, int32_t pitch, int32_t n, __m256i *p, __m256i *q) {
+    int32_t i;
+    for (i = 0; i < n; ++i) {
+        p[i] = _mm256_loadu_si256((const __m256i *)(s - (i + 1) * pitch));
+        q[i] = _mm256_loadu_si256((const __m256i *)(s + i * pitch));
+    }
+}
+
+static INLINE void highbd_lpf_store_horz(uint16_t *s, int32_t pitch, int32_t n, const __m256i *p, const __m256i *q) {
+    int32_t i;
+    for (i = 0; i < n; ++i) {
+        _mm256_storeu_si256((__m256i *)(s - (i + 1) * pitch), p[i]);
+        _mm256_storeu_si256((__m256i *)(s + i * pitch), q[i]);
+    }
+}
+
+// 8 columns of 16 rows: rows r and r + 8 share a register before the transpose,
+// so that each column register holds the 16 rows in order
+static INLINE void lpf_load_cols8(const uint8_t *s, int32_t pitch, __m256i *cols) {
+    __m256i rows[8];
+    int32_t r;
+    for (r = 0; r < 8; ++r) {
+        rows[r] = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)(s + r * pitch)))),
+            _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)(s + (r + 8) * pitch))), 1);
+    }
+    transpose_16bit_8x8_lanes(rows, cols);
+}
+
+static INLINE void lpf_store_cols8(uint8_t *s, int32_t pitch, const __m256i *cols) {
+    __m256i rows[8];
+    int32_t r;
+    transpose_16bit_8x8_lanes(cols, rows);
+    for (r = 0; r < 8; ++r) {
+        const __m256i packed = _mm256_packus_epi16(rows[r], rows[r]);
+        _mm_storel_epi64((__m128i *)(s + r * pitch), _mm256_castsi256_si128(packed));
+        _mm_storel_epi64((__m128i *)(s + (r + 8) * pitch), _mm256_extracti128_si256(packed, 1));
+    }
+}
+
+static INLINE void highbd_lpf_load_cols8(const uint16_t *s, int32_t pitch, __m256i *cols) {
+    __m256i rows[8];
+    int32_t r;
+    for (r = 0; r < 8; ++r) {
+        rows[r] = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)(s + r * pitch))),
+            _mm_loadu_si128((const __m128i *)(s + (r + 8) * pitch)), 1);
+    }
+    transpose_16bit_8x8_lanes(rows, cols);
+}
+
+static INLINE void highbd_lpf_store_cols8(uint16_t *s, int32_t pitch, const __m256i *cols) {
+    __m256i rows[8];
+    int32_t r;
+    transpose_16bit_8x8_lanes(cols, rows);
+    for (r = 0; r < 8; ++r) {
+        _mm_storeu_si128((__m128i *)(s + r * pitch), _mm256_castsi256_si128(rows[r]));
+        _mm_storeu_si128((__m128i *)(s + (r + 8) * pitch), _mm256_extracti128_si256(rows[r], 1));
+    }
+}
+
+// Columns -4 to 3 around a vertical edge, and -8 to 7 for the 14-tap filter
+static INLINE void lpf_split_cols(const __m256i *cols, int32_t n, __m256i *p, __m256i *q) {
+    int32_t i;
+    for (i = 0; i < n; ++i) {
+        p[i] = cols[n - 1 - i];
+        q[i] = cols[n + i];
+    }
+}
+
+static INLINE void lpf_join_cols(const __m256i *p, const __m256i *q, int32_t n, __m256i *cols) {
+    int32_t i;
+    for (i = 0; i < n; ++i) {
+        cols[n - 1 - i] = p[i];
+        cols[n + i] = q[i];
+    }
+}
+
+/*****************************************************************************
+ * Kernels
+ *****************************************************************************/
+
+void aom_lpf_horizontal_4_quad_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    LpfLimits limits;
+    __m256i p[2], q[2];
+    lpf_load_limits(blimit, limit, thresh, 0, &limits);
+    lpf_load_horz(s, pitch, 2, p, q);
+    if (lpf_4(p, q, &limits, 0))
+        lpf_store_horz(s, pitch, 2, p, q);
+}
+
+void aom_lpf_horizontal_6_quad_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    LpfLimits limits;
+    __m256i p[3], q[3];
+    lpf_load_limits(blimit, limit, thresh, 0, &limits);
+    lpf_load_horz(s, pitch, 3, p, q);
+    if (lpf_6(p, q, &limits, 0))
+        lpf_store_horz(s, pitch, 2, p, q);
+}
+
+void aom_lpf_horizontal_8_quad_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    LpfLimits limits;
+    __m256i p[4], q[4];
+    lpf_load_limits(blimit, limit, thresh, 0, &limits);
+    lpf_load_horz(s, pitch, 4, p, q);
+    if (lpf_8(p, q, &limits, 0))
+        lpf_store_horz(s, pitch, 3, p, q);
+}
+
+void aom_lpf_horizontal_14_quad_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    LpfLimits limits;
+    __m256i p[7], q[7];
+    lpf_load_limits(blimit, limit, thresh, 0, &limits);
+    lpf_load_horz(s, pitch, 7, p, q);
+    if (lpf_14(p, q, &limits, 0))
+        lpf_store_horz(s, pitch, 6, p, q);
+}
+
+void aom_lpf_vertical_4_quad_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    LpfLimits limits;
+    __m256i cols[8], p[4], q[4];
+    lpf_load_limits(blimit, limit, thresh, 0, &limits);
+    lpf_load_cols8(s - 4, pitch, cols);
+    lpf_split_cols(cols, 4, p, q);
+    if (lpf_4(p, q, &limits, 0)) {
+        lpf_join_cols(p, q, 4, cols);
+        lpf_store_cols8(s - 4, pitch, cols);
+    }
+}
+
+void aom_lpf_vertical_6_quad_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    LpfLimits limits;
+    __m256i cols[8], p[4], q[4];
+    lpf_load_limits(blimit, limit, thresh, 0, &limits);
+    lpf_load_cols8(s - 4, pitch, cols);
+    lpf_split_cols(cols, 4, p, q);
+    if (lpf_6(p, q, &limits, 0)) {
+        lpf_join_cols(p, q, 4, cols);
+        lpf_store_cols8(s - 4, pitch, cols);
+    }
+}
+
+void aom_lpf_vertical_8_quad_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    LpfLimits limits;
+    __m256i cols[8], p[4], q[4];
+    lpf_load_limits(blimit, limit, thresh, 0, &limits);
+    lpf_load_cols8(s - 4, pitch, cols);
+    lpf_split_cols(cols, 4, p, q);
+    if (lpf_8(p, q, &limits, 0)) {
+        lpf_join_cols(p, q, 4, cols);
+        lpf_store_cols8(s - 4, pitch, cols);
+    }
+}
+
+void aom_lpf_vertical_14_quad_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    LpfLimits limits;
+    __m256i cols[16], p[8], q[8];
+    lpf_load_limits(blimit, limit, thresh, 0, &limits);
+    lpf_load_cols8(s - 8, pitch, cols);
+    lpf_load_cols8(s, pitch, cols + 8);
+    lpf_split_cols(cols, 8, p, q);
+    if (lpf_14(p, q, &limits, 0)) {
+        lpf_join_cols(p, q, 8, cols);
+        lpf_store_cols8(s - 8, pitch, cols);
+        lpf_store_cols8(s, pitch, cols + 8);
+    }
+}
+
+void aom_highbd_lpf_horizontal_4_quad_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh, int32_t bd) {
+    LpfLimits limits;
+    __m256i p[2], q[2];
+    lpf_load_limits(blimit, limit, thresh, bd - 8, &limits);
+    highbd_lpf_load_horz(s, pitch, 2, p, q);
+    if (lpf_4(p, q, &limits, bd - 8))
+        highbd_lpf_store_horz(s, pitch, 2, p, q);
+}
+
+void aom_highbd_lpf_horizontal_6_quad_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh, int32_t bd) {
+    LpfLimits limits;
+    __m256i p[3], q[3];
+    lpf_load_limits(blimit, limit, thresh, bd - 8, &limits);
+    highbd_lpf_load_horz(s, pitch, 3, p, q);
+    if (lpf_6(p, q, &limits, bd - 8))
+        highbd_lpf_store_horz(s, pitch, 2, p, q);
+}
+
+void aom_highbd_lpf_horizontal_8_quad_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh, int32_t bd) {
+    LpfLimits limits;
+    __m256i p[4], q[4];
+    lpf_load_limits(blimit, limit, thresh, bd - 8, &limits);
+    highbd_lpf_load_horz(s, pitch, 4, p, q);
+    if (lpf_8(p, q, &limits, bd - 8))
+        highbd_lpf_store_horz(s, pitch, 3, p, q);
+}
+
+void aom_highbd_lpf_horizontal_14_quad_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh, int32_t bd) {
+    LpfLimits limits;
+    __m256i p[7], q[7];
+    lpf_load_limits(blimit, limit, thresh, bd - 8, &limits);
+    highbd_lpf_load_horz(s, pitch, 7, p, q);
+    if (lpf_14(p, q, &limits, bd - 8))
+        highbd_lpf_store_horz(s, pitch, 6, p, q);
+}
+
+void aom_highbd_lpf_vertical_4_quad_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh, int32_t bd) {
+    LpfLimits limits;
+    __m256i cols[8], p[4], q[4];
+    lpf_load_limits(blimit, limit, thresh, bd - 8, &limits);
+    highbd_lpf_load_cols8(s - 4, pitch, cols);
+    lpf_split_cols(cols, 4, p, q);
+    if (lpf_4(p, q, &limits, bd - 8)) {
+        lpf_join_cols(p, q, 4, cols);
+        highbd_lpf_store_cols8(s - 4, pitch, cols);
+    }
+}
+
+void aom_highbd_lpf_vertical_6_quad_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh, int32_t bd) {
+    LpfLimits limits;
+    __m256i cols[8], p[4], q[4];
+    lpf_load_limits(blimit, limit, thresh, bd - 8, &limits);
+    highbd_lpf_load_cols8(s - 4, pitch, cols);
+    lpf_split_cols(cols, 4, p, q);
+    if (lpf_6(p, q, &limits, bd - 8)) {
+        lpf_join_cols(p, q, 4, cols);
+        highbd_lpf_store_cols8(s - 4, pitch, cols);
+    }
+}
+
+void aom_highbd_lpf_vertical_8_quad_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh, int32_t bd) {
+    LpfLimits limits;
+    __m256i cols[8], p[4], q[4];
+    lpf_load_limits(blimit, limit, thresh, bd - 8, &limits);
+    highbd_lpf_load_cols8(s - 4, pitch, cols);
+    lpf_split_cols(cols, 4, p, q);
+    if (lpf_8(p, q, &limits, bd - 8)) {
+        lpf_join_cols(p, q, 4, cols);
+        highbd_lpf_store_cols8(s - 4, pitch, cols);
+    }
+}
+
+void aom_highbd_lpf_vertical_14_quad_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh, int32_t bd) {
+    LpfLimits limits;
+    __m256i cols[16], p[8], q[8];
+    lpf_load_limits(blimit, limit, thresh, bd - 8, &limits);
+    highbd_lpf_load_cols8(s - 8, pitch, cols);
+    highbd_lpf_load_cols8(s, pitch, cols + 8);
+    lpf_split_cols(cols, 8, p, q);
+    if (lpf_14(p, q, &limits, bd - 8)) {
+        lpf_join_cols(p, q, 8, cols);
+        highbd_lpf_store_cols8(s - 8, pitch, cols);
+        highbd_lpf_store_cols8(s, pitch, cols + 8);
+    }
+}
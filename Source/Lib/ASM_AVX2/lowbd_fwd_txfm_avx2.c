@@ -0,0 +1,372 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include "EbDefinitions.h"
+#include "aom_dsp_rtcd.h"
+#include "EbTransforms.h"
+#include <immintrin.h>
+static const int32_t NewSqrt2Bits = 12;
+// 2^12 * sqrt(2)
+static const int32_t NewSqrt2 = 5793;
+
+#include "txfm_common_sse2.h"
+#include "av1_txfm_sse2.h"
+#include "transpose_sse2.h"
+
+const int32_t *cospi_arr(int32_t n);
+
+/*****************************************************************************
+ * Forward DCT_DCT of 8 bit residuals with 16 bit intermediates.
+ *
+ * With 9 bit residuals every stage of the 4x4, 8x8 and 16x16 DCT_DCT stays
+ * within int16 (largest intermediate 32639, the 16x16 row transform), so the
+ * butterflies take 16 bit lanes, multiply into 32 bits, round by cos_bit and
+ * pack back: the outputs match Av1TransformTwoD_NxN_c exactly. The other
+ * transform types, and the higher bit depths, go to the 32 bit kernels.
+ *****************************************************************************/
+
+#define pair_set_w16_epi16(a, b) \
+  _mm256_set1_epi32((int32_t)(((uint16_t)(a)) | (((uint32_t)(b)) << 16)))
+
+// out0 = w0 . (in0, in1), out1 = w1 . (in0, in1), as half_btf
+#define btf_16_w16_avx2(w0, w1, in0, in1, out0, out1)       \
+  {                                                         \
+    __m256i t0 = _mm256_unpacklo_epi16(in0, in1);           \
+    __m256i t1 = _mm256_unpackhi_epi16(in0, in1);           \
+    __m256i u0 = _mm256_madd_epi16(t0, w0);                 \
+    __m256i u1 = _mm256_madd_epi16(t1, w0);                 \
+    __m256i v0 = _mm256_madd_epi16(t0, w1);                 \
+    __m256i v1 = _mm256_madd_epi16(t1, w1);                 \
+                                                            \
+    __m256i a0 = _mm256_add_epi32(u0, __rounding_256);      \
+    __m256i a1 = _mm256_add_epi32(u1, __rounding_256);      \
+    __m256i b0 = _mm256_add_epi32(v0, __rounding_256);      \
+    __m256i b1 = _mm256_add_epi32(v1, __rounding_256);      \
+                                                            \
+    __m256i c0 = _mm256_srai_epi32(a0, cos_bit);            \
+    __m256i c1 = _mm256_srai_epi32(a1, cos_bit);            \
+    __m256i d0 = _mm256_srai_epi32(b0, cos_bit);            \
+    __m256i d1 = _mm256_srai_epi32(b1, cos_bit);            \
+                                                            \
+    out0 = _mm256_packs_epi32(c0, c1);                      \
+    out1 = _mm256_packs_epi32(d0, d1);                      \
+  }
+
+// Stages of av1_fdct4_new, 4 lanes of each register
+static AOM_FORCE_INLINE void fdct4_w4_sse2(__m128i *x, const int32_t *cospi, int8_t cos_bit)
+{
+    const __m128i __rounding = _mm_set1_epi32(1 << (cos_bit - 1));
+    const __m128i cospi_p32_p32 = pair_set_epi16(cospi[32], cospi[32]);
+    const __m128i cospi_p32_m32 = pair_set_epi16(cospi[32], -cospi[32]);
+    const __m128i cospi_p48_p16 = pair_set_epi16(cospi[48], cospi[16]);
+    const __m128i cospi_m16_p48 = pair_set_epi16(-cospi[16], cospi[48]);
+    __m128i s0, s1, s2, s3;
+
+    // stage 1
+    s0 = _mm_add_epi16(x[0], x[3]);
+    s1 = _mm_add_epi16(x[1], x[2]);
+    s2 = _mm_sub_epi16(x[1], x[2]);
+    s3 = _mm_sub_epi16(x[0], x[3]);
+
+    // stage 2
+    btf_16_4p_sse2(cospi_p32_p32, cospi_p32_m32, s0, s1, x[0], x[2]);
+    btf_16_4p_sse2(cospi_p48_p16, cospi_m16_p48, s2, s3, x[1], x[3]);
+}
+
+// Stages of av1_fdct8_new, 8 lanes of each register
+static AOM_FORCE_INLINE void fdct8_w8_sse2(__m128i *x, const int32_t *cospi, int8_t cos_bit)
+{
+    const __m128i __rounding = _mm_set1_epi32(1 << (cos_bit - 1));
+    const __m128i cospi_m32_p32 = pair_set_epi16(-cospi[32], cospi[32]);
+    const __m128i cospi_p32_p32 = pair_set_epi16(cospi[32], cospi[32]);
+    const __m128i cospi_p32_m32 = pair_set_epi16(cospi[32], -cospi[32]);
+    const __m128i cospi_p48_p16 = pair_set_epi16(cospi[48], cospi[16]);
+    const __m128i cospi_m16_p48 = pair_set_epi16(-cospi[16], cospi[48]);
+    const __m128i cospi_p56_p08 = pair_set_epi16(cospi[56], cospi[8]);
+    const __m128i cospi_m08_p56 = pair_set_epi16(-cospi[8], cospi[56]);
+    const __m128i cospi_p24_p40 = pair_set_epi16(cospi[24], cospi[40]);
+    const __m128i cospi_m40_p24 = pair_set_epi16(-cospi[40], cospi[24]);
+    __m128i s[8], t[8];
+
+    // stage 1
+    s[0] = _mm_add_epi16(x[0], x[7]);
+    s[1] = _mm_add_epi16(x[1], x[6]);
+    s[2] = _mm_add_epi16(x[2], x[5]);
+    s[3] = _mm_add_epi16(x[3], x[4]);
+    s[4] = _mm_sub_epi16(x[3], x[4]);
+    s[5] = _mm_sub_epi16(x[2], x[5]);
+    s[6] = _mm_sub_epi16(x[1], x[6]);
+    s[7] = _mm_sub_epi16(x[0], x[7]);
+
+    // stage 2
+    t[0] = _mm_add_epi16(s[0], s[3]);
+    t[1] = _mm_add_epi16(s[1], s[2]);
+    t[2] = _mm_sub_epi16(s[1], s[2]);
+    t[3] = _mm_sub_epi16(s[0], s[3]);
+    btf_16_sse2(cospi_m32_p32, cospi_p32_p32, s[5], s[6], t[5], t[6]);
+
+    // stage 3
+    btf_16_sse2(cospi_p32_p32, cospi_p32_m32, t[0], t[1], x[0], x[4]);
+    btf_16_sse2(cospi_p48_p16, cospi_m16_p48, t[2], t[3], x[2], x[6]);
+    s[5] = _mm_sub_epi16(s[4], t[5]);
+    s[4] = _mm_add_epi16(s[4], t[5]);
+    s[6] = _mm_sub_epi16(s[7], t[6]);
+    s[7] = _mm_add_epi16(s[7], t[6]);
+
+    // stage 4 and 5
+    btf_16_sse2(cospi_p56_p08, cospi_m08_p56, s[4], s[7], x[1], x[7]);
+    btf_16_sse2(cospi_p24_p40, cospi_m40_p24, s[5], s[6], x[5], x[3]);
+}
+
+// Stages of av1_fdct16_new, 16 lanes of each register
+static AOM_FORCE_INLINE void fdct16_w16_avx2(__m256i *x, const int32_t *cospi, int8_t cos_bit)
+{
+    const __m256i __rounding_256 = _mm256_set1_epi32(1 << (cos_bit - 1));
+    const __m256i cospi_m32_p32 = pair_set_w16_epi16(-cospi[32], cospi[32]);
+    const __m256i cospi_p32_p32 = pair_set_w16_epi16(cospi[32], cospi[32]);
+    const __m256i cospi_p32_m32 = pair_set_w16_epi16(cospi[32], -cospi[32]);
+    const __m256i cospi_p48_p16 = pair_set_w16_epi16(cospi[48], cospi[16]);
+    const __m256i cospi_m16_p48 = pair_set_w16_epi16(-cospi[16], cospi[48]);
+    const __m256i cospi_m48_m16 = pair_set_w16_epi16(-cospi[48], -cospi[16]);
+    const __m256i cospi_p56_p08 = pair_set_w16_epi16(cospi[56], cospi[8]);
+    const __m256i cospi_m08_p56 = pair_set_w16_epi16(-cospi[8], cospi[56]);
+    const __m256i cospi_p24_p40 = pair_set_w16_epi16(cospi[24], cospi[40]);
+    const __m256i cospi_m40_p24 = pair_set_w16_epi16(-cospi[40], cospi[24]);
+    const __m256i cospi_p60_p04 = pair_set_w16_epi16(cospi[60], cospi[4]);
+    const __m256i cospi_m04_p60 = pair_set_w16_epi16(-cospi[4], cospi[60]);
+    const __m256i cospi_p28_p36 = pair_set_w16_epi16(cospi[28], cospi[36]);
+    const __m256i cospi_m36_p28 = pair_set_w16_epi16(-cospi[36], cospi[28]);
+    const __m256i cospi_p44_p20 = pair_set_w16_epi16(cospi[44], cospi[20]);
+    const __m256i cospi_m20_p44 = pair_set_w16_epi16(-cospi[20], cospi[44]);
+    const __m256i cospi_p12_p52 = pair_set_w16_epi16(cospi[12], cospi[52]);
+    const __m256i cospi_m52_p12 = pair_set_w16_epi16(-cospi[52], cospi[12]);
+    __m256i a[16], b[16];
+
+    // stage 1
+    a[0] = _mm256_add_epi16(x[0], x[15]);
+    a[1] = _mm256_add_epi16(x[1], x[14]);
+    a[2] = _mm256_add_epi16(x[2], x[13]);
+    a[3] = _mm256_add_epi16(x[3], x[12]);
+    a[4] = _mm256_add_epi16(x[4], x[11]);
+    a[5] = _mm256_add_epi16(x[5], x[10]);
+    a[6] = _mm256_add_epi16(x[6], x[9]);
+    a[7] = _mm256_add_epi16(x[7], x[8]);
+    a[8] = _mm256_sub_epi16(x[7], x[8]);
+    a[9] = _mm256_sub_epi16(x[6], x[9]);
+    a[10] = _mm256_sub_epi16(x[5], x[10]);
+    a[11] = _mm256_sub_epi16(x[4], x[11]);
+    a[12] = _mm256_sub_epi16(x[3], x[12]);
+    a[13] = _mm256_sub_epi16(x[2], x[13]);
+    a[14] = _mm256_sub_epi16(x[1], x[14]);
+    a[15] = _mm256_sub_epi16(x[0], x[15]);
+
+    // stage 2
+    b[0] = _mm256_add_epi16(a[0], a[7]);
+    b[1] = _mm256_add_epi16(a[1], a[6]);
+    b[2] = _mm256_add_epi16(a[2], a[5]);
+    b[3] = _mm256_add_epi16(a[3], a[4]);
+    b[4] = _mm256_sub_epi16(a[3], a[4]);
+    b[5] = _mm256_sub_epi16(a[2], a[5]);
+    b[6] = _mm256_sub_epi16(a[1], a[6]);
+    b[7] = _mm256_sub_epi16(a[0], a[7]);
+    b[8] = a[8];
+    b[9] = a[9];
+    btf_16_w16_avx2(cospi_m32_p32, cospi_p32_p32, a[10], a[13], b[10], b[13]);
+    btf_16_w16_avx2(cospi_m32_p32, cospi_p32_p32, a[11], a[12], b[11], b[12]);
+    b[14] = a[14];
+    b[15] = a[15];
+
+    // stage 3
+    a[0] = _mm256_add_epi16(b[0], b[3]);
+    a[1] = _mm256_add_epi16(b[1], b[2]);
+    a[2] = _mm256_sub_epi16(b[1], b[2]);
+    a[3] = _mm256_sub_epi16(b[0], b[3]);
+    a[4] = b[4];
+    btf_16_w16_avx2(cospi_m32_p32, cospi_p32_p32, b[5], b[6], a[5], a[6]);
+    a[7] = b[7];
+    a[8] = _mm256_add_epi16(b[8], b[11]);
+    a[9] = _mm256_add_epi16(b[9], b[10]);
+    a[10] = _mm256_sub_epi16(b[9], b[10]);
+    a[11] = _mm256_sub_epi16(b[8], b[11]);
+    a[12] = _mm256_sub_epi16(b[15], b[12]);
+    a[13] = _mm256_sub_epi16(b[14], b[13]);
+    a[14] = _mm256_add_epi16(b[14], b[13]);
+    a[15] = _mm256_add_epi16(b[15], b[12]);
+
+    // stage 4
+    btf_16_w16_avx2(cospi_p32_p32, cospi_p32_m32, a[0], a[1], b[0], b[1]);
+    btf_16_w16_avx2(cospi_p48_p16, cospi_m16_p48, a[2], a[3], b[2], b[3]);
+    b[4] = _mm256_add_epi16(a[4], a[5]);
+    b[5] = _mm256_sub_epi16(a[4], a[5]);
+    b[6] = _mm256_sub_epi16(a[7], a[6]);
+    b[7] = _mm256_add_epi16(a[7], a[6]);
+    b[8] = a[8];
+    btf_16_w16_avx2(cospi_m16_p48, cospi_p48_p16, a[9], a[14], b[9], b[14]);
+    btf_16_w16_avx2(cospi_m48_m16, cospi_m16_p48, a[10], a[13], b[10], b[13]);
+    b[11] = a[11];
+    b[12] = a[12];
+    b[15] = a[15];
+
+    // stage 5
+    btf_16_w16_avx2(cospi_p56_p08, cospi_m08_p56, b[4], b[7], a[4], a[7]);
+    btf_16_w16_avx2(cospi_p24_p40, cospi_m40_p24, b[5], b[6], a[5], a[6]);
+    a[8] = _mm256_add_epi16(b[8], b[9]);
+    a[9] = _mm256_sub_epi16(b[8], b[9]);
+    a[10] = _mm256_sub_epi16(b[11], b[10]);
+    a[11] = _mm256_add_epi16(b[11], b[10]);
+    a[12] = _mm256_add_epi16(b[12], b[13]);
+    a[13] = _mm256_sub_epi16(b[12], b[13]);
+    a[14] = _mm256_sub_epi16(b[15], b[14]);
+    a[15] = _mm256_add_epi16(b[15], b[14]);
+
+    // stage 6 and 7
+    x[0] = b[0];
+    x[2] = a[4];
+    x[4] = b[2];
+    x[6] = a[6];
+    x[8] = b[1];
+    x[10] = a[5];
+    x[12] = b[3];
+    x[14] = a[7];
+    btf_16_w16_avx2(cospi_p60_p04, cospi_m04_p60, a[8], a[15], x[1], x[15]);
+    btf_16_w16_avx2(cospi_p28_p36, cospi_m36_p28, a[9], a[14], x[9], x[7]);
+    btf_16_w16_avx2(cospi_p44_p20, cospi_m20_p44, a[10], a[13], x[5], x[11]);
+    btf_16_w16_avx2(cospi_p12_p52, cospi_m52_p12, a[11], a[12], x[13], x[3]);
+}
+
+// transpose_16bit_8x8 within each 128 bit lane
+static AOM_FORCE_INLINE void transpose_16bit_8x8_avx2(const __m256i *in, __m256i *out)
+{
+    const __m256i a0 = _mm256_unpacklo_epi16(in[0], in[1]);
+    const __m256i a1 = _mm256_unpacklo_epi16(in[2], in[3]);
+    const __m256i a2 = _mm256_unpacklo_epi16(in[4], in[5]);
+    const __m256i a3 = _mm256_unpacklo_epi16(in[6], in[7]);
+    const __m256i a4 = _mm256_unpackhi_epi16(in[0], in[1]);
+    const __m256i a5 = _mm256_unpackhi_epi16(in[2], in[3]);
+    const __m256i a6 = _mm256_unpackhi_epi16(in[4], in[5]);
+    const __m256i a7 = _mm256_unpackhi_epi16(in[6], in[7]);
+
+    const __m256i b0 = _mm256_unpacklo_epi32(a0, a1);
+    const __m256i b1 = _mm256_unpacklo_epi32(a2, a3);
+    const __m256i b2 = _mm256_unpacklo_epi32(a4, a5);
+    const __m256i b3 = _mm256_unpacklo_epi32(a6, a7);
+    const __m256i b4 = _mm256_unpackhi_epi32(a0, a1);
+    const __m256i b5 = _mm256_unpackhi_epi32(a2, a3);
+    const __m256i b6 = _mm256_unpackhi_epi32(a4, a5);
+    const __m256i b7 = _mm256_unpackhi_epi32(a6, a7);
+
+    out[0] = _mm256_unpacklo_epi64(b0, b1);
+    out[1] = _mm256_unpackhi_epi64(b0, b1);
+    out[2] = _mm256_unpacklo_epi64(b4, b5);
+    out[3] = _mm256_unpackhi_epi64(b4, b5);
+    out[4] = _mm256_unpacklo_epi64(b2, b3);
+    out[5] = _mm256_unpackhi_epi64(b2, b3);
+    out[6] = _mm256_unpacklo_epi64(b6, b7);
+    out[7] = _mm256_unpackhi_epi64(b6, b7);
+}
+
+// The 8x8 transposes of the upper and lower halves, then their lanes exchanged
+static AOM_FORCE_INLINE void transpose_16bit_16x16_avx2(const __m256i *in, __m256i *out)
+{
+    __m256i b[16];
+    transpose_16bit_8x8_avx2(in, b);
+    transpose_16bit_8x8_avx2(in + 8, b + 8);
+    out[0] = _mm256_permute2x128_si256(b[0], b[8], 0x20);
+    out[8] = _mm256_permute2x128_si256(b[0], b[8], 0x31);
+    out[1] = _mm256_permute2x128_si256(b[1], b[9], 0x20);
+    out[9] = _mm256_permute2x128_si256(b[1], b[9], 0x31);
+    out[2] = _mm256_permute2x128_si256(b[2], b[10], 0x20);
+    out[10] = _mm256_permute2x128_si256(b[2], b[10], 0x31);
+    out[3] = _mm256_permute2x128_si256(b[3], b[11], 0x20);
+    out[11] = _mm256_permute2x128_si256(b[3], b[11], 0x31);
+    out[4] = _mm256_permute2x128_si256(b[4], b[12], 0x20);
+    out[12] = _mm256_permute2x128_si256(b[4], b[12], 0x31);
+    out[5] = _mm256_permute2x128_si256(b[5], b[13], 0x20);
+    out[13] = _mm256_permute2x128_si256(b[5], b[13], 0x31);
+    out[6] = _mm256_permute2x128_si256(b[6], b[14], 0x20);
+    out[14] = _mm256_permute2x128_si256(b[6], b[14], 0x31);
+    out[7] = _mm256_permute2x128_si256(b[7], b[15], 0x20);
+    out[15] = _mm256_permute2x128_si256(b[7], b[15], 0x31);
+}
+
+static INLINE void store_w16_16bit_to_32bit(const __m256i a, int32_t *b)
+{
+    _mm256_storeu_si256((__m256i *)b, _mm256_cvtepi16_epi32(_mm256_castsi256_si128(a)));
+    _mm256_storeu_si256((__m256i *)(b + 8), _mm256_cvtepi16_epi32(_mm256_extracti128_si256(a, 1)));
+}
+
+void av1_lowbd_fwd_txfm2d_4x4_avx2(int16_t *input, int32_t *output, uint32_t inputStride, TxType transform_type, uint8_t  bit_depth)
+{
+    const int8_t cos_bit_col = fwd_cos_bit_col[TX_4X4][TX_4X4];
+    const int8_t cos_bit_row = fwd_cos_bit_row[TX_4X4][TX_4X4];
+    __m128i buf0[4], buf1[4];
+    int32_t i;
+
+    if (transform_type != DCT_DCT || bit_depth != EB_8BIT) {
+        av1_fwd_txfm2d_4x4_sse4_1(input, output, inputStride, transform_type, bit_depth);
+        return;
+    }
+
+    for (i = 0; i < 4; ++i)
+        buf0[i] = _mm_slli_epi16(_mm_loadl_epi64((const __m128i *)(input + i * inputStride)), fwd_shift_4x4[0]);
+    fdct4_w4_sse2(buf0, cospi_arr(cos_bit_col), cos_bit_col);
+    transpose_16bit_4x4(buf0, buf1);
+    fdct4_w4_sse2(buf1, cospi_arr(cos_bit_row), cos_bit_row);
+    transpose_16bit_4x4(buf1, buf0);
+    for (i = 0; i < 4; ++i)
+        _mm_storeu_si128((__m128i *)(output + i * 4), _mm_cvtepi16_epi32(buf0[i]));
+}
+
+void av1_lowbd_fwd_txfm2d_8x8_avx2(int16_t *input, int32_t *output, uint32_t inputStride, TxType transform_type, uint8_t  bit_depth)
+{
+    const int8_t cos_bit_col = fwd_cos_bit_col[TX_8X8][TX_8X8];
+    const int8_t cos_bit_row = fwd_cos_bit_row[TX_8X8][TX_8X8];
+    const int32_t *cospi = cospi_arr(cos_bit_col);
+    const __m128i rounding = _mm_set1_epi16(1 << (-fwd_shift_8x8[1] - 1));
+    __m128i buf0[8], buf1[8];
+    int32_t i;
+
+    if (transform_type != DCT_DCT || bit_depth != EB_8BIT) {
+        av1_fwd_txfm2d_8x8_avx2(input, output, inputStride, transform_type, bit_depth);
+        return;
+    }
+
+    for (i = 0; i < 8; ++i)
+        buf0[i] = _mm_slli_epi16(_mm_loadu_si128((const __m128i *)(input + i * inputStride)), fwd_shift_8x8[0]);
+    fdct8_w8_sse2(buf0, cospi, cos_bit_col);
+    for (i = 0; i < 8; ++i)
+        buf0[i] = _mm_srai_epi16(_mm_add_epi16(buf0[i], rounding), -fwd_shift_8x8[1]);
+    transpose_16bit_8x8(buf0, buf1);
+    // Both passes take the same cos_bit
+    fdct8_w8_sse2(buf1, cos_bit_row == cos_bit_col ? cospi : cospi_arr(cos_bit_row), cos_bit_row);
+    transpose_16bit_8x8(buf1, buf0);
+    for (i = 0; i < 8; ++i)
+        _mm256_storeu_si256((__m256i *)(output + i * 8), _mm256_cvtepi16_epi32(buf0[i]));
+}
+
+void av1_lowbd_fwd_txfm2d_16x16_avx2(int16_t *input, int32_t *output, uint32_t inputStride, TxType transform_type, uint8_t  bit_depth)
+{
+    const int8_t cos_bit_col = fwd_cos_bit_col[TX_16X16][TX_16X16];
+    const int8_t cos_bit_row = fwd_cos_bit_row[TX_16X16][TX_16X16];
+    const __m256i rounding = _mm256_set1_epi16(1 << (-fwd_shift_16x16[1] - 1));
+    __m256i buf0[16], buf1[16];
+    int32_t i;
+
+    if (transform_type != DCT_DCT || bit_depth != EB_8BIT) {
+        av1_fwd_txfm2d_16x16_avx2(input, output, inputStride, transform_type, bit_depth);
+        return;
+    }
+
+    for (i = 0; i < 16; ++i)
+        buf0[i] = _mm256_slli_epi16(_mm256_loadu_si256((const __m256i *)(input + i * inputStride)), fwd_shift_16x16[0]);
+    fdct16_w16_avx2(buf0, cospi_arr(cos_bit_col), cos_bit_col);
+    for (i = 0; i < 16; ++i)
+        buf0[i] = _mm256_srai_epi16(_mm256_add_epi16(buf0[i], rounding), -fwd_shift_16x16[1]);
+    transpose_16bit_16x16_avx2(buf0, buf1);
+    fdct16_w16_avx2(buf1, cospi_arr(cos_bit_row), cos_bit_row);
+    transpose_16bit_16x16_avx2(buf1, buf0);
+    for (i = 0; i < 16; ++i)
+        store_w16_16bit_to_32bit(buf0[i], output + i * 16);
+}
@@ -0,0 +1,202 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include "EbDefinitions.h"
+#include <immintrin.h>
+
+#include "aom_dsp_rtcd.h"
+
+#ifdef __GNUC__
+#define LIKELY(v) __builtin_expect(v, 1)
+#define UNLIKELY(v) __builtin_expect(v, 0)
+#else
+#define LIKELY(v) (v)
+#define UNLIKELY(v) (v)
+#endif
+
+typedef int32_t tran_low_t;
+
+/*****************************************************************************
+ * Quantizer of the 8 bit coefficients, 16 of them per register.
+ *
+ * Same arithmetic as aom_highbd_quantize_b*_avx2 on 16 bit lanes: the products
+ * by quant and quant_shift are taken from mulhi/mullo. It is exact as long as
+ * abs(coeff) + round stays below 2^15, which covers the 8 bit residuals but
+ * the largest 64x64 DC terms; a block with such a coefficient is handed over
+ * to the 32 bit kernel.
+ *****************************************************************************/
+
+// The tables hold the DC value then 7 times the AC one: lanes 0-7 take them
+// as they are, the other lanes the AC value
+static INLINE __m256i load_qp_lowbd(__m128i p) {
+    return _mm256_inserti128_si256(_mm256_broadcastw_epi16(_mm_srli_si128(p, 2)), p, 0);
+}
+
+// zbin, round, quant, dequant, quant_shift and the overflow limit
+static INLINE void init_qp_lowbd(const int16_t *zbin_ptr, const int16_t *round_ptr,
+    const int16_t *quant_ptr, const int16_t *dequant_ptr,
+    const int16_t *quant_shift_ptr, int32_t log_scale, __m256i *qp) {
+    const __m128i add = _mm_set1_epi16((int16_t)((1 << log_scale) >> 1));
+    const __m128i zbin = _mm_loadu_si128((const __m128i *)zbin_ptr);
+    const __m128i round = _mm_loadu_si128((const __m128i *)round_ptr);
+    qp[0] = load_qp_lowbd(_mm_srli_epi16(_mm_add_epi16(zbin, add), log_scale));
+    qp[1] = load_qp_lowbd(_mm_srli_epi16(_mm_add_epi16(round, add), log_scale));
+    qp[2] = load_qp_lowbd(_mm_loadu_si128((const __m128i *)quant_ptr));
+    qp[3] = load_qp_lowbd(_mm_loadu_si128((const __m128i *)dequant_ptr));
+    qp[4] = load_qp_lowbd(_mm_loadu_si128((const __m128i *)quant_shift_ptr));
+    qp[5] = _mm256_sub_epi16(_mm256_set1_epi16(INT16_MAX), qp[1]);
+}
+
+// Past the first 16 coefficients, every lane takes the AC value
+static INLINE void update_qp_lowbd(__m256i *qp) {
+    int32_t i;
+    for (i = 0; i < 6; i++)
+        qp[i] = _mm256_broadcastw_epi16(_mm_srli_si128(_mm256_castsi256_si128(qp[i]), 2));
+}
+
+// Quantizes 16 coefficients, returns the lanes out of the 16 bit range
+static INLINE __m256i quantize_lowbd(const __m256i *qp, const tran_low_t *coeff_ptr,
+    const int16_t *iscan_ptr, tran_low_t *qcoeff, tran_low_t *dqcoeff,
+    int32_t log_scale, __m256i *eob) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i c0 = _mm256_loadu_si256((const __m256i *)coeff_ptr);
+    const __m256i c1 = _mm256_loadu_si256((const __m256i *)(coeff_ptr + 8));
+    // Lanes hold coefficients 0-3, 8-11 | 4-7, 12-15
+    const __m256i abs = _mm256_abs_epi16(_mm256_packs_epi32(c0, c1));
+    const __m256i overflow = _mm256_cmpeq_epi16(_mm256_max_epu16(abs, qp[5]), abs);
+    const __m256i below = _mm256_cmpgt_epi16(qp[0], abs);
+
+    if (LIKELY(_mm256_movemask_epi8(below) != -1)) {
+        __m256i q = _mm256_add_epi16(abs, qp[1]);
+        q = _mm256_add_epi16(_mm256_mulhi_epi16(q, qp[2]), q);
+        if (log_scale) {
+            const __m256i hi = _mm256_mulhi_epu16(q, qp[4]);
+            const __m256i lo = _mm256_mullo_epi16(q, qp[4]);
+            q = _mm256_or_si256(_mm256_slli_epi16(hi, log_scale), _mm256_srli_epi16(lo, 16 - log_scale));
+        }
+        else
+            q = _mm256_mulhi_epu16(q, qp[4]);
+        q = _mm256_andnot_si256(below, q);
+
+        const __m256i dq_lo = _mm256_mullo_epi16(q, qp[3]);
+        const __m256i dq_hi = _mm256_mulhi_epu16(q, qp[3]);
+        const __m256i dq0 = _mm256_srli_epi32(_mm256_unpacklo_epi16(dq_lo, dq_hi), log_scale);
+        const __m256i dq1 = _mm256_srli_epi32(_mm256_unpackhi_epi16(dq_lo, dq_hi), log_scale);
+
+        _mm256_storeu_si256((__m256i *)qcoeff, _mm256_sign_epi32(_mm256_unpacklo_epi16(q, zero), c0));
+        _mm256_storeu_si256((__m256i *)(qcoeff + 8), _mm256_sign_epi32(_mm256_unpackhi_epi16(q, zero), c1));
+        _mm256_storeu_si256((__m256i *)dqcoeff, _mm256_sign_epi32(dq0, c0));
+        _mm256_storeu_si256((__m256i *)(dqcoeff + 8), _mm256_sign_epi32(dq1, c1));
+
+        // The dequantized value is nonzero with q, dequant being at least 4
+        const __m256i iscan = _mm256_permute4x64_epi64(
+            _mm256_loadu_si256((const __m256i *)iscan_ptr), 0xd8);
+        const __m256i cur_eob = _mm256_andnot_si256(_mm256_cmpeq_epi16(q, zero),
+            _mm256_add_epi16(iscan, _mm256_set1_epi16(1)));
+        *eob = _mm256_max_epi16(cur_eob, *eob);
+    }
+    else {
+        _mm256_storeu_si256((__m256i *)qcoeff, zero);
+        _mm256_storeu_si256((__m256i *)(qcoeff + 8), zero);
+        _mm256_storeu_si256((__m256i *)dqcoeff, zero);
+        _mm256_storeu_si256((__m256i *)(dqcoeff + 8), zero);
+    }
+    return overflow;
+}
+
+// Returns 0 when a coefficient is out of the 16 bit range, the outputs being
+// left for the 32 bit kernel
+static INLINE int32_t quantize_b_lowbd(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+    const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr,
+    const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+    const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *iscan,
+    int32_t log_scale) {
+    const uint32_t step = 16;
+    __m256i qp[6];
+    __m256i eob = _mm256_setzero_si256();
+    __m256i overflow = _mm256_setzero_si256();
+    intptr_t i;
+
+    init_qp_lowbd(zbin_ptr, round_ptr, quant_ptr, dequant_ptr, quant_shift_ptr, log_scale, qp);
+    overflow = quantize_lowbd(qp, coeff_ptr, iscan, qcoeff_ptr, dqcoeff_ptr, log_scale, &eob);
+
+    if (n_coeffs > step) {
+        update_qp_lowbd(qp);
+        for (i = step; i < n_coeffs; i += step) {
+            overflow = _mm256_or_si256(overflow, quantize_lowbd(qp, coeff_ptr + i,
+                iscan + i, qcoeff_ptr + i, dqcoeff_ptr + i, log_scale, &eob));
+        }
+    }
+    if (UNLIKELY(_mm256_movemask_epi8(overflow)))
+        return 0;
+
+    {
+        __m128i final_eob = _mm_max_epi16(_mm256_castsi256_si128(eob), _mm256_extracti128_si256(eob, 1));
+        final_eob = _mm_max_epi16(final_eob, _mm_srli_si128(final_eob, 8));
+        final_eob = _mm_max_epi16(final_eob, _mm_srli_si128(final_eob, 4));
+        final_eob = _mm_max_epi16(final_eob, _mm_srli_si128(final_eob, 2));
+        *eob_ptr = (uint16_t)_mm_extract_epi16(final_eob, 0);
+    }
+    return 1;
+}
+
+static INLINE void quantize_b_skip(intptr_t n_coeffs, tran_low_t *qcoeff_ptr,
+    tran_low_t *dqcoeff_ptr, uint16_t *eob_ptr) {
+    const __m256i zero = _mm256_setzero_si256();
+    intptr_t i;
+    for (i = 0; i < n_coeffs; i += 8) {
+        _mm256_storeu_si256((__m256i *)(qcoeff_ptr + i), zero);
+        _mm256_storeu_si256((__m256i *)(dqcoeff_ptr + i), zero);
+    }
+    *eob_ptr = 0;
+}
+
+void aom_quantize_b_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+    int32_t skip_block, const int16_t *zbin_ptr,
+    const int16_t *round_ptr,
+    const int16_t *quant_ptr,
+    const int16_t *quant_shift_ptr,
+    tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+    const int16_t *dequant_ptr, uint16_t *eob_ptr,
+    const int16_t *scan, const int16_t *iscan) {
+    if (UNLIKELY(skip_block))
+        quantize_b_skip(n_coeffs, qcoeff_ptr, dqcoeff_ptr, eob_ptr);
+    else if (!quantize_b_lowbd(coeff_ptr, n_coeffs, zbin_ptr, round_ptr, quant_ptr, quant_shift_ptr,
+        qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr, iscan, 0))
+        aom_highbd_quantize_b_avx2(coeff_ptr, n_coeffs, skip_block, zbin_ptr, round_ptr, quant_ptr,
+            quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr, scan, iscan);
+}
+
+void aom_quantize_b_32x32_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+    int32_t skip_block, const int16_t *zbin_ptr,
+    const int16_t *round_ptr,
+    const int16_t *quant_ptr,
+    const int16_t *quant_shift_ptr,
+    tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+    const int16_t *dequant_ptr, uint16_t *eob_ptr,
+    const int16_t *scan, const int16_t *iscan) {
+    if (UNLIKELY(skip_block))
+        quantize_b_skip(n_coeffs, qcoeff_ptr, dqcoeff_ptr, eob_ptr);
+    else if (!quantize_b_lowbd(coeff_ptr, n_coeffs, zbin_ptr, round_ptr, quant_ptr, quant_shift_ptr,
+        qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr, iscan, 1))
+        aom_highbd_quantize_b_32x32_avx2(coeff_ptr, n_coeffs, skip_block, zbin_ptr, round_ptr, quant_ptr,
+            quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr, scan, iscan);
+}
+
+void aom_quantize_b_64x64_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs,
+    int32_t skip_block, const int16_t *zbin_ptr,
+    const int16_t *round_ptr,
+    const int16_t *quant_ptr,
+    const int16_t *quant_shift_ptr,
+    tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr,
+    const int16_t *dequant_ptr, uint16_t *eob_ptr,
+    const int16_t *scan, const int16_t *iscan) {
+    if (UNLIKELY(skip_block))
+        quantize_b_skip(n_coeffs, qcoeff_ptr, dqcoeff_ptr, eob_ptr);
+    else if (!quantize_b_lowbd(coeff_ptr, n_coeffs, zbin_ptr, round_ptr, quant_ptr, quant_shift_ptr,
+        qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr, iscan, 2))
+        aom_highbd_quantize_b_64x64_avx2(coeff_ptr, n_coeffs, skip_block, zbin_ptr, round_ptr, quant_ptr,
+            quant_shift_ptr, qcoeff_ptr, dqcoeff_ptr, dequant_ptr, eob_ptr, scan, iscan);
+}
@@ -0,0 +1,256 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include "EbComputeSAD_AVX512.h"
+#include "EbDefinitions.h"
+#include "immintrin.h"
+
+/*******************************************************************************
+* Requirement: height % 2 = 0
+*******************************************************************************/
+uint32_t Compute32xMSad_AVX512_INTRIN(
+    uint8_t  *src,        // input parameter, source samples Ptr
+    uint32_t  src_stride,  // input parameter, source stride
+    uint8_t  *ref,        // input parameter, reference samples Ptr
+    uint32_t  refStride,  // input parameter, reference stride
+    uint32_t  height,     // input parameter, block height (M)
+    uint32_t  width)     // input parameter, block width (N)
+{
+    __m512i zmm0, zmm1, zmm2;
+    __m256i ymm0;
+    __m128i xmm0;
+    uint32_t y;
+    (void)width;
+
+    zmm0 = _mm512_setzero_si512();
+    for (y = 0; y < height; y += 2) {
+        zmm1 = _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_loadu_si256((__m256i*)src)), _mm256_loadu_si256((__m256i*)(src + src_stride)), 1);
+        zmm2 = _mm512_inserti64x4(_mm512_castsi256_si512(_mm256_loadu_si256((__m256i*)ref)), _mm256_loadu_si256((__m256i*)(ref + refStride)), 1);
+        zmm0 = _mm512_add_epi32(zmm0, _mm512_sad_epu8(zmm1, zmm2));
+        src += src_stride << 1;
+        ref += refStride << 1;
+    }
+    ymm0 = _mm256_add_epi32(_mm512_castsi512_si256(zmm0), _mm512_extracti64x4_epi64(zmm0, 1));
+    xmm0 = _mm_add_epi32(_mm256_castsi256_si128(ymm0), _mm256_extracti128_si256(ymm0, 1));
+    xmm0 = _mm_add_epi32(xmm0, _mm_srli_si128(xmm0, 8));
+    return (uint32_t)_mm_cvtsi128_si32(xmm0);
+}
+
+/*******************************************************************************
+* Requirement: height % 2 = 0
+*******************************************************************************/
+uint32_t Compute64xMSad_AVX512_INTRIN(
+    uint8_t  *src,        // input parameter, source samples Ptr
+    uint32_t  src_stride,  // input parameter, source stride
+    uint8_t  *ref,        // input parameter, reference samples Ptr
+    uint32_t  refStride,  // input parameter, reference stride
+    uint32_t  height,     // input parameter, block height (M)
+    uint32_t  width)     // input parameter, block width (N)
+{
+    __m512i zmm0, zmm1;
+    __m256i ymm0;
+    __m128i xmm0;
+    uint32_t y;
+    (void)width;
+
+    zmm0 = zmm1 = _mm512_setzero_si512();
+    for (y = 0; y < height; y += 2) {
+        zmm0 = _mm512_add_epi32(zmm0, _mm512_sad_epu8(_mm512_loadu_si512((__m512i*)src), _mm512_loadu_si512((__m512i*)ref)));
+        zmm1 = _mm512_add_epi32(zmm1, _mm512_sad_epu8(_mm512_loadu_si512((__m512i*)(src + src_stride)), _mm512_loadu_si512((__m512i*)(ref + refStride))));
+        src += src_stride << 1;
+        ref += refStride << 1;
+    }
+    zmm0 = _mm512_add_epi32(zmm0, zmm1);
+    ymm0 = _mm256_add_epi32(_mm512_castsi512_si256(zmm0), _mm512_extracti64x4_epi64(zmm0, 1));
+    xmm0 = _mm_add_epi32(_mm256_castsi256_si128(ymm0), _mm256_extracti128_si256(ymm0, 1));
+    xmm0 = _mm_add_epi32(xmm0, _mm_srli_si128(xmm0, 8));
+    return (uint32_t)_mm_cvtsi128_si32(xmm0);
+}
+
+/*******************************************************************************
+* SADs of one 16 samples source line against the 8 horizontal search points.
+* 128-bit lane l holds the 8 SADs of the source quadruplet l: vdbpsadbw
+* compares the quadruplet, broadcast by srcIdx, with the reference dwords
+* l, l+1, l+1, l+2 picked by refIdx and imm8 0x94, i.e. at offsets 0 to 7.
+*******************************************************************************/
+static INLINE __m512i EightPointSad16x1(
+    uint8_t  *src,
+    uint8_t  *ref,
+    __m512i   srcIdx,
+    __m512i   refIdx)
+{
+    const __m512i s = _mm512_permutexvar_epi32(srcIdx, _mm512_castsi128_si512(_mm_loadu_si128((__m128i*)src)));
+    const __m512i r = _mm512_permutexvar_epi32(refIdx, _mm512_castsi256_si512(_mm256_maskz_loadu_epi8(0x00FFFFFF, ref)));
+    return _mm512_dbsad_epu8(s, r, 0x94);
+}
+
+/*******************************************************************************
+* Requirement: p_best_sad8x8[i] must be less than 0x7FFFFFFF because signed comparison is used.
+*******************************************************************************/
+void GetEightHorizontalSearchPointResults_8x8_16x16_PU_AVX512_INTRIN(
+    uint8_t   *src,
+    uint32_t   src_stride,
+    uint8_t   *ref,
+    uint32_t   refStride,
+    uint32_t  *p_best_sad8x8,
+    uint32_t  *p_best_mv8x8,
+    uint32_t  *p_best_sad16x16,
+    uint32_t  *p_best_mv16x16,
+    uint32_t   mv,
+    uint16_t  *p_sad16x16)
+{
+    int16_t x_mv, y_mv;
+    __m128i s3;
+    __m128i sad_0, sad_1, sad_2, sad_3;
+    __m512i top, bottom;
+    uint32_t temSum, y;
+    const __m512i srcIdx = _mm512_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3);
+    const __m512i refIdx = _mm512_setr_epi32(0, 1, 2, 2, 1, 2, 3, 3, 2, 3, 4, 4, 3, 4, 5, 5);
+
+    // Every other line of the 16x16 block: lines 0 to 6 for 8x8_0 & 8x8_1
+    // and lines 8 to 14 for 8x8_2 & 8x8_3. The 16-bit sums cannot saturate
+    // (at most 8 x 16 x 255).
+    top = bottom = _mm512_setzero_si512();
+    for (y = 0; y < 8; y += 2) {
+        top = _mm512_add_epi16(top, EightPointSad16x1(src + y * src_stride, ref + y * refStride, srcIdx, refIdx));
+        bottom = _mm512_add_epi16(bottom, EightPointSad16x1(src + (y + 8) * src_stride, ref + (y + 8) * refStride, srcIdx, refIdx));
+    }
+    top = _mm512_add_epi16(top, _mm512_shuffle_i32x4(top, top, 0xB1));
+    bottom = _mm512_add_epi16(bottom, _mm512_shuffle_i32x4(bottom, bottom, 0xB1));
+    sad_0 = _mm512_castsi512_si128(top);
+    sad_1 = _mm512_extracti32x4_epi32(top, 2);
+    sad_2 = _mm512_castsi512_si128(bottom);
+    sad_3 = _mm512_extracti32x4_epi32(bottom, 2);
+
+    //16x16
+    s3 = _mm_adds_epu16(_mm_adds_epu16(sad_0, sad_1), _mm_adds_epu16(sad_2, sad_3));
+    //sotore the 8 SADs(16x8 SADs)
+    _mm_store_si128((__m128i*)p_sad16x16, s3);
+    //find the best for 16x16
+    s3 = _mm_minpos_epu16(s3);
+    temSum = _mm_extract_epi16(s3, 0) << 1;
+    if (temSum < p_best_sad16x16[0]) {
+        p_best_sad16x16[0] = temSum;
+        x_mv = _MVXT(mv) + (int16_t)(_mm_extract_epi16(s3, 1) * 4);
+        y_mv = _MVYT(mv);
+        p_best_mv16x16[0] = ((uint16_t)y_mv << 16) | ((uint16_t)x_mv);
+    }
+
+    //find the best for 8x8_0, 8x8_1, 8x8_2 & 8x8_3
+    sad_0 = _mm_minpos_epu16(sad_0);
+    sad_1 = _mm_minpos_epu16(sad_1);
+    sad_2 = _mm_minpos_epu16(sad_2);
+    sad_3 = _mm_minpos_epu16(sad_3);
+    sad_0 = _mm_unpacklo_epi16(sad_0, sad_1);
+    sad_2 = _mm_unpacklo_epi16(sad_2, sad_3);
+    sad_0 = _mm_unpacklo_epi32(sad_0, sad_2);
+    sad_1 = _mm_unpackhi_epi16(sad_0, _mm_setzero_si128());
+    sad_0 = _mm_unpacklo_epi16(sad_0, _mm_setzero_si128());
+    sad_0 = _mm_slli_epi32(sad_0, 1);
+    sad_1 = _mm_slli_epi16(sad_1, 2);
+    sad_2 = _mm_loadu_si128((__m128i*)p_best_sad8x8);
+    s3 = _mm_cmpgt_epi32(sad_2, sad_0);
+    sad_0 = _mm_min_epu32(sad_0, sad_2);
+    _mm_storeu_si128((__m128i*)p_best_sad8x8, sad_0);
+    sad_3 = _mm_loadu_si128((__m128i*)p_best_mv8x8);
+    sad_3 = _mm_andnot_si128(s3, sad_3);
+    sad_2 = _mm_set1_epi32(mv);
+    sad_2 = _mm_add_epi16(sad_2, sad_1);
+    sad_2 = _mm_and_si128(sad_2, s3);
+    sad_2 = _mm_or_si128(sad_2, sad_3);
+    _mm_storeu_si128((__m128i*)p_best_mv8x8, sad_2);
+}
+
+/*******************************************************************************
+* Smallest of the 8 unsigned 64-bit lanes
+*******************************************************************************/
+static INLINE uint64_t HorizontalMin_epu64(__m512i a)
+{
+    a = _mm512_min_epu64(a, _mm512_shuffle_i64x2(a, a, 0x4E));
+    a = _mm512_min_epu64(a, _mm512_shuffle_i64x2(a, a, 0xB1));
+    a = _mm512_min_epu64(a, _mm512_shuffle_epi32(a, _MM_PERM_BADC));
+    return (uint64_t)_mm_cvtsi128_si64(_mm512_castsi512_si128(a));
+}
+
+/*******************************************************************************
+* Smallest lanes of the two 256-bit halves, in lanes 0 and 4
+*******************************************************************************/
+static INLINE __m512i HalvesMin_epu64(__m512i a)
+{
+    a = _mm512_min_epu64(a, _mm512_shuffle_i64x2(a, a, 0xB1));
+    return _mm512_min_epu64(a, _mm512_shuffle_epi32(a, _MM_PERM_BADC));
+}
+
+/*******************************************
+Calcualte SAD for 32x32,64x64 from 16x16
+and check if there is improvement, if yes keep
+the best SAD+MV
+
+The 32x32 selection follows the AVX2 kernel
+step by step, including the way GCC builds of
+it label the search points, so that both tiers
+give the same motion vectors
+*******************************************/
+void GetEightHorizontalSearchPointResults_32x32_64x64_PU_AVX512_INTRIN(
+    uint16_t  *p_sad16x16,
+    uint32_t  *p_best_sad32x32,
+    uint32_t  *p_best_sad64x64,
+    uint32_t  *p_best_mv32x32,
+    uint32_t  *p_best_mv64x64,
+    uint32_t   mv)
+{
+    int16_t x_mv, y_mv;
+    uint32_t temSum, blockIndex, lowSad, highSad, searchOffset;
+    uint64_t best;
+    __m512i s0, s1, key;
+    __m256i sad32x32, sad64x64;
+
+    // The SAD of search point p is stored as (SAD << 3) | p so that the
+    // unsigned minimum is the smallest SAD at the first search point.
+    const __m512i searchPoint = _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+
+    sad64x64 = _mm256_setzero_si256();
+    for (blockIndex = 0; blockIndex < 4; ++blockIndex) {
+        // 16x16_4n to 16x16_4n+3, 8 search points each
+        s0 = _mm512_loadu_si512((__m512i*)(p_sad16x16 + blockIndex * 32));
+        s1 = _mm512_add_epi32(_mm512_cvtepu16_epi32(_mm512_castsi512_si256(s0)), _mm512_cvtepu16_epi32(_mm512_extracti64x4_epi64(s0, 1)));
+        sad32x32 = _mm256_add_epi32(_mm512_castsi512_si256(s1), _mm512_extracti64x4_epi64(s1, 1));
+        sad64x64 = _mm256_add_epi32(sad64x64, sad32x32);
+
+        // Best of search points 0-3 in lane 0, best of 4-7 in lane 4
+        key = HalvesMin_epu64(_mm512_or_si512(_mm512_slli_epi64(_mm512_cvtepu32_epi64(sad32x32), 3), searchPoint));
+        best = (uint64_t)_mm_cvtsi128_si64(_mm512_castsi512_si128(key));
+        lowSad = (uint32_t)(best >> 3);
+        searchOffset = (uint32_t)(best & 7);
+        best = (uint64_t)_mm_cvtsi128_si64(_mm512_extracti32x4_epi32(key, 2));
+        highSad = (uint32_t)(best >> 3);
+
+        // The AVX2 kernel compares the two halves the other way round on GCC builds,
+        // and then takes the search point of one half at the position of the other
+#ifdef __GNUC__
+        searchOffset = (highSad > lowSad) ? searchOffset + 4 : (uint32_t)(best & 7) - 4;
+#else
+        searchOffset = (lowSad > highSad) ? (uint32_t)(best & 7) : searchOffset;
+#endif
+
+        // << 1 to compensate for every other line
+        temSum = (lowSad < highSad ? lowSad : highSad) << 1;
+        if ((int32_t)p_best_sad32x32[blockIndex] > (int32_t)temSum) {
+            x_mv = _MVXT(mv) + (int16_t)(searchOffset * 4);  y_mv = _MVYT(mv);
+            p_best_mv32x32[blockIndex] = ((uint16_t)y_mv << 16) | ((uint16_t)x_mv);
+        }
+        if (temSum < p_best_sad32x32[blockIndex])
+            p_best_sad32x32[blockIndex] = temSum;
+    }
+
+    key = _mm512_or_si512(_mm512_slli_epi64(_mm512_cvtepu32_epi64(sad64x64), 1 + 3), searchPoint);
+    best = HorizontalMin_epu64(key);
+    temSum = (uint32_t)(best >> 3);
+    if (temSum < p_best_sad64x64[0]) {
+        p_best_sad64x64[0] = temSum;
+        x_mv = _MVXT(mv) + (int16_t)((best & 7) * 4);  y_mv = _MVYT(mv);
+        p_best_mv64x64[0] = ((uint16_t)y_mv << 16) | ((uint16_t)x_mv);
+    }
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "EbDefinitions.h"
+#include <immintrin.h>
+#include "convolve.h"
+#include "aom_dsp_rtcd.h"
+#include "convolve_avx512.h"
+
+void av1_convolve_2d_sr_avx512(const uint8_t *src, int32_t src_stride, uint8_t *dst,
+    int32_t dst_stride, int32_t w, int32_t h,
+    InterpFilterParams *filter_params_x,
+    InterpFilterParams *filter_params_y,
+    const int32_t subpel_x_q4, const int32_t subpel_y_q4,
+    ConvolveParams *conv_params) {
+    const int32_t bd = 8;
+
+    // Narrow blocks keep the 8 columns AVX2 kernel
+    if (w < CONVOLVE_AVX512_BLOCK_WIDTH) {
+        av1_convolve_2d_sr_avx2(src, src_stride, dst, dst_stride, w, h,
+            filter_params_x, filter_params_y, subpel_x_q4, subpel_y_q4, conv_params);
+        return;
+    }
+
+    DECLARE_ALIGNED(64, int16_t, im_block[(MAX_SB_SIZE + MAX_FILTER_TAP) * CONVOLVE_AVX512_BLOCK_WIDTH]);
+    int32_t im_h = h + filter_params_y->taps - 1;
+    int32_t im_stride = CONVOLVE_AVX512_BLOCK_WIDTH;
+    int32_t i, j;
+    const int32_t fo_vert = filter_params_y->taps / 2 - 1;
+    const int32_t fo_horiz = filter_params_x->taps / 2 - 1;
+    const uint8_t *const src_ptr = src - fo_vert * src_stride - fo_horiz;
+
+    const int32_t bits =
+        FILTER_BITS * 2 - conv_params->round_0 - conv_params->round_1;
+    const int32_t offset_bits = bd + 2 * FILTER_BITS - conv_params->round_0;
+
+    __m512i filt[4], coeffs_h[4], coeffs_v[4];
+
+    assert(conv_params->round_0 > 0);
+
+    prepare_filt_avx512(filt);
+    prepare_coeffs_lowbd_avx512(filter_params_x, subpel_x_q4, coeffs_h);
+    prepare_coeffs_avx512(filter_params_y, subpel_y_q4, coeffs_v);
+
+    const __m512i round_const_h = _mm512_set1_epi16(
+        ((1 << (conv_params->round_0 - 1)) >> 1) + (1 << (bd + FILTER_BITS - 2)));
+    const __m128i round_shift_h = _mm_cvtsi32_si128(conv_params->round_0 - 1);
+
+    const __m512i sum_round_v = _mm512_set1_epi32(
+        (1 << offset_bits) + ((1 << conv_params->round_1) >> 1));
+    const __m128i sum_shift_v = _mm_cvtsi32_si128(conv_params->round_1);
+
+    const __m512i round_const_v = _mm512_set1_epi32(
+        ((1 << bits) >> 1) - (1 << (offset_bits - conv_params->round_1)) -
+        ((1 << (offset_bits - conv_params->round_1)) >> 1));
+    const __m128i round_shift_v = _mm_cvtsi32_si128(bits);
+
+    for (j = 0; j < w; j += CONVOLVE_AVX512_BLOCK_WIDTH) {
+        convolve_2d_x_16_avx512(src_ptr + j, src_stride, im_block, im_h,
+            coeffs_h, filt, round_const_h, round_shift_h);
+
+        /* Vertical filter */
+        {
+            // Each load covers lines k and k + 1
+            __m512i src_0 = _mm512_loadu_si512((__m512i *)(im_block + 0 * im_stride));
+            __m512i src_1 = _mm512_loadu_si512((__m512i *)(im_block + 1 * im_stride));
+            __m512i src_2 = _mm512_loadu_si512((__m512i *)(im_block + 2 * im_stride));
+            __m512i src_3 = _mm512_loadu_si512((__m512i *)(im_block + 3 * im_stride));
+            __m512i src_4 = _mm512_loadu_si512((__m512i *)(im_block + 4 * im_stride));
+            __m512i src_5 = _mm512_loadu_si512((__m512i *)(im_block + 5 * im_stride));
+
+            __m512i s[8];
+            s[0] = _mm512_unpacklo_epi16(src_0, src_1);
+            s[1] = _mm512_unpacklo_epi16(src_2, src_3);
+            s[2] = _mm512_unpacklo_epi16(src_4, src_5);
+
+            s[4] = _mm512_unpackhi_epi16(src_0, src_1);
+            s[5] = _mm512_unpackhi_epi16(src_2, src_3);
+            s[6] = _mm512_unpackhi_epi16(src_4, src_5);
+
+            for (i = 0; i < h; i += 2) {
+                const int16_t *data = &im_block[i * im_stride];
+
+                const __m512i s6 =
+                    _mm512_loadu_si512((__m512i *)(data + 6 * im_stride));
+                const __m512i s7 =
+                    _mm512_loadu_si512((__m512i *)(data + 7 * im_stride));
+
+                s[3] = _mm512_unpacklo_epi16(s6, s7);
+                s[7] = _mm512_unpackhi_epi16(s6, s7);
+
+                __m512i res_a = convolve_avx512(s, coeffs_v);
+                __m512i res_b = convolve_avx512(s + 4, coeffs_v);
+
+                // Combine V round and 2F-H-V round into a single rounding
+                res_a =
+                    _mm512_sra_epi32(_mm512_add_epi32(res_a, sum_round_v), sum_shift_v);
+                res_b =
+                    _mm512_sra_epi32(_mm512_add_epi32(res_b, sum_round_v), sum_shift_v);
+
+                const __m512i res_a_round = _mm512_sra_epi32(
+                    _mm512_add_epi32(res_a, round_const_v), round_shift_v);
+                const __m512i res_b_round = _mm512_sra_epi32(
+                    _mm512_add_epi32(res_b, round_const_v), round_shift_v);
+
+                /* rounding code */
+                // 16 bit conversion, lines i and i + 1 in raster order
+                const __m512i res_16bit = _mm512_packs_epi32(res_a_round, res_b_round);
+                // 8 bit conversion and saturation to uint8
+                const __m256i res_8b = pack_us_16x2_avx512(res_16bit);
+
+                // Store values into the destination buffer
+                _mm_storeu_si128((__m128i *)&dst[i * dst_stride + j], _mm256_castsi256_si128(res_8b));
+                _mm_storeu_si128((__m128i *)&dst[i * dst_stride + j + dst_stride], _mm256_extracti128_si256(res_8b, 1));
+
+                s[0] = s[1];
+                s[1] = s[2];
+                s[2] = s[3];
+
+                s[4] = s[5];
+                s[5] = s[6];
+                s[6] = s[7];
+            }
+        }
+    }
+}
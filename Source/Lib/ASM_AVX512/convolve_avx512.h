@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+#include "convolve.h"
+#include "convolve_avx2.h"
+#ifndef AOM_DSP_X86_CONVOLVE_AVX512_H_
+#define AOM_DSP_X86_CONVOLVE_AVX512_H_
+
+// The 2D kernels filter 16 columns at a time. A 512-bit register holds two
+// lines of 16 samples, one 128-bit lane per group of 8 columns, so the
+// per-lane shuffles, unpacks and packs of the AVX2 kernels carry over.
+#define CONVOLVE_AVX512_BLOCK_WIDTH 16
+
+static INLINE void prepare_filt_avx512(__m512i *const filt /* [4] */) {
+    filt[0] = _mm512_broadcast_i64x4(_mm256_load_si256((__m256i const *)filt1_global_avx2));
+    filt[1] = _mm512_broadcast_i64x4(_mm256_load_si256((__m256i const *)filt2_global_avx2));
+    filt[2] = _mm512_broadcast_i64x4(_mm256_load_si256((__m256i const *)filt3_global_avx2));
+    filt[3] = _mm512_broadcast_i64x4(_mm256_load_si256((__m256i const *)filt4_global_avx2));
+}
+
+static INLINE void prepare_coeffs_lowbd_avx512(
+    const InterpFilterParams *const filter_params, const int32_t subpel_q4,
+    __m512i *const coeffs /* [4] */) {
+    const int16_t *const filter = av1_get_interp_filter_subpel_kernel(
+        *filter_params, subpel_q4 & SUBPEL_MASK);
+    const __m128i coeffs_8 = _mm_loadu_si128((__m128i *)filter);
+    const __m512i filter_coeffs = _mm512_broadcast_i32x4(coeffs_8);
+
+    // right shift all filter co-efficients by 1 to reduce the bits required,
+    // see prepare_coeffs_lowbd()
+    const __m512i coeffs_1 = _mm512_srai_epi16(filter_coeffs, 1);
+
+    // coeffs 0 1 0 1 0 1 0 1
+    coeffs[0] = _mm512_shuffle_epi8(coeffs_1, _mm512_set1_epi16(0x0200u));
+    // coeffs 2 3 2 3 2 3 2 3
+    coeffs[1] = _mm512_shuffle_epi8(coeffs_1, _mm512_set1_epi16(0x0604u));
+    // coeffs 4 5 4 5 4 5 4 5
+    coeffs[2] = _mm512_shuffle_epi8(coeffs_1, _mm512_set1_epi16(0x0a08u));
+    // coeffs 6 7 6 7 6 7 6 7
+    coeffs[3] = _mm512_shuffle_epi8(coeffs_1, _mm512_set1_epi16(0x0e0cu));
+}
+
+static INLINE void prepare_coeffs_avx512(
+    const InterpFilterParams *const filter_params, const int32_t subpel_q4,
+    __m512i *const coeffs /* [4] */) {
+    const int16_t *filter = av1_get_interp_filter_subpel_kernel(
+        *filter_params, subpel_q4 & SUBPEL_MASK);
+
+    const __m128i coeff_8 = _mm_loadu_si128((__m128i *)filter);
+    const __m512i coeff = _mm512_broadcast_i32x4(coeff_8);
+
+    // coeffs 0 1 0 1 0 1 0 1
+    coeffs[0] = _mm512_shuffle_epi32(coeff, 0x00);
+    // coeffs 2 3 2 3 2 3 2 3
+    coeffs[1] = _mm512_shuffle_epi32(coeff, 0x55);
+    // coeffs 4 5 4 5 4 5 4 5
+    coeffs[2] = _mm512_shuffle_epi32(coeff, 0xaa);
+    // coeffs 6 7 6 7 6 7 6 7
+    coeffs[3] = _mm512_shuffle_epi32(coeff, 0xff);
+}
+
+static INLINE __m512i convolve_lowbd_x_avx512(const __m512i data,
+    const __m512i *const coeffs,
+    const __m512i *const filt) {
+    const __m512i res_01 = _mm512_maddubs_epi16(_mm512_shuffle_epi8(data, filt[0]), coeffs[0]);
+    const __m512i res_23 = _mm512_maddubs_epi16(_mm512_shuffle_epi8(data, filt[1]), coeffs[1]);
+    const __m512i res_45 = _mm512_maddubs_epi16(_mm512_shuffle_epi8(data, filt[2]), coeffs[2]);
+    const __m512i res_67 = _mm512_maddubs_epi16(_mm512_shuffle_epi8(data, filt[3]), coeffs[3]);
+
+    return _mm512_add_epi16(_mm512_add_epi16(res_01, res_45),
+        _mm512_add_epi16(res_23, res_67));
+}
+
+static INLINE __m512i convolve_avx512(const __m512i *const s,
+    const __m512i *const coeffs) {
+    const __m512i res_0 = _mm512_madd_epi16(s[0], coeffs[0]);
+    const __m512i res_1 = _mm512_madd_epi16(s[1], coeffs[1]);
+    const __m512i res_2 = _mm512_madd_epi16(s[2], coeffs[2]);
+    const __m512i res_3 = _mm512_madd_epi16(s[3], coeffs[3]);
+
+    return _mm512_add_epi32(_mm512_add_epi32(res_0, res_1),
+        _mm512_add_epi32(res_2, res_3));
+}
+
+// Horizontal pass of the 2D kernels: columns j to j + 15 of the im_h lines
+// of src_ptr into im_block, with a stride of 16
+static INLINE void convolve_2d_x_16_avx512(const uint8_t *src_ptr,
+    int32_t src_stride, int16_t *im_block, int32_t im_h,
+    const __m512i *const coeffs_h, const __m512i *const filt,
+    const __m512i round_const_h, const __m128i round_shift_h) {
+    int32_t i;
+    for (i = 0; i < im_h; i += 2) {
+        const uint8_t *p = &src_ptr[i * src_stride];
+        __m512i data = _mm512_castsi128_si512(_mm_loadu_si128((__m128i *)p));
+        data = _mm512_inserti32x4(data, _mm_loadu_si128((__m128i *)(p + 8)), 1);
+
+        // Load the next line
+        if (i + 1 < im_h) {
+            data = _mm512_inserti32x4(data, _mm_loadu_si128((__m128i *)(p + src_stride)), 2);
+            data = _mm512_inserti32x4(data, _mm_loadu_si128((__m128i *)(p + src_stride + 8)), 3);
+        }
+
+        __m512i res = convolve_lowbd_x_avx512(data, coeffs_h, filt);
+        res = _mm512_sra_epi16(_mm512_add_epi16(res, round_const_h), round_shift_h);
+        _mm512_store_si512((__m512i *)&im_block[i * CONVOLVE_AVX512_BLOCK_WIDTH], res);
+    }
+}
+
+static INLINE __m512i comp_avg_avx512(const __m512i *const data_ref_0,
+    const __m512i *const res_unsigned,
+    const __m512i *const wt,
+    const int32_t use_jnt_comp_avg) {
+    __m512i res;
+    if (use_jnt_comp_avg) {
+        const __m512i data_lo = _mm512_unpacklo_epi16(*data_ref_0, *res_unsigned);
+        const __m512i data_hi = _mm512_unpackhi_epi16(*data_ref_0, *res_unsigned);
+
+        const __m512i wt_res_lo = _mm512_madd_epi16(data_lo, *wt);
+        const __m512i wt_res_hi = _mm512_madd_epi16(data_hi, *wt);
+
+        const __m512i res_lo = _mm512_srai_epi32(wt_res_lo, DIST_PRECISION_BITS);
+        const __m512i res_hi = _mm512_srai_epi32(wt_res_hi, DIST_PRECISION_BITS);
+
+        res = _mm512_packs_epi32(res_lo, res_hi);
+    }
+    else {
+        const __m512i wt_res = _mm512_add_epi16(*data_ref_0, *res_unsigned);
+        res = _mm512_srai_epi16(wt_res, 1);
+    }
+    return res;
+}
+
+static INLINE __m512i convolve_rounding_avx512(const __m512i *const res_unsigned,
+    const __m512i *const offset_const,
+    const __m512i *const round_const,
+    const int32_t round_shift) {
+    const __m512i res_signed = _mm512_sub_epi16(*res_unsigned, *offset_const);
+    const __m512i res_round = _mm512_srai_epi16(
+        _mm512_add_epi16(res_signed, *round_const), round_shift);
+    return res_round;
+}
+
+// Two lines of 16 signed 16-bit results to 8 bits with unsigned saturation
+static INLINE __m256i pack_us_16x2_avx512(const __m512i res) {
+    return _mm512_cvtusepi16_epi8(_mm512_max_epi16(res, _mm512_setzero_si512()));
+}
+
+#endif
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2018, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include "EbDefinitions.h"
+#include <immintrin.h>
+#include "convolve.h"
+#include "aom_dsp_rtcd.h"
+#include "convolve_avx512.h"
+
+void av1_jnt_convolve_2d_avx512(const uint8_t *src, int32_t src_stride, uint8_t *dst0,
+    int32_t dst_stride0, int32_t w, int32_t h,
+    InterpFilterParams *filter_params_x,
+    InterpFilterParams *filter_params_y,
+    const int32_t subpel_x_q4, const int32_t subpel_y_q4,
+    ConvolveParams *conv_params) {
+    // Narrow blocks keep the 8 columns AVX2 kernel
+    if (w < CONVOLVE_AVX512_BLOCK_WIDTH) {
+        av1_jnt_convolve_2d_avx2(src, src_stride, dst0, dst_stride0, w, h,
+            filter_params_x, filter_params_y, subpel_x_q4, subpel_y_q4, conv_params);
+        return;
+    }
+
+    CONV_BUF_TYPE *dst = conv_params->dst;
+    int32_t dst_stride = conv_params->dst_stride;
+    const int32_t bd = 8;
+
+    DECLARE_ALIGNED(64, int16_t, im_block[(MAX_SB_SIZE + MAX_FILTER_TAP) * CONVOLVE_AVX512_BLOCK_WIDTH]);
+    int32_t im_h = h + filter_params_y->taps - 1;
+    int32_t im_stride = CONVOLVE_AVX512_BLOCK_WIDTH;
+    int32_t i, j;
+    const int32_t fo_vert = filter_params_y->taps / 2 - 1;
+    const int32_t fo_horiz = filter_params_x->taps / 2 - 1;
+    const uint8_t *const src_ptr = src - fo_vert * src_stride - fo_horiz;
+    const int32_t w0 = conv_params->fwd_offset;
+    const int32_t w1 = conv_params->bck_offset;
+    const __m512i wt0 = _mm512_set1_epi16(w0);
+    const __m512i wt1 = _mm512_set1_epi16(w1);
+    const __m512i wt = _mm512_unpacklo_epi16(wt0, wt1);
+    const int32_t do_average = conv_params->do_average;
+    const int32_t use_jnt_comp_avg = conv_params->use_jnt_comp_avg;
+    const int32_t offset_0 =
+        bd + 2 * FILTER_BITS - conv_params->round_0 - conv_params->round_1;
+    const int32_t offset = (1 << offset_0) + (1 << (offset_0 - 1));
+    const __m512i offset_const = _mm512_set1_epi16(offset);
+    const int32_t rounding_shift =
+        2 * FILTER_BITS - conv_params->round_0 - conv_params->round_1;
+    const __m512i rounding_const = _mm512_set1_epi16((1 << rounding_shift) >> 1);
+    __m512i filt[4], s[8], coeffs_x[4], coeffs_y[4];
+
+    assert(conv_params->round_0 > 0);
+
+    prepare_filt_avx512(filt);
+    prepare_coeffs_lowbd_avx512(filter_params_x, subpel_x_q4, coeffs_x);
+    prepare_coeffs_avx512(filter_params_y, subpel_y_q4, coeffs_y);
+
+    const __m512i round_const_h = _mm512_set1_epi16(
+        ((1 << (conv_params->round_0 - 1)) >> 1) + (1 << (bd + FILTER_BITS - 2)));
+    const __m128i round_shift_h = _mm_cvtsi32_si128(conv_params->round_0 - 1);
+
+    const __m512i round_const_v = _mm512_set1_epi32(
+        ((1 << conv_params->round_1) >> 1) -
+        (1 << (bd + 2 * FILTER_BITS - conv_params->round_0 - 1)));
+    const __m128i round_shift_v = _mm_cvtsi32_si128(conv_params->round_1);
+
+    for (j = 0; j < w; j += CONVOLVE_AVX512_BLOCK_WIDTH) {
+        /* Horizontal filter */
+        convolve_2d_x_16_avx512(src_ptr + j, src_stride, im_block, im_h,
+            coeffs_x, filt, round_const_h, round_shift_h);
+
+        /* Vertical filter */
+        {
+            // Each load covers lines k and k + 1
+            __m512i s0 = _mm512_loadu_si512((__m512i *)(im_block + 0 * im_stride));
+            __m512i s1 = _mm512_loadu_si512((__m512i *)(im_block + 1 * im_stride));
+            __m512i s2 = _mm512_loadu_si512((__m512i *)(im_block + 2 * im_stride));
+            __m512i s3 = _mm512_loadu_si512((__m512i *)(im_block + 3 * im_stride));
+            __m512i s4 = _mm512_loadu_si512((__m512i *)(im_block + 4 * im_stride));
+            __m512i s5 = _mm512_loadu_si512((__m512i *)(im_block + 5 * im_stride));
+
+            s[0] = _mm512_unpacklo_epi16(s0, s1);
+            s[1] = _mm512_unpacklo_epi16(s2, s3);
+            s[2] = _mm512_unpacklo_epi16(s4, s5);
+
+            s[4] = _mm512_unpackhi_epi16(s0, s1);
+            s[5] = _mm512_unpackhi_epi16(s2, s3);
+            s[6] = _mm512_unpackhi_epi16(s4, s5);
+
+            for (i = 0; i < h; i += 2) {
+                const int16_t *data = &im_block[i * im_stride];
+
+                const __m512i s6 =
+                    _mm512_loadu_si512((__m512i *)(data + 6 * im_stride));
+                const __m512i s7 =
+                    _mm512_loadu_si512((__m512i *)(data + 7 * im_stride));
+
+                s[3] = _mm512_unpacklo_epi16(s6, s7);
+                s[7] = _mm512_unpackhi_epi16(s6, s7);
+
+                const __m512i res_a = convolve_avx512(s, coeffs_y);
+                const __m512i res_a_round = _mm512_sra_epi32(
+                    _mm512_add_epi32(res_a, round_const_v), round_shift_v);
+                const __m512i res_b = convolve_avx512(s + 4, coeffs_y);
+                const __m512i res_b_round = _mm512_sra_epi32(
+                    _mm512_add_epi32(res_b, round_const_v), round_shift_v);
+
+                // Lines i and i + 1 in raster order
+                const __m512i res_16b = _mm512_packs_epi32(res_a_round, res_b_round);
+                const __m512i res_unsigned = _mm512_add_epi16(res_16b, offset_const);
+
+                if (do_average) {
+                    const __m512i data_ref_0 = _mm512_inserti64x4(
+                        _mm512_castsi256_si512(
+                            _mm256_loadu_si256((__m256i *)(&dst[i * dst_stride + j]))),
+                        _mm256_loadu_si256((__m256i *)(&dst[i * dst_stride + j + dst_stride])),
+                        1);
+
+                    const __m512i comp_avg_res =
+                        comp_avg_avx512(&data_ref_0, &res_unsigned, &wt, use_jnt_comp_avg);
+
+                    const __m512i round_result = convolve_rounding_avx512(
+                        &comp_avg_res, &offset_const, &rounding_const, rounding_shift);
+
+                    const __m256i res_8 = pack_us_16x2_avx512(round_result);
+
+                    _mm_storeu_si128((__m128i *)(&dst0[i * dst_stride0 + j]),
+                        _mm256_castsi256_si128(res_8));
+                    _mm_storeu_si128((__m128i *)(&dst0[i * dst_stride0 + j + dst_stride0]),
+                        _mm256_extracti128_si256(res_8, 1));
+                }
+                else {
+                    _mm256_storeu_si256((__m256i *)(&dst[i * dst_stride + j]),
+                        _mm512_castsi512_si256(res_unsigned));
+                    _mm256_storeu_si256((__m256i *)(&dst[i * dst_stride + j + dst_stride]),
+                        _mm512_extracti64x4_epi64(res_unsigned, 1));
+                }
+
+                s[0] = s[1];
+                s[1] = s[2];
+                s[2] = s[3];
+
+                s[4] = s[5];
+                s[5] = s[6];
+                s[6] = s[7];
+            }
+        }
+    }
+}
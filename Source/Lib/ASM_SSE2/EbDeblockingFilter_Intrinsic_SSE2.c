@@ -3428,7 +3428,113 @@ void aom_highbd_lpf_vertical_14_dual_sse2(uint16_t *s, int32_t pitch,
     _mm_storeu_si128((__m128i *)(s + 7 * pitch), d7_out);
 }
 
+/*********************************************************************************************/
+// 4 adjacent segments of an edge, all at the same filter level, through the
+// dual kernels when there is one (the 8 bit dual 4 and 8 tap kernels cover the
+// 16 samples, the others 8)
+
+void aom_lpf_horizontal_4_quad_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    aom_lpf_horizontal_4_dual_sse2(s, pitch, blimit, limit, thresh, blimit, limit, thresh);
+}
+
+void aom_lpf_horizontal_6_quad_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_lpf_horizontal_6_sse2(s + 4 * i, pitch, blimit, limit, thresh);
+}
+
+void aom_lpf_horizontal_8_quad_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    aom_lpf_horizontal_8_dual_sse2(s, pitch, blimit, limit, thresh, blimit, limit, thresh);
+}
+
+void aom_lpf_horizontal_14_quad_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    aom_lpf_horizontal_14_dual_sse2(s, pitch, blimit, limit, thresh);
+    aom_lpf_horizontal_14_dual_sse2(s + 8, pitch, blimit, limit, thresh);
+}
+
+void aom_lpf_vertical_4_quad_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    aom_lpf_vertical_4_dual_sse2(s, pitch, blimit, limit, thresh, blimit, limit, thresh);
+}
+
+void aom_lpf_vertical_6_quad_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_lpf_vertical_6_sse2(s + 4 * i * pitch, pitch, blimit, limit, thresh);
+}
+
+void aom_lpf_vertical_8_quad_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_lpf_vertical_8_sse2(s + 4 * i * pitch, pitch, blimit, limit, thresh);
+}
+
+void aom_lpf_vertical_14_quad_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    aom_lpf_vertical_14_dual_sse2(s, pitch, blimit, limit, thresh);
+    aom_lpf_vertical_14_dual_sse2(s + 8 * pitch, pitch, blimit, limit, thresh);
+}
+
+void aom_highbd_lpf_horizontal_4_quad_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    aom_highbd_lpf_horizontal_4_dual_sse2(s, pitch, blimit, limit, thresh, blimit, limit, thresh, bd);
+    aom_highbd_lpf_horizontal_4_dual_sse2(s + 8, pitch, blimit, limit, thresh, blimit, limit, thresh, bd);
+}
+
+void aom_highbd_lpf_horizontal_6_quad_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_highbd_lpf_horizontal_6_sse2(s + 4 * i, pitch, blimit, limit, thresh, bd);
+}
 
+void aom_highbd_lpf_horizontal_8_quad_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    aom_highbd_lpf_horizontal_8_dual_sse2(s, pitch, blimit, limit, thresh, blimit, limit, thresh, bd);
+    aom_highbd_lpf_horizontal_8_dual_sse2(s + 8, pitch, blimit, limit, thresh, blimit, limit, thresh, bd);
+}
 
+void aom_highbd_lpf_horizontal_14_quad_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    aom_highbd_lpf_horizontal_14_dual_sse2(s, pitch, blimit, limit, thresh, bd);
+    aom_highbd_lpf_horizontal_14_dual_sse2(s + 8, pitch, blimit, limit, thresh, bd);
+}
 
+void aom_highbd_lpf_vertical_4_quad_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    aom_highbd_lpf_vertical_4_dual_sse2(s, pitch, blimit, limit, thresh, blimit, limit, thresh, bd);
+    aom_highbd_lpf_vertical_4_dual_sse2(s + 8 * pitch, pitch, blimit, limit, thresh, blimit, limit, thresh, bd);
+}
 
+void aom_highbd_lpf_vertical_6_quad_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_highbd_lpf_vertical_6_sse2(s + 4 * i * pitch, pitch, blimit, limit, thresh, bd);
+}
+
+void aom_highbd_lpf_vertical_8_quad_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    aom_highbd_lpf_vertical_8_dual_sse2(s, pitch, blimit, limit, thresh, blimit, limit, thresh, bd);
+    aom_highbd_lpf_vertical_8_dual_sse2(s + 8 * pitch, pitch, blimit, limit, thresh, blimit, limit, thresh, bd);
+}
+
+void aom_highbd_lpf_vertical_14_quad_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    aom_highbd_lpf_vertical_14_dual_sse2(s, pitch, blimit, limit, thresh, bd);
+    aom_highbd_lpf_vertical_14_dual_sse2(s + 8 * pitch, pitch, blimit, limit, thresh, bd);
+}
@@ -1453,8 +1453,9 @@ void generate_av1_mvp_table(
     memset(xd->ref_mv_stack, 0, sizeof(xd->ref_mv_stack));
 #endif
 
-    xd->up_available = (mi_row > 0);
-    xd->left_available = (mi_col > 0);
+    av1_tile_init(&xd->tile, cm, mi_row, mi_col);
+    xd->up_available = (mi_row > xd->tile.mi_row_start);
+    xd->left_available = (mi_col > xd->tile.mi_col_start);
 
     xd->n8_h = bh;
     xd->n8_w = bw;
@@ -1469,12 +1470,6 @@ void generate_av1_mvp_table(
     if (xd->n8_w > xd->n8_h)
         if (mi_row & (xd->n8_w - 1)) xd->is_sec_rect = 1;
 
-
-    xd->tile.mi_col_start = 0;
-    xd->tile.mi_col_end = cm->mi_cols;
-    xd->tile.mi_row_start = 0;
-    xd->tile.mi_row_end = cm->mi_rows;
-
     //these could be done at init time
     xd->mi_stride = picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr->picture_width_in_sb*(BLOCK_SIZE_64 / 4);
     const int32_t offset = mi_row * xd->mi_stride + mi_col;
@@ -265,6 +265,25 @@ extern "C" {
             AvcStyleLumaInterpolationFilterPosq_SSSE3,             //q
             AvcStyleLumaInterpolationFilterPosr_SSSE3,             //r
         },
+        // AVX512
+        {
+            AvcStyleCopy_SSE2,                                    //A
+            AvcStyleLumaInterpolationFilterHorizontal_SSSE3_INTRIN,       //a
+            AvcStyleLumaInterpolationFilterHorizontal_SSSE3_INTRIN,       //b
+            AvcStyleLumaInterpolationFilterHorizontal_SSSE3_INTRIN,       //c
+            AvcStyleLumaInterpolationFilterVertical_SSSE3_INTRIN,         //d
+            AvcStyleLumaInterpolationFilterPose_SSSE3,             //e
+            AvcStyleLumaInterpolationFilterPosf_SSSE3,             //f
+            AvcStyleLumaInterpolationFilterPosg_SSSE3,             //g
+            AvcStyleLumaInterpolationFilterVertical_SSSE3_INTRIN,         //h
+            AvcStyleLumaInterpolationFilterPosi_SSSE3,             //i
+            AvcStyleLumaInterpolationFilterPosj_SSSE3,             //j
+            AvcStyleLumaInterpolationFilterPosk_SSSE3,             //k
+            AvcStyleLumaInterpolationFilterVertical_SSSE3_INTRIN,         //n
+            AvcStyleLumaInterpolationFilterPosp_SSSE3,             //p
+            AvcStyleLumaInterpolationFilterPosq_SSSE3,             //q
+            AvcStyleLumaInterpolationFilterPosr_SSSE3,             //r
+        },
     };
 
     static const PictureAverage FUNC_TABLE picture_average_array[ASM_TYPE_TOTAL] = {
@@ -272,6 +291,8 @@ extern "C" {
         PictureAverageKernel_SSE2_INTRIN,
         // AVX2
         PictureAverageKernel_SSE2_INTRIN,
+        // AVX512
+        PictureAverageKernel_SSE2_INTRIN,
     };
 
     typedef void(*PictureAverage1Line)(
@@ -285,6 +306,8 @@ extern "C" {
         PictureAverageKernel1Line_SSE2_INTRIN,
         // AVX2
         PictureAverageKernel1Line_SSE2_INTRIN,
+        // AVX512
+        PictureAverageKernel1Line_SSE2_INTRIN,
     };
 
 #ifdef __cplusplus
@@ -4436,7 +4436,7 @@ static const aom_cdf_prob av1_default_coeff_base_eob_multi_cdfs
 
 /********************************************************************************************************************************/
 // entropy.c
-static int32_t get_q_ctx(int32_t q) {
+int32_t get_q_ctx(int32_t q) {
     if (q <= 20) return 0;
     if (q <= 60) return 1;
     if (q <= 120) return 2;
@@ -713,6 +713,7 @@ extern "C" {
     struct AV1Common;
     struct frame_contexts;
     void av1_reset_cdf_symbol_counters(struct frame_contexts *fc);
+    int32_t get_q_ctx(int32_t q);
     void av1_default_coef_probs(struct frame_contexts *fc, int32_t base_qindex);
     void init_mode_probs(struct frame_contexts *fc);
 
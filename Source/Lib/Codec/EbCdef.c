@@ -464,24 +464,24 @@ static INLINE void copy_rect(uint16_t *dst, int32_t dstride, const uint16_t *src
 }
 
 void av1_cdef_frame(
-    EncDecContext_t                *context_ptr,
     SequenceControlSet_t           *sequence_control_set_ptr,
     PictureControlSet_t            *pCs
 )
 {
     struct PictureParentControlSet_s     *pPcs = pCs->parent_pcs_ptr;
     Av1Common*   cm = pPcs->av1_cm;
+    EbBool is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
 
 
     EbPictureBufferDesc_t  * recon_picture_ptr;
 
 
     if (pPcs->is_used_as_reference_flag == EB_TRUE)
-        recon_picture_ptr = context_ptr->is16bit ?
+        recon_picture_ptr = is16bit ?
         ((EbReferenceObject_t*)pCs->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->referencePicture16bit :
         ((EbReferenceObject_t*)pCs->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->referencePicture;
     else
-        recon_picture_ptr = context_ptr->is16bit ? pCs->recon_picture16bit_ptr : pCs->recon_picture_ptr;
+        recon_picture_ptr = is16bit ? pCs->recon_picture16bit_ptr : pCs->recon_picture_ptr;
 
     EbByte  reconBufferY = &((recon_picture_ptr->bufferY)[recon_picture_ptr->origin_x + recon_picture_ptr->origin_y * recon_picture_ptr->strideY]);
     EbByte  reconBufferCb = &((recon_picture_ptr->bufferCb)[recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->strideCb]);
@@ -793,12 +793,10 @@ void av1_cdef_frame(
 }
 
 void av1_cdef_frame16bit(
-    EncDecContext_t                *context_ptr,
     SequenceControlSet_t           *sequence_control_set_ptr,
     PictureControlSet_t            *pCs
 )
 {
-    (void)context_ptr;
     struct PictureParentControlSet_s     *pPcs = pCs->parent_pcs_ptr;
     Av1Common*   cm = pPcs->av1_cm;
 
@@ -1404,49 +1402,57 @@ uint64_t compute_cdef_dist(uint16_t *dst, int32_t dstride, uint16_t *src,
     return sum >> 2 * coeff_shift;
 }
 
-void av1_cdef_search(
-    EncDecContext_t                *context_ptr,
+/* Searches the CDEF strengths of the 64x64 filter blocks of the filter block
+ * row fbr. The distortions are stored per filter block in the picture control
+ * set, so that the rows can be searched by several threads before
+ * av1_cdef_search_finish() selects the frame strengths. */
+void av1_cdef_search_sb_row(
+    int32_t                         fbr,
     SequenceControlSet_t           *sequence_control_set_ptr,
-    PictureControlSet_t            *picture_control_set_ptr
-    //Yv12BufferConfig *frame,
-    //const Yv12BufferConfig *ref,
-    //Av1Common *cm,
-    //MacroBlockD *xd,
-    //int32_t fast
-)
+    PictureControlSet_t            *picture_control_set_ptr)
 {
-    (void)context_ptr;
     int32_t fast = 0;
     struct PictureParentControlSet_s     *pPcs = picture_control_set_ptr->parent_pcs_ptr;
     Av1Common*   cm = pPcs->av1_cm;
     int32_t mi_rows = pPcs->av1_cm->mi_rows;
     int32_t mi_cols = pPcs->av1_cm->mi_cols;
+    EbBool is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
 
     EbPictureBufferDesc_t  * recon_picture_ptr;
-    if (pPcs->is_used_as_reference_flag == EB_TRUE)
-        recon_picture_ptr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->referencePicture;
-    else
-        recon_picture_ptr = picture_control_set_ptr->recon_picture_ptr;
-
-    EbByte  reconBufferY = &((recon_picture_ptr->bufferY)[recon_picture_ptr->origin_x + recon_picture_ptr->origin_y * recon_picture_ptr->strideY]);
-    EbByte  reconBufferCb = &((recon_picture_ptr->bufferCb)[recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->strideCb]);
-    EbByte  reconBufferCr = &((recon_picture_ptr->bufferCr)[recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->strideCr]);
-
-
-    EbPictureBufferDesc_t *inputPicturePtr = (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
-    EbByte  inputBufferY = &((inputPicturePtr->bufferY)[inputPicturePtr->origin_x + inputPicturePtr->origin_y * inputPicturePtr->strideY]);
-    EbByte  inputBufferCb = &((inputPicturePtr->bufferCb)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCb]);
-    EbByte  inputBufferCr = &((inputPicturePtr->bufferCr)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCr]);
-
+    EbPictureBufferDesc_t  * inputPicturePtr;
+    if (is16bit) {
+        if (pPcs->is_used_as_reference_flag == EB_TRUE)
+            recon_picture_ptr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->referencePicture16bit;
+        else
+            recon_picture_ptr = picture_control_set_ptr->recon_picture16bit_ptr;
+        inputPicturePtr = picture_control_set_ptr->input_frame16bit;
+    }
+    else {
+        if (pPcs->is_used_as_reference_flag == EB_TRUE)
+            recon_picture_ptr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->referencePicture;
+        else
+            recon_picture_ptr = picture_control_set_ptr->recon_picture_ptr;
+        inputPicturePtr = (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
+    }
 
-    int32_t r, c;
-    int32_t fbr, fbc;
-    uint16_t *src[3];
-    uint16_t *ref_coeff[3];
+    // Offsets are in samples, for both the 8 bit and the 16 bit buffers
+    const int32_t reconOffset[3] = {
+        recon_picture_ptr->origin_x + recon_picture_ptr->origin_y * recon_picture_ptr->strideY,
+        recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->strideCb,
+        recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->strideCr };
+    const int32_t inputOffset[3] = {
+        inputPicturePtr->origin_x + inputPicturePtr->origin_y * inputPicturePtr->strideY,
+        inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCb,
+        inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCr };
+    EbByte reconBuffer[3] = { recon_picture_ptr->bufferY, recon_picture_ptr->bufferCb, recon_picture_ptr->bufferCr };
+    EbByte inputBuffer[3] = { inputPicturePtr->bufferY, inputPicturePtr->bufferCb, inputPicturePtr->bufferCr };
+    const int32_t reconStride[3] = { recon_picture_ptr->strideY, recon_picture_ptr->strideCb, recon_picture_ptr->strideCr };
+    const int32_t inputStride[3] = { inputPicturePtr->strideY, inputPicturePtr->strideCb, inputPicturePtr->strideCr };
+
+    int32_t fbc;
     /*static*/ cdef_list dlist[MI_SIZE_128X128 * MI_SIZE_128X128];
     int32_t dir[CDEF_NBLOCKS][CDEF_NBLOCKS] = { { 0 } };
     int32_t var[CDEF_NBLOCKS][CDEF_NBLOCKS] = { { 0 } };
-    int32_t stride[3];
     int32_t bsize[3];
     int32_t mi_wide_l2[3];
     int32_t mi_high_l2[3];
@@ -1458,75 +1464,24 @@ void av1_cdef_search(
     //CHKN int32_t coeff_shift = AOMMAX(cm->bit_depth - 8, 0);
     int32_t coeff_shift = AOMMAX(sequence_control_set_ptr->static_config.encoder_bit_depth - 8, 0);
 
-    uint64_t best_tot_mse = (uint64_t)1 << 63;
-    uint64_t tot_mse;
-    int32_t sb_count;
-
     int32_t nvfb = (mi_rows /*cm->mi_rows*/ + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
     int32_t nhfb = (mi_cols/*cm->mi_cols*/ + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
 
-    int32_t *sb_index = (int32_t *)aom_malloc(nvfb * nhfb * sizeof(*sb_index));       //CHKN add cast
-    int32_t *selected_strength = (int32_t *)aom_malloc(nvfb * nhfb * sizeof(*sb_index));
-    ASSERT(sb_index != NULL);
-    ASSERT(selected_strength != NULL);
-
     uint64_t(*mse[2])[TOTAL_STRENGTHS];
     int32_t pri_damping = 3 + (picture_control_set_ptr->parent_pcs_ptr->base_qindex /*cm->base_qindex*/ >> 6);
     int32_t sec_damping = 3 + (picture_control_set_ptr->parent_pcs_ptr->base_qindex /*cm->base_qindex*/ >> 6);
     int32_t i;
-    int32_t nb_strengths;
-    int32_t nb_strength_bits;
-    int32_t quantizer;
-    double lambda;
     const int32_t num_planes = 3;// av1_num_planes(cm);
     const int32_t total_strengths = fast ? REDUCED_TOTAL_STRENGTHS : TOTAL_STRENGTHS;
     DECLARE_ALIGNED(32, uint16_t, inbuf[CDEF_INBUF_SIZE]);
     uint16_t *in;
     DECLARE_ALIGNED(32, uint16_t, tmp_dst[1 << (MAX_SB_SIZE_LOG2 * 2)]);
-    quantizer =
-        //CHKN av1_ac_quant_Q3(cm->base_qindex, 0, cm->bit_depth) >> (cm->bit_depth - 8);
-        av1_ac_quant_Q3(pPcs->base_qindex, 0, (aom_bit_depth_t)sequence_control_set_ptr->static_config.encoder_bit_depth) >> (sequence_control_set_ptr->static_config.encoder_bit_depth - 8);
-    lambda = .12 * quantizer * quantizer / 256.;
-
-    //av1_setup_dst_planes(xd->plane, cm->seq_params.sb_size, frame, 0, 0, 0,    num_planes);
-
-    mse[0] = (uint64_t(*)[64])aom_malloc(sizeof(**mse) * nvfb * nhfb);
-    mse[1] = (uint64_t(*)[64])aom_malloc(sizeof(**mse) * nvfb * nhfb);
+    DECLARE_ALIGNED(32, uint16_t, ref_coeff[1 << (MAX_SB_SIZE_LOG2 * 2)]);
 
+    mse[0] = (uint64_t(*)[TOTAL_STRENGTHS])picture_control_set_ptr->cdef_mse[0];
+    mse[1] = (uint64_t(*)[TOTAL_STRENGTHS])picture_control_set_ptr->cdef_mse[1];
 
     for (pli = 0; pli < num_planes; pli++) {
-
-        uint8_t *in_buffer = 0;
-        int32_t in_stride;
-
-        uint8_t *ref_buffer = 0;
-        int32_t ref_stride;
-        switch (pli) {
-        case 0:
-            ref_buffer = inputBufferY;
-            ref_stride = inputPicturePtr->strideY;
-            in_buffer = reconBufferY;
-            in_stride = recon_picture_ptr->strideY;
-            break;
-        case 1:
-            ref_buffer = inputBufferCb;
-            ref_stride = inputPicturePtr->strideCb;
-            in_buffer = reconBufferCb;
-            in_stride = recon_picture_ptr->strideCb;
-            break;
-        case 2:
-            ref_buffer = inputBufferCr;
-            ref_stride = inputPicturePtr->strideCr;
-            in_buffer = reconBufferCr;
-            in_stride = recon_picture_ptr->strideCr;
-            break;
-        }
-
-
-        ///CHKN: allocate one frame 16bit for src and recon!!
-        src[pli] = (uint16_t*)aom_memalign(32, sizeof(*src)       * mi_rows * mi_cols * MI_SIZE * MI_SIZE);
-        ref_coeff[pli] = (uint16_t*)aom_memalign(32, sizeof(*ref_coeff) * mi_rows * mi_cols * MI_SIZE * MI_SIZE);
-
         int32_t subsampling_x = (pli == 0) ? 0 : 1;
         int32_t subsampling_y = (pli == 0) ? 0 : 1;
 
@@ -1535,283 +1490,134 @@ void av1_cdef_search(
         bsize[pli] = ydec[pli] ? (xdec[pli] ? BLOCK_4X4 : BLOCK_8X4)
             : (xdec[pli] ? BLOCK_4X8 : BLOCK_8X8);
 
-        stride[pli] = cm->mi_cols << MI_SIZE_LOG2;
         mi_wide_l2[pli] = MI_SIZE_LOG2 - subsampling_x;  //CHKN MI_SIZE_LOG2 - xd->plane[pli].subsampling_x;
         mi_high_l2[pli] = MI_SIZE_LOG2 - subsampling_y;  //CHKN MI_SIZE_LOG2 - xd->plane[pli].subsampling_y;
-
-        const int32_t frame_height = (cm->mi_rows * MI_SIZE) >> subsampling_y;//CHKN  xd->plane[pli].subsampling_y;
-        const int32_t frame_width = (cm->mi_cols * MI_SIZE) >> subsampling_x;//CHKN  xd->plane[pli].subsampling_x;
-
-
-
-        for (r = 0; r < frame_height; ++r) {
-            for (c = 0; c < frame_width; ++c) {
-                //if (cm->use_highbitdepth) {
-                //    src[pli][r * stride[pli] + c] = CONVERT_TO_SHORTPTR(
-                //        xd->plane[pli].dst.buf)[r * xd->plane[pli].dst.stride + c];
-                //    ref_coeff[pli][r * stride[pli] + c] =
-                //        CONVERT_TO_SHORTPTR(ref_buffer)[r * ref_stride + c];
-                //}
-                //else
-                {
-                    src[pli][r * stride[pli] + c] = in_buffer[r * in_stride + c];//CHKN xd->plane[pli].dst.buf[r * xd->plane[pli].dst.stride + c];
-                    ref_coeff[pli][r * stride[pli] + c] = ref_buffer[r * ref_stride + c];
-
-                }
-            }
-        }
     }
 
     in = inbuf + CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER;
-    sb_count = 0;
-    for (fbr = 0; fbr < nvfb; ++fbr) {
-        for (fbc = 0; fbc < nhfb; ++fbc) {
-            int32_t nvb, nhb;
-            int32_t gi;
-            int32_t dirinit = 0;
-            nhb = AOMMIN(MI_SIZE_64X64, cm->mi_cols - MI_SIZE_64X64 * fbc);
-            nvb = AOMMIN(MI_SIZE_64X64, cm->mi_rows - MI_SIZE_64X64 * fbr);
-            int32_t hb_step = 1; //CHKN these should be all time with 64x64 LCUs
-            int32_t vb_step = 1;
-            BlockSize bs = BLOCK_64X64;
-            ModeInfo **mi = picture_control_set_ptr->mi_grid_base + MI_SIZE_64X64 * fbr * cm->mi_stride + MI_SIZE_64X64 * fbc;
-            const MbModeInfo *mbmi = &mi[0]->mbmi;
-
-            //MbModeInfo *const mbmi =
-            //    cm->mi_grid_visible[MI_SIZE_64X64 * fbr * cm->mi_stride +
-            //    MI_SIZE_64X64 * fbc];
-
-            if (((fbc & 1) &&
-                (mbmi->sb_type == BLOCK_128X128 || mbmi->sb_type == BLOCK_128X64)) ||
-                ((fbr & 1) &&
-                (mbmi->sb_type == BLOCK_128X128 || mbmi->sb_type == BLOCK_64X128)))
-                continue;
-            if (mbmi->sb_type == BLOCK_128X128 || mbmi->sb_type == BLOCK_128X64 ||
-                mbmi->sb_type == BLOCK_64X128)
-                bs = mbmi->sb_type;
-            if (bs == BLOCK_128X128 || bs == BLOCK_128X64) {
-                nhb = AOMMIN(MI_SIZE_128X128, cm->mi_cols - MI_SIZE_64X64 * fbc);
-                hb_step = 2;
-            }
-            if (bs == BLOCK_128X128 || bs == BLOCK_64X128) {
-                nvb = AOMMIN(MI_SIZE_128X128, cm->mi_rows - MI_SIZE_64X64 * fbr);
-                vb_step = 2;
-            }
+    for (fbc = 0; fbc < nhfb; ++fbc) {
+        int32_t nvb, nhb;
+        int32_t gi;
+        int32_t dirinit = 0;
+        const int32_t fb_idx = fbr * nhfb + fbc;
+        nhb = AOMMIN(MI_SIZE_64X64, cm->mi_cols - MI_SIZE_64X64 * fbc);
+        nvb = AOMMIN(MI_SIZE_64X64, cm->mi_rows - MI_SIZE_64X64 * fbr);
+        int32_t hb_step = 1; //CHKN these should be all time with 64x64 LCUs
+        int32_t vb_step = 1;
+        BlockSize bs = BLOCK_64X64;
+        ModeInfo **mi = picture_control_set_ptr->mi_grid_base + MI_SIZE_64X64 * fbr * cm->mi_stride + MI_SIZE_64X64 * fbc;
+        const MbModeInfo *mbmi = &mi[0]->mbmi;
+
+        picture_control_set_ptr->cdef_fb_valid_array[fb_idx] = EB_FALSE;
+
+        if (((fbc & 1) &&
+            (mbmi->sb_type == BLOCK_128X128 || mbmi->sb_type == BLOCK_128X64)) ||
+            ((fbr & 1) &&
+            (mbmi->sb_type == BLOCK_128X128 || mbmi->sb_type == BLOCK_64X128)))
+            continue;
+        if (mbmi->sb_type == BLOCK_128X128 || mbmi->sb_type == BLOCK_128X64 ||
+            mbmi->sb_type == BLOCK_64X128)
+            bs = mbmi->sb_type;
+        if (bs == BLOCK_128X128 || bs == BLOCK_128X64) {
+            nhb = AOMMIN(MI_SIZE_128X128, cm->mi_cols - MI_SIZE_64X64 * fbc);
+            hb_step = 2;
+        }
+        if (bs == BLOCK_128X128 || bs == BLOCK_64X128) {
+            nvb = AOMMIN(MI_SIZE_128X128, cm->mi_rows - MI_SIZE_64X64 * fbr);
+            vb_step = 2;
+        }
 
-            // No filtering if the entire filter block is skipped
-            if (sb_all_skip(picture_control_set_ptr, cm, fbr * MI_SIZE_64X64, fbc * MI_SIZE_64X64))
-                continue;
+        // No filtering if the entire filter block is skipped
+        if (sb_all_skip(picture_control_set_ptr, cm, fbr * MI_SIZE_64X64, fbc * MI_SIZE_64X64))
+            continue;
 
-            cdef_count = sb_compute_cdef_list(picture_control_set_ptr, cm, fbr * MI_SIZE_64X64, fbc * MI_SIZE_64X64, dlist, bs);
+        cdef_count = sb_compute_cdef_list(picture_control_set_ptr, cm, fbr * MI_SIZE_64X64, fbc * MI_SIZE_64X64, dlist, bs);
 
-            for (pli = 0; pli < num_planes; pli++) {
+        for (pli = 0; pli < num_planes; pli++) {
 
-                for (i = 0; i < CDEF_INBUF_SIZE; i++)
-                    inbuf[i] = CDEF_VERY_LARGE;
-#if    REDUCE_COPY_CDEF
-                int32_t yoff = CDEF_VBORDER * (fbr != 0);
-                int32_t xoff = CDEF_HBORDER * (fbc != 0);
-                int32_t ysize = (nvb << mi_high_l2[pli]) + CDEF_VBORDER * (fbr + vb_step < nvfb) + yoff;
-                int32_t xsize = (nhb << mi_wide_l2[pli]) + CDEF_HBORDER * (fbc + hb_step < nhfb) + xoff;
+            for (i = 0; i < CDEF_INBUF_SIZE; i++)
+                inbuf[i] = CDEF_VERY_LARGE;
 
+            int32_t yoff = CDEF_VBORDER * (fbr != 0);
+            int32_t xoff = CDEF_HBORDER * (fbc != 0);
+            int32_t ysize = (nvb << mi_high_l2[pli]) + CDEF_VBORDER * (fbr + vb_step < nvfb) + yoff;
+            int32_t xsize = (nhb << mi_wide_l2[pli]) + CDEF_HBORDER * (fbc + hb_step < nhfb) + xoff;
+            const int32_t fb_voffset = fbr * MI_SIZE_64X64 << mi_high_l2[pli];
+            const int32_t fb_hoffset = fbc * MI_SIZE_64X64 << mi_wide_l2[pli];
+
+            // The filter only reads the source, so it is copied once for all the strengths
+            uint16_t *ref_ptr;
+            int32_t ref_stride;
+            if (is16bit) {
                 copy_sb16_16(
                     &in[(-yoff * CDEF_BSTRIDE - xoff)], CDEF_BSTRIDE,
-                    src[pli],
-                    (fbr * MI_SIZE_64X64 << mi_high_l2[pli]) - yoff,
-                    (fbc * MI_SIZE_64X64 << mi_wide_l2[pli]) - xoff,
-                    stride[pli], ysize, xsize);
-#endif
-                for (gi = 0; gi < total_strengths; gi++) {
-                    int32_t threshold;
-                    uint64_t curr_mse;
-                    int32_t sec_strength;
-                    threshold = gi / CDEF_SEC_STRENGTHS;
-                    if (fast) threshold = priconv[threshold];
-                    /* We avoid filtering the pixels for which some of the pixels to
-                    average are outside the frame. We could change the filter instead, but it would add special cases for any future vectorization. */
-#if    !REDUCE_COPY_CDEF
-                    int32_t yoff = CDEF_VBORDER * (fbr != 0);
-                    int32_t xoff = CDEF_HBORDER * (fbc != 0);
-                    int32_t ysize = (nvb << mi_high_l2[pli]) + CDEF_VBORDER * (fbr + vb_step < nvfb) + yoff;
-                    int32_t xsize = (nhb << mi_wide_l2[pli]) + CDEF_HBORDER * (fbc + hb_step < nhfb) + xoff;
-#endif
-                    sec_strength = gi % CDEF_SEC_STRENGTHS;
-#if    !REDUCE_COPY_CDEF
-                    copy_sb16_16(
-                        &in[(-yoff * CDEF_BSTRIDE - xoff)], CDEF_BSTRIDE,
-                        src[pli],
-                        (fbr * MI_SIZE_64X64 << mi_high_l2[pli]) - yoff,
-                        (fbc * MI_SIZE_64X64 << mi_wide_l2[pli]) - xoff,
-                        stride[pli], ysize, xsize);
-#endif
-                    cdef_filter_fb(NULL, tmp_dst, CDEF_BSTRIDE, in, xdec[pli], ydec[pli],
-                        dir, &dirinit, var, pli, dlist, cdef_count, threshold,
-                        sec_strength + (sec_strength == 3), pri_damping,
-                        sec_damping, coeff_shift);
-
-                    curr_mse = compute_cdef_dist(
-                        ref_coeff[pli] +
-                        (fbr * MI_SIZE_64X64 << mi_high_l2[pli]) * stride[pli] +
-                        (fbc * MI_SIZE_64X64 << mi_wide_l2[pli]),
-                        stride[pli], tmp_dst, dlist, cdef_count, (BlockSize)bsize[pli], coeff_shift,
-                        pli);
+                    (uint16_t*)reconBuffer[pli] + reconOffset[pli],
+                    fb_voffset - yoff,
+                    fb_hoffset - xoff,
+                    reconStride[pli], ysize, xsize);
 
-                    if (pli < 2)
-                        mse[pli][sb_count][gi] = curr_mse;
-                    else
-                        mse[1][sb_count][gi] += curr_mse;
-
-
-                    sb_index[sb_count] = MI_SIZE_64X64 * fbr * picture_control_set_ptr->mi_stride + MI_SIZE_64X64 * fbc;//CHKN
-                }
+                ref_stride = inputStride[pli];
+                ref_ptr = (uint16_t*)inputBuffer[pli] + inputOffset[pli] + fb_voffset * ref_stride + fb_hoffset;
             }
-            sb_count++;
-        }
-    }
-
-    nb_strength_bits = 0;
-    /* Search for different number of signalling bits. */
-    for (i = 0; i <= 3; i++) {
-        int32_t j;
-        int32_t best_lev0[CDEF_MAX_STRENGTHS];
-        int32_t best_lev1[CDEF_MAX_STRENGTHS] = { 0 };
-        nb_strengths = 1 << i;
-
-        if (num_planes >= 3)
-            tot_mse = joint_strength_search_dual(best_lev0, best_lev1, nb_strengths, mse, sb_count, fast);
-        else
-            tot_mse = joint_strength_search(best_lev0, nb_strengths, mse[0], sb_count, fast);
-
-        /* Count superblock signalling cost. */
-        tot_mse += (uint64_t)(sb_count * lambda * i);
-        /* Count header signalling cost. */
-        tot_mse += (uint64_t)(nb_strengths * lambda * CDEF_STRENGTH_BITS);
-        if (tot_mse < best_tot_mse) {
-            best_tot_mse = tot_mse;
-            nb_strength_bits = i;
-            for (j = 0; j < 1 << nb_strength_bits; j++) {
-                pPcs->cdef_strengths[j] = best_lev0[j];
-                pPcs->cdef_uv_strengths[j] = best_lev1[j];
+            else {
+                copy_sb8_16(
+                    &in[(-yoff * CDEF_BSTRIDE - xoff)], CDEF_BSTRIDE,
+                    reconBuffer[pli] + reconOffset[pli],
+                    fb_voffset - yoff,
+                    fb_hoffset - xoff,
+                    reconStride[pli], ysize, xsize);
+
+                ref_stride = MAX_SB_SIZE;
+                ref_ptr = ref_coeff;
+                copy_sb8_16(
+                    ref_coeff, ref_stride,
+                    inputBuffer[pli] + inputOffset[pli],
+                    fb_voffset,
+                    fb_hoffset,
+                    inputStride[pli], nvb << mi_high_l2[pli], nhb << mi_wide_l2[pli]);
             }
-        }
-    }
-    nb_strengths = 1 << nb_strength_bits;
 
-    /*cm*/pPcs->cdef_bits = nb_strength_bits;
-    /*cm*/pPcs->nb_cdef_strengths = nb_strengths;
-    for (i = 0; i < sb_count; i++) {
-        int32_t gi;
-        int32_t best_gi;
-        uint64_t best_mse = (uint64_t)1 << 63;
-        best_gi = 0;
-        for (gi = 0; gi < /*cm*/pPcs->nb_cdef_strengths; gi++) {
-            uint64_t curr = mse[0][i][/*cm*/pPcs->cdef_strengths[gi]];
-            if (num_planes >= 3) curr += mse[1][i][/*cm*/pPcs->cdef_uv_strengths[gi]];
-            if (curr < best_mse) {
-                best_gi = gi;
-                best_mse = curr;
+            for (gi = 0; gi < total_strengths; gi++) {
+                int32_t threshold;
+                uint64_t curr_mse;
+                int32_t sec_strength;
+                threshold = gi / CDEF_SEC_STRENGTHS;
+                if (fast) threshold = priconv[threshold];
+                /* We avoid filtering the pixels for which some of the pixels to
+                average are outside the frame. We could change the filter instead, but it would add special cases for any future vectorization. */
+                sec_strength = gi % CDEF_SEC_STRENGTHS;
+                cdef_filter_fb(NULL, tmp_dst, CDEF_BSTRIDE, in, xdec[pli], ydec[pli],
+                    dir, &dirinit, var, pli, dlist, cdef_count, threshold,
+                    sec_strength + (sec_strength == 3), pri_damping,
+                    sec_damping, coeff_shift);
+
+                curr_mse = compute_cdef_dist(
+                    ref_ptr,
+                    ref_stride, tmp_dst, dlist, cdef_count, (BlockSize)bsize[pli], coeff_shift,
+                    pli);
+
+                if (pli < 2)
+                    mse[pli][fb_idx][gi] = curr_mse;
+                else
+                    mse[1][fb_idx][gi] += curr_mse;
             }
         }
-        selected_strength[i] = best_gi;
-        //CHKN cm->mi_grid_visible[sb_index[i]]->cdef_strength = best_gi;
-        picture_control_set_ptr->mi_grid_base[sb_index[i]]->mbmi.cdef_strength = (int8_t)best_gi;
-        //in case the fb is within a block=128x128 or 128x64, or 64x128, then we genrate param only for the first 64x64.
-        //since our mi map deos not have the multi pointer single data assignment, we need to duplicate data.
-        BlockSize sb_type = picture_control_set_ptr->mi_grid_base[sb_index[i]]->mbmi.sb_type;
-
-        if (sb_type == BLOCK_128X128)
-        {
-            picture_control_set_ptr->mi_grid_base[sb_index[i] + MI_SIZE_64X64]->mbmi.cdef_strength = (int8_t)best_gi;
-            picture_control_set_ptr->mi_grid_base[sb_index[i] + MI_SIZE_64X64 * picture_control_set_ptr->mi_stride]->mbmi.cdef_strength = (int8_t)best_gi;
-            picture_control_set_ptr->mi_grid_base[sb_index[i] + MI_SIZE_64X64 * picture_control_set_ptr->mi_stride + MI_SIZE_64X64]->mbmi.cdef_strength = (int8_t)best_gi;
-        }
-        else if (sb_type == BLOCK_128X64)
-        {
-            picture_control_set_ptr->mi_grid_base[sb_index[i] + MI_SIZE_64X64]->mbmi.cdef_strength = (int8_t)best_gi;
-        }
-        else if (sb_type == BLOCK_64X128)
-        {
-            picture_control_set_ptr->mi_grid_base[sb_index[i] + MI_SIZE_64X64 * picture_control_set_ptr->mi_stride]->mbmi.cdef_strength = (int8_t)best_gi;
-        }
-
-
+        picture_control_set_ptr->cdef_fb_valid_array[fb_idx] = EB_TRUE;
     }
-
-    if (fast) {
-        for (int32_t j = 0; j < nb_strengths; j++) {
-            pPcs->cdef_strengths[j] = priconv[pPcs->cdef_strengths[j] / CDEF_SEC_STRENGTHS] * CDEF_SEC_STRENGTHS + (pPcs->cdef_strengths[j] % CDEF_SEC_STRENGTHS);
-            pPcs->cdef_uv_strengths[j] = priconv[pPcs->cdef_uv_strengths[j] / CDEF_SEC_STRENGTHS] * CDEF_SEC_STRENGTHS + (pPcs->cdef_uv_strengths[j] % CDEF_SEC_STRENGTHS);
-        }
-    }
-    pPcs->cdef_pri_damping = pri_damping;
-    pPcs->cdef_sec_damping = sec_damping;
-
-
-    aom_free(mse[0]);
-    aom_free(mse[1]);
-    for (pli = 0; pli < num_planes; pli++) {
-        aom_free(src[pli]);
-        aom_free(ref_coeff[pli]);
-    }
-    aom_free(sb_index);
-    aom_free(selected_strength);
 }
 
-void av1_cdef_search16bit(
-    EncDecContext_t                *context_ptr,
+/* Selects the frame CDEF strengths and the strength of each filter block, once
+ * all the filter block rows have been searched by av1_cdef_search_sb_row(). */
+void av1_cdef_search_finish(
     SequenceControlSet_t           *sequence_control_set_ptr,
-    PictureControlSet_t            *picture_control_set_ptr
-    //Yv12BufferConfig *frame,
-    //const Yv12BufferConfig *ref,
-    //Av1Common *cm,
-    //MacroBlockD *xd,
-    //int32_t fast
-)
+    PictureControlSet_t            *picture_control_set_ptr)
 {
-    (void)context_ptr;
     int32_t fast = 0;
     struct PictureParentControlSet_s     *pPcs = picture_control_set_ptr->parent_pcs_ptr;
-    Av1Common*   cm = pPcs->av1_cm;
     int32_t mi_rows = pPcs->av1_cm->mi_rows;
     int32_t mi_cols = pPcs->av1_cm->mi_cols;
 
-    EbPictureBufferDesc_t  * recon_picture_ptr;
-    if (pPcs->is_used_as_reference_flag == EB_TRUE)
-        recon_picture_ptr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->referencePicture16bit;
-    else
-        recon_picture_ptr = picture_control_set_ptr->recon_picture16bit_ptr;
-
-
-    uint16_t*  reconBufferY = (uint16_t*)recon_picture_ptr->bufferY + (recon_picture_ptr->origin_x + recon_picture_ptr->origin_y     * recon_picture_ptr->strideY);
-    uint16_t*  reconBufferCb = (uint16_t*)recon_picture_ptr->bufferCb + (recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->strideCb);
-    uint16_t*  reconBufferCr = (uint16_t*)recon_picture_ptr->bufferCr + (recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->strideCr);
-
-
-    EbPictureBufferDesc_t *inputPicturePtr = picture_control_set_ptr->input_frame16bit;
-    uint16_t*  inputBufferY = (uint16_t*)inputPicturePtr->bufferY + (inputPicturePtr->origin_x + inputPicturePtr->origin_y * inputPicturePtr->strideY);
-    uint16_t*  inputBufferCb = (uint16_t*)inputPicturePtr->bufferCb + (inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCb);
-    uint16_t*  inputBufferCr = (uint16_t*)inputPicturePtr->bufferCr + (inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCr);
-
-
-    int32_t r, c;
     int32_t fbr, fbc;
-    uint16_t *src[3];
-    uint16_t *ref_coeff[3];
-    /*static*/ cdef_list dlist[MI_SIZE_128X128 * MI_SIZE_128X128];
-    int32_t dir[CDEF_NBLOCKS][CDEF_NBLOCKS] = { { 0 } };
-    int32_t var[CDEF_NBLOCKS][CDEF_NBLOCKS] = { { 0 } };
-    int32_t stride[3];
-    int32_t bsize[3];
-    int32_t mi_wide_l2[3];
-    int32_t mi_high_l2[3];
-    int32_t xdec[3];
-    int32_t ydec[3];
-    int32_t pli;
-    int32_t cdef_count;
-
-    //CHKN int32_t coeff_shift = AOMMAX(cm->bit_depth - 8, 0);
-    int32_t coeff_shift = AOMMAX(sequence_control_set_ptr->static_config.encoder_bit_depth - 8, 0);
-
     uint64_t best_tot_mse = (uint64_t)1 << 63;
     uint64_t tot_mse;
     int32_t sb_count;
@@ -1820,12 +1626,9 @@ void av1_cdef_search16bit(
     int32_t nhfb = (mi_cols/*cm->mi_cols*/ + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
 
     int32_t *sb_index = (int32_t *)aom_malloc(nvfb * nhfb * sizeof(*sb_index));       //CHKN add cast
-    int32_t *selected_strength = (int32_t *)aom_malloc(nvfb * nhfb * sizeof(*sb_index));
-    ASSERT(sb_index);
-    ASSERT(selected_strength);
+    ASSERT(sb_index != NULL);
 
     uint64_t(*mse[2])[TOTAL_STRENGTHS];
-
     int32_t pri_damping = 3 + (picture_control_set_ptr->parent_pcs_ptr->base_qindex /*cm->base_qindex*/ >> 6);
     int32_t sec_damping = 3 + (picture_control_set_ptr->parent_pcs_ptr->base_qindex /*cm->base_qindex*/ >> 6);
     int32_t i;
@@ -1834,205 +1637,35 @@ void av1_cdef_search16bit(
     int32_t quantizer;
     double lambda;
     const int32_t num_planes = 3;// av1_num_planes(cm);
-    const int32_t total_strengths = fast ? REDUCED_TOTAL_STRENGTHS : TOTAL_STRENGTHS;
-    DECLARE_ALIGNED(32, uint16_t, inbuf[CDEF_INBUF_SIZE]);
-    uint16_t *in;
-    DECLARE_ALIGNED(32, uint16_t, tmp_dst[1 << (MAX_SB_SIZE_LOG2 * 2)]);
     quantizer =
         //CHKN av1_ac_quant_Q3(cm->base_qindex, 0, cm->bit_depth) >> (cm->bit_depth - 8);
         av1_ac_quant_Q3(pPcs->base_qindex, 0, (aom_bit_depth_t)sequence_control_set_ptr->static_config.encoder_bit_depth) >> (sequence_control_set_ptr->static_config.encoder_bit_depth - 8);
     lambda = .12 * quantizer * quantizer / 256.;
 
-    //av1_setup_dst_planes(xd->plane, cm->seq_params.sb_size, frame, 0, 0, 0,    num_planes);
-
-    mse[0] = (uint64_t(*)[64])aom_malloc(sizeof(**mse) * nvfb * nhfb);
-    mse[1] = (uint64_t(*)[64])aom_malloc(sizeof(**mse) * nvfb * nhfb);
-
-
-    for (pli = 0; pli < num_planes; pli++) {
-
-        uint16_t *in_buffer = 0;
-        int32_t in_stride;
-
-        uint16_t *ref_buffer = 0;
-        int32_t ref_stride;
-        switch (pli) {
-#if CDEF_10BIT_FIX
-        case 0:
-            ref_buffer = inputBufferY;
-            ref_stride = inputPicturePtr->strideY;
-            in_buffer = reconBufferY;
-            in_stride = recon_picture_ptr->strideY;
-            break;
-        case 1:
-            ref_buffer = inputBufferCb;
-            ref_stride = inputPicturePtr->strideCb;
-            in_buffer = reconBufferCb;
-            in_stride = recon_picture_ptr->strideCb;
-            break;
-        case 2:
-            ref_buffer = inputBufferCr;
-            ref_stride = inputPicturePtr->strideCr;
-            in_buffer = reconBufferCr;
-            in_stride = recon_picture_ptr->strideCr;
-            break;
-#else
-        case 0:
-            ref_buffer = reconBufferY;
-            ref_stride = recon_picture_ptr->strideY;
-            in_buffer = inputBufferY;
-            in_stride = inputPicturePtr->strideY;
-            break;
-        case 1:
-            ref_buffer = reconBufferCb;
-            ref_stride = recon_picture_ptr->strideCb;
-            in_buffer = inputBufferCb;
-            in_stride = inputPicturePtr->strideCb;
-            break;
-        case 2:
-            ref_buffer = reconBufferCr;
-            ref_stride = recon_picture_ptr->strideCr;
-            in_buffer = inputBufferCr;
-            in_stride = inputPicturePtr->strideCr;
-            break;
-#endif
-        }
-
-        ///CHKN: allocate one frame 16bit for src and recon!!
-        src[pli] = (uint16_t*)aom_memalign(32, sizeof(*src)       * mi_rows * mi_cols * MI_SIZE * MI_SIZE);
-        ref_coeff[pli] = (uint16_t*)aom_memalign(32, sizeof(*ref_coeff) * mi_rows * mi_cols * MI_SIZE * MI_SIZE);
-
-        int32_t subsampling_x = (pli == 0) ? 0 : 1;
-        int32_t subsampling_y = (pli == 0) ? 0 : 1;
-
-        xdec[pli] = subsampling_x; //CHKN  xd->plane[pli].subsampling_x;
-        ydec[pli] = subsampling_y; //CHKN  xd->plane[pli].subsampling_y;
-        bsize[pli] = ydec[pli] ? (xdec[pli] ? BLOCK_4X4 : BLOCK_8X4)
-            : (xdec[pli] ? BLOCK_4X8 : BLOCK_8X8);
-
-        stride[pli] = cm->mi_cols << MI_SIZE_LOG2;
-        mi_wide_l2[pli] = MI_SIZE_LOG2 - subsampling_x;  //CHKN MI_SIZE_LOG2 - xd->plane[pli].subsampling_x;
-        mi_high_l2[pli] = MI_SIZE_LOG2 - subsampling_y;  //CHKN MI_SIZE_LOG2 - xd->plane[pli].subsampling_y;
-
-        const int32_t frame_height = (cm->mi_rows * MI_SIZE) >> subsampling_y;//CHKN  xd->plane[pli].subsampling_y;
-        const int32_t frame_width = (cm->mi_cols * MI_SIZE) >> subsampling_x;//CHKN  xd->plane[pli].subsampling_x;
+    mse[0] = (uint64_t(*)[TOTAL_STRENGTHS])picture_control_set_ptr->cdef_mse[0];
+    mse[1] = (uint64_t(*)[TOTAL_STRENGTHS])picture_control_set_ptr->cdef_mse[1];
 
-
-
-        for (r = 0; r < frame_height; ++r) {
-            for (c = 0; c < frame_width; ++c) {
-                //if (cm->use_highbitdepth) {
-                //    src[pli][r * stride[pli] + c] = CONVERT_TO_SHORTPTR(
-                //        xd->plane[pli].dst.buf)[r * xd->plane[pli].dst.stride + c];
-                //    ref_coeff[pli][r * stride[pli] + c] =
-                //        CONVERT_TO_SHORTPTR(ref_buffer)[r * ref_stride + c];
-                //}
-                //else
-                {
-                    src[pli][r * stride[pli] + c] = in_buffer[r * in_stride + c];//CHKN xd->plane[pli].dst.buf[r * xd->plane[pli].dst.stride + c];
-                    ref_coeff[pli][r * stride[pli] + c] = ref_buffer[r * ref_stride + c];
-
-                }
-            }
-        }
-    }
-
-    in = inbuf + CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER;
+    // Pack the searched filter blocks in raster order
     sb_count = 0;
     for (fbr = 0; fbr < nvfb; ++fbr) {
         for (fbc = 0; fbc < nhfb; ++fbc) {
-            int32_t nvb, nhb;
-            int32_t gi;
-            int32_t dirinit = 0;
-            nhb = AOMMIN(MI_SIZE_64X64, cm->mi_cols - MI_SIZE_64X64 * fbc);
-            nvb = AOMMIN(MI_SIZE_64X64, cm->mi_rows - MI_SIZE_64X64 * fbr);
-            int32_t hb_step = 1; //CHKN these should be all time with 64x64 LCUs
-            int32_t vb_step = 1;
-            BlockSize bs = BLOCK_64X64;
-            ModeInfo **mi = picture_control_set_ptr->mi_grid_base + MI_SIZE_64X64 * fbr * cm->mi_stride + MI_SIZE_64X64 * fbc;
-            const MbModeInfo *mbmi = &mi[0]->mbmi;
-
-            //MbModeInfo *const mbmi =
-            //    cm->mi_grid_visible[MI_SIZE_64X64 * fbr * cm->mi_stride +
-            //    MI_SIZE_64X64 * fbc];
-
-            if (((fbc & 1) &&
-                (mbmi->sb_type == BLOCK_128X128 || mbmi->sb_type == BLOCK_128X64)) ||
-                ((fbr & 1) &&
-                (mbmi->sb_type == BLOCK_128X128 || mbmi->sb_type == BLOCK_64X128)))
+            const int32_t fb_idx = fbr * nhfb + fbc;
+            if (!picture_control_set_ptr->cdef_fb_valid_array[fb_idx])
                 continue;
-            if (mbmi->sb_type == BLOCK_128X128 || mbmi->sb_type == BLOCK_128X64 ||
-                mbmi->sb_type == BLOCK_64X128)
-                bs = mbmi->sb_type;
-            if (bs == BLOCK_128X128 || bs == BLOCK_128X64) {
-                nhb = AOMMIN(MI_SIZE_128X128, cm->mi_cols - MI_SIZE_64X64 * fbc);
-                hb_step = 2;
-            }
-            if (bs == BLOCK_128X128 || bs == BLOCK_64X128) {
-                nvb = AOMMIN(MI_SIZE_128X128, cm->mi_rows - MI_SIZE_64X64 * fbr);
-                vb_step = 2;
-            }
-
-            // No filtering if the entire filter block is skipped
-            if (sb_all_skip(picture_control_set_ptr, cm, fbr * MI_SIZE_64X64, fbc * MI_SIZE_64X64))
-                continue;
-
-            cdef_count = sb_compute_cdef_list(picture_control_set_ptr, cm, fbr * MI_SIZE_64X64, fbc * MI_SIZE_64X64, dlist, bs);
-
-            for (pli = 0; pli < num_planes; pli++) {
-
-                for (i = 0; i < CDEF_INBUF_SIZE; i++)
-                    inbuf[i] = CDEF_VERY_LARGE;
-
-                for (gi = 0; gi < total_strengths; gi++) {
-                    int32_t threshold;
-                    uint64_t curr_mse;
-                    int32_t sec_strength;
-                    threshold = gi / CDEF_SEC_STRENGTHS;
-                    if (fast) threshold = priconv[threshold];
-                    /* We avoid filtering the pixels for which some of the pixels to
-                    average are outside the frame. We could change the filter instead, but it would add special cases for any future vectorization. */
-                    int32_t yoff = CDEF_VBORDER * (fbr != 0);
-                    int32_t xoff = CDEF_HBORDER * (fbc != 0);
-                    int32_t ysize = (nvb << mi_high_l2[pli]) + CDEF_VBORDER * (fbr + vb_step < nvfb) + yoff;
-                    int32_t xsize = (nhb << mi_wide_l2[pli]) + CDEF_HBORDER * (fbc + hb_step < nhfb) + xoff;
-                    sec_strength = gi % CDEF_SEC_STRENGTHS;
-
-                    copy_sb16_16(
-                        &in[(-yoff * CDEF_BSTRIDE - xoff)], CDEF_BSTRIDE,
-                        src[pli],
-                        (fbr * MI_SIZE_64X64 << mi_high_l2[pli]) - yoff,
-                        (fbc * MI_SIZE_64X64 << mi_wide_l2[pli]) - xoff,
-                        stride[pli], ysize, xsize);
-
-                    cdef_filter_fb(NULL, tmp_dst, CDEF_BSTRIDE, in, xdec[pli], ydec[pli],
-                        dir, &dirinit, var, pli, dlist, cdef_count, threshold,
-                        sec_strength + (sec_strength == 3), pri_damping,
-                        sec_damping, coeff_shift);
-
-                    curr_mse = compute_cdef_dist(
-                        ref_coeff[pli] +
-                        (fbr * MI_SIZE_64X64 << mi_high_l2[pli]) * stride[pli] +
-                        (fbc * MI_SIZE_64X64 << mi_wide_l2[pli]),
-                        stride[pli], tmp_dst, dlist, cdef_count, (BlockSize)bsize[pli], coeff_shift,
-                        pli);
-
-                    if (pli < 2)
-                        mse[pli][sb_count][gi] = curr_mse;
-                    else
-                        mse[1][sb_count][gi] += curr_mse;
-
-
-                    sb_index[sb_count] = MI_SIZE_64X64 * fbr * picture_control_set_ptr->mi_stride + MI_SIZE_64X64 * fbc;//CHKN
-                }
+            if (sb_count != fb_idx) {
+                EB_MEMCPY(mse[0][sb_count], mse[0][fb_idx], sizeof(**mse));
+                EB_MEMCPY(mse[1][sb_count], mse[1][fb_idx], sizeof(**mse));
             }
+            sb_index[sb_count] = MI_SIZE_64X64 * fbr * picture_control_set_ptr->mi_stride + MI_SIZE_64X64 * fbc;//CHKN
             sb_count++;
         }
     }
 
     nb_strength_bits = 0;
-    /* Search for different number of signalling bits. */
-    for (i = 0; i <= 3; i++) {
+    /* Search for different number of signalling bits. The SB row latency mode
+     * entropy codes the superblocks before the search, with a single strength. */
+    const int32_t max_strength_bits = sequence_control_set_ptr->static_config.low_latency == EB_SB_ROW_LATENCY ? 0 : 3;
+    for (i = 0; i <= max_strength_bits; i++) {
         int32_t j;
         int32_t best_lev0[CDEF_MAX_STRENGTHS];
         int32_t best_lev1[CDEF_MAX_STRENGTHS] = { 0 };
@@ -2073,7 +1706,6 @@ void av1_cdef_search16bit(
                 best_mse = curr;
             }
         }
-        selected_strength[i] = best_gi;
         //CHKN cm->mi_grid_visible[sb_index[i]]->cdef_strength = best_gi;
         picture_control_set_ptr->mi_grid_base[sb_index[i]]->mbmi.cdef_strength = (int8_t)best_gi;
         //in case the fb is within a block=128x128 or 128x64, or 64x128, then we genrate param only for the first 64x64.
@@ -2095,15 +1727,6 @@ void av1_cdef_search16bit(
             picture_control_set_ptr->mi_grid_base[sb_index[i] + MI_SIZE_64X64 * picture_control_set_ptr->mi_stride]->mbmi.cdef_strength = (int8_t)best_gi;
         }
 
-        //ModeInfo *miPtr = *(picture_control_set_ptr->mi_grid_base + sb_index[i]);
-        //uint8_t  miX, miY;
-        //for (miY = 0; miY < (block_size_high[sb_type] >> MI_SIZE_LOG2); miY++) {
-        //    for (miX = 0; miX < (block_size_wide[sb_type] >> MI_SIZE_LOG2); miX++) {
-        //        miPtr[miX + miY * picture_control_set_ptr->mi_stride].mbmi.cdef_strength = (int8_t)best_gi;
-        //    }
-        //}
-
-
 
     }
 
@@ -2117,12 +1740,6 @@ void av1_cdef_search16bit(
     pPcs->cdef_sec_damping = sec_damping;
 
 
-    aom_free(mse[0]);
-    aom_free(mse[1]);
-    for (pli = 0; pli < num_planes; pli++) {
-        aom_free(src[pli]);
-        aom_free(ref_coeff[pli]);
-    }
     aom_free(sb_index);
-    aom_free(selected_strength);
 }
+
@@ -2824,7 +2824,8 @@ EB_EXTERN void AV1EncodePass(
     EbBool dlfEnableFlag = (EbBool)(!sequence_control_set_ptr->static_config.disable_dlf_flag &&
         (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag ||
             sequence_control_set_ptr->static_config.recon_enabled ||
-            sequence_control_set_ptr->static_config.stat_report));
+            sequence_control_set_ptr->static_config.stat_report ||
+            sequence_control_set_ptr->static_config.frame_stats == 2));
 
     const EbBool isIntraLCU = picture_control_set_ptr->limit_intra ? isIntraPresent(sb_ptr) : EB_TRUE;
 
@@ -2832,7 +2833,8 @@ EB_EXTERN void AV1EncodePass(
         (picture_control_set_ptr->limit_intra == 0 || isIntraLCU == 1) ||
         picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag ||
         sequence_control_set_ptr->static_config.recon_enabled ||
-        sequence_control_set_ptr->static_config.stat_report);
+        sequence_control_set_ptr->static_config.stat_report ||
+        sequence_control_set_ptr->static_config.frame_stats == 2);
 
     EntropyCoder_t  *coeff_est_entropy_coder_ptr = picture_control_set_ptr->coeff_est_entropy_coder_ptr;
 
@@ -2911,7 +2913,7 @@ EB_EXTERN void AV1EncodePass(
 
 
     EbBool use_delta_qp = (EbBool)sequence_control_set_ptr->static_config.improve_sharpness;
-    EbBool oneSegment = (sequence_control_set_ptr->enc_dec_segment_col_count_array[picture_control_set_ptr->temporal_layer_index] == 1) && (sequence_control_set_ptr->enc_dec_segment_row_count_array[picture_control_set_ptr->temporal_layer_index] == 1);
+    EbBool oneSegment = (picture_control_set_ptr->enc_dec_segment_ctrl->segmentTotalCount == 1);
     EbBool useDeltaQpSegments = oneSegment ? 0 : (EbBool)sequence_control_set_ptr->static_config.improve_sharpness;
 
     // DeriveZeroLumaCbf
@@ -3049,7 +3051,7 @@ EB_EXTERN void AV1EncodePass(
         av1_loop_filter_init(picture_control_set_ptr);
 
         av1_pick_filter_level(
-            context_ptr,
+            NULL,
             (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
             picture_control_set_ptr,
             LPF_PICK_FROM_Q);
@@ -3217,7 +3219,7 @@ EB_EXTERN void AV1EncodePass(
                                         if (context_ptr->cu_origin_x != 0)
                                             memcpy(leftNeighArray + 1, (uint16_t*)(ep_luma_recon_neighbor_array->leftArray) + context_ptr->cu_origin_y, blk_geom->bheight * 2 * sizeof(uint16_t));
                                         if (context_ptr->cu_origin_y != 0 && context_ptr->cu_origin_x != 0)
-                                            topNeighArray[0] = leftNeighArray[0] = ((uint16_t*)(ep_luma_recon_neighbor_array->topLeftArray) + MAX_PICTURE_HEIGHT_SIZE + context_ptr->cu_origin_x - context_ptr->cu_origin_y)[0];
+                                            topNeighArray[0] = leftNeighArray[0] = ((uint16_t*)(ep_luma_recon_neighbor_array->topLeftArray) + ep_luma_recon_neighbor_array->leftArraySize + context_ptr->cu_origin_x - context_ptr->cu_origin_y)[0];
                                     }
 
                                     else if (plane == 1) {
@@ -3226,7 +3228,7 @@ EB_EXTERN void AV1EncodePass(
                                         if (cu_originx_uv != 0)
                                             memcpy(leftNeighArray + 1, (uint16_t*)(ep_cb_recon_neighbor_array->leftArray) + cu_originy_uv, blk_geom->bheight_uv * 2 * sizeof(uint16_t));
                                         if (cu_originy_uv != 0 && cu_originx_uv != 0)
-                                            topNeighArray[0] = leftNeighArray[0] = ((uint16_t*)(ep_cb_recon_neighbor_array->topLeftArray) + MAX_PICTURE_HEIGHT_SIZE / 2 + cu_originx_uv - cu_originy_uv)[0];
+                                            topNeighArray[0] = leftNeighArray[0] = ((uint16_t*)(ep_cb_recon_neighbor_array->topLeftArray) + ep_cb_recon_neighbor_array->leftArraySize + cu_originx_uv - cu_originy_uv)[0];
                                     }
                                     else {
                                         if (cu_originy_uv != 0)
@@ -3234,7 +3236,7 @@ EB_EXTERN void AV1EncodePass(
                                         if (cu_originx_uv != 0)
                                             memcpy(leftNeighArray + 1, (uint16_t*)(ep_cr_recon_neighbor_array->leftArray) + cu_originy_uv, blk_geom->bheight_uv * 2 * sizeof(uint16_t));
                                         if (cu_originy_uv != 0 && cu_originx_uv != 0)
-                                            topNeighArray[0] = leftNeighArray[0] = ((uint16_t*)(ep_cr_recon_neighbor_array->topLeftArray) + MAX_PICTURE_HEIGHT_SIZE / 2 + cu_originx_uv - cu_originy_uv)[0];
+                                            topNeighArray[0] = leftNeighArray[0] = ((uint16_t*)(ep_cr_recon_neighbor_array->topLeftArray) + ep_cr_recon_neighbor_array->leftArraySize + cu_originx_uv - cu_originy_uv)[0];
 
                                     }
 
@@ -3287,7 +3289,7 @@ EB_EXTERN void AV1EncodePass(
                                             memcpy(leftNeighArray + 1, ep_luma_recon_neighbor_array->leftArray + context_ptr->cu_origin_y, blk_geom->bheight * 2);
 
                                         if (context_ptr->cu_origin_y != 0 && context_ptr->cu_origin_x != 0)
-                                            topNeighArray[0] = leftNeighArray[0] = ep_luma_recon_neighbor_array->topLeftArray[MAX_PICTURE_HEIGHT_SIZE + context_ptr->cu_origin_x - context_ptr->cu_origin_y];
+                                            topNeighArray[0] = leftNeighArray[0] = ep_luma_recon_neighbor_array->topLeftArray[ep_luma_recon_neighbor_array->leftArraySize + context_ptr->cu_origin_x - context_ptr->cu_origin_y];
                                     }
 
                                     else if (plane == 1) {
@@ -3298,7 +3300,7 @@ EB_EXTERN void AV1EncodePass(
                                             memcpy(leftNeighArray + 1, ep_cb_recon_neighbor_array->leftArray + cu_originy_uv, blk_geom->bheight_uv * 2);
 
                                         if (cu_originy_uv != 0 && cu_originx_uv != 0)
-                                            topNeighArray[0] = leftNeighArray[0] = ep_cb_recon_neighbor_array->topLeftArray[MAX_PICTURE_HEIGHT_SIZE / 2 + cu_originx_uv - cu_originy_uv];
+                                            topNeighArray[0] = leftNeighArray[0] = ep_cb_recon_neighbor_array->topLeftArray[ep_cb_recon_neighbor_array->leftArraySize + cu_originx_uv - cu_originy_uv];
                                     }
                                     else {
                                         if (cu_originy_uv != 0)
@@ -3308,7 +3310,7 @@ EB_EXTERN void AV1EncodePass(
                                             memcpy(leftNeighArray + 1, ep_cr_recon_neighbor_array->leftArray + cu_originy_uv, blk_geom->bheight_uv * 2);
 
                                         if (cu_originy_uv != 0 && cu_originx_uv != 0)
-                                            topNeighArray[0] = leftNeighArray[0] = ep_cr_recon_neighbor_array->topLeftArray[MAX_PICTURE_HEIGHT_SIZE / 2 + cu_originx_uv - cu_originy_uv];
+                                            topNeighArray[0] = leftNeighArray[0] = ep_cr_recon_neighbor_array->topLeftArray[ep_cr_recon_neighbor_array->leftArraySize + cu_originx_uv - cu_originy_uv];
                                     }
 
 
@@ -3367,7 +3369,7 @@ EB_EXTERN void AV1EncodePass(
                                     if (context_ptr->cu_origin_x != 0)
                                         memcpy(leftNeighArray + 1, ep_luma_recon_neighbor_array->leftArray + context_ptr->cu_origin_y, size);
                                     if (context_ptr->cu_origin_y != 0 && context_ptr->cu_origin_x != 0)
-                                        topNeighArray[0] = leftNeighArray[0] = ep_luma_recon_neighbor_array->topLeftArray[MAX_PICTURE_HEIGHT_SIZE + context_ptr->cu_origin_x - context_ptr->cu_origin_y];
+                                        topNeighArray[0] = leftNeighArray[0] = ep_luma_recon_neighbor_array->topLeftArray[ep_luma_recon_neighbor_array->leftArraySize + context_ptr->cu_origin_x - context_ptr->cu_origin_y];
                                 }
                                 else if (plane == 1) {
                                     if (context_ptr->cu_origin_y != 0)
@@ -3375,7 +3377,7 @@ EB_EXTERN void AV1EncodePass(
                                     if (context_ptr->cu_origin_x != 0)
                                         memcpy(leftNeighArray + 1, ep_cb_recon_neighbor_array->leftArray + context_ptr->cu_origin_y / 2, size / 2);
                                     if (context_ptr->cu_origin_y != 0 && context_ptr->cu_origin_x != 0)
-                                        topNeighArray[0] = leftNeighArray[0] = ep_cb_recon_neighbor_array->topLeftArray[MAX_PICTURE_HEIGHT_SIZE / 2 + context_ptr->cu_origin_x / 2 - context_ptr->cu_origin_y / 2];
+                                        topNeighArray[0] = leftNeighArray[0] = ep_cb_recon_neighbor_array->topLeftArray[ep_cb_recon_neighbor_array->leftArraySize + context_ptr->cu_origin_x / 2 - context_ptr->cu_origin_y / 2];
                                 }
                                 else {
                                     if (context_ptr->cu_origin_y != 0)
@@ -3383,7 +3385,7 @@ EB_EXTERN void AV1EncodePass(
                                     if (context_ptr->cu_origin_x != 0)
                                         memcpy(leftNeighArray + 1, ep_cr_recon_neighbor_array->leftArray + context_ptr->cu_origin_y / 2, size / 2);
                                     if (context_ptr->cu_origin_y != 0 && context_ptr->cu_origin_x != 0)
-                                        topNeighArray[0] = leftNeighArray[0] = ep_cr_recon_neighbor_array->topLeftArray[MAX_PICTURE_HEIGHT_SIZE / 2 + context_ptr->cu_origin_x / 2 - context_ptr->cu_origin_y / 2];
+                                        topNeighArray[0] = leftNeighArray[0] = ep_cr_recon_neighbor_array->topLeftArray[ep_cr_recon_neighbor_array->leftArraySize + context_ptr->cu_origin_x / 2 - context_ptr->cu_origin_y / 2];
 
                                 }
                                 if (plane)
@@ -75,6 +75,11 @@ EbErrorType largest_coding_unit_ctor(
 
     EB_MALLOC(CodingUnit_t*, largestCodingUnitPtr->final_cu_arr, sizeof(CodingUnit_t) * tot_cu_num, EB_N_PTR);
 
+    // One slab for the MacroBlockD of all the CUs, one cache line aligned record per CU
+    const size_t xdSize = (sizeof(MacroBlockD) + EB_CACHE_LINE_SIZE - 1) & ~(size_t)(EB_CACHE_LINE_SIZE - 1);
+    uint8_t *xdSlab;
+    EB_CACHE_ALIGNED_MALLOC(uint8_t*, xdSlab, xdSize * tot_cu_num, EB_N_PTR);
+
     for (cu_i = 0; cu_i < tot_cu_num; ++cu_i) {
 
         for (tu_index = 0; tu_index < TRANSFORM_UNIT_MAX_COUNT; ++tu_index) {
@@ -83,7 +88,7 @@ EbErrorType largest_coding_unit_ctor(
 
         largestCodingUnitPtr->final_cu_arr[cu_i].leaf_index = cu_i;
 
-        EB_MALLOC(MacroBlockD*, largestCodingUnitPtr->final_cu_arr[cu_i].av1xd, sizeof(MacroBlockD), EB_N_PTR);
+        largestCodingUnitPtr->final_cu_arr[cu_i].av1xd = (MacroBlockD*)(xdSlab + cu_i * xdSize);
     }
 
     EB_MALLOC(PartitionType*, largestCodingUnitPtr->cu_partition_array, sizeof(PartitionType) * BLOCK_MAX_COUNT, EB_N_PTR);
@@ -362,8 +362,8 @@ extern "C" {
         unsigned                        picture_right_edge_flag : 1;
         unsigned                        pred64                  : 2;
         unsigned                        index                   : 12;
-        unsigned                        origin_x                : 12;
-        unsigned                        origin_y                : 12;
+        unsigned                        origin_x                : 13;
+        unsigned                        origin_y                : 13;
 #if ADD_DELTA_QP_SUPPORT
         uint16_t                        qp;
         int16_t                         delta_qp;
@@ -26,12 +26,16 @@ extern "C" {
             // NON_AVX2
             ComputeMean8x8_SSE2_INTRIN,
             // AVX2
+            ComputeMean8x8_AVX2_INTRIN,
+            // AVX512
             ComputeMean8x8_AVX2_INTRIN
         },
         {
             // NON_AVX2
             ComputeMeanOfSquaredValues8x8_SSE2_INTRIN,
             // AVX2
+            ComputeMeanOfSquaredValues8x8_SSE2_INTRIN,
+            // AVX512
             ComputeMeanOfSquaredValues8x8_SSE2_INTRIN
         }
     };
@@ -13,6 +13,7 @@
 #include "EbComputeSAD_SSE2.h"
 #include "EbComputeSAD_SSE4_1.h"
 #include "EbComputeSAD_AVX2.h"
+#include "EbComputeSAD_AVX512.h"
 #if M0_SSD_HALF_QUARTER_PEL_BIPRED_SEARCH
 #include "EbUtility.h"
 #endif
@@ -121,6 +122,19 @@ extern "C" {
             /*8 64xM */ Compute64xMSad_AVX2_INTRIN,
             0,0,0,0,0,0,0,FastLoop_NxMSadKernel
         },
+        // AVX512
+        {
+            /*0 4xM  */ Compute4xMSadSub_SSE2_INTRIN,
+            /*1 8xM  */ Compute8xMSad_AVX2_INTRIN,
+            /*2 16xM */ Compute16xMSad_AVX2_INTRIN,
+            /*3 24xM */ FastLoop_NxMSadKernel,
+            /*4 32xM */ Compute32xMSad_AVX512_INTRIN,
+            /*5      */ 0,
+            /*6 48xM */ FastLoop_NxMSadKernel,
+            /*7      */ 0,
+            /*8 64xM */ Compute64xMSad_AVX512_INTRIN,
+            0,0,0,0,0,0,0,FastLoop_NxMSadKernel
+        },
     };
     static EB_SADKERNELNxM_TYPE FUNC_TABLE NxMSadKernel_funcPtrArray[ASM_TYPE_TOTAL][9] =   // [ASMTYPE][SAD - block height]
     {
@@ -148,6 +162,18 @@ extern "C" {
             /*7      */ (EB_SADKERNELNxM_TYPE)NxMSadKernelVoidFunc,
             /*8 64xM */ Compute64xMSad_AVX2_INTRIN,
         },
+        // AVX512
+        {
+            /*0 4xM  */ Compute4xMSad_AVX2_INTRIN,
+            /*1 8xM  */ Compute8xMSad_AVX2_INTRIN,
+            /*2 16xM */ Compute16xMSad_AVX2_INTRIN,//Compute16xMSad_AVX2_INTRIN is slower than the SSE2 version
+            /*3 24xM */ Compute24xMSad_AVX2_INTRIN,
+            /*4 32xM */ Compute32xMSad_AVX512_INTRIN,
+            /*5      */ (EB_SADKERNELNxM_TYPE)NxMSadKernelVoidFunc,
+            /*6 48xM */ Compute48xMSad_AVX2_INTRIN,
+            /*7      */ (EB_SADKERNELNxM_TYPE)NxMSadKernelVoidFunc,
+            /*8 64xM */ Compute64xMSad_AVX512_INTRIN,
+        },
     };
 
     static EB_SADAVGKERNELNxM_TYPE FUNC_TABLE NxMSadAveragingKernel_funcPtrArray[ASM_TYPE_TOTAL][9] =   // [ASMTYPE][SAD - block height]
@@ -176,6 +202,18 @@ extern "C" {
             /*7      */     (EB_SADAVGKERNELNxM_TYPE)NxMSadKernelVoidFunc,
             /*8 64xM */     CombinedAveraging64xMSAD_AVX2_INTRIN
         },
+        // AVX512
+        {
+            /*0 4xM  */     CombinedAveraging4xMSAD_SSE2_INTRIN,
+            /*1 8xM  */     CombinedAveraging8xMSAD_AVX2_INTRIN,
+            /*2 16xM */     CombinedAveraging16xMSAD_AVX2_INTRIN,
+            /*3 24xM */     CombinedAveraging24xMSAD_AVX2_INTRIN,
+            /*4 32xM */     CombinedAveraging32xMSAD_AVX2_INTRIN,
+            /*5      */     (EB_SADAVGKERNELNxM_TYPE)NxMSadKernelVoidFunc,
+            /*6 48xM */     CombinedAveraging48xMSAD_AVX2_INTRIN,
+            /*7      */     (EB_SADAVGKERNELNxM_TYPE)NxMSadKernelVoidFunc,
+            /*8 64xM */     CombinedAveraging64xMSAD_AVX2_INTRIN
+        },
     };
 
     static EB_SADLOOPKERNELNxM_TYPE FUNC_TABLE NxMSadLoopKernelSparse_funcPtrArray[ASM_TYPE_TOTAL] =
@@ -184,6 +222,8 @@ extern "C" {
         SadLoopKernelSparse_SSE4_1_INTRIN,
         // AVX2
         SadLoopKernelSparse_AVX2_INTRIN,
+        // AVX512
+        SadLoopKernelSparse_AVX2_INTRIN,
     };
 
 
@@ -193,6 +233,8 @@ extern "C" {
         SadLoopKernel_SSE4_1_INTRIN,
         // AVX2
         SadLoopKernel_AVX2_INTRIN,
+        // AVX512
+        SadLoopKernel_AVX2_INTRIN,
     };
 
     static EB_GETEIGHTSAD8x8 FUNC_TABLE GetEightHorizontalSearchPointResults_8x8_16x16_funcPtrArray[ASM_TYPE_TOTAL] =
@@ -201,6 +243,8 @@ extern "C" {
         GetEightHorizontalSearchPointResults_8x8_16x16_PU_SSE41_INTRIN,
         // AVX2
         GetEightHorizontalSearchPointResults_8x8_16x16_PU_AVX2_INTRIN,
+        // AVX512
+        GetEightHorizontalSearchPointResults_8x8_16x16_PU_AVX512_INTRIN,
     };
 
     static EB_GETEIGHTSAD32x32 FUNC_TABLE GetEightHorizontalSearchPointResults_32x32_64x64_funcPtrArray[ASM_TYPE_TOTAL] =
@@ -209,6 +253,8 @@ extern "C" {
         GetEightHorizontalSearchPointResults_32x32_64x64_PU_SSE41_INTRIN,
         // AVX2
         GetEightHorizontalSearchPointResults_32x32_64x64_PU_AVX2_INTRIN,
+        // AVX512
+        GetEightHorizontalSearchPointResults_32x32_64x64_PU_AVX512_INTRIN,
     };
 
 #ifdef __cplusplus
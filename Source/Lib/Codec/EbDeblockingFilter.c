@@ -23,6 +23,7 @@
 #include "EbSequenceControlSet.h"
 #include "EbReferenceObject.h"
 #include "EbDeblockingFilter.h"
+#include "aom_dsp_rtcd.h"
 
 #define   convertToChromaQp(iQpY)  ( ((iQpY) < 0) ? (iQpY) : (((iQpY) > 57) ? ((iQpY)-6) : (int32_t)(MapChromaQp((uint32_t)iQpY))) )
 
@@ -263,6 +264,22 @@ void aom_lpf_horizontal_6_c(uint8_t *s, int32_t p, const uint8_t *blimit,
     }
 }
 
+void aom_lpf_vertical_6_c(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    int32_t i;
+    int32_t count = 4;
+
+    for (i = 0; i < count; ++i) {
+        const uint8_t p2 = s[-3], p1 = s[-2], p0 = s[-1];
+        const uint8_t q0 = s[0], q1 = s[1], q2 = s[2];
+        const int8_t mask =
+            filter_mask3_chroma(*limit, *blimit, p2, p1, p0, q0, q1, q2);
+        const int8_t flat = flat_mask3_chroma(1, p2, p1, p0, q0, q1, q2);
+        filter6(mask, *thresh, flat, s - 3, s - 2, s - 1, s, s + 1, s + 2);
+        s += pitch;
+    }
+}
+
 void aom_lpf_horizontal_8_c(uint8_t *s, int32_t p, const uint8_t *blimit,
     const uint8_t *limit, const uint8_t *thresh) {
     int32_t i;
@@ -366,6 +383,33 @@ static INLINE void filter14(int8_t mask, uint8_t thresh, int8_t flat,
 }
 
 
+static void mb_lpf_horizontal_edge_w(uint8_t *s, int32_t p, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t count) {
+    int32_t i;
+    int32_t step = 4;
+
+    for (i = 0; i < step * count; ++i) {
+        const uint8_t p6 = s[-7 * p], p5 = s[-6 * p], p4 = s[-5 * p],
+            p3 = s[-4 * p], p2 = s[-3 * p], p1 = s[-2 * p], p0 = s[-p];
+        const uint8_t q0 = s[0 * p], q1 = s[1 * p], q2 = s[2 * p], q3 = s[3 * p],
+            q4 = s[4 * p], q5 = s[5 * p], q6 = s[6 * p];
+        const int8_t mask =
+            filter_mask(*limit, *blimit, p3, p2, p1, p0, q0, q1, q2, q3);
+        const int8_t flat = flat_mask4(1, p3, p2, p1, p0, q0, q1, q2, q3);
+        const int8_t flat2 = flat_mask4(1, p6, p5, p4, p0, q0, q4, q5, q6);
+
+        filter14(mask, *thresh, flat, flat2, s - 7 * p, s - 6 * p, s - 5 * p,
+            s - 4 * p, s - 3 * p, s - 2 * p, s - 1 * p, s, s + 1 * p,
+            s + 2 * p, s + 3 * p, s + 4 * p, s + 5 * p, s + 6 * p);
+        ++s;
+    }
+}
+
+void aom_lpf_horizontal_14_c(uint8_t *s, int32_t p, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    mb_lpf_horizontal_edge_w(s, p, blimit, limit, thresh, 1);
+}
 
 static void mb_lpf_vertical_edge_w(uint8_t *s, int32_t p, const uint8_t *blimit,
     const uint8_t *limit, const uint8_t *thresh,
@@ -388,6 +432,10 @@ static void mb_lpf_vertical_edge_w(uint8_t *s, int32_t p, const uint8_t *blimit,
     }
 }
 
+void aom_lpf_vertical_14_c(uint8_t *s, int32_t p, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    mb_lpf_vertical_edge_w(s, p, blimit, limit, thresh, 4);
+}
 
 void aom_lpf_vertical_14_dual_c(uint8_t *s, int32_t p, const uint8_t *blimit,
     const uint8_t *limit, const uint8_t *thresh) {
@@ -593,6 +641,45 @@ static INLINE void highbd_filter8(int8_t mask, uint8_t thresh, int8_t flat,
     }
 }
 
+void aom_highbd_lpf_horizontal_6_c(uint16_t *s, int32_t p, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    int32_t i;
+    int32_t count = 4;
+
+    for (i = 0; i < count; ++i) {
+        const uint16_t p2 = s[-3 * p], p1 = s[-2 * p], p0 = s[-p];
+        const uint16_t q0 = s[0 * p], q1 = s[1 * p], q2 = s[2 * p];
+
+        const int8_t mask =
+            highbd_filter_mask3_chroma(*limit, *blimit, p2, p1, p0, q0, q1, q2, bd);
+        const int8_t flat =
+            highbd_flat_mask3_chroma(1, p2, p1, p0, q0, q1, q2, bd);
+        highbd_filter6(mask, *thresh, flat, s - 3 * p, s - 2 * p, s - 1 * p, s,
+            s + 1 * p, s + 2 * p, bd);
+        ++s;
+    }
+}
+
+void aom_highbd_lpf_vertical_6_c(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    int32_t i;
+    int32_t count = 4;
+
+    for (i = 0; i < count; ++i) {
+        const uint16_t p2 = s[-3], p1 = s[-2], p0 = s[-1];
+        const uint16_t q0 = s[0], q1 = s[1], q2 = s[2];
+        const int8_t mask =
+            highbd_filter_mask3_chroma(*limit, *blimit, p2, p1, p0, q0, q1, q2, bd);
+        const int8_t flat =
+            highbd_flat_mask3_chroma(1, p2, p1, p0, q0, q1, q2, bd);
+        highbd_filter6(mask, *thresh, flat, s - 3, s - 2, s - 1, s, s + 1, s + 2,
+            bd);
+        s += pitch;
+    }
+}
+
 void aom_highbd_lpf_horizontal_8_c(uint16_t *s, int32_t p, const uint8_t *blimit,
     const uint8_t *limit, const uint8_t *thresh,
     int32_t bd) {
@@ -697,6 +784,201 @@ static INLINE void highbd_filter14(int8_t mask, uint8_t thresh, int8_t flat,
     }
 }
 
+static void highbd_mb_lpf_horizontal_edge_w(uint16_t *s, int32_t p,
+    const uint8_t *blimit,
+    const uint8_t *limit,
+    const uint8_t *thresh, int32_t count,
+    int32_t bd) {
+    int32_t i;
+    int32_t step = 4;
+
+    for (i = 0; i < step * count; ++i) {
+        const uint16_t p3 = s[-4 * p];
+        const uint16_t p2 = s[-3 * p];
+        const uint16_t p1 = s[-2 * p];
+        const uint16_t p0 = s[-p];
+        const uint16_t q0 = s[0 * p];
+        const uint16_t q1 = s[1 * p];
+        const uint16_t q2 = s[2 * p];
+        const uint16_t q3 = s[3 * p];
+        const int8_t mask =
+            highbd_filter_mask(*limit, *blimit, p3, p2, p1, p0, q0, q1, q2, q3, bd);
+        const int8_t flat =
+            highbd_flat_mask4(1, p3, p2, p1, p0, q0, q1, q2, q3, bd);
+        const int8_t flat2 =
+            highbd_flat_mask4(1, s[-7 * p], s[-6 * p], s[-5 * p], p0, q0, s[4 * p],
+                s[5 * p], s[6 * p], bd);
+
+        highbd_filter14(mask, *thresh, flat, flat2, s - 7 * p, s - 6 * p, s - 5 * p,
+            s - 4 * p, s - 3 * p, s - 2 * p, s - 1 * p, s, s + 1 * p,
+            s + 2 * p, s + 3 * p, s + 4 * p, s + 5 * p, s + 6 * p, bd);
+        ++s;
+    }
+}
+
+void aom_highbd_lpf_horizontal_14_c(uint16_t *s, int32_t pitch,
+    const uint8_t *blimit, const uint8_t *limit,
+    const uint8_t *thresh, int32_t bd) {
+    highbd_mb_lpf_horizontal_edge_w(s, pitch, blimit, limit, thresh, 1, bd);
+}
+
+static void highbd_mb_lpf_vertical_edge_w(uint16_t *s, int32_t p,
+    const uint8_t *blimit,
+    const uint8_t *limit,
+    const uint8_t *thresh, int32_t count,
+    int32_t bd) {
+    int32_t i;
+
+    for (i = 0; i < count; ++i) {
+        const uint16_t p3 = s[-4];
+        const uint16_t p2 = s[-3];
+        const uint16_t p1 = s[-2];
+        const uint16_t p0 = s[-1];
+        const uint16_t q0 = s[0];
+        const uint16_t q1 = s[1];
+        const uint16_t q2 = s[2];
+        const uint16_t q3 = s[3];
+        const int8_t mask =
+            highbd_filter_mask(*limit, *blimit, p3, p2, p1, p0, q0, q1, q2, q3, bd);
+        const int8_t flat =
+            highbd_flat_mask4(1, p3, p2, p1, p0, q0, q1, q2, q3, bd);
+        const int8_t flat2 =
+            highbd_flat_mask4(1, s[-7], s[-6], s[-5], p0, q0, s[4], s[5], s[6], bd);
+
+        highbd_filter14(mask, *thresh, flat, flat2, s - 7, s - 6, s - 5, s - 4,
+            s - 3, s - 2, s - 1, s, s + 1, s + 2, s + 3, s + 4, s + 5, s + 6,
+            bd);
+        s += p;
+    }
+}
+
+void aom_highbd_lpf_vertical_14_c(uint16_t *s, int32_t p, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    highbd_mb_lpf_vertical_edge_w(s, p, blimit, limit, thresh, 4, bd);
+}
+
+// 4 adjacent segments of an edge, all at the same filter level
+void aom_lpf_horizontal_4_quad_c(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_lpf_horizontal_4_c(s + 4 * i, pitch, blimit, limit, thresh);
+}
+
+void aom_lpf_horizontal_6_quad_c(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_lpf_horizontal_6_c(s + 4 * i, pitch, blimit, limit, thresh);
+}
+
+void aom_lpf_horizontal_8_quad_c(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_lpf_horizontal_8_c(s + 4 * i, pitch, blimit, limit, thresh);
+}
+
+void aom_lpf_horizontal_14_quad_c(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_lpf_horizontal_14_c(s + 4 * i, pitch, blimit, limit, thresh);
+}
+
+void aom_lpf_vertical_4_quad_c(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_lpf_vertical_4_c(s + 4 * i * pitch, pitch, blimit, limit, thresh);
+}
+
+void aom_lpf_vertical_6_quad_c(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_lpf_vertical_6_c(s + 4 * i * pitch, pitch, blimit, limit, thresh);
+}
+
+void aom_lpf_vertical_8_quad_c(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_lpf_vertical_8_c(s + 4 * i * pitch, pitch, blimit, limit, thresh);
+}
+
+void aom_lpf_vertical_14_quad_c(uint8_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_lpf_vertical_14_c(s + 4 * i * pitch, pitch, blimit, limit, thresh);
+}
+
+void aom_highbd_lpf_horizontal_4_quad_c(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_highbd_lpf_horizontal_4_c(s + 4 * i, pitch, blimit, limit, thresh, bd);
+}
+
+void aom_highbd_lpf_horizontal_6_quad_c(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_highbd_lpf_horizontal_6_c(s + 4 * i, pitch, blimit, limit, thresh, bd);
+}
+
+void aom_highbd_lpf_horizontal_8_quad_c(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_highbd_lpf_horizontal_8_c(s + 4 * i, pitch, blimit, limit, thresh, bd);
+}
+
+void aom_highbd_lpf_horizontal_14_quad_c(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_highbd_lpf_horizontal_14_c(s + 4 * i, pitch, blimit, limit, thresh, bd);
+}
+
+void aom_highbd_lpf_vertical_4_quad_c(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_highbd_lpf_vertical_4_c(s + 4 * i * pitch, pitch, blimit, limit, thresh, bd);
+}
+
+void aom_highbd_lpf_vertical_6_quad_c(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_highbd_lpf_vertical_6_c(s + 4 * i * pitch, pitch, blimit, limit, thresh, bd);
+}
+
+void aom_highbd_lpf_vertical_8_quad_c(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_highbd_lpf_vertical_8_c(s + 4 * i * pitch, pitch, blimit, limit, thresh, bd);
+}
+
+void aom_highbd_lpf_vertical_14_quad_c(uint16_t *s, int32_t pitch, const uint8_t *blimit,
+    const uint8_t *limit, const uint8_t *thresh,
+    int32_t bd) {
+    int32_t i;
+    for (i = 0; i < 4; ++i)
+        aom_highbd_lpf_vertical_14_c(s + 4 * i * pitch, pitch, blimit, limit, thresh, bd);
+}
+
 
 
 //**********************************************************************************************************************//
@@ -1122,6 +1404,213 @@ static TxSize set_lpf_parameters(
     return ts;
 }
 
+// Edges of LPF_QUAD adjacent rows (vertical edges) or columns (horizontal
+// edges) are filtered together when they share the filter length and level
+#define LPF_QUAD 4
+
+// set_lpf_parameters() with the filtering disabled for invalid mode info
+static TxSize get_lpf_parameters(
+    AV1_DEBLOCKING_PARAMETERS *const params, const uint64_t mode_step,
+    const PictureControlSet_t *const  pcsPtr, const MacroBlockD *const xd,
+    const EDGE_DIR edge_dir, const uint32_t x, const uint32_t y,
+    const int32_t plane, const struct MacroblockdPlane *const plane_ptr) {
+    TxSize tx_size;
+    memset(params, 0, sizeof(*params));
+
+    tx_size = set_lpf_parameters(params, mode_step, pcsPtr, xd, edge_dir, x, y,
+        plane, plane_ptr);
+    if (tx_size == TX_INVALID) {
+        params->filter_length = 0;
+        tx_size = TX_4X4;
+    }
+    ASSERT(tx_size < TX_SIZES_ALL);
+    return tx_size;
+}
+
+static void filter_vert_edge(
+    uint8_t *p, const int32_t dst_stride, const AV1_DEBLOCKING_PARAMETERS *const params,
+    const int32_t plane, const EbBool is16bit, const int32_t bit_depth) {
+    switch (params->filter_length) {
+        // apply 4-tap filtering
+    case 4:
+        if (is16bit)
+            aom_highbd_lpf_vertical_4((uint16_t*)(p), dst_stride, params->mblim,
+                params->lim, params->hev_thr, bit_depth);
+        else
+            aom_lpf_vertical_4(p, dst_stride, params->mblim, params->lim,
+                params->hev_thr);
+        break;
+        // apply 6-tap filter for chroma plane only
+    case 6:
+        assert(plane != 0);
+        if (is16bit)
+            aom_highbd_lpf_vertical_6((uint16_t*)(p), dst_stride, params->mblim,
+                params->lim, params->hev_thr, bit_depth);
+        else
+            aom_lpf_vertical_6(p, dst_stride, params->mblim, params->lim,
+                params->hev_thr);
+        break;
+        // apply 8-tap filtering
+    case 8:
+        if (is16bit)
+            aom_highbd_lpf_vertical_8((uint16_t*)(p), dst_stride, params->mblim,
+                params->lim, params->hev_thr, bit_depth);
+        else
+            aom_lpf_vertical_8(p, dst_stride, params->mblim, params->lim,
+                params->hev_thr);
+        break;
+        // apply 14-tap filtering
+    case 14:
+        if (is16bit)
+            aom_highbd_lpf_vertical_14((uint16_t*)(p), dst_stride, params->mblim,
+                params->lim, params->hev_thr, bit_depth);
+        else
+            aom_lpf_vertical_14(p, dst_stride, params->mblim, params->lim,
+                params->hev_thr);
+        break;
+        // no filtering
+    default: break;
+    }
+}
+
+static void filter_vert_edge_quad(
+    uint8_t *p, const int32_t dst_stride, const AV1_DEBLOCKING_PARAMETERS *const params,
+    const int32_t plane, const EbBool is16bit, const int32_t bit_depth) {
+    switch (params->filter_length) {
+        // apply 4-tap filtering
+    case 4:
+        if (is16bit)
+            aom_highbd_lpf_vertical_4_quad((uint16_t*)(p), dst_stride, params->mblim,
+                params->lim, params->hev_thr, bit_depth);
+        else
+            aom_lpf_vertical_4_quad(p, dst_stride, params->mblim, params->lim,
+                params->hev_thr);
+        break;
+        // apply 6-tap filter for chroma plane only
+    case 6:
+        assert(plane != 0);
+        if (is16bit)
+            aom_highbd_lpf_vertical_6_quad((uint16_t*)(p), dst_stride, params->mblim,
+                params->lim, params->hev_thr, bit_depth);
+        else
+            aom_lpf_vertical_6_quad(p, dst_stride, params->mblim, params->lim,
+                params->hev_thr);
+        break;
+        // apply 8-tap filtering
+    case 8:
+        if (is16bit)
+            aom_highbd_lpf_vertical_8_quad((uint16_t*)(p), dst_stride, params->mblim,
+                params->lim, params->hev_thr, bit_depth);
+        else
+            aom_lpf_vertical_8_quad(p, dst_stride, params->mblim, params->lim,
+                params->hev_thr);
+        break;
+        // apply 14-tap filtering
+    case 14:
+        if (is16bit)
+            aom_highbd_lpf_vertical_14_quad((uint16_t*)(p), dst_stride, params->mblim,
+                params->lim, params->hev_thr, bit_depth);
+        else
+            aom_lpf_vertical_14_quad(p, dst_stride, params->mblim, params->lim,
+                params->hev_thr);
+        break;
+        // no filtering
+    default: break;
+    }
+}
+
+static void filter_horz_edge(
+    uint8_t *p, const int32_t dst_stride, const AV1_DEBLOCKING_PARAMETERS *const params,
+    const int32_t plane, const EbBool is16bit, const int32_t bit_depth) {
+    switch (params->filter_length) {
+        // apply 4-tap filtering
+    case 4:
+        if (is16bit)
+            aom_highbd_lpf_horizontal_4((uint16_t*)(p), dst_stride, params->mblim,
+                params->lim, params->hev_thr, bit_depth);
+        else
+            aom_lpf_horizontal_4(p, dst_stride, params->mblim, params->lim,
+                params->hev_thr);
+        break;
+        // apply 6-tap filter for chroma plane only
+    case 6:
+        assert(plane != 0);
+        if (is16bit)
+            aom_highbd_lpf_horizontal_6((uint16_t*)(p), dst_stride, params->mblim,
+                params->lim, params->hev_thr, bit_depth);
+        else
+            aom_lpf_horizontal_6(p, dst_stride, params->mblim, params->lim,
+                params->hev_thr);
+        break;
+        // apply 8-tap filtering
+    case 8:
+        if (is16bit)
+            aom_highbd_lpf_horizontal_8((uint16_t*)(p), dst_stride, params->mblim,
+                params->lim, params->hev_thr, bit_depth);
+        else
+            aom_lpf_horizontal_8(p, dst_stride, params->mblim, params->lim,
+                params->hev_thr);
+        break;
+        // apply 14-tap filtering
+    case 14:
+        if (is16bit)
+            aom_highbd_lpf_horizontal_14((uint16_t*)(p), dst_stride, params->mblim,
+                params->lim, params->hev_thr, bit_depth);
+        else
+            aom_lpf_horizontal_14(p, dst_stride, params->mblim, params->lim,
+                params->hev_thr);
+        break;
+        // no filtering
+    default: break;
+    }
+}
+
+static void filter_horz_edge_quad(
+    uint8_t *p, const int32_t dst_stride, const AV1_DEBLOCKING_PARAMETERS *const params,
+    const int32_t plane, const EbBool is16bit, const int32_t bit_depth) {
+    switch (params->filter_length) {
+        // apply 4-tap filtering
+    case 4:
+        if (is16bit)
+            aom_highbd_lpf_horizontal_4_quad((uint16_t*)(p), dst_stride, params->mblim,
+                params->lim, params->hev_thr, bit_depth);
+        else
+            aom_lpf_horizontal_4_quad(p, dst_stride, params->mblim, params->lim,
+                params->hev_thr);
+        break;
+        // apply 6-tap filter for chroma plane only
+    case 6:
+        assert(plane != 0);
+        if (is16bit)
+            aom_highbd_lpf_horizontal_6_quad((uint16_t*)(p), dst_stride, params->mblim,
+                params->lim, params->hev_thr, bit_depth);
+        else
+            aom_lpf_horizontal_6_quad(p, dst_stride, params->mblim, params->lim,
+                params->hev_thr);
+        break;
+        // apply 8-tap filtering
+    case 8:
+        if (is16bit)
+            aom_highbd_lpf_horizontal_8_quad((uint16_t*)(p), dst_stride, params->mblim,
+                params->lim, params->hev_thr, bit_depth);
+        else
+            aom_lpf_horizontal_8_quad(p, dst_stride, params->mblim, params->lim,
+                params->hev_thr);
+        break;
+        // apply 14-tap filtering
+    case 14:
+        if (is16bit)
+            aom_highbd_lpf_horizontal_14_quad((uint16_t*)(p), dst_stride, params->mblim,
+                params->lim, params->hev_thr, bit_depth);
+        else
+            aom_lpf_horizontal_14_quad(p, dst_stride, params->mblim, params->lim,
+                params->hev_thr);
+        break;
+        // no filtering
+    default: break;
+    }
+}
+
 void av1_filter_block_plane_vert(
     const PictureControlSet_t *const  pcsPtr,
     const MacroBlockD *const xd, const int32_t plane,
@@ -1130,116 +1619,60 @@ void av1_filter_block_plane_vert(
 
     SequenceControlSet_t *scsPtr = (SequenceControlSet_t*)pcsPtr->parent_pcs_ptr->sequence_control_set_wrapper_ptr->objectPtr;
     EbBool is16bit = scsPtr->static_config.encoder_bit_depth > 8;
-    const int32_t row_step = MI_SIZE >> MI_SIZE_LOG2;
+    const int32_t bit_depth = scsPtr->static_config.encoder_bit_depth;
     const uint32_t scale_horz = plane_ptr->subsampling_x;
     const uint32_t scale_vert = plane_ptr->subsampling_y;
     uint8_t *const dst_ptr = plane_ptr->dst.buf;
     const int32_t dst_stride = plane_ptr->dst.stride;
     const int32_t y_range = scsPtr->sb_size == BLOCK_128X128 ? (MAX_MIB_SIZE >> scale_vert) : (SB64_MIB_SIZE >> scale_vert);
     const int32_t x_range = scsPtr->sb_size == BLOCK_128X128 ? (MAX_MIB_SIZE >> scale_horz) : (SB64_MIB_SIZE >> scale_horz);
-    for (int32_t y = 0; y < y_range; y += row_step) {
-        uint8_t *p = dst_ptr + ((y * MI_SIZE * dst_stride) << plane_ptr->is16Bit);
-        for (int32_t x = 0; x < x_range;) {
-            // inner loop always filter vertical edges in a MI block. If MI size
-            // is 8x8, it will filter the vertical edge aligned with a 8x8 block.
-            // If 4x4 trasnform is used, it will then filter the internal edge
-            //  aligned with a 4x4 block
-            const uint32_t curr_x = ((mi_col * MI_SIZE) >> scale_horz) + x * MI_SIZE;
-            const uint32_t curr_y = ((mi_row * MI_SIZE) >> scale_vert) + y * MI_SIZE;
-            uint32_t advance_units;
-            TxSize tx_size;
-            AV1_DEBLOCKING_PARAMETERS params;
-            memset(&params, 0, sizeof(params));
-
-            tx_size =
-                set_lpf_parameters(&params, ((uint64_t)1 << scale_horz), pcsPtr, xd,
-                    VERT_EDGE, curr_x, curr_y, plane, plane_ptr);
-            if (tx_size == TX_INVALID) {
-                params.filter_length = 0;
-                tx_size = TX_4X4;
+    for (int32_t y = 0; y < y_range; y += LPF_QUAD) {
+        // The vertical edges of different rows do not overlap: each row keeps
+        // its own position, and the rows at the leftmost position are filtered
+        // first, so that the samples of a row are filtered in the same order
+        const int32_t rows = AOMMIN(LPF_QUAD, y_range - y);
+        const uint32_t curr_y = ((mi_row * MI_SIZE) >> scale_vert) + y * MI_SIZE;
+        int32_t x[LPF_QUAD];
+        TxSize tx_size[LPF_QUAD];
+        AV1_DEBLOCKING_PARAMETERS params[LPF_QUAD];
+        int32_t r;
+
+        for (r = 0; r < rows; ++r) {
+            x[r] = 0;
+            tx_size[r] = get_lpf_parameters(&params[r], ((uint64_t)1 << scale_horz),
+                pcsPtr, xd, VERT_EDGE, (mi_col * MI_SIZE) >> scale_horz,
+                curr_y + r * MI_SIZE, plane, plane_ptr);
+        }
+        for (;;) {
+            int32_t x_min = x_range;
+            EbBool quad = rows == LPF_QUAD;
+            uint8_t *p;
+
+            for (r = 0; r < rows; ++r)
+                x_min = AOMMIN(x_min, x[r]);
+            if (x_min >= x_range) break;
+            p = dst_ptr + (((y * MI_SIZE * dst_stride) + x_min * MI_SIZE) << plane_ptr->is16Bit);
+
+            for (r = 0; r < rows; ++r) {
+                quad = quad && x[r] == x_min &&
+                    params[r].filter_length == params[0].filter_length &&
+                    params[r].lim == params[0].lim;
             }
-
-            switch (params.filter_length) {
-                // apply 4-tap filtering
-            case 4:
-                if (is16bit)
-                    aom_highbd_lpf_vertical_4(
-                    (uint16_t*)(p),//CONVERT_TO_SHORTPTR(p),
-                        dst_stride,
-                        params.mblim,
-                        params.lim,
-                        params.hev_thr,
-                        scsPtr->static_config.encoder_bit_depth);
-                else
-                    aom_lpf_vertical_4(
-                        p,
-                        dst_stride,
-                        params.mblim,
-                        params.lim,
-                        params.hev_thr);
-                break;
-            case 6:  // apply 6-tap filter for chroma plane only
-                assert(plane != 0);
-                if (is16bit)
-                    aom_highbd_lpf_vertical_6(
-                    (uint16_t*)(p),//CONVERT_TO_SHORTPTR(p),
-                        dst_stride,
-                        params.mblim,
-                        params.lim,
-                        params.hev_thr,
-                        scsPtr->static_config.encoder_bit_depth);
-                else
-                    aom_lpf_vertical_6(
-                        p,
-                        dst_stride,
-                        params.mblim,
-                        params.lim,
-                        params.hev_thr);
-                break;
-                // apply 8-tap filtering
-            case 8:
-                if (is16bit)
-                    aom_highbd_lpf_vertical_8(
-                    (uint16_t*)(p),//CONVERT_TO_SHORTPTR(p),
-                        dst_stride,
-                        params.mblim,
-                        params.lim,
-                        params.hev_thr,
-                        scsPtr->static_config.encoder_bit_depth);
-                else
-                    aom_lpf_vertical_8(
-                        p,
-                        dst_stride,
-                        params.mblim,
-                        params.lim,
-                        params.hev_thr);
-                break;
-                // apply 14-tap filtering
-            case 14:
-                if (is16bit)
-                    aom_highbd_lpf_vertical_14(
-                    (uint16_t*)(p),//CONVERT_TO_SHORTPTR(p),
-                        dst_stride,
-                        params.mblim,
-                        params.lim,
-                        params.hev_thr,
-                        scsPtr->static_config.encoder_bit_depth);
-                else
-                    aom_lpf_vertical_14(
-                        p,
-                        dst_stride,
-                        params.mblim,
-                        params.lim,
-                        params.hev_thr);
-                break;
-                // no filtering
-            default: break;
+            if (quad)
+                filter_vert_edge_quad(p, dst_stride, &params[0], plane, is16bit, bit_depth);
+            for (r = 0; r < rows; ++r) {
+                if (x[r] != x_min) continue;
+                if (!quad)
+                    filter_vert_edge(p + ((r * MI_SIZE * dst_stride) << plane_ptr->is16Bit),
+                        dst_stride, &params[r], plane, is16bit, bit_depth);
+                // advance to the next edge of the row
+                x[r] += tx_size_wide_unit[tx_size[r]];
+                if (x[r] < x_range) {
+                    tx_size[r] = get_lpf_parameters(&params[r], ((uint64_t)1 << scale_horz),
+                        pcsPtr, xd, VERT_EDGE, ((mi_col * MI_SIZE) >> scale_horz) + x[r] * MI_SIZE,
+                        curr_y + r * MI_SIZE, plane, plane_ptr);
+                }
             }
-            // advance the destination pointer
-            ASSERT(tx_size < TX_SIZES_ALL);
-            advance_units = tx_size_wide_unit[tx_size];
-            x += advance_units;
-            p += ((advance_units * MI_SIZE) << plane_ptr->is16Bit);
         }
     }
 }
@@ -1252,7 +1685,7 @@ void av1_filter_block_plane_horz(
 
     SequenceControlSet_t *scsPtr = (SequenceControlSet_t*)pcsPtr->parent_pcs_ptr->sequence_control_set_wrapper_ptr->objectPtr;
     EbBool is16bit = scsPtr->static_config.encoder_bit_depth > 8;
-    const int32_t col_step = MI_SIZE >> MI_SIZE_LOG2;
+    const int32_t bit_depth = scsPtr->static_config.encoder_bit_depth;
     const uint32_t scale_horz = plane_ptr->subsampling_x;
     const uint32_t scale_vert = plane_ptr->subsampling_y;
     uint8_t *const dst_ptr = plane_ptr->dst.buf;
@@ -1260,121 +1693,52 @@ void av1_filter_block_plane_horz(
     const int32_t y_range = scsPtr->sb_size == BLOCK_128X128 ? (MAX_MIB_SIZE >> scale_vert) : (SB64_MIB_SIZE >> scale_vert);
     const int32_t x_range = scsPtr->sb_size == BLOCK_128X128 ? (MAX_MIB_SIZE >> scale_horz) : (SB64_MIB_SIZE >> scale_horz);
     uint32_t mi_stride = pcsPtr->parent_pcs_ptr->sequence_control_set_ptr->picture_width_in_sb*(BLOCK_SIZE_64 >> MI_SIZE_LOG2);
-    for (int32_t x = 0; x < x_range; x += col_step) {
-        uint8_t *p = dst_ptr + ((x * MI_SIZE) << plane_ptr->is16Bit);
-        for (int32_t y = 0; y < y_range;) {
-            // inner loop always filter vertical edges in a MI block. If MI size
-            // is 8x8, it will first filter the vertical edge aligned with a 8x8
-            // block. If 4x4 trasnform is used, it will then filter the internal
-            // edge aligned with a 4x4 block
-            const uint32_t curr_x = ((mi_col * MI_SIZE) >> scale_horz) + x * MI_SIZE;
-            const uint32_t curr_y = ((mi_row * MI_SIZE) >> scale_vert) + y * MI_SIZE;
-            uint32_t advance_units;
-            TxSize tx_size;
-            AV1_DEBLOCKING_PARAMETERS params;
-            memset(&params, 0, sizeof(params));
-
-
-            tx_size =
-                set_lpf_parameters(
-                    &params,
-                    //(pcsPtr->parent_pcs_ptr->av1_cm->mi_stride << scale_vert),
-                    (mi_stride << scale_vert),
-                    pcsPtr,
-                    xd,
-                    HORZ_EDGE,
-                    curr_x,
-                    curr_y,
-                    plane,
-                    plane_ptr);
-            if (tx_size == TX_INVALID) {
-                params.filter_length = 0;
-                tx_size = TX_4X4;
+    for (int32_t x = 0; x < x_range; x += LPF_QUAD) {
+        // The horizontal edges of different columns do not overlap, see
+        // av1_filter_block_plane_vert()
+        const int32_t cols = AOMMIN(LPF_QUAD, x_range - x);
+        const uint32_t curr_x = ((mi_col * MI_SIZE) >> scale_horz) + x * MI_SIZE;
+        int32_t y[LPF_QUAD];
+        TxSize tx_size[LPF_QUAD];
+        AV1_DEBLOCKING_PARAMETERS params[LPF_QUAD];
+        int32_t c;
+
+        for (c = 0; c < cols; ++c) {
+            y[c] = 0;
+            tx_size[c] = get_lpf_parameters(&params[c], (mi_stride << scale_vert),
+                pcsPtr, xd, HORZ_EDGE, curr_x + c * MI_SIZE,
+                (mi_row * MI_SIZE) >> scale_vert, plane, plane_ptr);
+        }
+        for (;;) {
+            int32_t y_min = y_range;
+            EbBool quad = cols == LPF_QUAD;
+            uint8_t *p;
+
+            for (c = 0; c < cols; ++c)
+                y_min = AOMMIN(y_min, y[c]);
+            if (y_min >= y_range) break;
+            p = dst_ptr + (((y_min * MI_SIZE * dst_stride) + x * MI_SIZE) << plane_ptr->is16Bit);
+
+            for (c = 0; c < cols; ++c) {
+                quad = quad && y[c] == y_min &&
+                    params[c].filter_length == params[0].filter_length &&
+                    params[c].lim == params[0].lim;
             }
-
-            switch (params.filter_length) {
-                // apply 4-tap filtering
-            case 4:
-                if (is16bit)
-                    aom_highbd_lpf_horizontal_4(
-                    (uint16_t*)(p),//CONVERT_TO_SHORTPTR(p),
-                        dst_stride,
-                        params.mblim,
-                        params.lim,
-                        params.hev_thr,
-                        scsPtr->static_config.encoder_bit_depth);
-                else
-                    aom_lpf_horizontal_4(
-                        p,
-                        dst_stride,
-                        params.mblim,
-                        params.lim,
-                        params.hev_thr);
-                break;
-                // apply 6-tap filtering
-            case 6:
-                assert(plane != 0);
-                if (is16bit)
-                    aom_highbd_lpf_horizontal_6(
-                    (uint16_t*)(p),//CONVERT_TO_SHORTPTR(p),
-                        dst_stride,
-                        params.mblim,
-                        params.lim,
-                        params.hev_thr,
-                        scsPtr->static_config.encoder_bit_depth);
-                else
-                    aom_lpf_horizontal_6(
-                        p,
-                        dst_stride,
-                        params.mblim,
-                        params.lim,
-                        params.hev_thr);
-                break;
-                // apply 8-tap filtering
-            case 8:
-                if (is16bit)
-                    aom_highbd_lpf_horizontal_8(
-                    (uint16_t*)(p),//CONVERT_TO_SHORTPTR(p),
-                        dst_stride,
-                        params.mblim,
-                        params.lim,
-                        params.hev_thr,
-                        scsPtr->static_config.encoder_bit_depth);
-                else
-                    aom_lpf_horizontal_8(
-                        p,
-                        dst_stride,
-                        params.mblim,
-                        params.lim,
-                        params.hev_thr);
-                break;
-                // apply 14-tap filtering
-            case 14:
-                if (is16bit)
-                    aom_highbd_lpf_horizontal_14(
-                    (uint16_t*)(p),//CONVERT_TO_SHORTPTR(p),
-                        dst_stride,
-                        params.mblim,
-                        params.lim,
-                        params.hev_thr,
-                        scsPtr->static_config.encoder_bit_depth);
-                else
-                    aom_lpf_horizontal_14(
-                        p,
-                        dst_stride,
-                        params.mblim,
-                        params.lim,
-                        params.hev_thr);
-                break;
-                // no filtering
-            default: break;
+            if (quad)
+                filter_horz_edge_quad(p, dst_stride, &params[0], plane, is16bit, bit_depth);
+            for (c = 0; c < cols; ++c) {
+                if (y[c] != y_min) continue;
+                if (!quad)
+                    filter_horz_edge(p + ((c * MI_SIZE) << plane_ptr->is16Bit),
+                        dst_stride, &params[c], plane, is16bit, bit_depth);
+                // advance to the next edge of the column
+                y[c] += tx_size_high_unit[tx_size[c]];
+                if (y[c] < y_range) {
+                    tx_size[c] = get_lpf_parameters(&params[c], (mi_stride << scale_vert),
+                        pcsPtr, xd, HORZ_EDGE, curr_x + c * MI_SIZE,
+                        ((mi_row * MI_SIZE) >> scale_vert) + y[c] * MI_SIZE, plane, plane_ptr);
+                }
             }
-
-            // advance the destination pointer
-            ASSERT(tx_size < TX_SIZES_ALL);
-            advance_units = tx_size_high_unit[tx_size];
-            y += advance_units;
-            p += ((advance_units * dst_stride * MI_SIZE) << plane_ptr->is16Bit);
         }
     }
 }
@@ -1499,13 +1863,66 @@ void av1_loop_filter_frame(
     }
 
 }
+
+// Deblocks one SB row of the frame. The rows are filtered as a wavefront:
+// before each SB the row waits until the row above is two SBs ahead, since the
+// horizontal edges at the top of the row change the last pixel rows of the row
+// above, and it posts the semaphore of the row below once per deblocked SB.
+// av1_loop_filter_frame_init() must have been called for the frame.
+void av1_loop_filter_sb_row(
+    EbPictureBufferDesc_t *frame_buffer,
+    PictureControlSet_t *picture_control_set_ptr,
+    uint32_t yLcuIndex,
+    int32_t plane_start, int32_t plane_end) {
+
+    SequenceControlSet_t *scsPtr = (SequenceControlSet_t*)picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_wrapper_ptr->objectPtr;
+    uint8_t                                   sb_size_Log2 = (uint8_t)Log2f(scsPtr->sb_size_pix);
+    uint32_t                                   xLcuIndex;
+    uint32_t                                   sb_origin_x;
+    uint32_t                                   sb_origin_y;
+    uint32_t                                   aboveDoneCount = 0;
+    EbBool                                  endOfRowFlag;
+
+    uint32_t picture_width_in_sb = (scsPtr->luma_width + scsPtr->sb_size_pix - 1) / scsPtr->sb_size_pix;
+    uint32_t picture_height_in_sb = (scsPtr->luma_height + scsPtr->sb_size_pix - 1) / scsPtr->sb_size_pix;
+
+    for (xLcuIndex = 0; xLcuIndex < picture_width_in_sb; ++xLcuIndex) {
+        if (yLcuIndex > 0) {
+            while (aboveDoneCount < AOMMIN(xLcuIndex + 2, picture_width_in_sb)) {
+                EbBlockOnSemaphore(picture_control_set_ptr->dlf_row_semaphore_array[yLcuIndex]);
+                ++aboveDoneCount;
+            }
+        }
+
+        sb_origin_x = xLcuIndex << sb_size_Log2;
+        sb_origin_y = yLcuIndex << sb_size_Log2;
+        endOfRowFlag = (xLcuIndex == picture_width_in_sb - 1) ? EB_TRUE : EB_FALSE;
+
+        loop_filter_sb(
+            frame_buffer,
+            picture_control_set_ptr,
+            NULL,
+            sb_origin_y >> 2,
+            sb_origin_x >> 2,
+            plane_start,
+            plane_end,
+            endOfRowFlag);
+
+        if (yLcuIndex + 1 < picture_height_in_sb)
+            EbPostSemaphore(picture_control_set_ptr->dlf_row_semaphore_array[yLcuIndex + 1]);
+    }
+}
 extern int16_t av1_ac_quant_Q3(int32_t qindex, int32_t delta, aom_bit_depth_t bit_depth);
 
+// Copies the luma rows [y_start, y_end) of the plane, the matching rows for
+// chroma
 void EbCopyBuffer(
     EbPictureBufferDesc_t  *srcBuffer,
     EbPictureBufferDesc_t  *dstBuffer,
     PictureControlSet_t    *pcsPtr,
-    uint8_t                   plane) {
+    uint8_t                   plane,
+    uint32_t                  y_start,
+    uint32_t                  y_end) {
 
     EbBool is16bit = (EbBool)(pcsPtr->parent_pcs_ptr->sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
     dstBuffer->origin_x = srcBuffer->origin_x;
@@ -1523,6 +1940,8 @@ void EbCopyBuffer(
     uint16_t   luma_width = (uint16_t)(srcBuffer->width - pcsPtr->parent_pcs_ptr->sequence_control_set_ptr->pad_right) << is16bit;
     uint16_t   luma_height = (uint16_t)(srcBuffer->height - pcsPtr->parent_pcs_ptr->sequence_control_set_ptr->pad_bottom);
     uint16_t   chroma_width = (luma_width >> 1);
+    const int32_t row_start = (int32_t)y_start;
+    const int32_t row_end = (int32_t)AOMMIN(y_end, luma_height);
     if (plane == 0) {
 #if LF_10BIT_FIX
         uint16_t strideY = srcBuffer->strideY << is16bit;
@@ -1530,7 +1949,7 @@ void EbCopyBuffer(
         dstBuffer->strideY = srcBuffer->strideY;
         dstBuffer->strideBitIncY = srcBuffer->strideBitIncY;
 
-        for (int32_t inputRowIndex = 0; inputRowIndex < luma_height; inputRowIndex++) {
+        for (int32_t inputRowIndex = row_start; inputRowIndex < row_end; inputRowIndex++) {
 #if LF_10BIT_FIX
             EB_MEMCPY((dstBuffer->bufferY + lumaBufferOffset + strideY * inputRowIndex),
                 (srcBuffer->bufferY + lumaBufferOffset + strideY * inputRowIndex),
@@ -1552,7 +1971,7 @@ void EbCopyBuffer(
 
         uint32_t   chromaBufferOffset = (srcBuffer->origin_x / 2 + srcBuffer->origin_y / 2 * srcBuffer->strideCb) << is16bit;
 
-        for (int32_t inputRowIndex = 0; inputRowIndex < luma_height >> 1; inputRowIndex++) {
+        for (int32_t inputRowIndex = row_start >> 1; inputRowIndex < row_end >> 1; inputRowIndex++) {
 #if LF_10BIT_FIX
             EB_MEMCPY((dstBuffer->bufferCb + chromaBufferOffset + strideCb * inputRowIndex),
                 (srcBuffer->bufferCb + chromaBufferOffset + strideCb * inputRowIndex),
@@ -1573,7 +1992,7 @@ void EbCopyBuffer(
 
         uint32_t   chromaBufferOffset = (srcBuffer->origin_x / 2 + srcBuffer->origin_y / 2 * srcBuffer->strideCr) << is16bit;
 
-        for (int32_t inputRowIndex = 0; inputRowIndex < luma_height >> 1; inputRowIndex++) {
+        for (int32_t inputRowIndex = row_start >> 1; inputRowIndex < row_end >> 1; inputRowIndex++) {
 #if LF_10BIT_FIX
             EB_MEMCPY((dstBuffer->bufferCr + chromaBufferOffset + strideCr * inputRowIndex),
                 (srcBuffer->bufferCr + chromaBufferOffset + strideCr * inputRowIndex),
@@ -1605,31 +2024,37 @@ void EbCopyBuffer(
 //    }
 //}
 
+// Sum of squared errors of the plane over the luma rows [y_start, y_end), the
+// matching rows for chroma
 uint64_t PictureSseCalculations(
     PictureControlSet_t    *picture_control_set_ptr,
     EbPictureBufferDesc_t *reconPtr,
-    int32_t plane)
+    int32_t plane,
+    uint32_t y_start,
+    uint32_t y_end)
 
 {
     SequenceControlSet_t   *sequence_control_set_ptr = picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr;
     EbBool is16bit = (sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    const uint32_t luma_end = MIN(y_end, sequence_control_set_ptr->luma_height);
+    const uint32_t chroma_end = MIN(y_end >> 1, sequence_control_set_ptr->chroma_height);
 
     if (!is16bit) {
 
         EbPictureBufferDesc_t *inputPicturePtr = (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
 
         uint32_t   columnIndex;
-        uint32_t   rowIndex = 0;
+        uint32_t   rowIndex = y_start;
         uint64_t   residualDistortion = 0;
         EbByte  inputBuffer;
         EbByte  reconCoeffBuffer;
         if (plane == 0) {
-            reconCoeffBuffer = &((reconPtr->bufferY)[reconPtr->origin_x + reconPtr->origin_y * reconPtr->strideY]);
-            inputBuffer = &((inputPicturePtr->bufferY)[inputPicturePtr->origin_x + inputPicturePtr->origin_y * inputPicturePtr->strideY]);
+            reconCoeffBuffer = &((reconPtr->bufferY)[reconPtr->origin_x + (reconPtr->origin_y + y_start) * reconPtr->strideY]);
+            inputBuffer = &((inputPicturePtr->bufferY)[inputPicturePtr->origin_x + (inputPicturePtr->origin_y + y_start) * inputPicturePtr->strideY]);
 
             residualDistortion = 0;
 
-            while (rowIndex < sequence_control_set_ptr->luma_height) {
+            while (rowIndex < luma_end) {
 
                 columnIndex = 0;
                 while (columnIndex < sequence_control_set_ptr->luma_width) {
@@ -1646,12 +2071,12 @@ uint64_t PictureSseCalculations(
 
         else if (plane == 1) {
 
-            reconCoeffBuffer = &((reconPtr->bufferCb)[reconPtr->origin_x / 2 + reconPtr->origin_y / 2 * reconPtr->strideCb]);
-            inputBuffer = &((inputPicturePtr->bufferCb)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCb]);
+            reconCoeffBuffer = &((reconPtr->bufferCb)[reconPtr->origin_x / 2 + (reconPtr->origin_y / 2 + (y_start >> 1)) * reconPtr->strideCb]);
+            inputBuffer = &((inputPicturePtr->bufferCb)[inputPicturePtr->origin_x / 2 + (inputPicturePtr->origin_y / 2 + (y_start >> 1)) * inputPicturePtr->strideCb]);
 
             residualDistortion = 0;
-            rowIndex = 0;
-            while (rowIndex < sequence_control_set_ptr->chroma_height) {
+            rowIndex = y_start >> 1;
+            while (rowIndex < chroma_end) {
 
                 columnIndex = 0;
                 while (columnIndex < sequence_control_set_ptr->chroma_width) {
@@ -1667,12 +2092,12 @@ uint64_t PictureSseCalculations(
             return residualDistortion;
         }
         else if (plane == 2) {
-            reconCoeffBuffer = &((reconPtr->bufferCr)[reconPtr->origin_x / 2 + reconPtr->origin_y / 2 * reconPtr->strideCr]);
-            inputBuffer = &((inputPicturePtr->bufferCr)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCr]);
+            reconCoeffBuffer = &((reconPtr->bufferCr)[reconPtr->origin_x / 2 + (reconPtr->origin_y / 2 + (y_start >> 1)) * reconPtr->strideCr]);
+            inputBuffer = &((inputPicturePtr->bufferCr)[inputPicturePtr->origin_x / 2 + (inputPicturePtr->origin_y / 2 + (y_start >> 1)) * inputPicturePtr->strideCr]);
             residualDistortion = 0;
-            rowIndex = 0;
+            rowIndex = y_start >> 1;
 
-            while (rowIndex < sequence_control_set_ptr->chroma_height) {
+            while (rowIndex < chroma_end) {
 
                 columnIndex = 0;
                 while (columnIndex < sequence_control_set_ptr->chroma_width) {
@@ -1694,17 +2119,17 @@ uint64_t PictureSseCalculations(
         EbPictureBufferDesc_t *inputPicturePtr = (EbPictureBufferDesc_t*)picture_control_set_ptr->input_frame16bit;
 
         uint32_t   columnIndex;
-        uint32_t   rowIndex = 0;
+        uint32_t   rowIndex = y_start;
         uint64_t   residualDistortion = 0;
         uint16_t*  inputBuffer;
         uint16_t*  reconCoeffBuffer;
         if (plane == 0) {
-            reconCoeffBuffer = (uint16_t*)&((reconPtr->bufferY)[(reconPtr->origin_x + reconPtr->origin_y * reconPtr->strideY) << is16bit]);
-            inputBuffer = (uint16_t*)&((inputPicturePtr->bufferY)[(inputPicturePtr->origin_x + inputPicturePtr->origin_y * inputPicturePtr->strideY) << is16bit]);
+            reconCoeffBuffer = (uint16_t*)&((reconPtr->bufferY)[(reconPtr->origin_x + (reconPtr->origin_y + y_start) * reconPtr->strideY) << is16bit]);
+            inputBuffer = (uint16_t*)&((inputPicturePtr->bufferY)[(inputPicturePtr->origin_x + (inputPicturePtr->origin_y + y_start) * inputPicturePtr->strideY) << is16bit]);
 
             residualDistortion = 0;
 
-            while (rowIndex < sequence_control_set_ptr->luma_height) {
+            while (rowIndex < luma_end) {
 
                 columnIndex = 0;
                 while (columnIndex < sequence_control_set_ptr->luma_width) {
@@ -1722,12 +2147,12 @@ uint64_t PictureSseCalculations(
 
         else if (plane == 1) {
 
-            reconCoeffBuffer = (uint16_t*)&((reconPtr->bufferCb)[(reconPtr->origin_x / 2 + reconPtr->origin_y / 2 * reconPtr->strideCb) << is16bit]);
-            inputBuffer = (uint16_t*)&((inputPicturePtr->bufferCb)[(inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCb) << is16bit]);
+            reconCoeffBuffer = (uint16_t*)&((reconPtr->bufferCb)[(reconPtr->origin_x / 2 + (reconPtr->origin_y / 2 + (y_start >> 1)) * reconPtr->strideCb) << is16bit]);
+            inputBuffer = (uint16_t*)&((inputPicturePtr->bufferCb)[(inputPicturePtr->origin_x / 2 + (inputPicturePtr->origin_y / 2 + (y_start >> 1)) * inputPicturePtr->strideCb) << is16bit]);
 
             residualDistortion = 0;
-            rowIndex = 0;
-            while (rowIndex < sequence_control_set_ptr->chroma_height) {
+            rowIndex = y_start >> 1;
+            while (rowIndex < chroma_end) {
 
                 columnIndex = 0;
                 while (columnIndex < sequence_control_set_ptr->chroma_width) {
@@ -1743,12 +2168,12 @@ uint64_t PictureSseCalculations(
             return residualDistortion;
         }
         else if (plane == 2) {
-            reconCoeffBuffer = (uint16_t*)&((reconPtr->bufferCr)[(reconPtr->origin_x / 2 + reconPtr->origin_y / 2 * reconPtr->strideCr) << is16bit]);
-            inputBuffer = (uint16_t*)&((inputPicturePtr->bufferCr)[(inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCr) << is16bit]);
+            reconCoeffBuffer = (uint16_t*)&((reconPtr->bufferCr)[(reconPtr->origin_x / 2 + (reconPtr->origin_y / 2 + (y_start >> 1)) * reconPtr->strideCr) << is16bit]);
+            inputBuffer = (uint16_t*)&((inputPicturePtr->bufferCr)[(inputPicturePtr->origin_x / 2 + (inputPicturePtr->origin_y / 2 + (y_start >> 1)) * inputPicturePtr->strideCr) << is16bit]);
             residualDistortion = 0;
-            rowIndex = 0;
+            rowIndex = y_start >> 1;
 
-            while (rowIndex < sequence_control_set_ptr->chroma_height) {
+            while (rowIndex < chroma_end) {
 
                 columnIndex = 0;
                 while (columnIndex < sequence_control_set_ptr->chroma_width) {
@@ -1770,6 +2195,11 @@ uint64_t PictureSseCalculations(
     }
 }
 
+// LPF_PICK_FROM_SUBIMAGE filters and measures one superblock row out of
+// LPF_SUBIMAGE_SB_ROW_STEP, with the rows above it reached by its top edge
+#define LPF_SUBIMAGE_SB_ROW_STEP    2
+#define LPF_SUBIMAGE_TOP_ROWS       8
+
 static int64_t try_filter_frame(
     //const Yv12BufferConfig *sd,
     //AV1_COMP *const cpi,
@@ -1779,8 +2209,6 @@ static int64_t try_filter_frame(
     int32_t filt_level,
     int32_t partial_frame, int32_t plane, int32_t dir) {
     (void)sd;
-    (void)partial_frame;
-    (void)sd;
     int64_t filt_err;
 
     assert(plane >= 0 && plane <= 2);
@@ -1814,14 +2242,46 @@ static int64_t try_filter_frame(
     case 2: pcsPtr->parent_pcs_ptr->lf.filter_level_v = filter_level[0]; break;
     }
 
+    SequenceControlSet_t *scsPtr = pcsPtr->parent_pcs_ptr->sequence_control_set_ptr;
+    if (partial_frame) {
+        const uint32_t sb_size = scsPtr->sb_size_pix;
+        const uint32_t picture_width_in_sb = (scsPtr->luma_width + sb_size - 1) / sb_size;
+        const uint32_t picture_height_in_sb = (scsPtr->luma_height + sb_size - 1) / sb_size;
+        uint32_t xLcuIndex, yLcuIndex;
+
+        av1_loop_filter_frame_init(pcsPtr, plane, plane + 1);
+        filt_err = 0;
+        for (yLcuIndex = 0; yLcuIndex < picture_height_in_sb; yLcuIndex += LPF_SUBIMAGE_SB_ROW_STEP) {
+            const uint32_t y_start = yLcuIndex ? yLcuIndex * sb_size - LPF_SUBIMAGE_TOP_ROWS : 0;
+            const uint32_t y_end = (yLcuIndex + 1) * sb_size;
+
+            for (xLcuIndex = 0; xLcuIndex < picture_width_in_sb; ++xLcuIndex) {
+                loop_filter_sb(
+                    reconBuffer,
+                    pcsPtr,
+                    NULL,
+                    (yLcuIndex * sb_size) >> 2,
+                    (xLcuIndex * sb_size) >> 2,
+                    plane,
+                    plane + 1,
+                    xLcuIndex == picture_width_in_sb - 1);
+            }
+            filt_err += PictureSseCalculations(pcsPtr, reconBuffer, plane, y_start, y_end);
+
+            // Re-instate the unfiltered rows
+            EbCopyBuffer(tempLfReconBuffer, reconBuffer, pcsPtr, (uint8_t)plane, y_start, y_end);
+        }
+        return filt_err;
+    }
+
     av1_loop_filter_frame(reconBuffer, pcsPtr, plane, plane + 1);
 
-    filt_err = PictureSseCalculations(pcsPtr, reconBuffer, plane);
+    filt_err = PictureSseCalculations(pcsPtr, reconBuffer, plane, 0, scsPtr->luma_height);
 
 
 
     // Re-instate the unfiltered frame
-    EbCopyBuffer(tempLfReconBuffer/*cpi->last_frame_uf*/, reconBuffer /*cm->frame_to_show*/, pcsPtr, (uint8_t)plane);
+    EbCopyBuffer(tempLfReconBuffer/*cpi->last_frame_uf*/, reconBuffer /*cm->frame_to_show*/, pcsPtr, (uint8_t)plane, 0, scsPtr->luma_height);
 
     return filt_err;
 }
@@ -1874,7 +2334,8 @@ static int32_t search_filter_level(
     // Set each entry to -1
     memset(ss_err, 0xFF, sizeof(ss_err));
     // make a copy of reconBuffer
-    EbCopyBuffer(reconBuffer/*cm->frame_to_show*/, tempLfReconBuffer/*&cpi->last_frame_uf*/, pcsPtr, (uint8_t)plane);
+    EbCopyBuffer(reconBuffer/*cm->frame_to_show*/, tempLfReconBuffer/*&cpi->last_frame_uf*/, pcsPtr, (uint8_t)plane,
+        0, pcsPtr->parent_pcs_ptr->sequence_control_set_ptr->luma_height);
 
     best_err = try_filter_frame(sd, tempLfReconBuffer, pcsPtr, filt_mid, partial_frame, plane, dir);
     filt_best = filt_mid;
@@ -1943,7 +2404,7 @@ static int32_t search_filter_level(
 }
 
 void av1_pick_filter_level(
-    EncDecContext_t         *context_ptr,
+    EbPictureBufferDesc_t   *tempLfReconBuffer, // scratch reconstruction of the calling thread
     EbPictureBufferDesc_t   *srcBuffer, // source input
     PictureControlSet_t     *pcsPtr,
     LPF_PICK_METHOD          method) {
@@ -2001,8 +2462,6 @@ void av1_pick_filter_level(
             lf->filter_level[1],
             lf->filter_level_u,
             lf->filter_level_v };
-        EbPictureBufferDesc_t  *tempLfReconBuffer = (scsPtr->static_config.encoder_bit_depth != EB_8BIT) ? context_ptr->temp_lf_recon_picture16bit_ptr : context_ptr->temp_lf_recon_picture_ptr;
-
         lf->filter_level[0] = lf->filter_level[1] =
             search_filter_level(srcBuffer, tempLfReconBuffer, pcsPtr, method == LPF_PICK_FROM_SUBIMAGE,
                 last_frame_filter_level, NULL, 0, 2);
@@ -52,6 +52,9 @@ extern "C" {
 
 #define ENCODER_MODE_CLEANUP                1                                          
 #define IVF_FRAME_HEADER_IN_LIB                     0
+#ifndef LOCK_FREE_FIFO
+#define LOCK_FREE_FIFO                              1 // Lock-free rings behind the system resource queues, 0: mutex protected muxing queues
+#endif
 
 #define ENABLE_INTRA_4x4                            1 //
 #define DISABLE_NSQ                                 1 //
@@ -1807,6 +1810,7 @@ eb_memcpy_mode;
 #define CMPLX_NOISE              4
 #define EB_NORMAL_LATENCY        0
 #define EB_LOW_LATENCY           1
+#define EB_SB_ROW_LATENCY        2
 
 typedef enum EB_BITFIELD_MASKS {
     BITMASK_0 = 1,
@@ -2119,6 +2123,7 @@ static const uint8_t QP_OFFSET_WEIGHT[3][4] = { // [Slice Type][QP Offset Weight
 typedef enum EbAsm {
     ASM_NON_AVX2,
     ASM_AVX2,
+    ASM_AVX512,
     ASM_TYPE_TOTAL,
     ASM_TYPE_INVALID = ~0
 } EbAsm;
@@ -2146,6 +2151,13 @@ objectPtr is a EbPtr to the object being constructed.
 typedef void(*EB_DTOR)(
     EbPtr objectPtr);
 
+/** The EB_RELEASE type is used to define the hooks called on an object
+released back to the empty queue of its SystemResource.
+objectPtr is a EbPtr to the object being released.
+*/
+typedef void(*EB_RELEASE)(
+    EbPtr objectPtr);
+
 #define INVALID_MV            0xFFFFFFFF
 #define BLKSIZE 64
 
@@ -2193,13 +2205,15 @@ typedef enum EbPtrType {
     EB_A_PTR = 1,                                   // malloc'd pointer aligned
     EB_MUTEX = 2,                                   // mutex
     EB_SEMAPHORE = 3,                                   // semaphore
-    EB_THREAD = 4                                    // thread handle
+    EB_THREAD = 4,                                   // thread handle
+    EB_TASK = 5                                      // thread pool task handle
 } EbPtrType;
 
 typedef struct EbMemoryMapEntry
 {
     EbPtr                    ptr;                       // points to a memory pointer
     EbPtrType                ptrType;                   // pointer type
+    uint64_t                 size;                      // bytes of the allocation
 } EbMemoryMapEntry;
 
 // Rate Control
@@ -2213,23 +2227,50 @@ typedef struct EbMemoryMapEntry
 #define OIS_COMPLEX_MODE         3
 #define OIS_VERY_COMPLEX_MODE    4
 
-#define MAX_NUM_PTR                                 (0x1312D00 << 2) //0x4C4B4000            // Maximum number of pointers to be allocated for the library
 // Display Total Memory at the end of the memory allocations
 #define DISPLAY_MEMORY                                  0
 
+#define EB_MEMORY_MAP_BLOCK_SIZE                        1024 // Number of entries added each time a memory map grows
+
+/**************************************
+ * Memory Map
+ *   Registry of the pointers and OS objects allocated by one encoder instance.
+ *   The registry grows by blocks on demand and is released newest entry first.
+ **************************************/
+typedef struct EbMemoryMapBlock
+{
+    struct EbMemoryMapBlock *prev;                      // previously filled block
+    uint32_t                 count;
+    EbMemoryMapEntry         entries[EB_MEMORY_MAP_BLOCK_SIZE];
+} EbMemoryMapBlock;
+
+typedef struct EbMemoryContext
+{
+    EbMemoryMapBlock        *block;                     // most recent block of the registry
+    EbHandle                 mutex;                     // serializes the registrations done by the kernels
+    uint64_t                 total_lib_memory;          // library memory malloc'd
+    uint32_t                 malloc_count;
+    uint32_t                 thread_count;
+    uint32_t                 semaphore_count;
+    uint32_t                 mutex_count;
+} EbMemoryContext;
+
+extern EbErrorType eb_memory_context_ctor(
+    EbMemoryContext *context_ptr);
+extern EbErrorType eb_memory_context_release(
+    EbMemoryContext *context_ptr);
+extern void eb_set_memory_context(
+    EbMemoryContext *context_ptr);
+extern EbMemoryContext* eb_get_memory_context(void);
+extern EbErrorType eb_add_mem_entry(
+    EbPtr                    ptr,
+    EbPtrType                ptrType,
+    uint64_t                 size);
+
 extern    EbMemoryMapEntry        *appMemoryMap;            // App Memory table
 extern    uint32_t                  *appMemoryMapIndex;       // App Memory index
 extern    uint64_t                  *totalAppMemory;          // App Memory malloc'd
 
-extern    EbMemoryMapEntry        *memoryMap;               // library Memory table
-extern    uint32_t                  *memoryMapIndex;          // library memory index
-extern    uint64_t                  *totalLibMemory;          // library Memory malloc'd
-
-extern    uint32_t                   libMallocCount;
-extern    uint32_t                   libThreadCount;
-extern    uint32_t                   libSemaphoreCount;
-extern    uint32_t                   libMutexCount;
-
 extern    uint32_t                   appMallocCount;
 
 #define EB_APP_MALLOC(type, pointer, nElements, pointerClass, returnType) \
@@ -2284,42 +2325,20 @@ appMallocCount++;
 pointer = (type) _aligned_malloc(nElements,ALVALUE); \
 if (pointer == (type)EB_NULL) { \
     return EB_ErrorInsufficientResources; \
-    } \
-    else { \
-    memoryMap[*(memoryMapIndex)].ptrType = pointerClass; \
-    memoryMap[(*(memoryMapIndex))++].ptr = pointer; \
-    if (nElements % 8 == 0) { \
-        *totalLibMemory += (nElements); \
-    } \
-    else { \
-        *totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
-    } \
 } \
-if (*(memoryMapIndex) >= MAX_NUM_PTR) { \
+if (eb_add_mem_entry(pointer, pointerClass, nElements) != EB_ErrorNone) { \
     return EB_ErrorInsufficientResources; \
-} \
-libMallocCount++;
+}
 
 #else
 #define EB_ALLIGN_MALLOC(type, pointer, nElements, pointerClass) \
 if (posix_memalign((void**)(&(pointer)), ALVALUE, nElements) != 0) { \
     return EB_ErrorInsufficientResources; \
-        } \
-            else { \
-    pointer = (type) pointer;  \
-    memoryMap[*(memoryMapIndex)].ptrType = pointerClass; \
-    memoryMap[(*(memoryMapIndex))++].ptr = pointer; \
-    if (nElements % 8 == 0) { \
-        *totalLibMemory += (nElements); \
-            } \
-            else { \
-        *totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
-    } \
 } \
-if (*(memoryMapIndex) >= MAX_NUM_PTR) { \
+pointer = (type) pointer; \
+if (eb_add_mem_entry(pointer, pointerClass, nElements) != EB_ErrorNone) { \
     return EB_ErrorInsufficientResources; \
-    } \
-libMallocCount++;
+}
 #endif
 
 
@@ -2327,88 +2346,52 @@ libMallocCount++;
 pointer = (type) malloc(nElements); \
 if (pointer == (type)EB_NULL) { \
     return EB_ErrorInsufficientResources; \
-    } \
-    else { \
-    memoryMap[*(memoryMapIndex)].ptrType = pointerClass; \
-    memoryMap[(*(memoryMapIndex))++].ptr = pointer; \
-    if (nElements % 8 == 0) { \
-        *totalLibMemory += (nElements); \
-    } \
-    else { \
-        *totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
-    } \
 } \
-if (*(memoryMapIndex) >= MAX_NUM_PTR) { \
+if (eb_add_mem_entry(pointer, pointerClass, nElements) != EB_ErrorNone) { \
     return EB_ErrorInsufficientResources; \
-} \
-libMallocCount++;
+}
 
 #define EB_CALLOC(type, pointer, count, size, pointerClass) \
 pointer = (type) calloc(count, size); \
 if (pointer == (type)EB_NULL) { \
     return EB_ErrorInsufficientResources; \
 } \
-else { \
-    memoryMap[*(memoryMapIndex)].ptrType = pointerClass; \
-    memoryMap[(*(memoryMapIndex))++].ptr = pointer; \
-    if (count % 8 == 0) { \
-        *totalLibMemory += (count); \
-    } \
-    else { \
-        *totalLibMemory += ((count) + (8 - ((count) % 8))); \
-    } \
-} \
-if (*(memoryMapIndex) >= MAX_NUM_PTR) { \
+if (eb_add_mem_entry(pointer, pointerClass, (uint64_t)(count) * (size)) != EB_ErrorNone) { \
     return EB_ErrorInsufficientResources; \
-} \
-libMallocCount++;
+}
+
+// Alignment and padding keeping data written by different threads apart
+#define EB_CACHE_LINE_SIZE 64
+
+// The memory map keeps the unaligned block, which is the one released
+#define EB_CACHE_ALIGNED_MALLOC(type, pointer, nElements, pointerClass) \
+EB_MALLOC(type, pointer, (nElements) + EB_CACHE_LINE_SIZE - 1, pointerClass); \
+pointer = (type)(((size_t)(pointer) + EB_CACHE_LINE_SIZE - 1) & ~(size_t)(EB_CACHE_LINE_SIZE - 1));
 
 #define EB_CREATESEMAPHORE(type, pointer, nElements, pointerClass, initialCount, maxCount) \
 pointer = EbCreateSemaphore(initialCount, maxCount); \
 if (pointer == (type)EB_NULL) { \
     return EB_ErrorInsufficientResources; \
 } \
-else { \
-    memoryMap[*(memoryMapIndex)].ptrType = pointerClass; \
-    memoryMap[(*(memoryMapIndex))++].ptr = pointer; \
-    if (nElements % 8 == 0) { \
-        *totalLibMemory += (nElements); \
-    } \
-    else { \
-        *totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
-    } \
-} \
-if (*(memoryMapIndex) >= MAX_NUM_PTR) { \
+if (eb_add_mem_entry(pointer, pointerClass, nElements) != EB_ErrorNone) { \
     return EB_ErrorInsufficientResources; \
-} \
-libSemaphoreCount++;
+}
 
 #define EB_CREATEMUTEX(type, pointer, nElements, pointerClass) \
 pointer = EbCreateMutex(); \
 if (pointer == (type)EB_NULL){ \
     return EB_ErrorInsufficientResources; \
 } \
-else { \
-    memoryMap[*(memoryMapIndex)].ptrType = pointerClass; \
-    memoryMap[(*(memoryMapIndex))++].ptr = pointer; \
-    if (nElements % 8 == 0) { \
-        *totalLibMemory += (nElements); \
-    } \
-    else { \
-        *totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
-    } \
-} \
-if (*(memoryMapIndex) >= MAX_NUM_PTR) { \
+if (eb_add_mem_entry(pointer, pointerClass, nElements) != EB_ErrorNone) { \
     return EB_ErrorInsufficientResources; \
-} \
-libMutexCount++;
+}
 
 #define EB_MEMORY() \
-printf("Total Number of Mallocs in Library: %d\n", libMallocCount); \
-printf("Total Number of Threads in Library: %d\n", libThreadCount); \
-printf("Total Number of Semaphore in Library: %d\n", libSemaphoreCount); \
-printf("Total Number of Mutex in Library: %d\n", libMutexCount); \
-printf("Total Library Memory: %.2lf KB\n\n",*totalLibMemory/(double)1024);
+printf("Total Number of Mallocs in Library: %d\n", eb_get_memory_context()->malloc_count); \
+printf("Total Number of Threads in Library: %d\n", eb_get_memory_context()->thread_count); \
+printf("Total Number of Semaphore in Library: %d\n", eb_get_memory_context()->semaphore_count); \
+printf("Total Number of Mutex in Library: %d\n", eb_get_memory_context()->mutex_count); \
+printf("Total Library Memory: %.2lf KB\n\n", eb_get_memory_context()->total_lib_memory/(double)1024);
 
 
 #define EB_APP_MEMORY() \
@@ -2609,8 +2592,8 @@ void(*ErrorHandler)(
 #define TOTAL_LEVEL_COUNT                           13
 
 //***Encoding Parameters***
-#define MAX_PICTURE_WIDTH_SIZE                      4672u
-#define MAX_PICTURE_HEIGHT_SIZE                     2560u
+#define MAX_PICTURE_WIDTH_SIZE                      8192u // Largest supported source; buffers are sized from the actual one
+#define MAX_PICTURE_HEIGHT_SIZE                     4352u
 #define INTERNAL_BIT_DEPTH                          8 // to be modified
 #define MAX_SAMPLE_VALUE                            ((1 << INTERNAL_BIT_DEPTH) - 1)
 #define MAX_SAMPLE_VALUE_10BIT                      0x3FF
@@ -2635,10 +2618,6 @@ void(*ErrorHandler)(
 #define MIN_CU_BLK_COUNT                            ((BLOCK_SIZE_64 / MIN_BLOCK_SIZE) * (BLOCK_SIZE_64 / MIN_BLOCK_SIZE))
 #define MAX_NUM_OF_TU_PER_CU                        21
 #define MIN_NUM_OF_TU_PER_CU                        5
-#define MAX_LCU_ROWS                                ((MAX_PICTURE_HEIGHT_SIZE) / (BLOCK_SIZE_64))
-
-#define MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE       ((MAX_PICTURE_WIDTH_SIZE + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64) * \
-                                                ((MAX_PICTURE_HEIGHT_SIZE + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64)
 
 //***Prediction Structure***
 #define MAX_TEMPORAL_LAYERS                         6
@@ -3527,6 +3506,19 @@ static const uint8_t SearchAreaHeight[5][MAX_SUPPORTED_MODES] = {
 };
 #endif
 
+// Pipeline stages timed by the frame statistics, in pipeline order
+typedef enum LatencyStage {
+    LATENCY_STAGE_PICTURE_ANALYSIS,
+    LATENCY_STAGE_PICTURE_DECISION,
+    LATENCY_STAGE_MOTION_ESTIMATION,
+    LATENCY_STAGE_RATE_CONTROL,
+    LATENCY_STAGE_ENC_DEC,
+    LATENCY_STAGE_FILTER,
+    LATENCY_STAGE_ENTROPY_CODING,
+    LATENCY_STAGE_PACKETIZATION,
+    LATENCY_STAGE_COUNT
+} LatencyStage;
+
 #ifdef __cplusplus
 }
 #endif
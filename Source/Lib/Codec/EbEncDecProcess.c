@@ -17,43 +17,10 @@
 #include <stdlib.h>
 
 #include "EbEncDecTasks.h"
+#include "EbFilterTasks.h"
 #include "EbEncDecResults.h"
-#include "EbPictureDemuxResults.h"
 #include "EbCodingLoop.h"
 #include "EbErrorCodes.h"
-#include "EbDeblockingFilter.h"
-#include "grainSynthesis.h"
-
-void av1_cdef_search(
-    EncDecContext_t                *context_ptr,
-    SequenceControlSet_t           *sequence_control_set_ptr,
-    PictureControlSet_t            *picture_control_set_ptr
-);
-
-void av1_cdef_frame(
-    EncDecContext_t                *context_ptr,
-    SequenceControlSet_t           *sequence_control_set_ptr,
-    PictureControlSet_t            *pCs
-);
-
-void av1_cdef_search16bit(
-    EncDecContext_t                *context_ptr,
-    SequenceControlSet_t           *sequence_control_set_ptr,
-    PictureControlSet_t            *picture_control_set_ptr
-);
-void av1_cdef_frame16bit(
-    EncDecContext_t                *context_ptr,
-    SequenceControlSet_t           *sequence_control_set_ptr,
-    PictureControlSet_t            *pCs
-);
-
-void av1_add_film_grain(EbPictureBufferDesc_t *src,
-    EbPictureBufferDesc_t *dst,
-    aom_film_grain_t *film_grain_ptr);
-
-void av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame, Av1Common *cm, int32_t after_cdef);
-void av1_pick_filter_restoration(const Yv12BufferConfig *src, Yv12BufferConfig * trial_frame_rst /*AV1_COMP *cpi*/, Macroblock *x, Av1Common *const cm);
-void av1_loop_restoration_filter_frame(Yv12BufferConfig *frame, Av1Common *cm, int32_t optimized_lr);
 
 const int16_t encMinDeltaQpWeightTab[MAX_TEMPORAL_LAYERS] = { 100, 100, 100, 100, 100, 100 };
 const int16_t encMaxDeltaQpWeightTab[MAX_TEMPORAL_LAYERS] = { 100, 100, 100, 100, 100, 100 };
@@ -80,15 +47,13 @@ const int8_t  encMaxDeltaQpTab[4][MAX_TEMPORAL_LAYERS] = {
 EbErrorType enc_dec_context_ctor(
     EncDecContext_t        **context_dbl_ptr,
     EbFifo_t                *mode_decision_configuration_input_fifo_ptr,
-    EbFifo_t                *packetization_output_fifo_ptr,
+    EbFifo_t                *filter_output_fifo_ptr,
+    EbFifo_t                *entropy_coding_output_fifo_ptr,
     EbFifo_t                *feedback_fifo_ptr,
-    EbFifo_t                *picture_demux_fifo_ptr,
     EbBool                  is16bit,
     uint32_t                max_input_luma_width,
     uint32_t                max_input_luma_height){
 
-    (void)max_input_luma_width;
-    (void)max_input_luma_height;
     EbErrorType return_error = EB_ErrorNone;
     EncDecContext_t *context_ptr;
     EB_MALLOC(EncDecContext_t*, context_ptr, sizeof(EncDecContext_t), EB_N_PTR);
@@ -96,11 +61,14 @@ EbErrorType enc_dec_context_ctor(
 
     context_ptr->is16bit = is16bit;
 
+    // Intra coded area per SB
+    EB_MALLOC(uint8_t*, context_ptr->intra_coded_area_sb, sizeof(uint8_t) * ((max_input_luma_width + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64) * ((max_input_luma_height + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64), EB_N_PTR);
+
     // Input/Output System Resource Manager FIFOs
     context_ptr->mode_decision_input_fifo_ptr = mode_decision_configuration_input_fifo_ptr;
-    context_ptr->enc_dec_output_fifo_ptr = packetization_output_fifo_ptr;
+    context_ptr->enc_dec_output_fifo_ptr = filter_output_fifo_ptr;
+    context_ptr->entropy_coding_output_fifo_ptr = entropy_coding_output_fifo_ptr;
     context_ptr->enc_dec_feedback_fifo_ptr = feedback_fifo_ptr;
-    context_ptr->picture_demux_output_fifo_ptr = picture_demux_fifo_ptr;
 
     // Trasform Scratch Memory
     EB_MALLOC(int16_t*, context_ptr->transform_inner_array_ptr, 3152, EB_N_PTR); //refer to EbInvTransform_SSE2.as. case 32x32
@@ -217,62 +185,6 @@ EbErrorType enc_dec_context_ctor(
 
     context_ptr->md_context->enc_dec_context_ptr = context_ptr;
 
-    context_ptr->temp_lf_recon_picture16bit_ptr = (EbPictureBufferDesc_t *)EB_NULL;
-    context_ptr->temp_lf_recon_picture_ptr = (EbPictureBufferDesc_t *)EB_NULL;
-    EbPictureBufferDescInitData_t tempLfReconDescInitData;
-    tempLfReconDescInitData.maxWidth = (uint16_t)max_input_luma_width;
-    tempLfReconDescInitData.maxHeight = (uint16_t)max_input_luma_height;
-    tempLfReconDescInitData.bufferEnableMask = PICTURE_BUFFER_DESC_FULL_MASK;
-
-    tempLfReconDescInitData.left_padding = PAD_VALUE;
-    tempLfReconDescInitData.right_padding = PAD_VALUE;
-    tempLfReconDescInitData.top_padding = PAD_VALUE;
-    tempLfReconDescInitData.bot_padding = PAD_VALUE;
-
-    tempLfReconDescInitData.splitMode = EB_FALSE;
-
-    if (is16bit) {
-        tempLfReconDescInitData.bit_depth = EB_16BIT;
-        return_error = EbReconPictureBufferDescCtor(
-            (EbPtr*)&(context_ptr->temp_lf_recon_picture16bit_ptr),
-            (EbPtr)&tempLfReconDescInitData);
-    }
-    else {
-        tempLfReconDescInitData.bit_depth = EB_8BIT;
-        return_error = EbReconPictureBufferDescCtor(
-            (EbPtr*)&(context_ptr->temp_lf_recon_picture_ptr),
-            (EbPtr)&tempLfReconDescInitData);
-    }
-
-
-    {
-        EbPictureBufferDescInitData_t initData;
-
-        initData.bufferEnableMask = PICTURE_BUFFER_DESC_FULL_MASK;
-        initData.maxWidth = (uint16_t)max_input_luma_width;
-        initData.maxHeight = (uint16_t)max_input_luma_height;
-        initData.bit_depth = is16bit ? EB_16BIT : EB_8BIT;
-        initData.left_padding = AOM_BORDER_IN_PIXELS;
-        initData.right_padding = AOM_BORDER_IN_PIXELS;
-        initData.top_padding = AOM_BORDER_IN_PIXELS;
-        initData.bot_padding = AOM_BORDER_IN_PIXELS;
-        initData.splitMode = EB_FALSE;
-
-        return_error = EbPictureBufferDescCtor(
-            (EbPtr*)&context_ptr->trial_frame_rst,
-            (EbPtr)&initData);
-
-        if (return_error == EB_ErrorInsufficientResources) {
-            return EB_ErrorInsufficientResources;
-        }
-
-        //memset(context_ptr->trial_frame_rst->bufferY,  context_ptr->trial_frame_rst->lumaSize * 2, 0);
-        //memset(context_ptr->trial_frame_rst->bufferCb, context_ptr->trial_frame_rst->chromaSize * 2, 0);
-        //memset(context_ptr->trial_frame_rst->bufferCr, context_ptr->trial_frame_rst->chromaSize * 2, 0);
-
-    }
-
-
     return EB_ErrorNone;
 }
 
@@ -307,8 +219,6 @@ static void ResetEncDec(
     SequenceControlSet_t    *sequence_control_set_ptr,
     uint32_t                   segment_index)
 {
-    EB_SLICE                     slice_type;
-    MdRateEstimationContext_t   *md_rate_estimation_array;
     uint32_t                       entropyCodingQp;
 
     context_ptr->is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
@@ -341,23 +251,6 @@ static void ResetEncDec(
         (uint8_t)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr->bit_depth,
         context_ptr->qp_index);
 
-    // Slice Type
-    slice_type =
-        (picture_control_set_ptr->parent_pcs_ptr->idr_flag == EB_TRUE) ? I_SLICE :
-        picture_control_set_ptr->slice_type;
-
-    // Increment the MD Rate Estimation array pointer to point to the right address based on the QP and slice type
-    md_rate_estimation_array = (MdRateEstimationContext_t*)sequence_control_set_ptr->encode_context_ptr->md_rate_estimation_array;
-#if ADD_DELTA_QP_SUPPORT
-    md_rate_estimation_array += slice_type * TOTAL_NUMBER_OF_QP_VALUES + picture_control_set_ptr->parent_pcs_ptr->picture_qp;
-#else
-    md_rate_estimation_array += slice_type * TOTAL_NUMBER_OF_QP_VALUES + context_ptr->qp;
-#endif
-
-    // Reset MD rate Estimation table to initial values by copying from md_rate_estimation_array
-
-    context_ptr->md_rate_estimation_ptr = md_rate_estimation_array;
-
     // TMVP Map Writer Pointer
     if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
         context_ptr->reference_object_write_ptr = (EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr;
@@ -378,24 +271,25 @@ static void ResetEncDec(
         ResetEncodePassNeighborArrays(picture_control_set_ptr);
 
 
-        // Initial Rate Estimatimation of the syntax elements
-        if (!md_rate_estimation_array->initialized)
-            av1_estimate_syntax_rate(
-                md_rate_estimation_array,
+        // Initial Rate Estimatimation of the syntax elements, the motion vectors and the quantized
+        // coefficients. The tables are estimated once per set of inputs, and read by the pictures after.
+        // The other segments of the picture start once the first one is done
+        EbBlockOnMutex(sequence_control_set_ptr->encode_context_ptr->md_rate_estimation_mutex);
+        if (av1_update_md_rate_estimation(
+                sequence_control_set_ptr->encode_context_ptr->md_rate_estimation_cache,
                 picture_control_set_ptr->slice_type == I_SLICE ? EB_TRUE : EB_FALSE,
-                picture_control_set_ptr->coeff_est_entropy_coder_ptr->fc);
-
-        // Initial Rate Estimatimation of the Motion vectors
-        av1_estimate_mv_rate(
-            md_rate_estimation_array,
-            &picture_control_set_ptr->coeff_est_entropy_coder_ptr->fc->nmvc);
-
-        // Initial Rate Estimatimation of the quantized coefficients
-        av1_estimate_coefficients_rate(
-            md_rate_estimation_array,
-            picture_control_set_ptr->coeff_est_entropy_coder_ptr->fc);
+                entropyCodingQp,
+                MD_RATE_CDF_SOURCE_DEFAULT,
+                picture_control_set_ptr->coeff_est_entropy_coder_ptr->fc,
+                &picture_control_set_ptr->md_rate_estimation_ptr))
+            sequence_control_set_ptr->encode_context_ptr->md_rate_estimation_hit_count++;
+        else
+            sequence_control_set_ptr->encode_context_ptr->md_rate_estimation_miss_count++;
+        EbReleaseMutex(sequence_control_set_ptr->encode_context_ptr->md_rate_estimation_mutex);
     }
 
+    context_ptr->md_rate_estimation_ptr = picture_control_set_ptr->md_rate_estimation_ptr;
+
 
     return;
 }
@@ -617,641 +511,6 @@ EbBool AssignEncDecSegments(
 
     return continueProcessingFlag;
 }
-static void ReconOutput(
-    PictureControlSet_t    *picture_control_set_ptr,
-    SequenceControlSet_t   *sequence_control_set_ptr) {
-
-    EbObjectWrapper_t             *outputReconWrapperPtr;
-    EbBufferHeaderType           *outputReconPtr;
-    EncodeContext_t               *encode_context_ptr = sequence_control_set_ptr->encode_context_ptr;
-    EbBool is16bit = (sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
-    // The totalNumberOfReconFrames counter has to be write/read protected as
-    //   it is used to determine the end of the stream.  If it is not protected
-    //   the encoder might not properly terminate.
-    EbBlockOnMutex(encode_context_ptr->total_number_of_recon_frame_mutex);
-
-    // Get Recon Buffer
-    EbGetEmptyObject(
-        sequence_control_set_ptr->encode_context_ptr->recon_output_fifo_ptr,
-        &outputReconWrapperPtr);
-    outputReconPtr = (EbBufferHeaderType*)outputReconWrapperPtr->objectPtr;
-    outputReconPtr->flags = 0;
-
-    // START READ/WRITE PROTECTED SECTION
-    if (encode_context_ptr->total_number_of_recon_frames == encode_context_ptr->terminating_picture_number)
-        outputReconPtr->flags = EB_BUFFERFLAG_EOS;
-
-    encode_context_ptr->total_number_of_recon_frames++;
-
-    //EbReleaseMutex(encode_context_ptr->terminating_conditions_mutex);
-
-    // STOP READ/WRITE PROTECTED SECTION
-    outputReconPtr->n_filled_len = 0;
-
-    // Copy the Reconstructed Picture to the Output Recon Buffer
-    {
-        uint32_t sampleTotalCount;
-        uint8_t *reconReadPtr;
-        uint8_t *reconWritePtr;
-
-        EbPictureBufferDesc_t *reconPtr;
-        {
-            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                reconPtr = is16bit ?
-                ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->referencePicture16bit :
-                ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->referencePicture;
-            else {
-                if (is16bit)
-                    reconPtr = picture_control_set_ptr->recon_picture16bit_ptr;
-                else
-                    reconPtr = picture_control_set_ptr->recon_picture_ptr;
-            }
-        }
-
-        // FGN: Create a buffer if needed, copy the reconstructed picture and run the film grain synthesis algorithm
-
-        if (sequence_control_set_ptr->film_grain_params_present) {
-            EbPictureBufferDesc_t  *intermediateBufferPtr;
-            {
-                if (is16bit)
-                    intermediateBufferPtr = picture_control_set_ptr->film_grain_picture16bit_ptr;
-                else
-                    intermediateBufferPtr = picture_control_set_ptr->film_grain_picture_ptr;
-            }
-
-            aom_film_grain_t *film_grain_ptr;
-
-            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                film_grain_ptr = &((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->film_grain_params;
-            else
-                film_grain_ptr = &picture_control_set_ptr->parent_pcs_ptr->film_grain_params;
-
-            av1_add_film_grain(reconPtr, intermediateBufferPtr, film_grain_ptr);
-            reconPtr = intermediateBufferPtr;
-        }
-
-        // End running the film grain
-        // Y Recon Samples
-        sampleTotalCount = ((reconPtr->maxWidth - sequence_control_set_ptr->max_input_pad_right) * (reconPtr->maxHeight - sequence_control_set_ptr->max_input_pad_bottom)) << is16bit;
-        reconReadPtr = reconPtr->bufferY + (reconPtr->origin_y << is16bit) * reconPtr->strideY + (reconPtr->origin_x << is16bit);
-        reconWritePtr = &(outputReconPtr->p_buffer[outputReconPtr->n_filled_len]);
-
-        CHECK_REPORT_ERROR(
-            (outputReconPtr->n_filled_len + sampleTotalCount <= outputReconPtr->n_alloc_len),
-            encode_context_ptr->app_callback_ptr,
-            EB_ENC_ROB_OF_ERROR);
-
-        // Initialize Y recon buffer
-        PictureCopyKernel(
-            reconReadPtr,
-            reconPtr->strideY,
-            reconWritePtr,
-            reconPtr->maxWidth - sequence_control_set_ptr->max_input_pad_right,
-            reconPtr->width - sequence_control_set_ptr->pad_right,
-            reconPtr->height - sequence_control_set_ptr->pad_bottom,
-            1 << is16bit);
-
-        outputReconPtr->n_filled_len += sampleTotalCount;
-
-        // U Recon Samples
-        sampleTotalCount = ((reconPtr->maxWidth - sequence_control_set_ptr->max_input_pad_right) * (reconPtr->maxHeight - sequence_control_set_ptr->max_input_pad_bottom) >> 2) << is16bit;
-        reconReadPtr = reconPtr->bufferCb + ((reconPtr->origin_y << is16bit) >> 1) * reconPtr->strideCb + ((reconPtr->origin_x << is16bit) >> 1);
-        reconWritePtr = &(outputReconPtr->p_buffer[outputReconPtr->n_filled_len]);
-
-        CHECK_REPORT_ERROR(
-            (outputReconPtr->n_filled_len + sampleTotalCount <= outputReconPtr->n_alloc_len),
-            encode_context_ptr->app_callback_ptr,
-            EB_ENC_ROB_OF_ERROR);
-
-        // Initialize U recon buffer
-        PictureCopyKernel(
-            reconReadPtr,
-            reconPtr->strideCb,
-            reconWritePtr,
-            (reconPtr->maxWidth - sequence_control_set_ptr->max_input_pad_right) >> 1,
-            (reconPtr->width - sequence_control_set_ptr->pad_right) >> 1,
-            (reconPtr->height - sequence_control_set_ptr->pad_bottom) >> 1,
-            1 << is16bit);
-        outputReconPtr->n_filled_len += sampleTotalCount;
-
-        // V Recon Samples
-        sampleTotalCount = ((reconPtr->maxWidth - sequence_control_set_ptr->max_input_pad_right) * (reconPtr->maxHeight - sequence_control_set_ptr->max_input_pad_bottom) >> 2) << is16bit;
-        reconReadPtr = reconPtr->bufferCr + ((reconPtr->origin_y << is16bit) >> 1) * reconPtr->strideCr + ((reconPtr->origin_x << is16bit) >> 1);
-        reconWritePtr = &(outputReconPtr->p_buffer[outputReconPtr->n_filled_len]);
-
-        CHECK_REPORT_ERROR(
-            (outputReconPtr->n_filled_len + sampleTotalCount <= outputReconPtr->n_alloc_len),
-            encode_context_ptr->app_callback_ptr,
-            EB_ENC_ROB_OF_ERROR);
-
-        // Initialize V recon buffer
-
-        PictureCopyKernel(
-            reconReadPtr,
-            reconPtr->strideCr,
-            reconWritePtr,
-            (reconPtr->maxWidth - sequence_control_set_ptr->max_input_pad_right) >> 1,
-            (reconPtr->width - sequence_control_set_ptr->pad_right) >> 1,
-            (reconPtr->height - sequence_control_set_ptr->pad_bottom) >> 1,
-            1 << is16bit);
-        outputReconPtr->n_filled_len += sampleTotalCount;
-        outputReconPtr->pts = picture_control_set_ptr->picture_number;
-    }
-
-    // Post the Recon object
-    EbPostFullObject(outputReconWrapperPtr);
-    EbReleaseMutex(encode_context_ptr->total_number_of_recon_frame_mutex);
-}
-
-void PsnrCalculations(
-    PictureControlSet_t    *picture_control_set_ptr,
-    SequenceControlSet_t   *sequence_control_set_ptr){
-
-    EbBool is16bit = (sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
-
-    if (!is16bit) {
-
-        EbPictureBufferDesc_t *reconPtr;
-
-        if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-            reconPtr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->referencePicture;
-        else
-            reconPtr = picture_control_set_ptr->recon_picture_ptr;
-
-        EbPictureBufferDesc_t *inputPicturePtr = (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
-
-        uint64_t sseTotal[3] = { 0 };
-        uint32_t   columnIndex;
-        uint32_t   rowIndex = 0;
-        uint64_t   residualDistortion = 0;
-        EbByte  inputBuffer;
-        EbByte  reconCoeffBuffer;
-
-        reconCoeffBuffer = &((reconPtr->bufferY)[reconPtr->origin_x + reconPtr->origin_y * reconPtr->strideY]);
-        inputBuffer = &((inputPicturePtr->bufferY)[inputPicturePtr->origin_x + inputPicturePtr->origin_y * inputPicturePtr->strideY]);
-
-        residualDistortion = 0;
-
-        while (rowIndex < sequence_control_set_ptr->luma_height) {
-
-            columnIndex = 0;
-            while (columnIndex < sequence_control_set_ptr->luma_width) {
-                residualDistortion += (int64_t)SQR((int64_t)(inputBuffer[columnIndex]) - (reconCoeffBuffer[columnIndex]));
-                ++columnIndex;
-            }
-
-            inputBuffer += inputPicturePtr->strideY;
-            reconCoeffBuffer += reconPtr->strideY;
-            ++rowIndex;
-        }
-
-        sseTotal[0] = residualDistortion;
-
-        reconCoeffBuffer = &((reconPtr->bufferCb)[reconPtr->origin_x / 2 + reconPtr->origin_y / 2 * reconPtr->strideCb]);
-        inputBuffer = &((inputPicturePtr->bufferCb)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCb]);
-
-        residualDistortion = 0;
-        rowIndex = 0;
-        while (rowIndex < sequence_control_set_ptr->chroma_height) {
-
-            columnIndex = 0;
-            while (columnIndex < sequence_control_set_ptr->chroma_width) {
-                residualDistortion += (int64_t)SQR((int64_t)(inputBuffer[columnIndex]) - (reconCoeffBuffer[columnIndex]));
-                ++columnIndex;
-            }
-
-            inputBuffer += inputPicturePtr->strideCb;
-            reconCoeffBuffer += reconPtr->strideCb;
-            ++rowIndex;
-        }
-
-        sseTotal[1] = residualDistortion;
-
-        reconCoeffBuffer = &((reconPtr->bufferCr)[reconPtr->origin_x / 2 + reconPtr->origin_y / 2 * reconPtr->strideCr]);
-        inputBuffer = &((inputPicturePtr->bufferCr)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCr]);
-        residualDistortion = 0;
-        rowIndex = 0;
-
-        while (rowIndex < sequence_control_set_ptr->chroma_height) {
-
-            columnIndex = 0;
-            while (columnIndex < sequence_control_set_ptr->chroma_width) {
-                residualDistortion += (int64_t)SQR((int64_t)(inputBuffer[columnIndex]) - (reconCoeffBuffer[columnIndex]));
-                ++columnIndex;
-            }
-
-            inputBuffer += inputPicturePtr->strideCr;
-            reconCoeffBuffer += reconPtr->strideCr;
-            ++rowIndex;
-        }
-
-        sseTotal[2] = residualDistortion;
-        picture_control_set_ptr->parent_pcs_ptr->luma_sse = (uint32_t)sseTotal[0];
-        picture_control_set_ptr->parent_pcs_ptr->cr_sse = (uint32_t)sseTotal[1];
-        picture_control_set_ptr->parent_pcs_ptr->cb_sse = (uint32_t)sseTotal[2];
-    }
-    else {
-
-        EbPictureBufferDesc_t *reconPtr;
-
-        if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-            reconPtr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->referencePicture16bit;
-        else
-            reconPtr = picture_control_set_ptr->recon_picture16bit_ptr;
-        EbPictureBufferDesc_t *inputPicturePtr = (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
-
-        uint64_t sseTotal[3] = { 0 };
-        uint32_t   columnIndex;
-        uint32_t   rowIndex = 0;
-        uint64_t   residualDistortion = 0;
-        EbByte  inputBuffer;
-        EbByte  inputBufferBitInc;
-        uint16_t*  reconCoeffBuffer;
-
-        if (sequence_control_set_ptr->static_config.ten_bit_format == 1) {
-
-            const uint32_t luma_width = sequence_control_set_ptr->luma_width;
-            const uint32_t luma_height = sequence_control_set_ptr->luma_height;
-            const uint32_t chroma_width = sequence_control_set_ptr->chroma_width;
-            const uint32_t picture_width_in_sb = (luma_width + 64 - 1) / 64;
-            const uint32_t pictureHeighInLcu = (luma_height + 64 - 1) / 64;
-            const uint32_t luma2BitWidth = luma_width / 4;
-            const uint32_t chroma_height = luma_height / 2;
-            const uint32_t chroma2BitWidth = luma_width / 8;
-            uint32_t lcuNumberInHeight, lcuNumberInWidth;
-
-            EbByte  inputBufferOrg = &((inputPicturePtr->bufferY)[inputPicturePtr->origin_x + inputPicturePtr->origin_y * inputPicturePtr->strideY]);
-            uint16_t*  reconBufferOrg = (uint16_t*)(&((reconPtr->bufferY)[(reconPtr->origin_x << is16bit) + (reconPtr->origin_y << is16bit) * reconPtr->strideY]));;
-
-            EbByte  inputBufferOrgU = &((inputPicturePtr->bufferCb)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCb]);;
-            uint16_t*  reconBufferOrgU = reconCoeffBuffer = (uint16_t*)(&((reconPtr->bufferCb)[(reconPtr->origin_x << is16bit) / 2 + (reconPtr->origin_y << is16bit) / 2 * reconPtr->strideCb]));;
-
-            EbByte  inputBufferOrgV = &((inputPicturePtr->bufferCr)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCr]);;
-            uint16_t*  reconBufferOrgV = reconCoeffBuffer = (uint16_t*)(&((reconPtr->bufferCr)[(reconPtr->origin_x << is16bit) / 2 + (reconPtr->origin_y << is16bit) / 2 * reconPtr->strideCr]));;
-
-            residualDistortion = 0;
-            uint64_t residualDistortionU = 0;
-            uint64_t residualDistortionV = 0;
-
-            for (lcuNumberInHeight = 0; lcuNumberInHeight < pictureHeighInLcu; ++lcuNumberInHeight)
-            {
-                for (lcuNumberInWidth = 0; lcuNumberInWidth < picture_width_in_sb; ++lcuNumberInWidth)
-                {
-
-                    uint32_t tbOriginX = lcuNumberInWidth * 64;
-                    uint32_t tbOriginY = lcuNumberInHeight * 64;
-                    uint32_t sb_width = (luma_width - tbOriginX) < 64 ? (luma_width - tbOriginX) : 64;
-                    uint32_t sb_height = (luma_height - tbOriginY) < 64 ? (luma_height - tbOriginY) : 64;
-
-                    inputBuffer = inputBufferOrg + tbOriginY * inputPicturePtr->strideY + tbOriginX;
-                    inputBufferBitInc = inputPicturePtr->bufferBitIncY + tbOriginY * luma2BitWidth + (tbOriginX / 4)*sb_height;
-                    reconCoeffBuffer = reconBufferOrg + tbOriginY * reconPtr->strideY + tbOriginX;
-
-                    uint64_t   j, k;
-                    uint16_t   outPixel;
-                    uint8_t    nBitPixel;
-                    uint8_t   four2bitPels;
-                    uint32_t     innStride = sb_width / 4;
-
-                    for (j = 0; j < sb_height; j++)
-                    {
-                        for (k = 0; k < sb_width / 4; k++)
-                        {
-
-                            four2bitPels = inputBufferBitInc[k + j * innStride];
-
-                            nBitPixel = (four2bitPels >> 6) & 3;
-                            outPixel = inputBuffer[k * 4 + 0 + j * inputPicturePtr->strideY] << 2;
-                            outPixel = outPixel | nBitPixel;
-                            residualDistortion += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 0 + j * reconPtr->strideY]);
-
-
-                            nBitPixel = (four2bitPels >> 4) & 3;
-                            outPixel = inputBuffer[k * 4 + 1 + j * inputPicturePtr->strideY] << 2;
-                            outPixel = outPixel | nBitPixel;
-                            residualDistortion += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 1 + j * reconPtr->strideY]);
-
-
-                            nBitPixel = (four2bitPels >> 2) & 3;
-                            outPixel = inputBuffer[k * 4 + 2 + j * inputPicturePtr->strideY] << 2;
-                            outPixel = outPixel | nBitPixel;
-                            residualDistortion += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 2 + j * reconPtr->strideY]);
-
-                            nBitPixel = (four2bitPels >> 0) & 3;
-                            outPixel = inputBuffer[k * 4 + 3 + j * inputPicturePtr->strideY] << 2;
-                            outPixel = outPixel | nBitPixel;
-                            residualDistortion += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 3 + j * reconPtr->strideY]);
-
-                        }
-                    }
-
-                    //U+V
-
-                    tbOriginX = lcuNumberInWidth * 32;
-                    tbOriginY = lcuNumberInHeight * 32;
-                    sb_width = (chroma_width - tbOriginX) < 32 ? (chroma_width - tbOriginX) : 32;
-                    sb_height = (chroma_height - tbOriginY) < 32 ? (chroma_height - tbOriginY) : 32;
-
-                    innStride = sb_width / 4;
-
-                    inputBuffer = inputBufferOrgU + tbOriginY * inputPicturePtr->strideCb + tbOriginX;
-
-                    inputBufferBitInc = inputPicturePtr->bufferBitIncCb + tbOriginY * chroma2BitWidth + (tbOriginX / 4)*sb_height;
-
-                    reconCoeffBuffer = reconBufferOrgU + tbOriginY * reconPtr->strideCb + tbOriginX;
-
-
-
-                    for (j = 0; j < sb_height; j++)
-                    {
-                        for (k = 0; k < sb_width / 4; k++)
-                        {
-
-                            four2bitPels = inputBufferBitInc[k + j * innStride];
-
-                            nBitPixel = (four2bitPels >> 6) & 3;
-                            outPixel = inputBuffer[k * 4 + 0 + j * inputPicturePtr->strideCb] << 2;
-                            outPixel = outPixel | nBitPixel;
-                            residualDistortionU += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 0 + j * reconPtr->strideCb]);
-
-
-                            nBitPixel = (four2bitPels >> 4) & 3;
-                            outPixel = inputBuffer[k * 4 + 1 + j * inputPicturePtr->strideCb] << 2;
-                            outPixel = outPixel | nBitPixel;
-                            residualDistortionU += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 1 + j * reconPtr->strideCb]);
-
-
-                            nBitPixel = (four2bitPels >> 2) & 3;
-                            outPixel = inputBuffer[k * 4 + 2 + j * inputPicturePtr->strideCb] << 2;
-                            outPixel = outPixel | nBitPixel;
-                            residualDistortionU += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 2 + j * reconPtr->strideCb]);
-
-                            nBitPixel = (four2bitPels >> 0) & 3;
-                            outPixel = inputBuffer[k * 4 + 3 + j * inputPicturePtr->strideCb] << 2;
-                            outPixel = outPixel | nBitPixel;
-                            residualDistortionU += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 3 + j * reconPtr->strideCb]);
-
-                        }
-                    }
-
-
-                    inputBuffer = inputBufferOrgV + tbOriginY * inputPicturePtr->strideCr + tbOriginX;
-                    inputBufferBitInc = inputPicturePtr->bufferBitIncCr + tbOriginY * chroma2BitWidth + (tbOriginX / 4)*sb_height;
-                    reconCoeffBuffer = reconBufferOrgV + tbOriginY * reconPtr->strideCr + tbOriginX;
-
-
-                    for (j = 0; j < sb_height; j++)
-                    {
-                        for (k = 0; k < sb_width / 4; k++)
-                        {
-
-                            four2bitPels = inputBufferBitInc[k + j * innStride];
-
-                            nBitPixel = (four2bitPels >> 6) & 3;
-                            outPixel = inputBuffer[k * 4 + 0 + j * inputPicturePtr->strideCr] << 2;
-                            outPixel = outPixel | nBitPixel;
-                            residualDistortionV += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 0 + j * reconPtr->strideCr]);
-
-
-                            nBitPixel = (four2bitPels >> 4) & 3;
-                            outPixel = inputBuffer[k * 4 + 1 + j * inputPicturePtr->strideCr] << 2;
-                            outPixel = outPixel | nBitPixel;
-                            residualDistortionV += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 1 + j * reconPtr->strideCr]);
-
-
-                            nBitPixel = (four2bitPels >> 2) & 3;
-                            outPixel = inputBuffer[k * 4 + 2 + j * inputPicturePtr->strideCr] << 2;
-                            outPixel = outPixel | nBitPixel;
-                            residualDistortionV += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 2 + j * reconPtr->strideCr]);
-
-                            nBitPixel = (four2bitPels >> 0) & 3;
-                            outPixel = inputBuffer[k * 4 + 3 + j * inputPicturePtr->strideCr] << 2;
-                            outPixel = outPixel | nBitPixel;
-                            residualDistortionV += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 3 + j * reconPtr->strideCr]);
-
-                        }
-                    }
-
-
-
-
-                }
-            }
-
-
-            sseTotal[0] = residualDistortion;
-            sseTotal[1] = residualDistortionU;
-            sseTotal[2] = residualDistortionV;
-        }
-        else {
-
-
-            reconCoeffBuffer = (uint16_t*)(&((reconPtr->bufferY)[(reconPtr->origin_x << is16bit) + (reconPtr->origin_y << is16bit) * reconPtr->strideY]));
-            inputBuffer = &((inputPicturePtr->bufferY)[inputPicturePtr->origin_x + inputPicturePtr->origin_y * inputPicturePtr->strideY]);
-            inputBufferBitInc = &((inputPicturePtr->bufferBitIncY)[inputPicturePtr->origin_x + inputPicturePtr->origin_y * inputPicturePtr->strideBitIncY]);
-
-            residualDistortion = 0;
-
-            while (rowIndex < sequence_control_set_ptr->luma_height) {
-
-                columnIndex = 0;
-                while (columnIndex < sequence_control_set_ptr->luma_width) {
-                    residualDistortion += (int64_t)SQR((int64_t)((((inputBuffer[columnIndex]) << 2) | ((inputBufferBitInc[columnIndex] >> 6) & 3))) - (reconCoeffBuffer[columnIndex]));
-
-                    ++columnIndex;
-                }
-
-                inputBuffer += inputPicturePtr->strideY;
-                inputBufferBitInc += inputPicturePtr->strideBitIncY;
-                reconCoeffBuffer += reconPtr->strideY;
-                ++rowIndex;
-            }
-
-            sseTotal[0] = residualDistortion;
-
-            reconCoeffBuffer = (uint16_t*)(&((reconPtr->bufferCb)[(reconPtr->origin_x << is16bit) / 2 + (reconPtr->origin_y << is16bit) / 2 * reconPtr->strideCb]));
-            inputBuffer = &((inputPicturePtr->bufferCb)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCb]);
-            inputBufferBitInc = &((inputPicturePtr->bufferBitIncCb)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideBitIncCb]);
-
-            residualDistortion = 0;
-            rowIndex = 0;
-            while (rowIndex < sequence_control_set_ptr->chroma_height) {
-
-                columnIndex = 0;
-                while (columnIndex < sequence_control_set_ptr->chroma_width) {
-                    residualDistortion += (int64_t)SQR((int64_t)((((inputBuffer[columnIndex]) << 2) | ((inputBufferBitInc[columnIndex] >> 6) & 3))) - (reconCoeffBuffer[columnIndex]));
-                    ++columnIndex;
-                }
-
-                inputBuffer += inputPicturePtr->strideCb;
-                inputBufferBitInc += inputPicturePtr->strideBitIncCb;
-                reconCoeffBuffer += reconPtr->strideCb;
-                ++rowIndex;
-            }
-
-            sseTotal[1] = residualDistortion;
-
-            reconCoeffBuffer = (uint16_t*)(&((reconPtr->bufferCr)[(reconPtr->origin_x << is16bit) / 2 + (reconPtr->origin_y << is16bit) / 2 * reconPtr->strideCr]));
-            inputBuffer = &((inputPicturePtr->bufferCr)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCr]);
-            inputBufferBitInc = &((inputPicturePtr->bufferBitIncCr)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideBitIncCr]);
-
-            residualDistortion = 0;
-            rowIndex = 0;
-
-            while (rowIndex < sequence_control_set_ptr->chroma_height) {
-
-                columnIndex = 0;
-                while (columnIndex < sequence_control_set_ptr->chroma_width) {
-                    residualDistortion += (int64_t)SQR((int64_t)((((inputBuffer[columnIndex]) << 2) | ((inputBufferBitInc[columnIndex] >> 6) & 3))) - (reconCoeffBuffer[columnIndex]));
-                    ++columnIndex;
-                }
-
-                inputBuffer += inputPicturePtr->strideCr;
-                inputBufferBitInc += inputPicturePtr->strideBitIncCr;
-                reconCoeffBuffer += reconPtr->strideCr;
-                ++rowIndex;
-            }
-
-            sseTotal[2] = residualDistortion;
-
-        }
-
-
-        picture_control_set_ptr->parent_pcs_ptr->luma_sse = (uint32_t)sseTotal[0];
-        picture_control_set_ptr->parent_pcs_ptr->cr_sse = (uint32_t)sseTotal[1];
-        picture_control_set_ptr->parent_pcs_ptr->cb_sse = (uint32_t)sseTotal[2];
-    }
-}
-
-void PadRefAndSetFlags(
-    PictureControlSet_t    *picture_control_set_ptr,
-    SequenceControlSet_t   *sequence_control_set_ptr
-)
-{
-
-    EbReferenceObject_t   *referenceObject = (EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr;
-    EbPictureBufferDesc_t *refPicPtr = (EbPictureBufferDesc_t*)referenceObject->referencePicture;
-    EbPictureBufferDesc_t *refPic16BitPtr = (EbPictureBufferDesc_t*)referenceObject->referencePicture16bit;
-    EbBool                is16bit = (sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
-
-    if (!is16bit) {
-        // Y samples
-        generate_padding(
-            refPicPtr->bufferY,
-            refPicPtr->strideY,
-            refPicPtr->width,
-            refPicPtr->height,
-            refPicPtr->origin_x,
-            refPicPtr->origin_y);
-
-        // Cb samples
-        generate_padding(
-            refPicPtr->bufferCb,
-            refPicPtr->strideCb,
-            refPicPtr->width >> 1,
-            refPicPtr->height >> 1,
-            refPicPtr->origin_x >> 1,
-            refPicPtr->origin_y >> 1);
-
-        // Cr samples
-        generate_padding(
-            refPicPtr->bufferCr,
-            refPicPtr->strideCr,
-            refPicPtr->width >> 1,
-            refPicPtr->height >> 1,
-            refPicPtr->origin_x >> 1,
-            refPicPtr->origin_y >> 1);
-    }
-
-    //We need this for MCP
-    if (is16bit) {
-        // Y samples
-        generate_padding16_bit(
-            refPic16BitPtr->bufferY,
-            refPic16BitPtr->strideY << 1,
-            refPic16BitPtr->width << 1,
-            refPic16BitPtr->height,
-            refPic16BitPtr->origin_x << 1,
-            refPic16BitPtr->origin_y);
-
-        // Cb samples
-        generate_padding16_bit(
-            refPic16BitPtr->bufferCb,
-            refPic16BitPtr->strideCb << 1,
-            refPic16BitPtr->width,
-            refPic16BitPtr->height >> 1,
-            refPic16BitPtr->origin_x,
-            refPic16BitPtr->origin_y >> 1);
-
-        // Cr samples
-        generate_padding16_bit(
-            refPic16BitPtr->bufferCr,
-            refPic16BitPtr->strideCr << 1,
-            refPic16BitPtr->width,
-            refPic16BitPtr->height >> 1,
-            refPic16BitPtr->origin_x,
-            refPic16BitPtr->origin_y >> 1);
-
-    }
-
-    // set up TMVP flag for the reference picture
-
-    referenceObject->tmvpEnableFlag = (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) ? EB_TRUE : EB_FALSE;
-
-    // set up the ref POC
-    referenceObject->refPOC = picture_control_set_ptr->parent_pcs_ptr->picture_number;
-
-    // set up the QP
-#if ADD_DELTA_QP_SUPPORT
-    uint16_t picture_qp = picture_control_set_ptr->parent_pcs_ptr->base_qindex;
-    referenceObject->qp = (uint16_t)picture_qp;
-#else
-    referenceObject->qp = (uint8_t)picture_control_set_ptr->parent_pcs_ptr->picture_qp;
-#endif
-
-    // set up the Slice Type
-    referenceObject->slice_type = picture_control_set_ptr->parent_pcs_ptr->slice_type;
-
-
-}
-
-void CopyStatisticsToRefObject(
-    PictureControlSet_t    *picture_control_set_ptr,
-    SequenceControlSet_t   *sequence_control_set_ptr
-)
-{
-    picture_control_set_ptr->intra_coded_area = (100 * picture_control_set_ptr->intra_coded_area) / (sequence_control_set_ptr->luma_width * sequence_control_set_ptr->luma_height);
-    if (picture_control_set_ptr->slice_type == I_SLICE)
-        picture_control_set_ptr->intra_coded_area = 0;
-
-    ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->intra_coded_area = (uint8_t)(picture_control_set_ptr->intra_coded_area);
-
-    uint32_t sb_index;
-    for (sb_index = 0; sb_index < picture_control_set_ptr->sb_total_count; ++sb_index) {
-        ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->non_moving_index_array[sb_index] = picture_control_set_ptr->parent_pcs_ptr->non_moving_index_array[sb_index];
-    }
-
-    EbReferenceObject_t  * refObjL0, *refObjL1;
-    ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->penalizeSkipflag = EB_FALSE;
-    if (picture_control_set_ptr->slice_type == B_SLICE) {
-        refObjL0 = (EbReferenceObject_t*)picture_control_set_ptr->ref_pic_ptr_array[REF_LIST_0]->objectPtr;
-        refObjL1 = (EbReferenceObject_t*)picture_control_set_ptr->ref_pic_ptr_array[REF_LIST_1]->objectPtr;
-
-        if (picture_control_set_ptr->temporal_layer_index == 0) {
-            if (picture_control_set_ptr->parent_pcs_ptr->intra_coded_block_probability > 30) {
-                ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->penalizeSkipflag = EB_TRUE;
-            }
-        }
-        else {
-            ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->penalizeSkipflag = (refObjL0->penalizeSkipflag || refObjL1->penalizeSkipflag) ? EB_TRUE : EB_FALSE;
-        }
-    }
-    ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->tmpLayerIdx = (uint8_t)picture_control_set_ptr->temporal_layer_index;
-    ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->isSceneChange = picture_control_set_ptr->parent_pcs_ptr->scene_change_flag;
-
-
-}
-
 
 EbErrorType QpmDeriveWeightsMinAndMax(
     PictureControlSet_t                    *picture_control_set_ptr,
@@ -1319,6 +578,41 @@ void move_cu_data(
     CodingUnit_t *src_cu,
     CodingUnit_t *dst_cu);
 
+/******************************************************
+ * EncDec Stream LCU
+ *   SB row latency mode: hands a coded SB over to the entropy
+ *   coder. The picture is sent to the entropy coder along
+ *   with its first SB, and the entropy coder codes each SB
+ *   row once the row semaphore was posted by all its SBs.
+ ******************************************************/
+static void EncDecStreamLcu(
+    EncDecContext_t         *context_ptr,
+    EbObjectWrapper_t       *pictureControlSetWrapperPtr,
+    uint16_t                 sb_index,
+    uint32_t                 yLcuIndex)
+{
+    PictureControlSet_t     *picture_control_set_ptr = (PictureControlSet_t*)pictureControlSetWrapperPtr->objectPtr;
+    EbObjectWrapper_t       *encDecResultsWrapperPtr;
+    EncDecResults_t         *encDecResultsPtr;
+
+    EbPostSemaphore(picture_control_set_ptr->entropy_coding_row_semaphore_array[yLcuIndex]);
+
+    if (sb_index == 0) {
+
+        // Get Empty EncDec Results
+        EbGetEmptyObject(
+            context_ptr->entropy_coding_output_fifo_ptr,
+            &encDecResultsWrapperPtr);
+        encDecResultsPtr = (EncDecResults_t*)encDecResultsWrapperPtr->objectPtr;
+        encDecResultsPtr->pictureControlSetWrapperPtr = pictureControlSetWrapperPtr;
+        encDecResultsPtr->tile_index = 0;
+        encDecResultsPtr->inputType = ENCDEC_RESULTS_TILE_INPUT;
+
+        // Post EncDec Results
+        EbPostFullObject(encDecResultsWrapperPtr);
+    }
+}
+
 /******************************************************
  * EncDec Kernel
  ******************************************************/
@@ -1334,10 +628,8 @@ void* EncDecKernel(void *input_ptr)
     EncDecTasks_t                           *encDecTasksPtr;
 
     // Output
-    EbObjectWrapper_t                       *encDecResultsWrapperPtr;
-    EncDecResults_t                         *encDecResultsPtr;
-    EbObjectWrapper_t                       *pictureDemuxResultsWrapperPtr;
-    PictureDemuxResults_t                   *pictureDemuxResultsPtr;
+    EbObjectWrapper_t                       *filterTasksWrapperPtr;
+    FilterTasks_t                           *filterTasksPtr;
 
     // SB Loop variables
     LargestCodingUnit_t                     *sb_ptr;
@@ -1349,15 +641,9 @@ void* EncDecKernel(void *input_ptr)
     uint32_t                                 sb_origin_x;
     uint32_t                                 sb_origin_y;
     EbBool                                   lastLcuFlag;
-    EbBool                                   endOfRowFlag;
-    uint32_t                                 lcuRowIndexStart;
-    uint32_t                                 lcuRowIndexCount;
     uint32_t                                 picture_width_in_sb;
     MdcLcuData_t                            *mdcPtr;
 
-    // Variables
-    EbBool                                   is16bit;
-
     // Segments
     //EbBool                                 initialProcessCall;
     uint16_t                                 segment_index;
@@ -1371,8 +657,6 @@ void* EncDecKernel(void *input_ptr)
     uint32_t                                 segmentBandSize;
     EncDecSegments_t                        *segmentsPtr;
 
-    EbBool                                   enableEcRows = EB_FALSE;//for CDEF.
-
     for (;;) {
 
         // Get Mode Decision Results
@@ -1385,15 +669,12 @@ void* EncDecKernel(void *input_ptr)
         sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->objectPtr;
         segmentsPtr = picture_control_set_ptr->enc_dec_segment_ctrl;
         lastLcuFlag = EB_FALSE;
-        is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
 
         // SB Constants
         sb_sz = (uint8_t)sequence_control_set_ptr->sb_size_pix;
         lcuSizeLog2 = (uint8_t)Log2f(sb_sz);
         context_ptr->sb_sz = sb_sz;
         picture_width_in_sb = (sequence_control_set_ptr->luma_width + sb_sz - 1) >> lcuSizeLog2;
-        endOfRowFlag = EB_FALSE;
-        lcuRowIndexStart = lcuRowIndexCount = 0;
         context_ptr->tot_intra_coded_area = 0;
 
         // Segment-loop
@@ -1408,16 +689,16 @@ void* EncDecKernel(void *input_ptr)
             segmentBandIndex = segment_index - segmentRowIndex * segmentsPtr->segmentBandCount;
             segmentBandSize = (segmentsPtr->lcuBandCount * (segmentBandIndex + 1) + segmentsPtr->segmentBandCount - 1) / segmentsPtr->segmentBandCount;
 
-            // Reset Coding Loop State
-            reset_mode_decision( // HT done
-                context_ptr->md_context,
+            // Reset EncDec Coding State, the MD rate tables of the picture first
+            ResetEncDec(    // HT done
+                context_ptr,
                 picture_control_set_ptr,
                 sequence_control_set_ptr,
                 segment_index);
 
-            // Reset EncDec Coding State
-            ResetEncDec(    // HT done
-                context_ptr,
+            // Reset Coding Loop State
+            reset_mode_decision( // HT done
+                context_ptr->md_context,
                 picture_control_set_ptr,
                 sequence_control_set_ptr,
                 segment_index);
@@ -1435,9 +716,6 @@ void* EncDecKernel(void *input_ptr)
                     sb_origin_x = xLcuIndex << lcuSizeLog2;
                     sb_origin_y = yLcuIndex << lcuSizeLog2;
                     lastLcuFlag = (sb_index == sequence_control_set_ptr->sb_tot_cnt - 1) ? EB_TRUE : EB_FALSE;
-                    endOfRowFlag = (xLcuIndex == picture_width_in_sb - 1) ? EB_TRUE : EB_FALSE;
-                    lcuRowIndexStart = (xLcuIndex == picture_width_in_sb - 1 && lcuRowIndexCount == 0) ? yLcuIndex : lcuRowIndexStart;
-                    lcuRowIndexCount = (xLcuIndex == picture_width_in_sb - 1) ? lcuRowIndexCount + 1 : lcuRowIndexCount;
                     mdcPtr = &picture_control_set_ptr->mdc_sb_array[sb_index];
                     context_ptr->sb_index = sb_index;
                     context_ptr->md_context->cu_use_ref_src_flag = (picture_control_set_ptr->parent_pcs_ptr->use_src_ref) && (picture_control_set_ptr->parent_pcs_ptr->edge_results_ptr[sb_index].edge_block_num == EB_FALSE || picture_control_set_ptr->parent_pcs_ptr->sb_flat_noise_array[sb_index]) ? EB_TRUE : EB_FALSE;
@@ -1580,6 +858,14 @@ void* EncDecKernel(void *input_ptr)
                         ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->intra_coded_area_sb[sb_index] = (uint8_t)((100 * context_ptr->intra_coded_area_sb[sb_index]) / (64 * 64));
                     }
 
+                    if (sequence_control_set_ptr->static_config.low_latency == EB_SB_ROW_LATENCY) {
+                        EncDecStreamLcu(
+                            context_ptr,
+                            encDecTasksPtr->pictureControlSetWrapperPtr,
+                            sb_index,
+                            yLcuIndex);
+                    }
+
                 }
                 xLcuStartIndex = (xLcuStartIndex > 0) ? xLcuStartIndex - 1 : 0;
             }
@@ -1591,6 +877,10 @@ void* EncDecKernel(void *input_ptr)
 
         if (lastLcuFlag) {
 
+            PictureStageDone(
+                picture_control_set_ptr->parent_pcs_ptr,
+                LATENCY_STAGE_ENC_DEC);
+
             // Copy film grain data from parent picture set to the reference object for further reference
             if (sequence_control_set_ptr->film_grain_params_present)
             {
@@ -1602,308 +892,23 @@ void* EncDecKernel(void *input_ptr)
                 }
             }
 
-#if AV1_LF && AV1_LF_FULL_IMAGE_SELECTION
-            EbBool dlfEnableFlag = (EbBool)(!sequence_control_set_ptr->static_config.disable_dlf_flag &&
-                (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag ||
-                    sequence_control_set_ptr->static_config.recon_enabled ||
-                    sequence_control_set_ptr->static_config.stat_report));
-
-            if (dlfEnableFlag) {
-                EbPictureBufferDesc_t  *reconBuffer = is16bit ? picture_control_set_ptr->recon_picture16bit_ptr : picture_control_set_ptr->recon_picture_ptr;
-                if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE && picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr) {
-
-                    //get the 16bit form of the input LCU
-                    if (is16bit) {
-                        reconBuffer = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->referencePicture16bit;
-                    }
-                    else {
-                        reconBuffer = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->referencePicture;
-                    }
-                }
-                else { // non ref pictures
-                    reconBuffer = is16bit ? picture_control_set_ptr->recon_picture16bit_ptr : picture_control_set_ptr->recon_picture_ptr;
-                }
-
-                av1_loop_filter_init(picture_control_set_ptr);
-
-                av1_pick_filter_level(
-                    context_ptr,
-                    (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
-                    picture_control_set_ptr,
-                    LPF_PICK_FROM_FULL_IMAGE);
-
-#if NO_ENCDEC
-                //NO DLF
-                picture_control_set_ptr->parent_pcs_ptr->lf.filter_level[0] = 0;
-                picture_control_set_ptr->parent_pcs_ptr->lf.filter_level[1] = 0;
-                picture_control_set_ptr->parent_pcs_ptr->lf.filter_level_u = 0;
-                picture_control_set_ptr->parent_pcs_ptr->lf.filter_level_v = 0;
-#endif
-                av1_loop_filter_frame(
-                    reconBuffer,
-                    picture_control_set_ptr,
-                    0,
-                    3);
-            }
-#endif
-
-            Av1Common* cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
-
-            EbPictureBufferDesc_t  * recon_picture_ptr;
-
-            if (is16bit) {
-                if ((picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) && (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE))
-                    recon_picture_ptr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->referencePicture16bit;
-                else
-                    recon_picture_ptr = picture_control_set_ptr->recon_picture16bit_ptr;
-            }
-            else {
-                if ((picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) && (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE))
-                    recon_picture_ptr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->referencePicture;
-                else
-                    recon_picture_ptr = picture_control_set_ptr->recon_picture_ptr;
-            }
-
-            LinkEbToAomBufferDesc(
-                recon_picture_ptr,
-                cm->frame_to_show);
-
-            if (sequence_control_set_ptr->enable_restoration) {
-                av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
-            }
-
-
-#if CDEF_REF_ONLY
-            if (sequence_control_set_ptr->enable_cdef && picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
-#else
-            if (sequence_control_set_ptr->enable_cdef) {
-#endif
-                if (is16bit) {
-                    av1_cdef_search16bit(
-                        context_ptr,
-                        sequence_control_set_ptr,
-                        picture_control_set_ptr
-                    );
-
-                    av1_cdef_frame16bit(
-                        context_ptr,
-                        sequence_control_set_ptr,
-                        picture_control_set_ptr
-                    );
-                }
-                else {
-                    av1_cdef_search(
-                        context_ptr,
-                        sequence_control_set_ptr,
-                        picture_control_set_ptr
-                    );
-
-                    av1_cdef_frame(
-                        context_ptr,
-                        sequence_control_set_ptr,
-                        picture_control_set_ptr
-                    );
-                }
-            }
-            else {
-
-#if CDEF_REF_ONLY
-                picture_control_set_ptr->parent_pcs_ptr->cdef_bits = 0;
-                picture_control_set_ptr->parent_pcs_ptr->cdef_strengths[0] = 0;
-                picture_control_set_ptr->parent_pcs_ptr->nb_cdef_strengths = 1;
-                picture_control_set_ptr->parent_pcs_ptr->cdef_uv_strengths[0] = 0;
-#else
-                picture_control_set_ptr->parent_pcs_ptr->cdef_bits = 0;
-
-                picture_control_set_ptr->parent_pcs_ptr->nb_cdef_strengths = 0;
-#endif         
-           
-
-            }
-
-
-#if REST_REF_ONLY
-            if (sequence_control_set_ptr->enable_restoration && picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
-#else
             if (sequence_control_set_ptr->enable_restoration) {
-#endif
-                av1_loop_restoration_save_boundary_lines(
-                    cm->frame_to_show,
-                    cm,
-                    1);
-
-                Yv12BufferConfig cpi_source;
-                LinkEbToAomBufferDesc(
-                    is16bit ? picture_control_set_ptr->input_frame16bit : picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
-                    &cpi_source);
-
-                Yv12BufferConfig trial_frame_rst;
-                LinkEbToAomBufferDesc(
-                    context_ptr->trial_frame_rst,
-                    &trial_frame_rst);
-
                 memcpy(&picture_control_set_ptr->parent_pcs_ptr->av1x->sgrproj_restore_cost, &context_ptr->md_rate_estimation_ptr->sgrprojRestoreFacBits, 2 * sizeof(int32_t));
                 memcpy(&picture_control_set_ptr->parent_pcs_ptr->av1x->switchable_restore_cost, &context_ptr->md_rate_estimation_ptr->switchableRestoreFacBits, 3 * sizeof(int32_t));
                 memcpy(&picture_control_set_ptr->parent_pcs_ptr->av1x->wiener_restore_cost, &context_ptr->md_rate_estimation_ptr->wienerRestoreFacBits, 2 * sizeof(int32_t));
                 picture_control_set_ptr->parent_pcs_ptr->av1x->rdmult = context_ptr->full_lambda;
-
-                av1_pick_filter_restoration(
-                    &cpi_source,
-                    &trial_frame_rst,
-                    picture_control_set_ptr->parent_pcs_ptr->av1x,
-                    picture_control_set_ptr->parent_pcs_ptr->av1_cm);
-
-                if (cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
-                    cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
-                    cm->rst_info[2].frame_restoration_type != RESTORE_NONE)
-                {
-                    av1_loop_restoration_filter_frame(
-                        cm->frame_to_show,
-                        cm,
-                        0);
-                }
-            }
-            else {
-                cm->rst_info[0].frame_restoration_type = RESTORE_NONE;
-                cm->rst_info[1].frame_restoration_type = RESTORE_NONE;
-                cm->rst_info[2].frame_restoration_type = RESTORE_NONE;
-            }
-
-            if (picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) {
-                // copy stat to ref object (intra_coded_area, Luminance, Scene change detection flags)
-                CopyStatisticsToRefObject(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr);
-            }
-            //printf("%3i\t%i\n", picture_control_set_ptr->picture_number, context_ptr->tot_intra_coded_area);
-
-            // PSNR Calculation
-            if (sequence_control_set_ptr->static_config.stat_report) {
-                PsnrCalculations(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr);
-            }
-
-            // Pad the reference picture and set up TMVP flag and ref POC
-            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                PadRefAndSetFlags(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr);
-
-            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE && picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr)
-            {
-                EbPictureBufferDesc_t *inputPicturePtr = (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
-                const uint32_t  SrclumaOffSet = inputPicturePtr->origin_x + inputPicturePtr->origin_y    *inputPicturePtr->strideY;
-                const uint32_t  SrccbOffset = (inputPicturePtr->origin_x >> 1) + (inputPicturePtr->origin_y >> 1)*inputPicturePtr->strideCb;
-                const uint32_t  SrccrOffset = (inputPicturePtr->origin_x >> 1) + (inputPicturePtr->origin_y >> 1)*inputPicturePtr->strideCr;
-
-                EbReferenceObject_t   *referenceObject = (EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr;
-                EbPictureBufferDesc_t *refDenPic = referenceObject->refDenSrcPicture;
-                const uint32_t           ReflumaOffSet = refDenPic->origin_x + refDenPic->origin_y    *refDenPic->strideY;
-                const uint32_t           RefcbOffset = (refDenPic->origin_x >> 1) + (refDenPic->origin_y >> 1)*refDenPic->strideCb;
-                const uint32_t           RefcrOffset = (refDenPic->origin_x >> 1) + (refDenPic->origin_y >> 1)*refDenPic->strideCr;
-
-                uint16_t  verticalIdx;
-
-                for (verticalIdx = 0; verticalIdx < refDenPic->height; ++verticalIdx)
-                {
-                    EB_MEMCPY(refDenPic->bufferY + ReflumaOffSet + verticalIdx * refDenPic->strideY,
-                        inputPicturePtr->bufferY + SrclumaOffSet + verticalIdx * inputPicturePtr->strideY,
-                        inputPicturePtr->width);
-                }
-
-                for (verticalIdx = 0; verticalIdx < inputPicturePtr->height / 2; ++verticalIdx)
-                {
-                    EB_MEMCPY(refDenPic->bufferCb + RefcbOffset + verticalIdx * refDenPic->strideCb,
-                        inputPicturePtr->bufferCb + SrccbOffset + verticalIdx * inputPicturePtr->strideCb,
-                        inputPicturePtr->width / 2);
-
-                    EB_MEMCPY(refDenPic->bufferCr + RefcrOffset + verticalIdx * refDenPic->strideCr,
-                        inputPicturePtr->bufferCr + SrccrOffset + verticalIdx * inputPicturePtr->strideCr,
-                        inputPicturePtr->width / 2);
-                }
-
-                generate_padding(
-                    refDenPic->bufferY,
-                    refDenPic->strideY,
-                    refDenPic->width,
-                    refDenPic->height,
-                    refDenPic->origin_x,
-                    refDenPic->origin_y);
-
-                generate_padding(
-                    refDenPic->bufferCb,
-                    refDenPic->strideCb,
-                    refDenPic->width >> 1,
-                    refDenPic->height >> 1,
-                    refDenPic->origin_x >> 1,
-                    refDenPic->origin_y >> 1);
-
-                generate_padding(
-                    refDenPic->bufferCr,
-                    refDenPic->strideCr,
-                    refDenPic->width >> 1,
-                    refDenPic->height >> 1,
-                    refDenPic->origin_x >> 1,
-                    refDenPic->origin_y >> 1);
             }
-            if (sequence_control_set_ptr->static_config.recon_enabled) {
-                ReconOutput(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr);
-            }
-
-            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
 
-                // Get Empty EntropyCoding Results
-                EbGetEmptyObject(
-                    context_ptr->picture_demux_output_fifo_ptr,
-                    &pictureDemuxResultsWrapperPtr);
-
-                pictureDemuxResultsPtr = (PictureDemuxResults_t*)pictureDemuxResultsWrapperPtr->objectPtr;
-                pictureDemuxResultsPtr->reference_picture_wrapper_ptr = picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr;
-                pictureDemuxResultsPtr->sequence_control_set_wrapper_ptr = picture_control_set_ptr->sequence_control_set_wrapper_ptr;
-                pictureDemuxResultsPtr->picture_number = picture_control_set_ptr->picture_number;
-                pictureDemuxResultsPtr->pictureType = EB_PIC_REFERENCE;
-
-                // Post Reference Picture
-                EbPostFullObject(pictureDemuxResultsWrapperPtr);
-            }
-
-        }
-
-        // Send the Entropy Coder incremental updates as each SB row becomes available
-        if (enableEcRows)
-        {
-            if (endOfRowFlag == EB_TRUE) {
-
-                // Get Empty EncDec Results
-                EbGetEmptyObject(
-                    context_ptr->enc_dec_output_fifo_ptr,
-                    &encDecResultsWrapperPtr);
-                encDecResultsPtr = (EncDecResults_t*)encDecResultsWrapperPtr->objectPtr;
-                encDecResultsPtr->pictureControlSetWrapperPtr = encDecTasksPtr->pictureControlSetWrapperPtr;
-                encDecResultsPtr->completedLcuRowIndexStart = lcuRowIndexStart;
-                encDecResultsPtr->completedLcuRowCount = lcuRowIndexCount;
-
-                // Post EncDec Results
-                EbPostFullObject(encDecResultsWrapperPtr);
-            }
-        }
-        else if (lastLcuFlag)
-        {
-
-            // Get Empty EncDec Results
+            // Get Empty Filter Task
             EbGetEmptyObject(
                 context_ptr->enc_dec_output_fifo_ptr,
-                &encDecResultsWrapperPtr);
-            encDecResultsPtr = (EncDecResults_t*)encDecResultsWrapperPtr->objectPtr;
-            encDecResultsPtr->pictureControlSetWrapperPtr = encDecTasksPtr->pictureControlSetWrapperPtr;
-            encDecResultsPtr->completedLcuRowIndexStart = 0;
-            encDecResultsPtr->completedLcuRowCount = ((sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) >> lcuSizeLog2);
-            // Post EncDec Results
-            EbPostFullObject(encDecResultsWrapperPtr);
+                &filterTasksWrapperPtr);
+            filterTasksPtr = (FilterTasks_t*)filterTasksWrapperPtr->objectPtr;
+            filterTasksPtr->pictureControlSetWrapperPtr = encDecTasksPtr->pictureControlSetWrapperPtr;
+            filterTasksPtr->inputType = FILTER_TASKS_ENCDEC_INPUT;
 
+            // Post Filter Task
+            EbPostFullObject(filterTasksWrapperPtr);
         }
 
         // Release Mode Decision Results
@@ -1912,73 +917,3 @@ void* EncDecKernel(void *input_ptr)
     }
     return EB_NULL;
 }
-
-void av1_add_film_grain(EbPictureBufferDesc_t *src,
-    EbPictureBufferDesc_t *dst,
-    aom_film_grain_t *film_grain_ptr) {
-    uint8_t *luma, *cb, *cr;
-    int32_t height, width, luma_stride, chroma_stride;
-    int32_t use_high_bit_depth = 0;
-    int32_t chroma_subsamp_x = 0;
-    int32_t chroma_subsamp_y = 0;
-
-    aom_film_grain_t params = *film_grain_ptr;
-
-    switch (src->bit_depth) {
-    case EB_8BIT:
-        params.bit_depth = 8;
-        use_high_bit_depth = 0;
-        chroma_subsamp_x = 1;
-        chroma_subsamp_y = 1;
-        break;
-    case EB_10BIT:
-        params.bit_depth = 10;
-        use_high_bit_depth = 1;
-        chroma_subsamp_x = 1;
-        chroma_subsamp_y = 1;
-        break;
-    default:  //todo: Throw an error if unknown format?
-        params.bit_depth = 10;
-        use_high_bit_depth = 1;
-        chroma_subsamp_x = 1;
-        chroma_subsamp_y = 1;
-    }
-
-    dst->maxWidth = src->maxWidth;
-    dst->maxHeight = src->maxHeight;
-
-    fgn_copy_rect(src->bufferY + ((src->origin_y * src->strideY + src->origin_x) << use_high_bit_depth), src->strideY,
-        dst->bufferY + ((dst->origin_y * dst->strideY + dst->origin_x) << use_high_bit_depth), dst->strideY,
-        dst->width, dst->height, use_high_bit_depth);
-
-    fgn_copy_rect(src->bufferCb + ((src->strideCb * (src->origin_y >> chroma_subsamp_y)
-        + (src->origin_x >> chroma_subsamp_x)) << use_high_bit_depth), src->strideCb,
-        dst->bufferCb + ((dst->strideCb * (dst->origin_y >> chroma_subsamp_y)
-            + (dst->origin_x >> chroma_subsamp_x)) << use_high_bit_depth), dst->strideCb,
-        dst->width >> chroma_subsamp_x, dst->height >> chroma_subsamp_y,
-        use_high_bit_depth);
-
-    fgn_copy_rect(src->bufferCr + ((src->strideCr * (src->origin_y >> chroma_subsamp_y)
-        + (src->origin_x >> chroma_subsamp_x)) << use_high_bit_depth), src->strideCr,
-        dst->bufferCr + ((dst->strideCr * (dst->origin_y >> chroma_subsamp_y)
-            + (dst->origin_x >> chroma_subsamp_x)) << use_high_bit_depth), dst->strideCr,
-        dst->width >> chroma_subsamp_x, dst->height >> chroma_subsamp_y,
-        use_high_bit_depth);
-
-    luma = dst->bufferY + ((dst->origin_y * dst->strideY + dst->origin_x) << use_high_bit_depth);
-    cb = dst->bufferCb + ((dst->strideCb * (dst->origin_y >> chroma_subsamp_y)
-        + (dst->origin_x >> chroma_subsamp_x)) << use_high_bit_depth);
-    cr = dst->bufferCr + ((dst->strideCr * (dst->origin_y >> chroma_subsamp_y)
-        + (dst->origin_x >> chroma_subsamp_x)) << use_high_bit_depth);
-
-    luma_stride = dst->strideY;
-    chroma_stride = dst->strideCb;
-
-    width = dst->width;
-    height = dst->height;
-
-    av1_add_film_grain_run(&params, luma, cb, cr, height, width, luma_stride,
-        chroma_stride, use_high_bit_depth, chroma_subsamp_y,
-        chroma_subsamp_x);
-    return;
-}
@@ -42,8 +42,8 @@ extern "C" {
     {
         EbFifo_t                              *mode_decision_input_fifo_ptr;
         EbFifo_t                              *enc_dec_output_fifo_ptr;
+        EbFifo_t                              *entropy_coding_output_fifo_ptr; // SB row latency: SB rows to the entropy coder
         EbFifo_t                              *enc_dec_feedback_fifo_ptr;
-        EbFifo_t                              *picture_demux_output_fifo_ptr;   // to picture-manager
         int16_t                               *transform_inner_array_ptr;
         MdRateEstimationContext_t             *md_rate_estimation_ptr;
         ModeDecisionContext_t                 *md_context;
@@ -65,12 +65,6 @@ extern "C" {
         EbPictureBufferDesc_t                 *transform_buffer;
         EbPictureBufferDesc_t                 *input_samples;
         EbPictureBufferDesc_t                 *input_sample16bit_buffer;
-        EbPictureBufferDesc_t                 *trial_frame_rst;
-
-        // temporary buffers for decision making of LF (LPF_PICK_FROM_FULL_IMAGE).
-        // Since recon switches between reconPtr and referencePtr, the temporary buffers sizes used the referencePtr's which has padding,...
-        EbPictureBufferDesc_t                 *temp_lf_recon_picture_ptr;
-        EbPictureBufferDesc_t                 *temp_lf_recon_picture16bit_ptr;
         EbPictureBufferDesc_t                 *inverse_quant_buffer;
         // Lambda
 #if ADD_DELTA_QP_SUPPORT
@@ -97,7 +91,7 @@ extern "C" {
         uint8_t                                txb_itr;
         EbBool                                 is16bit; //enable 10 bit encode in CL
         uint64_t                               tot_intra_coded_area;
-        uint8_t                                intra_coded_area_sb[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];//percentage of intra coded area 0-100%
+        uint8_t                               *intra_coded_area_sb;//percentage of intra coded area 0-100%
         uint8_t                                pmp_masking_level_enc_dec;
         EbBool                                 skip_qpm_flag;
         int16_t                                min_delta_qp_weight;
@@ -142,9 +136,9 @@ extern "C" {
     extern EbErrorType enc_dec_context_ctor(
         EncDecContext_t        **context_dbl_ptr,
         EbFifo_t                *mode_decision_configuration_input_fifo_ptr,
-        EbFifo_t                *packetization_output_fifo_ptr,
+        EbFifo_t                *filter_output_fifo_ptr,
+        EbFifo_t                *entropy_coding_output_fifo_ptr,
         EbFifo_t                *feedback_fifo_ptr,
-        EbFifo_t                *picture_demux_fifo_ptr,
         EbBool                   is16bit,
         uint32_t                 max_input_luma_width,
         uint32_t                 max_input_luma_height);
@@ -11,14 +11,17 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+#define ENCDEC_RESULTS_TILE_INPUT           0   // tile to entropy code
+#define ENCDEC_RESULTS_FILTER_DONE_INPUT    1   // SB row latency: the in-loop filters are done with the picture
+
     /**************************************
      * Process Results
      **************************************/
     typedef struct EncDecResults_s
     {
         EbObjectWrapper_t      *pictureControlSetWrapperPtr;
-        uint32_t                  completedLcuRowIndexStart;
-        uint32_t                  completedLcuRowCount;
+        uint16_t                  tile_index;
+        uint32_t                  inputType;
 
     } EncDecResults_t;
 
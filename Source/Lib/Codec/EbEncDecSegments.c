@@ -8,6 +8,7 @@
 
 #include "EbEncDecSegments.h"
 #include "EbThreads.h"
+#include "EbUtility.h"
 
 EbErrorType EncDecSegmentsCtor(
     EncDecSegments_t **segmentsDblPtr,
@@ -48,15 +49,45 @@ EbErrorType EncDecSegmentsCtor(
 
 
 
+/*********************************************************************
+ * EncDecSegmentRowStart
+ *   First segment row of a tile row. Each tile row gets one segment row,
+ *   and the others in proportion to its height, so that no segment
+ *   straddles two tile rows and no segment row is empty.
+ *********************************************************************/
+static unsigned EncDecSegmentRowStart(
+    unsigned tileRowIndex,
+    unsigned tileRowY,
+    unsigned tileRowCount,
+    unsigned segRowCount,
+    unsigned picHeightLcu)
+{
+    if (picHeightLcu == tileRowCount)
+        return tileRowIndex;
+    return tileRowIndex + ((tileRowY - tileRowIndex) * (segRowCount - tileRowCount)) / (picHeightLcu - tileRowCount);
+}
+
 void EncDecSegmentsInit(
     EncDecSegments_t *segmentsPtr,
     uint32_t            segColCount,
     uint32_t            segRowCount,
     uint32_t            picWidthLcu,
-    uint32_t            picHeightLcu)
+    uint32_t            picHeightLcu,
+    const int32_t      *tileRowStartSb,
+    uint32_t            tileRowCount)
 {
-    unsigned x, y, yLast;
+    unsigned x, y;
     unsigned rowIndex, bandIndex, segment_index;
+    unsigned prevRowIndex = (unsigned)-1;
+    unsigned tileRowIndex = 0;
+    unsigned tileRowY, tileRowEndY, tileRowSegStart, tileRowSegEnd;
+
+    // The segment rows follow the tile rows, one per tile row at least.
+    // The bands stay the picture diagonals, across the tile columns: they
+    // are the wavefront order of the picture wide neighbor arrays.
+    segRowCount = MIN(MAX(segRowCount, tileRowCount), MIN(segmentsPtr->segmentMaxRowCount, picHeightLcu));
+    if (tileRowCount > segRowCount)
+        tileRowCount = 1;
 
     segmentsPtr->lcuRowCount = picHeightLcu;
     segmentsPtr->lcuBandCount = BAND_TOTAL_COUNT(picHeightLcu, picWidthLcu);
@@ -69,11 +100,25 @@ void EncDecSegmentsInit(
     EB_MEMSET(segmentsPtr->xStartArray, -1, sizeof(uint16_t) * segmentsPtr->segmentTotalCount);
     EB_MEMSET(segmentsPtr->yStartArray, -1, sizeof(uint16_t) * segmentsPtr->segmentTotalCount);
 
-    // Initialize the per-LCU input availability map & Start Arrays
+    // Initialize the per-LCU input availability map & Start Arrays, and the row-based controls
+    tileRowY = 0;
+    tileRowEndY = (tileRowCount > 1) ? (unsigned)tileRowStartSb[1] : picHeightLcu;
+    tileRowSegStart = 0;
+    tileRowSegEnd = (tileRowCount > 1) ? EncDecSegmentRowStart(1, tileRowEndY, tileRowCount, segRowCount, picHeightLcu) : segRowCount;
     for (y = 0; y < picHeightLcu; ++y) {
+        if (y == tileRowEndY) {
+            ++tileRowIndex;
+            tileRowY = tileRowEndY;
+            tileRowEndY = (tileRowIndex + 1 < tileRowCount) ? (unsigned)tileRowStartSb[tileRowIndex + 1] : picHeightLcu;
+            tileRowSegStart = tileRowSegEnd;
+            tileRowSegEnd = (tileRowIndex + 1 < tileRowCount) ?
+                EncDecSegmentRowStart(tileRowIndex + 1, tileRowEndY, tileRowCount, segRowCount, picHeightLcu) :
+                segRowCount;
+        }
+        rowIndex = tileRowSegStart + ROW_INDEX(y - tileRowY, tileRowSegEnd - tileRowSegStart, tileRowEndY - tileRowY);
+
         for (x = 0; x < picWidthLcu; ++x) {
             bandIndex = BAND_INDEX(x, y, segmentsPtr->segmentBandCount, segmentsPtr->lcuBandCount);
-            rowIndex = ROW_INDEX(y, segmentsPtr->segmentRowCount, segmentsPtr->lcuRowCount);
             segment_index = SEGMENT_INDEX(rowIndex, bandIndex, segmentsPtr->segmentBandCount);
 
             //++segmentsPtr->inputMap.inputDependencyMap[segment_index];
@@ -85,18 +130,16 @@ void EncDecSegmentsInit(
                 (uint16_t)y :
                 segmentsPtr->yStartArray[segment_index];
         }
-    }
 
-    // Initialize the row-based controls
-    for (rowIndex = 0; rowIndex < segmentsPtr->segmentRowCount; ++rowIndex) {
-        y = ((rowIndex * segmentsPtr->lcuRowCount) + (segmentsPtr->segmentRowCount - 1)) / segmentsPtr->segmentRowCount;
-        yLast = ((((rowIndex + 1) * segmentsPtr->lcuRowCount) + (segmentsPtr->segmentRowCount - 1)) / segmentsPtr->segmentRowCount) - 1;
-        bandIndex = BAND_INDEX(0, y, segmentsPtr->segmentBandCount, segmentsPtr->lcuBandCount);
-
-        segmentsPtr->rowArray[rowIndex].startingSegIndex = (uint16_t)SEGMENT_INDEX(rowIndex, bandIndex, segmentsPtr->segmentBandCount);
-        bandIndex = BAND_INDEX(picWidthLcu - 1, yLast, segmentsPtr->segmentBandCount, segmentsPtr->lcuBandCount);
+        // The row starts with the band of its first LCU row, and ends with the band of its last one
+        if (rowIndex != prevRowIndex) {
+            bandIndex = BAND_INDEX(0, y, segmentsPtr->segmentBandCount, segmentsPtr->lcuBandCount);
+            segmentsPtr->rowArray[rowIndex].startingSegIndex = (uint16_t)SEGMENT_INDEX(rowIndex, bandIndex, segmentsPtr->segmentBandCount);
+            segmentsPtr->rowArray[rowIndex].currentSegIndex = segmentsPtr->rowArray[rowIndex].startingSegIndex;
+            prevRowIndex = rowIndex;
+        }
+        bandIndex = BAND_INDEX(picWidthLcu - 1, y, segmentsPtr->segmentBandCount, segmentsPtr->lcuBandCount);
         segmentsPtr->rowArray[rowIndex].endingSegIndex = (uint16_t)SEGMENT_INDEX(rowIndex, bandIndex, segmentsPtr->segmentBandCount);
-        segmentsPtr->rowArray[rowIndex].currentSegIndex = segmentsPtr->rowArray[rowIndex].startingSegIndex;
     }
 
     // Initialize the per-segment dependency map
@@ -85,7 +85,9 @@ extern "C" {
         uint32_t            colCount,
         uint32_t            row_count,
         uint32_t            picWidthLcu,
-        uint32_t            picHeightLcu);
+        uint32_t            picHeightLcu,
+        const int32_t      *tileRowStartSb,
+        uint32_t            tileRowCount);
 #ifdef __cplusplus
 }
 #endif
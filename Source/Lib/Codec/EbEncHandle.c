@@ -64,6 +64,7 @@
 #include "EbDefinitions.h"
 #include "EbApi.h"
 #include "EbThreads.h"
+#include "EbThreadPool.h"
 #include "EbUtility.h"
 #include "EbEncHandle.h"
 #include "EbSystemResourceManager.h"
@@ -82,6 +83,7 @@
 #include "EbRateControlProcess.h"
 #include "EbModeDecisionConfigurationProcess.h"
 #include "EbEncDecProcess.h"
+#include "EbFilterProcess.h"
 #include "EbEntropyCodingProcess.h"
 #include "EbPacketizationProcess.h"
 #include "EbResourceCoordinationResults.h"
@@ -94,6 +96,7 @@
 #include "EbRateControlResults.h"
 #include "EbEncDecTasks.h"
 #include "EbEncDecResults.h"
+#include "EbFilterTasks.h"
 #include "EbEntropyCodingResults.h"
 #include "EbPredictionStructure.h"
 
@@ -131,7 +134,6 @@
 
 // Output Buffer Transfer Parameters
 #define EB_OUTPUTSTREAMBUFFERSIZE                                       0x2DC6C0   //0x7D00        // match MTU Size
-#define EB_OUTPUTRECONBUFFERSIZE                                        (MAX_PICTURE_WIDTH_SIZE*MAX_PICTURE_HEIGHT_SIZE*2)   // Recon Slice Size
 #define EB_OUTPUTSTATISTICSBUFFERSIZE                                   0x30            // 6X8 (8 Bytes for Y, U, V, number of bits, picture number, QP)
 #define EOS_NAL_BUFFER_SIZE                                             0x0010 // Bitstream used to code EOS NAL
 #define EB_OUTPUTSTREAMBUFFERSIZE_MACRO(ResolutionSize)                ((ResolutionSize) < (INPUT_SIZE_1080i_TH) ? 0x1E8480 : (ResolutionSize) < (INPUT_SIZE_1080p_TH) ? 0x2DC6C0 : (ResolutionSize) < (INPUT_SIZE_4K_TH) ? 0x2DC6C0 : 0x2DC6C0  )   
@@ -140,20 +142,42 @@
 #define ENCDEC_INPUT_PORT_ENCDEC                             1
 #define ENCDEC_INPUT_PORT_INVALID                           -1
 
+#define FILTER_INPUT_PORT_ENCDEC                             0
+#define FILTER_INPUT_PORT_FILTER                             1
+#define FILTER_INPUT_PORT_INVALID                           -1
+
+#define ENTROPY_CODING_INPUT_PORT_FILTER                     0
+#define ENTROPY_CODING_INPUT_PORT_ENCDEC                     1
+#define ENTROPY_CODING_INPUT_PORT_INVALID                   -1
+
 #define SCD_LAD                                              6
 
+#define PARALLEL_STAGE_TOTAL_COUNT                           7
+
 /**************************************
- * Globals
+ * Relative CPU cost (percent) of the parallel stages, in the order picture
+ * analysis, motion estimation, source based operations, mode decision
+ * configuration, encdec, loop filter and entropy coding. Measured from the
+ * CPU time of the threads of each stage at enc-mode 3 and rounded; the stages
+ * below the measurement resolution keep a minimal share.
+ **************************************/
+static const uint32_t parallelStageCost[PARALLEL_STAGE_TOTAL_COUNT] = { 4, 12, 1, 1, 58, 20, 4 };
+
+/**************************************
+ * Kernels run on dedicated threads, or as tasks of the shared thread pool
  **************************************/
+#define EB_CREATEKERNEL(encHandlePtr, pointer, kernelFunction, kernelContext) \
+    if ((encHandlePtr)->thread_pool_ptr) { \
+        EB_CREATETASK(EbHandle, pointer, sizeof(EbHandle), EB_TASK, (encHandlePtr)->thread_pool_ptr, kernelFunction, kernelContext); \
+    } \
+    else { \
+        EB_CREATETHREAD(EbHandle, pointer, sizeof(EbHandle), EB_THREAD, kernelFunction, kernelContext); \
+    }
 
-EbMemoryMapEntry                 *memoryMap;
-uint32_t                         *memoryMapIndex;
-uint64_t                         *totalLibMemory;
+/**************************************
+ * Globals
+ **************************************/
 
-uint32_t                         libMallocCount = 0;
-uint32_t                         libThreadCount = 0;
-uint32_t                         libSemaphoreCount = 0;
-uint32_t                         libMutexCount = 0;
 #ifdef _MSC_VER
 GROUP_AFFINITY                   groupAffinity;
 #endif
@@ -194,6 +218,17 @@ int32_t CheckXcr0Ymm()
 #endif
     return ((xcr0 & 6) == 6); /* checking if xmm and ymm state are enabled in XCR0 */
 }
+int32_t CheckXcr0Zmm()
+{
+    uint32_t xcr0;
+    uint32_t zmm_ymm_xmm = (7 << 5) | (1 << 2) | (1 << 1);
+#if defined(_MSC_VER)
+    xcr0 = (uint32_t)_xgetbv(0);  /* min VS2010 SP1 compiler is required */
+#else
+    __asm__("xgetbv" : "=a" (xcr0) : "c" (0) : "%edx");
+#endif
+    return ((xcr0 & zmm_ymm_xmm) == zmm_ymm_xmm); /* checking if xmm, ymm and zmm state are enabled in XCR0 */
+}
 int32_t Check4thGenIntelCoreFeatures()
 {
     int32_t abcd[4];
@@ -230,11 +265,42 @@ static int32_t CanUseIntelCore4thGenFeatures()
         the_4th_gen_features_available = Check4thGenIntelCoreFeatures();
     return the_4th_gen_features_available;
 }
+int32_t CheckAVX512Features()
+{
+    int32_t abcd[4];
+    uint32_t avx512_mask = (1u << 16) | (1u << 17) | (1u << 28) | (1u << 30) | (1u << 31);
+
+    if (!Check4thGenIntelCoreFeatures())
+        return 0;
+
+    if (!CheckXcr0Zmm())
+        return 0;
+
+    /*  CPUID.(EAX=07H, ECX=0H):EBX.AVX512F[bit 16]==1  &&
+        CPUID.(EAX=07H, ECX=0H):EBX.AVX512DQ[bit 17]==1 &&
+        CPUID.(EAX=07H, ECX=0H):EBX.AVX512CD[bit 28]==1 &&
+        CPUID.(EAX=07H, ECX=0H):EBX.AVX512BW[bit 30]==1 &&
+        CPUID.(EAX=07H, ECX=0H):EBX.AVX512VL[bit 31]==1 */
+    RunCpuid(7, 0, abcd);
+    if (((uint32_t)abcd[1] & avx512_mask) != avx512_mask)
+        return 0;
+    return 1;
+}
+static int32_t CanUseIntelAVX512Features()
+{
+    static int32_t the_avx512_features_available = -1;
+    /* test is performed once */
+    if (the_avx512_features_available < 0)
+        the_avx512_features_available = CheckAVX512Features();
+    return the_avx512_features_available;
+}
 EbAsm GetCpuAsmType()
 {
     EbAsm asm_type = ASM_NON_AVX2;
 
-    if (CanUseIntelCore4thGenFeatures() == 1)
+    if (CanUseIntelAVX512Features() == 1)
+        asm_type = ASM_AVX512;
+    else if (CanUseIntelCore4thGenFeatures() == 1)
         asm_type = ASM_AVX2;
     else
         // Need to change to support lower CPU Technologies
@@ -331,6 +397,137 @@ uint32_t SetParentPcs(EbSvtAv1EncConfiguration*   config) {
 
     return inputPic;
 }
+/******************************************************
+* Split the thread budget across the parallel stages
+*   Without a budget the stages keep their default sizes. Otherwise the
+*   stages with a user defined thread count take it out of the budget, the
+*   others get one thread each and share the rest in proportion of the
+*   stage costs (largest remainder rounding). Returns the number of threads
+*   of the parallel stages.
+******************************************************/
+static uint32_t SetParallelProcessCounts(
+    SequenceControlSet_t       *sequence_control_set_ptr,
+    uint32_t                    coreCount)
+{
+    EbSvtAv1EncConfiguration *config = &sequence_control_set_ptr->static_config;
+    uint32_t *processCount[PARALLEL_STAGE_TOTAL_COUNT] = {
+        &sequence_control_set_ptr->picture_analysis_process_init_count,
+        &sequence_control_set_ptr->motion_estimation_process_init_count,
+        &sequence_control_set_ptr->source_based_operations_process_init_count,
+        &sequence_control_set_ptr->mode_decision_configuration_process_init_count,
+        &sequence_control_set_ptr->enc_dec_process_init_count,
+        &sequence_control_set_ptr->filter_process_init_count,
+        &sequence_control_set_ptr->entropy_coding_process_init_count };
+    const uint32_t userCount[PARALLEL_STAGE_TOTAL_COUNT] = {
+        config->picture_analysis_thread_count,
+        config->motion_estimation_thread_count,
+        config->source_based_operations_thread_count,
+        config->mode_decision_configuration_thread_count,
+        config->enc_dec_thread_count,
+        config->filter_thread_count,
+        config->entropy_coding_thread_count };
+    const uint32_t defaultCount[PARALLEL_STAGE_TOTAL_COUNT] = {
+        MAX(15, coreCount / 6),
+        MAX(20, coreCount / 3),
+        MAX(3, coreCount / 12),
+        MAX(3, coreCount / 12),
+        MAX(40, coreCount),
+        MAX(4, coreCount / 4),
+        MAX(3, coreCount / 12) };
+    uint32_t remainder[PARALLEL_STAGE_TOTAL_COUNT] = { 0 };
+    uint32_t budget = config->thread_count;
+    uint32_t costTotal = 0;
+    uint32_t assigned = 0;
+    uint32_t total = 0;
+    uint32_t stage;
+
+    // On the shared thread pool the kernels only take a worker while they
+    // have work, each stage may then use every worker of the pool
+    if (config->use_thread_pool) {
+        budget = budget ? budget : coreCount;
+        for (stage = 0; stage < PARALLEL_STAGE_TOTAL_COUNT; ++stage) {
+            *processCount[stage] = userCount[stage] ? userCount[stage] : MAX(1, budget);
+            total += *processCount[stage];
+        }
+        return total;
+    }
+
+    if (budget == 0) {
+        for (stage = 0; stage < PARALLEL_STAGE_TOTAL_COUNT; ++stage) {
+            *processCount[stage] = userCount[stage] ? userCount[stage] : defaultCount[stage];
+            total += *processCount[stage];
+        }
+        return total;
+    }
+
+    // The budget covers the user counts and one thread of each other stage,
+    // see VerifySettings
+    for (stage = 0; stage < PARALLEL_STAGE_TOTAL_COUNT; ++stage) {
+        if (userCount[stage]) {
+            *processCount[stage] = userCount[stage];
+            budget -= MIN(budget, userCount[stage]);
+        }
+        else {
+            budget -= MIN(budget, 1);
+            costTotal += parallelStageCost[stage];
+        }
+    }
+
+    for (stage = 0; stage < PARALLEL_STAGE_TOTAL_COUNT && costTotal; ++stage) {
+        if (userCount[stage] == 0) {
+            *processCount[stage] = budget * parallelStageCost[stage] / costTotal;
+            remainder[stage] = budget * parallelStageCost[stage] % costTotal;
+            assigned += *processCount[stage];
+        }
+    }
+
+    while (assigned < budget) {
+        uint32_t best = 0;
+        for (stage = 1; stage < PARALLEL_STAGE_TOTAL_COUNT; ++stage)
+            best = (remainder[stage] > remainder[best]) ? stage : best;
+        if (remainder[best] == 0)
+            break;
+        remainder[best] = 0;
+        (*processCount[best])++;
+        assigned++;
+    }
+
+    for (stage = 0; stage < PARALLEL_STAGE_TOTAL_COUNT; ++stage) {
+        if (userCount[stage] == 0)
+            (*processCount[stage])++;
+        total += *processCount[stage];
+    }
+
+    return total;
+}
+
+/*********************************************************************
+ * Upper bound of the number of tiles of a picture, i.e. of the entropy
+ * coders of a picture control set. Mirrors av1_set_tile_info() with 64x64
+ * superblocks, which give the finest tile grid.
+ *********************************************************************/
+static uint16_t GetTileCountUpperBound(
+    SequenceControlSet_t       *sequence_control_set_ptr)
+{
+    uint32_t sbCols = (sequence_control_set_ptr->max_input_luma_width + 63) >> 6;
+    uint32_t sbRows = (sequence_control_set_ptr->max_input_luma_height + 63) >> 6;
+    uint32_t log2TileCols = sequence_control_set_ptr->static_config.tile_columns;
+    uint32_t log2TileRows = sequence_control_set_ptr->static_config.tile_rows;
+    uint32_t minLog2TileCols = 0;
+    uint32_t minLog2Tiles = 0;
+
+    // A tile is at most 4096 samples wide and 4096x2304 samples large
+    while ((64u << minLog2TileCols) < sbCols)
+        minLog2TileCols++;
+    while ((2304u << minLog2Tiles) < sbCols * sbRows)
+        minLog2Tiles++;
+
+    log2TileCols = MAX(log2TileCols, minLog2TileCols);
+    log2TileRows = MAX(log2TileRows, minLog2Tiles);
+
+    return (uint16_t)(MIN(sbCols, 1u << log2TileCols) * MIN(sbRows, 1u << log2TileRows));
+}
+
 void LoadDefaultBufferConfigurationSettings(
     SequenceControlSet_t       *sequence_control_set_ptr){
     uint32_t encDecSegH = (sequence_control_set_ptr->static_config.super_block_size == 128) ?
@@ -349,6 +546,9 @@ void LoadDefaultBufferConfigurationSettings(
 
     sequence_control_set_ptr->output_stream_buffer_fifo_init_count = sequence_control_set_ptr->input_buffer_fifo_init_count = inputPic + SCD_LAD;
     sequence_control_set_ptr->output_stream_buffer_fifo_init_count = sequence_control_set_ptr->input_buffer_fifo_init_count + 4;
+    // With the tile group output, each picture takes a buffer per tile group on top of its headers
+    if (sequence_control_set_ptr->static_config.tile_group_output)
+        sequence_control_set_ptr->output_stream_buffer_fifo_init_count *= 1 + GetTileCountUpperBound(sequence_control_set_ptr);
     // ME segments
     sequence_control_set_ptr->me_segment_row_count_array[0] = meSegH;
     sequence_control_set_ptr->me_segment_row_count_array[1] = meSegH;
@@ -398,6 +598,7 @@ void LoadDefaultBufferConfigurationSettings(
     sequence_control_set_ptr->motion_estimation_fifo_init_count = 300;
     sequence_control_set_ptr->entropy_coding_fifo_init_count = 300;
     sequence_control_set_ptr->enc_dec_fifo_init_count = 300;
+    sequence_control_set_ptr->filter_fifo_init_count = 300;
 
     //#====================== Processes number ======================
     sequence_control_set_ptr->total_process_init_count = 0;
@@ -408,14 +609,10 @@ void LoadDefaultBufferConfigurationSettings(
     sequence_control_set_ptr->total_process_init_count += sequence_control_set_ptr->source_based_operations_process_init_count = 1;//MAX(3, coreCount / 12);
     sequence_control_set_ptr->total_process_init_count += sequence_control_set_ptr->mode_decision_configuration_process_init_count = 1;//MAX(3, coreCount / 12);
     sequence_control_set_ptr->total_process_init_count += sequence_control_set_ptr->enc_dec_process_init_count = 1;//MAX(40, coreCount);
+    sequence_control_set_ptr->total_process_init_count += sequence_control_set_ptr->filter_process_init_count = 1;//MAX(4, coreCount / 4);
     sequence_control_set_ptr->total_process_init_count += sequence_control_set_ptr->entropy_coding_process_init_count = 1;//MAX(3, coreCount / 12);
 #else
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->picture_analysis_process_init_count             = MAX(15, coreCount / 6));
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->motion_estimation_process_init_count            = MAX(20, coreCount / 3));
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->source_based_operations_process_init_count      = MAX(3, coreCount / 12));
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->mode_decision_configuration_process_init_count  = MAX(3, coreCount / 12));
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->enc_dec_process_init_count                      = MAX(40, coreCount)    );
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->entropy_coding_process_init_count               = MAX(3, coreCount / 12));
+    sequence_control_set_ptr->total_process_init_count += SetParallelProcessCounts(sequence_control_set_ptr, coreCount);
 #endif
 
     sequence_control_set_ptr->total_process_init_count += 6; // single processes count
@@ -495,6 +692,80 @@ static uint32_t EncDecPortTotalCount(void){
 
     return total_count;
 }
+
+// Filter
+typedef struct {
+    int32_t  type;
+    uint32_t  count;
+} FilterPorts_t;
+static FilterPorts_t filterPorts[] = {
+    {FILTER_INPUT_PORT_ENCDEC,     0},
+    {FILTER_INPUT_PORT_FILTER,     0},
+    {FILTER_INPUT_PORT_INVALID,    0}
+};
+
+// Filter
+static uint32_t FilterPortLookup(
+    int32_t  type,
+    uint32_t  portTypeIndex)
+{
+    uint32_t portIndex = 0;
+    uint32_t portCount = 0;
+
+    while ((type != filterPorts[portIndex].type) && (type != FILTER_INPUT_PORT_INVALID)) {
+        portCount += filterPorts[portIndex++].count;
+    }
+
+    return (portCount + portTypeIndex);
+}
+// Filter
+static uint32_t FilterPortTotalCount(void){
+    uint32_t portIndex = 0;
+    uint32_t total_count = 0;
+
+    while (filterPorts[portIndex].type != FILTER_INPUT_PORT_INVALID) {
+        total_count += filterPorts[portIndex++].count;
+    }
+
+    return total_count;
+}
+
+// Entropy Coding
+typedef struct {
+    int32_t  type;
+    uint32_t  count;
+} EntropyCodingPorts_t;
+static EntropyCodingPorts_t entropyCodingPorts[] = {
+    {ENTROPY_CODING_INPUT_PORT_FILTER,     0},
+    {ENTROPY_CODING_INPUT_PORT_ENCDEC,     0},
+    {ENTROPY_CODING_INPUT_PORT_INVALID,    0}
+};
+
+// Entropy Coding
+static uint32_t EntropyCodingPortLookup(
+    int32_t  type,
+    uint32_t  portTypeIndex)
+{
+    uint32_t portIndex = 0;
+    uint32_t portCount = 0;
+
+    while ((type != entropyCodingPorts[portIndex].type) && (type != ENTROPY_CODING_INPUT_PORT_INVALID)) {
+        portCount += entropyCodingPorts[portIndex++].count;
+    }
+
+    return (portCount + portTypeIndex);
+}
+// Entropy Coding
+static uint32_t EntropyCodingPortTotalCount(void){
+    uint32_t portIndex = 0;
+    uint32_t total_count = 0;
+
+    while (entropyCodingPorts[portIndex].type != ENTROPY_CODING_INPUT_PORT_INVALID) {
+        total_count += entropyCodingPorts[portIndex++].count;
+    }
+
+    return total_count;
+}
 /*****************************************
  * Input Port Total Count
  *****************************************/
@@ -518,22 +789,19 @@ static EbErrorType eb_enc_handle_ctor(
     if (encHandlePtr == (EbEncHandle_t*)EB_NULL) {
         return EB_ErrorInsufficientResources;
     }
-    encHandlePtr->memoryMap = (EbMemoryMapEntry*)malloc(sizeof(EbMemoryMapEntry) * MAX_NUM_PTR);
-    encHandlePtr->memoryMapIndex = 0;
-    encHandlePtr->totalLibMemory = sizeof(EbEncHandle_t) + sizeof(EbMemoryMapEntry) * MAX_NUM_PTR;
-
-    // Save Memory Map Pointers 
-    totalLibMemory = &encHandlePtr->totalLibMemory;
-    memoryMap = encHandlePtr->memoryMap;
-    memoryMapIndex = &encHandlePtr->memoryMapIndex;
-    libMallocCount = 0;
-    libThreadCount = 0;
-    libMutexCount = 0;
-    libSemaphoreCount = 0;
-
-    if (memoryMap == (EbMemoryMapEntry*)EB_NULL) {
-        return EB_ErrorInsufficientResources;
+    // Memory Map of the instance, every allocation made on behalf of this handle is registered in it
+    return_error = eb_memory_context_ctor(&encHandlePtr->memory_context);
+    if (return_error != EB_ErrorNone) {
+        return return_error;
     }
+    encHandlePtr->memory_context.total_lib_memory = sizeof(EbEncHandle_t);
+    eb_set_memory_context(&encHandlePtr->memory_context);
+    encHandlePtr->thread_pool_ptr = (EbThreadPool_t*)EB_NULL;
+    encHandlePtr->numa_node_mask = 1;
+    encHandlePtr->input_buffer_sent_count = 0;
+    encHandlePtr->eos_sent = EB_FALSE;
+    encHandlePtr->message_in_flight_count = 0;
+    encHandlePtr->init_time = 0;
 
     InitThreadManagmentParams();
 
@@ -571,6 +839,7 @@ static EbErrorType eb_enc_handle_ctor(
     encHandlePtr->rateControlThreadHandle = (EbHandle)EB_NULL;
     encHandlePtr->modeDecisionConfigurationThreadHandleArray = (EbHandle*)EB_NULL;
     encHandlePtr->encDecThreadHandleArray = (EbHandle*)EB_NULL;
+    encHandlePtr->filterThreadHandleArray = (EbHandle*)EB_NULL;
     encHandlePtr->entropyCodingThreadHandleArray = (EbHandle*)EB_NULL;
     encHandlePtr->packetizationThreadHandle = (EbHandle)EB_NULL;
 
@@ -585,6 +854,7 @@ static EbErrorType eb_enc_handle_ctor(
     encHandlePtr->rateControlContextPtr = (EbPtr)EB_NULL;
     encHandlePtr->modeDecisionConfigurationContextPtrArray = (EbPtr*)EB_NULL;
     encHandlePtr->encDecContextPtrArray = (EbPtr*)EB_NULL;
+    encHandlePtr->filterContextPtrArray = (EbPtr*)EB_NULL;
     encHandlePtr->entropyCodingContextPtrArray = (EbPtr*)EB_NULL;
     encHandlePtr->packetizationContextPtr = (EbPtr)EB_NULL;
 
@@ -600,6 +870,7 @@ static EbErrorType eb_enc_handle_ctor(
     encHandlePtr->rateControlTasksResourcePtr = (EbSystemResource_t*)EB_NULL;
     encHandlePtr->rateControlResultsResourcePtr = (EbSystemResource_t*)EB_NULL;
     encHandlePtr->encDecTasksResourcePtr = (EbSystemResource_t*)EB_NULL;
+    encHandlePtr->filterTasksResourcePtr = (EbSystemResource_t*)EB_NULL;
     encHandlePtr->encDecResultsResourcePtr = (EbSystemResource_t*)EB_NULL;
     encHandlePtr->entropyCodingResultsResourcePtr = (EbSystemResource_t*)EB_NULL;
 
@@ -612,6 +883,7 @@ static EbErrorType eb_enc_handle_ctor(
     encHandlePtr->rateControlTasksProducerFifoPtrArray = (EbFifo_t**)EB_NULL;
     encHandlePtr->rateControlResultsProducerFifoPtrArray = (EbFifo_t**)EB_NULL;
     encHandlePtr->encDecTasksProducerFifoPtrArray = (EbFifo_t**)EB_NULL;
+    encHandlePtr->filterTasksProducerFifoPtrArray = (EbFifo_t**)EB_NULL;
     encHandlePtr->encDecResultsProducerFifoPtrArray = (EbFifo_t**)EB_NULL;
     encHandlePtr->entropyCodingResultsProducerFifoPtrArray = (EbFifo_t**)EB_NULL;
 
@@ -623,6 +895,7 @@ static EbErrorType eb_enc_handle_ctor(
     encHandlePtr->rateControlTasksConsumerFifoPtrArray = (EbFifo_t**)EB_NULL;
     encHandlePtr->rateControlResultsConsumerFifoPtrArray = (EbFifo_t**)EB_NULL;
     encHandlePtr->encDecTasksConsumerFifoPtrArray = (EbFifo_t**)EB_NULL;
+    encHandlePtr->filterTasksConsumerFifoPtrArray = (EbFifo_t**)EB_NULL;
     encHandlePtr->encDecResultsConsumerFifoPtrArray = (EbFifo_t**)EB_NULL;
     encHandlePtr->entropyCodingResultsConsumerFifoPtrArray = (EbFifo_t**)EB_NULL;
 
@@ -655,10 +928,29 @@ uint64_t GetAffinityMask(uint32_t lpnum) {
     return mask;
 }
 #endif
+/**************************************
+* Input Buffer Header
+*   Object of the input buffer pool. The pipeline only sees the leading
+*   EbBufferHeaderType, whose p_buffer points either to the library copy
+*   of the picture or, for a zero copy input, to zeroCopyPicture which
+*   describes the application planes.
+**************************************/
+typedef struct EbInputBufferHeader_s {
+    EbBufferHeaderType          header;
+    EbPictureBufferDesc_t      *ownPicturePtr;
+    EbPictureBufferDesc_t       zeroCopyPicture;
+    EbBufferHeaderType         *appBufferPtr;
+    EbInputReleaseCallback      releaseCallback;
+    void                       *releaseContext;
+} EbInputBufferHeader_t;
+
 EbErrorType EbInputBufferHeaderCtor(
     EbPtr *objectDblPtr,
     EbPtr  objectInitDataPtr);
 
+void EbInputBufferHeaderRelease(
+    EbPtr  objectPtr);
+
 EbErrorType EbOutputReconBufferHeaderCtor(
     EbPtr *objectDblPtr,
     EbPtr  objectInitDataPtr);
@@ -669,12 +961,8 @@ EbErrorType EbOutputBufferHeaderCtor(
 /**********************************
 * Initialize Encoder Library
 **********************************/
-#if defined(__linux__) || defined(__APPLE__)
-__attribute__((visibility("default")))
-#endif
-EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
+static EbErrorType eb_init_encoder_resources(EbEncHandle_t *encHandlePtr)
 {
-    EbEncHandle_t *encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
     EbErrorType return_error = EB_ErrorNone;
     uint32_t instanceIndex;
     uint32_t processIndex;
@@ -724,7 +1012,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         (EbFifo_t ***)EB_NULL,
         EB_FALSE,
         eb_sequence_control_set_ctor,
-        &scs_init);
+        &scs_init,
+        sizeof(scs_init));
 
 
     if (return_error == EB_ErrorInsufficientResources) {
@@ -775,6 +1064,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         inputData.ext_block_flag = (uint8_t)encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequence_control_set_ptr->static_config.ext_block_flag;
 
         inputData.in_loop_me_flag = (uint8_t)encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequence_control_set_ptr->static_config.in_loop_me_flag;
+        inputData.tile_count = GetTileCountUpperBound(encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequence_control_set_ptr);
 
         return_error = EbSystemResourceCtor(
             &(encHandlePtr->pictureParentControlSetPoolPtrArray[instanceIndex]),
@@ -785,7 +1075,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             (EbFifo_t ***)EB_NULL,
             EB_FALSE,
             PictureParentControlSetCtor,
-            &inputData);
+            &inputData,
+            sizeof(inputData));
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -806,6 +1097,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
 
         inputData.enc_dec_segment_col = 0;
         inputData.enc_dec_segment_row = 0;
+        inputData.tile_count = GetTileCountUpperBound(encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequence_control_set_ptr);
         for (i = 0; i <= encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequence_control_set_ptr->static_config.hierarchical_levels; ++i) {
             inputData.enc_dec_segment_col = encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequence_control_set_ptr->enc_dec_segment_col_count_array[i] > inputData.enc_dec_segment_col ?
                 (uint16_t)encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequence_control_set_ptr->enc_dec_segment_col_count_array[i] :
@@ -837,7 +1129,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             (EbFifo_t ***)EB_NULL,
             EB_FALSE,
             PictureControlSetCtor,
-            &inputData);
+            &inputData,
+            sizeof(inputData));
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -863,6 +1156,10 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
 
     encDecPorts[ENCDEC_INPUT_PORT_MDC].count = encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->mode_decision_configuration_process_init_count;
     encDecPorts[ENCDEC_INPUT_PORT_ENCDEC].count = encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->enc_dec_process_init_count;
+    filterPorts[FILTER_INPUT_PORT_ENCDEC].count = encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->enc_dec_process_init_count;
+    filterPorts[FILTER_INPUT_PORT_FILTER].count = encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->filter_process_init_count;
+    entropyCodingPorts[ENTROPY_CODING_INPUT_PORT_FILTER].count = encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->filter_process_init_count;
+    entropyCodingPorts[ENTROPY_CODING_INPUT_PORT_ENCDEC].count = encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->enc_dec_process_init_count;
 
     for (instanceIndex = 0; instanceIndex < encHandlePtr->encodeInstanceTotalCount; ++instanceIndex) {
 
@@ -901,7 +1198,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             (EbFifo_t ***)EB_NULL,
             EB_FALSE,
             EbReferenceObjectCtor,
-            &(EbReferenceObjectDescInitDataStructure));
+            &(EbReferenceObjectDescInitDataStructure),
+            sizeof(EbReferenceObjectDescInitDataStructure));
 
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
@@ -955,7 +1253,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             (EbFifo_t ***)EB_NULL,
             EB_FALSE,
             EbPaReferenceObjectCtor,
-            &(EbPaReferenceObjectDescInitDataStructure));
+            &(EbPaReferenceObjectDescInitDataStructure),
+            sizeof(EbPaReferenceObjectDescInitDataStructure));
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -979,11 +1278,14 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         &encHandlePtr->input_buffer_consumer_fifo_ptr_array,
         EB_TRUE,
         EbInputBufferHeaderCtor,
-        encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr);
+        encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr,
+        0);
 
     if (return_error == EB_ErrorInsufficientResources) {
         return EB_ErrorInsufficientResources;
     }
+    // Hands zero copy inputs back to the application
+    encHandlePtr->input_buffer_resource_ptr->objectRelease = EbInputBufferHeaderRelease;
     // EbBufferHeaderType Output Stream
     EB_MALLOC(EbSystemResource_t**, encHandlePtr->output_stream_buffer_resource_ptr_array, sizeof(EbSystemResource_t*) * encHandlePtr->encodeInstanceTotalCount, EB_N_PTR);
     EB_MALLOC(EbFifo_t***, encHandlePtr->output_stream_buffer_producer_fifo_ptr_dbl_array, sizeof(EbFifo_t**)          * encHandlePtr->encodeInstanceTotalCount, EB_N_PTR);
@@ -999,7 +1301,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             &encHandlePtr->output_stream_buffer_consumer_fifo_ptr_dbl_array[instanceIndex],
             EB_TRUE,
             EbOutputBufferHeaderCtor,
-            &encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->static_config);
+            &encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->static_config,
+            0);
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -1014,13 +1317,14 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             return_error = EbSystemResourceCtor(
                 &encHandlePtr->output_recon_buffer_resource_ptr_array[instanceIndex],
                 encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequence_control_set_ptr->output_recon_buffer_fifo_init_count,
-                encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequence_control_set_ptr->enc_dec_process_init_count,
+                encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequence_control_set_ptr->filter_process_init_count,
                 1,
                 &encHandlePtr->output_recon_buffer_producer_fifo_ptr_dbl_array[instanceIndex],
                 &encHandlePtr->output_recon_buffer_consumer_fifo_ptr_dbl_array[instanceIndex],
                 EB_TRUE,
                 EbOutputReconBufferHeaderCtor,
-                encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr);
+                encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr,
+                0);
             if (return_error == EB_ErrorInsufficientResources) {
                 return EB_ErrorInsufficientResources;
             }
@@ -1040,7 +1344,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             &encHandlePtr->resourceCoordinationResultsConsumerFifoPtrArray,
             EB_TRUE,
             ResourceCoordinationResultCtor,
-            &resourceCoordinationResultInitData);
+            &resourceCoordinationResultInitData,
+            sizeof(resourceCoordinationResultInitData));
 
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
@@ -1061,7 +1366,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             &encHandlePtr->pictureAnalysisResultsConsumerFifoPtrArray,
             EB_TRUE,
             PictureAnalysisResultCtor,
-            &pictureAnalysisResultInitData);
+            &pictureAnalysisResultInitData,
+            sizeof(pictureAnalysisResultInitData));
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -1080,7 +1386,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             &encHandlePtr->pictureDecisionResultsConsumerFifoPtrArray,
             EB_TRUE,
             PictureDecisionResultCtor,
-            &pictureDecisionResultInitData);
+            &pictureDecisionResultInitData,
+            sizeof(pictureDecisionResultInitData));
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -1099,7 +1406,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             &encHandlePtr->motionEstimationResultsConsumerFifoPtrArray,
             EB_TRUE,
             MotionEstimationResultsCtor,
-            &motionEstimationResultInitData);
+            &motionEstimationResultInitData,
+            sizeof(motionEstimationResultInitData));
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -1118,7 +1426,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             &encHandlePtr->initialRateControlResultsConsumerFifoPtrArray,
             EB_TRUE,
             InitialRateControlResultsCtor,
-            &initialRateControlResultInitData);
+            &initialRateControlResultInitData,
+            sizeof(initialRateControlResultInitData));
 
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
@@ -1132,13 +1441,14 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         return_error = EbSystemResourceCtor(
             &encHandlePtr->pictureDemuxResultsResourcePtr,
             encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->picture_demux_fifo_init_count,
-            encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->source_based_operations_process_init_count + encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->enc_dec_process_init_count,
+            encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->source_based_operations_process_init_count + encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->filter_process_init_count,
             EB_PictureManagerProcessInitCount,
             &encHandlePtr->pictureDemuxResultsProducerFifoPtrArray,
             &encHandlePtr->pictureDemuxResultsConsumerFifoPtrArray,
             EB_TRUE,
             PictureResultsCtor,
-            &pictureResultInitData);
+            &pictureResultInitData,
+            sizeof(pictureResultInitData));
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -1157,7 +1467,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             &encHandlePtr->rateControlTasksConsumerFifoPtrArray,
             EB_TRUE,
             RateControlTasksCtor,
-            &rateControlTasksInitData);
+            &rateControlTasksInitData,
+            sizeof(rateControlTasksInitData));
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -1176,7 +1487,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             &encHandlePtr->rateControlResultsConsumerFifoPtrArray,
             EB_TRUE,
             RateControlResultsCtor,
-            &rateControlResultInitData);
+            &rateControlResultInitData,
+            sizeof(rateControlResultInitData));
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -1203,7 +1515,26 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             &encHandlePtr->encDecTasksConsumerFifoPtrArray,
             EB_TRUE,
             EncDecTasksCtor,
-            &ModeDecisionResultInitData);
+            &ModeDecisionResultInitData,
+            sizeof(ModeDecisionResultInitData));
+        if (return_error == EB_ErrorInsufficientResources) {
+            return EB_ErrorInsufficientResources;
+        }
+    }
+
+    // Filter Tasks
+    {
+        return_error = EbSystemResourceCtor(
+            &encHandlePtr->filterTasksResourcePtr,
+            encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->filter_fifo_init_count,
+            FilterPortTotalCount(),
+            encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->filter_process_init_count,
+            &encHandlePtr->filterTasksProducerFifoPtrArray,
+            &encHandlePtr->filterTasksConsumerFifoPtrArray,
+            EB_TRUE,
+            FilterTasksCtor,
+            EB_NULL,
+            0);
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -1216,13 +1547,14 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         return_error = EbSystemResourceCtor(
             &encHandlePtr->encDecResultsResourcePtr,
             encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->enc_dec_fifo_init_count,
-            encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->enc_dec_process_init_count,
+            EntropyCodingPortTotalCount(),
             encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->entropy_coding_process_init_count,
             &encHandlePtr->encDecResultsProducerFifoPtrArray,
             &encHandlePtr->encDecResultsConsumerFifoPtrArray,
             EB_TRUE,
             EncDecResultsCtor,
-            &encDecResultInitData);
+            &encDecResultInitData,
+            sizeof(encDecResultInitData));
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -1241,12 +1573,34 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             &encHandlePtr->entropyCodingResultsConsumerFifoPtrArray,
             EB_TRUE,
             EntropyCodingResultsCtor,
-            &entropyCodingResultInitData);
+            &entropyCodingResultInitData,
+            sizeof(entropyCodingResultInitData));
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
     }
 
+    // The inter-process messages share one in-flight count, see eb_svt_enc_reset
+    {
+        EbSystemResource_t *messageResources[] = {
+            encHandlePtr->resourceCoordinationResultsResourcePtr,
+            encHandlePtr->pictureAnalysisResultsResourcePtr,
+            encHandlePtr->pictureDecisionResultsResourcePtr,
+            encHandlePtr->motionEstimationResultsResourcePtr,
+            encHandlePtr->initialRateControlResultsResourcePtr,
+            encHandlePtr->pictureDemuxResultsResourcePtr,
+            encHandlePtr->rateControlTasksResourcePtr,
+            encHandlePtr->rateControlResultsResourcePtr,
+            encHandlePtr->encDecTasksResourcePtr,
+            encHandlePtr->filterTasksResourcePtr,
+            encHandlePtr->encDecResultsResourcePtr,
+            encHandlePtr->entropyCodingResultsResourcePtr };
+        uint32_t resourceIndex;
+
+        for (resourceIndex = 0; resourceIndex < sizeof(messageResources) / sizeof(messageResources[0]); ++resourceIndex)
+            messageResources[resourceIndex]->inFlightCountPtr = &encHandlePtr->message_in_flight_count;
+    }
+
     /************************************
     * App Callbacks
     ************************************/
@@ -1419,9 +1773,9 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         return_error = enc_dec_context_ctor(
             (EncDecContext_t**)&encHandlePtr->encDecContextPtrArray[processIndex],
             encHandlePtr->encDecTasksConsumerFifoPtrArray[processIndex],
-            encHandlePtr->encDecResultsProducerFifoPtrArray[processIndex],
+            encHandlePtr->filterTasksProducerFifoPtrArray[FilterPortLookup(FILTER_INPUT_PORT_ENCDEC, processIndex)],
+            encHandlePtr->encDecResultsProducerFifoPtrArray[EntropyCodingPortLookup(ENTROPY_CODING_INPUT_PORT_ENCDEC, processIndex)],
             encHandlePtr->encDecTasksProducerFifoPtrArray[EncDecPortLookup(ENCDEC_INPUT_PORT_ENCDEC, processIndex)],
-            encHandlePtr->pictureDemuxResultsProducerFifoPtrArray[1 + processIndex], // Add port lookup logic here JMJ
             is16bit,
             encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->max_input_luma_width,
             encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->max_input_luma_height
@@ -1431,6 +1785,25 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         }
     }
 
+    // Filter Contexts
+    EB_MALLOC(EbPtr*, encHandlePtr->filterContextPtrArray, sizeof(EbPtr) * encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->filter_process_init_count, EB_N_PTR);
+
+    for (processIndex = 0; processIndex < encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->filter_process_init_count; ++processIndex) {
+        return_error = filter_context_ctor(
+            (FilterContext_t**)&encHandlePtr->filterContextPtrArray[processIndex],
+            encHandlePtr->filterTasksConsumerFifoPtrArray[processIndex],
+            encHandlePtr->encDecResultsProducerFifoPtrArray[EntropyCodingPortLookup(ENTROPY_CODING_INPUT_PORT_FILTER, processIndex)],
+            encHandlePtr->filterTasksProducerFifoPtrArray[FilterPortLookup(FILTER_INPUT_PORT_FILTER, processIndex)],
+            encHandlePtr->pictureDemuxResultsProducerFifoPtrArray[1 + processIndex], // Add port lookup logic here JMJ
+            encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->filter_process_init_count,
+            is16bit,
+            encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->max_input_luma_width,
+            encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->max_input_luma_height);
+        if (return_error == EB_ErrorInsufficientResources) {
+            return EB_ErrorInsufficientResources;
+        }
+    }
+
     // Entropy Coding Contexts
     EB_MALLOC(EbPtr*, encHandlePtr->entropyCodingContextPtrArray, sizeof(EbPtr) * encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->entropy_coding_process_init_count, EB_N_PTR);
 
@@ -1440,7 +1813,9 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             encHandlePtr->encDecResultsConsumerFifoPtrArray[processIndex],
             encHandlePtr->entropyCodingResultsProducerFifoPtrArray[processIndex],
             encHandlePtr->rateControlTasksProducerFifoPtrArray[RateControlPortLookup(RATE_CONTROL_INPUT_PORT_ENTROPY_CODING, processIndex)],
-            is16bit);
+            is16bit,
+            encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->max_input_luma_width,
+            encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->max_input_luma_height);
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -1458,68 +1833,72 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     /************************************
     * Thread Handles
     ************************************/
-    EbSvtAv1EncConfiguration   *config_ptr = &encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->static_config;
-    EbSetThreadManagementParameters(config_ptr);
-
     // Resource Coordination
-    EB_CREATETHREAD(EbHandle, encHandlePtr->resourceCoordinationThreadHandle, sizeof(EbHandle), EB_THREAD, ResourceCoordinationKernel, encHandlePtr->resourceCoordinationContextPtr);
+    EB_CREATEKERNEL(encHandlePtr, encHandlePtr->resourceCoordinationThreadHandle, ResourceCoordinationKernel, encHandlePtr->resourceCoordinationContextPtr);
 
     // Picture Analysis
     EB_MALLOC(EbHandle*, encHandlePtr->pictureAnalysisThreadHandleArray, sizeof(EbHandle) * encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->picture_analysis_process_init_count, EB_N_PTR);
 
     for (processIndex = 0; processIndex < encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->picture_analysis_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, encHandlePtr->pictureAnalysisThreadHandleArray[processIndex], sizeof(EbHandle), EB_THREAD, PictureAnalysisKernel, encHandlePtr->pictureAnalysisContextPtrArray[processIndex]);
+        EB_CREATEKERNEL(encHandlePtr, encHandlePtr->pictureAnalysisThreadHandleArray[processIndex], PictureAnalysisKernel, encHandlePtr->pictureAnalysisContextPtrArray[processIndex]);
     }
 
     // Picture Decision
-    EB_CREATETHREAD(EbHandle, encHandlePtr->pictureDecisionThreadHandle, sizeof(EbHandle), EB_THREAD, PictureDecisionKernel, encHandlePtr->pictureDecisionContextPtr);
+    EB_CREATEKERNEL(encHandlePtr, encHandlePtr->pictureDecisionThreadHandle, PictureDecisionKernel, encHandlePtr->pictureDecisionContextPtr);
 
     // Motion Estimation
     EB_MALLOC(EbHandle*, encHandlePtr->motionEstimationThreadHandleArray, sizeof(EbHandle) * encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->motion_estimation_process_init_count, EB_N_PTR);
 
     for (processIndex = 0; processIndex < encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->motion_estimation_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, encHandlePtr->motionEstimationThreadHandleArray[processIndex], sizeof(EbHandle), EB_THREAD, MotionEstimationKernel, encHandlePtr->motionEstimationContextPtrArray[processIndex]);
+        EB_CREATEKERNEL(encHandlePtr, encHandlePtr->motionEstimationThreadHandleArray[processIndex], MotionEstimationKernel, encHandlePtr->motionEstimationContextPtrArray[processIndex]);
     }
 
     // Initial Rate Control
-    EB_CREATETHREAD(EbHandle, encHandlePtr->initialRateControlThreadHandle, sizeof(EbHandle), EB_THREAD, InitialRateControlKernel, encHandlePtr->initialRateControlContextPtr);
+    EB_CREATEKERNEL(encHandlePtr, encHandlePtr->initialRateControlThreadHandle, InitialRateControlKernel, encHandlePtr->initialRateControlContextPtr);
 
     // Source Based Oprations
     EB_MALLOC(EbHandle*, encHandlePtr->sourceBasedOperationsThreadHandleArray, sizeof(EbHandle) * encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->source_based_operations_process_init_count, EB_N_PTR);
 
     for (processIndex = 0; processIndex < encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->source_based_operations_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, encHandlePtr->sourceBasedOperationsThreadHandleArray[processIndex], sizeof(EbHandle), EB_THREAD, source_based_operations_kernel, encHandlePtr->sourceBasedOperationsContextPtrArray[processIndex]);
+        EB_CREATEKERNEL(encHandlePtr, encHandlePtr->sourceBasedOperationsThreadHandleArray[processIndex], source_based_operations_kernel, encHandlePtr->sourceBasedOperationsContextPtrArray[processIndex]);
     }
 
     // Picture Manager
-    EB_CREATETHREAD(EbHandle, encHandlePtr->pictureManagerThreadHandle, sizeof(EbHandle), EB_THREAD, PictureManagerKernel, encHandlePtr->pictureManagerContextPtr);
+    EB_CREATEKERNEL(encHandlePtr, encHandlePtr->pictureManagerThreadHandle, PictureManagerKernel, encHandlePtr->pictureManagerContextPtr);
 
     // Rate Control
-    EB_CREATETHREAD(EbHandle, encHandlePtr->rateControlThreadHandle, sizeof(EbHandle), EB_THREAD, RateControlKernel, encHandlePtr->rateControlContextPtr);
+    EB_CREATEKERNEL(encHandlePtr, encHandlePtr->rateControlThreadHandle, RateControlKernel, encHandlePtr->rateControlContextPtr);
 
     // Mode Decision Configuration Process
     EB_MALLOC(EbHandle*, encHandlePtr->modeDecisionConfigurationThreadHandleArray, sizeof(EbHandle) * encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->mode_decision_configuration_process_init_count, EB_N_PTR);
 
     for (processIndex = 0; processIndex < encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->mode_decision_configuration_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, encHandlePtr->modeDecisionConfigurationThreadHandleArray[processIndex], sizeof(EbHandle), EB_THREAD, ModeDecisionConfigurationKernel, encHandlePtr->modeDecisionConfigurationContextPtrArray[processIndex]);
+        EB_CREATEKERNEL(encHandlePtr, encHandlePtr->modeDecisionConfigurationThreadHandleArray[processIndex], ModeDecisionConfigurationKernel, encHandlePtr->modeDecisionConfigurationContextPtrArray[processIndex]);
     }
 
     // EncDec Process
     EB_MALLOC(EbHandle*, encHandlePtr->encDecThreadHandleArray, sizeof(EbHandle) * encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->enc_dec_process_init_count, EB_N_PTR);
 
     for (processIndex = 0; processIndex < encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->enc_dec_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, encHandlePtr->encDecThreadHandleArray[processIndex], sizeof(EbHandle), EB_THREAD, EncDecKernel, encHandlePtr->encDecContextPtrArray[processIndex]);
+        EB_CREATEKERNEL(encHandlePtr, encHandlePtr->encDecThreadHandleArray[processIndex], EncDecKernel, encHandlePtr->encDecContextPtrArray[processIndex]);
+    }
+
+    // Filter Process
+    EB_MALLOC(EbHandle*, encHandlePtr->filterThreadHandleArray, sizeof(EbHandle) * encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->filter_process_init_count, EB_N_PTR);
+
+    for (processIndex = 0; processIndex < encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->filter_process_init_count; ++processIndex) {
+        EB_CREATEKERNEL(encHandlePtr, encHandlePtr->filterThreadHandleArray[processIndex], FilterKernel, encHandlePtr->filterContextPtrArray[processIndex]);
     }
 
     // Entropy Coding Process
     EB_MALLOC(EbHandle*, encHandlePtr->entropyCodingThreadHandleArray, sizeof(EbHandle) * encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->entropy_coding_process_init_count, EB_N_PTR);
 
     for (processIndex = 0; processIndex < encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->entropy_coding_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, encHandlePtr->entropyCodingThreadHandleArray[processIndex], sizeof(EbHandle), EB_THREAD, EntropyCodingKernel, encHandlePtr->entropyCodingContextPtrArray[processIndex]);
+        EB_CREATEKERNEL(encHandlePtr, encHandlePtr->entropyCodingThreadHandleArray[processIndex], EntropyCodingKernel, encHandlePtr->entropyCodingContextPtrArray[processIndex]);
     }
 
     // Packetization
-    EB_CREATETHREAD(EbHandle, encHandlePtr->packetizationThreadHandle, sizeof(EbHandle), EB_THREAD, PacketizationKernel, encHandlePtr->packetizationContextPtr);
+    EB_CREATEKERNEL(encHandlePtr, encHandlePtr->packetizationThreadHandle, PacketizationKernel, encHandlePtr->packetizationContextPtr);
 
     
 #if DISPLAY_MEMORY
@@ -1528,6 +1907,42 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     return return_error;
 }
 
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
+{
+    EbEncHandle_t *encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+    EbSvtAv1EncConfiguration *config_ptr = &encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr->static_config;
+    EbErrorType return_error;
+    int32_t numaNode = config_ptr->target_socket;
+
+    // Register the allocations, and those of the kernels, in the memory map of this instance
+    eb_set_memory_context(&encHandlePtr->memory_context);
+
+    EbSetThreadManagementParameters(config_ptr);
+
+    // The pool workers serve all the channels, they keep the placement of the process
+    if (config_ptr->use_thread_pool) {
+        encHandlePtr->thread_pool_ptr = eb_thread_pool_acquire(config_ptr->thread_count ? config_ptr->thread_count : GetNumCores());
+        if (encHandlePtr->thread_pool_ptr == (EbThreadPool_t*)EB_NULL)
+            return EB_ErrorInsufficientResources;
+    }
+
+    // Build the channel on its NUMA node: the buffers are first touched there,
+    // and the kernel threads inherit the CPUs of the calling thread
+    if (numaNode == -1 && config_ptr->use_round_robin_thread_assignment && config_ptr->active_channel_count > 1)
+        numaNode = (int32_t)(config_ptr->channel_id % EbGetNumaNodeCount());
+    return_error = EbSetThreadPlacement(numaNode, config_ptr->cpu_list, &encHandlePtr->numa_node_mask);
+    if (return_error == EB_ErrorNone)
+        return_error = eb_init_encoder_resources(encHandlePtr);
+    EbRestoreThreadPlacement();
+    if (return_error == EB_ErrorNone)
+        encHandlePtr->init_time = EbGetMonotonicTime();
+
+    return return_error;
+}
+
 /**********************************
 * DeInitialize Encoder Library
 **********************************/
@@ -1538,42 +1953,18 @@ EB_API EbErrorType eb_deinit_encoder(EbComponentType *svt_enc_component)
 {
     EbEncHandle_t *encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
     EbErrorType return_error = EB_ErrorNone;
-    int32_t              ptrIndex = 0;
-    EbMemoryMapEntry*   memoryEntry = (EbMemoryMapEntry*)EB_NULL;
     if (encHandlePtr) {
-        if (encHandlePtr->memoryMapIndex) {
-            // Loop through the ptr table and free all malloc'd pointers per channel
-            for (ptrIndex = (encHandlePtr->memoryMapIndex) - 1; ptrIndex >= 0; --ptrIndex) {
-                memoryEntry = &encHandlePtr->memoryMap[ptrIndex];
-                switch (memoryEntry->ptrType) {
-                case EB_N_PTR:
-                    free(memoryEntry->ptr);
-                    break;
-                case EB_A_PTR:
-#ifdef _WIN32
-                    _aligned_free(memoryEntry->ptr);
-#else
-                    free(memoryEntry->ptr);
-#endif
-                    break;
-                case EB_SEMAPHORE:
-                    EbDestroySemaphore(memoryEntry->ptr);
-                    break;
-                case EB_THREAD:
-                    EbDestroyThread(memoryEntry->ptr);
-                    break;
-                case EB_MUTEX:
-                    EbDestroyMutex(memoryEntry->ptr);
-                    break;
-                default:
-                    return_error = EB_ErrorMax;
-                    break;
-                }
-            }
-            if (encHandlePtr->memoryMap != (EbMemoryMapEntry*)NULL) {
-                free(encHandlePtr->memoryMap);
-            }
+        // Stop the kernel tasks before any of them, or of the objects they use, is freed
+        if (encHandlePtr->thread_pool_ptr)
+            eb_thread_pool_cancel_tasks(encHandlePtr->thread_pool_ptr, &encHandlePtr->memory_context);
 
+        // Free all the pointers and OS objects of this channel
+        return_error = eb_memory_context_release(&encHandlePtr->memory_context);
+
+        // The kernel tasks are gone, leave the shared thread pool
+        if (encHandlePtr->thread_pool_ptr) {
+            eb_thread_pool_release(encHandlePtr->thread_pool_ptr);
+            encHandlePtr->thread_pool_ptr = (EbThreadPool_t*)EB_NULL;
         }
     }
     return return_error;
@@ -1829,6 +2220,9 @@ void CopyApiFromApp(
     sequence_control_set_ptr->static_config.intra_period_length = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->intra_period_length;
     sequence_control_set_ptr->static_config.intra_refresh_type = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->intra_refresh_type;
     sequence_control_set_ptr->static_config.base_layer_switch_mode = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->base_layer_switch_mode;
+    sequence_control_set_ptr->static_config.low_latency = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->low_latency;
+    sequence_control_set_ptr->static_config.tile_group_output = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->tile_group_output;
+    sequence_control_set_ptr->static_config.frame_context_adaptation = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->frame_context_adaptation;
     sequence_control_set_ptr->static_config.hierarchical_levels = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->hierarchical_levels;
     sequence_control_set_ptr->static_config.enc_mode = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->enc_mode;
     sequence_control_set_ptr->intra_period_length = sequence_control_set_ptr->static_config.intra_period_length;
@@ -1842,6 +2236,11 @@ void CopyApiFromApp(
     // Deblock Filter
     sequence_control_set_ptr->static_config.disable_dlf_flag = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->disable_dlf_flag;
 #endif
+    sequence_control_set_ptr->static_config.loop_filter_search = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->loop_filter_search;
+
+    // Tiles
+    sequence_control_set_ptr->static_config.tile_columns = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->tile_columns;
+    sequence_control_set_ptr->static_config.tile_rows = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->tile_rows;
 
     // Local Warped Motion
     sequence_control_set_ptr->static_config.enable_warped_motion = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->enable_warped_motion;
@@ -1903,6 +2302,8 @@ void CopyApiFromApp(
     sequence_control_set_ptr->static_config.min_qp_allowed = (sequence_control_set_ptr->static_config.rate_control_mode) ?
         ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->min_qp_allowed :
         0;
+    sequence_control_set_ptr->static_config.vbv_buffer_size = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->vbv_buffer_size;
+    sequence_control_set_ptr->static_config.vbv_initial_fullness = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->vbv_initial_fullness;
 
     // Misc
     sequence_control_set_ptr->static_config.encoder_bit_depth = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->encoder_bit_depth;
@@ -1925,6 +2326,7 @@ void CopyApiFromApp(
     sequence_control_set_ptr->static_config.tier = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->tier;
     sequence_control_set_ptr->static_config.level = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->level;
     sequence_control_set_ptr->static_config.stat_report = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->stat_report;
+    sequence_control_set_ptr->static_config.frame_stats = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->frame_stats;
 
     sequence_control_set_ptr->static_config.injector_frame_rate = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->injector_frame_rate;
     sequence_control_set_ptr->static_config.speed_control_flag = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->speed_control_flag;
@@ -1932,9 +2334,22 @@ void CopyApiFromApp(
     // Buffers - Hardcoded(Cleanup)
     sequence_control_set_ptr->static_config.asm_type = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->asm_type;
 
+    // Threads management
+    sequence_control_set_ptr->static_config.thread_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->thread_count;
+    sequence_control_set_ptr->static_config.picture_analysis_thread_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->picture_analysis_thread_count;
+    sequence_control_set_ptr->static_config.motion_estimation_thread_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->motion_estimation_thread_count;
+    sequence_control_set_ptr->static_config.source_based_operations_thread_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->source_based_operations_thread_count;
+    sequence_control_set_ptr->static_config.mode_decision_configuration_thread_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->mode_decision_configuration_thread_count;
+    sequence_control_set_ptr->static_config.enc_dec_thread_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->enc_dec_thread_count;
+    sequence_control_set_ptr->static_config.filter_thread_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->filter_thread_count;
+    sequence_control_set_ptr->static_config.entropy_coding_thread_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->entropy_coding_thread_count;
+    sequence_control_set_ptr->static_config.use_thread_pool = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->use_thread_pool;
+
     sequence_control_set_ptr->static_config.channel_id = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->channel_id;
     sequence_control_set_ptr->static_config.active_channel_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->active_channel_count;
     sequence_control_set_ptr->static_config.use_round_robin_thread_assignment = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->use_round_robin_thread_assignment;
+    sequence_control_set_ptr->static_config.target_socket = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->target_socket;
+    sequence_control_set_ptr->static_config.cpu_list = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->cpu_list;
     sequence_control_set_ptr->qp = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->qp;
     sequence_control_set_ptr->static_config.recon_enabled = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->recon_enabled;
 
@@ -1943,6 +2358,28 @@ void CopyApiFromApp(
         sequence_control_set_ptr->frame_rate = sequence_control_set_ptr->static_config.frame_rate = (((sequence_control_set_ptr->static_config.frame_rate_numerator << 8) / (sequence_control_set_ptr->static_config.frame_rate_denominator)) << 8);
     }
 
+    // Low latency: no picture waits for a later one
+    if (sequence_control_set_ptr->static_config.low_latency != EB_NORMAL_LATENCY) {
+        sequence_control_set_ptr->static_config.hierarchical_levels = 0;
+        sequence_control_set_ptr->max_temporal_layers = 0;
+        sequence_control_set_ptr->static_config.look_ahead_distance = 0;
+        sequence_control_set_ptr->static_config.scene_change_detection = 0;
+    }
+
+    // SB row latency: the superblock rows are entropy coded without waiting for the in-loop filters
+    if (sequence_control_set_ptr->static_config.low_latency == EB_SB_ROW_LATENCY) {
+        sequence_control_set_ptr->static_config.tile_columns = 0;
+        sequence_control_set_ptr->static_config.tile_rows = 0;
+        sequence_control_set_ptr->enable_restoration = 0;
+    }
+
+    // Constant bitrate: the QP of each picture is decided without look ahead
+    if (sequence_control_set_ptr->static_config.rate_control_mode == 2) {
+        sequence_control_set_ptr->static_config.look_ahead_distance = 0;
+        if (sequence_control_set_ptr->static_config.vbv_buffer_size == 0)
+            sequence_control_set_ptr->static_config.vbv_buffer_size = sequence_control_set_ptr->static_config.target_bit_rate;
+    }
+
     // Get Default Intra Period if not specified
     if (sequence_control_set_ptr->static_config.intra_period_length == -2) {
         sequence_control_set_ptr->intra_period_length = sequence_control_set_ptr->static_config.intra_period_length = ComputeIntraPeriod(sequence_control_set_ptr);
@@ -2059,13 +2496,13 @@ static EbErrorType VerifySettings(
         return_error = EB_ErrorBadParameter;
     }
 
-    if (sequence_control_set_ptr->max_input_luma_width > 4096) {
-        SVT_LOG("Error instance %u: Source Width must be less than 4096\n", channelNumber + 1);
+    if (sequence_control_set_ptr->max_input_luma_width > MAX_PICTURE_WIDTH_SIZE) {
+        SVT_LOG("Error instance %u: Source Width must be less than or equal to %u\n", channelNumber + 1, MAX_PICTURE_WIDTH_SIZE);
         return_error = EB_ErrorBadParameter;
     }
 
-    if (sequence_control_set_ptr->max_input_luma_height > 2160) {
-        SVT_LOG("Error instance %u: Source Height must be less than 2160\n", channelNumber + 1);
+    if (sequence_control_set_ptr->max_input_luma_height > MAX_PICTURE_HEIGHT_SIZE) {
+        SVT_LOG("Error instance %u: Source Height must be less than or equal to %u\n", channelNumber + 1, MAX_PICTURE_HEIGHT_SIZE);
         return_error = EB_ErrorBadParameter;
     }
 
@@ -2074,7 +2511,12 @@ static EbErrorType VerifySettings(
         return_error = EB_ErrorBadParameter;
     }
 
-    if (config->hierarchical_levels != 3) {
+    if (config->low_latency > EB_SB_ROW_LATENCY) {
+        SVT_LOG("Error instance %u: The latency mode must be [0 - 2]\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->hierarchical_levels != 3 && !(config->low_latency != EB_NORMAL_LATENCY && config->hierarchical_levels == 0)) {
         SVT_LOG("Error instance %u: Hierarchical Levels supported [3]\n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
     }
@@ -2098,6 +2540,21 @@ static EbErrorType VerifySettings(
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->loop_filter_search > 2) {
+        SVT_LOG("Error Instance %u: Invalid LoopFilterSearch. LoopFilterSearch must be [0 - 2]\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->tile_columns > 6) {
+        SVT_LOG("Error Instance %u: Invalid TileColumns. TileColumns must be [0 - 6]\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->tile_rows > 6) {
+        SVT_LOG("Error Instance %u: Invalid TileRows. TileRows must be [0 - 6]\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (config->use_default_me_hme > 1) {
         SVT_LOG("Error Instance %u: invalid use_default_me_hme. use_default_me_hme must be [0 - 1]\n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
@@ -2196,8 +2653,16 @@ static EbErrorType VerifySettings(
         SVT_LOG("Error Instance %u: The constrained intra must be [0 - 1] \n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
     }
-    if (config->rate_control_mode > 1) {
-        SVT_LOG("Error Instance %u: The rate control mode must be [0 - 1] \n", channelNumber + 1);
+    if (config->rate_control_mode > 2) {
+        SVT_LOG("Error Instance %u: The rate control mode must be [0 - 2] \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (config->rate_control_mode == 2 && config->target_bit_rate == 0) {
+        SVT_LOG("Error Instance %u: The constant bitrate mode needs a target bitrate \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+    if (config->vbv_initial_fullness > 100) {
+        SVT_LOG("Error Instance %u: The VBV initial fullness must be [0 - 100] \n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
     }
 
@@ -2289,12 +2754,44 @@ static EbErrorType VerifySettings(
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->frame_stats > 2) {
+        SVT_LOG("Error Instance %u: Invalid FrameStats [0 - 2]\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (((int32_t)(config->asm_type) < -1) || ((int32_t)(config->asm_type) != 1)) {
        // SVT_LOG("Error Instance %u: Invalid asm type value [0: C Only, 1: Auto] .\n", channelNumber + 1);
         SVT_LOG("Error Instance %u: Asm 0 is not supported in this build .\n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->thread_count && !config->use_thread_pool) {
+        const uint32_t stageCount[PARALLEL_STAGE_TOTAL_COUNT] = {
+            config->picture_analysis_thread_count,
+            config->motion_estimation_thread_count,
+            config->source_based_operations_thread_count,
+            config->mode_decision_configuration_thread_count,
+            config->enc_dec_thread_count,
+            config->filter_thread_count,
+            config->entropy_coding_thread_count };
+        uint32_t requiredCount = 0;
+        uint32_t stage;
+        // Each stage without a thread count of its own needs one thread
+        for (stage = 0; stage < PARALLEL_STAGE_TOTAL_COUNT; ++stage)
+            requiredCount += stageCount[stage] ? stageCount[stage] : 1;
+        if (requiredCount > config->thread_count) {
+            SVT_LOG("Error Instance %u: ThreadCount must be at least %u (one thread per stage plus the per stage thread counts)\n", channelNumber + 1, requiredCount);
+            return_error = EB_ErrorBadParameter;
+        }
+    }
+
+#if defined(__linux__)
+    if (config->cpu_list == NULL && (config->target_socket < -1 || config->target_socket >= (int32_t)EbGetNumaNodeCount())) {
+        SVT_LOG("Error Instance %u: Invalid TargetSocket [-1 - %u]\n", channelNumber + 1, EbGetNumaNodeCount() - 1);
+        return_error = EB_ErrorBadParameter;
+    }
+#endif
+
     return return_error;
 }
 
@@ -2321,6 +2818,7 @@ EbErrorType EbH265EncInitParameter(
     config_ptr->source_height = 0;
     config_ptr->framesToBeEncoded = 0; 
     config_ptr->stat_report = 1;
+    config_ptr->frame_stats = 0;
 
     config_ptr->qp = 50;
     config_ptr->use_qp_file = EB_FALSE;
@@ -2330,13 +2828,21 @@ EbErrorType EbH265EncInitParameter(
     config_ptr->target_bit_rate = 7000000;
     config_ptr->max_qp_allowed = 63;
     config_ptr->min_qp_allowed = 0;
+    config_ptr->vbv_buffer_size = 0;
+    config_ptr->vbv_initial_fullness = 90;
     config_ptr->base_layer_switch_mode = 0;
+    config_ptr->low_latency = EB_NORMAL_LATENCY;
+    config_ptr->tile_group_output = EB_FALSE;
+    config_ptr->frame_context_adaptation = EB_FALSE;
     config_ptr->enc_mode = 3;
     config_ptr->intra_period_length = 30;
     config_ptr->intra_refresh_type = 1;
     config_ptr->hierarchical_levels = 3;
     config_ptr->pred_structure = EB_PRED_RANDOM_ACCESS;
     config_ptr->disable_dlf_flag = EB_FALSE;
+    config_ptr->loop_filter_search = 0;
+    config_ptr->tile_columns = 0;
+    config_ptr->tile_rows = 0;
     config_ptr->enable_warped_motion = EB_FALSE;
     config_ptr->in_loop_me_flag = EB_TRUE;
     config_ptr->ext_block_flag = EB_FALSE;
@@ -2401,9 +2907,22 @@ EbErrorType EbH265EncInitParameter(
     // ASM Type
     config_ptr->asm_type = 1;
 
+    // Threads management
+    config_ptr->thread_count = 0;
+    config_ptr->picture_analysis_thread_count = 0;
+    config_ptr->motion_estimation_thread_count = 0;
+    config_ptr->source_based_operations_thread_count = 0;
+    config_ptr->mode_decision_configuration_thread_count = 0;
+    config_ptr->enc_dec_thread_count = 0;
+    config_ptr->filter_thread_count = 0;
+    config_ptr->entropy_coding_thread_count = 0;
+    config_ptr->use_thread_pool = EB_FALSE;
+
     // Channel info
     //config_ptr->logicalProcessors = 0;
-    //config_ptr->target_socket = -1;
+    config_ptr->target_socket = -1;
+    config_ptr->cpu_list = (const char*)EB_NULL;
+    config_ptr->use_round_robin_thread_assignment = EB_FALSE;
     config_ptr->channel_id = 0;
     config_ptr->active_channel_count = 1;
 
@@ -2447,8 +2966,22 @@ static void PrintLibParams(
     else
         SVT_LOG("\nSVT [config]: FrameRate / Gop Size\t\t\t\t\t\t: %d / %d ", config->frame_rate > 1000 ? config->frame_rate >> 16 : config->frame_rate, config->intra_period_length + 1);
     SVT_LOG("\nSVT [config]: HierarchicalLevels / BaseLayerSwitchMode / PredStructure\t\t: %d / %d / %d ", config->hierarchical_levels, config->base_layer_switch_mode, config->pred_structure);
+    if (config->low_latency == EB_SB_ROW_LATENCY)
+        SVT_LOG("\nSVT [config]: LowLatency \t\t\t\t\t\t\t: SB row streaming, no LR, single CDEF strength ");
+    else if (config->low_latency == EB_LOW_LATENCY)
+        SVT_LOG("\nSVT [config]: LowLatency \t\t\t\t\t\t\t: display order ");
+    if (config->tile_group_output)
+        SVT_LOG("\nSVT [config]: Output \t\t\t\t\t\t\t: frame parts per tile group ");
+    if (config->frame_context_adaptation)
+        SVT_LOG("\nSVT [config]: FrameContextAdaptation \t\t\t\t\t\t: CDFs from the primary reference ");
+    if (config->loop_filter_search)
+        SVT_LOG("\nSVT [config]: LoopFilterSearch \t\t\t\t\t\t\t: %s ", config->loop_filter_search == 1 ? "every other SB row" : "from the quantizer");
+    if (config->frame_stats)
+        SVT_LOG("\nSVT [config]: FrameStats \t\t\t\t\t\t\t: %s ", config->frame_stats == 2 ? "bits, timing and PSNR" : "bits and timing");
     if (config->rate_control_mode == 1)
         SVT_LOG("\nSVT [config]: RCMode / TargetBitrate / LookaheadDistance / SceneChange\t\t: VBR / %d / %d / %d ", config->target_bit_rate, config->look_ahead_distance, config->scene_change_detection);
+    else if (config->rate_control_mode == 2)
+        SVT_LOG("\nSVT [config]: RCMode / TargetBitrate / VbvBufferSize / VbvInitialFullness\t: CBR / %d / %d / %d%% ", config->target_bit_rate, config->vbv_buffer_size, config->vbv_initial_fullness);
     else
         SVT_LOG("\nSVT [config]: BRC Mode / QP  / LookaheadDistance / SceneChange\t\t\t: CQP / %d / %d / %d ", scs->qp, config->look_ahead_distance, config->scene_change_detection);
 #ifdef DEBUG_BUFFERS
@@ -2474,12 +3007,13 @@ static void PrintLibParams(
         scs->enc_dec_segment_row_count_array[1],
         scs->enc_dec_segment_row_count_array[2],
         scs->enc_dec_segment_row_count_array[3]);
-    SVT_LOG("\nSVT [config]: PA_P / ME_P / SBO_P / MDC_P / ED_P / EC_P \t\t\t: %d / %d / %d / %d / %d / %d ",
+    SVT_LOG("\nSVT [config]: PA_P / ME_P / SBO_P / MDC_P / ED_P / LF_P / EC_P \t\t: %d / %d / %d / %d / %d / %d / %d ",
         scs->picture_analysis_process_init_count,
         scs->motion_estimation_process_init_count,
         scs->source_based_operations_process_init_count,
         scs->mode_decision_configuration_process_init_count,
         scs->enc_dec_process_init_count,
+        scs->filter_process_init_count,
         scs->entropy_coding_process_init_count);
 #endif
     SVT_LOG("\n------------------------------------------- ");
@@ -2743,13 +3277,11 @@ static EbErrorType CopyFrameBuffer(
     }
     return return_error;
 }
-static void CopyInputBuffer(
-    SequenceControlSet_t*    sequenceControlSet,
+static void CopyInputBufferHeader(
     EbBufferHeaderType*     dst,
     EbBufferHeaderType*     src
 )
 {
-    // Copy the higher level structure
     dst->n_alloc_len = src->n_alloc_len;
     dst->n_filled_len = src->n_filled_len;
     dst->flags = src->flags;
@@ -2758,12 +3290,56 @@ static void CopyInputBuffer(
     dst->size = src->size;
     dst->qp = src->qp;
     dst->pic_type = src->pic_type;
+}
+static void CopyInputBuffer(
+    SequenceControlSet_t*    sequenceControlSet,
+    EbBufferHeaderType*     dst,
+    EbBufferHeaderType*     src
+)
+{
+    // Copy the higher level structure
+    CopyInputBufferHeader(dst, src);
 
     // Copy the picture buffer
     if (src->p_buffer != NULL)
         CopyFrameBuffer(sequenceControlSet, dst->p_buffer, src->p_buffer);
 }
 
+/***********************************************
+**** Point the library picture descriptor at the
+**** application planes, fails when the planes do
+**** not have the layout of the library buffers
+************************************************/
+static EbBool ZeroCopyFrameBuffer(
+    SequenceControlSet_t            *sequence_control_set_ptr,
+    EbPictureBufferDesc_t           *dst,
+    EbPictureBufferDesc_t           *ownPicturePtr,
+    EbSvtEncInput                   *inputPtr)
+{
+    uint32_t lumaOffset   = ownPicturePtr->strideY * ownPicturePtr->origin_y + ownPicturePtr->origin_x;
+    uint32_t chromaOffset = ownPicturePtr->strideCb * (ownPicturePtr->origin_y >> 1) + (ownPicturePtr->origin_x >> 1);
+
+    // The 10 bit inputs are unpacked into the library buffers
+    if (sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT)
+        return EB_FALSE;
+
+    if (inputPtr->luma == NULL || inputPtr->cb == NULL || inputPtr->cr == NULL ||
+        inputPtr->yStride != ownPicturePtr->strideY ||
+        inputPtr->cbStride != ownPicturePtr->strideCb ||
+        inputPtr->crStride != ownPicturePtr->strideCr)
+        return EB_FALSE;
+
+    if (((size_t)(inputPtr->luma - lumaOffset) | (size_t)(inputPtr->cb - chromaOffset) | (size_t)(inputPtr->cr - chromaOffset)) & (ALVALUE - 1))
+        return EB_FALSE;
+
+    *dst = *ownPicturePtr;
+    dst->bufferY  = inputPtr->luma - lumaOffset;
+    dst->bufferCb = inputPtr->cb - chromaOffset;
+    dst->bufferCr = inputPtr->cr - chromaOffset;
+
+    return EB_TRUE;
+}
+
 /**********************************
 * Empty This Buffer
 **********************************/
@@ -2787,12 +3363,104 @@ EB_API EbErrorType eb_svt_enc_send_picture(
             encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr,
             (EbBufferHeaderType*)ebWrapperPtr->objectPtr,
             p_buffer);
+        if (p_buffer->flags & EB_BUFFERFLAG_EOS)
+            encHandlePtr->eos_sent = EB_TRUE;
+    }
+    encHandlePtr->input_buffer_sent_count++;
+
+    EbPostFullObject(ebWrapperPtr);
+
+    return EB_ErrorNone;
+}
+
+/**********************************
+* Empty This Buffer, without copy
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_send_picture_zero_copy(
+    EbComponentType        *svt_enc_component,
+    EbBufferHeaderType     *p_buffer,
+    EbInputReleaseCallback  release_cb,
+    void                   *release_ctx)
+{
+    EbEncHandle_t          *encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+    SequenceControlSet_t   *sequence_control_set_ptr = encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr;
+    EbObjectWrapper_t      *ebWrapperPtr;
+    EbInputBufferHeader_t  *inputBufferPtr;
+
+    if (p_buffer == NULL || release_cb == NULL)
+        return EB_ErrorBadParameter;
+
+    // Take the buffer and put it into our internal queue structure
+    EbGetEmptyObject(
+        encHandlePtr->input_buffer_producer_fifo_ptr_array[0],
+        &ebWrapperPtr);
+    inputBufferPtr = (EbInputBufferHeader_t*)ebWrapperPtr->objectPtr;
+
+    CopyInputBufferHeader(
+        &inputBufferPtr->header,
+        p_buffer);
+
+    if (p_buffer->p_buffer != NULL && ZeroCopyFrameBuffer(
+            sequence_control_set_ptr,
+            &inputBufferPtr->zeroCopyPicture,
+            inputBufferPtr->ownPicturePtr,
+            (EbSvtEncInput*)p_buffer->p_buffer)) {
+
+        // Released by EbInputBufferHeaderRelease
+        inputBufferPtr->header.p_buffer = (uint8_t*)&inputBufferPtr->zeroCopyPicture;
+        inputBufferPtr->appBufferPtr    = p_buffer;
+        inputBufferPtr->releaseCallback = release_cb;
+        inputBufferPtr->releaseContext  = release_ctx;
+    }
+    else {
+        // Fall back to the copy
+        if (p_buffer->p_buffer != NULL)
+            CopyFrameBuffer(sequence_control_set_ptr, inputBufferPtr->header.p_buffer, p_buffer->p_buffer);
+        release_cb(release_ctx, p_buffer);
     }
 
+    if (inputBufferPtr->header.flags & EB_BUFFERFLAG_EOS)
+        encHandlePtr->eos_sent = EB_TRUE;
+    encHandlePtr->input_buffer_sent_count++;
+
     EbPostFullObject(ebWrapperPtr);
 
     return EB_ErrorNone;
 }
+
+/**********************************
+* Input Layout
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_get_input_layout(
+    EbComponentType      *svt_enc_component,
+    EbSvtInputLayout     *layout)
+{
+    EbEncHandle_t          *encHandlePtr;
+    SequenceControlSet_t   *sequence_control_set_ptr;
+
+    if (svt_enc_component == NULL || layout == NULL)
+        return EB_ErrorBadParameter;
+
+    encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+    sequence_control_set_ptr = encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr;
+
+    // Same layout as the library input buffers, see allocate_frame_buffer
+    layout->left_padding  = sequence_control_set_ptr->left_padding;
+    layout->right_padding = sequence_control_set_ptr->right_padding;
+    layout->top_padding   = sequence_control_set_ptr->top_padding;
+    layout->bot_padding   = sequence_control_set_ptr->bot_padding;
+    layout->luma_stride   = sequence_control_set_ptr->max_input_luma_width + sequence_control_set_ptr->left_padding + sequence_control_set_ptr->right_padding;
+    layout->chroma_stride = layout->luma_stride >> 1;
+    layout->alignment     = ALVALUE;
+
+    return EB_ErrorNone;
+}
 static void CopyOutputReconBuffer(
     EbBufferHeaderType   *dst,
     EbBufferHeaderType   *src
@@ -2842,10 +3510,49 @@ EB_API EbErrorType eb_svt_get_packet(
 
         packet = (EbBufferHeaderType*)ebWrapperPtr->objectPtr;
 
-        if (packet->flags != EB_BUFFERFLAG_EOS && 
-            packet->flags != EB_BUFFERFLAG_SHOW_EXT &&
-            packet->flags != (EB_BUFFERFLAG_SHOW_EXT | EB_BUFFERFLAG_EOS) &&
-            packet->flags != 0) {
+        if (packet->flags & ~(EB_BUFFERFLAG_EOS | EB_BUFFERFLAG_SHOW_EXT | EB_BUFFERFLAG_FRAME_PART | EB_BUFFERFLAG_FRAME_END)) {
+            return_error = EB_ErrorMax;
+        }
+
+        // return the output stream buffer
+        *p_buffer = packet;
+
+        // save the wrapper pointer for the release
+        (*p_buffer)->wrapper_ptr = (void*)ebWrapperPtr;
+    }
+    else {
+        return_error = EB_NoErrorEmptyQueue;
+    }
+
+    return return_error;
+}
+
+/**********************************
+* eb_svt_get_packet_timeout waits for a packet
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_get_packet_timeout(
+    EbComponentType      *svt_enc_component,
+    EbBufferHeaderType  **p_buffer,
+    uint32_t              timeout_ms)
+{
+    EbErrorType             return_error = EB_ErrorNone;
+    EbEncHandle_t          *pEncCompData = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+    EbObjectWrapper_t      *ebWrapperPtr = NULL;
+    EbBufferHeaderType     *packet;
+
+    EbGetFullObjectTimeout(
+        (pEncCompData->output_stream_buffer_consumer_fifo_ptr_dbl_array[0])[0],
+        &ebWrapperPtr,
+        timeout_ms);
+
+    if (ebWrapperPtr) {
+
+        packet = (EbBufferHeaderType*)ebWrapperPtr->objectPtr;
+
+        if (packet->flags & ~(EB_BUFFERFLAG_EOS | EB_BUFFERFLAG_SHOW_EXT | EB_BUFFERFLAG_FRAME_PART | EB_BUFFERFLAG_FRAME_END)) {
             return_error = EB_ErrorMax;
         }
 
@@ -2917,6 +3624,228 @@ EB_API EbErrorType eb_svt_get_recon(
     return return_error;
 }
 
+/**********************************
+* Encoder Reset
+**********************************/
+// The pipeline is idle once Resource Coordination has taken every input
+// buffer and no inter-process message is in flight. Resource Coordination
+// counts an input once its message is posted, and every kernel, whichever
+// way the message flows, gets its output message before releasing its input
+// one: the single count only reaches 0 when no kernel is left running.
+static EbBool eb_enc_handle_idle(EbEncHandle_t *encHandlePtr)
+{
+    ResourceCoordinationContext_t *resourceCoordinationContextPtr = (ResourceCoordinationContext_t*)encHandlePtr->resourceCoordinationContextPtr;
+
+    if (EB_ATOMIC_LOAD_ACQUIRE(&resourceCoordinationContextPtr->processedInputCount) != encHandlePtr->input_buffer_sent_count)
+        return EB_FALSE;
+
+    return EB_ATOMIC_LOAD_ACQUIRE(&encHandlePtr->message_in_flight_count) == 0 ? EB_TRUE : EB_FALSE;
+}
+
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_reset(
+    EbComponentType *svt_enc_component)
+{
+    EbEncHandle_t          *encHandlePtr;
+    SequenceControlSet_t   *sequence_control_set_ptr;
+    EbObjectWrapper_t      *ebWrapperPtr;
+    uint32_t                instanceIndex;
+
+    if (svt_enc_component == (EbComponentType*)EB_NULL)
+        return EB_ErrorBadParameter;
+
+    encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+    sequence_control_set_ptr = encHandlePtr->sequenceControlSetInstanceArray[0]->sequence_control_set_ptr;
+
+    // Close the stream so the reorder queues give back their pictures
+    if (encHandlePtr->input_buffer_sent_count && !encHandlePtr->eos_sent) {
+        EbBufferHeaderType eosBuffer;
+        EB_MEMSET(&eosBuffer, 0, sizeof(EbBufferHeaderType));
+        eosBuffer.flags = EB_BUFFERFLAG_EOS;
+        eosBuffer.pic_type = EB_INVALID_PICTURE;
+        eb_svt_enc_send_picture(svt_enc_component, &eosBuffer);
+    }
+
+    // Drain the outputs until the pipeline stops
+    while (!eb_enc_handle_idle(encHandlePtr)) {
+        ebWrapperPtr = (EbObjectWrapper_t*)EB_NULL;
+        EbGetFullObjectTimeout(
+            (encHandlePtr->output_stream_buffer_consumer_fifo_ptr_dbl_array[0])[0],
+            &ebWrapperPtr,
+            1);
+        if (ebWrapperPtr)
+            EbReleaseObject(ebWrapperPtr);
+
+        if (sequence_control_set_ptr->static_config.recon_enabled) {
+            do {
+                ebWrapperPtr = (EbObjectWrapper_t*)EB_NULL;
+                EbGetFullObjectNonBlocking(
+                    (encHandlePtr->output_recon_buffer_consumer_fifo_ptr_dbl_array[0])[0],
+                    &ebWrapperPtr);
+                if (ebWrapperPtr)
+                    EbReleaseObject(ebWrapperPtr);
+            } while (ebWrapperPtr);
+        }
+    }
+
+    // The kernels wait on empty queues, take back every object. This also
+    // returns the pictures the last stream still references.
+    EbSystemResourceReset(encHandlePtr->sequenceControlSetPoolPtr);
+    for (instanceIndex = 0; instanceIndex < encHandlePtr->encodeInstanceTotalCount; ++instanceIndex) {
+        EbSystemResourceReset(encHandlePtr->pictureParentControlSetPoolPtrArray[instanceIndex]);
+        EbSystemResourceReset(encHandlePtr->pictureControlSetPoolPtrArray[instanceIndex]);
+        EbSystemResourceReset(encHandlePtr->referencePicturePoolPtrArray[instanceIndex]);
+        EbSystemResourceReset(encHandlePtr->paReferencePicturePoolPtrArray[instanceIndex]);
+        EbSystemResourceReset(encHandlePtr->output_stream_buffer_resource_ptr_array[instanceIndex]);
+        if (encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->sequence_control_set_ptr->static_config.recon_enabled)
+            EbSystemResourceReset(encHandlePtr->output_recon_buffer_resource_ptr_array[instanceIndex]);
+
+        encode_context_reset(encHandlePtr->sequenceControlSetInstanceArray[instanceIndex]->encode_context_ptr);
+    }
+    EbSystemResourceReset(encHandlePtr->input_buffer_resource_ptr);
+    EbSystemResourceReset(encHandlePtr->resourceCoordinationResultsResourcePtr);
+    EbSystemResourceReset(encHandlePtr->pictureAnalysisResultsResourcePtr);
+    EbSystemResourceReset(encHandlePtr->pictureDecisionResultsResourcePtr);
+    EbSystemResourceReset(encHandlePtr->motionEstimationResultsResourcePtr);
+    EbSystemResourceReset(encHandlePtr->initialRateControlResultsResourcePtr);
+    EbSystemResourceReset(encHandlePtr->pictureDemuxResultsResourcePtr);
+    EbSystemResourceReset(encHandlePtr->rateControlTasksResourcePtr);
+    EbSystemResourceReset(encHandlePtr->rateControlResultsResourcePtr);
+    EbSystemResourceReset(encHandlePtr->encDecTasksResourcePtr);
+    EbSystemResourceReset(encHandlePtr->filterTasksResourcePtr);
+    EbSystemResourceReset(encHandlePtr->encDecResultsResourcePtr);
+    EbSystemResourceReset(encHandlePtr->entropyCodingResultsResourcePtr);
+
+    // Per-stream state of the kernels
+    ResourceCoordinationContextReset((ResourceCoordinationContext_t*)encHandlePtr->resourceCoordinationContextPtr);
+    PictureDecisionContextReset((PictureDecisionContext_t*)encHandlePtr->pictureDecisionContextPtr);
+    RateControlContextReset(
+        (RateControlContext_t*)encHandlePtr->rateControlContextPtr,
+        sequence_control_set_ptr->intra_period_length);
+    PacketizationContextReset((PacketizationContext_t*)encHandlePtr->packetizationContextPtr);
+
+    encHandlePtr->input_buffer_sent_count = 0;
+    encHandlePtr->eos_sent = EB_FALSE;
+
+    return EB_ErrorNone;
+}
+
+/**********************************
+* Memory usage of the encoder instance
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_get_memory_usage(
+    EbComponentType      *svt_enc_component,
+    EbSvtMemoryUsage     *usage_ptr)
+{
+    EbEncHandle_t    *encHandlePtr;
+    EbMemoryContext  *context_ptr;
+    EbMemoryMapBlock *block_ptr;
+
+    if (svt_enc_component == (EbComponentType*)EB_NULL || usage_ptr == (EbSvtMemoryUsage*)EB_NULL)
+        return EB_ErrorBadParameter;
+
+    encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+    if (encHandlePtr == (EbEncHandle_t*)EB_NULL)
+        return EB_ErrorInvalidComponent;
+
+    context_ptr = &encHandlePtr->memory_context;
+    if (context_ptr->mutex == (EbHandle)EB_NULL)
+        return EB_ErrorInvalidComponent;
+
+    EbBlockOnMutex(context_ptr->mutex);
+    usage_ptr->total_lib_memory = context_ptr->total_lib_memory;
+    usage_ptr->malloc_count = context_ptr->malloc_count;
+    usage_ptr->thread_count = context_ptr->thread_count;
+    usage_ptr->semaphore_count = context_ptr->semaphore_count;
+    usage_ptr->mutex_count = context_ptr->mutex_count;
+
+    // Where the pages of the allocations reside
+    usage_ptr->local_memory = 0;
+    usage_ptr->remote_memory = 0;
+    for (block_ptr = context_ptr->block; block_ptr != (EbMemoryMapBlock*)EB_NULL; block_ptr = block_ptr->prev) {
+        uint32_t entryIndex;
+        for (entryIndex = 0; entryIndex < block_ptr->count; ++entryIndex) {
+            EbMemoryMapEntry *entry_ptr = &block_ptr->entries[entryIndex];
+            if (entry_ptr->ptrType == EB_N_PTR || entry_ptr->ptrType == EB_A_PTR)
+                EbGetNumaResidency(entry_ptr->ptr, entry_ptr->size, encHandlePtr->numa_node_mask, &usage_ptr->local_memory, &usage_ptr->remote_memory);
+        }
+    }
+    EbReleaseMutex(context_ptr->mutex);
+
+    return EB_ErrorNone;
+}
+
+/**********************************
+* Profile of the pipeline stages, each one read from the full queue of its
+* input resource
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_get_pipeline_stats(
+    EbComponentType      *svt_enc_component,
+    EbSvtPipelineStats   *stats_ptr)
+{
+    EbEncHandle_t *encHandlePtr;
+    uint32_t       stageIndex;
+
+    if (svt_enc_component == (EbComponentType*)EB_NULL || stats_ptr == (EbSvtPipelineStats*)EB_NULL)
+        return EB_ErrorBadParameter;
+
+    encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+    if (encHandlePtr == (EbEncHandle_t*)EB_NULL || encHandlePtr->init_time == 0)
+        return EB_ErrorInvalidComponent;
+
+    {
+        const struct {
+            const char         *name;
+            EbSystemResource_t *inputResourcePtr;
+        } stages[] = {
+            { "ResourceCoordination",   encHandlePtr->input_buffer_resource_ptr },
+            { "PictureAnalysis",        encHandlePtr->resourceCoordinationResultsResourcePtr },
+            { "PictureDecision",        encHandlePtr->pictureAnalysisResultsResourcePtr },
+            { "MotionEstimation",       encHandlePtr->pictureDecisionResultsResourcePtr },
+            { "InitialRateControl",     encHandlePtr->motionEstimationResultsResourcePtr },
+            { "SourceBasedOperations",  encHandlePtr->initialRateControlResultsResourcePtr },
+            { "PictureManager",         encHandlePtr->pictureDemuxResultsResourcePtr },
+            { "RateControl",            encHandlePtr->rateControlTasksResourcePtr },
+            { "ModeDecisionConfig",     encHandlePtr->rateControlResultsResourcePtr },
+            { "EncDec",                 encHandlePtr->encDecTasksResourcePtr },
+            { "Filter",                 encHandlePtr->filterTasksResourcePtr },
+            { "EntropyCoding",          encHandlePtr->encDecResultsResourcePtr },
+            { "Packetization",          encHandlePtr->entropyCodingResultsResourcePtr }
+        };
+
+        stats_ptr->elapsed_time = EbGetMonotonicTime() - encHandlePtr->init_time;
+        stats_ptr->stage_count = sizeof(stages) / sizeof(stages[0]);
+
+        for (stageIndex = 0; stageIndex < stats_ptr->stage_count; ++stageIndex) {
+            EbSvtStageStats *stage_ptr = &stats_ptr->stage[stageIndex];
+            EbQueueStats_t   queueStats;
+
+            EbSystemResourceGetStats(stages[stageIndex].inputResourcePtr, &queueStats, &stage_ptr->thread_count);
+            stage_ptr->name = stages[stageIndex].name;
+            stage_ptr->task_count = queueStats.getCount;
+            stage_ptr->busy_time = queueStats.busyTime > queueStats.outputWaitTime ? queueStats.busyTime - queueStats.outputWaitTime : 0;
+            stage_ptr->input_wait_time = queueStats.inputWaitTime;
+            stage_ptr->output_wait_time = queueStats.outputWaitTime;
+            stage_ptr->fifo_depth = queueStats.objectCount;
+            stage_ptr->fifo_depth_max = queueStats.objectCountMax;
+            stage_ptr->fifo_depth_mean = queueStats.postCount ? (double)queueStats.objectCountSum / queueStats.postCount : 0;
+        }
+    }
+
+    stats_ptr->rate_table_hits = encHandlePtr->sequenceControlSetInstanceArray[0]->encode_context_ptr->md_rate_estimation_hit_count;
+    stats_ptr->rate_table_misses = encHandlePtr->sequenceControlSetInstanceArray[0]->encode_context_ptr->md_rate_estimation_miss_count;
+
+    return EB_ErrorNone;
+}
+
 /**********************************
 * Encoder Error Handling
 **********************************/
@@ -3034,10 +3963,12 @@ EbErrorType EbInputBufferHeaderCtor(
     EbPtr *objectDblPtr,
     EbPtr  objectInitDataPtr)
 {
-    EbBufferHeaderType* inputBuffer;
+    EbInputBufferHeader_t       *inputBufferPtr;
+    EbBufferHeaderType          *inputBuffer;
     SequenceControlSet_t        *sequence_control_set_ptr = (SequenceControlSet_t*)objectInitDataPtr;
-    EB_MALLOC(EbBufferHeaderType*, inputBuffer, sizeof(EbBufferHeaderType), EB_N_PTR);
-    *objectDblPtr = (EbPtr)inputBuffer;
+    EB_MALLOC(EbInputBufferHeader_t*, inputBufferPtr, sizeof(EbInputBufferHeader_t), EB_N_PTR);
+    *objectDblPtr = (EbPtr)inputBufferPtr;
+    inputBuffer = &inputBufferPtr->header;
     // Initialize Header
     inputBuffer->size = sizeof(EbBufferHeaderType);
 
@@ -3047,9 +3978,35 @@ EbErrorType EbInputBufferHeaderCtor(
 
     inputBuffer->p_app_private = NULL;
 
+    inputBufferPtr->ownPicturePtr   = (EbPictureBufferDesc_t*)inputBuffer->p_buffer;
+    inputBufferPtr->appBufferPtr    = NULL;
+    inputBufferPtr->releaseCallback = NULL;
+    inputBufferPtr->releaseContext  = NULL;
+
     return EB_ErrorNone;
 }
 
+/**************************************
+* EbBufferHeaderType Release
+*   Returns a zero copy input to the application and points the header
+*   back at the library picture.
+**************************************/
+void EbInputBufferHeaderRelease(
+    EbPtr  objectPtr)
+{
+    EbInputBufferHeader_t *inputBufferPtr = (EbInputBufferHeader_t*)objectPtr;
+    EbInputReleaseCallback releaseCallback = inputBufferPtr->releaseCallback;
+
+    if (releaseCallback) {
+        inputBufferPtr->header.p_buffer = (uint8_t*)inputBufferPtr->ownPicturePtr;
+        inputBufferPtr->releaseCallback = NULL;
+
+        releaseCallback(
+            inputBufferPtr->releaseContext,
+            inputBufferPtr->appBufferPtr);
+    }
+}
+
 /**************************************
 * EbBufferHeaderType Constructor
 **************************************/
@@ -3061,7 +4018,8 @@ EbErrorType EbOutputBufferHeaderCtor(
     uint32_t nStride = (uint32_t)(EB_OUTPUTSTREAMBUFFERSIZE_MACRO(config->source_width * config->source_height));  //TBC
     EbBufferHeaderType* outBufPtr;
 
-    EB_MALLOC(EbBufferHeaderType*, outBufPtr, sizeof(EbBufferHeaderType), EB_N_PTR);
+    // the frame statistics are stored right after the header
+    EB_MALLOC(EbBufferHeaderType*, outBufPtr, sizeof(EbBufferHeaderType) + (config->frame_stats ? sizeof(EbSvtFrameStats) : 0), EB_N_PTR);
     *objectDblPtr = (EbPtr)outBufPtr;
 
     // Initialize Header
@@ -3071,8 +4029,7 @@ EbErrorType EbOutputBufferHeaderCtor(
 
     outBufPtr->n_alloc_len = nStride;
     outBufPtr->p_app_private = NULL;
-
-    (void)objectInitDataPtr;
+    outBufPtr->frame_stats = NULL;
 
     return EB_ErrorNone;
 }
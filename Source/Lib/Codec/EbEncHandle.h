@@ -10,6 +10,7 @@
 #include "EbApi.h"
 #include "EbPictureBufferDesc.h"
 #include "EbSystemResourceManager.h"
+#include "EbThreadPool.h"
 #include "EbSequenceControlSet.h"
 
 #include "EbResourceCoordinationResults.h"
@@ -70,6 +71,7 @@ typedef struct EbEncHandle_s
     EbHandle                               rateControlThreadHandle;
     EbHandle                              *modeDecisionConfigurationThreadHandleArray;
     EbHandle                              *encDecThreadHandleArray;
+    EbHandle                              *filterThreadHandleArray;
     EbHandle                              *entropyCodingThreadHandleArray;
     EbHandle                               packetizationThreadHandle;
 
@@ -85,6 +87,7 @@ typedef struct EbEncHandle_s
     EbPtr                                  rateControlContextPtr;
     EbPtr                                 *modeDecisionConfigurationContextPtrArray;
     EbPtr                                 *encDecContextPtrArray;
+    EbPtr                                 *filterContextPtrArray;
     EbPtr                                 *entropyCodingContextPtrArray;
     EbPtr                                  packetizationContextPtr;
 
@@ -102,6 +105,7 @@ typedef struct EbEncHandle_s
     EbSystemResource_t                     *rateControlTasksResourcePtr;
     EbSystemResource_t                     *rateControlResultsResourcePtr;
     EbSystemResource_t                     *encDecTasksResourcePtr;
+    EbSystemResource_t                     *filterTasksResourcePtr;
     EbSystemResource_t                     *encDecResultsResourcePtr;
     EbSystemResource_t                     *entropyCodingResultsResourcePtr;
 
@@ -120,6 +124,7 @@ typedef struct EbEncHandle_s
     EbFifo_t                              **rateControlTasksProducerFifoPtrArray;
     EbFifo_t                              **rateControlResultsProducerFifoPtrArray;
     EbFifo_t                              **encDecTasksProducerFifoPtrArray;
+    EbFifo_t                              **filterTasksProducerFifoPtrArray;
     EbFifo_t                              **encDecResultsProducerFifoPtrArray;
     EbFifo_t                              **entropyCodingResultsProducerFifoPtrArray;
 
@@ -137,6 +142,7 @@ typedef struct EbEncHandle_s
     EbFifo_t                              **rateControlTasksConsumerFifoPtrArray;
     EbFifo_t                              **rateControlResultsConsumerFifoPtrArray;
     EbFifo_t                              **encDecTasksConsumerFifoPtrArray;
+    EbFifo_t                              **filterTasksConsumerFifoPtrArray;
     EbFifo_t                              **encDecResultsConsumerFifoPtrArray;
     EbFifo_t                              **entropyCodingResultsConsumerFifoPtrArray;
 
@@ -144,9 +150,25 @@ typedef struct EbEncHandle_s
     EbCallback_t                          **app_callback_ptr_array;
 
     // Memory Map
-    EbMemoryMapEntry                       *memoryMap;
-    uint32_t                                memoryMapIndex;
-    uint64_t                                totalLibMemory;
+    EbMemoryContext                         memory_context;
+
+    // Shared thread pool running the kernels, NULL with dedicated kernel threads
+    EbThreadPool_t                         *thread_pool_ptr;
+
+    // NUMA nodes the kernel threads run on
+    uint64_t                                numa_node_mask;
+
+    // Input of the current stream, see eb_svt_enc_reset
+    uint32_t                                input_buffer_sent_count;
+    EbBool                                  eos_sent;
+
+    // Inter-process messages taken and not yet released, by every kernel.
+    // A kernel gets its output message before releasing its input one.
+    uint32_t                                message_in_flight_count;
+
+    // Monotonic time the encoder was initialized at, origin of the pipeline
+    // stats. 0 before eb_init_encoder succeeds
+    uint64_t                                init_time;
 
 } EbEncHandle_t;
 
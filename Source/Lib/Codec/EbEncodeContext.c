@@ -11,6 +11,130 @@
 #include "EbCabacContextModel.h"
 #include "EbErrorCodes.h"
 
+/**************************************
+ * encode_context_reset
+ *   Returns the GOP counters, the reorder
+ *   and picture queues and the speed and
+ *   rate control state to their start of
+ *   stream values. The pipeline must be idle.
+ **************************************/
+void encode_context_reset(
+    EncodeContext_t *encode_context_ptr)
+{
+    uint32_t pictureIndex;
+
+    encode_context_ptr->total_number_of_recon_frames = 0;
+
+    // Picture Decision Reordering Queue
+    encode_context_ptr->picture_decision_reorder_queue_head_index = 0;
+    for (pictureIndex = 0; pictureIndex < PICTURE_DECISION_REORDER_QUEUE_MAX_DEPTH; ++pictureIndex) {
+        encode_context_ptr->picture_decision_reorder_queue[pictureIndex]->picture_number = pictureIndex;
+        encode_context_ptr->picture_decision_reorder_queue[pictureIndex]->parentPcsWrapperPtr = (EbObjectWrapper_t*)EB_NULL;
+    }
+
+    // Picture Manager Reordering Queue
+    encode_context_ptr->picture_manager_reorder_queue_head_index = 0;
+    for (pictureIndex = 0; pictureIndex < PICTURE_MANAGER_REORDER_QUEUE_MAX_DEPTH; ++pictureIndex) {
+        encode_context_ptr->picture_manager_reorder_queue[pictureIndex]->picture_number = pictureIndex;
+        encode_context_ptr->picture_manager_reorder_queue[pictureIndex]->parentPcsWrapperPtr = (EbObjectWrapper_t*)EB_NULL;
+    }
+
+    // Picture Manager Pre-Assignment Buffer
+    encode_context_ptr->pre_assignment_buffer_intra_count = 0;
+    encode_context_ptr->pre_assignment_buffer_idr_count = 0;
+    encode_context_ptr->pre_assignment_buffer_scene_change_count = 0;
+    encode_context_ptr->pre_assignment_buffer_scene_change_index = 0;
+    encode_context_ptr->pre_assignment_buffer_eos_flag = EB_FALSE;
+    encode_context_ptr->decode_base_number = 0;
+
+    encode_context_ptr->pre_assignment_buffer_count = 0;
+    for (pictureIndex = 0; pictureIndex < PRE_ASSIGNMENT_MAX_DEPTH; ++pictureIndex) {
+        encode_context_ptr->pre_assignment_buffer[pictureIndex] = (EbObjectWrapper_t*)EB_NULL;
+    }
+
+    // Picture Manager Input Queue
+    encode_context_ptr->input_picture_queue_head_index = 0;
+    encode_context_ptr->input_picture_queue_tail_index = 0;
+    for (pictureIndex = 0; pictureIndex < INPUT_QUEUE_MAX_DEPTH; ++pictureIndex) {
+        encode_context_ptr->input_picture_queue[pictureIndex]->inputObjectPtr = (EbObjectWrapper_t*)EB_NULL;
+        encode_context_ptr->input_picture_queue[pictureIndex]->referenceEntryIndex = 0;
+        encode_context_ptr->input_picture_queue[pictureIndex]->dependentCount = 0;
+        encode_context_ptr->input_picture_queue[pictureIndex]->list0Ptr = (ReferenceList_t*)EB_NULL;
+        encode_context_ptr->input_picture_queue[pictureIndex]->list1Ptr = (ReferenceList_t*)EB_NULL;
+    }
+
+    // Picture Manager Reference Queue
+    encode_context_ptr->reference_picture_queue_head_index = 0;
+    encode_context_ptr->reference_picture_queue_tail_index = 0;
+    for (pictureIndex = 0; pictureIndex < REFERENCE_QUEUE_MAX_DEPTH; ++pictureIndex) {
+        encode_context_ptr->reference_picture_queue[pictureIndex]->referenceObjectPtr = (EbObjectWrapper_t*)EB_NULL;
+        encode_context_ptr->reference_picture_queue[pictureIndex]->picture_number = ~0u;
+        encode_context_ptr->reference_picture_queue[pictureIndex]->dependentCount = 0;
+        encode_context_ptr->reference_picture_queue[pictureIndex]->referenceAvailable = EB_FALSE;
+    }
+
+    // Picture Decision PA Reference Queue
+    encode_context_ptr->picture_decision_pa_reference_queue_head_index = 0;
+    encode_context_ptr->picture_decision_pa_reference_queue_tail_index = 0;
+    for (pictureIndex = 0; pictureIndex < PICTURE_DECISION_PA_REFERENCE_QUEUE_MAX_DEPTH; ++pictureIndex) {
+        encode_context_ptr->picture_decision_pa_reference_queue[pictureIndex]->inputObjectPtr = (EbObjectWrapper_t*)EB_NULL;
+        encode_context_ptr->picture_decision_pa_reference_queue[pictureIndex]->picture_number = 0;
+        encode_context_ptr->picture_decision_pa_reference_queue[pictureIndex]->referenceEntryIndex = 0;
+        encode_context_ptr->picture_decision_pa_reference_queue[pictureIndex]->dependentCount = 0;
+        encode_context_ptr->picture_decision_pa_reference_queue[pictureIndex]->list0Ptr = (ReferenceList_t*)EB_NULL;
+        encode_context_ptr->picture_decision_pa_reference_queue[pictureIndex]->list1Ptr = (ReferenceList_t*)EB_NULL;
+    }
+
+    // Initial Rate Control Reordering Queue
+    encode_context_ptr->initial_rate_control_reorder_queue_head_index = 0;
+    for (pictureIndex = 0; pictureIndex < INITIAL_RATE_CONTROL_REORDER_QUEUE_MAX_DEPTH; ++pictureIndex) {
+        encode_context_ptr->initial_rate_control_reorder_queue[pictureIndex]->picture_number = pictureIndex;
+        encode_context_ptr->initial_rate_control_reorder_queue[pictureIndex]->parentPcsWrapperPtr = (EbObjectWrapper_t*)EB_NULL;
+    }
+
+    // High level Rate Control histogram Queue
+    encode_context_ptr->hl_rate_control_historgram_queue_head_index = 0;
+    for (pictureIndex = 0; pictureIndex < HIGH_LEVEL_RATE_CONTROL_HISTOGRAM_QUEUE_MAX_DEPTH; ++pictureIndex) {
+        encode_context_ptr->hl_rate_control_historgram_queue[pictureIndex]->picture_number = pictureIndex;
+        encode_context_ptr->hl_rate_control_historgram_queue[pictureIndex]->lifeCount = 0;
+        encode_context_ptr->hl_rate_control_historgram_queue[pictureIndex]->parentPcsWrapperPtr = (EbObjectWrapper_t*)EB_NULL;
+    }
+
+    // Packetization Reordering Queue
+    encode_context_ptr->packetization_reorder_queue_head_index = 0;
+    for (pictureIndex = 0; pictureIndex < PACKETIZATION_REORDER_QUEUE_MAX_DEPTH; ++pictureIndex) {
+        encode_context_ptr->packetization_reorder_queue[pictureIndex]->picture_number = pictureIndex;
+        encode_context_ptr->packetization_reorder_queue[pictureIndex]->output_stream_wrapper_ptr = (EbObjectWrapper_t*)EB_NULL;
+        encode_context_ptr->packetization_reorder_queue[pictureIndex]->outputStatisticsWrapperPtr = (EbObjectWrapper_t*)EB_NULL;
+        encode_context_ptr->packetization_reorder_queue[pictureIndex]->outMetaData = (EbLinkedListNode*)EB_NULL;
+        encode_context_ptr->packetization_reorder_queue[pictureIndex]->parent_pcs_wrapper_ptr = (EbObjectWrapper_t*)EB_NULL;
+        encode_context_ptr->packetization_reorder_queue[pictureIndex]->posted_part_count = 0;
+    }
+
+    encode_context_ptr->intra_period_position = 0;
+    encode_context_ptr->pred_struct_position = 0;
+    encode_context_ptr->current_input_poc = -1;
+    encode_context_ptr->elapsed_non_idr_count = 0;
+    encode_context_ptr->elapsed_non_cra_count = 0;
+    encode_context_ptr->initial_picture = EB_TRUE;
+
+    encode_context_ptr->last_idr_picture = 0;
+
+    // Sequence Termination Flags
+    encode_context_ptr->terminating_picture_number = ~0u;
+    encode_context_ptr->terminating_sequence_flag_received = EB_FALSE;
+
+    encode_context_ptr->sc_buffer = 0;
+    encode_context_ptr->sc_frame_in = 0;
+    encode_context_ptr->sc_frame_out = 0;
+
+    encode_context_ptr->enc_mode = SPEED_CONTROL_INIT_MOD;
+
+    encode_context_ptr->previous_selected_ref_qp = 32;
+    encode_context_ptr->max_coded_poc = 0;
+    encode_context_ptr->max_coded_poc_selected_ref_qp = 32;
+}
+
 EbErrorType encode_context_ctor(
     EbPtr *object_dbl_ptr,
     EbPtr object_init_data_ptr)
@@ -32,7 +156,6 @@ EbErrorType encode_context_ctor(
     encode_context_ptr->app_callback_ptr = (EbCallback_t*)EB_NULL;
 
     EB_CREATEMUTEX(EbHandle, encode_context_ptr->total_number_of_recon_frame_mutex, sizeof(EbHandle), EB_MUTEX);
-    encode_context_ptr->total_number_of_recon_frames = 0;
     encode_context_ptr->statistics_port_active = EB_FALSE;
     
     // Output Buffer Fifos
@@ -44,7 +167,6 @@ EbErrorType encode_context_ctor(
     encode_context_ptr->pa_reference_picture_pool_fifo_ptr = (EbFifo_t*)EB_NULL;
 
     // Picture Decision Reordering Queue
-    encode_context_ptr->picture_decision_reorder_queue_head_index = 0;
     EB_MALLOC(PictureDecisionReorderEntry_t**, encode_context_ptr->picture_decision_reorder_queue, sizeof(PictureDecisionReorderEntry_t*) * PICTURE_DECISION_REORDER_QUEUE_MAX_DEPTH, EB_N_PTR);
 
     for (pictureIndex = 0; pictureIndex < PICTURE_DECISION_REORDER_QUEUE_MAX_DEPTH; ++pictureIndex) {
@@ -57,7 +179,6 @@ EbErrorType encode_context_ctor(
     }
 
     // Picture Manager Reordering Queue
-    encode_context_ptr->picture_manager_reorder_queue_head_index = 0;
     EB_MALLOC(PictureManagerReorderEntry_t**, encode_context_ptr->picture_manager_reorder_queue, sizeof(PictureManagerReorderEntry_t*) * PICTURE_MANAGER_REORDER_QUEUE_MAX_DEPTH, EB_N_PTR);
 
     for (pictureIndex = 0; pictureIndex < PICTURE_MANAGER_REORDER_QUEUE_MAX_DEPTH; ++pictureIndex) {
@@ -70,25 +191,9 @@ EbErrorType encode_context_ctor(
     }
 
 
-    // Picture Manager Pre-Assignment Buffer
-    encode_context_ptr->pre_assignment_buffer_intra_count = 0;
-    encode_context_ptr->pre_assignment_buffer_idr_count = 0;
-    encode_context_ptr->pre_assignment_buffer_scene_change_count = 0;
-    encode_context_ptr->pre_assignment_buffer_scene_change_index = 0;
-    encode_context_ptr->pre_assignment_buffer_eos_flag = EB_FALSE;
-    encode_context_ptr->decode_base_number = 0;
-
-    encode_context_ptr->pre_assignment_buffer_count = 0;
-
     EB_MALLOC(EbObjectWrapper_t**, encode_context_ptr->pre_assignment_buffer, sizeof(EbObjectWrapper_t*) * PRE_ASSIGNMENT_MAX_DEPTH, EB_N_PTR);
 
-    for (pictureIndex = 0; pictureIndex < PRE_ASSIGNMENT_MAX_DEPTH; ++pictureIndex) {
-        encode_context_ptr->pre_assignment_buffer[pictureIndex] = (EbObjectWrapper_t*)EB_NULL;
-    }
-
     // Picture Manager Input Queue
-    encode_context_ptr->input_picture_queue_head_index = 0;
-    encode_context_ptr->input_picture_queue_tail_index = 0;
     EB_MALLOC(InputQueueEntry_t**, encode_context_ptr->input_picture_queue, sizeof(InputQueueEntry_t*) * INPUT_QUEUE_MAX_DEPTH, EB_N_PTR);
 
     for (pictureIndex = 0; pictureIndex < INPUT_QUEUE_MAX_DEPTH; ++pictureIndex) {
@@ -100,8 +205,6 @@ EbErrorType encode_context_ctor(
     }
 
     // Picture Manager Reference Queue
-    encode_context_ptr->reference_picture_queue_head_index = 0;
-    encode_context_ptr->reference_picture_queue_tail_index = 0;
     EB_MALLOC(ReferenceQueueEntry_t**, encode_context_ptr->reference_picture_queue, sizeof(ReferenceQueueEntry_t*) * REFERENCE_QUEUE_MAX_DEPTH, EB_N_PTR);
 
     for (pictureIndex = 0; pictureIndex < REFERENCE_QUEUE_MAX_DEPTH; ++pictureIndex) {
@@ -113,8 +216,6 @@ EbErrorType encode_context_ctor(
     }
 
     // Picture Decision PA Reference Queue
-    encode_context_ptr->picture_decision_pa_reference_queue_head_index = 0;
-    encode_context_ptr->picture_decision_pa_reference_queue_tail_index = 0;
     EB_MALLOC(PaReferenceQueueEntry_t**, encode_context_ptr->picture_decision_pa_reference_queue, sizeof(PaReferenceQueueEntry_t*) * PICTURE_DECISION_PA_REFERENCE_QUEUE_MAX_DEPTH, EB_N_PTR);
 
     for (pictureIndex = 0; pictureIndex < PICTURE_DECISION_PA_REFERENCE_QUEUE_MAX_DEPTH; ++pictureIndex) {
@@ -126,7 +227,6 @@ EbErrorType encode_context_ctor(
     }
 
     // Initial Rate Control Reordering Queue
-    encode_context_ptr->initial_rate_control_reorder_queue_head_index = 0;
     EB_MALLOC(InitialRateControlReorderEntry_t**, encode_context_ptr->initial_rate_control_reorder_queue, sizeof(InitialRateControlReorderEntry_t*) * INITIAL_RATE_CONTROL_REORDER_QUEUE_MAX_DEPTH, EB_N_PTR);
 
     for (pictureIndex = 0; pictureIndex < INITIAL_RATE_CONTROL_REORDER_QUEUE_MAX_DEPTH; ++pictureIndex) {
@@ -139,8 +239,6 @@ EbErrorType encode_context_ctor(
     }
 
     // High level Rate Control histogram Queue
-    encode_context_ptr->hl_rate_control_historgram_queue_head_index = 0;
-
     EB_MALLOC(HlRateControlHistogramEntry_t**, encode_context_ptr->hl_rate_control_historgram_queue, sizeof(HlRateControlHistogramEntry_t*) * HIGH_LEVEL_RATE_CONTROL_HISTOGRAM_QUEUE_MAX_DEPTH, EB_N_PTR);
 
     for (pictureIndex = 0; pictureIndex < HIGH_LEVEL_RATE_CONTROL_HISTOGRAM_QUEUE_MAX_DEPTH; ++pictureIndex) {
@@ -155,7 +253,6 @@ EbErrorType encode_context_ctor(
     EB_CREATEMUTEX(EbHandle, encode_context_ptr->hl_rate_control_historgram_queue_mutex, sizeof(EbHandle), EB_MUTEX);
 
     // Packetization Reordering Queue
-    encode_context_ptr->packetization_reorder_queue_head_index = 0;
     EB_MALLOC(PacketizationReorderEntry_t**, encode_context_ptr->packetization_reorder_queue, sizeof(PacketizationReorderEntry_t*) * PACKETIZATION_REORDER_QUEUE_MAX_DEPTH, EB_N_PTR);
 
     for (pictureIndex = 0; pictureIndex < PACKETIZATION_REORDER_QUEUE_MAX_DEPTH; ++pictureIndex) {
@@ -167,19 +264,6 @@ EbErrorType encode_context_ctor(
         }
     }
 
-    encode_context_ptr->intra_period_position = 0;
-    encode_context_ptr->pred_struct_position = 0;
-    encode_context_ptr->current_input_poc = -1;
-    encode_context_ptr->elapsed_non_idr_count = 0;
-    encode_context_ptr->elapsed_non_cra_count = 0;
-    encode_context_ptr->initial_picture = EB_TRUE;
-
-    encode_context_ptr->last_idr_picture = 0;
-
-    // Sequence Termination Flags
-    encode_context_ptr->terminating_picture_number = ~0u;
-    encode_context_ptr->terminating_sequence_flag_received = EB_FALSE;
-
     // Prediction Structure Group
     encode_context_ptr->prediction_structure_group_ptr = (PredictionStructureGroup_t*)EB_NULL;
 
@@ -192,6 +276,11 @@ EbErrorType encode_context_ctor(
     if (return_error == EB_ErrorInsufficientResources) {
         return EB_ErrorInsufficientResources;
     }
+    EB_MALLOC(MdRateEstimationContext_t*, encode_context_ptr->md_rate_estimation_cache, sizeof(MdRateEstimationContext_t) * MD_RATE_ESTIMATION_CACHE_SIZE, EB_N_PTR);
+    memset(encode_context_ptr->md_rate_estimation_cache, 0, sizeof(MdRateEstimationContext_t) * MD_RATE_ESTIMATION_CACHE_SIZE);
+    EB_CREATEMUTEX(EbHandle, encode_context_ptr->md_rate_estimation_mutex, sizeof(EbHandle), EB_MUTEX);
+    encode_context_ptr->md_rate_estimation_hit_count = 0;
+    encode_context_ptr->md_rate_estimation_miss_count = 0;
 
     // Temporal Filter
 
@@ -208,26 +297,9 @@ EbErrorType encode_context_ctor(
     encode_context_ptr->rate_control_tables_array_updated = EB_FALSE;
 
     EB_CREATEMUTEX(EbHandle, encode_context_ptr->sc_buffer_mutex, sizeof(EbHandle), EB_MUTEX);
-    encode_context_ptr->sc_buffer = 0;
-    encode_context_ptr->sc_frame_in = 0;
-    encode_context_ptr->sc_frame_out = 0;
-
-    encode_context_ptr->enc_mode = SPEED_CONTROL_INIT_MOD;
-
-    encode_context_ptr->previous_selected_ref_qp = 32;
-    encode_context_ptr->max_coded_poc = 0;
-    encode_context_ptr->max_coded_poc_selected_ref_qp = 32;
-
-    encode_context_ptr->shared_reference_mutex = EbCreateMutex();
-    if (encode_context_ptr->shared_reference_mutex == (EbHandle)EB_NULL) {
-        return EB_ErrorInsufficientResources;
-    }
-    else {
-        memoryMap[*(memoryMapIndex)].ptrType = EB_MUTEX;
-        memoryMap[(*(memoryMapIndex))++].ptr = encode_context_ptr->shared_reference_mutex;
-        *totalLibMemory += (sizeof(EbHandle));
-    }
+    EB_CREATEMUTEX(EbHandle, encode_context_ptr->shared_reference_mutex, sizeof(EbHandle), EB_MUTEX);
 
+    encode_context_reset(encode_context_ptr);
 
     return EB_ErrorNone;
 }
@@ -120,6 +120,11 @@ typedef struct EncodeContext_s
                                                      
     // MD Rate Estimation Table                      
     MdRateEstimationContext_t                        *md_rate_estimation_array;
+    // Rate tables estimated from the frame CDFs, see av1_update_md_rate_estimation
+    MdRateEstimationContext_t                        *md_rate_estimation_cache;
+    EbHandle                                          md_rate_estimation_mutex;
+    uint64_t                                          md_rate_estimation_hit_count;
+    uint64_t                                          md_rate_estimation_miss_count;
 
     // Rate Control Bit Tables
     RateControlTables_t                              *rate_control_tables_array;
@@ -156,4 +161,7 @@ typedef struct EncodeContextInitData_s {
 extern EbErrorType encode_context_ctor(
     EbPtr *object_dbl_ptr,
     EbPtr  object_init_data_ptr);
+
+extern void encode_context_reset(
+    EncodeContext_t *encode_context_ptr);
 #endif // EbEncodeContext_h
\ No newline at end of file
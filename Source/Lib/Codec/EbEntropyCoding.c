@@ -350,7 +350,14 @@ void GetTxbCtx(
 
     uint8_t sign;
 
-    if (cu_origin_y != 0) {//dcSignLevelCoeffNeighborArray->topArray[dcSignLevelCoeffTopNeighborIndex] != INVALID_NEIGHBOR_DATA){ AMIR
+    // The neighbors are reset at each tile start, INVALID_NEIGHBOR_DATA marks
+    // the blocks outside of the tile
+    const EbBool topAvailable = cu_origin_y != 0 &&
+        dcSignLevelCoeffNeighborArray->topArray[dcSignLevelCoeffTopNeighborIndex] != (uint8_t)INVALID_NEIGHBOR_DATA;
+    const EbBool leftAvailable = cu_origin_x != 0 &&
+        dcSignLevelCoeffNeighborArray->leftArray[dcSignLevelCoeffLeftNeighborIndex] != (uint8_t)INVALID_NEIGHBOR_DATA;
+
+    if (topAvailable) {
         do {
             sign = ((uint8_t)dcSignLevelCoeffNeighborArray->topArray[k + dcSignLevelCoeffTopNeighborIndex] >> COEFF_CONTEXT_BITS);
             assert(sign <= 2);
@@ -358,7 +365,7 @@ void GetTxbCtx(
         } while (++k < txb_w_unit);
     }
 
-    if (cu_origin_x != 0) {// dcSignLevelCoeffNeighborArray->leftArray[dcSignLevelCoeffLeftNeighborIndex] != INVALID_NEIGHBOR_DATA){ AMIR
+    if (leftAvailable) {
         k = 0;
         do {
             sign = ((uint8_t)dcSignLevelCoeffNeighborArray->leftArray[k + dcSignLevelCoeffLeftNeighborIndex] >> COEFF_CONTEXT_BITS);
@@ -388,7 +395,7 @@ void GetTxbCtx(
             int32_t left = 0;
 
             k = 0;
-            if (cu_origin_y != 0) {
+            if (topAvailable) {
                 do {
                     top |= (int32_t)(dcSignLevelCoeffNeighborArray->topArray[k + dcSignLevelCoeffTopNeighborIndex]);
                 } while (++k < txb_w_unit);
@@ -396,7 +403,7 @@ void GetTxbCtx(
             top &= COEFF_CONTEXT_MASK;
 
 
-            if (cu_origin_x != 0) {
+            if (leftAvailable) {
                 k = 0;
                 do {
                     left |= (int32_t)(dcSignLevelCoeffNeighborArray->leftArray[k + dcSignLevelCoeffLeftNeighborIndex]);
@@ -423,14 +430,14 @@ void GetTxbCtx(
         //const int32_t ctx_base = get_entropy_context(tx_size, a, l);
         int16_t ctx_base_left = 0;
         int16_t ctx_base_top = 0;
-        if (cu_origin_y != 0) {
+        if (topAvailable) {
             k = 0;
             do {
                 ctx_base_top += (dcSignLevelCoeffNeighborArray->topArray[k + dcSignLevelCoeffTopNeighborIndex] != 0);
             } while (++k < txb_w_unit);
         }
 
-        if (cu_origin_x != 0) {
+        if (leftAvailable) {
             k = 0;
             do {
                 ctx_base_left += (dcSignLevelCoeffNeighborArray->leftArray[k + dcSignLevelCoeffLeftNeighborIndex] != 0);
@@ -1390,8 +1397,9 @@ void av1_count_overlappable_neighbors(
     xd->mi_stride = picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr->picture_width_in_sb*(BLOCK_SIZE_64 / 4);
     const int32_t offset = mi_row * xd->mi_stride + mi_col;
     xd->mi = picture_control_set_ptr->mi_grid_base + offset;
-    xd->up_available = (mi_row > 0);
-    xd->left_available = (mi_col > 0);
+    av1_tile_init(&xd->tile, cm, mi_row, mi_col);
+    xd->up_available = (mi_row > xd->tile.mi_row_start);
+    xd->left_available = (mi_col > xd->tile.mi_col_start);
 
     if (!is_motion_variation_allowed_bsize(bsize)) return;
 
@@ -1947,7 +1955,7 @@ int32_t av1_get_pred_context_switchable_interp(
     int32_t left_type = SWITCHABLE_FILTERS;
     int32_t above_type = SWITCHABLE_FILTERS;
 
-    if (cu_origin_x != 0 /*&& interpolation_type_neighbor_array->leftArray[interpolationTypeLeftNeighborIndex] != SWITCHABLE_FILTERS*/) {
+    if (cu_origin_x != 0 && ref_frame_type_neighbor_array->leftArray[rfLeftNeighborIndex] != (uint8_t)INVALID_NEIGHBOR_DATA) {
 
         MvReferenceFrame rf_left[2];
         av1_set_ref_frame(rf_left, ref_frame_type_neighbor_array->leftArray[rfLeftNeighborIndex]);
@@ -1958,7 +1966,7 @@ int32_t av1_get_pred_context_switchable_interp(
 
 
 
-    if (cu_origin_y != 0 /*&& interpolation_type_neighbor_array->topArray[interpolationTypeTopNeighborIndex] != SWITCHABLE_FILTERS*/) {
+    if (cu_origin_y != 0 && ref_frame_type_neighbor_array->topArray[rfTopNeighborIndex] != (uint8_t)INVALID_NEIGHBOR_DATA) {
         MvReferenceFrame rf_above[2];
         av1_set_ref_frame(rf_above, ref_frame_type_neighbor_array->topArray[rfTopNeighborIndex]);
         uint32_t aboveNeigh = (uint32_t)interpolation_type_neighbor_array->topArray[interpolationTypeTopNeighborIndex];
@@ -2934,9 +2942,6 @@ static void write_tile_info_max_tile(const PictureParentControlSet_t *const pcsP
 
     if (pcsPtr->uniform_tile_spacing_flag) {
 
-        //CHKN: no tiles
-        cm->log2_tile_cols = cm->min_log2_tile_cols;
-
         // Uniform spaced tiles with power-of-two number of rows and columns
         // tile columns
         int32_t ones = cm->log2_tile_cols - cm->min_log2_tile_cols;
@@ -2948,9 +2953,6 @@ static void write_tile_info_max_tile(const PictureParentControlSet_t *const pcsP
         }
 
         // rows
-        //CHKN: no tiles
-        cm->log2_tile_rows = cm->min_log2_tile_rows;
-
         ones = cm->log2_tile_rows - cm->min_log2_tile_rows;
         while (ones--) {
             aom_wb_write_bit(wb, 1);
@@ -2992,7 +2994,7 @@ static int32_t tile_log2(int32_t blk_size, int32_t target) {
     }
     return k;
 }
-void av1_get_tile_limits(PictureParentControlSet_t * pcsPtr) {
+static void av1_get_tile_limits(PictureParentControlSet_t * pcsPtr) {
 
     Av1Common * cm = pcsPtr->av1_cm;
 
@@ -3008,18 +3010,67 @@ void av1_get_tile_limits(PictureParentControlSet_t * pcsPtr) {
     cm->min_log2_tile_cols = tile_log2(cm->max_tile_width_sb, sb_cols);
     cm->max_log2_tile_cols = tile_log2(1, AOMMIN(sb_cols, MAX_TILE_COLS));
     cm->max_log2_tile_rows = tile_log2(1, AOMMIN(sb_rows, MAX_TILE_ROWS));
-    cm->min_log2_tile_rows = 0; // CHKN Tiles 
     cm->min_log2_tiles = tile_log2(max_tile_area_sb, sb_cols * sb_rows);
     cm->min_log2_tiles = AOMMAX(cm->min_log2_tiles, cm->min_log2_tile_cols);
 }
 
+/*********************************************************************
+* av1_set_tile_info
+*   Derives the uniformly spaced tile grid of the picture from the
+*   requested log2 number of tile columns and rows
+*********************************************************************/
+void av1_set_tile_info(PictureParentControlSet_t * pcsPtr) {
+
+    SequenceControlSet_t *scsPtr = pcsPtr->sequence_control_set_ptr;
+    Av1Common * cm = pcsPtr->av1_cm;
+    int32_t i, start_sb, size_sb;
+
+    av1_get_tile_limits(pcsPtr);
+
+    int32_t mi_cols = ALIGN_POWER_OF_TWO(cm->mi_cols, scsPtr->mib_size_log2);
+    int32_t mi_rows = ALIGN_POWER_OF_TWO(cm->mi_rows, scsPtr->mib_size_log2);
+    int32_t sb_cols = mi_cols >> scsPtr->mib_size_log2;
+    int32_t sb_rows = mi_rows >> scsPtr->mib_size_log2;
+
+    cm->mib_size_log2 = scsPtr->mib_size_log2;
+    cm->uniform_tile_spacing_flag = pcsPtr->uniform_tile_spacing_flag;
+
+    // Tile columns
+    cm->log2_tile_cols = CLIP3(cm->min_log2_tile_cols, cm->max_log2_tile_cols, (int32_t)scsPtr->static_config.tile_columns);
+    size_sb = ALIGN_POWER_OF_TWO(sb_cols, cm->log2_tile_cols) >> cm->log2_tile_cols;
+    for (i = 0, start_sb = 0; start_sb < sb_cols; i++) {
+        cm->tile_col_start_sb[i] = start_sb;
+        start_sb += size_sb;
+    }
+    cm->tile_cols = i;
+    cm->tile_col_start_sb[i] = sb_cols;
+    cm->tile_width = size_sb << cm->mib_size_log2;
+    cm->tile_width = AOMMIN(cm->tile_width, cm->mi_cols);
+
+    // Tile rows
+    cm->min_log2_tile_rows = AOMMAX(cm->min_log2_tiles - cm->log2_tile_cols, 0);
+    cm->max_tile_height_sb = sb_rows >> cm->min_log2_tile_rows;
+    cm->log2_tile_rows = CLIP3(cm->min_log2_tile_rows, cm->max_log2_tile_rows, (int32_t)scsPtr->static_config.tile_rows);
+    size_sb = ALIGN_POWER_OF_TWO(sb_rows, cm->log2_tile_rows) >> cm->log2_tile_rows;
+    for (i = 0, start_sb = 0; start_sb < sb_rows; i++) {
+        cm->tile_row_start_sb[i] = start_sb;
+        start_sb += size_sb;
+    }
+    cm->tile_rows = i;
+    cm->tile_row_start_sb[i] = sb_rows;
+    cm->tile_height = size_sb << cm->mib_size_log2;
+    cm->tile_height = AOMMIN(cm->tile_height, cm->mi_rows);
+
+    // Refined by the packetization once the tile sizes are known
+    cm->tile_size_bytes = 4;
+}
+
 
 
 static void write_tile_info(const PictureParentControlSet_t *const pcsPtr,
     //struct aom_write_bit_buffer *saved_wb,
     struct aom_write_bit_buffer *wb) {
 
-    av1_get_tile_limits((PictureParentControlSet_t *)pcsPtr);
 #if AV1_UPGRADE
     write_tile_info_max_tile(pcsPtr, wb);
 #else
@@ -3070,10 +3121,12 @@ static void write_tile_info(const PictureParentControlSet_t *const pcsPtr,
 #if !AV1_UPGRADE
     }
 #endif
-    //if (cm->tile_rows * cm->tile_cols > 1) {
-    //    // Number of bytes in tile size - 1
-    //    aom_wb_write_literal(wb, 3, 2);
-    //}
+    if (pcsPtr->av1_cm->tile_rows * pcsPtr->av1_cm->tile_cols > 1) {
+        // context_update_tile_id
+        aom_wb_write_literal(wb, 0, pcsPtr->av1_cm->log2_tile_cols + pcsPtr->av1_cm->log2_tile_rows);
+        // Number of bytes in tile size - 1
+        aom_wb_write_literal(wb, pcsPtr->av1_cm->tile_size_bytes - 1, 2);
+    }
 }
 
 static void write_frame_size(PictureParentControlSet_t *pcsPtr,
@@ -3622,8 +3675,9 @@ static void WriteGlobalMotion(
 {
     int32_t frame;
     for (frame = LAST_FRAME; frame <= ALTREF_FRAME; ++frame) {
-        const EbWarpedMotionParams *ref_params = &default_warp_params;
-        //pcsPtr->prev_frame ? &pcsPtr->prev_frame->global_motion[frame] : &default_warp_params;
+        // With a primary reference frame, the global motion is coded against the one it kept
+        const EbWarpedMotionParams *ref_params = pcsPtr->primary_ref_frame != PRIMARY_REF_NONE ?
+            &pcsPtr->prev_global_motion[frame] : &default_warp_params;
 
         write_global_motion_params(&pcsPtr->global_motion[frame], ref_params, wb,
             pcsPtr->allow_high_precision_mv);
@@ -4411,6 +4465,20 @@ EbErrorType WriteFrameHeaderAv1(
     int32_t currDataSize = 0;
 
     const uint8_t obuExtensionHeader = 0;
+    const uint16_t tileCount = showExisting ? 1 : (uint16_t)(parentPcsPtr->av1_cm->tile_cols * parentPcsPtr->av1_cm->tile_rows);
+    uint16_t tileIdx;
+
+    if (tileCount > 1) {
+        // tile_size_bytes is signaled in the frame header: use the fewest
+        // bytes holding the size of every tile but the last one
+        uint32_t maxTileSize = 0;
+        for (tileIdx = 0; tileIdx < tileCount - 1; ++tileIdx)
+            maxTileSize = MAX(maxTileSize, pcsPtr->entropy_coder_ptr_array[tileIdx]->ecWriter.pos - 1);
+        parentPcsPtr->av1_cm->tile_size_bytes =
+            maxTileSize < (1 << 8) ? 1 :
+            maxTileSize < (1 << 16) ? 2 :
+            maxTileSize < (1 << 24) ? 3 : 4;
+    }
 
     // A new tile group begins at this tile.  Write the obu header and
     // tile group header
@@ -4428,14 +4496,111 @@ EbErrorType WriteFrameHeaderAv1(
     //    n_log2_tiles, cm->num_tg > 1);
 
     if (!showExisting) {
-        // Add data from EC stream to Picture Stream.
-        int32_t frameSize = pcsPtr->entropy_coder_ptr->ecWriter.pos;
-        OutputBitstreamUnit_t *ecOutputBitstreamPtr = (OutputBitstreamUnit_t*)pcsPtr->entropy_coder_ptr->ecOutputBitstreamPtr;
-        //****************************************************************//
-        // Copy from EC stream to frame stream
-        memcpy(data + currDataSize, ecOutputBitstreamPtr->bufferBeginAv1, frameSize);
-        currDataSize += (frameSize);
+        // Tile group header: tile_start_and_end_present_flag = 0, byte aligned
+        if (tileCount > 1)
+            data[currDataSize++] = 0;
+
+        // Add data from the EC streams to Picture Stream, in raster tile order.
+        for (tileIdx = 0; tileIdx < tileCount; ++tileIdx) {
+            EntropyCoder_t *entropy_coder_ptr = pcsPtr->entropy_coder_ptr_array[tileIdx];
+            int32_t tileSize = entropy_coder_ptr->ecWriter.pos;
+            OutputBitstreamUnit_t *ecOutputBitstreamPtr = (OutputBitstreamUnit_t*)entropy_coder_ptr->ecOutputBitstreamPtr;
+
+            // tile_size_minus_1, little endian, for all the tiles but the last one
+            if (tileIdx < tileCount - 1) {
+                int32_t byteIdx;
+                for (byteIdx = 0; byteIdx < parentPcsPtr->av1_cm->tile_size_bytes; ++byteIdx)
+                    data[currDataSize++] = (uint8_t)((tileSize - 1) >> (8 * byteIdx));
+            }
+            //****************************************************************//
+            // Copy from EC stream to frame stream
+            memcpy(data + currDataSize, ecOutputBitstreamPtr->bufferBeginAv1, tileSize);
+            currDataSize += (tileSize);
+        }
+    }
+    const uint32_t obuPayloadSize = currDataSize - obuHeaderSize;
+    const size_t lengthFieldSize =
+        ObuMemMove(obuHeaderSize, obuPayloadSize, data);
+    if (WriteUlebObuSize(obuHeaderSize, obuPayloadSize, data) !=
+        AOM_CODEC_OK) {
+        assert(0);
+    }
+    currDataSize += (int32_t)lengthFieldSize;
+    data += currDataSize;
+
+    outputBitstreamPtr->bufferAv1 = data;
+    return return_error;
+}
+
+/**************************************************
+* WriteFrameHeaderObuAv1
+*   Tile group output: the frame header in its own
+*   OBU, the tiles follow in tile group OBUs
+**************************************************/
+EbErrorType WriteFrameHeaderObuAv1(
+    Bitstream_t *bitstreamPtr,
+    SequenceControlSet_t *scsPtr,
+    PictureControlSet_t *pcsPtr)
+{
+    EbErrorType                 return_error = EB_ErrorNone;
+    OutputBitstreamUnit_t       *outputBitstreamPtr = (OutputBitstreamUnit_t*)bitstreamPtr->outputBitstreamPtr;
+    uint8_t                     *data = outputBitstreamPtr->bufferAv1;
+    uint32_t                    obuHeaderSize = 0;
+    uint32_t                    obuPayloadSize = 0;
+
+    obuHeaderSize = WriteObuHeader(OBU_FRAME_HEADER, 0, data);
+
+    // Each tile group holds a single tile, the tile_size_bytes of the header is not used
+    obuPayloadSize = WriteFrameHeaderObu(scsPtr, pcsPtr->parent_pcs_ptr, data + obuHeaderSize, 0, 1);
+
+    const size_t lengthFieldSize = ObuMemMove(obuHeaderSize, obuPayloadSize, data);
+    if (WriteUlebObuSize(obuHeaderSize, obuPayloadSize, data) !=
+        AOM_CODEC_OK) {
+        assert(0);
+    }
+    data += obuHeaderSize + obuPayloadSize + lengthFieldSize;
+
+    outputBitstreamPtr->bufferAv1 = data;
+    return return_error;
+}
+
+/**************************************************
+* WriteTileGroupObuAv1
+*   Tile group output: one tile in a tile group OBU
+**************************************************/
+EbErrorType WriteTileGroupObuAv1(
+    Bitstream_t *bitstreamPtr,
+    PictureControlSet_t *pcsPtr,
+    uint16_t tileIdx)
+{
+    EbErrorType                 return_error = EB_ErrorNone;
+    OutputBitstreamUnit_t       *outputBitstreamPtr = (OutputBitstreamUnit_t*)bitstreamPtr->outputBitstreamPtr;
+    Av1Common                   *cm = pcsPtr->parent_pcs_ptr->av1_cm;
+    EntropyCoder_t              *entropy_coder_ptr = pcsPtr->entropy_coder_ptr_array[tileIdx];
+    OutputBitstreamUnit_t       *ecOutputBitstreamPtr = (OutputBitstreamUnit_t*)entropy_coder_ptr->ecOutputBitstreamPtr;
+    uint8_t                     *data = outputBitstreamPtr->bufferAv1;
+    uint32_t                    obuHeaderSize = 0;
+    int32_t                     currDataSize = 0;
+    const int32_t               tileSize = entropy_coder_ptr->ecWriter.pos;
+
+    currDataSize = WriteObuHeader(OBU_TILE_GROUP, 0, data);
+    obuHeaderSize = currDataSize;
+
+    // Tile group header: tile_start_and_end_present_flag = 1, tg_start = tg_end = tileIdx, byte aligned
+    if (cm->tile_cols * cm->tile_rows > 1) {
+        struct aom_write_bit_buffer wb = { data + currDataSize, 0 };
+        const int32_t tileBits = cm->log2_tile_cols + cm->log2_tile_rows;
+
+        aom_wb_write_bit(&wb, 1);
+        aom_wb_write_literal(&wb, tileIdx, tileBits);
+        aom_wb_write_literal(&wb, tileIdx, tileBits);
+        currDataSize += aom_wb_bytes_written(&wb);
     }
+
+    // The last tile of a tile group has no size field
+    memcpy(data + currDataSize, ecOutputBitstreamPtr->bufferBeginAv1, tileSize);
+    currDataSize += tileSize;
+
     const uint32_t obuPayloadSize = currDataSize - obuHeaderSize;
     const size_t lengthFieldSize =
         ObuMemMove(obuHeaderSize, obuPayloadSize, data);
@@ -4544,6 +4709,7 @@ static void Av1writeDeltaQindex(
 static void write_cdef(
     SequenceControlSet_t     *seqCSetPtr,
     PictureControlSet_t     *p_pcs_ptr,
+    EntropyCodingContext_t  *context_ptr,
     //Av1Common *cm,
     MacroBlockD *const xd,
     aom_writer *w,
@@ -4571,8 +4737,8 @@ static void write_cdef(
 // Initialise when at top left part of the superblock
     if (!(mi_row & (seqCSetPtr->mib_size - 1)) &&
         !(mi_col & (seqCSetPtr->mib_size - 1))) {  // Top left?
-        p_pcs_ptr->cdef_preset[0] = p_pcs_ptr->cdef_preset[1] = p_pcs_ptr->cdef_preset[2] =
-            p_pcs_ptr->cdef_preset[3] = -1;
+        context_ptr->cdef_preset[0] = context_ptr->cdef_preset[1] = context_ptr->cdef_preset[2] =
+            context_ptr->cdef_preset[3] = -1;
     }
 
     // Emit CDEF param at first non-skip coding block
@@ -4581,9 +4747,9 @@ static void write_cdef(
         ? !!(mi_col & mask) + 2 * !!(mi_row & mask)
         : 0;
 
-    if (p_pcs_ptr->cdef_preset[index] == -1 && !skip) {
+    if (context_ptr->cdef_preset[index] == -1 && !skip) {
         aom_write_literal(w, mi->mbmi.cdef_strength, p_pcs_ptr->parent_pcs_ptr->cdef_bits);
-        p_pcs_ptr->cdef_preset[index] = mi->mbmi.cdef_strength;
+        context_ptr->cdef_preset[index] = mi->mbmi.cdef_strength;
 
 
     }
@@ -4591,10 +4757,10 @@ static void write_cdef(
 }
 
 
-void av1_reset_loop_restoration(PictureControlSet_t     *piCSetPtr) {
+void av1_reset_loop_restoration(EntropyCodingContext_t *context_ptr) {
     for (int32_t p = 0; p < 3; ++p) {
-        set_default_wiener(piCSetPtr->wiener_info + p);
-        set_default_sgrproj(piCSetPtr->sgrproj_info + p);
+        set_default_wiener(context_ptr->wiener_info + p);
+        set_default_sgrproj(context_ptr->sgrproj_info + p);
     }
 }
 static void write_wiener_filter(int32_t wiener_win, const WienerInfo *wiener_info,
@@ -4672,7 +4838,7 @@ static void write_sgrproj_filter(const SgrprojInfo *sgrproj_info,
 
     memcpy(ref_sgrproj_info, sgrproj_info, sizeof(*sgrproj_info));
 }
-static void loop_restoration_write_sb_coeffs(PictureControlSet_t     *piCSetPtr, FRAME_CONTEXT           *frameContext, const Av1Common *const cm,
+static void loop_restoration_write_sb_coeffs(EntropyCodingContext_t *context_ptr, FRAME_CONTEXT           *frameContext, const Av1Common *const cm,
     //MacroBlockD *xd,
     const RestorationUnitInfo *rui,
     aom_writer *const w, int32_t plane/*,
@@ -4686,8 +4852,8 @@ static void loop_restoration_write_sb_coeffs(PictureControlSet_t     *piCSetPtr,
 //    assert(!cm->all_lossless);
 
     const int32_t wiener_win = (plane > 0) ? WIENER_WIN_CHROMA : WIENER_WIN;
-    WienerInfo *wiener_info = piCSetPtr->wiener_info + plane;
-    SgrprojInfo *sgrproj_info = piCSetPtr->sgrproj_info + plane;
+    WienerInfo *wiener_info = context_ptr->wiener_info + plane;
+    SgrprojInfo *sgrproj_info = context_ptr->sgrproj_info + plane;
     RestorationType unit_rtype = rui->restoration_type;
 
 
@@ -4748,18 +4914,19 @@ EbErrorType ec_update_neighbors(
     BlockSize                bsize,
     EbPictureBufferDesc_t   *coeffPtr)
 {
+    UNUSED(picture_control_set_ptr);
     UNUSED(coeffPtr);
     EbErrorType return_error = EB_ErrorNone;
-    NeighborArrayUnit_t     *mode_type_neighbor_array = picture_control_set_ptr->mode_type_neighbor_array;
-    NeighborArrayUnit_t     *partition_context_neighbor_array = picture_control_set_ptr->partition_context_neighbor_array;
-    NeighborArrayUnit_t     *skip_flag_neighbor_array = picture_control_set_ptr->skip_flag_neighbor_array;
-    NeighborArrayUnit_t     *skip_coeff_neighbor_array = picture_control_set_ptr->skip_coeff_neighbor_array;
-    NeighborArrayUnit_t     *luma_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->luma_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit_t     *cr_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->cr_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit_t     *cb_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->cb_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit_t     *inter_pred_dir_neighbor_array = picture_control_set_ptr->inter_pred_dir_neighbor_array;
-    NeighborArrayUnit_t     *ref_frame_type_neighbor_array = picture_control_set_ptr->ref_frame_type_neighbor_array;
-    NeighborArrayUnit32_t   *interpolation_type_neighbor_array = picture_control_set_ptr->interpolation_type_neighbor_array;
+    NeighborArrayUnit_t     *mode_type_neighbor_array = context_ptr->mode_type_neighbor_array;
+    NeighborArrayUnit_t     *partition_context_neighbor_array = context_ptr->partition_context_neighbor_array;
+    NeighborArrayUnit_t     *skip_flag_neighbor_array = context_ptr->skip_flag_neighbor_array;
+    NeighborArrayUnit_t     *skip_coeff_neighbor_array = context_ptr->skip_coeff_neighbor_array;
+    NeighborArrayUnit_t     *luma_dc_sign_level_coeff_neighbor_array = context_ptr->luma_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit_t     *cr_dc_sign_level_coeff_neighbor_array = context_ptr->cr_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit_t     *cb_dc_sign_level_coeff_neighbor_array = context_ptr->cb_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit_t     *inter_pred_dir_neighbor_array = context_ptr->inter_pred_dir_neighbor_array;
+    NeighborArrayUnit_t     *ref_frame_type_neighbor_array = context_ptr->ref_frame_type_neighbor_array;
+    NeighborArrayUnit32_t   *interpolation_type_neighbor_array = context_ptr->interpolation_type_neighbor_array;
     const BlockGeom         *blk_geom = Get_blk_geom_mds(cu_ptr->mds_idx);
     EbBool                   skipCoeff = EB_FALSE;
     PartitionContext         partition;
@@ -4914,16 +5081,16 @@ EbErrorType write_modes_b(
     aom_writer              *ecWriter = &entropy_coder_ptr->ecWriter;
     SequenceControlSet_t     *sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->objectPtr;
 
-    NeighborArrayUnit_t     *mode_type_neighbor_array = picture_control_set_ptr->mode_type_neighbor_array;
-    NeighborArrayUnit_t     *intra_luma_mode_neighbor_array = picture_control_set_ptr->intra_luma_mode_neighbor_array;
-    NeighborArrayUnit_t     *skip_flag_neighbor_array = picture_control_set_ptr->skip_flag_neighbor_array;
-    NeighborArrayUnit_t     *skip_coeff_neighbor_array = picture_control_set_ptr->skip_coeff_neighbor_array;
-    NeighborArrayUnit_t     *luma_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->luma_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit_t     *cr_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->cr_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit_t     *cb_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->cb_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit_t     *inter_pred_dir_neighbor_array = picture_control_set_ptr->inter_pred_dir_neighbor_array;
-    NeighborArrayUnit_t     *ref_frame_type_neighbor_array = picture_control_set_ptr->ref_frame_type_neighbor_array;
-    NeighborArrayUnit32_t   *interpolation_type_neighbor_array = picture_control_set_ptr->interpolation_type_neighbor_array;
+    NeighborArrayUnit_t     *mode_type_neighbor_array = context_ptr->mode_type_neighbor_array;
+    NeighborArrayUnit_t     *intra_luma_mode_neighbor_array = context_ptr->intra_luma_mode_neighbor_array;
+    NeighborArrayUnit_t     *skip_flag_neighbor_array = context_ptr->skip_flag_neighbor_array;
+    NeighborArrayUnit_t     *skip_coeff_neighbor_array = context_ptr->skip_coeff_neighbor_array;
+    NeighborArrayUnit_t     *luma_dc_sign_level_coeff_neighbor_array = context_ptr->luma_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit_t     *cr_dc_sign_level_coeff_neighbor_array = context_ptr->cr_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit_t     *cb_dc_sign_level_coeff_neighbor_array = context_ptr->cb_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit_t     *inter_pred_dir_neighbor_array = context_ptr->inter_pred_dir_neighbor_array;
+    NeighborArrayUnit_t     *ref_frame_type_neighbor_array = context_ptr->ref_frame_type_neighbor_array;
+    NeighborArrayUnit32_t   *interpolation_type_neighbor_array = context_ptr->interpolation_type_neighbor_array;
 
     const BlockGeom          *blk_geom = Get_blk_geom_mds(cu_ptr->mds_idx);
     uint32_t blkOriginX = context_ptr->sb_origin_x + blk_geom->origin_x;
@@ -4945,6 +5112,7 @@ EbErrorType write_modes_b(
         write_cdef(
             sequence_control_set_ptr,
             picture_control_set_ptr,
+            context_ptr,
             cu_ptr->av1xd,
             ecWriter,
             skipCoeff,
@@ -5065,6 +5233,7 @@ EbErrorType write_modes_b(
         write_cdef(
             sequence_control_set_ptr,
             picture_control_set_ptr, /*cm,*/
+            context_ptr,
             cu_ptr->av1xd,
             ecWriter,
             cu_ptr->skip_flag ? 1 : skipCoeff,
@@ -5364,7 +5533,7 @@ EB_EXTERN EbErrorType write_sb(
     FRAME_CONTEXT           *frameContext = entropy_coder_ptr->fc;
     aom_writer              *ecWriter = &entropy_coder_ptr->ecWriter;
     SequenceControlSet_t     *sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->objectPtr;
-    NeighborArrayUnit_t     *partition_context_neighbor_array = picture_control_set_ptr->partition_context_neighbor_array;
+    NeighborArrayUnit_t     *partition_context_neighbor_array = context_ptr->partition_context_neighbor_array;
 
     // CU Varaiables
     const BlockGeom          *blk_geom;
@@ -5383,10 +5552,6 @@ EB_EXTERN EbErrorType write_sb(
 
     SbGeom_t * sb_geom = &sequence_control_set_ptr->sb_geom[tbPtr->index];// .block_is_inside_md_scan[blk_index])
 
-
-    if (context_ptr->sb_origin_x == 0 && context_ptr->sb_origin_y == 0)
-
-        av1_reset_loop_restoration(picture_control_set_ptr);
     if (!(sb_geom->is_complete_sb)) {
 
         checkCuOutOfBound = EB_TRUE;
@@ -5433,7 +5598,7 @@ EB_EXTERN EbErrorType write_sb(
                                 const int32_t runit_idx = tile_tl_idx + rcol + rrow * rstride;
                                 const RestorationUnitInfo *rui =
                                     &cm->rst_info[plane].unit_info[runit_idx];
-                                loop_restoration_write_sb_coeffs(picture_control_set_ptr, frameContext, cm, /*xd,*/ rui, ecWriter, plane);
+                                loop_restoration_write_sb_coeffs(context_ptr, frameContext, cm, /*xd,*/ rui, ecWriter, plane);
                             }
                         }
                     }
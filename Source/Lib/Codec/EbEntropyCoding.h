@@ -59,6 +59,8 @@ extern "C" {
         EntropyCoder_t          *entropy_coder_ptr,
         EbPictureBufferDesc_t   *coeffPtr);
 
+    extern void av1_reset_loop_restoration(
+        struct EntropyCodingContext_s   *context_ptr);
 
     extern EbErrorType EncodeSliceFinish(
         EntropyCoder_t        *entropy_coder_ptr);
@@ -294,11 +296,22 @@ extern "C" {
     extern int32_t av1_get_pred_context_single_ref_p6(const MacroBlockD *xd);
 
 
+    extern void av1_set_tile_info(
+        PictureParentControlSet_t *pcsPtr);
+
     extern EbErrorType WriteFrameHeaderAv1(
         Bitstream_t *bitstreamPtr,
         SequenceControlSet_t *scsPtr,
         PictureControlSet_t *pcsPtr,
         uint8_t showExisting);
+    extern EbErrorType WriteFrameHeaderObuAv1(
+        Bitstream_t *bitstreamPtr,
+        SequenceControlSet_t *scsPtr,
+        PictureControlSet_t *pcsPtr);
+    extern EbErrorType WriteTileGroupObuAv1(
+        Bitstream_t *bitstreamPtr,
+        PictureControlSet_t *pcsPtr,
+        uint16_t tileIdx);
     extern EbErrorType EncodeTDAv1(
         Bitstream_t *bitstreamPtr);
     extern EbErrorType EncodeSPSAv1(
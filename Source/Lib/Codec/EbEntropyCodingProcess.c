@@ -20,6 +20,7 @@
 #include "EbEncDecResults.h"
 #include "EbEntropyCodingResults.h"
 #include "EbRateControlTasks.h"
+#include "EbReferenceObject.h"
 /******************************************************
  * Enc Dec Context Constructor
  ******************************************************/
@@ -28,8 +29,13 @@ EbErrorType entropy_coding_context_ctor(
     EbFifo_t                *enc_dec_input_fifo_ptr,
     EbFifo_t                *packetization_output_fifo_ptr,
     EbFifo_t                *rate_control_output_fifo_ptr,
-    EbBool                  is16bit)
+    EbBool                  is16bit,
+    uint32_t                max_input_luma_width,
+    uint32_t                max_input_luma_height)
 {
+    const uint32_t neighborArrayWidth = NEIGHBOR_ARRAY_SIZE(max_input_luma_width);
+    const uint32_t neighborArrayHeight = NEIGHBOR_ARRAY_SIZE(max_input_luma_height);
+    EbErrorType return_error = EB_ErrorNone;
     EntropyCodingContext_t *context_ptr;
     EB_MALLOC(EntropyCodingContext_t*, context_ptr, sizeof(EntropyCodingContext_t), EB_N_PTR);
     *context_dbl_ptr = context_ptr;
@@ -41,29 +47,155 @@ EbErrorType entropy_coding_context_ctor(
     context_ptr->entropy_coding_output_fifo_ptr = packetization_output_fifo_ptr;
     context_ptr->rate_control_output_fifo_ptr = rate_control_output_fifo_ptr;
 
+    // Entropy Coding Neighbor Arrays
+    return_error = NeighborArrayUnitCtor(
+        &context_ptr->mode_type_neighbor_array,
+        neighborArrayWidth,
+        neighborArrayHeight,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+    return_error = NeighborArrayUnitCtor(
+        &context_ptr->partition_context_neighbor_array,
+        neighborArrayWidth,
+        neighborArrayHeight,
+        sizeof(struct PartitionContext),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+    return_error = NeighborArrayUnitCtor(
+        &context_ptr->skip_flag_neighbor_array,
+        neighborArrayWidth,
+        neighborArrayHeight,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+    return_error = NeighborArrayUnitCtor(
+        &context_ptr->skip_coeff_neighbor_array,
+        neighborArrayWidth,
+        neighborArrayHeight,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+    // for each 4x4
+    return_error = NeighborArrayUnitCtor(
+        &context_ptr->luma_dc_sign_level_coeff_neighbor_array,
+        neighborArrayWidth,
+        neighborArrayHeight,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+    // for each 4x4
+    return_error = NeighborArrayUnitCtor(
+        &context_ptr->cr_dc_sign_level_coeff_neighbor_array,
+        neighborArrayWidth,
+        neighborArrayHeight,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+    // for each 4x4
+    return_error = NeighborArrayUnitCtor(
+        &context_ptr->cb_dc_sign_level_coeff_neighbor_array,
+        neighborArrayWidth,
+        neighborArrayHeight,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+    return_error = NeighborArrayUnitCtor(
+        &context_ptr->inter_pred_dir_neighbor_array,
+        neighborArrayWidth,
+        neighborArrayHeight,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+    return_error = NeighborArrayUnitCtor(
+        &context_ptr->ref_frame_type_neighbor_array,
+        neighborArrayWidth,
+        neighborArrayHeight,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+    return_error = NeighborArrayUnitCtor32(
+        &context_ptr->interpolation_type_neighbor_array,
+        neighborArrayWidth,
+        neighborArrayHeight,
+        sizeof(uint32_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+    return_error = NeighborArrayUnitCtor(
+        &context_ptr->intra_luma_mode_neighbor_array,
+        neighborArrayWidth,
+        neighborArrayHeight,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
     return EB_ErrorNone;
 }
 
 /***********************************************
  * Entropy Coding Reset Neighbor Arrays
  ***********************************************/
-static void EntropyCodingResetNeighborArrays(PictureControlSet_t *picture_control_set_ptr)
+static void EntropyCodingResetNeighborArrays(EntropyCodingContext_t *context_ptr)
 {
-    NeighborArrayUnitReset(picture_control_set_ptr->mode_type_neighbor_array);
+    NeighborArrayUnitReset(context_ptr->mode_type_neighbor_array);
 
-    NeighborArrayUnitReset(picture_control_set_ptr->partition_context_neighbor_array);
+    NeighborArrayUnitReset(context_ptr->partition_context_neighbor_array);
 
-    NeighborArrayUnitReset(picture_control_set_ptr->skip_flag_neighbor_array);
+    NeighborArrayUnitReset(context_ptr->skip_flag_neighbor_array);
 
-    NeighborArrayUnitReset(picture_control_set_ptr->skip_coeff_neighbor_array);
-    NeighborArrayUnitReset(picture_control_set_ptr->luma_dc_sign_level_coeff_neighbor_array);
-    NeighborArrayUnitReset(picture_control_set_ptr->cb_dc_sign_level_coeff_neighbor_array);
-    NeighborArrayUnitReset(picture_control_set_ptr->cr_dc_sign_level_coeff_neighbor_array);
-    NeighborArrayUnitReset(picture_control_set_ptr->inter_pred_dir_neighbor_array);
-    NeighborArrayUnitReset(picture_control_set_ptr->ref_frame_type_neighbor_array);
+    NeighborArrayUnitReset(context_ptr->skip_coeff_neighbor_array);
+    NeighborArrayUnitReset(context_ptr->luma_dc_sign_level_coeff_neighbor_array);
+    NeighborArrayUnitReset(context_ptr->cb_dc_sign_level_coeff_neighbor_array);
+    NeighborArrayUnitReset(context_ptr->cr_dc_sign_level_coeff_neighbor_array);
+    NeighborArrayUnitReset(context_ptr->inter_pred_dir_neighbor_array);
+    NeighborArrayUnitReset(context_ptr->ref_frame_type_neighbor_array);
 
-    NeighborArrayUnitReset(picture_control_set_ptr->intra_luma_mode_neighbor_array);
-    NeighborArrayUnitReset32(picture_control_set_ptr->interpolation_type_neighbor_array);
+    NeighborArrayUnitReset(context_ptr->intra_luma_mode_neighbor_array);
+    NeighborArrayUnitReset32(context_ptr->interpolation_type_neighbor_array);
     return;
 }
 
@@ -164,14 +296,15 @@ void av1_build_nmv_cost_table(int32_t *mvjoint, int32_t *mvcost[2],
 
 
 /**************************************************
- * Reset Entropy Coding Picture
+ * Reset Entropy Coding Tile
  **************************************************/
-static void ResetEntropyCodingPicture(
+static void ResetEntropyCodingTile(
     EntropyCodingContext_t  *context_ptr,
     PictureControlSet_t     *picture_control_set_ptr,
-    SequenceControlSet_t    *sequence_control_set_ptr)
+    SequenceControlSet_t    *sequence_control_set_ptr,
+    EntropyCoder_t          *entropy_coder_ptr)
 {
-    ResetBitstream(EntropyCoderGetBitstreamPtr(picture_control_set_ptr->entropy_coder_ptr));
+    ResetBitstream(EntropyCoderGetBitstreamPtr(entropy_coder_ptr));
 
     uint32_t                       entropyCodingQp;
 
@@ -218,24 +351,37 @@ static void ResetEntropyCodingPicture(
 #endif
 
     // pass the ent
-    OutputBitstreamUnit_t *outputBitstreamPtr = (OutputBitstreamUnit_t*)(picture_control_set_ptr->entropy_coder_ptr->ecOutputBitstreamPtr);
+    OutputBitstreamUnit_t *outputBitstreamPtr = (OutputBitstreamUnit_t*)(entropy_coder_ptr->ecOutputBitstreamPtr);
     //****************************************************************//
 
     uint8_t *data = outputBitstreamPtr->bufferAv1;
-    picture_control_set_ptr->entropy_coder_ptr->ecWriter.allow_update_cdf = !picture_control_set_ptr->parent_pcs_ptr->large_scale_tile;
-    picture_control_set_ptr->entropy_coder_ptr->ecWriter.allow_update_cdf =
-        picture_control_set_ptr->entropy_coder_ptr->ecWriter.allow_update_cdf && !picture_control_set_ptr->parent_pcs_ptr->disable_cdf_update;
-    aom_start_encode(&picture_control_set_ptr->entropy_coder_ptr->ecWriter, data);
-
-    // ADD Reset here
+    entropy_coder_ptr->ecWriter.allow_update_cdf = !picture_control_set_ptr->parent_pcs_ptr->large_scale_tile;
+    entropy_coder_ptr->ecWriter.allow_update_cdf =
+        entropy_coder_ptr->ecWriter.allow_update_cdf && !picture_control_set_ptr->parent_pcs_ptr->disable_cdf_update;
+    aom_start_encode(&entropy_coder_ptr->ecWriter, data);
+
+    // Each tile starts from the default CDFs, or from the CDFs kept by the primary reference frame
+    if (picture_control_set_ptr->parent_pcs_ptr->primary_ref_frame != PRIMARY_REF_NONE) {
+        EbReferenceObject_t *referenceObject = (EbReferenceObject_t*)picture_control_set_ptr->ref_pic_ptr_array[
+            picture_control_set_ptr->parent_pcs_ptr->primary_ref_frame == BWDREF_FRAME - LAST_FRAME ? REF_LIST_1 : REF_LIST_0]->objectPtr;
+
+        // Wait for the reference to keep its CDFs, and let the next frame loading them through
+        EbBlockOnSemaphore(referenceObject->frame_context_semaphore);
+        EbPostSemaphore(referenceObject->frame_context_semaphore);
+        *entropy_coder_ptr->fc = *referenceObject->frame_context;
+        EB_MEMCPY(picture_control_set_ptr->parent_pcs_ptr->prev_global_motion, referenceObject->global_motion, sizeof(referenceObject->global_motion));
+    }
+    else {
+        ResetEntropyCoder(
+            sequence_control_set_ptr->encode_context_ptr,
+            entropy_coder_ptr,
+            entropyCodingQp,
+            picture_control_set_ptr->slice_type);
+    }
 
-    ResetEntropyCoder(
-        sequence_control_set_ptr->encode_context_ptr,
-        picture_control_set_ptr->entropy_coder_ptr,
-        entropyCodingQp,
-        picture_control_set_ptr->slice_type);
+    EntropyCodingResetNeighborArrays(context_ptr);
 
-    EntropyCodingResetNeighborArrays(picture_control_set_ptr);
+    av1_reset_loop_restoration(context_ptr);
 
 
     return;
@@ -273,6 +419,7 @@ static void EntropyCodingLcu(
     LargestCodingUnit_t               *sb_ptr,
     PictureControlSet_t               *picture_control_set_ptr,
     SequenceControlSet_t              *sequence_control_set_ptr,
+    EntropyCoder_t                    *entropy_coder_ptr,
     uint32_t                             sb_origin_x,
     uint32_t                             sb_origin_y,
     EbBool                            terminateSliceFlag,
@@ -295,7 +442,7 @@ static void EntropyCodingLcu(
     // + 32  - bits remaining in interval Low Value
     // + number of buffered byte * 8
     // This should be only for coeffs not any flag
-    writtenBitsBeforeQuantizedCoeff = ((OutputBitstreamUnit_t*)EntropyCoderGetBitstreamPtr(picture_control_set_ptr->entropy_coder_ptr))->writtenBitsCount;
+    writtenBitsBeforeQuantizedCoeff = ((OutputBitstreamUnit_t*)EntropyCoderGetBitstreamPtr(entropy_coder_ptr))->writtenBitsCount;
 
     (void)pictureOriginX;
     (void)pictureOriginY;
@@ -304,7 +451,7 @@ static void EntropyCodingLcu(
         context_ptr,
         sb_ptr,
         picture_control_set_ptr,
-        picture_control_set_ptr->entropy_coder_ptr,
+        entropy_coder_ptr,
         coeffPicturePtr);
 
     //store the number of written bits after coding quantized coeffs (flush is not called yet):
@@ -312,7 +459,7 @@ static void EntropyCodingLcu(
     // number of written bits
     // + 32  - bits remaining in interval Low Value
     // + number of buffered byte * 8
-    writtenBitsAfterQuantizedCoeff = ((OutputBitstreamUnit_t*)EntropyCoderGetBitstreamPtr(picture_control_set_ptr->entropy_coder_ptr))->writtenBitsCount;
+    writtenBitsAfterQuantizedCoeff = ((OutputBitstreamUnit_t*)EntropyCoderGetBitstreamPtr(entropy_coder_ptr))->writtenBitsCount;
 
     sb_ptr->total_bits = writtenBitsAfterQuantizedCoeff - writtenBitsBeforeQuantizedCoeff;
 
@@ -322,97 +469,101 @@ static void EntropyCodingLcu(
 }
 
 /******************************************************
- * Update Entropy Coding Rows
- *
- * This function is responsible for synchronizing the
- *   processing of Entropy Coding LCU-rows and starts
- *   processing of LCU-rows as soon as their inputs are
- *   available and the previous LCU-row has completed.
- *   At any given time, only one segment row per picture
- *   is being processed.
- *
- * The function has two parts:
- *
- * (1) Update the available row index which tracks
- *   which SB Row-inputs are available.
- *
- * (2) Increment the lcu-row counter as the segment-rows
- *   are completed.
- *
- * Since there is the potentential for thread collusion,
- *   a MUTEX a used to protect the sensitive data and
- *   the execution flow is separated into two paths
- *
- * (A) Initial update.
- *  -Update the Completion Mask [see (1) above]
- *  -If the picture is not currently being processed,
- *     check to see if the next segment-row is available
- *     and start processing.
- * (B) Continued processing
- *  -Upon the completion of a segment-row, check
- *     to see if the next segment-row's inputs have
- *     become available and begin processing if so.
- *
- * On last important point is that the thread-safe
- *   code section is kept minimally short. The MUTEX
- *   should NOT be locked for the entire processing
- *   of the segment-row (B) as this would block other
- *   threads from performing an update (A).
+ * Entropy Coding Picture Join
+ *   Counts one more completed input of the picture, the
+ *   last one releases the references and hands the
+ *   picture to the packetization.
  ******************************************************/
-static EbBool UpdateEntropyCodingRows(
-    PictureControlSet_t *picture_control_set_ptr,
-    uint32_t              *rowIndex,
-    uint32_t               row_count,
-    EbBool             *initialProcessCall)
+static void EntropyCodingPictureJoin(
+    EntropyCodingContext_t  *context_ptr,
+    EbObjectWrapper_t       *pictureControlSetWrapperPtr,
+    uint16_t                 joinCount)
 {
-    EbBool processNextRow = EB_FALSE;
+    PictureControlSet_t     *picture_control_set_ptr = (PictureControlSet_t*)pictureControlSetWrapperPtr->objectPtr;
+    EbObjectWrapper_t       *entropyCodingResultsWrapperPtr;
+    EntropyCodingResults_t  *entropyCodingResultsPtr;
 
-    // Note, any writes & reads to status variables (e.g. in_progress) in MD-CTRL must be thread-safe
     EbBlockOnMutex(picture_control_set_ptr->entropy_coding_mutex);
 
-    // Update availability mask
-    if (*initialProcessCall == EB_TRUE) {
-        unsigned i;
+    // If the picture is complete, release the references and send it to the packetization
+    if (++picture_control_set_ptr->entropy_coding_tile_done_count == joinCount)
+    {
+        uint32_t refIdx;
 
-        for (i = *rowIndex; i < *rowIndex + row_count; ++i) {
-            picture_control_set_ptr->entropy_coding_row_array[i] = EB_TRUE;
-        }
+        // Release the List 0 Reference Pictures
+        for (refIdx = 0; refIdx < picture_control_set_ptr->parent_pcs_ptr->ref_list0_count; ++refIdx) {
+            if (picture_control_set_ptr->ref_pic_ptr_array[0] != EB_NULL) {
 
-        while (picture_control_set_ptr->entropy_coding_row_array[picture_control_set_ptr->entropy_coding_current_available_row] == EB_TRUE &&
-            picture_control_set_ptr->entropy_coding_current_available_row < picture_control_set_ptr->entropy_coding_row_count)
-        {
-            ++picture_control_set_ptr->entropy_coding_current_available_row;
+                EbReleaseObject(picture_control_set_ptr->ref_pic_ptr_array[0]);
+            }
         }
-    }
 
-    // Release in_progress token
-    if (*initialProcessCall == EB_FALSE && picture_control_set_ptr->entropy_coding_in_progress == EB_TRUE) {
-        picture_control_set_ptr->entropy_coding_in_progress = EB_FALSE;
-    }
+        // Release the List 1 Reference Pictures
+        for (refIdx = 0; refIdx < picture_control_set_ptr->parent_pcs_ptr->ref_list1_count; ++refIdx) {
+            if (picture_control_set_ptr->ref_pic_ptr_array[1] != EB_NULL) {
 
-    // Test if the picture is not already complete AND not currently being worked on by another ENCDEC process
-    if (picture_control_set_ptr->entropy_coding_current_row < picture_control_set_ptr->entropy_coding_row_count &&
-        picture_control_set_ptr->entropy_coding_row_array[picture_control_set_ptr->entropy_coding_current_row] == EB_TRUE &&
-        picture_control_set_ptr->entropy_coding_in_progress == EB_FALSE)
-    {
-        // Test if the next LCU-row is ready to go
-        if (picture_control_set_ptr->entropy_coding_current_row <= picture_control_set_ptr->entropy_coding_current_available_row)
-        {
-            picture_control_set_ptr->entropy_coding_in_progress = EB_TRUE;
-            *rowIndex = picture_control_set_ptr->entropy_coding_current_row++;
-            processNextRow = EB_TRUE;
+                EbReleaseObject(picture_control_set_ptr->ref_pic_ptr_array[1]);
+            }
         }
-    }
 
-    *initialProcessCall = EB_FALSE;
+        // Get Empty Entropy Coding Results
+        EbGetEmptyObject(
+            context_ptr->entropy_coding_output_fifo_ptr,
+            &entropyCodingResultsWrapperPtr);
+        entropyCodingResultsPtr = (EntropyCodingResults_t*)entropyCodingResultsWrapperPtr->objectPtr;
+        entropyCodingResultsPtr->pictureControlSetWrapperPtr = pictureControlSetWrapperPtr;
+        entropyCodingResultsPtr->resultType = ENTROPY_CODING_RESULTS_PICTURE;
+
+        // Post EntropyCoding Results
+        EbPostFullObject(entropyCodingResultsWrapperPtr);
+
+    } // End if(PictureCompleteFlag)
 
     EbReleaseMutex(picture_control_set_ptr->entropy_coding_mutex);
+}
 
-    return processNextRow;
+/******************************************************
+ * Entropy Coding Post Tile
+ *   Tile group output: hands a coded tile to the
+ *   packetization, ahead of the rest of the picture.
+ ******************************************************/
+static void EntropyCodingPostTile(
+    EntropyCodingContext_t  *context_ptr,
+    EbObjectWrapper_t       *pictureControlSetWrapperPtr,
+    uint16_t                 tileIndex)
+{
+    EbObjectWrapper_t       *entropyCodingResultsWrapperPtr;
+    EntropyCodingResults_t  *entropyCodingResultsPtr;
+
+    // Get Empty Entropy Coding Results
+    EbGetEmptyObject(
+        context_ptr->entropy_coding_output_fifo_ptr,
+        &entropyCodingResultsWrapperPtr);
+    entropyCodingResultsPtr = (EntropyCodingResults_t*)entropyCodingResultsWrapperPtr->objectPtr;
+    entropyCodingResultsPtr->pictureControlSetWrapperPtr = pictureControlSetWrapperPtr;
+    entropyCodingResultsPtr->resultType = ENTROPY_CODING_RESULTS_TILE;
+    entropyCodingResultsPtr->tile_index = tileIndex;
+
+    // Post EntropyCoding Results
+    EbPostFullObject(entropyCodingResultsWrapperPtr);
 }
 
 /******************************************************
  * Entropy Coding Kernel
+ *
+ * Each input task carries one tile of a picture. The
+ *   tiles of a picture are coded independently, each
+ *   into its own entropy coder, and the last completed
+ *   tile hands the picture to the packetization. With
+ *   the tile group output, each tile is also handed to
+ *   the packetization as soon as it is coded.
+ *
+ * In SB row latency mode the encdec sends the picture
+ *   (a single tile) with its first SB and the SB rows
+ *   are coded as the encdec completes them. The filters
+ *   send their own input once the frame header fields
+ *   they set are final, and the picture is handed to the
+ *   packetization once both inputs are done.
  ******************************************************/
 void* EntropyCodingKernel(void *input_ptr)
 {
@@ -425,10 +576,6 @@ void* EntropyCodingKernel(void *input_ptr)
     EbObjectWrapper_t                       *encDecResultsWrapperPtr;
     EncDecResults_t                         *encDecResultsPtr;
 
-    // Output
-    EbObjectWrapper_t                       *entropyCodingResultsWrapperPtr;
-    EntropyCodingResults_t                  *entropyCodingResultsPtr;
-
     // SB Loop variables
     LargestCodingUnit_t                     *sb_ptr;
     uint16_t                                   sb_index;
@@ -440,8 +587,17 @@ void* EntropyCodingKernel(void *input_ptr)
     uint32_t                                   sb_origin_y;
     EbBool                                  lastLcuFlag;
     uint32_t                                   picture_width_in_sb;
-    // Variables
-    EbBool                                  initialProcessCall;
+
+    // Tile variables
+    Av1Common                               *cm;
+    EntropyCoder_t                          *entropy_coder_ptr;
+    uint16_t                                   tileIndex;
+    uint16_t                                   tileCount;
+    uint32_t                                   tileLcuStartX;
+    uint32_t                                   tileLcuEndX;
+    uint32_t                                   tileLcuStartY;
+    uint32_t                                   tileLcuEndY;
+
     for (;;) {
 
         // Get Mode Decision Results
@@ -451,6 +607,22 @@ void* EntropyCodingKernel(void *input_ptr)
         encDecResultsPtr = (EncDecResults_t*)encDecResultsWrapperPtr->objectPtr;
         picture_control_set_ptr = (PictureControlSet_t*)encDecResultsPtr->pictureControlSetWrapperPtr->objectPtr;
         sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->objectPtr;
+        cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+        tileIndex = encDecResultsPtr->tile_index;
+        tileCount = (uint16_t)(cm->tile_cols * cm->tile_rows);
+
+        if (encDecResultsPtr->inputType == ENCDEC_RESULTS_FILTER_DONE_INPUT) {
+            EntropyCodingPictureJoin(
+                context_ptr,
+                encDecResultsPtr->pictureControlSetWrapperPtr,
+                tileCount + 1);
+
+            // Release Mode Decision Results
+            EbReleaseObject(encDecResultsWrapperPtr);
+            continue;
+        }
+
+        entropy_coder_ptr = picture_control_set_ptr->entropy_coder_ptr_array[tileIndex];
         lastLcuFlag = EB_FALSE;
 
         // SB Constants
@@ -460,124 +632,130 @@ void* EntropyCodingKernel(void *input_ptr)
         lcuSizeLog2 = (uint8_t)Log2f(sb_sz);
         context_ptr->sb_sz = sb_sz;
         picture_width_in_sb = (sequence_control_set_ptr->luma_width + sb_sz - 1) >> lcuSizeLog2;
-        {
-            initialProcessCall = EB_TRUE;
-            yLcuIndex = encDecResultsPtr->completedLcuRowIndexStart;
 
-            // LCU-loops
-            while (UpdateEntropyCodingRows(picture_control_set_ptr, &yLcuIndex, encDecResultsPtr->completedLcuRowCount, &initialProcessCall) == EB_TRUE)
-            {
-                uint32_t rowTotalBits = 0;
-
-                if (yLcuIndex == 0) {
-                    ResetEntropyCodingPicture(
-                        context_ptr,
-                        picture_control_set_ptr,
-                        sequence_control_set_ptr);
-                    picture_control_set_ptr->entropy_coding_pic_done = EB_FALSE;
-                }
-
-                for (xLcuIndex = 0; xLcuIndex < picture_width_in_sb; ++xLcuIndex)
-                {
-
-
-                    sb_index = (uint16_t)(xLcuIndex + yLcuIndex * picture_width_in_sb);
-                    sb_ptr = picture_control_set_ptr->sb_ptr_array[sb_index];
-
-                    sb_origin_x = xLcuIndex << lcuSizeLog2;
-                    sb_origin_y = yLcuIndex << lcuSizeLog2;
-                    context_ptr->sb_origin_x = sb_origin_x;
-                    context_ptr->sb_origin_y = sb_origin_y;
-                    lastLcuFlag = (sb_index == sequence_control_set_ptr->sb_tot_cnt - 1) ? EB_TRUE : EB_FALSE;
-                    // Configure the LCU
-                    EntropyCodingConfigureLcu(
-                        context_ptr,
-                        sb_ptr,
-                        picture_control_set_ptr);
-
-                    // Entropy Coding
-                    EntropyCodingLcu(
-                        context_ptr,
-                        sb_ptr,
-                        picture_control_set_ptr,
-                        sequence_control_set_ptr,
-                        sb_origin_x,
-                        sb_origin_y,
-                        lastLcuFlag,
-                        0,
-                        0);
-
-                    rowTotalBits += sb_ptr->total_bits;
-                }
-
-                // At the end of each LCU-row, send the updated bit-count to Entropy Coding
-                {
-                    EbObjectWrapper_t *rateControlTaskWrapperPtr;
-                    RateControlTasks_t *rateControlTaskPtr;
-
-                    // Get Empty EncDec Results
-                    EbGetEmptyObject(
-                        context_ptr->rate_control_output_fifo_ptr,
-                        &rateControlTaskWrapperPtr);
-                    rateControlTaskPtr = (RateControlTasks_t*)rateControlTaskWrapperPtr->objectPtr;
-                    rateControlTaskPtr->taskType = RC_ENTROPY_CODING_ROW_FEEDBACK_RESULT;
-                    rateControlTaskPtr->picture_number = picture_control_set_ptr->picture_number;
-                    rateControlTaskPtr->rowNumber = yLcuIndex;
-                    rateControlTaskPtr->bitCount = rowTotalBits;
-
-                    rateControlTaskPtr->pictureControlSetWrapperPtr = 0;
-                    rateControlTaskPtr->segment_index = ~0u;
-
-                    // Post EncDec Results
-                    EbPostFullObject(rateControlTaskWrapperPtr);
+        // Tile bounds
+        av1_tile_init(
+            &context_ptr->tile_info,
+            cm,
+            cm->tile_row_start_sb[tileIndex / cm->tile_cols] << cm->mib_size_log2,
+            cm->tile_col_start_sb[tileIndex % cm->tile_cols] << cm->mib_size_log2);
+        tileLcuStartX = (context_ptr->tile_info.mi_col_start << MI_SIZE_LOG2) >> lcuSizeLog2;
+        tileLcuEndX = ((context_ptr->tile_info.mi_col_end << MI_SIZE_LOG2) + sb_sz - 1) >> lcuSizeLog2;
+        tileLcuStartY = (context_ptr->tile_info.mi_row_start << MI_SIZE_LOG2) >> lcuSizeLog2;
+        tileLcuEndY = ((context_ptr->tile_info.mi_row_end << MI_SIZE_LOG2) + sb_sz - 1) >> lcuSizeLog2;
+
+        ResetEntropyCodingTile(
+            context_ptr,
+            picture_control_set_ptr,
+            sequence_control_set_ptr,
+            entropy_coder_ptr);
+
+        // LCU-loops
+        for (yLcuIndex = tileLcuStartY; yLcuIndex < tileLcuEndY; ++yLcuIndex)
+        {
+            // Bits of the row, from the position of the tile entropy coder
+            int32_t rowStartBits = od_ec_enc_tell(&entropy_coder_ptr->ecWriter.ec);
+            uint32_t rowTotalBits;
+
+            // SB row latency: wait for the encdec to complete the row
+            if (sequence_control_set_ptr->static_config.low_latency == EB_SB_ROW_LATENCY) {
+                for (xLcuIndex = tileLcuStartX; xLcuIndex < tileLcuEndX; ++xLcuIndex) {
+                    EbBlockOnSemaphore(picture_control_set_ptr->entropy_coding_row_semaphore_array[yLcuIndex]);
                 }
+            }
 
-                EbBlockOnMutex(picture_control_set_ptr->entropy_coding_mutex);
-                if (picture_control_set_ptr->entropy_coding_pic_done == EB_FALSE) {
-
-                    // If the picture is complete, terminate the slice
-                    if (picture_control_set_ptr->entropy_coding_current_row == picture_control_set_ptr->entropy_coding_row_count)
-                    {
-                        uint32_t refIdx;
-
-                        picture_control_set_ptr->entropy_coding_pic_done = EB_TRUE;
-
-                        EncodeSliceFinish(picture_control_set_ptr->entropy_coder_ptr);
-
-                        // Release the List 0 Reference Pictures
-                        for (refIdx = 0; refIdx < picture_control_set_ptr->parent_pcs_ptr->ref_list0_count; ++refIdx) {
-                            if (picture_control_set_ptr->ref_pic_ptr_array[0] != EB_NULL) {
-
-                                EbReleaseObject(picture_control_set_ptr->ref_pic_ptr_array[0]);
-                            }
-                        }
-
-                        // Release the List 1 Reference Pictures
-                        for (refIdx = 0; refIdx < picture_control_set_ptr->parent_pcs_ptr->ref_list1_count; ++refIdx) {
-                            if (picture_control_set_ptr->ref_pic_ptr_array[1] != EB_NULL) {
-
-                                EbReleaseObject(picture_control_set_ptr->ref_pic_ptr_array[1]);
-                            }
-                        }
+            for (xLcuIndex = tileLcuStartX; xLcuIndex < tileLcuEndX; ++xLcuIndex)
+            {
+                sb_index = (uint16_t)(xLcuIndex + yLcuIndex * picture_width_in_sb);
+                sb_ptr = picture_control_set_ptr->sb_ptr_array[sb_index];
+
+                sb_origin_x = xLcuIndex << lcuSizeLog2;
+                sb_origin_y = yLcuIndex << lcuSizeLog2;
+                context_ptr->sb_origin_x = sb_origin_x;
+                context_ptr->sb_origin_y = sb_origin_y;
+                lastLcuFlag = (xLcuIndex == tileLcuEndX - 1 && yLcuIndex == tileLcuEndY - 1) ? EB_TRUE : EB_FALSE;
+                // Configure the LCU
+                EntropyCodingConfigureLcu(
+                    context_ptr,
+                    sb_ptr,
+                    picture_control_set_ptr);
+
+                // Entropy Coding
+                EntropyCodingLcu(
+                    context_ptr,
+                    sb_ptr,
+                    picture_control_set_ptr,
+                    sequence_control_set_ptr,
+                    entropy_coder_ptr,
+                    sb_origin_x,
+                    sb_origin_y,
+                    lastLcuFlag,
+                    0,
+                    0);
+            }
+            rowTotalBits = (uint32_t)(od_ec_enc_tell(&entropy_coder_ptr->ecWriter.ec) - rowStartBits);
 
-                        // Get Empty Entropy Coding Results
-                        EbGetEmptyObject(
-                            context_ptr->entropy_coding_output_fifo_ptr,
-                            &entropyCodingResultsWrapperPtr);
-                        entropyCodingResultsPtr = (EntropyCodingResults_t*)entropyCodingResultsWrapperPtr->objectPtr;
-                        entropyCodingResultsPtr->pictureControlSetWrapperPtr = encDecResultsPtr->pictureControlSetWrapperPtr;
+            // At the end of each LCU-row of the tile, send the updated bit-count to Rate Control,
+            // keyed by the tile and the row
+            {
+                EbObjectWrapper_t *rateControlTaskWrapperPtr;
+                RateControlTasks_t *rateControlTaskPtr;
+
+                // Get Empty EncDec Results
+                EbGetEmptyObject(
+                    context_ptr->rate_control_output_fifo_ptr,
+                    &rateControlTaskWrapperPtr);
+                rateControlTaskPtr = (RateControlTasks_t*)rateControlTaskWrapperPtr->objectPtr;
+                rateControlTaskPtr->taskType = RC_ENTROPY_CODING_ROW_FEEDBACK_RESULT;
+                rateControlTaskPtr->picture_number = picture_control_set_ptr->picture_number;
+                rateControlTaskPtr->tile_index = tileIndex;
+                rateControlTaskPtr->rowNumber = yLcuIndex;
+                rateControlTaskPtr->bitCount = rowTotalBits;
+
+                rateControlTaskPtr->pictureControlSetWrapperPtr = 0;
+                rateControlTaskPtr->segment_index = ~0u;
+
+                // Post EncDec Results
+                EbPostFullObject(rateControlTaskWrapperPtr);
+            }
+        }
 
-                        // Post EntropyCoding Results
-                        EbPostFullObject(entropyCodingResultsWrapperPtr);
+        // Terminate the tile
+        EncodeSliceFinish(entropy_coder_ptr);
+
+        // Frame context adaptation: a reference frame keeps the CDFs of its first tile, the tile the
+        // frame header names to update the frame context, and then lets go of its reference object
+        if (sequence_control_set_ptr->static_config.frame_context_adaptation && tileIndex == 0 &&
+            picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
+            EbReferenceObject_t *referenceObject = (EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr;
+
+            *referenceObject->frame_context = *entropy_coder_ptr->fc;
+            av1_reset_cdf_symbol_counters(referenceObject->frame_context);
+            for (int32_t frame = INTRA_FRAME; frame < TOTAL_REFS_PER_FRAME; ++frame)
+                referenceObject->global_motion[frame] = picture_control_set_ptr->slice_type == I_SLICE ?
+                    default_warp_params : picture_control_set_ptr->parent_pcs_ptr->global_motion[frame];
+            referenceObject->frame_context_saved = EB_TRUE;
+            EbPostSemaphore(referenceObject->frame_context_semaphore);
+            EbReleaseObject(picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr);
+        }
 
-                    } // End if(PictureCompleteFlag)
-                }
-                EbReleaseMutex(picture_control_set_ptr->entropy_coding_mutex);
+        PictureStageDone(
+            picture_control_set_ptr->parent_pcs_ptr,
+            LATENCY_STAGE_ENTROPY_CODING);
 
+        // In SB row latency mode the frame header waits for the filters, the tile is output with the picture
+        if (sequence_control_set_ptr->static_config.tile_group_output && sequence_control_set_ptr->static_config.low_latency != EB_SB_ROW_LATENCY) {
+            EntropyCodingPostTile(
+                context_ptr,
+                encDecResultsPtr->pictureControlSetWrapperPtr,
+                tileIndex);
+        }
 
-            }
+        EntropyCodingPictureJoin(
+            context_ptr,
+            encDecResultsPtr->pictureControlSetWrapperPtr,
+            sequence_control_set_ptr->static_config.low_latency == EB_SB_ROW_LATENCY ? tileCount + 1 : tileCount);
 
-        }
         // Release Mode Decision Results
         EbReleaseObject(encDecResultsWrapperPtr);
 
@@ -71,6 +71,27 @@ typedef struct EntropyCodingContext_s
     EbBool                            is16bit; //enable 10 bit encode in CL
     int32_t                           coded_area_sb;
     int32_t                           coded_area_sb_uv;
+
+    // Tile being coded, in MI units
+    TileInfo                          tile_info;
+
+    // Entropy Coding Neighbor Arrays, reset at the start of each tile
+    NeighborArrayUnit_t              *mode_type_neighbor_array;
+    NeighborArrayUnit_t              *partition_context_neighbor_array;
+    NeighborArrayUnit_t              *intra_luma_mode_neighbor_array;
+    NeighborArrayUnit_t              *skip_flag_neighbor_array;
+    NeighborArrayUnit_t              *skip_coeff_neighbor_array;
+    NeighborArrayUnit_t              *luma_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits (COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
+    NeighborArrayUnit_t              *cr_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
+    NeighborArrayUnit_t              *cb_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
+    NeighborArrayUnit_t              *inter_pred_dir_neighbor_array;
+    NeighborArrayUnit_t              *ref_frame_type_neighbor_array;
+    NeighborArrayUnit32_t            *interpolation_type_neighbor_array;
+
+    // Tile level syntax state
+    int32_t                           cdef_preset[4];
+    WienerInfo                        wiener_info[MAX_MB_PLANE];
+    SgrprojInfo                       sgrproj_info[MAX_MB_PLANE];
 } EntropyCodingContext_t;
 
 /**************************************
@@ -81,7 +102,9 @@ extern EbErrorType entropy_coding_context_ctor(
     EbFifo_t                *enc_dec_input_fifo_ptr,
     EbFifo_t                *packetization_output_fifo_ptr,
     EbFifo_t                *rate_control_output_fifo_ptr,
-    EbBool                   is16bit);
+    EbBool                   is16bit,
+    uint32_t                 max_input_luma_width,
+    uint32_t                 max_input_luma_height);
 
 extern void* EntropyCodingKernel(void *input_ptr);
 
@@ -11,12 +11,17 @@
 #ifdef __cplusplus
 extern "C" {
 #endif
+#define ENTROPY_CODING_RESULTS_PICTURE  0   // the picture is coded
+#define ENTROPY_CODING_RESULTS_TILE     1   // tile group output: the tile tile_index is coded
+
     /**************************************
      * Process Results
      **************************************/
     typedef struct
     {
         EbObjectWrapper_t      *pictureControlSetWrapperPtr;
+        uint32_t                resultType;
+        uint16_t                tile_index;
 
     } EntropyCodingResults_t;
 
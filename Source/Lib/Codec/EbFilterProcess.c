@@ -0,0 +1,1406 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+/*
+* Copyright (c) 2016, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at www.aomedia.org/license/software. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+*/
+
+#include <stdlib.h>
+
+#include "EbFilterProcess.h"
+#include "EbFilterTasks.h"
+#include "EbEncDecResults.h"
+#include "EbPictureDemuxResults.h"
+#include "EbPictureControlSet.h"
+#include "EbSequenceControlSet.h"
+#include "EbReferenceObject.h"
+#include "EbDeblockingFilter.h"
+#include "EbRestoration.h"
+#include "EbUtility.h"
+#include "EbErrorCodes.h"
+#include "grainSynthesis.h"
+
+void av1_cdef_search_sb_row(
+    int32_t                         fbr,
+    SequenceControlSet_t           *sequence_control_set_ptr,
+    PictureControlSet_t            *picture_control_set_ptr
+);
+
+void av1_cdef_search_finish(
+    SequenceControlSet_t           *sequence_control_set_ptr,
+    PictureControlSet_t            *picture_control_set_ptr
+);
+
+void av1_cdef_frame(
+    SequenceControlSet_t           *sequence_control_set_ptr,
+    PictureControlSet_t            *pCs
+);
+
+void av1_cdef_frame16bit(
+    SequenceControlSet_t           *sequence_control_set_ptr,
+    PictureControlSet_t            *pCs
+);
+
+void av1_add_film_grain(EbPictureBufferDesc_t *src,
+    EbPictureBufferDesc_t *dst,
+    aom_film_grain_t *film_grain_ptr);
+
+void av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame, Av1Common *cm, int32_t after_cdef);
+void av1_pick_filter_restoration_init(Av1Common *const cm, RestUnitSearchInfo **rusi);
+void av1_pick_filter_restoration_rows(const Yv12BufferConfig *src, Yv12BufferConfig *trial_frame_rst,
+    int32_t *rst_tmpbuf, Macroblock *x, Av1Common *const cm, RestUnitSearchInfo *rusi,
+    int32_t plane, int32_t row_start, int32_t row_end);
+void av1_pick_filter_restoration_finish(const Yv12BufferConfig *src, Macroblock *x, Av1Common *const cm, RestUnitSearchInfo **rusi);
+void av1_loop_restoration_filter_frame(Yv12BufferConfig *frame, Av1Common *cm, int32_t optimized_lr);
+
+// The in-loop filters of a picture run as a sequence of passes. The jobs of a
+// pass (SB rows for the deblocking filter, 64x64 filter block rows for the CDEF
+// search and restoration unit rows for the restoration search) are shared by
+// all the filter threads working on the picture; the thread finishing the last
+// job of a pass runs the serial part between two passes and starts the next one.
+#define FILTER_PASS_DLF     0
+#define FILTER_PASS_CDEF    1
+#define FILTER_PASS_REST    2
+#define FILTER_PASS_DONE    3
+
+/******************************************************
+ * Filter Context Constructor
+ ******************************************************/
+EbErrorType filter_context_ctor(
+    FilterContext_t **context_dbl_ptr,
+    EbFifo_t         *filter_input_fifo_ptr,
+    EbFifo_t         *filter_output_fifo_ptr,
+    EbFifo_t         *filter_feedback_fifo_ptr,
+    EbFifo_t         *picture_demux_output_fifo_ptr,
+    uint32_t          filter_process_count,
+    EbBool            is16bit,
+    uint32_t          max_input_luma_width,
+    uint32_t          max_input_luma_height)
+{
+    EbErrorType return_error = EB_ErrorNone;
+    FilterContext_t *context_ptr;
+    EB_MALLOC(FilterContext_t*, context_ptr, sizeof(FilterContext_t), EB_N_PTR);
+    *context_dbl_ptr = context_ptr;
+
+    context_ptr->is16bit = is16bit;
+    context_ptr->filter_process_count = filter_process_count;
+
+    // Input/Output System Resource Manager FIFOs
+    context_ptr->filter_input_fifo_ptr = filter_input_fifo_ptr;
+    context_ptr->filter_output_fifo_ptr = filter_output_fifo_ptr;
+    context_ptr->filter_feedback_fifo_ptr = filter_feedback_fifo_ptr;
+    context_ptr->picture_demux_output_fifo_ptr = picture_demux_output_fifo_ptr;
+
+    context_ptr->temp_lf_recon_picture16bit_ptr = (EbPictureBufferDesc_t *)EB_NULL;
+    context_ptr->temp_lf_recon_picture_ptr = (EbPictureBufferDesc_t *)EB_NULL;
+    EbPictureBufferDescInitData_t tempLfReconDescInitData;
+    tempLfReconDescInitData.maxWidth = (uint16_t)max_input_luma_width;
+    tempLfReconDescInitData.maxHeight = (uint16_t)max_input_luma_height;
+    tempLfReconDescInitData.bufferEnableMask = PICTURE_BUFFER_DESC_FULL_MASK;
+
+    tempLfReconDescInitData.left_padding = PAD_VALUE;
+    tempLfReconDescInitData.right_padding = PAD_VALUE;
+    tempLfReconDescInitData.top_padding = PAD_VALUE;
+    tempLfReconDescInitData.bot_padding = PAD_VALUE;
+
+    tempLfReconDescInitData.splitMode = EB_FALSE;
+
+    if (is16bit) {
+        tempLfReconDescInitData.bit_depth = EB_16BIT;
+        return_error = EbReconPictureBufferDescCtor(
+            (EbPtr*)&(context_ptr->temp_lf_recon_picture16bit_ptr),
+            (EbPtr)&tempLfReconDescInitData);
+    }
+    else {
+        tempLfReconDescInitData.bit_depth = EB_8BIT;
+        return_error = EbReconPictureBufferDescCtor(
+            (EbPtr*)&(context_ptr->temp_lf_recon_picture_ptr),
+            (EbPtr)&tempLfReconDescInitData);
+    }
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
+    {
+        EbPictureBufferDescInitData_t initData;
+
+        initData.bufferEnableMask = PICTURE_BUFFER_DESC_FULL_MASK;
+        initData.maxWidth = (uint16_t)max_input_luma_width;
+        initData.maxHeight = (uint16_t)max_input_luma_height;
+        initData.bit_depth = is16bit ? EB_16BIT : EB_8BIT;
+        initData.left_padding = AOM_BORDER_IN_PIXELS;
+        initData.right_padding = AOM_BORDER_IN_PIXELS;
+        initData.top_padding = AOM_BORDER_IN_PIXELS;
+        initData.bot_padding = AOM_BORDER_IN_PIXELS;
+        initData.splitMode = EB_FALSE;
+
+        return_error = EbPictureBufferDescCtor(
+            (EbPtr*)&context_ptr->trial_frame_rst,
+            (EbPtr)&initData);
+
+        if (return_error == EB_ErrorInsufficientResources) {
+            return EB_ErrorInsufficientResources;
+        }
+    }
+
+    EB_MALLOC(int32_t*, context_ptr->rst_tmpbuf, RESTORATION_TMPBUF_SIZE, EB_N_PTR);
+
+    return EB_ErrorNone;
+}
+
+static void ReconOutput(
+    PictureControlSet_t    *picture_control_set_ptr,
+    SequenceControlSet_t   *sequence_control_set_ptr) {
+
+    EbObjectWrapper_t             *outputReconWrapperPtr;
+    EbBufferHeaderType           *outputReconPtr;
+    EncodeContext_t               *encode_context_ptr = sequence_control_set_ptr->encode_context_ptr;
+    EbBool is16bit = (sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    // The totalNumberOfReconFrames counter has to be write/read protected as
+    //   it is used to determine the end of the stream.  If it is not protected
+    //   the encoder might not properly terminate.
+    EbBlockOnMutex(encode_context_ptr->total_number_of_recon_frame_mutex);
+
+    // Get Recon Buffer
+    EbGetEmptyObject(
+        sequence_control_set_ptr->encode_context_ptr->recon_output_fifo_ptr,
+        &outputReconWrapperPtr);
+    outputReconPtr = (EbBufferHeaderType*)outputReconWrapperPtr->objectPtr;
+    outputReconPtr->flags = 0;
+
+    // START READ/WRITE PROTECTED SECTION
+    if (encode_context_ptr->total_number_of_recon_frames == encode_context_ptr->terminating_picture_number)
+        outputReconPtr->flags = EB_BUFFERFLAG_EOS;
+
+    encode_context_ptr->total_number_of_recon_frames++;
+
+    //EbReleaseMutex(encode_context_ptr->terminating_conditions_mutex);
+
+    // STOP READ/WRITE PROTECTED SECTION
+    outputReconPtr->n_filled_len = 0;
+
+    // Copy the Reconstructed Picture to the Output Recon Buffer
+    {
+        uint32_t sampleTotalCount;
+        uint8_t *reconReadPtr;
+        uint8_t *reconWritePtr;
+
+        EbPictureBufferDesc_t *reconPtr;
+        {
+            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
+                reconPtr = is16bit ?
+                ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->referencePicture16bit :
+                ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->referencePicture;
+            else {
+                if (is16bit)
+                    reconPtr = picture_control_set_ptr->recon_picture16bit_ptr;
+                else
+                    reconPtr = picture_control_set_ptr->recon_picture_ptr;
+            }
+        }
+
+        // FGN: Create a buffer if needed, copy the reconstructed picture and run the film grain synthesis algorithm
+
+        if (sequence_control_set_ptr->film_grain_params_present) {
+            EbPictureBufferDesc_t  *intermediateBufferPtr;
+            {
+                if (is16bit)
+                    intermediateBufferPtr = picture_control_set_ptr->film_grain_picture16bit_ptr;
+                else
+                    intermediateBufferPtr = picture_control_set_ptr->film_grain_picture_ptr;
+            }
+
+            aom_film_grain_t *film_grain_ptr;
+
+            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
+                film_grain_ptr = &((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->film_grain_params;
+            else
+                film_grain_ptr = &picture_control_set_ptr->parent_pcs_ptr->film_grain_params;
+
+            av1_add_film_grain(reconPtr, intermediateBufferPtr, film_grain_ptr);
+            reconPtr = intermediateBufferPtr;
+        }
+
+        // End running the film grain
+        // Y Recon Samples
+        sampleTotalCount = ((reconPtr->maxWidth - sequence_control_set_ptr->max_input_pad_right) * (reconPtr->maxHeight - sequence_control_set_ptr->max_input_pad_bottom)) << is16bit;
+        reconReadPtr = reconPtr->bufferY + (reconPtr->origin_y << is16bit) * reconPtr->strideY + (reconPtr->origin_x << is16bit);
+        reconWritePtr = &(outputReconPtr->p_buffer[outputReconPtr->n_filled_len]);
+
+        CHECK_REPORT_ERROR(
+            (outputReconPtr->n_filled_len + sampleTotalCount <= outputReconPtr->n_alloc_len),
+            encode_context_ptr->app_callback_ptr,
+            EB_ENC_ROB_OF_ERROR);
+
+        // Initialize Y recon buffer
+        PictureCopyKernel(
+            reconReadPtr,
+            reconPtr->strideY,
+            reconWritePtr,
+            reconPtr->maxWidth - sequence_control_set_ptr->max_input_pad_right,
+            reconPtr->width - sequence_control_set_ptr->pad_right,
+            reconPtr->height - sequence_control_set_ptr->pad_bottom,
+            1 << is16bit);
+
+        outputReconPtr->n_filled_len += sampleTotalCount;
+
+        // U Recon Samples
+        sampleTotalCount = ((reconPtr->maxWidth - sequence_control_set_ptr->max_input_pad_right) * (reconPtr->maxHeight - sequence_control_set_ptr->max_input_pad_bottom) >> 2) << is16bit;
+        reconReadPtr = reconPtr->bufferCb + ((reconPtr->origin_y << is16bit) >> 1) * reconPtr->strideCb + ((reconPtr->origin_x << is16bit) >> 1);
+        reconWritePtr = &(outputReconPtr->p_buffer[outputReconPtr->n_filled_len]);
+
+        CHECK_REPORT_ERROR(
+            (outputReconPtr->n_filled_len + sampleTotalCount <= outputReconPtr->n_alloc_len),
+            encode_context_ptr->app_callback_ptr,
+            EB_ENC_ROB_OF_ERROR);
+
+        // Initialize U recon buffer
+        PictureCopyKernel(
+            reconReadPtr,
+            reconPtr->strideCb,
+            reconWritePtr,
+            (reconPtr->maxWidth - sequence_control_set_ptr->max_input_pad_right) >> 1,
+            (reconPtr->width - sequence_control_set_ptr->pad_right) >> 1,
+            (reconPtr->height - sequence_control_set_ptr->pad_bottom) >> 1,
+            1 << is16bit);
+        outputReconPtr->n_filled_len += sampleTotalCount;
+
+        // V Recon Samples
+        sampleTotalCount = ((reconPtr->maxWidth - sequence_control_set_ptr->max_input_pad_right) * (reconPtr->maxHeight - sequence_control_set_ptr->max_input_pad_bottom) >> 2) << is16bit;
+        reconReadPtr = reconPtr->bufferCr + ((reconPtr->origin_y << is16bit) >> 1) * reconPtr->strideCr + ((reconPtr->origin_x << is16bit) >> 1);
+        reconWritePtr = &(outputReconPtr->p_buffer[outputReconPtr->n_filled_len]);
+
+        CHECK_REPORT_ERROR(
+            (outputReconPtr->n_filled_len + sampleTotalCount <= outputReconPtr->n_alloc_len),
+            encode_context_ptr->app_callback_ptr,
+            EB_ENC_ROB_OF_ERROR);
+
+        // Initialize V recon buffer
+
+        PictureCopyKernel(
+            reconReadPtr,
+            reconPtr->strideCr,
+            reconWritePtr,
+            (reconPtr->maxWidth - sequence_control_set_ptr->max_input_pad_right) >> 1,
+            (reconPtr->width - sequence_control_set_ptr->pad_right) >> 1,
+            (reconPtr->height - sequence_control_set_ptr->pad_bottom) >> 1,
+            1 << is16bit);
+        outputReconPtr->n_filled_len += sampleTotalCount;
+        outputReconPtr->pts = picture_control_set_ptr->picture_number;
+    }
+
+    // Post the Recon object
+    EbPostFullObject(outputReconWrapperPtr);
+    EbReleaseMutex(encode_context_ptr->total_number_of_recon_frame_mutex);
+}
+
+void PsnrCalculations(
+    PictureControlSet_t    *picture_control_set_ptr,
+    SequenceControlSet_t   *sequence_control_set_ptr){
+
+    EbBool is16bit = (sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+
+    if (!is16bit) {
+
+        EbPictureBufferDesc_t *reconPtr;
+
+        if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
+            reconPtr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->referencePicture;
+        else
+            reconPtr = picture_control_set_ptr->recon_picture_ptr;
+
+        EbPictureBufferDesc_t *inputPicturePtr = (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
+
+        uint64_t sseTotal[3] = { 0 };
+        uint32_t   columnIndex;
+        uint32_t   rowIndex = 0;
+        uint64_t   residualDistortion = 0;
+        EbByte  inputBuffer;
+        EbByte  reconCoeffBuffer;
+
+        reconCoeffBuffer = &((reconPtr->bufferY)[reconPtr->origin_x + reconPtr->origin_y * reconPtr->strideY]);
+        inputBuffer = &((inputPicturePtr->bufferY)[inputPicturePtr->origin_x + inputPicturePtr->origin_y * inputPicturePtr->strideY]);
+
+        residualDistortion = 0;
+
+        while (rowIndex < sequence_control_set_ptr->luma_height) {
+
+            columnIndex = 0;
+            while (columnIndex < sequence_control_set_ptr->luma_width) {
+                residualDistortion += (int64_t)SQR((int64_t)(inputBuffer[columnIndex]) - (reconCoeffBuffer[columnIndex]));
+                ++columnIndex;
+            }
+
+            inputBuffer += inputPicturePtr->strideY;
+            reconCoeffBuffer += reconPtr->strideY;
+            ++rowIndex;
+        }
+
+        sseTotal[0] = residualDistortion;
+
+        reconCoeffBuffer = &((reconPtr->bufferCb)[reconPtr->origin_x / 2 + reconPtr->origin_y / 2 * reconPtr->strideCb]);
+        inputBuffer = &((inputPicturePtr->bufferCb)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCb]);
+
+        residualDistortion = 0;
+        rowIndex = 0;
+        while (rowIndex < sequence_control_set_ptr->chroma_height) {
+
+            columnIndex = 0;
+            while (columnIndex < sequence_control_set_ptr->chroma_width) {
+                residualDistortion += (int64_t)SQR((int64_t)(inputBuffer[columnIndex]) - (reconCoeffBuffer[columnIndex]));
+                ++columnIndex;
+            }
+
+            inputBuffer += inputPicturePtr->strideCb;
+            reconCoeffBuffer += reconPtr->strideCb;
+            ++rowIndex;
+        }
+
+        sseTotal[1] = residualDistortion;
+
+        reconCoeffBuffer = &((reconPtr->bufferCr)[reconPtr->origin_x / 2 + reconPtr->origin_y / 2 * reconPtr->strideCr]);
+        inputBuffer = &((inputPicturePtr->bufferCr)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCr]);
+        residualDistortion = 0;
+        rowIndex = 0;
+
+        while (rowIndex < sequence_control_set_ptr->chroma_height) {
+
+            columnIndex = 0;
+            while (columnIndex < sequence_control_set_ptr->chroma_width) {
+                residualDistortion += (int64_t)SQR((int64_t)(inputBuffer[columnIndex]) - (reconCoeffBuffer[columnIndex]));
+                ++columnIndex;
+            }
+
+            inputBuffer += inputPicturePtr->strideCr;
+            reconCoeffBuffer += reconPtr->strideCr;
+            ++rowIndex;
+        }
+
+        sseTotal[2] = residualDistortion;
+        picture_control_set_ptr->parent_pcs_ptr->luma_sse = sseTotal[0];
+        picture_control_set_ptr->parent_pcs_ptr->cb_sse = sseTotal[1];
+        picture_control_set_ptr->parent_pcs_ptr->cr_sse = sseTotal[2];
+    }
+    else {
+
+        EbPictureBufferDesc_t *reconPtr;
+
+        if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
+            reconPtr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->referencePicture16bit;
+        else
+            reconPtr = picture_control_set_ptr->recon_picture16bit_ptr;
+        EbPictureBufferDesc_t *inputPicturePtr = (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
+
+        uint64_t sseTotal[3] = { 0 };
+        uint32_t   columnIndex;
+        uint32_t   rowIndex = 0;
+        uint64_t   residualDistortion = 0;
+        EbByte  inputBuffer;
+        EbByte  inputBufferBitInc;
+        uint16_t*  reconCoeffBuffer;
+
+        if (sequence_control_set_ptr->static_config.ten_bit_format == 1) {
+
+            const uint32_t luma_width = sequence_control_set_ptr->luma_width;
+            const uint32_t luma_height = sequence_control_set_ptr->luma_height;
+            const uint32_t chroma_width = sequence_control_set_ptr->chroma_width;
+            const uint32_t picture_width_in_sb = (luma_width + 64 - 1) / 64;
+            const uint32_t pictureHeighInLcu = (luma_height + 64 - 1) / 64;
+            const uint32_t luma2BitWidth = luma_width / 4;
+            const uint32_t chroma_height = luma_height / 2;
+            const uint32_t chroma2BitWidth = luma_width / 8;
+            uint32_t lcuNumberInHeight, lcuNumberInWidth;
+
+            EbByte  inputBufferOrg = &((inputPicturePtr->bufferY)[inputPicturePtr->origin_x + inputPicturePtr->origin_y * inputPicturePtr->strideY]);
+            uint16_t*  reconBufferOrg = (uint16_t*)(&((reconPtr->bufferY)[(reconPtr->origin_x << is16bit) + (reconPtr->origin_y << is16bit) * reconPtr->strideY]));;
+
+            EbByte  inputBufferOrgU = &((inputPicturePtr->bufferCb)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCb]);;
+            uint16_t*  reconBufferOrgU = reconCoeffBuffer = (uint16_t*)(&((reconPtr->bufferCb)[(reconPtr->origin_x << is16bit) / 2 + (reconPtr->origin_y << is16bit) / 2 * reconPtr->strideCb]));;
+
+            EbByte  inputBufferOrgV = &((inputPicturePtr->bufferCr)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCr]);;
+            uint16_t*  reconBufferOrgV = reconCoeffBuffer = (uint16_t*)(&((reconPtr->bufferCr)[(reconPtr->origin_x << is16bit) / 2 + (reconPtr->origin_y << is16bit) / 2 * reconPtr->strideCr]));;
+
+            residualDistortion = 0;
+            uint64_t residualDistortionU = 0;
+            uint64_t residualDistortionV = 0;
+
+            for (lcuNumberInHeight = 0; lcuNumberInHeight < pictureHeighInLcu; ++lcuNumberInHeight)
+            {
+                for (lcuNumberInWidth = 0; lcuNumberInWidth < picture_width_in_sb; ++lcuNumberInWidth)
+                {
+
+                    uint32_t tbOriginX = lcuNumberInWidth * 64;
+                    uint32_t tbOriginY = lcuNumberInHeight * 64;
+                    uint32_t sb_width = (luma_width - tbOriginX) < 64 ? (luma_width - tbOriginX) : 64;
+                    uint32_t sb_height = (luma_height - tbOriginY) < 64 ? (luma_height - tbOriginY) : 64;
+
+                    inputBuffer = inputBufferOrg + tbOriginY * inputPicturePtr->strideY + tbOriginX;
+                    inputBufferBitInc = inputPicturePtr->bufferBitIncY + tbOriginY * luma2BitWidth + (tbOriginX / 4)*sb_height;
+                    reconCoeffBuffer = reconBufferOrg + tbOriginY * reconPtr->strideY + tbOriginX;
+
+                    uint64_t   j, k;
+                    uint16_t   outPixel;
+                    uint8_t    nBitPixel;
+                    uint8_t   four2bitPels;
+                    uint32_t     innStride = sb_width / 4;
+
+                    for (j = 0; j < sb_height; j++)
+                    {
+                        for (k = 0; k < sb_width / 4; k++)
+                        {
+
+                            four2bitPels = inputBufferBitInc[k + j * innStride];
+
+                            nBitPixel = (four2bitPels >> 6) & 3;
+                            outPixel = inputBuffer[k * 4 + 0 + j * inputPicturePtr->strideY] << 2;
+                            outPixel = outPixel | nBitPixel;
+                            residualDistortion += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 0 + j * reconPtr->strideY]);
+
+
+                            nBitPixel = (four2bitPels >> 4) & 3;
+                            outPixel = inputBuffer[k * 4 + 1 + j * inputPicturePtr->strideY] << 2;
+                            outPixel = outPixel | nBitPixel;
+                            residualDistortion += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 1 + j * reconPtr->strideY]);
+
+
+                            nBitPixel = (four2bitPels >> 2) & 3;
+                            outPixel = inputBuffer[k * 4 + 2 + j * inputPicturePtr->strideY] << 2;
+                            outPixel = outPixel | nBitPixel;
+                            residualDistortion += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 2 + j * reconPtr->strideY]);
+
+                            nBitPixel = (four2bitPels >> 0) & 3;
+                            outPixel = inputBuffer[k * 4 + 3 + j * inputPicturePtr->strideY] << 2;
+                            outPixel = outPixel | nBitPixel;
+                            residualDistortion += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 3 + j * reconPtr->strideY]);
+
+                        }
+                    }
+
+                    //U+V
+
+                    tbOriginX = lcuNumberInWidth * 32;
+                    tbOriginY = lcuNumberInHeight * 32;
+                    sb_width = (chroma_width - tbOriginX) < 32 ? (chroma_width - tbOriginX) : 32;
+                    sb_height = (chroma_height - tbOriginY) < 32 ? (chroma_height - tbOriginY) : 32;
+
+                    innStride = sb_width / 4;
+
+                    inputBuffer = inputBufferOrgU + tbOriginY * inputPicturePtr->strideCb + tbOriginX;
+
+                    inputBufferBitInc = inputPicturePtr->bufferBitIncCb + tbOriginY * chroma2BitWidth + (tbOriginX / 4)*sb_height;
+
+                    reconCoeffBuffer = reconBufferOrgU + tbOriginY * reconPtr->strideCb + tbOriginX;
+
+
+
+                    for (j = 0; j < sb_height; j++)
+                    {
+                        for (k = 0; k < sb_width / 4; k++)
+                        {
+
+                            four2bitPels = inputBufferBitInc[k + j * innStride];
+
+                            nBitPixel = (four2bitPels >> 6) & 3;
+                            outPixel = inputBuffer[k * 4 + 0 + j * inputPicturePtr->strideCb] << 2;
+                            outPixel = outPixel | nBitPixel;
+                            residualDistortionU += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 0 + j * reconPtr->strideCb]);
+
+
+                            nBitPixel = (four2bitPels >> 4) & 3;
+                            outPixel = inputBuffer[k * 4 + 1 + j * inputPicturePtr->strideCb] << 2;
+                            outPixel = outPixel | nBitPixel;
+                            residualDistortionU += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 1 + j * reconPtr->strideCb]);
+
+
+                            nBitPixel = (four2bitPels >> 2) & 3;
+                            outPixel = inputBuffer[k * 4 + 2 + j * inputPicturePtr->strideCb] << 2;
+                            outPixel = outPixel | nBitPixel;
+                            residualDistortionU += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 2 + j * reconPtr->strideCb]);
+
+                            nBitPixel = (four2bitPels >> 0) & 3;
+                            outPixel = inputBuffer[k * 4 + 3 + j * inputPicturePtr->strideCb] << 2;
+                            outPixel = outPixel | nBitPixel;
+                            residualDistortionU += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 3 + j * reconPtr->strideCb]);
+
+                        }
+                    }
+
+
+                    inputBuffer = inputBufferOrgV + tbOriginY * inputPicturePtr->strideCr + tbOriginX;
+                    inputBufferBitInc = inputPicturePtr->bufferBitIncCr + tbOriginY * chroma2BitWidth + (tbOriginX / 4)*sb_height;
+                    reconCoeffBuffer = reconBufferOrgV + tbOriginY * reconPtr->strideCr + tbOriginX;
+
+
+                    for (j = 0; j < sb_height; j++)
+                    {
+                        for (k = 0; k < sb_width / 4; k++)
+                        {
+
+                            four2bitPels = inputBufferBitInc[k + j * innStride];
+
+                            nBitPixel = (four2bitPels >> 6) & 3;
+                            outPixel = inputBuffer[k * 4 + 0 + j * inputPicturePtr->strideCr] << 2;
+                            outPixel = outPixel | nBitPixel;
+                            residualDistortionV += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 0 + j * reconPtr->strideCr]);
+
+
+                            nBitPixel = (four2bitPels >> 4) & 3;
+                            outPixel = inputBuffer[k * 4 + 1 + j * inputPicturePtr->strideCr] << 2;
+                            outPixel = outPixel | nBitPixel;
+                            residualDistortionV += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 1 + j * reconPtr->strideCr]);
+
+
+                            nBitPixel = (four2bitPels >> 2) & 3;
+                            outPixel = inputBuffer[k * 4 + 2 + j * inputPicturePtr->strideCr] << 2;
+                            outPixel = outPixel | nBitPixel;
+                            residualDistortionV += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 2 + j * reconPtr->strideCr]);
+
+                            nBitPixel = (four2bitPels >> 0) & 3;
+                            outPixel = inputBuffer[k * 4 + 3 + j * inputPicturePtr->strideCr] << 2;
+                            outPixel = outPixel | nBitPixel;
+                            residualDistortionV += (int64_t)SQR((int64_t)outPixel - (int64_t)reconCoeffBuffer[k * 4 + 3 + j * reconPtr->strideCr]);
+
+                        }
+                    }
+
+
+
+
+                }
+            }
+
+
+            sseTotal[0] = residualDistortion;
+            sseTotal[1] = residualDistortionU;
+            sseTotal[2] = residualDistortionV;
+        }
+        else {
+
+
+            reconCoeffBuffer = (uint16_t*)(&((reconPtr->bufferY)[(reconPtr->origin_x << is16bit) + (reconPtr->origin_y << is16bit) * reconPtr->strideY]));
+            inputBuffer = &((inputPicturePtr->bufferY)[inputPicturePtr->origin_x + inputPicturePtr->origin_y * inputPicturePtr->strideY]);
+            inputBufferBitInc = &((inputPicturePtr->bufferBitIncY)[inputPicturePtr->origin_x + inputPicturePtr->origin_y * inputPicturePtr->strideBitIncY]);
+
+            residualDistortion = 0;
+
+            while (rowIndex < sequence_control_set_ptr->luma_height) {
+
+                columnIndex = 0;
+                while (columnIndex < sequence_control_set_ptr->luma_width) {
+                    residualDistortion += (int64_t)SQR((int64_t)((((inputBuffer[columnIndex]) << 2) | ((inputBufferBitInc[columnIndex] >> 6) & 3))) - (reconCoeffBuffer[columnIndex]));
+
+                    ++columnIndex;
+                }
+
+                inputBuffer += inputPicturePtr->strideY;
+                inputBufferBitInc += inputPicturePtr->strideBitIncY;
+                reconCoeffBuffer += reconPtr->strideY;
+                ++rowIndex;
+            }
+
+            sseTotal[0] = residualDistortion;
+
+            reconCoeffBuffer = (uint16_t*)(&((reconPtr->bufferCb)[(reconPtr->origin_x << is16bit) / 2 + (reconPtr->origin_y << is16bit) / 2 * reconPtr->strideCb]));
+            inputBuffer = &((inputPicturePtr->bufferCb)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCb]);
+            inputBufferBitInc = &((inputPicturePtr->bufferBitIncCb)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideBitIncCb]);
+
+            residualDistortion = 0;
+            rowIndex = 0;
+            while (rowIndex < sequence_control_set_ptr->chroma_height) {
+
+                columnIndex = 0;
+                while (columnIndex < sequence_control_set_ptr->chroma_width) {
+                    residualDistortion += (int64_t)SQR((int64_t)((((inputBuffer[columnIndex]) << 2) | ((inputBufferBitInc[columnIndex] >> 6) & 3))) - (reconCoeffBuffer[columnIndex]));
+                    ++columnIndex;
+                }
+
+                inputBuffer += inputPicturePtr->strideCb;
+                inputBufferBitInc += inputPicturePtr->strideBitIncCb;
+                reconCoeffBuffer += reconPtr->strideCb;
+                ++rowIndex;
+            }
+
+            sseTotal[1] = residualDistortion;
+
+            reconCoeffBuffer = (uint16_t*)(&((reconPtr->bufferCr)[(reconPtr->origin_x << is16bit) / 2 + (reconPtr->origin_y << is16bit) / 2 * reconPtr->strideCr]));
+            inputBuffer = &((inputPicturePtr->bufferCr)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideCr]);
+            inputBufferBitInc = &((inputPicturePtr->bufferBitIncCr)[inputPicturePtr->origin_x / 2 + inputPicturePtr->origin_y / 2 * inputPicturePtr->strideBitIncCr]);
+
+            residualDistortion = 0;
+            rowIndex = 0;
+
+            while (rowIndex < sequence_control_set_ptr->chroma_height) {
+
+                columnIndex = 0;
+                while (columnIndex < sequence_control_set_ptr->chroma_width) {
+                    residualDistortion += (int64_t)SQR((int64_t)((((inputBuffer[columnIndex]) << 2) | ((inputBufferBitInc[columnIndex] >> 6) & 3))) - (reconCoeffBuffer[columnIndex]));
+                    ++columnIndex;
+                }
+
+                inputBuffer += inputPicturePtr->strideCr;
+                inputBufferBitInc += inputPicturePtr->strideBitIncCr;
+                reconCoeffBuffer += reconPtr->strideCr;
+                ++rowIndex;
+            }
+
+            sseTotal[2] = residualDistortion;
+
+        }
+
+
+        picture_control_set_ptr->parent_pcs_ptr->luma_sse = sseTotal[0];
+        picture_control_set_ptr->parent_pcs_ptr->cb_sse = sseTotal[1];
+        picture_control_set_ptr->parent_pcs_ptr->cr_sse = sseTotal[2];
+    }
+}
+
+void PadRefAndSetFlags(
+    PictureControlSet_t    *picture_control_set_ptr,
+    SequenceControlSet_t   *sequence_control_set_ptr
+)
+{
+
+    EbReferenceObject_t   *referenceObject = (EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr;
+    EbPictureBufferDesc_t *refPicPtr = (EbPictureBufferDesc_t*)referenceObject->referencePicture;
+    EbPictureBufferDesc_t *refPic16BitPtr = (EbPictureBufferDesc_t*)referenceObject->referencePicture16bit;
+    EbBool                is16bit = (sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+
+    if (!is16bit) {
+        // Y samples
+        generate_padding(
+            refPicPtr->bufferY,
+            refPicPtr->strideY,
+            refPicPtr->width,
+            refPicPtr->height,
+            refPicPtr->origin_x,
+            refPicPtr->origin_y);
+
+        // Cb samples
+        generate_padding(
+            refPicPtr->bufferCb,
+            refPicPtr->strideCb,
+            refPicPtr->width >> 1,
+            refPicPtr->height >> 1,
+            refPicPtr->origin_x >> 1,
+            refPicPtr->origin_y >> 1);
+
+        // Cr samples
+        generate_padding(
+            refPicPtr->bufferCr,
+            refPicPtr->strideCr,
+            refPicPtr->width >> 1,
+            refPicPtr->height >> 1,
+            refPicPtr->origin_x >> 1,
+            refPicPtr->origin_y >> 1);
+    }
+
+    //We need this for MCP
+    if (is16bit) {
+        // Y samples
+        generate_padding16_bit(
+            refPic16BitPtr->bufferY,
+            refPic16BitPtr->strideY << 1,
+            refPic16BitPtr->width << 1,
+            refPic16BitPtr->height,
+            refPic16BitPtr->origin_x << 1,
+            refPic16BitPtr->origin_y);
+
+        // Cb samples
+        generate_padding16_bit(
+            refPic16BitPtr->bufferCb,
+            refPic16BitPtr->strideCb << 1,
+            refPic16BitPtr->width,
+            refPic16BitPtr->height >> 1,
+            refPic16BitPtr->origin_x,
+            refPic16BitPtr->origin_y >> 1);
+
+        // Cr samples
+        generate_padding16_bit(
+            refPic16BitPtr->bufferCr,
+            refPic16BitPtr->strideCr << 1,
+            refPic16BitPtr->width,
+            refPic16BitPtr->height >> 1,
+            refPic16BitPtr->origin_x,
+            refPic16BitPtr->origin_y >> 1);
+
+    }
+
+    // set up TMVP flag for the reference picture
+
+    referenceObject->tmvpEnableFlag = (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) ? EB_TRUE : EB_FALSE;
+
+    // set up the ref POC
+    referenceObject->refPOC = picture_control_set_ptr->parent_pcs_ptr->picture_number;
+
+    // set up the QP
+#if ADD_DELTA_QP_SUPPORT
+    uint16_t picture_qp = picture_control_set_ptr->parent_pcs_ptr->base_qindex;
+    referenceObject->qp = (uint16_t)picture_qp;
+#else
+    referenceObject->qp = (uint8_t)picture_control_set_ptr->parent_pcs_ptr->picture_qp;
+#endif
+
+    // set up the Slice Type
+    referenceObject->slice_type = picture_control_set_ptr->parent_pcs_ptr->slice_type;
+
+
+}
+
+void CopyStatisticsToRefObject(
+    PictureControlSet_t    *picture_control_set_ptr,
+    SequenceControlSet_t   *sequence_control_set_ptr
+)
+{
+    picture_control_set_ptr->intra_coded_area = (100 * picture_control_set_ptr->intra_coded_area) / (sequence_control_set_ptr->luma_width * sequence_control_set_ptr->luma_height);
+    if (picture_control_set_ptr->slice_type == I_SLICE)
+        picture_control_set_ptr->intra_coded_area = 0;
+
+    ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->intra_coded_area = (uint8_t)(picture_control_set_ptr->intra_coded_area);
+
+    uint32_t sb_index;
+    for (sb_index = 0; sb_index < picture_control_set_ptr->sb_total_count; ++sb_index) {
+        ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->non_moving_index_array[sb_index] = picture_control_set_ptr->parent_pcs_ptr->non_moving_index_array[sb_index];
+    }
+
+    EbReferenceObject_t  * refObjL0, *refObjL1;
+    ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->penalizeSkipflag = EB_FALSE;
+    if (picture_control_set_ptr->slice_type == B_SLICE) {
+        refObjL0 = (EbReferenceObject_t*)picture_control_set_ptr->ref_pic_ptr_array[REF_LIST_0]->objectPtr;
+        refObjL1 = (EbReferenceObject_t*)picture_control_set_ptr->ref_pic_ptr_array[REF_LIST_1]->objectPtr;
+
+        if (picture_control_set_ptr->temporal_layer_index == 0) {
+            if (picture_control_set_ptr->parent_pcs_ptr->intra_coded_block_probability > 30) {
+                ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->penalizeSkipflag = EB_TRUE;
+            }
+        }
+        else {
+            ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->penalizeSkipflag = (refObjL0->penalizeSkipflag || refObjL1->penalizeSkipflag) ? EB_TRUE : EB_FALSE;
+        }
+    }
+    ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->tmpLayerIdx = (uint8_t)picture_control_set_ptr->temporal_layer_index;
+    ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr)->isSceneChange = picture_control_set_ptr->parent_pcs_ptr->scene_change_flag;
+
+
+}
+void av1_add_film_grain(EbPictureBufferDesc_t *src,
+    EbPictureBufferDesc_t *dst,
+    aom_film_grain_t *film_grain_ptr) {
+    uint8_t *luma, *cb, *cr;
+    int32_t height, width, luma_stride, chroma_stride;
+    int32_t use_high_bit_depth = 0;
+    int32_t chroma_subsamp_x = 0;
+    int32_t chroma_subsamp_y = 0;
+
+    aom_film_grain_t params = *film_grain_ptr;
+
+    switch (src->bit_depth) {
+    case EB_8BIT:
+        params.bit_depth = 8;
+        use_high_bit_depth = 0;
+        chroma_subsamp_x = 1;
+        chroma_subsamp_y = 1;
+        break;
+    case EB_10BIT:
+        params.bit_depth = 10;
+        use_high_bit_depth = 1;
+        chroma_subsamp_x = 1;
+        chroma_subsamp_y = 1;
+        break;
+    default:  //todo: Throw an error if unknown format?
+        params.bit_depth = 10;
+        use_high_bit_depth = 1;
+        chroma_subsamp_x = 1;
+        chroma_subsamp_y = 1;
+    }
+
+    dst->maxWidth = src->maxWidth;
+    dst->maxHeight = src->maxHeight;
+
+    fgn_copy_rect(src->bufferY + ((src->origin_y * src->strideY + src->origin_x) << use_high_bit_depth), src->strideY,
+        dst->bufferY + ((dst->origin_y * dst->strideY + dst->origin_x) << use_high_bit_depth), dst->strideY,
+        dst->width, dst->height, use_high_bit_depth);
+
+    fgn_copy_rect(src->bufferCb + ((src->strideCb * (src->origin_y >> chroma_subsamp_y)
+        + (src->origin_x >> chroma_subsamp_x)) << use_high_bit_depth), src->strideCb,
+        dst->bufferCb + ((dst->strideCb * (dst->origin_y >> chroma_subsamp_y)
+            + (dst->origin_x >> chroma_subsamp_x)) << use_high_bit_depth), dst->strideCb,
+        dst->width >> chroma_subsamp_x, dst->height >> chroma_subsamp_y,
+        use_high_bit_depth);
+
+    fgn_copy_rect(src->bufferCr + ((src->strideCr * (src->origin_y >> chroma_subsamp_y)
+        + (src->origin_x >> chroma_subsamp_x)) << use_high_bit_depth), src->strideCr,
+        dst->bufferCr + ((dst->strideCr * (dst->origin_y >> chroma_subsamp_y)
+            + (dst->origin_x >> chroma_subsamp_x)) << use_high_bit_depth), dst->strideCr,
+        dst->width >> chroma_subsamp_x, dst->height >> chroma_subsamp_y,
+        use_high_bit_depth);
+
+    luma = dst->bufferY + ((dst->origin_y * dst->strideY + dst->origin_x) << use_high_bit_depth);
+    cb = dst->bufferCb + ((dst->strideCb * (dst->origin_y >> chroma_subsamp_y)
+        + (dst->origin_x >> chroma_subsamp_x)) << use_high_bit_depth);
+    cr = dst->bufferCr + ((dst->strideCr * (dst->origin_y >> chroma_subsamp_y)
+        + (dst->origin_x >> chroma_subsamp_x)) << use_high_bit_depth);
+
+    luma_stride = dst->strideY;
+    chroma_stride = dst->strideCb;
+
+    width = dst->width;
+    height = dst->height;
+
+    av1_add_film_grain_run(&params, luma, cb, cr, height, width, luma_stride,
+        chroma_stride, use_high_bit_depth, chroma_subsamp_y,
+        chroma_subsamp_x);
+    return;
+}
+
+/******************************************************
+ * Filter Start Pass
+ *   posts the tasks waking up the other filter threads
+ ******************************************************/
+static void FilterStartPass(
+    FilterContext_t         *context_ptr,
+    EbObjectWrapper_t       *pictureControlSetWrapperPtr,
+    uint8_t                  filter_pass,
+    uint32_t                 job_count)
+{
+    PictureControlSet_t *picture_control_set_ptr = (PictureControlSet_t*)pictureControlSetWrapperPtr->objectPtr;
+    EbObjectWrapper_t *filterTasksWrapperPtr;
+    FilterTasks_t     *filterTasksPtr;
+    uint32_t           helperCount = MIN(job_count, context_ptr->filter_process_count);
+    uint32_t           helperIndex;
+
+    // The calling thread works on the pass as well
+    helperCount = (helperCount > 0) ? helperCount - 1 : 0;
+
+    EbBlockOnMutex(picture_control_set_ptr->filter_mutex);
+    picture_control_set_ptr->filter_pass = filter_pass;
+    picture_control_set_ptr->filter_job_count = job_count;
+    picture_control_set_ptr->filter_job_next = 0;
+    picture_control_set_ptr->filter_job_done = 0;
+    picture_control_set_ptr->filter_active_count += helperCount;
+    EbReleaseMutex(picture_control_set_ptr->filter_mutex);
+
+    for (helperIndex = 0; helperIndex < helperCount; ++helperIndex) {
+        EbGetEmptyObject(
+            context_ptr->filter_feedback_fifo_ptr,
+            &filterTasksWrapperPtr);
+        filterTasksPtr = (FilterTasks_t*)filterTasksWrapperPtr->objectPtr;
+        filterTasksPtr->pictureControlSetWrapperPtr = pictureControlSetWrapperPtr;
+        filterTasksPtr->inputType = FILTER_TASKS_CONTINUE;
+
+        EbPostFullObject(filterTasksWrapperPtr);
+    }
+}
+
+static EbPictureBufferDesc_t *FilterReconPicture(
+    PictureControlSet_t     *picture_control_set_ptr,
+    EbBool                   is16bit)
+{
+    if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE && picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr) {
+        EbReferenceObject_t *referenceObject = (EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr;
+        return is16bit ? referenceObject->referencePicture16bit : referenceObject->referencePicture;
+    }
+    return is16bit ? picture_control_set_ptr->recon_picture16bit_ptr : picture_control_set_ptr->recon_picture_ptr;
+}
+
+/******************************************************
+ * Filter Picture Done
+ *   post-filter work, runs once the restoration is applied
+ ******************************************************/
+static void FilterPictureDone(
+    FilterContext_t         *context_ptr,
+    SequenceControlSet_t    *sequence_control_set_ptr,
+    PictureControlSet_t     *picture_control_set_ptr)
+{
+    EbObjectWrapper_t       *pictureDemuxResultsWrapperPtr;
+    PictureDemuxResults_t   *pictureDemuxResultsPtr;
+
+    if (picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) {
+        // copy stat to ref object (intra_coded_area, Luminance, Scene change detection flags)
+        CopyStatisticsToRefObject(
+            picture_control_set_ptr,
+            sequence_control_set_ptr);
+    }
+
+    // PSNR Calculation
+    if (sequence_control_set_ptr->static_config.stat_report || sequence_control_set_ptr->static_config.frame_stats == 2) {
+        PsnrCalculations(
+            picture_control_set_ptr,
+            sequence_control_set_ptr);
+    }
+
+    // Pad the reference picture and set up TMVP flag and ref POC
+    if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
+        PadRefAndSetFlags(
+            picture_control_set_ptr,
+            sequence_control_set_ptr);
+
+    if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE && picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr)
+    {
+        EbPictureBufferDesc_t *inputPicturePtr = (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
+        const uint32_t  SrclumaOffSet = inputPicturePtr->origin_x + inputPicturePtr->origin_y    *inputPicturePtr->strideY;
+        const uint32_t  SrccbOffset = (inputPicturePtr->origin_x >> 1) + (inputPicturePtr->origin_y >> 1)*inputPicturePtr->strideCb;
+        const uint32_t  SrccrOffset = (inputPicturePtr->origin_x >> 1) + (inputPicturePtr->origin_y >> 1)*inputPicturePtr->strideCr;
+
+        EbReferenceObject_t   *referenceObject = (EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->objectPtr;
+        EbPictureBufferDesc_t *refDenPic = referenceObject->refDenSrcPicture;
+        const uint32_t           ReflumaOffSet = refDenPic->origin_x + refDenPic->origin_y    *refDenPic->strideY;
+        const uint32_t           RefcbOffset = (refDenPic->origin_x >> 1) + (refDenPic->origin_y >> 1)*refDenPic->strideCb;
+        const uint32_t           RefcrOffset = (refDenPic->origin_x >> 1) + (refDenPic->origin_y >> 1)*refDenPic->strideCr;
+
+        uint16_t  verticalIdx;
+
+        for (verticalIdx = 0; verticalIdx < refDenPic->height; ++verticalIdx)
+        {
+            EB_MEMCPY(refDenPic->bufferY + ReflumaOffSet + verticalIdx * refDenPic->strideY,
+                inputPicturePtr->bufferY + SrclumaOffSet + verticalIdx * inputPicturePtr->strideY,
+                inputPicturePtr->width);
+        }
+
+        for (verticalIdx = 0; verticalIdx < inputPicturePtr->height / 2; ++verticalIdx)
+        {
+            EB_MEMCPY(refDenPic->bufferCb + RefcbOffset + verticalIdx * refDenPic->strideCb,
+                inputPicturePtr->bufferCb + SrccbOffset + verticalIdx * inputPicturePtr->strideCb,
+                inputPicturePtr->width / 2);
+
+            EB_MEMCPY(refDenPic->bufferCr + RefcrOffset + verticalIdx * refDenPic->strideCr,
+                inputPicturePtr->bufferCr + SrccrOffset + verticalIdx * inputPicturePtr->strideCr,
+                inputPicturePtr->width / 2);
+        }
+
+        generate_padding(
+            refDenPic->bufferY,
+            refDenPic->strideY,
+            refDenPic->width,
+            refDenPic->height,
+            refDenPic->origin_x,
+            refDenPic->origin_y);
+
+        generate_padding(
+            refDenPic->bufferCb,
+            refDenPic->strideCb,
+            refDenPic->width >> 1,
+            refDenPic->height >> 1,
+            refDenPic->origin_x >> 1,
+            refDenPic->origin_y >> 1);
+
+        generate_padding(
+            refDenPic->bufferCr,
+            refDenPic->strideCr,
+            refDenPic->width >> 1,
+            refDenPic->height >> 1,
+            refDenPic->origin_x >> 1,
+            refDenPic->origin_y >> 1);
+    }
+    if (sequence_control_set_ptr->static_config.recon_enabled) {
+        ReconOutput(
+            picture_control_set_ptr,
+            sequence_control_set_ptr);
+    }
+
+    if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
+
+        // Get Empty Picture Demux Results
+        EbGetEmptyObject(
+            context_ptr->picture_demux_output_fifo_ptr,
+            &pictureDemuxResultsWrapperPtr);
+
+        pictureDemuxResultsPtr = (PictureDemuxResults_t*)pictureDemuxResultsWrapperPtr->objectPtr;
+        pictureDemuxResultsPtr->reference_picture_wrapper_ptr = picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr;
+        pictureDemuxResultsPtr->sequence_control_set_wrapper_ptr = picture_control_set_ptr->sequence_control_set_wrapper_ptr;
+        pictureDemuxResultsPtr->picture_number = picture_control_set_ptr->picture_number;
+        pictureDemuxResultsPtr->pictureType = EB_PIC_REFERENCE;
+
+        // Post Reference Picture
+        EbPostFullObject(pictureDemuxResultsWrapperPtr);
+    }
+}
+
+/******************************************************
+ * Filter Finish Pass
+ *   serial work between two passes, run by the thread
+ *   finishing the last job of the pass
+ ******************************************************/
+static void FilterFinishPass(
+    FilterContext_t         *context_ptr,
+    EbObjectWrapper_t       *pictureControlSetWrapperPtr)
+{
+    PictureControlSet_t     *picture_control_set_ptr = (PictureControlSet_t*)pictureControlSetWrapperPtr->objectPtr;
+    SequenceControlSet_t    *sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->objectPtr;
+    Av1Common               *cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+    EbBool                   is16bit = context_ptr->is16bit;
+    uint8_t                  filter_pass = picture_control_set_ptr->filter_pass;
+    uint32_t                 job_count = 0;
+
+    // Passes without jobs are chained here
+    while (filter_pass != FILTER_PASS_DONE && job_count == 0) {
+
+        switch (filter_pass) {
+        case FILTER_PASS_DLF:
+
+            LinkEbToAomBufferDesc(
+                FilterReconPicture(picture_control_set_ptr, is16bit),
+                cm->frame_to_show);
+
+            if (sequence_control_set_ptr->enable_restoration) {
+                av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
+            }
+
+#if CDEF_REF_ONLY
+            if (sequence_control_set_ptr->enable_cdef && picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
+#else
+            if (sequence_control_set_ptr->enable_cdef) {
+#endif
+                job_count = (cm->mi_rows + MI_SIZE_64X64 - 1) / MI_SIZE_64X64;
+            }
+            else {
+
+#if CDEF_REF_ONLY
+                picture_control_set_ptr->parent_pcs_ptr->cdef_bits = 0;
+                picture_control_set_ptr->parent_pcs_ptr->cdef_strengths[0] = 0;
+                picture_control_set_ptr->parent_pcs_ptr->nb_cdef_strengths = 1;
+                picture_control_set_ptr->parent_pcs_ptr->cdef_uv_strengths[0] = 0;
+#else
+                picture_control_set_ptr->parent_pcs_ptr->cdef_bits = 0;
+
+                picture_control_set_ptr->parent_pcs_ptr->nb_cdef_strengths = 0;
+#endif
+            }
+            filter_pass = FILTER_PASS_CDEF;
+            break;
+
+        case FILTER_PASS_CDEF:
+
+#if CDEF_REF_ONLY
+            if (sequence_control_set_ptr->enable_cdef && picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
+#else
+            if (sequence_control_set_ptr->enable_cdef) {
+#endif
+                av1_cdef_search_finish(
+                    sequence_control_set_ptr,
+                    picture_control_set_ptr);
+
+                if (is16bit) {
+                    av1_cdef_frame16bit(
+                        sequence_control_set_ptr,
+                        picture_control_set_ptr);
+                }
+                else {
+                    av1_cdef_frame(
+                        sequence_control_set_ptr,
+                        picture_control_set_ptr);
+                }
+            }
+
+#if REST_REF_ONLY
+            if (sequence_control_set_ptr->enable_restoration && picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
+#else
+            if (sequence_control_set_ptr->enable_restoration) {
+#endif
+                av1_loop_restoration_save_boundary_lines(
+                    cm->frame_to_show,
+                    cm,
+                    1);
+
+                av1_pick_filter_restoration_init(
+                    cm,
+                    picture_control_set_ptr->parent_pcs_ptr->rusi_picture);
+
+                job_count = cm->rst_info[0].vert_units_per_tile +
+                    cm->rst_info[1].vert_units_per_tile +
+                    cm->rst_info[2].vert_units_per_tile;
+            }
+            filter_pass = FILTER_PASS_REST;
+            break;
+
+        case FILTER_PASS_REST:
+
+#if REST_REF_ONLY
+            if (sequence_control_set_ptr->enable_restoration && picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
+#else
+            if (sequence_control_set_ptr->enable_restoration) {
+#endif
+                Yv12BufferConfig cpi_source;
+                LinkEbToAomBufferDesc(
+                    is16bit ? picture_control_set_ptr->input_frame16bit : picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+                    &cpi_source);
+
+                av1_pick_filter_restoration_finish(
+                    &cpi_source,
+                    picture_control_set_ptr->parent_pcs_ptr->av1x,
+                    cm,
+                    picture_control_set_ptr->parent_pcs_ptr->rusi_picture);
+
+                if (cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
+                    cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
+                    cm->rst_info[2].frame_restoration_type != RESTORE_NONE)
+                {
+                    av1_loop_restoration_filter_frame(
+                        cm->frame_to_show,
+                        cm,
+                        0);
+                }
+            }
+            else {
+                cm->rst_info[0].frame_restoration_type = RESTORE_NONE;
+                cm->rst_info[1].frame_restoration_type = RESTORE_NONE;
+                cm->rst_info[2].frame_restoration_type = RESTORE_NONE;
+            }
+
+            FilterPictureDone(
+                context_ptr,
+                sequence_control_set_ptr,
+                picture_control_set_ptr);
+
+            filter_pass = FILTER_PASS_DONE;
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    FilterStartPass(
+        context_ptr,
+        pictureControlSetWrapperPtr,
+        filter_pass,
+        job_count);
+}
+
+/******************************************************
+ * Filter Run Job
+ ******************************************************/
+static void FilterRunJob(
+    FilterContext_t         *context_ptr,
+    PictureControlSet_t     *picture_control_set_ptr,
+    uint8_t                  filter_pass,
+    uint32_t                 job_index)
+{
+    SequenceControlSet_t    *sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->objectPtr;
+    Av1Common               *cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+    EbBool                   is16bit = context_ptr->is16bit;
+
+    switch (filter_pass) {
+    case FILTER_PASS_DLF:
+        av1_loop_filter_sb_row(
+            FilterReconPicture(picture_control_set_ptr, is16bit),
+            picture_control_set_ptr,
+            job_index,
+            0,
+            3);
+        break;
+
+    case FILTER_PASS_CDEF:
+        av1_cdef_search_sb_row(
+            job_index,
+            sequence_control_set_ptr,
+            picture_control_set_ptr);
+        break;
+
+    case FILTER_PASS_REST:
+    {
+        // The jobs are the restoration unit rows of the three planes
+        int32_t plane = 0;
+        while (job_index >= (uint32_t)cm->rst_info[plane].vert_units_per_tile) {
+            job_index -= cm->rst_info[plane].vert_units_per_tile;
+            ++plane;
+        }
+
+        Yv12BufferConfig cpi_source;
+        LinkEbToAomBufferDesc(
+            is16bit ? picture_control_set_ptr->input_frame16bit : picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+            &cpi_source);
+
+        Yv12BufferConfig trial_frame_rst;
+        LinkEbToAomBufferDesc(
+            context_ptr->trial_frame_rst,
+            &trial_frame_rst);
+
+        av1_pick_filter_restoration_rows(
+            &cpi_source,
+            &trial_frame_rst,
+            context_ptr->rst_tmpbuf,
+            picture_control_set_ptr->parent_pcs_ptr->av1x,
+            cm,
+            picture_control_set_ptr->parent_pcs_ptr->rusi_picture[plane],
+            plane,
+            job_index,
+            job_index + 1);
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+/******************************************************
+ * Filter Picture Init
+ *   picks the loop filter levels, runs once per picture
+ ******************************************************/
+static void FilterPictureInit(
+    FilterContext_t         *context_ptr,
+    EbObjectWrapper_t       *pictureControlSetWrapperPtr)
+{
+    PictureControlSet_t     *picture_control_set_ptr = (PictureControlSet_t*)pictureControlSetWrapperPtr->objectPtr;
+    SequenceControlSet_t    *sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->objectPtr;
+    uint32_t                 job_count = 0;
+
+    // No other thread knows about the picture yet
+    picture_control_set_ptr->filter_active_count = 1;
+    picture_control_set_ptr->filter_pass = FILTER_PASS_DLF;
+
+#if AV1_LF && AV1_LF_FULL_IMAGE_SELECTION
+    EbBool dlfEnableFlag = (EbBool)(!sequence_control_set_ptr->static_config.disable_dlf_flag &&
+        (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag ||
+            sequence_control_set_ptr->static_config.recon_enabled ||
+            sequence_control_set_ptr->static_config.stat_report ||
+            sequence_control_set_ptr->static_config.frame_stats == 2));
+
+    if (dlfEnableFlag) {
+        // Indexed by LoopFilterSearch
+        static const LPF_PICK_METHOD pickMethods[] = { LPF_PICK_FROM_FULL_IMAGE, LPF_PICK_FROM_SUBIMAGE, LPF_PICK_FROM_Q };
+        av1_loop_filter_init(picture_control_set_ptr);
+
+        av1_pick_filter_level(
+            context_ptr->is16bit ? context_ptr->temp_lf_recon_picture16bit_ptr : context_ptr->temp_lf_recon_picture_ptr,
+            (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+            picture_control_set_ptr,
+            pickMethods[sequence_control_set_ptr->static_config.loop_filter_search]);
+
+#if NO_ENCDEC
+        //NO DLF
+        picture_control_set_ptr->parent_pcs_ptr->lf.filter_level[0] = 0;
+        picture_control_set_ptr->parent_pcs_ptr->lf.filter_level[1] = 0;
+        picture_control_set_ptr->parent_pcs_ptr->lf.filter_level_u = 0;
+        picture_control_set_ptr->parent_pcs_ptr->lf.filter_level_v = 0;
+#endif
+        av1_loop_filter_frame_init(picture_control_set_ptr, 0, 3);
+
+        job_count = (sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix;
+    }
+#endif
+
+    if (job_count)
+        FilterStartPass(
+            context_ptr,
+            pictureControlSetWrapperPtr,
+            FILTER_PASS_DLF,
+            job_count);
+    else
+        FilterFinishPass(
+            context_ptr,
+            pictureControlSetWrapperPtr);
+}
+
+/******************************************************
+ * Filter Kernel
+ ******************************************************/
+void* FilterKernel(void *input_ptr)
+{
+    // Context & SCS & PCS
+    FilterContext_t                         *context_ptr = (FilterContext_t*)input_ptr;
+    PictureControlSet_t                     *picture_control_set_ptr;
+
+    // Input
+    EbObjectWrapper_t                       *filterTasksWrapperPtr;
+    FilterTasks_t                           *filterTasksPtr;
+
+    // Output
+    EbObjectWrapper_t                       *encDecResultsWrapperPtr;
+    EncDecResults_t                         *encDecResultsPtr;
+
+    uint8_t                                  filter_pass;
+    uint32_t                                 job_index;
+    EbBool                                   lastJobFlag;
+    EbBool                                   lastThreadFlag;
+
+    for (;;) {
+
+        // Get Filter Task
+        EbGetFullObject(
+            context_ptr->filter_input_fifo_ptr,
+            &filterTasksWrapperPtr);
+
+        filterTasksPtr = (FilterTasks_t*)filterTasksWrapperPtr->objectPtr;
+        picture_control_set_ptr = (PictureControlSet_t*)filterTasksPtr->pictureControlSetWrapperPtr->objectPtr;
+
+        if (filterTasksPtr->inputType == FILTER_TASKS_ENCDEC_INPUT) {
+            FilterPictureInit(
+                context_ptr,
+                filterTasksPtr->pictureControlSetWrapperPtr);
+        }
+
+        // Run the jobs of the current pass until none is left
+        for (;;) {
+            EbBlockOnMutex(picture_control_set_ptr->filter_mutex);
+            if (picture_control_set_ptr->filter_job_next == picture_control_set_ptr->filter_job_count) {
+                EbReleaseMutex(picture_control_set_ptr->filter_mutex);
+                break;
+            }
+            filter_pass = picture_control_set_ptr->filter_pass;
+            job_index = picture_control_set_ptr->filter_job_next++;
+            EbReleaseMutex(picture_control_set_ptr->filter_mutex);
+
+            FilterRunJob(
+                context_ptr,
+                picture_control_set_ptr,
+                filter_pass,
+                job_index);
+
+            EbBlockOnMutex(picture_control_set_ptr->filter_mutex);
+            lastJobFlag = (EbBool)(++picture_control_set_ptr->filter_job_done == picture_control_set_ptr->filter_job_count);
+            EbReleaseMutex(picture_control_set_ptr->filter_mutex);
+
+            if (lastJobFlag) {
+                FilterFinishPass(
+                    context_ptr,
+                    filterTasksPtr->pictureControlSetWrapperPtr);
+            }
+        }
+
+        EbBlockOnMutex(picture_control_set_ptr->filter_mutex);
+        lastThreadFlag = (EbBool)(--picture_control_set_ptr->filter_active_count == 0);
+        EbReleaseMutex(picture_control_set_ptr->filter_mutex);
+
+        // The last thread leaving the picture sends its tiles to the entropy coders. In SB
+        // row latency mode the encdec already sent them, and the entropy coding only learns that
+        // the frame header fields set by the filters are final.
+        if (lastThreadFlag) {
+            SequenceControlSet_t *sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->objectPtr;
+            Av1Common *cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+            uint16_t tileCount = sequence_control_set_ptr->static_config.low_latency == EB_SB_ROW_LATENCY ? 1 : (uint16_t)(cm->tile_cols * cm->tile_rows);
+            uint16_t tileIndex;
+
+            PictureStageDone(
+                picture_control_set_ptr->parent_pcs_ptr,
+                LATENCY_STAGE_FILTER);
+
+            for (tileIndex = 0; tileIndex < tileCount; ++tileIndex) {
+
+                // Get Empty EncDec Results
+                EbGetEmptyObject(
+                    context_ptr->filter_output_fifo_ptr,
+                    &encDecResultsWrapperPtr);
+                encDecResultsPtr = (EncDecResults_t*)encDecResultsWrapperPtr->objectPtr;
+                encDecResultsPtr->pictureControlSetWrapperPtr = filterTasksPtr->pictureControlSetWrapperPtr;
+                encDecResultsPtr->tile_index = tileIndex;
+                encDecResultsPtr->inputType = sequence_control_set_ptr->static_config.low_latency == EB_SB_ROW_LATENCY ? ENCDEC_RESULTS_FILTER_DONE_INPUT : ENCDEC_RESULTS_TILE_INPUT;
+                // Post EncDec Results
+                EbPostFullObject(encDecResultsWrapperPtr);
+            }
+        }
+
+        // Release Filter Task
+        EbReleaseObject(filterTasksWrapperPtr);
+    }
+    return EB_NULL;
+}
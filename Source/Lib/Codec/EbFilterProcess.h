@@ -0,0 +1,57 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbFilterProcess_h
+#define EbFilterProcess_h
+
+#include "EbDefinitions.h"
+#include "EbSystemResourceManager.h"
+#include "EbPictureBufferDesc.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**************************************
+     * Filter Context
+     **************************************/
+    typedef struct FilterContext_s
+    {
+        EbFifo_t                              *filter_input_fifo_ptr;
+        EbFifo_t                              *filter_output_fifo_ptr;          // to entropy coding
+        EbFifo_t                              *filter_feedback_fifo_ptr;        // to the other filter threads
+        EbFifo_t                              *picture_demux_output_fifo_ptr;   // to picture manager
+
+        uint32_t                               filter_process_count;
+
+        // Per thread buffers of the loop filter level search and of the restoration search
+        EbPictureBufferDesc_t                 *temp_lf_recon_picture_ptr;
+        EbPictureBufferDesc_t                 *temp_lf_recon_picture16bit_ptr;
+        EbPictureBufferDesc_t                 *trial_frame_rst;
+        int32_t                               *rst_tmpbuf;
+
+        EbBool                                 is16bit;
+    } FilterContext_t;
+
+    /**************************************
+     * Extern Function Declarations
+     **************************************/
+    extern EbErrorType filter_context_ctor(
+        FilterContext_t **context_dbl_ptr,
+        EbFifo_t         *filter_input_fifo_ptr,
+        EbFifo_t         *filter_output_fifo_ptr,
+        EbFifo_t         *filter_feedback_fifo_ptr,
+        EbFifo_t         *picture_demux_output_fifo_ptr,
+        uint32_t          filter_process_count,
+        EbBool            is16bit,
+        uint32_t          max_input_luma_width,
+        uint32_t          max_input_luma_height);
+
+    extern void* FilterKernel(void *input_ptr);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbFilterProcess_h
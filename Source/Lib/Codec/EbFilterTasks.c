@@ -0,0 +1,23 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdlib.h>
+
+#include "EbDefinitions.h"
+#include "EbFilterTasks.h"
+
+EbErrorType FilterTasksCtor(
+    EbPtr *object_dbl_ptr,
+    EbPtr object_init_data_ptr)
+{
+    FilterTasks_t *context_ptr;
+    EB_MALLOC(FilterTasks_t*, context_ptr, sizeof(FilterTasks_t), EB_N_PTR);
+
+    *object_dbl_ptr = (EbPtr)context_ptr;
+
+    (void)object_init_data_ptr;
+
+    return EB_ErrorNone;
+}
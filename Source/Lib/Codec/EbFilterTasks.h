@@ -0,0 +1,38 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbFilterTasks_h
+#define EbFilterTasks_h
+
+#include "EbDefinitions.h"
+#include "EbSystemResourceManager.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+#define FILTER_TASKS_ENCDEC_INPUT   0
+#define FILTER_TASKS_CONTINUE       1
+
+    /**************************************
+     * Process Results
+     **************************************/
+    typedef struct FilterTasks_s
+    {
+        EbObjectWrapper_t            *pictureControlSetWrapperPtr;
+        uint32_t                        inputType;
+
+    } FilterTasks_t;
+
+    /**************************************
+     * Extern Function Declarations
+     **************************************/
+    extern EbErrorType FilterTasksCtor(
+        EbPtr *object_dbl_ptr,
+        EbPtr object_init_data_ptr);
+
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbFilterTasks_h
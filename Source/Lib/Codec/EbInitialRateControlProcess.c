@@ -1692,6 +1692,10 @@ void* InitialRateControlKernel(void *input_ptr)
             sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->objectPtr;
             encode_context_ptr = (EncodeContext_t*)sequence_control_set_ptr->encode_context_ptr;
 
+            PictureStageDone(
+                picture_control_set_ptr,
+                LATENCY_STAGE_MOTION_ESTIMATION);
+
             // Mark picture when global motion is detected using ME results
             //reset intraCodedEstimationLcu
             MeBasedGlobalMotionDetection(
@@ -1715,7 +1719,7 @@ void* InitialRateControlKernel(void *input_ptr)
                 picture_control_set_ptr,
                 inputResultsPtr);
 
-            if (sequence_control_set_ptr->static_config.rate_control_mode)
+            if (sequence_control_set_ptr->static_config.rate_control_mode == 1)
             {
                 if (sequence_control_set_ptr->static_config.look_ahead_distance != 0) {
 
@@ -1901,7 +1905,7 @@ void* InitialRateControlKernel(void *input_ptr)
                     else
                         picture_control_set_ptr->end_of_sequence_region = EB_FALSE;
 
-                    if (sequence_control_set_ptr->static_config.rate_control_mode)
+                    if (sequence_control_set_ptr->static_config.rate_control_mode == 1)
                     {
                         // Determine offset from the Head Ptr for HLRC histogram queue and set the life count
                         if (sequence_control_set_ptr->static_config.look_ahead_distance != 0) {
@@ -1981,6 +1985,20 @@ void* InitialRateControlKernel(void *input_ptr)
                     EbObjectIncLiveCount(
                         ((PictureParentControlSet_t*)(queueEntryPtr->parentPcsWrapperPtr->objectPtr))->reference_picture_wrapper_ptr,
                         1);
+
+                    // Frame context adaptation: the frame context kept by the last picture using the object is no
+                    // longer loaded, and a reference picture holds the object until it has kept its own
+                    {
+                        EbReferenceObject_t *referenceObject = (EbReferenceObject_t*)reference_picture_wrapper_ptr->objectPtr;
+
+                        if (referenceObject->frame_context_saved) {
+                            EbBlockOnSemaphore(referenceObject->frame_context_semaphore);
+                            referenceObject->frame_context_saved = EB_FALSE;
+                        }
+                        if (sequence_control_set_ptr->static_config.frame_context_adaptation &&
+                            ((PictureParentControlSet_t*)(queueEntryPtr->parentPcsWrapperPtr->objectPtr))->is_used_as_reference_flag)
+                            EbObjectIncLiveCount(reference_picture_wrapper_ptr, 1);
+                    }
                     //OPTION 1:  get the output stream buffer in ressource coordination
                     EbGetEmptyObject(
                         sequence_control_set_ptr->encode_context_ptr->stream_output_fifo_ptr,
@@ -1988,6 +2006,20 @@ void* InitialRateControlKernel(void *input_ptr)
 
                     picture_control_set_ptr->output_stream_wrapper_ptr = output_stream_wrapper_ptr;
 
+                    // Tile group output: the headers go to the buffer above, each tile group to its own
+                    picture_control_set_ptr->tile_group_count = 0;
+                    if (sequence_control_set_ptr->static_config.tile_group_output) {
+                        uint16_t tileIdx;
+                        ((EbBufferHeaderType*)output_stream_wrapper_ptr->objectPtr)->n_filled_len = 0;
+                        picture_control_set_ptr->tile_group_count = (uint16_t)(picture_control_set_ptr->av1_cm->tile_cols * picture_control_set_ptr->av1_cm->tile_rows);
+                        for (tileIdx = 0; tileIdx < picture_control_set_ptr->tile_group_count; ++tileIdx) {
+                            EbGetEmptyObject(
+                                sequence_control_set_ptr->encode_context_ptr->stream_output_fifo_ptr,
+                                &picture_control_set_ptr->tile_group_stream_wrapper_ptr_array[tileIdx]);
+                            ((EbBufferHeaderType*)picture_control_set_ptr->tile_group_stream_wrapper_ptr_array[tileIdx]->objectPtr)->n_filled_len = 0;
+                        }
+                    }
+
 
                     // Get Empty Results Object
                     EbGetEmptyObject(
@@ -43,6 +43,10 @@ extern "C" {
         ModeDecisionCandidateBuffer_t          *candidate_buffer_ptr,
         EbAsm                                   asm_type);
 
+    InterpFilterParams av1_get_interp_filter_params_with_block_size(
+        const InterpFilter                      interp_filter,
+        const int32_t                           w);
+
     EbErrorType av1_inter_prediction(
         PictureControlSet_t                    *picture_control_set_ptr,
         uint32_t                                interp_filters,
@@ -775,7 +775,7 @@ EbErrorType GenerateIntraReferenceSamplesEncodePass(
 
     *is_left_availble = (EbBool)neighborAvailable;
     // Top Left Block
-    reconArrayIndex = MAX_PICTURE_HEIGHT_SIZE + origin_x - origin_y;
+    reconArrayIndex = luma_recon_neighbor_array->leftArraySize + origin_x - origin_y;
     while (blockIndex < topLeftBlockEnd && neighborAvailable == EB_FALSE) {
 
         modeArrayIndex = GetNeighborArrayUnitTopLeftIndex(
@@ -949,7 +949,7 @@ EbErrorType GenerateIntraReferenceSamplesEncodePass(
     }
 
     // Top Left Block
-    reconArrayIndex = MAX_PICTURE_HEIGHT_SIZE + origin_x - origin_y;
+    reconArrayIndex = luma_recon_neighbor_array->leftArraySize + origin_x - origin_y;
     while (blockIndex < topLeftBlockEnd) {
 
         modeArrayIndex = GetNeighborArrayUnitTopLeftIndex(
@@ -1295,7 +1295,7 @@ EbErrorType GenerateIntraReference16bitSamplesEncodePass(
     *is_left_availble = (EbBool)neighborAvailable;
 
     // Top Left Block
-    reconArrayIndex = MAX_PICTURE_HEIGHT_SIZE + origin_x - origin_y;
+    reconArrayIndex = luma_recon_neighbor_array->leftArraySize + origin_x - origin_y;
     while (blockIndex < topLeftBlockEnd && neighborAvailable == EB_FALSE) {
 
         modeArrayIndex = GetNeighborArrayUnitTopLeftIndex(
@@ -1471,7 +1471,7 @@ EbErrorType GenerateIntraReference16bitSamplesEncodePass(
     }
 
     // Top Left Block
-    reconArrayIndex = MAX_PICTURE_HEIGHT_SIZE + origin_x - origin_y;
+    reconArrayIndex = luma_recon_neighbor_array->leftArraySize + origin_x - origin_y;
     while (blockIndex < topLeftBlockEnd) {
 
         modeArrayIndex = GetNeighborArrayUnitTopLeftIndex(
@@ -1795,7 +1795,7 @@ EbErrorType GenerateLumaIntraReference16bitSamplesEncodePass(
     *is_left_availble = (EbBool)neighborAvailable;
 
     // Top Left Block
-    reconArrayIndex = MAX_PICTURE_HEIGHT_SIZE + origin_x - origin_y;
+    reconArrayIndex = luma_recon_neighbor_array->leftArraySize + origin_x - origin_y;
     while (blockIndex < topLeftBlockEnd && neighborAvailable == EB_FALSE) {
 
         modeArrayIndex = GetNeighborArrayUnitTopLeftIndex(
@@ -1926,7 +1926,7 @@ EbErrorType GenerateLumaIntraReference16bitSamplesEncodePass(
     }
 
     // Top Left Block
-    reconArrayIndex = MAX_PICTURE_HEIGHT_SIZE + origin_x - origin_y;
+    reconArrayIndex = luma_recon_neighbor_array->leftArraySize + origin_x - origin_y;
     while (blockIndex < topLeftBlockEnd) {
 
         modeArrayIndex = GetNeighborArrayUnitTopLeftIndex(
@@ -2218,7 +2218,7 @@ EbErrorType GenerateChromaIntraReference16bitSamplesEncodePass(
 
     *is_left_availble = (EbBool)neighborAvailable;
     // Top Left Block
-    reconArrayIndex = MAX_PICTURE_HEIGHT_SIZE + origin_x - origin_y;
+    reconArrayIndex = luma_recon_neighbor_array->leftArraySize + origin_x - origin_y;
     while (blockIndex < topLeftBlockEnd && neighborAvailable == EB_FALSE) {
 
         modeArrayIndex = GetNeighborArrayUnitTopLeftIndex(
@@ -2372,7 +2372,7 @@ EbErrorType GenerateChromaIntraReference16bitSamplesEncodePass(
     }
 
     // Top Left Block
-    reconArrayIndex = MAX_PICTURE_HEIGHT_SIZE + origin_x - origin_y;
+    reconArrayIndex = luma_recon_neighbor_array->leftArraySize + origin_x - origin_y;
     while (blockIndex < topLeftBlockEnd) {
 
         modeArrayIndex = GetNeighborArrayUnitTopLeftIndex(
@@ -8606,7 +8606,7 @@ void generate_intra_reference_samples(
             if (md_context_ptr->cu_origin_x != 0)
                 memcpy(leftNeighArray + 1, md_context_ptr->luma_recon_neighbor_array->leftArray + md_context_ptr->cu_origin_y, md_context_ptr->blk_geom->bheight * 2);
             if (md_context_ptr->cu_origin_y != 0 && md_context_ptr->cu_origin_x != 0)
-                topNeighArray[0] = leftNeighArray[0] = md_context_ptr->luma_recon_neighbor_array->topLeftArray[MAX_PICTURE_HEIGHT_SIZE + md_context_ptr->cu_origin_x - md_context_ptr->cu_origin_y];
+                topNeighArray[0] = leftNeighArray[0] = md_context_ptr->luma_recon_neighbor_array->topLeftArray[md_context_ptr->luma_recon_neighbor_array->leftArraySize + md_context_ptr->cu_origin_x - md_context_ptr->cu_origin_y];
         }
 
         else if (plane == 1) {
@@ -8618,7 +8618,7 @@ void generate_intra_reference_samples(
                 memcpy(leftNeighArray + 1, md_context_ptr->cb_recon_neighbor_array->leftArray + md_context_ptr->round_origin_y / 2, md_context_ptr->blk_geom->bheight_uv * 2);
 
             if (md_context_ptr->round_origin_y != 0 && md_context_ptr->round_origin_x != 0)
-                topNeighArray[0] = leftNeighArray[0] = md_context_ptr->cb_recon_neighbor_array->topLeftArray[MAX_PICTURE_HEIGHT_SIZE / 2 + md_context_ptr->round_origin_x / 2 - md_context_ptr->round_origin_y / 2];
+                topNeighArray[0] = leftNeighArray[0] = md_context_ptr->cb_recon_neighbor_array->topLeftArray[md_context_ptr->cb_recon_neighbor_array->leftArraySize + md_context_ptr->round_origin_x / 2 - md_context_ptr->round_origin_y / 2];
         }
         else {
             if (md_context_ptr->round_origin_y != 0)
@@ -8630,7 +8630,7 @@ void generate_intra_reference_samples(
                 memcpy(leftNeighArray + 1, md_context_ptr->cr_recon_neighbor_array->leftArray + md_context_ptr->round_origin_y / 2, md_context_ptr->blk_geom->bheight_uv * 2);
 
             if (md_context_ptr->round_origin_y != 0 && md_context_ptr->round_origin_x != 0)
-                topNeighArray[0] = leftNeighArray[0] = md_context_ptr->cr_recon_neighbor_array->topLeftArray[MAX_PICTURE_HEIGHT_SIZE / 2 + md_context_ptr->round_origin_x / 2 - md_context_ptr->round_origin_y / 2];
+                topNeighArray[0] = leftNeighArray[0] = md_context_ptr->cr_recon_neighbor_array->topLeftArray[md_context_ptr->cr_recon_neighbor_array->leftArraySize + md_context_ptr->round_origin_x / 2 - md_context_ptr->round_origin_y / 2];
 
 
         }
@@ -8644,8 +8644,9 @@ void generate_intra_reference_samples(
         int32_t mirow = bl_org_y_pict >> 2;
         int32_t micol = bl_org_x_pict >> 2;
 
-        xd->up_available = (mirow > 0);
-        xd->left_available = (micol > 0);
+        av1_tile_init(&xd->tile, cm, mirow, micol);
+        xd->up_available = (mirow > xd->tile.mi_row_start);
+        xd->left_available = (micol > xd->tile.mi_col_start);
         const int32_t bw = mi_size_wide[bsize];
         const int32_t bh = mi_size_high[bsize];
 
@@ -8653,10 +8654,6 @@ void generate_intra_reference_samples(
         xd->mb_to_bottom_edge = ((cm->mi_rows - bh - mirow) * MI_SIZE) * 8;
         xd->mb_to_left_edge = -((micol * MI_SIZE) * 8);
         xd->mb_to_right_edge = ((cm->mi_cols - bw - micol) * MI_SIZE) * 8;
-        xd->tile.mi_col_start = 0;
-        xd->tile.mi_col_end = cm->mi_cols;
-        xd->tile.mi_row_start = 0;
-        xd->tile.mi_row_end = cm->mi_rows;
         xd->n8_h = bh;
         xd->n8_w = bw;
         xd->is_sec_rect = 0;
@@ -8678,9 +8675,9 @@ void generate_intra_reference_samples(
 
 
         if (ss_x && bw < mi_size_wide[BLOCK_8X8])
-            chroma_left_available = (micol - 1) > 0;//tile->mi_col_start;
+            chroma_left_available = (micol - 1) > xd->tile.mi_col_start;
         if (ss_y && bh < mi_size_high[BLOCK_8X8])
-            chroma_up_available = (mirow - 1) > 0;//tile->mi_row_start;
+            chroma_up_available = (mirow - 1) > xd->tile.mi_row_start;
 
 
         //CHKN  const MbModeInfo *const mbmi = xd->mi[0];
@@ -9355,14 +9352,13 @@ extern void av1_predict_intra_block_md(
         mirow = (cuOrgY * 2) >> 2;
         micol = (cuOrgX * 2) >> 2;
     }
+    av1_tile_init(&xd->tile, cm, mirow, micol);
+    xd->up_available &= (mirow > xd->tile.mi_row_start);
+    xd->left_available &= (micol > xd->tile.mi_col_start);
     xd->mb_to_top_edge = -((mirow * MI_SIZE) * 8);
     xd->mb_to_bottom_edge = ((cm->mi_rows - bh - mirow) * MI_SIZE) * 8;
     xd->mb_to_left_edge = -((micol * MI_SIZE) * 8);
     xd->mb_to_right_edge = ((cm->mi_cols - bw - micol) * MI_SIZE) * 8;
-    xd->tile.mi_col_start = 0;
-    xd->tile.mi_col_end = cm->mi_cols;
-    xd->tile.mi_row_start = 0;
-    xd->tile.mi_row_end = cm->mi_rows;
     xd->n8_h = bh;
     xd->n8_w = bw;
     xd->is_sec_rect = 0;
@@ -9568,8 +9564,10 @@ extern void av1_predict_intra_block(
     int32_t mirow = bl_org_y_pict >> 2;
     int32_t micol = bl_org_x_pict >> 2;
 #if INTRA_CORE_OPT
-    int32_t up_available = (mirow > 0);
-    int32_t left_available = (micol > 0);
+    TileInfo tile;
+    av1_tile_init(&tile, cm, mirow, micol);
+    int32_t up_available = (mirow > tile.mi_row_start);
+    int32_t left_available = (micol > tile.mi_col_start);
     const int32_t bw = mi_size_wide[bsize];
     const int32_t bh = mi_size_high[bsize];
 
@@ -9578,13 +9576,13 @@ extern void av1_predict_intra_block(
     int32_t mb_to_left_edge = -((micol * MI_SIZE) * 8);
     int32_t mb_to_right_edge = ((cm->mi_cols - bw - micol) * MI_SIZE) * 8;
 
-    // OMK to be changed in case of tiles
-    int32_t  tile_mi_col_end = cm->mi_cols;       //  xd->tile.mi_col_end = cm->mi_cols;
-    int32_t  tile_mi_row_end = cm->mi_rows;       //  xd->tile.mi_row_end = cm->mi_rows;
+    int32_t  tile_mi_col_end = tile.mi_col_end;
+    int32_t  tile_mi_row_end = tile.mi_row_end;
 
 #else
-    xd->up_available = (mirow > 0);
-    xd->left_available = (micol > 0);
+    av1_tile_init(&xd->tile, cm, mirow, micol);
+    xd->up_available = (mirow > xd->tile.mi_row_start);
+    xd->left_available = (micol > xd->tile.mi_col_start);
     const int32_t bw = mi_size_wide[bsize];
     const int32_t bh = mi_size_high[bsize];
 
@@ -9592,10 +9590,6 @@ extern void av1_predict_intra_block(
     xd->mb_to_bottom_edge = ((cm->mi_rows - bh - mirow) * MI_SIZE) * 8;
     xd->mb_to_left_edge = -((micol * MI_SIZE) * 8);
     xd->mb_to_right_edge = ((cm->mi_cols - bw - micol) * MI_SIZE) * 8;
-    xd->tile.mi_col_start = 0;
-    xd->tile.mi_col_end = cm->mi_cols;
-    xd->tile.mi_row_start = 0;
-    xd->tile.mi_row_end = cm->mi_rows;
     xd->n8_h = bh;
     xd->n8_w = bw;
     xd->is_sec_rect = 0;
@@ -9629,18 +9623,22 @@ extern void av1_predict_intra_block(
 #if INTRA_CORE_OPT
     int32_t chroma_up_available = up_available;
     int32_t chroma_left_available = left_available;
+    const int32_t tile_mi_col_start = tile.mi_col_start;
+    const int32_t tile_mi_row_start = tile.mi_row_start;
 #else
     int32_t chroma_up_available = xd->up_available;
     int32_t chroma_left_available = xd->left_available;
+    const int32_t tile_mi_col_start = xd->tile.mi_col_start;
+    const int32_t tile_mi_row_start = xd->tile.mi_row_start;
 #endif
     const int32_t ss_x = plane == 0 ? 0 : 1; //CHKN
     const int32_t ss_y = plane == 0 ? 0 : 1;
 
 
     if (ss_x && bw < mi_size_wide[BLOCK_8X8])
-        chroma_left_available = (micol - 1) > 0;//tile->mi_col_start;
+        chroma_left_available = (micol - 1) > tile_mi_col_start;
     if (ss_y && bh < mi_size_high[BLOCK_8X8])
-        chroma_up_available = (mirow - 1) > 0;//tile->mi_row_start;
+        chroma_up_available = (mirow - 1) > tile_mi_row_start;
 
 
     //CHKN  const MbModeInfo *const mbmi = xd->mi[0];
@@ -9869,8 +9867,9 @@ void av1_predict_intra_block_16bit(
     int32_t mirow = bl_org_y_pict >> 2;
     int32_t micol = bl_org_x_pict >> 2;
 
-    xd->up_available = (mirow > 0);
-    xd->left_available = (micol > 0);
+    av1_tile_init(&xd->tile, cm, mirow, micol);
+    xd->up_available = (mirow > xd->tile.mi_row_start);
+    xd->left_available = (micol > xd->tile.mi_col_start);
     const int32_t bw = mi_size_wide[bsize];
     const int32_t bh = mi_size_high[bsize];
 
@@ -9878,10 +9877,6 @@ void av1_predict_intra_block_16bit(
     xd->mb_to_bottom_edge = ((cm->mi_rows - bh - mirow) * MI_SIZE) * 8;
     xd->mb_to_left_edge = -((micol * MI_SIZE) * 8);
     xd->mb_to_right_edge = ((cm->mi_cols - bw - micol) * MI_SIZE) * 8;
-    xd->tile.mi_col_start = 0;
-    xd->tile.mi_col_end = cm->mi_cols;
-    xd->tile.mi_row_start = 0;
-    xd->tile.mi_row_end = cm->mi_rows;
 
     xd->n8_h = bh;
     xd->n8_w = bw;
@@ -9922,9 +9917,9 @@ void av1_predict_intra_block_16bit(
 
 
     if (ss_x && bw < mi_size_wide[BLOCK_8X8])
-        chroma_left_available = (micol - 1) > 0;//tile->mi_col_start;
+        chroma_left_available = (micol - 1) > xd->tile.mi_col_start;
     if (ss_y && bh < mi_size_high[BLOCK_8X8])
-        chroma_up_available = (mirow - 1) > 0;//tile->mi_row_start;
+        chroma_up_available = (mirow - 1) > xd->tile.mi_row_start;
 
     //CHKN  const MbModeInfo *const mbmi = xd->mi[0];
     const int32_t txwpx = tx_size_wide[tx_size];
@@ -10098,7 +10093,7 @@ EbErrorType AV1IntraPredictionCL(
             if (md_context_ptr->cu_origin_x != 0)
                 memcpy(leftNeighArray + 1, md_context_ptr->luma_recon_neighbor_array->leftArray + md_context_ptr->cu_origin_y, md_context_ptr->blk_geom->bheight * 2);
             if (md_context_ptr->cu_origin_y != 0 && md_context_ptr->cu_origin_x != 0)
-                topNeighArray[0] = leftNeighArray[0] = md_context_ptr->luma_recon_neighbor_array->topLeftArray[MAX_PICTURE_HEIGHT_SIZE + md_context_ptr->cu_origin_x - md_context_ptr->cu_origin_y];
+                topNeighArray[0] = leftNeighArray[0] = md_context_ptr->luma_recon_neighbor_array->topLeftArray[md_context_ptr->luma_recon_neighbor_array->leftArraySize + md_context_ptr->cu_origin_x - md_context_ptr->cu_origin_y];
         }
 
         else if (plane == 1) {
@@ -10110,7 +10105,7 @@ EbErrorType AV1IntraPredictionCL(
                 memcpy(leftNeighArray + 1, md_context_ptr->cb_recon_neighbor_array->leftArray + md_context_ptr->round_origin_y / 2, md_context_ptr->blk_geom->bheight_uv * 2);
 
             if (md_context_ptr->round_origin_y != 0 && md_context_ptr->round_origin_x != 0)
-                topNeighArray[0] = leftNeighArray[0] = md_context_ptr->cb_recon_neighbor_array->topLeftArray[MAX_PICTURE_HEIGHT_SIZE / 2 + md_context_ptr->round_origin_x / 2 - md_context_ptr->round_origin_y / 2];
+                topNeighArray[0] = leftNeighArray[0] = md_context_ptr->cb_recon_neighbor_array->topLeftArray[md_context_ptr->cb_recon_neighbor_array->leftArraySize + md_context_ptr->round_origin_x / 2 - md_context_ptr->round_origin_y / 2];
         }
         else {
             if (md_context_ptr->round_origin_y != 0)
@@ -10122,7 +10117,7 @@ EbErrorType AV1IntraPredictionCL(
                 memcpy(leftNeighArray + 1, md_context_ptr->cr_recon_neighbor_array->leftArray + md_context_ptr->round_origin_y / 2, md_context_ptr->blk_geom->bheight_uv * 2);
 
             if (md_context_ptr->round_origin_y != 0 && md_context_ptr->round_origin_x != 0)
-                topNeighArray[0] = leftNeighArray[0] = md_context_ptr->cr_recon_neighbor_array->topLeftArray[MAX_PICTURE_HEIGHT_SIZE / 2 + md_context_ptr->round_origin_x / 2 - md_context_ptr->round_origin_y / 2];
+                topNeighArray[0] = leftNeighArray[0] = md_context_ptr->cr_recon_neighbor_array->topLeftArray[md_context_ptr->cr_recon_neighbor_array->leftArraySize + md_context_ptr->round_origin_x / 2 - md_context_ptr->round_origin_y / 2];
 
 
         }
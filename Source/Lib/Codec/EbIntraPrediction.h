@@ -541,6 +541,8 @@ extern "C" {
         IntraModeVerticalLuma_SSE2_INTRIN,
         // AVX2
         IntraModeVerticalLuma_AVX2_INTRIN,
+        // AVX512
+        IntraModeVerticalLuma_AVX2_INTRIN,
 
     };
 
@@ -550,6 +552,8 @@ extern "C" {
         IntraModeVerticalChroma_SSE2_INTRIN,
         // AVX2
         IntraModeVerticalChroma_SSE2_INTRIN,
+        // AVX512
+        IntraModeVerticalChroma_SSE2_INTRIN,
     };
 
 
@@ -558,6 +562,8 @@ extern "C" {
         IntraModeHorizontalLuma_SSE2_INTRIN,
         // AVX2
         IntraModeHorizontalLuma_SSE2_INTRIN,
+        // AVX512
+        IntraModeHorizontalLuma_SSE2_INTRIN,
     };
 
 
@@ -566,6 +572,8 @@ extern "C" {
         IntraModeHorizontalChroma_SSE2_INTRIN,
         // AVX2
         IntraModeHorizontalChroma_SSE2_INTRIN,
+        // AVX512
+        IntraModeHorizontalChroma_SSE2_INTRIN,
     };
 
 #if !QT_10BIT_SUPPORT
@@ -577,6 +585,8 @@ extern "C" {
             highbd_dc_predictor,
             // AVX2
             IntraModeDC_4x4_AV1_SSE2_INTRIN,
+            // AVX512
+            IntraModeDC_4x4_AV1_SSE2_INTRIN,
         },
         // 8x8
         {
@@ -584,6 +594,8 @@ extern "C" {
             highbd_dc_predictor,
             // AVX2
             IntraModeDC_8x8_AV1_SSE2_INTRIN,
+            // AVX512
+            IntraModeDC_8x8_AV1_SSE2_INTRIN,
         },
         // 16x16
         {
@@ -591,6 +603,8 @@ extern "C" {
             highbd_dc_predictor,
             // AVX2
             IntraModeDC_16x16_AV1_SSE2_INTRIN,
+            // AVX512
+            IntraModeDC_16x16_AV1_SSE2_INTRIN,
 
         },
         // NxN
@@ -599,6 +613,8 @@ extern "C" {
             highbd_dc_predictor,
             // AVX2
             highbd_dc_predictor,
+            // AVX512
+            highbd_dc_predictor,
 
         },
         // 32x32
@@ -607,6 +623,8 @@ extern "C" {
             highbd_dc_predictor,
             // AVX2
             IntraModeDC_32x32_AV1_AVX2_INTRIN,
+            // AVX512
+            IntraModeDC_32x32_AV1_AVX2_INTRIN,
 
         } ,
         // NxN
@@ -615,6 +633,8 @@ extern "C" {
             highbd_dc_predictor,
             // AVX2
             highbd_dc_predictor,
+            // AVX512
+            highbd_dc_predictor,
 
         },
         // NxN
@@ -623,6 +643,8 @@ extern "C" {
             highbd_dc_predictor,
             // AVX2
             highbd_dc_predictor,
+            // AVX512
+            highbd_dc_predictor,
 
         },
         // NxN
@@ -631,6 +653,8 @@ extern "C" {
             highbd_dc_predictor,
             // AVX2
             highbd_dc_predictor,
+            // AVX512
+            highbd_dc_predictor,
 
         },
         // 64x64
@@ -640,6 +664,8 @@ extern "C" {
             // AVX2
 
             IntraModeDC_64x64_AV1_AVX2_INTRIN,
+            // AVX512
+            IntraModeDC_64x64_AV1_AVX2_INTRIN,
 
         }
 
@@ -650,6 +676,8 @@ extern "C" {
         IntraModeDCLuma_SSE2_INTRIN,
         // AVX2
         IntraModeDCLuma_AVX2_INTRIN,
+        // AVX512
+        IntraModeDCLuma_AVX2_INTRIN,
 
     };
 
@@ -666,6 +694,8 @@ extern "C" {
         IntraModeDCLuma16bit_SSE4_1_INTRIN,
         // AVX2
         IntraModeDCLuma16bit_SSE4_1_INTRIN,
+        // AVX512
+        IntraModeDCLuma16bit_SSE4_1_INTRIN,
     };
 
     static EB_INTRA_NOANG_TYPE FUNC_TABLE IntraDCChroma_funcPtrArray[ASM_TYPE_TOTAL] = {
@@ -673,6 +703,8 @@ extern "C" {
         IntraModeDCChroma_SSE2_INTRIN,
         // AVX2
         IntraModeDCChroma_SSE2_INTRIN,
+        // AVX512
+        IntraModeDCChroma_SSE2_INTRIN,
     };
 
 
@@ -681,6 +713,8 @@ extern "C" {
         IntraModePlanar_SSE2_INTRIN,
         // AVX2
         IntraModePlanar_AVX2_INTRIN,
+        // AVX512
+        IntraModePlanar_AVX2_INTRIN,
     };
 
     void smooth_v_predictor_c(uint8_t *dst, ptrdiff_t stride, int32_t bw,
@@ -692,6 +726,8 @@ extern "C" {
         IntraModePlanar,
         // AVX2
         IntraModePlanar_AV1_AVX2_INTRIN,
+        // AVX512
+        IntraModePlanar_AV1_AVX2_INTRIN,
     };
 #if !QT_10BIT_SUPPORT
     static EB_INTRA_NOANG_16bit_TYPE FUNC_TABLE IntraSmoothV_16bit_Av1_funcPtrArray[ASM_TYPE_TOTAL] = {
@@ -699,6 +735,8 @@ extern "C" {
         highbd_smooth_v_predictor,
         // AVX2
         highbd_smooth_v_predictor,
+        // AVX512
+        highbd_smooth_v_predictor,
     };
 #endif
     static EB_INTRA_NOANG_TYPE FUNC_TABLE IntraSmoothH_Av1_funcPtrArray[ASM_TYPE_TOTAL] = {
@@ -706,6 +744,8 @@ extern "C" {
         ebav1_smooth_h_predictor,
         // AVX2
         ebav1_smooth_h_predictor,
+        // AVX512
+        ebav1_smooth_h_predictor,
     };
 #if !QT_10BIT_SUPPORT
     static EB_INTRA_NOANG_16bit_TYPE FUNC_TABLE IntraSmoothH_16bit_Av1_funcPtrArray[ASM_TYPE_TOTAL] = {
@@ -713,6 +753,8 @@ extern "C" {
         highbd_smooth_h_predictor,
         // AVX2
         highbd_smooth_h_predictor,
+        // AVX512
+        highbd_smooth_h_predictor,
     };
 #endif
     static EB_INTRA_NOANG_TYPE FUNC_TABLE IntraSmoothV_Av1_funcPtrArray[ASM_TYPE_TOTAL] = {
@@ -720,6 +762,8 @@ extern "C" {
         ebav1_smooth_v_predictor,
         // AVX2
         ebav1_smooth_v_predictor,
+        // AVX512
+        ebav1_smooth_v_predictor,
     };
 
     static EB_INTRA_NOANG_16bit_TYPE FUNC_TABLE IntraPlanar_16bit_funcPtrArray[ASM_TYPE_TOTAL] = {
@@ -727,6 +771,8 @@ extern "C" {
         IntraModePlanar16bit_SSE2_INTRIN,
         // AVX2
         IntraModePlanar16bit_SSE2_INTRIN,
+        // AVX512
+        IntraModePlanar16bit_SSE2_INTRIN,
     };
 
     static EB_INTRA_NOANG_TYPE FUNC_TABLE IntraAng34_funcPtrArray[ASM_TYPE_TOTAL] = {
@@ -734,6 +780,8 @@ extern "C" {
         IntraModeAngular_34_SSE2_INTRIN,
         // AVX2
         IntraModeAngular_34_AVX2_INTRIN,
+        // AVX512
+        IntraModeAngular_34_AVX2_INTRIN,
     };
 
 
@@ -742,6 +790,8 @@ extern "C" {
         IntraModeAngular_18_SSE2_INTRIN,
         // AVX2
         IntraModeAngular_18_AVX2_INTRIN,
+        // AVX512
+        IntraModeAngular_18_AVX2_INTRIN,
 
     };
 
@@ -751,6 +801,8 @@ extern "C" {
         IntraModeAngular_2_SSE2_INTRIN,
         // AVX2
         IntraModeAngular_2_AVX2_INTRIN,
+        // AVX512
+        IntraModeAngular_2_AVX2_INTRIN,
     };
 
 
@@ -759,6 +811,8 @@ extern "C" {
         IntraModeAngular_Vertical_Kernel_SSSE3_INTRIN,
         // AVX2
         IntraModeAngular_Vertical_Kernel_AVX2_INTRIN,
+        // AVX512
+        IntraModeAngular_Vertical_Kernel_AVX2_INTRIN,
     };
 
 
@@ -767,6 +821,8 @@ extern "C" {
         IntraModeAngular_Horizontal_Kernel_SSSE3_INTRIN,
         // AVX2
         IntraModeAngular_Horizontal_Kernel_AVX2_INTRIN,
+        // AVX512
+        IntraModeAngular_Horizontal_Kernel_AVX2_INTRIN,
     };
 
 
@@ -777,6 +833,8 @@ extern "C" {
             IntraModeAngular_AV1_Z1_16bit,
             // AVX2
             IntraModeAngular_AV1_Z1_16bit_4x4_AVX2,
+            // AVX512
+            IntraModeAngular_AV1_Z1_16bit_4x4_AVX2,
         },
         // 8x8
         {
@@ -784,6 +842,8 @@ extern "C" {
             IntraModeAngular_AV1_Z1_16bit,
             // AVX2
             IntraModeAngular_AV1_Z1_16bit_8x8_AVX2,
+            // AVX512
+            IntraModeAngular_AV1_Z1_16bit_8x8_AVX2,
         },
         // 16x16
         {
@@ -791,6 +851,8 @@ extern "C" {
             IntraModeAngular_AV1_Z1_16bit,
             // AVX2
             IntraModeAngular_AV1_Z1_16bit_16x16_AVX2,
+            // AVX512
+            IntraModeAngular_AV1_Z1_16bit_16x16_AVX2,
         },
         // NxN
         {
@@ -798,6 +860,8 @@ extern "C" {
             IntraModeAngular_AV1_Z1_16bit,
             // AVX2
             IntraModeAngular_AV1_Z1_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z1_16bit,
         },
         // 32x32
         {
@@ -805,6 +869,8 @@ extern "C" {
             IntraModeAngular_AV1_Z1_16bit,
             // AVX2
             IntraModeAngular_AV1_Z1_16bit_32x32_AVX2,
+            // AVX512
+            IntraModeAngular_AV1_Z1_16bit_32x32_AVX2,
         },
         // NxN
         {
@@ -812,6 +878,8 @@ extern "C" {
             IntraModeAngular_AV1_Z1_16bit,
             // AVX2
             IntraModeAngular_AV1_Z1_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z1_16bit,
         },
         // NxN
         {
@@ -819,6 +887,8 @@ extern "C" {
             IntraModeAngular_AV1_Z1_16bit,
             // AVX2
             IntraModeAngular_AV1_Z1_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z1_16bit,
         },
         // NxN
         {
@@ -826,6 +896,8 @@ extern "C" {
             IntraModeAngular_AV1_Z1_16bit,
             // AVX2
             IntraModeAngular_AV1_Z1_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z1_16bit,
         },
         // 64x64
         {
@@ -833,6 +905,8 @@ extern "C" {
             IntraModeAngular_AV1_Z1_16bit,
             // AVX2
             IntraModeAngular_AV1_Z1_16bit_64x64_AVX2,
+            // AVX512
+            IntraModeAngular_AV1_Z1_16bit_64x64_AVX2,
         }
     };
     static EB_INTRA_ANG_Z1_Z2_Z3_16bit_TYPE FUNC_TABLE IntraModeAngular_AV1_Z2_16bit_funcPtrArray[9][ASM_TYPE_TOTAL] = {
@@ -842,6 +916,8 @@ extern "C" {
             IntraModeAngular_AV1_Z2_16bit,
             // AVX2
             IntraModeAngular_AV1_Z2_16bit_4x4_AVX2,
+            // AVX512
+            IntraModeAngular_AV1_Z2_16bit_4x4_AVX2,
         },
         // 8x8
         {
@@ -849,6 +925,8 @@ extern "C" {
             IntraModeAngular_AV1_Z2_16bit,
             // AVX2
             IntraModeAngular_AV1_Z2_16bit_8x8_AVX2,
+            // AVX512
+            IntraModeAngular_AV1_Z2_16bit_8x8_AVX2,
         },
         // 16x16
         {
@@ -856,6 +934,8 @@ extern "C" {
             IntraModeAngular_AV1_Z2_16bit,
             // AVX2
             IntraModeAngular_AV1_Z2_16bit_16x16_AVX2,
+            // AVX512
+            IntraModeAngular_AV1_Z2_16bit_16x16_AVX2,
         },
         // NxN
         {
@@ -863,6 +943,8 @@ extern "C" {
             IntraModeAngular_AV1_Z2_16bit,
             // AVX2
             IntraModeAngular_AV1_Z2_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z2_16bit,
         },
         // 32x32
         {
@@ -870,6 +952,8 @@ extern "C" {
             IntraModeAngular_AV1_Z2_16bit,
             // AVX2
             IntraModeAngular_AV1_Z2_16bit_32x32_AVX2,
+            // AVX512
+            IntraModeAngular_AV1_Z2_16bit_32x32_AVX2,
         },
         // NxN
         {
@@ -877,6 +961,8 @@ extern "C" {
             IntraModeAngular_AV1_Z2_16bit,
             // AVX2
             IntraModeAngular_AV1_Z2_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z2_16bit,
         },
         // NxN
         {
@@ -884,6 +970,8 @@ extern "C" {
             IntraModeAngular_AV1_Z2_16bit,
             // AVX2
             IntraModeAngular_AV1_Z2_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z2_16bit,
         },
         // NxN
         {
@@ -891,6 +979,8 @@ extern "C" {
             IntraModeAngular_AV1_Z2_16bit,
             // AVX2
             IntraModeAngular_AV1_Z2_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z2_16bit,
         },
         // 64x64
         {
@@ -898,6 +988,8 @@ extern "C" {
             IntraModeAngular_AV1_Z2_16bit,
             // AVX2
             IntraModeAngular_AV1_Z2_16bit_64x64_AVX2,
+            // AVX512
+            IntraModeAngular_AV1_Z2_16bit_64x64_AVX2,
         }
     };
     static EB_INTRA_ANG_Z1_Z2_Z3_16bit_TYPE FUNC_TABLE IntraModeAngular_AV1_Z3_16bit_funcPtrArray[9][ASM_TYPE_TOTAL] = {
@@ -907,6 +999,8 @@ extern "C" {
             IntraModeAngular_AV1_Z3_16bit,
             // AVX2
             IntraModeAngular_AV1_Z3_16bit_4x4_AVX2,
+            // AVX512
+            IntraModeAngular_AV1_Z3_16bit_4x4_AVX2,
         },
         // 8x8
         {
@@ -914,6 +1008,8 @@ extern "C" {
             IntraModeAngular_AV1_Z3_16bit,
             // AVX2
             IntraModeAngular_AV1_Z3_16bit_8x8_AVX2,
+            // AVX512
+            IntraModeAngular_AV1_Z3_16bit_8x8_AVX2,
         },
         // 16x16
         {
@@ -921,6 +1017,8 @@ extern "C" {
             IntraModeAngular_AV1_Z3_16bit,
             // AVX2
             IntraModeAngular_AV1_Z3_16bit_16x16_AVX2,
+            // AVX512
+            IntraModeAngular_AV1_Z3_16bit_16x16_AVX2,
         },
         // NxN
         {
@@ -928,6 +1026,8 @@ extern "C" {
             IntraModeAngular_AV1_Z3_16bit,
             // AVX2
             IntraModeAngular_AV1_Z3_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z3_16bit,
         },
         // 32x32
         {
@@ -935,6 +1035,8 @@ extern "C" {
             IntraModeAngular_AV1_Z3_16bit,
             // AVX2
             IntraModeAngular_AV1_Z3_16bit_32x32_AVX2,
+            // AVX512
+            IntraModeAngular_AV1_Z3_16bit_32x32_AVX2,
         },
         // NxN
         {
@@ -942,6 +1044,8 @@ extern "C" {
             IntraModeAngular_AV1_Z3_16bit,
             // AVX2
             IntraModeAngular_AV1_Z3_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z3_16bit,
         },
         // NxN
         {
@@ -949,6 +1053,8 @@ extern "C" {
             IntraModeAngular_AV1_Z3_16bit,
             // AVX2
             IntraModeAngular_AV1_Z3_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z3_16bit,
         },
         // NxN
         {
@@ -956,6 +1062,8 @@ extern "C" {
             IntraModeAngular_AV1_Z3_16bit,
             // AVX2
             IntraModeAngular_AV1_Z3_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z3_16bit,
         },
         // 64x64
         {
@@ -963,6 +1071,8 @@ extern "C" {
             IntraModeAngular_AV1_Z3_16bit,
             // AVX2
             IntraModeAngular_AV1_Z3_16bit_64x64_AVX2,
+            // AVX512
+            IntraModeAngular_AV1_Z3_16bit_64x64_AVX2,
         }
     };
 
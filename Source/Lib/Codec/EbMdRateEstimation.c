@@ -80,8 +80,6 @@ void av1_estimate_syntax_rate(
 {
     int32_t i, j;
 
-    md_rate_estimation_array->initialized = 1;
-
     for (i = 0; i < PARTITION_CONTEXTS; ++i)
         av1_get_syntax_rate_from_cdf(md_rate_estimation_array->partitionFacBits[i], fc->partition_cdf[i], NULL);
 
@@ -514,3 +512,39 @@ EbErrorType MdRateEstimationContextCtor(MdRateEstimationContext_t *md_rate_estim
     }
     return EB_ErrorNone;
 }
+
+/**************************************************************
+* av1_update_md_rate_estimation()
+* The default CDFs only depend on the coefficient qindex range,
+* so do the tables estimated from them
+**************************************************************/
+EbBool av1_update_md_rate_estimation(
+    MdRateEstimationContext_t  *md_rate_estimation_cache,
+    EbBool                      is_i_slice,
+    uint32_t                    base_qindex,
+    uint32_t                    cdf_source,
+    FRAME_CONTEXT              *fc,
+    MdRateEstimationContext_t **md_rate_estimation_dbl_ptr)
+{
+    const uint32_t              cacheIndex = (cdf_source * 2 + (is_i_slice ? 1 : 0)) * TOKEN_CDF_Q_CTXS + (uint32_t)get_q_ctx((int32_t)base_qindex);
+    MdRateEstimationContext_t  *mdRateEstimation = &md_rate_estimation_cache[cacheIndex];
+
+    *md_rate_estimation_dbl_ptr = mdRateEstimation;
+
+    if (mdRateEstimation->initialized)
+        return EB_TRUE;
+
+    av1_estimate_syntax_rate(
+        mdRateEstimation,
+        is_i_slice,
+        fc);
+    av1_estimate_mv_rate(
+        mdRateEstimation,
+        &fc->nmvc);
+    av1_estimate_coefficients_rate(
+        mdRateEstimation,
+        fc);
+    mdRateEstimation->initialized = 1;
+
+    return EB_FALSE;
+}
@@ -17,6 +17,11 @@ extern "C" {
 #define TOTAL_NUMBER_OF_MD_RATE_ESTIMATION_CASE_BUFFERS (TOTAL_NUMBER_OF_QP_VALUES * TOTAL_NUMBER_OF_SLICE_TYPES)
 #define NUMBER_OF_SPLIT_FLAG_CASES                            6       // number of cases for bit estimation for split flag
 #define NUMBER_OF_MVD_CASES                                  12       // number of cases for bit estimation for motion vector difference
+     // Sources of the CDFs the rate tables are estimated from
+#define MD_RATE_CDF_SOURCE_DEFAULT                            0       // default CDFs of the coefficient qindex range
+#define MD_RATE_CDF_SOURCE_COUNT                              1
+     // One rate table per intra flag, coefficient qindex range and CDF source
+#define MD_RATE_ESTIMATION_CACHE_SIZE                        (2 * TOKEN_CDF_Q_CTXS * MD_RATE_CDF_SOURCE_COUNT)
      // Set to (1 << 5) if the 32-ary codebooks are used for any bock size
 #define MAX_WEDGE_TYPES                                      (1 << 4)
      // The factor to scale from cost in bits to cost in av1_prob_cost units.
@@ -317,6 +322,21 @@ extern "C" {
     extern void av1_estimate_mv_rate(
         MdRateEstimationContext_t  *md_rate_estimation_array,
         nmv_context                *nmv_ctx);
+    /**************************************************************************
+    * av1_update_md_rate_estimation()
+    * Point md_rate_estimation_dbl_ptr at the cache entry of the inputs of the
+    * rate tables: the intra flag, the coefficient qindex range and the CDF
+    * source. The entry is estimated from the frame CDF on its first use and
+    * never written after, the pictures read it without lock. Returns EB_TRUE
+    * when the entry was already estimated. The caller serializes the calls
+    ***************************************************************************/
+    extern EbBool av1_update_md_rate_estimation(
+        MdRateEstimationContext_t  *md_rate_estimation_cache,
+        EbBool                      is_i_slice,
+        uint32_t                    base_qindex,
+        uint32_t                    cdf_source,
+        FRAME_CONTEXT              *fc,
+        MdRateEstimationContext_t **md_rate_estimation_dbl_ptr);
 
 
 #ifdef __cplusplus
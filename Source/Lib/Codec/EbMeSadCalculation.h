@@ -151,6 +151,8 @@ extern "C" {
         // NON_AVX2
         InitializeBuffer_32bits_SSE2_INTRIN,
         // AVX2
+        InitializeBuffer_32bits_SSE2_INTRIN,
+        // AVX512
         InitializeBuffer_32bits_SSE2_INTRIN
     };
 
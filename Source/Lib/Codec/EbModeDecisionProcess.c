@@ -99,22 +99,25 @@ EbErrorType mode_decision_context_ctor(
     }
     uint32_t codedLeafIndex, tu_index;
 
+    // Per block state: one slab, one cache line aligned record per block in
+    // blk_geom order (neighbor recon rows, then the MacroBlockD)
+    const size_t xdSize = (sizeof(MacroBlockD) + EB_CACHE_LINE_SIZE - 1) & ~(size_t)(EB_CACHE_LINE_SIZE - 1);
+    const size_t blockRecordSize = 6 * MD_NEIGHBOR_RECON_SIZE + xdSize;
+    uint8_t *blockSlab;
+    EB_CACHE_ALIGNED_MALLOC(uint8_t*, blockSlab, blockRecordSize * BLOCK_MAX_COUNT, EB_N_PTR);
+
     for (codedLeafIndex = 0; codedLeafIndex < BLOCK_MAX_COUNT; ++codedLeafIndex) {
 
         for (tu_index = 0; tu_index < TRANSFORM_UNIT_MAX_COUNT; ++tu_index) {
             context_ptr->md_cu_arr_nsq[codedLeafIndex].transform_unit_array[tu_index].tu_index = tu_index;
         }
 
-        const BlockGeom * blk_geom = Get_blk_geom_mds(codedLeafIndex);
-        UNUSED(blk_geom);
-        EB_MALLOC(MacroBlockD*, context_ptr->md_cu_arr_nsq[codedLeafIndex].av1xd, sizeof(MacroBlockD), EB_N_PTR);
-        EB_MALLOC(uint8_t*, context_ptr->md_cu_arr_nsq[codedLeafIndex].neigh_left_recon[0], 128, EB_N_PTR);
-        EB_MALLOC(uint8_t*, context_ptr->md_cu_arr_nsq[codedLeafIndex].neigh_left_recon[1], 128, EB_N_PTR);
-        EB_MALLOC(uint8_t*, context_ptr->md_cu_arr_nsq[codedLeafIndex].neigh_left_recon[2], 128, EB_N_PTR);
-
-        EB_MALLOC(uint8_t*, context_ptr->md_cu_arr_nsq[codedLeafIndex].neigh_top_recon[0], 128, EB_N_PTR);
-        EB_MALLOC(uint8_t*, context_ptr->md_cu_arr_nsq[codedLeafIndex].neigh_top_recon[1], 128, EB_N_PTR);
-        EB_MALLOC(uint8_t*, context_ptr->md_cu_arr_nsq[codedLeafIndex].neigh_top_recon[2], 128, EB_N_PTR);
+        uint8_t *blockRecord = blockSlab + codedLeafIndex * blockRecordSize;
+        for (uint32_t plane = 0; plane < 3; ++plane) {
+            context_ptr->md_cu_arr_nsq[codedLeafIndex].neigh_left_recon[plane] = blockRecord + plane * MD_NEIGHBOR_RECON_SIZE;
+            context_ptr->md_cu_arr_nsq[codedLeafIndex].neigh_top_recon[plane] = blockRecord + (3 + plane) * MD_NEIGHBOR_RECON_SIZE;
+        }
+        context_ptr->md_cu_arr_nsq[codedLeafIndex].av1xd = (MacroBlockD*)(blockRecord + 6 * MD_NEIGHBOR_RECON_SIZE);
 
 #if NO_ENCDEC //SB128_TODO to upgrade
         {
@@ -357,9 +360,7 @@ void reset_mode_decision(
     SequenceControlSet_t    *sequence_control_set_ptr,
     uint32_t                   segment_index)
 {
-    EB_SLICE                     slice_type;
     uint32_t                       lcuRowIndex;
-    MdRateEstimationContext_t   *md_rate_estimation_array;
 
     // QP
 #if ADD_DELTA_QP_SUPPORT
@@ -422,28 +423,14 @@ void reset_mode_decision(
     context_ptr->buffer_depth_index_width[4] = 5;
 #endif
 
-    // Slice Type
-    slice_type =
-        (picture_control_set_ptr->parent_pcs_ptr->idr_flag == EB_TRUE) ? I_SLICE :
-        picture_control_set_ptr->slice_type;
-
-    // Increment the MD Rate Estimation array pointer to point to the right address based on the QP and slice type
+    // MD rate tables of the picture, see ResetEncDec
 
     /* Note(CHKN) : Rate estimation will use FrameQP even when Qp modulation is ON */
 
-    md_rate_estimation_array = (MdRateEstimationContext_t*)sequence_control_set_ptr->encode_context_ptr->md_rate_estimation_array;
-#if ADD_DELTA_QP_SUPPORT
-    md_rate_estimation_array += slice_type * TOTAL_NUMBER_OF_QP_VALUES + picture_control_set_ptr->picture_qp;
-#else
-    md_rate_estimation_array += slice_type * TOTAL_NUMBER_OF_QP_VALUES + context_ptr->qp;
-#endif
-
-    // Reset MD rate Estimation table to initial values by copying from md_rate_estimation_array
-
-    context_ptr->md_rate_estimation_ptr = md_rate_estimation_array;
+    context_ptr->md_rate_estimation_ptr = picture_control_set_ptr->md_rate_estimation_ptr;
     uint32_t  candidateIndex;
     for (candidateIndex = 0; candidateIndex < MODE_DECISION_CANDIDATE_MAX_COUNT; ++candidateIndex) {
-        context_ptr->fast_candidate_ptr_array[candidateIndex]->md_rate_estimation_ptr = md_rate_estimation_array;
+        context_ptr->fast_candidate_ptr_array[candidateIndex]->md_rate_estimation_ptr = picture_control_set_ptr->md_rate_estimation_ptr;
     }
 
 
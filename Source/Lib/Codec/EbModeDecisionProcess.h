@@ -35,6 +35,7 @@ extern "C" {
 #endif
 
 #define INDEPENDENT_INTRA_CHROMA_MODE_TOTAL_COUNT       4       // Planar, Vertical, Horizontal, DC
+#define MD_NEIGHBOR_RECON_SIZE                          128     // Samples of a block edge kept for the neighbor recon
 
 #define DEPTH_ONE_STEP   21
 #define DEPTH_TWO_STEP    5
@@ -122,6 +122,8 @@ static EB_COMPUTE8X4SAD_TYPE FUNC_TABLE compute8x4SAD_funcPtrArray[ASM_TYPE_TOTA
     Compute8x4SAD_Kernel,
     // SSE2
     Compute8x4SAD_Kernel,
+    // AVX512
+    Compute8x4SAD_Kernel,
 };
 /***************************************
 * Function Tables
@@ -130,12 +132,16 @@ static EB_EXTSADCALCULATION8X8AND16X16_TYPE ExtSadCalculation_8x8_16x16_funcPtrA
     // NON_AVX2
     ExtSadCalculation_8x8_16x16,
     // AVX2
+    ExtSadCalculation_8x8_16x16_SSE4_INTRIN,
+    // AVX512
     ExtSadCalculation_8x8_16x16_SSE4_INTRIN
 };
 static EB_EXTSADCALCULATION32X32AND64X64_TYPE ExtSadCalculation_32x32_64x64_funcPtrArray[ASM_TYPE_TOTAL] = {
     // NON_AVX2
     ExtSadCalculation_32x32_64x64,
     // AVX2
+    ExtSadCalculation_32x32_64x64_SSE4_INTRIN,
+    // AVX512
     ExtSadCalculation_32x32_64x64_SSE4_INTRIN
 };
 static EB_SADCALCULATION8X8AND16X16_TYPE SadCalculation_8x8_16x16_funcPtrArray[ASM_TYPE_TOTAL] = {
@@ -143,12 +149,16 @@ static EB_SADCALCULATION8X8AND16X16_TYPE SadCalculation_8x8_16x16_funcPtrArray[A
     SadCalculation_8x8_16x16_SSE2_INTRIN,
     // AVX2
     SadCalculation_8x8_16x16_SSE2_INTRIN,
+    // AVX512
+    SadCalculation_8x8_16x16_SSE2_INTRIN,
 };
 static EB_SADCALCULATION32X32AND64X64_TYPE SadCalculation_32x32_64x64_funcPtrArray[ASM_TYPE_TOTAL] = {
     // NON_AVX2
     SadCalculation_32x32_64x64_SSE2_INTRIN,
     // AVX2
     SadCalculation_32x32_64x64_SSE2_INTRIN,
+    // AVX512
+    SadCalculation_32x32_64x64_SSE2_INTRIN,
 };
 
 /*******************************************
@@ -1056,6 +1066,8 @@ static EB_EXTSADCALCULATION_TYPE ExtSadCalculation_funcPtrArray[ASM_TYPE_TOTAL]
     // C_DEFAULT
     ExtSadCalculation,
     // Assembly
+    ExtSadCalculation,
+    // AVX512
     ExtSadCalculation
 };
 
@@ -4234,7 +4246,7 @@ void HmeOneQuadrantLevel0(
             search_area_width = (int16_t)(floor((double)((search_area_width >> 4) << 4)));
         }
 
-        if (((search_area_width & 15) == 0) && (asm_type == ASM_AVX2))
+        if (((search_area_width & 15) == 0) && (asm_type >= ASM_AVX2))
         {
             SadLoopKernel_AVX2_HmeL0_INTRIN(
                 &context_ptr->sixteenth_sb_buffer[0],
@@ -4416,7 +4428,7 @@ void HmeLevel0(
 
     if (((sb_width & 7) == 0) || (sb_width == 4))
     {
-        if (((search_area_width & 15) == 0) && (asm_type == ASM_AVX2))
+        if (((search_area_width & 15) == 0) && (asm_type >= ASM_AVX2))
         {
             SadLoopKernel_AVX2_HmeL0_INTRIN(
                 &context_ptr->sixteenth_sb_buffer[0],
@@ -7159,7 +7171,7 @@ EbErrorType MotionEstimateLcu(
 
 
 
-    if (sequence_control_set_ptr->static_config.rate_control_mode) {
+    if (sequence_control_set_ptr->static_config.rate_control_mode == 1) {
 
         // Compute the sum of the distortion of all 16 16x16 (best) blocks in the LCU
         picture_control_set_ptr->rc_me_distortion[sb_index] = 0;
@@ -7246,7 +7258,7 @@ uint64_t SixteenthDecimatedSearch(
     yTopLeftSearchRegion = ((int16_t)sixteenthRefPicPtr->origin_y + origin_y) + y_search_area_origin;
     searchRegionIndex = xTopLeftSearchRegion + yTopLeftSearchRegion * sixteenthRefPicPtr->strideY;
 
-    if (((search_area_width & 15) == 0) && (asm_type == ASM_AVX2))
+    if (((search_area_width & 15) == 0) && (asm_type >= ASM_AVX2))
     {
         SadLoopKernel_AVX2_HmeL0_INTRIN(
             &context_ptr->sixteenth_sb_buffer[0],
@@ -7980,7 +7992,7 @@ EbErrorType OpenLoopIntraDC(
 
     if ((cu_size == 32) || (cu_size == 16) || (cu_size == 8))
     {
-        if (asm_type == ASM_AVX2)
+        if (asm_type >= ASM_AVX2)
         {
             OisCuPtr[0].distortion = (uint32_t)UpdateNeighborDcIntraPred_AVX2_INTRIN(
                 context_ptr->intra_ref_ptr->y_intra_reference_array_reverse,
@@ -608,7 +608,7 @@ void* MotionEstimationKernel(void *input_ptr)
 
         EbBlockOnMutex(picture_control_set_ptr->rc_distortion_histogram_mutex);
 
-        if (sequence_control_set_ptr->static_config.rate_control_mode) {
+        if (sequence_control_set_ptr->static_config.rate_control_mode == 1) {
             if (picture_control_set_ptr->slice_type != I_SLICE) {
                 uint16_t sadIntervalIndex;
                 for (yLcuIndex = yLcuStartIndex; yLcuIndex < yLcuEndIndex; ++yLcuIndex) {
@@ -19,6 +19,10 @@ extern "C" {
 #define TU_NEIGHBOR_ARRAY_GRANULARITY                   4
 #define SAMPLE_NEIGHBOR_ARRAY_GRANULARITY               1
 
+    // Neighbor array span for a picture dimension: the superblocks covering
+    // it, plus one for the above right and below left samples of the last ones
+#define NEIGHBOR_ARRAY_SIZE(pictureSize)                (((pictureSize) + 2 * MAX_SB_SIZE - 1) & ~(MAX_SB_SIZE - 1))
+
     typedef enum NEIGHBOR_ARRAY_TYPE
     {
         NEIGHBOR_ARRAY_LEFT = 0,
@@ -30,11 +30,15 @@ extern "C" {
             EB_ENC_msbPack2D,
             // AVX2
             EB_ENC_msbPack2D,
+            // AVX512
+            EB_ENC_msbPack2D,
         },
         {
             // NON_AVX2
             EB_ENC_msbPack2D_SSE2_INTRIN,
             // AVX2
+            EB_ENC_msbPack2D_AVX2_INTRIN_AL,
+            // AVX512
             EB_ENC_msbPack2D_AVX2_INTRIN_AL,//EB_ENC_msbPack2D_AVX2
         }
     };
@@ -46,6 +50,8 @@ extern "C" {
         CompressedPackmsb,
         // AVX2
         CompressedPackmsb_AVX2_INTRIN,
+        // AVX512
+        CompressedPackmsb_AVX2_INTRIN,
 
     };
 
@@ -64,6 +70,8 @@ extern "C" {
         CPack_C,
         // AVX2
         CPack_AVX2_INTRIN,
+        // AVX512
+        CPack_AVX2_INTRIN,
 
     };
 
@@ -84,12 +92,16 @@ extern "C" {
             EB_ENC_msbUnPack2D,
             // AVX2
             EB_ENC_msbUnPack2D,
+            // AVX512
+            EB_ENC_msbUnPack2D,
         },
         {
             // NON_AVX2
             EB_ENC_msbUnPack2D_SSE2_INTRIN,
             // AVX2
             EB_ENC_msbUnPack2D_SSE2_INTRIN,
+            // AVX512
+            EB_ENC_msbUnPack2D_SSE2_INTRIN,
         }
     };
 
@@ -107,6 +119,8 @@ extern "C" {
         // NON_AVX2
         UnpackAvg,
         // AVX2
+        UnpackAvg_AVX2_INTRIN,
+        // AVX512
         UnpackAvg_AVX2_INTRIN,//UnpackAvg_SSE2_INTRIN,
 
     };
@@ -125,6 +139,8 @@ extern "C" {
         // NON_AVX2
         UnpackAvgSafeSub,
         // AVX2  SafeSub
+        UnpackAvgSafeSub_AVX2_INTRIN,
+        // AVX512
         UnpackAvgSafeSub_AVX2_INTRIN,//UnpackAvg_SSE2_INTRIN,
 
     };
@@ -141,12 +157,16 @@ extern "C" {
         {
            UnPack8BitData,
            UnPack8BitData,
+           // AVX512
+           UnPack8BitData,
         },
         {
             // NON_AVX2
             EB_ENC_UnPack8BitData_SSE2_INTRIN,
             // AVX2
             EB_ENC_UnPack8BitData_SSE2_INTRIN,
+            // AVX512
+            EB_ENC_UnPack8BitData_SSE2_INTRIN,
         }
     };
     typedef void(*EB_ENC_UnPack8BitDataSUB_TYPE)(
@@ -164,6 +184,8 @@ extern "C" {
         EB_ENC_UnPack8BitDataSafeSub_SSE2_INTRIN,
         // AVX2
         EB_ENC_UnPack8BitDataSafeSub_SSE2_INTRIN,
+        // AVX512
+        EB_ENC_UnPack8BitDataSafeSub_SSE2_INTRIN,
 
     };
 
@@ -4,6 +4,7 @@
 */
 
 #include <stdlib.h>
+#include <math.h>
 
 #include "EbDefinitions.h"
 #include "EbPacketizationProcess.h"
@@ -45,9 +46,226 @@ EbErrorType PacketizationContextCtor(
 
     EB_MALLOC(EbPPSConfig_t*, context_ptr->ppsConfig, sizeof(EbPPSConfig_t), EB_N_PTR);
 
+    PacketizationContextReset(context_ptr);
+
     return EB_ErrorNone;
 }
 
+/******************************************************
+ * Packetization Context Reset
+ ******************************************************/
+void PacketizationContextReset(
+    PacketizationContext_t  *context_ptr)
+{
+    context_ptr->totShownFrames = 0;
+    context_ptr->dispOrderContinuityCount = 0;
+}
+
+/******************************************************
+ * Packetization Init Output Stream
+ ******************************************************/
+static void PacketizationInitOutputStream(
+    EbBufferHeaderType             *output_stream_ptr,
+    PictureControlSet_t            *picture_control_set_ptr,
+    SequenceControlSet_t           *sequence_control_set_ptr,
+    uint32_t                        flags)
+{
+    output_stream_ptr->flags = flags;
+    output_stream_ptr->n_filled_len = 0;
+    output_stream_ptr->n_tick_count = 0;
+    output_stream_ptr->pts = picture_control_set_ptr->parent_pcs_ptr->input_ptr->pts;
+    output_stream_ptr->dts = picture_control_set_ptr->parent_pcs_ptr->decode_order - (uint64_t)(1 << sequence_control_set_ptr->static_config.hierarchical_levels) + 1;
+    output_stream_ptr->pic_type = picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag ?
+        picture_control_set_ptr->parent_pcs_ptr->idr_flag ? EB_IDR_PICTURE :
+        picture_control_set_ptr->slice_type : EB_NON_REF_PICTURE;
+    output_stream_ptr->p_app_private = picture_control_set_ptr->parent_pcs_ptr->input_ptr->p_app_private;
+    output_stream_ptr->frame_stats = NULL;
+}
+
+/******************************************************
+ * Packetization Frame Stats
+ *   fills the statistics stored after the header of the buffer ending the frame,
+ *   the latency is set when the buffer is output
+ ******************************************************/
+static void PacketizationFrameStats(
+    EbBufferHeaderType             *output_stream_ptr,
+    PictureControlSet_t            *picture_control_set_ptr,
+    SequenceControlSet_t           *sequence_control_set_ptr)
+{
+    PictureParentControlSet_t *parentPcsPtr = picture_control_set_ptr->parent_pcs_ptr;
+    EbSvtFrameStats *frameStats = (EbSvtFrameStats*)(output_stream_ptr + 1);
+    int32_t stage;
+
+    EB_MEMSET(frameStats, 0, sizeof(EbSvtFrameStats));
+    frameStats->picture_number = parentPcsPtr->picture_number;
+    frameStats->decode_order = parentPcsPtr->decode_order;
+    frameStats->temporal_layer = parentPcsPtr->temporal_layer_index;
+    frameStats->qp = picture_control_set_ptr->picture_qp;
+    frameStats->bits = parentPcsPtr->total_num_bits;
+    for (stage = 0; stage < LATENCY_STAGE_COUNT; ++stage) {
+        if (parentPcsPtr->stage_time_seconds[stage] | parentPcsPtr->stage_time_u_seconds[stage]) {
+            EbComputeOverallElapsedTimeUs(
+                parentPcsPtr->start_time_seconds,
+                parentPcsPtr->start_time_u_seconds,
+                parentPcsPtr->stage_time_seconds[stage],
+                parentPcsPtr->stage_time_u_seconds[stage],
+                &frameStats->stage_time[stage]);
+        }
+    }
+
+    if (sequence_control_set_ptr->static_config.frame_stats == 2) {
+        const double maxSample = (double)((1 << sequence_control_set_ptr->static_config.encoder_bit_depth) - 1);
+        const double lumaPeak = maxSample * maxSample * sequence_control_set_ptr->luma_width * sequence_control_set_ptr->luma_height;
+        const double chromaPeak = maxSample * maxSample * sequence_control_set_ptr->chroma_width * sequence_control_set_ptr->chroma_height;
+        int32_t plane;
+
+        frameStats->sse[0] = parentPcsPtr->luma_sse;
+        frameStats->sse[1] = parentPcsPtr->cb_sse;
+        frameStats->sse[2] = parentPcsPtr->cr_sse;
+        for (plane = 0; plane < 3; ++plane) {
+            frameStats->psnr[plane] = frameStats->sse[plane] ?
+                MIN(10.0 * log10((plane ? chromaPeak : lumaPeak) / frameStats->sse[plane]), 100.0) : 100.0;
+        }
+    }
+
+    output_stream_ptr->frame_stats = frameStats;
+}
+
+/******************************************************
+ * Packetization Write Frame Headers
+ *   temporal delimiter, sequence header and frame
+ *   header, followed by the tiles unless they are
+ *   output in their own tile groups
+ ******************************************************/
+static void PacketizationWriteFrameHeaders(
+    EbBufferHeaderType             *output_stream_ptr,
+    PictureControlSet_t            *picture_control_set_ptr,
+    SequenceControlSet_t           *sequence_control_set_ptr)
+{
+    // Reset the bitstream before writing to it
+    ResetBitstream(
+        picture_control_set_ptr->bitstreamPtr->outputBitstreamPtr);
+
+    if (picture_control_set_ptr->parent_pcs_ptr->showFrame && picture_control_set_ptr->parent_pcs_ptr->temporal_layer_index == 0) {
+        EncodeTDAv1(
+            picture_control_set_ptr->bitstreamPtr);
+    }
+    // Code the SPS
+    if (picture_control_set_ptr->parent_pcs_ptr->av1FrameType == KEY_FRAME) {
+        EncodeSPSAv1(
+            picture_control_set_ptr->bitstreamPtr,
+            sequence_control_set_ptr);
+    }
+
+    if (sequence_control_set_ptr->static_config.tile_group_output) {
+        WriteFrameHeaderObuAv1(
+            picture_control_set_ptr->bitstreamPtr,
+            sequence_control_set_ptr,
+            picture_control_set_ptr);
+    }
+    else {
+        WriteFrameHeaderAv1(
+            picture_control_set_ptr->bitstreamPtr,
+            sequence_control_set_ptr,
+            picture_control_set_ptr,
+            0);
+    }
+
+    // Copy Slice Header to the Output Bitstream
+    CopyRbspBitstreamToPayload(
+        picture_control_set_ptr->bitstreamPtr,
+        output_stream_ptr->p_buffer,
+        (uint32_t*) &(output_stream_ptr->n_filled_len),
+        (uint32_t*) &(output_stream_ptr->n_alloc_len),
+        (EncodeContext_t*)sequence_control_set_ptr->encode_context_ptr);
+}
+
+/******************************************************
+ * Packetization Write Tile Group
+ *   Tile group output: writes the tile into its own
+ *   output buffer, the first tile coded also writes the
+ *   headers of the picture
+ ******************************************************/
+static void PacketizationWriteTileGroup(
+    PacketizationReorderEntry_t    *queueEntryPtr,
+    PictureControlSet_t            *picture_control_set_ptr,
+    SequenceControlSet_t           *sequence_control_set_ptr,
+    uint16_t                        tileIdx)
+{
+    PictureParentControlSet_t      *parentPcsPtr = picture_control_set_ptr->parent_pcs_ptr;
+    EbBufferHeaderType             *header_stream_ptr = (EbBufferHeaderType*)parentPcsPtr->output_stream_wrapper_ptr->objectPtr;
+    EbBufferHeaderType             *tile_group_stream_ptr = (EbBufferHeaderType*)parentPcsPtr->tile_group_stream_wrapper_ptr_array[tileIdx]->objectPtr;
+
+    // Hold the parent PCS, its output buffers are posted past the picture
+    if (queueEntryPtr->parent_pcs_wrapper_ptr == EB_NULL) {
+        queueEntryPtr->parent_pcs_wrapper_ptr = picture_control_set_ptr->picture_parent_control_set_wrapper_ptr;
+        queueEntryPtr->posted_part_count = 0;
+        EbObjectIncLiveCount(
+            queueEntryPtr->parent_pcs_wrapper_ptr,
+            1);
+
+        PacketizationInitOutputStream(
+            header_stream_ptr,
+            picture_control_set_ptr,
+            sequence_control_set_ptr,
+            EB_BUFFERFLAG_FRAME_PART);
+        PacketizationWriteFrameHeaders(
+            header_stream_ptr,
+            picture_control_set_ptr,
+            sequence_control_set_ptr);
+    }
+
+    PacketizationInitOutputStream(
+        tile_group_stream_ptr,
+        picture_control_set_ptr,
+        sequence_control_set_ptr,
+        EB_BUFFERFLAG_FRAME_PART);
+
+    ResetBitstream(
+        picture_control_set_ptr->bitstreamPtr->outputBitstreamPtr);
+    WriteTileGroupObuAv1(
+        picture_control_set_ptr->bitstreamPtr,
+        picture_control_set_ptr,
+        tileIdx);
+    CopyRbspBitstreamToPayload(
+        picture_control_set_ptr->bitstreamPtr,
+        tile_group_stream_ptr->p_buffer,
+        (uint32_t*) &(tile_group_stream_ptr->n_filled_len),
+        (uint32_t*) &(tile_group_stream_ptr->n_alloc_len),
+        (EncodeContext_t*)sequence_control_set_ptr->encode_context_ptr);
+}
+
+/******************************************************
+ * Packetization Post Frame Parts
+ *   Tile group output: posts, in order, the parts of
+ *   the picture at the head of the queue written so
+ *   far: its headers, then a tile group per tile. The
+ *   last tile group is posted with the picture.
+ ******************************************************/
+static void PacketizationPostFrameParts(
+    PacketizationReorderEntry_t    *queueEntryPtr)
+{
+    PictureParentControlSet_t      *parentPcsPtr;
+    EbObjectWrapper_t              *partWrapperPtr;
+
+    if (queueEntryPtr->parent_pcs_wrapper_ptr == EB_NULL)
+        return;
+
+    parentPcsPtr = (PictureParentControlSet_t*)queueEntryPtr->parent_pcs_wrapper_ptr->objectPtr;
+    while (queueEntryPtr->posted_part_count < parentPcsPtr->tile_group_count) {
+        partWrapperPtr = queueEntryPtr->posted_part_count == 0 ?
+            parentPcsPtr->output_stream_wrapper_ptr :
+            parentPcsPtr->tile_group_stream_wrapper_ptr_array[queueEntryPtr->posted_part_count - 1];
+
+        // Not coded yet
+        if (((EbBufferHeaderType*)partWrapperPtr->objectPtr)->n_filled_len == 0)
+            break;
+
+        EbPostFullObject(partWrapperPtr);
+        ++queueEntryPtr->posted_part_count;
+    }
+}
+
 void* PacketizationKernel(void *input_ptr)
 {
     // Context
@@ -76,9 +294,6 @@ void* PacketizationKernel(void *input_ptr)
     PacketizationReorderEntry_t    *queueEntryPtr;
     EbLinkedListNode               *appDataLLHeadTempPtr;
 
-    context_ptr->totShownFrames = 0;
-    context_ptr->dispOrderContinuityCount = 0;
-
     for (;;) {
 
         // Get EntropyCoding Results
@@ -97,23 +312,25 @@ void* PacketizationKernel(void *input_ptr)
         //get a new entry spot
         queueEntryIndex = picture_control_set_ptr->parent_pcs_ptr->decode_order % PACKETIZATION_REORDER_QUEUE_MAX_DEPTH;
         queueEntryPtr = encode_context_ptr->packetization_reorder_queue[queueEntryIndex];
+
+        // Tile group output: write the coded tile, and post the parts of the head picture that are ready
+        if (entropyCodingResultsPtr->resultType == ENTROPY_CODING_RESULTS_TILE) {
+            PacketizationWriteTileGroup(
+                queueEntryPtr,
+                picture_control_set_ptr,
+                sequence_control_set_ptr,
+                entropyCodingResultsPtr->tile_index);
+
+            PacketizationPostFrameParts(
+                encode_context_ptr->packetization_reorder_queue[encode_context_ptr->packetization_reorder_queue_head_index]);
+
+            EbReleaseObject(entropyCodingResultsWrapperPtr);
+            continue;
+        }
+
         queueEntryPtr->start_time_seconds = picture_control_set_ptr->parent_pcs_ptr->start_time_seconds;
         queueEntryPtr->start_time_u_seconds = picture_control_set_ptr->parent_pcs_ptr->start_time_u_seconds;
 
-        //TODO: The output buffer should be big enough to avoid a deadlock here. Add an assert that make the warning
-        // Get  Output Bitstream buffer
-        output_stream_wrapper_ptr = picture_control_set_ptr->parent_pcs_ptr->output_stream_wrapper_ptr;
-        output_stream_ptr = (EbBufferHeaderType*)output_stream_wrapper_ptr->objectPtr;
-        output_stream_ptr->flags = 0;
-        output_stream_ptr->flags |= (encode_context_ptr->terminating_sequence_flag_received == EB_TRUE && picture_control_set_ptr->parent_pcs_ptr->decode_order == encode_context_ptr->terminating_picture_number) ? EB_BUFFERFLAG_EOS : 0;
-        output_stream_ptr->n_filled_len = 0;
-        output_stream_ptr->pts = picture_control_set_ptr->parent_pcs_ptr->input_ptr->pts;
-        output_stream_ptr->dts = picture_control_set_ptr->parent_pcs_ptr->decode_order - (uint64_t)(1 << sequence_control_set_ptr->static_config.hierarchical_levels) + 1;
-        output_stream_ptr->pic_type = picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag ?
-            picture_control_set_ptr->parent_pcs_ptr->idr_flag ? EB_IDR_PICTURE :
-            picture_control_set_ptr->slice_type : EB_NON_REF_PICTURE;
-        output_stream_ptr->p_app_private = picture_control_set_ptr->parent_pcs_ptr->input_ptr->p_app_private;
-
         // Get Empty Rate Control Input Tasks
         EbGetEmptyObject(
             context_ptr->rateControlTasksOutputFifoPtr,
@@ -122,36 +339,43 @@ void* PacketizationKernel(void *input_ptr)
         rateControlTasksPtr->pictureControlSetWrapperPtr = picture_control_set_ptr->picture_parent_control_set_wrapper_ptr;
         rateControlTasksPtr->taskType = RC_PACKETIZATION_FEEDBACK_RESULT;
 
-        // slice_type = picture_control_set_ptr->slice_type;
-         // Reset the bitstream before writing to it
-        ResetBitstream(
-            picture_control_set_ptr->bitstreamPtr->outputBitstreamPtr);
-
+        if (sequence_control_set_ptr->static_config.tile_group_output) {
+            uint16_t tileIdx;
+
+            // The tiles not output ahead of the picture, all of them in SB row latency mode
+            for (tileIdx = 0; tileIdx < picture_control_set_ptr->parent_pcs_ptr->tile_group_count; ++tileIdx) {
+                if (((EbBufferHeaderType*)picture_control_set_ptr->parent_pcs_ptr->tile_group_stream_wrapper_ptr_array[tileIdx]->objectPtr)->n_filled_len == 0) {
+                    PacketizationWriteTileGroup(
+                        queueEntryPtr,
+                        picture_control_set_ptr,
+                        sequence_control_set_ptr,
+                        tileIdx);
+                }
+            }
 
-        if (picture_control_set_ptr->parent_pcs_ptr->showFrame && picture_control_set_ptr->parent_pcs_ptr->temporal_layer_index == 0) {
-            EncodeTDAv1(
-                picture_control_set_ptr->bitstreamPtr);
+            // The last tile group ends the frame
+            output_stream_wrapper_ptr = picture_control_set_ptr->parent_pcs_ptr->tile_group_stream_wrapper_ptr_array[picture_control_set_ptr->parent_pcs_ptr->tile_group_count - 1];
+            output_stream_ptr = (EbBufferHeaderType*)output_stream_wrapper_ptr->objectPtr;
+            output_stream_ptr->flags |= EB_BUFFERFLAG_FRAME_END;
         }
-        // Code the SPS
-        if (picture_control_set_ptr->parent_pcs_ptr->av1FrameType == KEY_FRAME) {
-            EncodeSPSAv1(
-                picture_control_set_ptr->bitstreamPtr,
+        else {
+            //TODO: The output buffer should be big enough to avoid a deadlock here. Add an assert that make the warning
+            // Get  Output Bitstream buffer
+            output_stream_wrapper_ptr = picture_control_set_ptr->parent_pcs_ptr->output_stream_wrapper_ptr;
+            output_stream_ptr = (EbBufferHeaderType*)output_stream_wrapper_ptr->objectPtr;
+            PacketizationInitOutputStream(
+                output_stream_ptr,
+                picture_control_set_ptr,
+                sequence_control_set_ptr,
+                0);
+
+            PacketizationWriteFrameHeaders(
+                output_stream_ptr,
+                picture_control_set_ptr,
                 sequence_control_set_ptr);
         }
+        output_stream_ptr->flags |= (encode_context_ptr->terminating_sequence_flag_received == EB_TRUE && picture_control_set_ptr->parent_pcs_ptr->decode_order == encode_context_ptr->terminating_picture_number) ? EB_BUFFERFLAG_EOS : 0;
 
-        WriteFrameHeaderAv1(
-            picture_control_set_ptr->bitstreamPtr,
-            sequence_control_set_ptr,
-            picture_control_set_ptr,
-            0);
-
-        // Copy Slice Header to the Output Bitstream
-        CopyRbspBitstreamToPayload(
-            picture_control_set_ptr->bitstreamPtr,
-            output_stream_ptr->p_buffer,
-            (uint32_t*) &(output_stream_ptr->n_filled_len),
-            (uint32_t*) &(output_stream_ptr->n_alloc_len),
-            encode_context_ptr);
         if (picture_control_set_ptr->parent_pcs_ptr->hasShowExisting) {
             // Reset the bitstream before writing to it
             ResetBitstream(
@@ -175,6 +399,12 @@ void* PacketizationKernel(void *input_ptr)
 
         // Send the number of bytes per frame to RC
         picture_control_set_ptr->parent_pcs_ptr->total_num_bits = output_stream_ptr->n_filled_len << 3;
+        if (sequence_control_set_ptr->static_config.tile_group_output) {
+            uint16_t tileIdx;
+            picture_control_set_ptr->parent_pcs_ptr->total_num_bits += ((EbBufferHeaderType*)picture_control_set_ptr->parent_pcs_ptr->output_stream_wrapper_ptr->objectPtr)->n_filled_len << 3;
+            for (tileIdx = 0; tileIdx < picture_control_set_ptr->parent_pcs_ptr->tile_group_count - 1; ++tileIdx)
+                picture_control_set_ptr->parent_pcs_ptr->total_num_bits += ((EbBufferHeaderType*)picture_control_set_ptr->parent_pcs_ptr->tile_group_stream_wrapper_ptr_array[tileIdx]->objectPtr)->n_filled_len << 3;
+        }
         queueEntryPtr->av1FrameType = picture_control_set_ptr->parent_pcs_ptr->av1FrameType;
         queueEntryPtr->poc = picture_control_set_ptr->picture_number;
         memcpy(&queueEntryPtr->av1RefSignal, &picture_control_set_ptr->parent_pcs_ptr->av1RefSignal, sizeof(Av1RpsNode_t));
@@ -187,6 +417,16 @@ void* PacketizationKernel(void *input_ptr)
         queueEntryPtr->hasShowExisting = picture_control_set_ptr->parent_pcs_ptr->hasShowExisting;
         queueEntryPtr->showExistingLoc = picture_control_set_ptr->parent_pcs_ptr->showExistingLoc;
 
+        if (sequence_control_set_ptr->static_config.frame_stats) {
+            PictureStageDone(
+                picture_control_set_ptr->parent_pcs_ptr,
+                LATENCY_STAGE_PACKETIZATION);
+            PacketizationFrameStats(
+                output_stream_ptr,
+                picture_control_set_ptr,
+                sequence_control_set_ptr);
+        }
+
         //Store the output buffer in the Queue
         queueEntryPtr->output_stream_wrapper_ptr = output_stream_wrapper_ptr;
 
@@ -220,15 +460,14 @@ void* PacketizationKernel(void *input_ptr)
         //Release the Parent PCS then the Child PCS
         EbReleaseObject(entropyCodingResultsPtr->pictureControlSetWrapperPtr);//Child
 
-        // Release the Entropy Coding Result
-        EbReleaseObject(entropyCodingResultsWrapperPtr);
-
 
         //****************************************************
         // Process the head of the queue
         //****************************************************
         // Look at head of queue and see if any picture is ready to go
         queueEntryPtr = encode_context_ptr->packetization_reorder_queue[encode_context_ptr->packetization_reorder_queue_head_index];
+        PacketizationPostFrameParts(
+            queueEntryPtr);
 
         while (queueEntryPtr->output_stream_wrapper_ptr != EB_NULL) {
 
@@ -346,6 +585,15 @@ void* PacketizationKernel(void *input_ptr)
                 &latency);
 
             output_stream_ptr->n_tick_count = (uint32_t)latency;
+
+            if (output_stream_ptr->frame_stats) {
+                EbComputeOverallElapsedTimeUs(
+                    queueEntryPtr->start_time_seconds,
+                    queueEntryPtr->start_time_u_seconds,
+                    finishTimeSeconds,
+                    finishTimeuSeconds,
+                    &output_stream_ptr->frame_stats->latency);
+            }
             output_stream_ptr->p_app_private = queueEntryPtr->outMetaData;
             EbPostFullObject(output_stream_wrapper_ptr);
             queueEntryPtr->outMetaData = (EbLinkedListNode *)EB_NULL;
@@ -354,6 +602,12 @@ void* PacketizationKernel(void *input_ptr)
             queueEntryPtr->picture_number += PACKETIZATION_REORDER_QUEUE_MAX_DEPTH;
             queueEntryPtr->output_stream_wrapper_ptr = (EbObjectWrapper_t *)EB_NULL;
 
+            // Tile group output: all the parts are posted
+            if (queueEntryPtr->parent_pcs_wrapper_ptr != EB_NULL) {
+                EbReleaseObject(queueEntryPtr->parent_pcs_wrapper_ptr);
+                queueEntryPtr->parent_pcs_wrapper_ptr = (EbObjectWrapper_t *)EB_NULL;
+            }
+
             if (encode_context_ptr->statistics_port_active) {
                 queueEntryPtr->outputStatisticsWrapperPtr = (EbObjectWrapper_t *)EB_NULL;
             }
@@ -362,9 +616,14 @@ void* PacketizationKernel(void *input_ptr)
                 (encode_context_ptr->packetization_reorder_queue_head_index == PACKETIZATION_REORDER_QUEUE_MAX_DEPTH - 1) ? 0 : encode_context_ptr->packetization_reorder_queue_head_index + 1;
 
             queueEntryPtr = encode_context_ptr->packetization_reorder_queue[encode_context_ptr->packetization_reorder_queue_head_index];
+            PacketizationPostFrameParts(
+                queueEntryPtr);
 
         }
 
+        // Release the Entropy Coding Result, the pipeline is idle once all the results are
+        EbReleaseObject(entropyCodingResultsWrapperPtr);
+
     }
     return EB_NULL;
 }
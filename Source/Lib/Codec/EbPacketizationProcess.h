@@ -45,6 +45,9 @@ extern "C" {
         EbFifo_t                *entropyCodingInputFifoPtr,
         EbFifo_t                *rateControlTasksOutputFifoPtr);
 
+    extern void PacketizationContextReset(
+        PacketizationContext_t  *context_ptr);
+
 
 
     extern void* PacketizationKernel(void *input_ptr);
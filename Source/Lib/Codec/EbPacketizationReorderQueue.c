@@ -16,6 +16,8 @@ EbErrorType PacketizationReorderEntryCtor(
     (*entryDblPtr)->output_stream_wrapper_ptr = (EbObjectWrapper_t *)EB_NULL;
     (*entryDblPtr)->outputStatisticsWrapperPtr = (EbObjectWrapper_t *)EB_NULL;
     (*entryDblPtr)->outMetaData = (EbLinkedListNode*)EB_NULL;
+    (*entryDblPtr)->parent_pcs_wrapper_ptr = (EbObjectWrapper_t *)EB_NULL;
+    (*entryDblPtr)->posted_part_count = 0;
 
     return EB_ErrorNone;
 }
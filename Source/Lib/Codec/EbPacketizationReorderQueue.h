@@ -23,6 +23,10 @@ extern "C" {
 
         EbLinkedListNode               *outMetaData;
 
+        // Tile group output: the parent PCS is held until its parts are all posted
+        EbObjectWrapper_t              *parent_pcs_wrapper_ptr;
+        uint16_t                        posted_part_count;
+
         uint64_t                          start_time_seconds;
         uint64_t                          start_time_u_seconds;
 
@@ -706,7 +706,7 @@ uint64_t ComputeVariance64x64(
 
 
     else {
-        if (asm_type == ASM_AVX2) {
+        if (asm_type >= ASM_AVX2) {
 
             ComputeIntermVarFour8x8_AVX2_INTRIN(&(inputPaddedPicturePtr->bufferY[blockIndex]), strideY, &meanOf8x8Blocks[0], &meanOf8x8SquaredValuesBlocks[0]);
 
@@ -2332,7 +2332,7 @@ EbErrorType ComputeBlockMeanComputeVariance(
     else {
         const uint16_t strideY = inputPaddedPicturePtr->strideY;
 
-        if (asm_type == ASM_AVX2) {
+        if (asm_type >= ASM_AVX2) {
 
             ComputeIntermVarFour8x8_AVX2_INTRIN(&(inputPaddedPicturePtr->bufferY[blockIndex]), strideY, &meanOf8x8Blocks[0], &meanOf8x8SquaredValuesBlocks[0]);
 
@@ -5043,6 +5043,10 @@ void* PictureAnalysisKernel(void *input_ptr)
 
         }
 
+        PictureStageDone(
+            picture_control_set_ptr,
+            LATENCY_STAGE_PICTURE_ANALYSIS);
+
         // Get Empty Results Object
         EbGetEmptyObject(
             context_ptr->pictureAnalysisResultsOutputFifoPtr,
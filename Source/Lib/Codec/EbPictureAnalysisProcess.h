@@ -55,6 +55,8 @@ static EB_WEAKLUMAFILTER_TYPE FUNC_TABLE WeakLumaFilter_funcPtrArray[ASM_TYPE_TO
     noiseExtractLumaWeak,
     // AVX2
     noiseExtractLumaWeak_AVX2_INTRIN,
+    // AVX512
+    noiseExtractLumaWeak_AVX2_INTRIN,
 
 };
 
@@ -71,6 +73,8 @@ static EB_WEAKLUMAFILTER_TYPE FUNC_TABLE WeakLumaFilterLcu_funcPtrArray[ASM_TYPE
     noiseExtractLumaWeakLcu,
     // AVX2
     noiseExtractLumaWeakLcu_AVX2_INTRIN,
+    // AVX512
+    noiseExtractLumaWeakLcu_AVX2_INTRIN,
 
 };
 
@@ -93,6 +97,8 @@ static EB_STRONGLUMAFILTER_TYPE FUNC_TABLE StrongLumaFilter_funcPtrArray[ASM_TYP
     noiseExtractLumaStrong,
     // AVX2
     noiseExtractLumaStrong_AVX2_INTRIN,
+    // AVX512
+    noiseExtractLumaStrong_AVX2_INTRIN,
 
 };
 void noiseExtractChromaStrong(
@@ -113,6 +119,8 @@ static EB_STRONGCHROMAFILTER_TYPE FUNC_TABLE StrongChromaFilter_funcPtrArray[ASM
     noiseExtractChromaStrong,
     // AVX2
     noiseExtractChromaStrong_AVX2_INTRIN,
+    // AVX512
+    noiseExtractChromaStrong_AVX2_INTRIN,
 
 };
 
@@ -134,6 +142,8 @@ static EB_WEAKCHROMAFILTER_TYPE FUNC_TABLE WeakChromaFilter_funcPtrArray[ASM_TYP
     noiseExtractChromaWeak,
     // AVX2
     noiseExtractChromaWeak_AVX2_INTRIN,
+    // AVX512
+    noiseExtractChromaWeak_AVX2_INTRIN,
 
 };
 
@@ -19,6 +19,9 @@
 #include "EbDefinitions.h"
 #include "EbPictureControlSet.h"
 #include "EbPictureBufferDesc.h"
+#include "EbCdef.h"
+#include "EbSequenceControlSet.h"
+#include "EbTime.h"
 
 
 
@@ -60,6 +63,8 @@ EbErrorType PictureControlSetCtor(
     // LCUs
     const uint16_t pictureLcuWidth = (uint16_t)((initDataPtr->picture_width + initDataPtr->sb_sz - 1) / initDataPtr->sb_sz);
     const uint16_t pictureLcuHeight = (uint16_t)((initDataPtr->picture_height + initDataPtr->sb_sz - 1) / initDataPtr->sb_sz);
+    const uint32_t neighborArrayWidth = NEIGHBOR_ARRAY_SIZE(initDataPtr->picture_width);
+    const uint32_t neighborArrayHeight = NEIGHBOR_ARRAY_SIZE(initDataPtr->picture_height);
     uint16_t sb_index;
     uint16_t sb_origin_x;
     uint16_t sb_origin_y;
@@ -166,13 +171,17 @@ EbErrorType PictureControlSetCtor(
     }
 
 
-    // Entropy Coder
-    return_error = EntropyCoderCtor(
-        &objectPtr->entropy_coder_ptr,
-        SEGMENT_ENTROPY_BUFFER_SIZE);
+    // Entropy Coders, one per tile
+    objectPtr->entropy_coder_count = initDataPtr->tile_count;
+    EB_MALLOC(EntropyCoder_t**, objectPtr->entropy_coder_ptr_array, sizeof(EntropyCoder_t*) * objectPtr->entropy_coder_count, EB_N_PTR);
+    for (uint16_t tileIndex = 0; tileIndex < objectPtr->entropy_coder_count; ++tileIndex) {
+        return_error = EntropyCoderCtor(
+            &objectPtr->entropy_coder_ptr_array[tileIndex],
+            SEGMENT_ENTROPY_BUFFER_SIZE);
 
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
+        if (return_error == EB_ErrorInsufficientResources) {
+            return EB_ErrorInsufficientResources;
+        }
     }
 
     // Packetization process Bitstream
@@ -199,6 +208,10 @@ EbErrorType PictureControlSetCtor(
     objectPtr->sb_total_count = pictureLcuWidth * pictureLcuHeight;
     EB_MALLOC(LargestCodingUnit_t**, objectPtr->sb_ptr_array, sizeof(LargestCodingUnit_t*) * objectPtr->sb_total_count, EB_N_PTR);
 
+    // Enc/DecQP Assignment
+    EB_MALLOC(uint8_t*, objectPtr->enc_prev_coded_qp, sizeof(uint8_t) * ((initDataPtr->picture_height + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64), EB_N_PTR);
+    EB_MALLOC(uint8_t*, objectPtr->enc_prev_quant_group_coded_qp, sizeof(uint8_t) * ((initDataPtr->picture_height + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64), EB_N_PTR);
+
     sb_origin_x = 0;
     sb_origin_y = 0;
 
@@ -260,8 +273,8 @@ EbErrorType PictureControlSetCtor(
     for (depth = 0; depth < NEIGHBOR_ARRAY_TOTAL_COUNT; depth++) {
         return_error = NeighborArrayUnitCtor(
             &objectPtr->md_intra_luma_mode_neighbor_array[depth],
-            MAX_PICTURE_WIDTH_SIZE,
-            MAX_PICTURE_HEIGHT_SIZE,
+            neighborArrayWidth,
+            neighborArrayHeight,
             sizeof(uint8_t),
             PU_NEIGHBOR_ARRAY_GRANULARITY,
             PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -269,8 +282,8 @@ EbErrorType PictureControlSetCtor(
 
         return_error = NeighborArrayUnitCtor(
             &objectPtr->md_intra_chroma_mode_neighbor_array[depth],
-            MAX_PICTURE_WIDTH_SIZE >> 1,
-            MAX_PICTURE_HEIGHT_SIZE >> 1,
+            neighborArrayWidth >> 1,
+            neighborArrayHeight >> 1,
             sizeof(uint8_t),
             PU_NEIGHBOR_ARRAY_GRANULARITY,
             PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -281,8 +294,8 @@ EbErrorType PictureControlSetCtor(
         }
         return_error = NeighborArrayUnitCtor(
             &objectPtr->md_mv_neighbor_array[depth],
-            MAX_PICTURE_WIDTH_SIZE,
-            MAX_PICTURE_HEIGHT_SIZE,
+            neighborArrayWidth,
+            neighborArrayHeight,
             sizeof(MvUnit_t),
             PU_NEIGHBOR_ARRAY_GRANULARITY,
             PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -293,8 +306,8 @@ EbErrorType PictureControlSetCtor(
         }
         return_error = NeighborArrayUnitCtor(
             &objectPtr->md_skip_flag_neighbor_array[depth],
-            MAX_PICTURE_WIDTH_SIZE,
-            MAX_PICTURE_HEIGHT_SIZE,
+            neighborArrayWidth,
+            neighborArrayHeight,
             sizeof(uint8_t),
             PU_NEIGHBOR_ARRAY_GRANULARITY,
             PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -305,8 +318,8 @@ EbErrorType PictureControlSetCtor(
         }
         return_error = NeighborArrayUnitCtor(
             &objectPtr->md_mode_type_neighbor_array[depth],
-            MAX_PICTURE_WIDTH_SIZE,
-            MAX_PICTURE_HEIGHT_SIZE,
+            neighborArrayWidth,
+            neighborArrayHeight,
             sizeof(uint8_t),
             PU_NEIGHBOR_ARRAY_GRANULARITY,
             PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -317,8 +330,8 @@ EbErrorType PictureControlSetCtor(
         }
         return_error = NeighborArrayUnitCtor(
             &objectPtr->md_leaf_depth_neighbor_array[depth],
-            MAX_PICTURE_WIDTH_SIZE,
-            MAX_PICTURE_HEIGHT_SIZE,
+            neighborArrayWidth,
+            neighborArrayHeight,
             sizeof(uint8_t),
             PU_NEIGHBOR_ARRAY_GRANULARITY,
             PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -330,8 +343,8 @@ EbErrorType PictureControlSetCtor(
 
         return_error = NeighborArrayUnitCtor(
             &objectPtr->mdleaf_partition_neighbor_array[depth],
-            MAX_PICTURE_WIDTH_SIZE,
-            MAX_PICTURE_HEIGHT_SIZE,
+            neighborArrayWidth,
+            neighborArrayHeight,
             sizeof(struct PartitionContext),
             PU_NEIGHBOR_ARRAY_GRANULARITY,
             PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -343,8 +356,8 @@ EbErrorType PictureControlSetCtor(
 
         return_error = NeighborArrayUnitCtor(
             &objectPtr->md_luma_recon_neighbor_array[depth],
-            MAX_PICTURE_WIDTH_SIZE,
-            MAX_PICTURE_HEIGHT_SIZE,
+            neighborArrayWidth,
+            neighborArrayHeight,
             sizeof(uint8_t),
             SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
             SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
@@ -355,8 +368,8 @@ EbErrorType PictureControlSetCtor(
 
         return_error = NeighborArrayUnitCtor(
             &objectPtr->md_cb_recon_neighbor_array[depth],
-            MAX_PICTURE_WIDTH_SIZE >> 1,
-            MAX_PICTURE_HEIGHT_SIZE >> 1,
+            neighborArrayWidth >> 1,
+            neighborArrayHeight >> 1,
             sizeof(uint8_t),
             SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
             SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
@@ -368,8 +381,8 @@ EbErrorType PictureControlSetCtor(
 
         return_error = NeighborArrayUnitCtor(
             &objectPtr->md_cr_recon_neighbor_array[depth],
-            MAX_PICTURE_WIDTH_SIZE >> 1,
-            MAX_PICTURE_HEIGHT_SIZE >> 1,
+            neighborArrayWidth >> 1,
+            neighborArrayHeight >> 1,
             sizeof(uint8_t),
             SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
             SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
@@ -381,8 +394,8 @@ EbErrorType PictureControlSetCtor(
 
         return_error = NeighborArrayUnitCtor(
             &objectPtr->md_skip_coeff_neighbor_array[depth],
-            MAX_PICTURE_WIDTH_SIZE,
-            MAX_PICTURE_HEIGHT_SIZE,
+            neighborArrayWidth,
+            neighborArrayHeight,
             sizeof(uint8_t),
             PU_NEIGHBOR_ARRAY_GRANULARITY,
             PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -394,8 +407,8 @@ EbErrorType PictureControlSetCtor(
         // for each 4x4
         return_error = NeighborArrayUnitCtor(
             &objectPtr->md_luma_dc_sign_level_coeff_neighbor_array[depth],
-            MAX_PICTURE_WIDTH_SIZE,
-            MAX_PICTURE_HEIGHT_SIZE,
+            neighborArrayWidth,
+            neighborArrayHeight,
             sizeof(uint8_t),
             PU_NEIGHBOR_ARRAY_GRANULARITY,
             PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -407,8 +420,8 @@ EbErrorType PictureControlSetCtor(
         // for each 4x4
         return_error = NeighborArrayUnitCtor(
             &objectPtr->md_cr_dc_sign_level_coeff_neighbor_array[depth],
-            MAX_PICTURE_WIDTH_SIZE,
-            MAX_PICTURE_HEIGHT_SIZE,
+            neighborArrayWidth,
+            neighborArrayHeight,
             sizeof(uint8_t),
             PU_NEIGHBOR_ARRAY_GRANULARITY,
             PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -420,8 +433,8 @@ EbErrorType PictureControlSetCtor(
         // for each 4x4
         return_error = NeighborArrayUnitCtor(
             &objectPtr->md_cb_dc_sign_level_coeff_neighbor_array[depth],
-            MAX_PICTURE_WIDTH_SIZE,
-            MAX_PICTURE_HEIGHT_SIZE,
+            neighborArrayWidth,
+            neighborArrayHeight,
             sizeof(uint8_t),
             PU_NEIGHBOR_ARRAY_GRANULARITY,
             PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -433,8 +446,8 @@ EbErrorType PictureControlSetCtor(
 
         return_error = NeighborArrayUnitCtor(
             &objectPtr->md_inter_pred_dir_neighbor_array[depth],
-            MAX_PICTURE_WIDTH_SIZE,
-            MAX_PICTURE_HEIGHT_SIZE,
+            neighborArrayWidth,
+            neighborArrayHeight,
             sizeof(uint8_t),
             PU_NEIGHBOR_ARRAY_GRANULARITY,
             PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -446,8 +459,8 @@ EbErrorType PictureControlSetCtor(
 
         return_error = NeighborArrayUnitCtor(
             &objectPtr->md_ref_frame_type_neighbor_array[depth],
-            MAX_PICTURE_WIDTH_SIZE,
-            MAX_PICTURE_HEIGHT_SIZE,
+            neighborArrayWidth,
+            neighborArrayHeight,
             sizeof(uint8_t),
             PU_NEIGHBOR_ARRAY_GRANULARITY,
             PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -456,8 +469,8 @@ EbErrorType PictureControlSetCtor(
 
         return_error = NeighborArrayUnitCtor32(
             &objectPtr->md_interpolation_type_neighbor_array[depth],
-            MAX_PICTURE_WIDTH_SIZE,
-            MAX_PICTURE_HEIGHT_SIZE,
+            neighborArrayWidth,
+            neighborArrayHeight,
             sizeof(uint32_t),
             PU_NEIGHBOR_ARRAY_GRANULARITY,
             PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -475,8 +488,8 @@ EbErrorType PictureControlSetCtor(
 
     return_error = NeighborArrayUnitCtor(
         &objectPtr->md_refinement_intra_luma_mode_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
+        neighborArrayWidth,
+        neighborArrayHeight,
         sizeof(uint8_t),
         PU_NEIGHBOR_ARRAY_GRANULARITY,
         PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -488,8 +501,8 @@ EbErrorType PictureControlSetCtor(
 
     return_error = NeighborArrayUnitCtor(
         &objectPtr->md_refinement_mode_type_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
+        neighborArrayWidth,
+        neighborArrayHeight,
         sizeof(uint8_t),
         PU_NEIGHBOR_ARRAY_GRANULARITY,
         PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -501,8 +514,8 @@ EbErrorType PictureControlSetCtor(
 
     return_error = NeighborArrayUnitCtor(
         &objectPtr->md_refinement_luma_recon_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
+        neighborArrayWidth,
+        neighborArrayHeight,
         sizeof(uint8_t),
         SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
         SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
@@ -514,8 +527,8 @@ EbErrorType PictureControlSetCtor(
     // Encode Pass Neighbor Arrays
     return_error = NeighborArrayUnitCtor(
         &objectPtr->ep_intra_luma_mode_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
+        neighborArrayWidth,
+        neighborArrayHeight,
         sizeof(uint8_t),
         PU_NEIGHBOR_ARRAY_GRANULARITY,
         PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -524,8 +537,8 @@ EbErrorType PictureControlSetCtor(
     // Encode Pass Neighbor Arrays
     return_error = NeighborArrayUnitCtor(
         &objectPtr->ep_intra_chroma_mode_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE >> 1,
-        MAX_PICTURE_HEIGHT_SIZE >> 1,
+        neighborArrayWidth >> 1,
+        neighborArrayHeight >> 1,
         sizeof(uint8_t),
         PU_NEIGHBOR_ARRAY_GRANULARITY,
         PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -536,8 +549,8 @@ EbErrorType PictureControlSetCtor(
     }
     return_error = NeighborArrayUnitCtor(
         &objectPtr->ep_mv_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
+        neighborArrayWidth,
+        neighborArrayHeight,
         sizeof(MvUnit_t),
         PU_NEIGHBOR_ARRAY_GRANULARITY,
         PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -548,8 +561,8 @@ EbErrorType PictureControlSetCtor(
     }
     return_error = NeighborArrayUnitCtor(
         &objectPtr->ep_skip_flag_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
+        neighborArrayWidth,
+        neighborArrayHeight,
         sizeof(uint8_t),
         CU_NEIGHBOR_ARRAY_GRANULARITY,
         CU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -560,8 +573,8 @@ EbErrorType PictureControlSetCtor(
     }
     return_error = NeighborArrayUnitCtor(
         &objectPtr->ep_mode_type_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
+        neighborArrayWidth,
+        neighborArrayHeight,
         sizeof(uint8_t),
         PU_NEIGHBOR_ARRAY_GRANULARITY,
         PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -572,8 +585,8 @@ EbErrorType PictureControlSetCtor(
     }
     return_error = NeighborArrayUnitCtor(
         &objectPtr->ep_leaf_depth_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
+        neighborArrayWidth,
+        neighborArrayHeight,
         sizeof(uint8_t),
         PU_NEIGHBOR_ARRAY_GRANULARITY,
         PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -586,8 +599,8 @@ EbErrorType PictureControlSetCtor(
 
     return_error = NeighborArrayUnitCtor(
         &objectPtr->ep_luma_recon_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
+        neighborArrayWidth,
+        neighborArrayHeight,
         sizeof(uint8_t),
         SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
         SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
@@ -598,8 +611,8 @@ EbErrorType PictureControlSetCtor(
     }
     return_error = NeighborArrayUnitCtor(
         &objectPtr->ep_cb_recon_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE >> 1,
-        MAX_PICTURE_HEIGHT_SIZE >> 1,
+        neighborArrayWidth >> 1,
+        neighborArrayHeight >> 1,
         sizeof(uint8_t),
         SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
         SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
@@ -610,8 +623,8 @@ EbErrorType PictureControlSetCtor(
     }
     return_error = NeighborArrayUnitCtor(
         &objectPtr->ep_cr_recon_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE >> 1,
-        MAX_PICTURE_HEIGHT_SIZE >> 1,
+        neighborArrayWidth >> 1,
+        neighborArrayHeight >> 1,
         sizeof(uint8_t),
         SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
         SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
@@ -624,8 +637,8 @@ EbErrorType PictureControlSetCtor(
     if (is16bit) {
         return_error = NeighborArrayUnitCtor(
             &objectPtr->ep_luma_recon_neighbor_array16bit,
-            MAX_PICTURE_WIDTH_SIZE,
-            MAX_PICTURE_HEIGHT_SIZE,
+            neighborArrayWidth,
+            neighborArrayHeight,
             sizeof(uint16_t),
             SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
             SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
@@ -636,8 +649,8 @@ EbErrorType PictureControlSetCtor(
         }
         return_error = NeighborArrayUnitCtor(
             &objectPtr->ep_cb_recon_neighbor_array16bit,
-            MAX_PICTURE_WIDTH_SIZE >> 1,
-            MAX_PICTURE_HEIGHT_SIZE >> 1,
+            neighborArrayWidth >> 1,
+            neighborArrayHeight >> 1,
             sizeof(uint16_t),
             SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
             SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
@@ -648,8 +661,8 @@ EbErrorType PictureControlSetCtor(
         }
         return_error = NeighborArrayUnitCtor(
             &objectPtr->ep_cr_recon_neighbor_array16bit,
-            MAX_PICTURE_WIDTH_SIZE >> 1,
-            MAX_PICTURE_HEIGHT_SIZE >> 1,
+            neighborArrayWidth >> 1,
+            neighborArrayHeight >> 1,
             sizeof(uint16_t),
             SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
             SAMPLE_NEIGHBOR_ARRAY_GRANULARITY,
@@ -666,8 +679,8 @@ EbErrorType PictureControlSetCtor(
 
     return_error = NeighborArrayUnitCtor(
         &objectPtr->amvp_mv_merge_mv_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
+        neighborArrayWidth,
+        neighborArrayHeight,
         sizeof(MvUnit_t),
         PU_NEIGHBOR_ARRAY_GRANULARITY,
         PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -678,8 +691,8 @@ EbErrorType PictureControlSetCtor(
     }
     return_error = NeighborArrayUnitCtor(
         &objectPtr->amvp_mv_merge_mode_type_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
+        neighborArrayWidth,
+        neighborArrayHeight,
         sizeof(uint8_t),
         PU_NEIGHBOR_ARRAY_GRANULARITY,
         PU_NEIGHBOR_ARRAY_GRANULARITY,
@@ -688,147 +701,6 @@ EbErrorType PictureControlSetCtor(
     if (return_error == EB_ErrorInsufficientResources) {
         return EB_ErrorInsufficientResources;
     }
-    // Entropy Coding Neighbor Arrays
-    return_error = NeighborArrayUnitCtor(
-        &objectPtr->mode_type_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
-    return_error = NeighborArrayUnitCtor(
-        &objectPtr->partition_context_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(struct PartitionContext),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
-    return_error = NeighborArrayUnitCtor(
-        &objectPtr->skip_flag_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
-    return_error = NeighborArrayUnitCtor(
-        &objectPtr->skip_coeff_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-    // for each 4x4
-    return_error = NeighborArrayUnitCtor(
-        &objectPtr->luma_dc_sign_level_coeff_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-    // for each 4x4
-    return_error = NeighborArrayUnitCtor(
-        &objectPtr->cr_dc_sign_level_coeff_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-    // for each 4x4
-    return_error = NeighborArrayUnitCtor(
-        &objectPtr->cb_dc_sign_level_coeff_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
-    return_error = NeighborArrayUnitCtor(
-        &objectPtr->inter_pred_dir_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
-    return_error = NeighborArrayUnitCtor(
-        &objectPtr->ref_frame_type_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    return_error = NeighborArrayUnitCtor32(
-        &objectPtr->interpolation_type_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint32_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
-
-
-    return_error = NeighborArrayUnitCtor(
-        &objectPtr->intra_luma_mode_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
     // Note - non-zero offsets are not supported (to be fixed later in DLF chroma filtering)
     objectPtr->cb_qp_offset = 0;
     objectPtr->cr_qp_offset = 0;
@@ -844,19 +716,36 @@ EbErrorType PictureControlSetCtor(
     // Error Resilience
     objectPtr->constrained_intra_flag = EB_FALSE;
 
-    // Segments
+    // Segments, a segment row per tile row at least
     return_error = EncDecSegmentsCtor(
         &objectPtr->enc_dec_segment_ctrl,
         initDataPtr->enc_dec_segment_col,
-        initDataPtr->enc_dec_segment_row);
+        MAX(initDataPtr->enc_dec_segment_row, pictureLcuHeight));
     if (return_error == EB_ErrorInsufficientResources) {
         return EB_ErrorInsufficientResources;
     }
-    // Entropy Rows
+    // Entropy Tiles
     EB_CREATEMUTEX(EbHandle, objectPtr->entropy_coding_mutex, sizeof(EbHandle), EB_MUTEX);
 
+    EB_MALLOC(EbHandle*, objectPtr->entropy_coding_row_semaphore_array, sizeof(EbHandle) * pictureLcuHeight, EB_N_PTR);
+    for (uint16_t rowIndex = 0; rowIndex < pictureLcuHeight; ++rowIndex) {
+        EB_CREATESEMAPHORE(EbHandle, objectPtr->entropy_coding_row_semaphore_array[rowIndex], sizeof(EbHandle), EB_SEMAPHORE, 0, pictureLcuWidth);
+    }
+
     EB_CREATEMUTEX(EbHandle, objectPtr->intra_mutex, sizeof(EbHandle), EB_MUTEX);
 
+    // In-loop Filter Jobs
+    EB_CREATEMUTEX(EbHandle, objectPtr->filter_mutex, sizeof(EbHandle), EB_MUTEX);
+
+    EB_MALLOC(EbHandle*, objectPtr->dlf_row_semaphore_array, sizeof(EbHandle) * pictureLcuHeight, EB_N_PTR);
+    for (uint16_t rowIndex = 0; rowIndex < pictureLcuHeight; ++rowIndex) {
+        EB_CREATESEMAPHORE(EbHandle, objectPtr->dlf_row_semaphore_array[rowIndex], sizeof(EbHandle), EB_SEMAPHORE, 0, pictureLcuWidth);
+    }
+
+    EB_MALLOC(uint64_t*, objectPtr->cdef_mse[0], sizeof(uint64_t) * objectPtr->sb_total_count * CDEF_PRI_STRENGTHS * CDEF_SEC_STRENGTHS, EB_N_PTR);
+    EB_MALLOC(uint64_t*, objectPtr->cdef_mse[1], sizeof(uint64_t) * objectPtr->sb_total_count * CDEF_PRI_STRENGTHS * CDEF_SEC_STRENGTHS, EB_N_PTR);
+    EB_MALLOC(EbBool*, objectPtr->cdef_fb_valid_array, sizeof(EbBool) * objectPtr->sb_total_count, EB_N_PTR);
+
     objectPtr->cu32x32_quant_coeff_num_map_array_stride = (uint16_t)((initDataPtr->picture_width + 32 - 1) / 32);
     uint16_t cu32x32QuantCoeffNumMapArraySize = (uint16_t)(((initDataPtr->picture_width + 32 - 1) / 32) * ((initDataPtr->picture_height + 32 - 1) / 32));
     EB_MALLOC(int8_t*, objectPtr->cu32x32_quant_coeff_num_map_array, sizeof(int8_t) * cu32x32QuantCoeffNumMapArraySize, EB_N_PTR);
@@ -914,6 +803,9 @@ EbErrorType PictureParentControlSetCtor(
     objectPtr->last_idr_picture = 0;
     objectPtr->sb_total_count = pictureLcuWidth * pictureLcuHeight;
 
+    EB_MALLOC(EbObjectWrapper_t**, objectPtr->tile_group_stream_wrapper_ptr_array, sizeof(EbObjectWrapper_t*) * initDataPtr->tile_count, EB_N_PTR);
+    objectPtr->tile_group_count = 0;
+
     objectPtr->data_ll_head_ptr = (EbLinkedListNode *)EB_NULL;
     objectPtr->app_out_data_ll_head_ptr = (EbLinkedListNode *)EB_NULL;
     EB_MALLOC(uint16_t**, objectPtr->variance, sizeof(uint16_t*) * objectPtr->sb_total_count, EB_N_PTR);
@@ -1087,6 +979,10 @@ EbErrorType PictureParentControlSetCtor(
 
     return_error = av1_alloc_restoration_buffers(objectPtr->av1_cm);
 
+    for (int32_t plane = 0; plane < MAX_MB_PLANE; ++plane) {
+        EB_MALLOC(RestUnitSearchInfo*, objectPtr->rusi_picture[plane], sizeof(RestUnitSearchInfo) * objectPtr->av1_cm->rst_info[plane].units_per_tile, EB_N_PTR);
+    }
+
     memset(&objectPtr->av1_cm->rst_frame, 0, sizeof(Yv12BufferConfig));
 
 
@@ -1113,3 +1009,17 @@ EbErrorType PictureParentControlSetCtor(
     return return_error;
 }
 
+/**************************************
+ * PictureStageDone
+ *   time stamps the end of a pipeline stage for the frame statistics
+ **************************************/
+void PictureStageDone(
+    PictureParentControlSet_t *picture_control_set_ptr,
+    LatencyStage               stage)
+{
+    if (picture_control_set_ptr->sequence_control_set_ptr->static_config.frame_stats) {
+        EbStartTime(
+            &picture_control_set_ptr->stage_time_seconds[stage],
+            &picture_control_set_ptr->stage_time_u_seconds[stage]);
+    }
+}
@@ -13609,9 +13609,26 @@ extern "C" {
         int32_t tile_col_start_sb[MAX_TILE_COLS + 1];  // valid for 0 <= i <= tile_cols
         int32_t tile_row_start_sb[MAX_TILE_ROWS + 1];  // valid for 0 <= i <= tile_rows
         int32_t tile_width, tile_height;               // In MI units
+        int32_t mib_size_log2;                         // Log2 of the superblock size in MI units
+        int32_t tile_size_bytes;                       // Bytes of the tile size fields of the tile group
         struct PictureParentControlSet_s               *p_pcs_ptr;
     } Av1Common;
 
+    // Bounds, in MI units, of the tile holding the MI at (mi_row, mi_col)
+    static INLINE void av1_tile_init(TileInfo *tile, const Av1Common *cm, int32_t mi_row, int32_t mi_col) {
+        int32_t tile_row = 0;
+        int32_t tile_col = 0;
+        while (tile_row < cm->tile_rows - 1 && (cm->tile_row_start_sb[tile_row + 1] << cm->mib_size_log2) <= mi_row)
+            tile_row++;
+        while (tile_col < cm->tile_cols - 1 && (cm->tile_col_start_sb[tile_col + 1] << cm->mib_size_log2) <= mi_col)
+            tile_col++;
+        tile->mi_row_start = cm->tile_row_start_sb[tile_row] << cm->mib_size_log2;
+        tile->mi_row_end = AOMMIN(cm->tile_row_start_sb[tile_row + 1] << cm->mib_size_log2, cm->mi_rows);
+        tile->mi_col_start = cm->tile_col_start_sb[tile_col] << cm->mib_size_log2;
+        tile->mi_col_end = AOMMIN(cm->tile_col_start_sb[tile_col + 1] << cm->mib_size_log2, cm->mi_cols);
+        tile->tg_horz_boundary = 0;
+    }
+
     /**************************************
      * Segment-based Control Sets
      **************************************/
@@ -13672,7 +13689,8 @@ extern "C" {
 
         struct PictureParentControlSet_s     *parent_pcs_ptr;  //The parent of this PCS.
         EbObjectWrapper_t                    *picture_parent_control_set_wrapper_ptr;
-        EntropyCoder_t                       *entropy_coder_ptr;
+        EntropyCoder_t                      **entropy_coder_ptr_array;        // one coder per tile
+        uint16_t                              entropy_coder_count;
         // Packetization (used to encode SPS, PPS, etc)
         Bitstream_t                          *bitstreamPtr;
 
@@ -13688,17 +13706,24 @@ extern "C" {
         
         EncDecSegments_t                     *enc_dec_segment_ctrl;
 
-        // Entropy Process Rows
-        int8_t                                entropy_coding_current_available_row;
-        EbBool                                entropy_coding_row_array[MAX_LCU_ROWS];
-        int8_t                                entropy_coding_current_row;
-        int8_t                                entropy_coding_row_count;
+        // Entropy Process Tiles
+        uint16_t                              entropy_coding_tile_done_count;
         EbHandle                              entropy_coding_mutex;
-        EbBool                                entropy_coding_in_progress;
-        EbBool                                entropy_coding_pic_done;
+        EbHandle                             *entropy_coding_row_semaphore_array; // SB row latency: posted once per SB of the row done by the encdec
         EbHandle                              intra_mutex;
         uint32_t                              intra_coded_area;
 
+        // In-loop Filter Jobs
+        EbHandle                              filter_mutex;
+        uint8_t                               filter_pass;
+        uint32_t                              filter_job_count;
+        uint32_t                              filter_job_next;
+        uint32_t                              filter_job_done;
+        uint32_t                              filter_active_count;    // filter threads currently working on this picture
+        EbHandle                             *dlf_row_semaphore_array; // posted once per deblocked SB of the row, consumed by the row below
+        uint64_t                             *cdef_mse[2];             // CDEF distortion per 64x64 filter block and strength (luma, chroma)
+        EbBool                               *cdef_fb_valid_array;     // filter block was searched (not skipped)
+
         // Mode Decision Config
         MdcLcuData_t                         *mdc_sb_array;
 
@@ -13731,11 +13756,13 @@ extern "C" {
         uint8_t                               prev_quant_group_coded_qp;
 
         // Enc/DecQP Assignment
-        uint8_t                               enc_prev_coded_qp[50];
-        uint8_t                               enc_prev_quant_group_coded_qp[50];
+        uint8_t                              *enc_prev_coded_qp;               // one per SB row
+        uint8_t                              *enc_prev_quant_group_coded_qp;
 
         // EncDec Entropy Coder (for rate estimation)
         EntropyCoder_t                       *coeff_est_entropy_coder_ptr;
+        // MD rate tables of the picture, set by the first EncDec segment
+        struct MdRateEstimationContext_s     *md_rate_estimation_ptr;
 
         // Mode Decision Neighbor Arrays
         NeighborArrayUnit_t                  *md_intra_luma_mode_neighbor_array[NEIGHBOR_ARRAY_TOTAL_COUNT];
@@ -13782,19 +13809,6 @@ extern "C" {
         NeighborArrayUnit_t                  *amvp_mv_merge_mv_neighbor_array;
         NeighborArrayUnit_t                  *amvp_mv_merge_mode_type_neighbor_array;
 
-        // Entropy Coding Neighbor Arrays
-        NeighborArrayUnit_t                  *mode_type_neighbor_array;
-        NeighborArrayUnit_t                  *partition_context_neighbor_array;
-        NeighborArrayUnit_t                  *intra_luma_mode_neighbor_array;
-        NeighborArrayUnit_t                  *skip_flag_neighbor_array;
-        NeighborArrayUnit_t                  *skip_coeff_neighbor_array;
-        NeighborArrayUnit_t                  *luma_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits (COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
-        NeighborArrayUnit_t                  *cr_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
-        NeighborArrayUnit_t                  *cb_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
-        NeighborArrayUnit_t                  *inter_pred_dir_neighbor_array;
-        NeighborArrayUnit_t                  *ref_frame_type_neighbor_array;
-        NeighborArrayUnit32_t                *interpolation_type_neighbor_array;
-
         ModeInfo                            **mi_grid_base; //2 SB Rows of mi Data are enough
         ModeInfo                             *mip;
 
@@ -13817,9 +13831,6 @@ extern "C" {
         uint8_t                               high_intra_slection;
         EB_FRAME_CARACTERICTICS               scene_caracteristic_id;
         EbBool                                limit_intra;
-        int32_t                               cdef_preset[4];
-        WienerInfo                            wiener_info[MAX_MB_PLANE];
-        SgrprojInfo                           sgrproj_info[MAX_MB_PLANE];
 
     } PictureControlSet_t;
 
@@ -13890,6 +13901,8 @@ extern "C" {
         EbObjectWrapper_t                    *p_pcs_wrapper_ptr;
         EbObjectWrapper_t                    *previous_picture_control_set_wrapper_ptr;
         EbObjectWrapper_t                    *output_stream_wrapper_ptr;
+        EbObjectWrapper_t                   **tile_group_stream_wrapper_ptr_array;   // tile group output: one output buffer per tile
+        uint16_t                              tile_group_count;
         Av1Common                            *av1_cm;
         
         // Data attached to the picture. This includes data passed from the application, or other data the encoder attaches
@@ -13949,9 +13962,11 @@ extern "C" {
         uint64_t                              last_idr_picture;
         uint64_t                              start_time_seconds;
         uint64_t                              start_time_u_seconds;
-        uint32_t                              luma_sse;
-        uint32_t                              cr_sse;
-        uint32_t                              cb_sse;
+        uint64_t                              stage_time_seconds[LATENCY_STAGE_COUNT];   // end of each stage, set when frame_stats is on
+        uint64_t                              stage_time_u_seconds[LATENCY_STAGE_COUNT];
+        uint64_t                              luma_sse;
+        uint64_t                              cb_sse;
+        uint64_t                              cr_sse;
 
         // Pre Analysis
         EbObjectWrapper_t                    *ref_pa_pic_ptr_array[MAX_NUM_OF_REF_PIC_LIST];
@@ -14226,9 +14241,11 @@ extern "C" {
         int16_t                               tiltMvx;
         int16_t                               tiltMvy;
         EbWarpedMotionParams                  global_motion[TOTAL_REFS_PER_FRAME];
+        EbWarpedMotionParams                  prev_global_motion[TOTAL_REFS_PER_FRAME]; // global motion of the primary reference frame, the global motion is coded against
         PictureControlSet_t                  *childPcs;
         int32_t                               use_fast_interpolation_filter_search;
         Macroblock                           *av1x;
+        RestUnitSearchInfo                   *rusi_picture[MAX_MB_PLANE]; // restoration search results per unit, filled by the filter jobs
         int32_t                               film_grain_params_present; //todo (AN): Do we need this flag at picture level?
         aom_film_grain_t                      film_grain_params;
         struct aom_denoise_and_model_t       *denoise_and_model;
@@ -14261,6 +14278,7 @@ extern "C" {
         uint32_t                           compressed_ten_bit_format;
         uint16_t                           enc_dec_segment_col;
         uint16_t                           enc_dec_segment_row;
+        uint16_t                           tile_count;      // upper bound of the tiles of a picture
         EbEncMode                          enc_mode;
         uint8_t                            speed_control;
         uint16_t                           film_grain_noise_level;
@@ -14507,6 +14525,10 @@ extern "C" {
         EbPtr *object_dbl_ptr,
         EbPtr object_init_data_ptr);
 
+    extern void PictureStageDone(
+        PictureParentControlSet_t *picture_control_set_ptr,
+        LatencyStage               stage);
+
 
 #ifdef __cplusplus
 }
@@ -35,6 +35,29 @@
 #define WTH 64
 #define OTH 64
 
+/************************************************
+ * Picture Decision Context Reset
+ ************************************************/
+void PictureDecisionContextReset(
+    PictureDecisionContext_t *context_ptr)
+{
+    uint32_t arrayRow, arrowColumn;
+
+    for (arrayRow = 0; arrayRow < MAX_NUMBER_OF_REGIONS_IN_HEIGHT; arrayRow++)
+    {
+        for (arrowColumn = 0; arrowColumn < MAX_NUMBER_OF_REGIONS_IN_WIDTH; arrowColumn++) {
+            context_ptr->ahdRunningAvgCb[arrowColumn][arrayRow] = 0;
+            context_ptr->ahdRunningAvgCr[arrowColumn][arrayRow] = 0;
+            context_ptr->ahdRunningAvg[arrowColumn][arrayRow] = 0;
+        }
+    }
+
+    context_ptr->resetRunningAvg = EB_TRUE;
+
+    context_ptr->isSceneChangeDetected = EB_FALSE;
+    context_ptr->miniGopToggle = 0;
+}
+
  /************************************************
   * Picture Analysis Context Constructor
   ************************************************/
@@ -45,7 +68,6 @@ EbErrorType PictureDecisionContextCtor(
 {
     PictureDecisionContext_t *context_ptr;
     uint32_t arrayIndex;
-    uint32_t arrayRow, arrowColumn;
     EB_MALLOC(PictureDecisionContext_t*, context_ptr, sizeof(PictureDecisionContext_t), EB_N_PTR);
     *context_dbl_ptr = context_ptr;
 
@@ -67,20 +89,7 @@ EbErrorType PictureDecisionContextCtor(
         EB_MALLOC(uint32_t*, context_ptr->ahdRunningAvg[arrayIndex], sizeof(uint32_t) * MAX_NUMBER_OF_REGIONS_IN_HEIGHT, EB_N_PTR);
     }
 
-    for (arrayRow = 0; arrayRow < MAX_NUMBER_OF_REGIONS_IN_HEIGHT; arrayRow++)
-    {
-        for (arrowColumn = 0; arrowColumn < MAX_NUMBER_OF_REGIONS_IN_WIDTH; arrowColumn++) {
-            context_ptr->ahdRunningAvgCb[arrowColumn][arrayRow] = 0;
-            context_ptr->ahdRunningAvgCr[arrowColumn][arrayRow] = 0;
-            context_ptr->ahdRunningAvg[arrowColumn][arrayRow] = 0;
-        }
-    }
-
-
-    context_ptr->resetRunningAvg = EB_TRUE;
-
-    context_ptr->isSceneChangeDetected = EB_FALSE;
-
+    PictureDecisionContextReset(context_ptr);
 
     return EB_ErrorNone;
 }
@@ -939,7 +948,7 @@ void* PictureDecisionKernel(void *input_ptr)
                 encode_context_ptr->pre_assignment_buffer_idr_count += picture_control_set_ptr->idr_flag;
                 encode_context_ptr->pre_assignment_buffer_count += 1;
 
-                if (sequence_control_set_ptr->static_config.rate_control_mode)
+                if (sequence_control_set_ptr->static_config.rate_control_mode == 1)
                 {
                     // Increment the Intra Period Position
                     encode_context_ptr->intra_period_position = (encode_context_ptr->intra_period_position == (uint32_t)sequence_control_set_ptr->intra_period_length) ? 0 : encode_context_ptr->intra_period_position + 1;
@@ -1620,6 +1629,10 @@ void* PictureDecisionKernel(void *input_ptr)
                             picture_control_set_ptr->me_segments_total_count = (uint16_t)(picture_control_set_ptr->me_segments_column_count  * picture_control_set_ptr->me_segments_row_count);
                             picture_control_set_ptr->me_segments_completion_mask = 0;
 
+                            PictureStageDone(
+                                picture_control_set_ptr,
+                                LATENCY_STAGE_PICTURE_DECISION);
+
                             // Post the results to the ME processes
                             {
                                 uint32_t segment_index;
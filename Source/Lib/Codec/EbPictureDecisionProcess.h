@@ -57,6 +57,8 @@ extern EbErrorType PictureDecisionContextCtor(
     EbFifo_t                     *pictureAnalysisResultsInputFifoPtr,
     EbFifo_t                     *pictureDecisionResultsOutputFifoPtr);
 
+extern void PictureDecisionContextReset(
+    PictureDecisionContext_t     *context_ptr);
 
 extern void* PictureDecisionKernel(void *input_ptr);
 
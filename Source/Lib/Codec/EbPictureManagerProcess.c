@@ -537,21 +537,13 @@ void* PictureManagerKernel(void *input_ptr)
                             entrySequenceControlSetPtr->enc_dec_segment_col_count_array[entryPictureControlSetPtr->temporal_layer_index],
                             entrySequenceControlSetPtr->enc_dec_segment_row_count_array[entryPictureControlSetPtr->temporal_layer_index],
                             picture_width_in_sb,
-                            picture_height_in_sb);
+                            picture_height_in_sb,
+                            entryPictureControlSetPtr->av1_cm->tile_row_start_sb,
+                            (uint32_t)entryPictureControlSetPtr->av1_cm->tile_rows);
 
-                        // Entropy Coding Rows
-                        {
-                            unsigned rowIndex;
+                        // Entropy Coding Tiles
+                        ChildPictureControlSetPtr->entropy_coding_tile_done_count = 0;
 
-                            ChildPictureControlSetPtr->entropy_coding_current_row = 0;
-                            ChildPictureControlSetPtr->entropy_coding_current_available_row = 0;
-                            ChildPictureControlSetPtr->entropy_coding_row_count = picture_height_in_sb;
-                            ChildPictureControlSetPtr->entropy_coding_in_progress = EB_FALSE;
-
-                            for (rowIndex = 0; rowIndex < MAX_LCU_ROWS; ++rowIndex) {
-                                ChildPictureControlSetPtr->entropy_coding_row_array[rowIndex] = EB_FALSE;
-                            }
-                        }
                         // Picture edges
                         ConfigurePictureEdges(entrySequenceControlSetPtr, ChildPictureControlSetPtr);
 
@@ -196,6 +196,8 @@ extern "C" {
         sumResidual,
         // AVX2
         sumResidual8bit_AVX2_INTRIN,
+        // AVX512
+        sumResidual8bit_AVX2_INTRIN,
     };
 
     void memset16bitBlock(
@@ -216,6 +218,8 @@ extern "C" {
         memset16bitBlock,
         // AVX2
         memset16bitBlock_AVX2_INTRIN,
+        // AVX512
+        memset16bitBlock_AVX2_INTRIN,
     };
 
     void FullDistortionKernelCbfZero32Bits(
@@ -259,6 +263,8 @@ extern "C" {
         FullDistortionKernelCbfZero32Bits,
         // AVX2
         FullDistortionKernelCbfZero32Bits_AVX2,
+        // AVX512
+        FullDistortionKernelCbfZero32Bits_AVX2,
     };
 
     static EB_FUllDISTORTIONKERNEL32BITS FUNC_TABLE FullDistortionKernel32Bits_funcPtrArray[ASM_TYPE_TOTAL] = {
@@ -266,6 +272,8 @@ extern "C" {
         FullDistortionKernel32Bits,
         // AVX2
         FullDistortionKernel32Bits_AVX2,
+        // AVX512
+        FullDistortionKernel32Bits_AVX2,
     };
 
     /***************************************
@@ -384,6 +392,18 @@ extern "C" {
             /*7       */    (EB_ADDDKERNEL_TYPE)PictureAdditionVoidFunc,
             /*8 64x64 */    PictureAdditionKernel64x64_SSE2_INTRIN,
         },
+        // AVX512
+        {
+            /*0 4x4   */    PictureAdditionKernel4x4_SSE_INTRIN,
+            /*1 8x8   */    PictureAdditionKernel8x8_SSE2_INTRIN,
+            /*2 16x16 */    PictureAdditionKernel16x16_SSE2_INTRIN,
+            /*3       */    (EB_ADDDKERNEL_TYPE)PictureAdditionVoidFunc,
+            /*4 32x32 */    PictureAdditionKernel32x32_SSE2_INTRIN,
+            /*5       */    (EB_ADDDKERNEL_TYPE)PictureAdditionVoidFunc,
+            /*6       */    (EB_ADDDKERNEL_TYPE)PictureAdditionVoidFunc,
+            /*7       */    (EB_ADDDKERNEL_TYPE)PictureAdditionVoidFunc,
+            /*8 64x64 */    PictureAdditionKernel64x64_SSE2_INTRIN,
+        },
     };
 
 
@@ -412,6 +432,18 @@ extern "C" {
             /*7       */    (EB_ADDDKERNEL_AV1_TYPE)PictureAdditionVoidFunc,
             /*8 64x64 */    PictureAdditionKernel64x64_AV1_SSE2_INTRIN,
         },
+        // AVX512
+        {
+            /*0 4x4   */    PictureAdditionKernel4x4_AV1_SSE2_INTRIN,
+            /*1 8x8   */    PictureAdditionKernel8x8_AV1_SSE2_INTRIN,
+            /*2 16x16 */    PictureAdditionKernel16x16_AV1_SSE2_INTRIN,
+            /*3       */    (EB_ADDDKERNEL_AV1_TYPE)PictureAdditionVoidFunc,
+            /*4 32x32 */    PictureAdditionKernel32x32_AV1_SSE2_INTRIN,
+            /*5       */    (EB_ADDDKERNEL_AV1_TYPE)PictureAdditionVoidFunc,
+            /*6       */    (EB_ADDDKERNEL_AV1_TYPE)PictureAdditionVoidFunc,
+            /*7       */    (EB_ADDDKERNEL_AV1_TYPE)PictureAdditionVoidFunc,
+            /*8 64x64 */    PictureAdditionKernel64x64_AV1_SSE2_INTRIN,
+        },
     };
 
     static EB_ADDDKERNEL_TYPE_16BIT FUNC_TABLE AdditionKernel_funcPtrArray16bit[ASM_TYPE_TOTAL] = {
@@ -419,6 +451,8 @@ extern "C" {
         PictureAdditionKernel16bit_SSE2_INTRIN,
         // AVX2
         PictureAdditionKernel16bit_SSE2_INTRIN,
+        // AVX512
+        PictureAdditionKernel16bit_SSE2_INTRIN,
     };
 
     typedef void(*EB_RESDKERNELSUBSAMPLED_TYPE)(
@@ -457,6 +491,18 @@ extern "C" {
             /*7      */     (EB_RESDKERNELSUBSAMPLED_TYPE)PicResdVoidFunc,
             /*8 64x64 */    ResidualKernelSubSampled64x64_SSE2_INTRIN,
         },
+        // AVX512
+        {
+            /*0 4x4  */     ResidualKernelSubSampled4x4_SSE_INTRIN,
+            /*1 8x8  */     ResidualKernelSubSampled8x8_SSE2_INTRIN,
+            /*2 16x16 */    ResidualKernelSubSampled16x16_SSE2_INTRIN,
+            /*3  */         (EB_RESDKERNELSUBSAMPLED_TYPE)PicResdVoidFunc,
+            /*4 32x32 */    ResidualKernelSubSampled32x32_SSE2_INTRIN,
+            /*5      */     (EB_RESDKERNELSUBSAMPLED_TYPE)PicResdVoidFunc,
+            /*6  */         (EB_RESDKERNELSUBSAMPLED_TYPE)PicResdVoidFunc,
+            /*7      */     (EB_RESDKERNELSUBSAMPLED_TYPE)PicResdVoidFunc,
+            /*8 64x64 */    ResidualKernelSubSampled64x64_SSE2_INTRIN,
+        },
     };
 
     void ResidualKernel16bit(
@@ -484,6 +530,8 @@ extern "C" {
         ResidualKernel16bit_SSE2_INTRIN,
         // AVX2
         ResidualKernel16bit_SSE2_INTRIN,
+        // AVX512
+        ResidualKernel16bit_SSE2_INTRIN,
     };
 
     static EB_ZEROCOEFF_TYPE FUNC_TABLE PicZeroOutCoef_funcPtrArray[ASM_TYPE_TOTAL][5] = {
@@ -503,6 +551,14 @@ extern "C" {
             /*3       */     (EB_ZEROCOEFF_TYPE)PicZeroOutCoefVoidFunc,
             /*4 32x32 */     ZeroOutCoeff32x32_SSE2
         },
+        // AVX512
+        {
+            /*0 4x4   */     ZeroOutCoeff4x4_SSE,
+            /*1 8x8   */     ZeroOutCoeff8x8_SSE2,
+            /*2 16x16 */     ZeroOutCoeff16x16_SSE2,
+            /*3       */     (EB_ZEROCOEFF_TYPE)PicZeroOutCoefVoidFunc,
+            /*4 32x32 */     ZeroOutCoeff32x32_SSE2
+        },
     };
 
     
@@ -510,6 +566,8 @@ extern "C" {
         // NON_AVX2
         Compute8x8Satd_SSE4,
         // ASM_AVX2
+        Compute8x8Satd_SSE4,
+        // AVX512
         Compute8x8Satd_SSE4
     };
 
@@ -517,6 +575,8 @@ extern "C" {
         // NON_AVX2
         Compute8x8Satd_U8_SSE4,
         // ASM_AVX2
+        Compute8x8Satd_U8_SSE4,
+        // AVX512
         Compute8x8Satd_U8_SSE4
     };
 
@@ -556,6 +616,19 @@ extern "C" {
             // 64x64
             SpatialFullDistortionKernel16MxN_SSSE3_INTRIN
         },
+        // AVX512
+        {
+            // 4x4
+            SpatialFullDistortionKernel4x4_SSSE3_INTRIN,
+            // 8x8
+            SpatialFullDistortionKernel8x8_SSSE3_INTRIN,
+            // 16x16
+            SpatialFullDistortionKernel16MxN_SSSE3_INTRIN,
+            // 32x32
+            SpatialFullDistortionKernel16MxN_SSSE3_INTRIN,
+            // 64x64
+            SpatialFullDistortionKernel16MxN_SSSE3_INTRIN
+        },
     };
 #endif
 
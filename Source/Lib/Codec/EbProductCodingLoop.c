@@ -3064,9 +3064,13 @@ static EB_SADKERNELNxM_TYPE FUNC_TABLE compute4x4SAD_funcPtrArray[ASM_TYPE_TOTAL
 #if INTRINSIC_OPT_2
     // SSE2
     Compute4xMSad_AVX2_INTRIN,
+    // AVX512
+    Compute4xMSad_AVX2_INTRIN,
 #else
     // SSE2
     Compute4x4SAD_Kernel,
+    // AVX512
+    Compute4x4SAD_Kernel,
 #endif
 
 
@@ -213,31 +213,22 @@ EbErrorType RateControlLayerContextCtor(
     return EB_ErrorNone;
 }
 
-
-
-EbErrorType RateControlIntervalParamContextCtor(
-    RateControlIntervalParamContext_t   **entryDblPtr) {
+static void RateControlIntervalParamContextReset(
+    RateControlIntervalParamContext_t   *entryPtr) {
 
     uint32_t temporalIndex;
-    EbErrorType return_error = EB_ErrorNone;
-    RateControlIntervalParamContext_t *entryPtr;
-    EB_MALLOC(RateControlIntervalParamContext_t*, entryPtr, sizeof(RateControlIntervalParamContext_t), EB_N_PTR);
-
-    *entryDblPtr = entryPtr;
 
     entryPtr->inUse = EB_FALSE;
     entryPtr->wasUsed = EB_FALSE;
     entryPtr->lastGop = EB_FALSE;
     entryPtr->processedFramesNumber = 0;
-    EB_MALLOC(RateControlLayerContext_t**, entryPtr->rateControlLayerArray, sizeof(RateControlLayerContext_t*)*EB_MAX_TEMPORAL_LAYERS, EB_N_PTR);
 
     for (temporalIndex = 0; temporalIndex < EB_MAX_TEMPORAL_LAYERS; temporalIndex++) {
-        return_error = RateControlLayerContextCtor(&entryPtr->rateControlLayerArray[temporalIndex]);
+        entryPtr->rateControlLayerArray[temporalIndex]->firstFrame = 1;
+        entryPtr->rateControlLayerArray[temporalIndex]->firstNonIntraFrame = 1;
+        entryPtr->rateControlLayerArray[temporalIndex]->feedbackArrived = EB_FALSE;
         entryPtr->rateControlLayerArray[temporalIndex]->temporalIndex = temporalIndex;
         entryPtr->rateControlLayerArray[temporalIndex]->frame_rate = 1 << RC_PRECISION;
-        if (return_error == EB_ErrorInsufficientResources) {
-            return EB_ErrorInsufficientResources;
-        }
     }
 
     entryPtr->min_target_rate_assigned = EB_FALSE;
@@ -251,6 +242,30 @@ EbErrorType RateControlIntervalParamContextCtor(
     entryPtr->firstPicActualQpAssigned = EB_FALSE;
     entryPtr->scene_change_in_gop = EB_FALSE;
     entryPtr->extraApBitRatioI = 0;
+}
+
+
+
+EbErrorType RateControlIntervalParamContextCtor(
+    RateControlIntervalParamContext_t   **entryDblPtr) {
+
+    uint32_t temporalIndex;
+    EbErrorType return_error = EB_ErrorNone;
+    RateControlIntervalParamContext_t *entryPtr;
+    EB_MALLOC(RateControlIntervalParamContext_t*, entryPtr, sizeof(RateControlIntervalParamContext_t), EB_N_PTR);
+
+    *entryDblPtr = entryPtr;
+
+    EB_MALLOC(RateControlLayerContext_t**, entryPtr->rateControlLayerArray, sizeof(RateControlLayerContext_t*)*EB_MAX_TEMPORAL_LAYERS, EB_N_PTR);
+
+    for (temporalIndex = 0; temporalIndex < EB_MAX_TEMPORAL_LAYERS; temporalIndex++) {
+        return_error = RateControlLayerContextCtor(&entryPtr->rateControlLayerArray[temporalIndex]);
+        if (return_error == EB_ErrorInsufficientResources) {
+            return EB_ErrorInsufficientResources;
+        }
+    }
+
+    RateControlIntervalParamContextReset(entryPtr);
 
     return EB_ErrorNone;
 }
@@ -271,13 +286,60 @@ EbErrorType RateControlCodedFramesStatsContextCtor(
 }
 
 
+/************************************************
+ * Rate Control Context Reset
+ *   Restores the per-stream state so the context
+ *   can serve a new sequence
+ ************************************************/
+void RateControlContextReset(
+    RateControlContext_t    *context_ptr,
+    int32_t                   intra_period_length)
+{
+    uint32_t temporalIndex;
+    uint32_t intervalIndex;
+
+#if OVERSHOOT_STAT_PRINT
+    uint32_t pictureIndex;
+#endif
+
+    for (temporalIndex = 0; temporalIndex < EB_MAX_TEMPORAL_LAYERS; temporalIndex++) {
+        context_ptr->frames_in_interval[temporalIndex] = 0;
+    }
+
+    context_ptr->rateControlParamQueueHeadIndex = 0;
+    for (intervalIndex = 0; intervalIndex < PARALLEL_GOP_MAX_NUMBER; intervalIndex++) {
+        RateControlIntervalParamContextReset(context_ptr->rateControlParamQueue[intervalIndex]);
+        context_ptr->rateControlParamQueue[intervalIndex]->firstPoc = (intervalIndex*(uint32_t)(intra_period_length + 1));
+        context_ptr->rateControlParamQueue[intervalIndex]->lastPoc = ((intervalIndex + 1)*(uint32_t)(intra_period_length + 1)) - 1;
+    }
+
+#if OVERSHOOT_STAT_PRINT
+    context_ptr->codedFramesStatQueueHeadIndex = 0;
+    context_ptr->codedFramesStatQueueTailIndex = 0;
+    for (pictureIndex = 0; pictureIndex < CODED_FRAMES_STAT_QUEUE_MAX_DEPTH; ++pictureIndex) {
+        context_ptr->codedFramesStatQueue[pictureIndex]->picture_number = pictureIndex;
+        context_ptr->codedFramesStatQueue[pictureIndex]->frameTotalBitActual = -1;
+    }
+    context_ptr->maxBitActualPerSw = 0;
+    context_ptr->maxBitActualPerGop = 0;
+#endif
+
+    context_ptr->baseLayerFramesAvgQp = 0;
+    context_ptr->baseLayerIntraFramesAvgQp = 0;
+
+
+    context_ptr->intraCoefRate = 4;
+    context_ptr->extraBits = 0;
+    context_ptr->extraBitsGen = 0;
+    context_ptr->maxRateAdjustDeltaQP = 0;
+}
+
 EbErrorType RateControlContextCtor(
     RateControlContext_t   **context_dbl_ptr,
     EbFifo_t                *rateControlInputTasksFifoPtr,
     EbFifo_t                *rateControlOutputResultsFifoPtr,
     int32_t                   intra_period_length)
 {
-    uint32_t temporalIndex;
     uint32_t intervalIndex;
 
 #if OVERSHOOT_STAT_PRINT
@@ -300,26 +362,17 @@ EbErrorType RateControlContextCtor(
         return EB_ErrorInsufficientResources;
     }
 
-    for (temporalIndex = 0; temporalIndex < EB_MAX_TEMPORAL_LAYERS; temporalIndex++) {
-        context_ptr->frames_in_interval[temporalIndex] = 0;
-    }
-
     EB_MALLOC(RateControlIntervalParamContext_t**, context_ptr->rateControlParamQueue, sizeof(RateControlIntervalParamContext_t*)*PARALLEL_GOP_MAX_NUMBER, EB_N_PTR);
 
-    context_ptr->rateControlParamQueueHeadIndex = 0;
     for (intervalIndex = 0; intervalIndex < PARALLEL_GOP_MAX_NUMBER; intervalIndex++) {
         return_error = RateControlIntervalParamContextCtor(
             &context_ptr->rateControlParamQueue[intervalIndex]);
-        context_ptr->rateControlParamQueue[intervalIndex]->firstPoc = (intervalIndex*(uint32_t)(intra_period_length + 1));
-        context_ptr->rateControlParamQueue[intervalIndex]->lastPoc = ((intervalIndex + 1)*(uint32_t)(intra_period_length + 1)) - 1;
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
     }
 
 #if OVERSHOOT_STAT_PRINT
-    context_ptr->codedFramesStatQueueHeadIndex = 0;
-    context_ptr->codedFramesStatQueueTailIndex = 0;
     EB_MALLOC(CodedFramesStatsEntry_t**, context_ptr->codedFramesStatQueue, sizeof(CodedFramesStatsEntry_t*)*CODED_FRAMES_STAT_QUEUE_MAX_DEPTH, EB_N_PTR);
 
     for (pictureIndex = 0; pictureIndex < CODED_FRAMES_STAT_QUEUE_MAX_DEPTH; ++pictureIndex) {
@@ -330,19 +383,11 @@ EbErrorType RateControlContextCtor(
             return EB_ErrorInsufficientResources;
         }
     }
-    context_ptr->maxBitActualPerSw = 0;
-    context_ptr->maxBitActualPerGop = 0;
 #endif
 
-    context_ptr->baseLayerFramesAvgQp = 0;
-    context_ptr->baseLayerIntraFramesAvgQp = 0;
-
-
-    context_ptr->intraCoefRate = 4;
-    context_ptr->extraBits = 0;
-    context_ptr->extraBitsGen = 0;
-    context_ptr->maxRateAdjustDeltaQP = 0;
-
+    RateControlContextReset(
+        context_ptr,
+        intra_period_length);
 
     return EB_ErrorNone;
 }
@@ -919,6 +964,32 @@ void HighLevelRcInputPictureMode2(
     EbReleaseMutex(sequence_control_set_ptr->encode_context_ptr->rate_table_update_mutex);
 }
 
+/****************************************
+* Frame context adaptation: every frame keeps its adapted CDFs, and an
+* inter frame loads the CDFs of the reference closest to it in QP, its
+* coefficient statistics being the closest
+****************************************/
+static void SetFrameContextSource(
+    SequenceControlSet_t *sequence_control_set_ptr,
+    PictureControlSet_t  *picture_control_set_ptr)
+{
+    PictureParentControlSet_t *parent_pcs_ptr = picture_control_set_ptr->parent_pcs_ptr;
+
+    if (!sequence_control_set_ptr->static_config.frame_context_adaptation)
+        return;
+
+    parent_pcs_ptr->refresh_frame_context = REFRESH_FRAME_CONTEXT_BACKWARD;
+    if (picture_control_set_ptr->slice_type == I_SLICE || parent_pcs_ptr->error_resilient_mode)
+        return;
+
+    // The backward references of the low delay structure are signalled on the slot of LAST
+    parent_pcs_ptr->primary_ref_frame = LAST_FRAME - LAST_FRAME;
+    if (parent_pcs_ptr->pred_struct_ptr->predType == EB_PRED_RANDOM_ACCESS && parent_pcs_ptr->ref_list1_count &&
+        ABS((int32_t)picture_control_set_ptr->ref_pic_qp_array[REF_LIST_1] - (int32_t)picture_control_set_ptr->picture_qp) <
+        ABS((int32_t)picture_control_set_ptr->ref_pic_qp_array[REF_LIST_0] - (int32_t)picture_control_set_ptr->picture_qp))
+        parent_pcs_ptr->primary_ref_frame = BWDREF_FRAME - LAST_FRAME;
+}
+
 #if ADD_DELTA_QP_SUPPORT ||  NEW_QPS
 
 static const uint8_t quantizer_to_qindex[] = {
@@ -986,7 +1057,7 @@ void* RateControlKernel(void *input_ptr)
     PictureParentControlSet_t   *parentPictureControlSetPtr;
 
     // Config
-    SequenceControlSet_t        *sequence_control_set_ptr;
+    SequenceControlSet_t        *sequence_control_set_ptr = (SequenceControlSet_t*)EB_NULL;
 
     // Input
     EbObjectWrapper_t           *rateControlTasksWrapperPtr;
@@ -1030,7 +1101,10 @@ void* RateControlKernel(void *input_ptr)
             // High level RC
             if (picture_control_set_ptr->picture_number == 0) {
 
-                rate_control_model_init(rc_model_ptr, sequence_control_set_ptr);
+                if (sequence_control_set_ptr->static_config.rate_control_mode == 2)
+                    rate_control_cbr_init(rc_model_ptr, sequence_control_set_ptr, QP_OFFSET_LAYER_ARRAY_BDRATE);
+                else
+                    rate_control_model_init(rc_model_ptr, sequence_control_set_ptr);
                 context_ptr->highLevelRateControlPtr->target_bit_rate = sequence_control_set_ptr->static_config.target_bit_rate;
                 context_ptr->highLevelRateControlPtr->frame_rate = sequence_control_set_ptr->frame_rate;
                 context_ptr->highLevelRateControlPtr->channelBitRatePerFrame = (uint64_t)MAX((int64_t)1, (int64_t)((context_ptr->highLevelRateControlPtr->target_bit_rate << RC_PRECISION) / context_ptr->highLevelRateControlPtr->frame_rate));
@@ -1070,7 +1144,7 @@ void* RateControlKernel(void *input_ptr)
                 context_ptr->baseLayerFramesAvgQp = sequence_control_set_ptr->qp;
                 context_ptr->baseLayerIntraFramesAvgQp = sequence_control_set_ptr->qp;
             }
-            if (sequence_control_set_ptr->static_config.rate_control_mode)
+            if (sequence_control_set_ptr->static_config.rate_control_mode == 1)
             {
                 picture_control_set_ptr->parent_pcs_ptr->intra_selected_org_qp = 0;
                 HighLevelRcInputPictureMode2(
@@ -1084,7 +1158,7 @@ void* RateControlKernel(void *input_ptr)
             }
 
             // Frame level RC
-            if (sequence_control_set_ptr->intra_period_length == -1 || sequence_control_set_ptr->static_config.rate_control_mode == 0) {
+            if (sequence_control_set_ptr->intra_period_length == -1 || sequence_control_set_ptr->static_config.rate_control_mode != 1) {
                 rateControlParamPtr = context_ptr->rateControlParamQueue[0];
                 prevGopRateControlParamPtr = context_ptr->rateControlParamQueue[0];
                 nextGopRateControlParamPtr = context_ptr->rateControlParamQueue[0];
@@ -1207,6 +1281,13 @@ void* RateControlKernel(void *input_ptr)
 
                 picture_control_set_ptr->picture_qp = picture_control_set_ptr->picture_qp;
 
+            }
+            else if (sequence_control_set_ptr->static_config.rate_control_mode == 2) {
+                // Constant bitrate, no look ahead: the QP comes from the decoder buffer model
+                picture_control_set_ptr->picture_qp = rate_control_cbr_get_quantizer(rc_model_ptr, picture_control_set_ptr->parent_pcs_ptr);
+#if NEW_QPS
+                picture_control_set_ptr->parent_pcs_ptr->base_qindex = quantizer_to_qindex[picture_control_set_ptr->picture_qp];
+#endif
             }
             else {
                 picture_control_set_ptr->picture_qp = rate_control_get_quantizer(rc_model_ptr, picture_control_set_ptr->parent_pcs_ptr);
@@ -1337,6 +1418,14 @@ void* RateControlKernel(void *input_ptr)
                 picture_control_set_ptr->parent_pcs_ptr->average_qp += sb_ptr->qp;
             }
 
+            SetFrameContextSource(
+                sequence_control_set_ptr,
+                picture_control_set_ptr);
+
+            PictureStageDone(
+                picture_control_set_ptr->parent_pcs_ptr,
+                LATENCY_STAGE_RATE_CONTROL);
+
             // Get Empty Rate Control Results Buffer
             EbGetEmptyObject(
                 context_ptr->rateControlOutputResultsFifoPtr,
@@ -1357,12 +1446,15 @@ void* RateControlKernel(void *input_ptr)
             parentPictureControlSetPtr = (PictureParentControlSet_t*)rateControlTasksPtr->pictureControlSetWrapperPtr->objectPtr;
             sequence_control_set_ptr = (SequenceControlSet_t*)parentPictureControlSetPtr->sequence_control_set_wrapper_ptr->objectPtr;
 
-            if (sequence_control_set_ptr->static_config.rate_control_mode) {
+            if (sequence_control_set_ptr->static_config.rate_control_mode == 1) {
                 rate_control_update_model(rc_model_ptr, parentPictureControlSetPtr);
             }
+            else if (sequence_control_set_ptr->static_config.rate_control_mode == 2) {
+                rate_control_cbr_update(rc_model_ptr, parentPictureControlSetPtr);
+            }
 
             // Frame level RC
-            if (sequence_control_set_ptr->intra_period_length == -1 || sequence_control_set_ptr->static_config.rate_control_mode == 0) {
+            if (sequence_control_set_ptr->intra_period_length == -1 || sequence_control_set_ptr->static_config.rate_control_mode != 1) {
                 rateControlParamPtr = context_ptr->rateControlParamQueue[0];
                 prevGopRateControlParamPtr = context_ptr->rateControlParamQueue[0];
                 if (parentPictureControlSetPtr->slice_type == I_SLICE) {
@@ -1402,7 +1494,7 @@ void* RateControlKernel(void *input_ptr)
                     context_ptr->rateControlParamQueue[intervalIndexTemp - 1];
 
             }
-            if (sequence_control_set_ptr->static_config.rate_control_mode != 0) {
+            if (sequence_control_set_ptr->static_config.rate_control_mode == 1) {
 
                 context_ptr->previousVirtualBufferLevel = context_ptr->virtualBufferLevel;
 
@@ -1544,7 +1636,14 @@ void* RateControlKernel(void *input_ptr)
 
         case RC_ENTROPY_CODING_ROW_FEEDBACK_RESULT:
 
-            // Extract bits-per-lcu-row
+            // Extract bits-per-lcu-row, refines the size of the pictures in flight in constant bitrate.
+            // The picture of the row went through this kernel first, sequence_control_set_ptr is set.
+            if (sequence_control_set_ptr && sequence_control_set_ptr->static_config.rate_control_mode == 2) {
+                rate_control_cbr_update_row(
+                    rc_model_ptr,
+                    rateControlTasksPtr->picture_number,
+                    rateControlTasksPtr->bitCount);
+            }
 
             // Release Rate Control Tasks
             EbReleaseObject(rateControlTasksWrapperPtr);
@@ -298,6 +298,9 @@ extern EbErrorType RateControlContextCtor(
     EbFifo_t                *rateControlOutputResultsFifoPtr,
     int32_t                   intra_period_length);
 
+extern void RateControlContextReset(
+    RateControlContext_t    *context_ptr,
+    int32_t                   intra_period_length);
 
 
 extern void* RateControlKernel(void *input_ptr);
@@ -31,7 +31,10 @@ typedef struct RateControlTasks_s
     uint32_t                              segment_index;
 
     // Following are valid for RC_ENTROPY_CODING_ROW_FEEDBACK_RESULT only
+    // A feedback covers the SB row rowNumber of the tile tile_index, a picture
+    // row is sent once per tile column
     uint64_t                              picture_number;
+    uint16_t                              tile_index;
     uint32_t                              rowNumber;
     uint32_t                              bitCount;
 
@@ -182,9 +182,21 @@ EbErrorType EbReferenceObjectCtor(
 
 
 
+    // Frame context adaptation
+    EB_MALLOC(FRAME_CONTEXT*, referenceObject->frame_context, sizeof(FRAME_CONTEXT), EB_N_PTR);
+    EB_CREATESEMAPHORE(EbHandle, referenceObject->frame_context_semaphore, sizeof(EbHandle), EB_SEMAPHORE, 0, 1);
+    referenceObject->frame_context_saved = EB_FALSE;
+
     // Allocate SB based TMVP map
     EB_MALLOC(TmvpUnit_t *, referenceObject->tmvpMap, (sizeof(TmvpUnit_t) * (((pictureBufferDescInitDataPtr->maxWidth + (64 - 1)) >> 6) * ((pictureBufferDescInitDataPtr->maxHeight + (64 - 1)) >> 6))), EB_N_PTR);
 
+    // Allocate SB based statistics
+    {
+        uint32_t sbTotalCount = ((pictureBufferDescInitDataPtr->maxWidth + (64 - 1)) >> 6) * ((pictureBufferDescInitDataPtr->maxHeight + (64 - 1)) >> 6);
+        EB_MALLOC(uint8_t*, referenceObject->intra_coded_area_sb, sizeof(uint8_t) * sbTotalCount, EB_N_PTR);
+        EB_MALLOC(uint32_t*, referenceObject->non_moving_index_array, sizeof(uint32_t) * sbTotalCount, EB_N_PTR);
+    }
+
     //RESTRICT THIS TO M4
     {
         EbPictureBufferDescInitData_t bufDesc;
@@ -254,6 +266,13 @@ EbErrorType EbPaReferenceObjectCtor(
         return EB_ErrorInsufficientResources;
     }
 
+    // Allocate SB based statistics
+    {
+        uint32_t sbTotalCount = ((pictureBufferDescInitDataPtr->maxWidth + (64 - 1)) >> 6) * ((pictureBufferDescInitDataPtr->maxHeight + (64 - 1)) >> 6);
+        EB_MALLOC(uint16_t*, paReferenceObject->variance, sizeof(uint16_t) * sbTotalCount, EB_N_PTR);
+        EB_MALLOC(uint8_t*, paReferenceObject->yMean, sizeof(uint8_t) * sbTotalCount, EB_N_PTR);
+    }
+
     return EB_ErrorNone;
 }
 
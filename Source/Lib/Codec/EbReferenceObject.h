@@ -9,6 +9,7 @@
 #include "EbDefinitions.h"
 #include "EbDefinitions.h"
 #include "EbAdaptiveMotionVectorPrediction.h"
+#include "EbCabacContextModel.h"
 
 typedef struct EbReferenceObject_s {
     EbPictureBufferDesc_t          *referencePicture;
@@ -25,8 +26,8 @@ typedef struct EbReferenceObject_s {
 #endif
     EB_SLICE                        slice_type;
     uint8_t                         intra_coded_area;//percentage of intra coded area 0-100%
-    uint8_t                         intra_coded_area_sb[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];//percentage of intra coded area 0-100%
-    uint32_t                        non_moving_index_array[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];//array to hold non-moving blocks in reference frames
+    uint8_t                        *intra_coded_area_sb;//percentage of intra coded area 0-100%
+    uint32_t                       *non_moving_index_array;//array to hold non-moving blocks in reference frames
     uint32_t                        picSampleValue[MAX_NUMBER_OF_REGIONS_IN_WIDTH][MAX_NUMBER_OF_REGIONS_IN_HEIGHT][3];// [Y U V];
     EbBool                          penalizeSkipflag;
     uint8_t                         tmpLayerIdx;
@@ -34,6 +35,10 @@ typedef struct EbReferenceObject_s {
     uint16_t                        pic_avg_variance;
     uint8_t                         average_intensity;
     aom_film_grain_t                film_grain_params; //Film grain parameters for a reference frame
+    FRAME_CONTEXT                  *frame_context;          // CDFs at the end of the first tile, kept for the frame context adaptation
+    EbHandle                        frame_context_semaphore; // posted once the CDFs are kept, taken and posted back by each frame loading them
+    EbBool                          frame_context_saved;
+    EbWarpedMotionParams            global_motion[TOTAL_REFS_PER_FRAME]; // kept with the CDFs, the next frames code their global motion against it
 
 } EbReferenceObject_t;
 
@@ -45,8 +50,8 @@ typedef struct EbPaReferenceObject_s {
     EbPictureBufferDesc_t          *inputPaddedPicturePtr;
     EbPictureBufferDesc_t          *quarterDecimatedPicturePtr;
     EbPictureBufferDesc_t          *sixteenthDecimatedPicturePtr;
-    uint16_t                        variance[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];
-    uint8_t                         yMean[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];
+    uint16_t                       *variance;
+    uint8_t                        *yMean;
     EB_SLICE                        slice_type;
     uint32_t                        dependentPicturesCount; //number of pic using this reference frame
     PictureParentControlSet_t      *pPcsPtr;
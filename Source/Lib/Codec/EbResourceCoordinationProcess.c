@@ -14,6 +14,7 @@
 #include "EbResourceCoordinationProcess.h"
 #include "EbResourceCoordinationResults.h"
 #include "EbTransforms.h"
+#include "EbEntropyCoding.h"
 #include "EbTime.h"
 
 #if !ME_HME_OQ
@@ -162,6 +163,43 @@ uint8_t SearchAreaHeight[5][MAX_SUPPORTED_MODES] = {
 
 
 #endif
+/************************************************
+ * Resource Coordination Context Reset
+ *   Restores the per-stream state; the active
+ *   SequenceControlSet is dropped, its pool being
+ *   reset by the caller
+ ************************************************/
+void ResourceCoordinationContextReset(
+    ResourceCoordinationContext_t *context_ptr)
+{
+    uint32_t instanceIndex;
+
+    for (instanceIndex = 0; instanceIndex < context_ptr->encodeInstancesTotalCount; ++instanceIndex) {
+        context_ptr->sequenceControlSetActiveArray[instanceIndex] = 0;
+        context_ptr->pictureNumberArray[instanceIndex] = 0;
+    }
+    context_ptr->averageEncMod = 0;
+    context_ptr->prevEncMod = 0;
+    context_ptr->prevEncModeDelta = 0;
+    context_ptr->curSpeed = 0; // speed x 1000
+    context_ptr->previousModeChangeBuffer = 0;
+    context_ptr->firstInPicArrivedTimeSeconds = 0;
+    context_ptr->firstInPicArrivedTimeuSeconds = 0;
+    context_ptr->previousFrameInCheck1 = 0;
+    context_ptr->previousFrameInCheck2 = 0;
+    context_ptr->previousFrameInCheck3 = 0;
+    context_ptr->previousModeChangeFrameIn = 0;
+    context_ptr->prevsTimeSeconds = 0;
+    context_ptr->prevsTimeuSeconds = 0;
+    context_ptr->prevFrameOut = 0;
+    context_ptr->startFlag = EB_FALSE;
+
+    context_ptr->previousBufferCheck1 = 0;
+    context_ptr->prevChangeCond = 0;
+    context_ptr->prevPictureControlSetWrapperPtr = EB_NULL;
+    context_ptr->processedInputCount = 0;
+}
+
 /************************************************
  * Resource Coordination Context Constructor
  ************************************************/
@@ -176,8 +214,6 @@ EbErrorType ResourceCoordinationContextCtor(
     uint32_t                         *computeSegmentsTotalCountArray,
     uint32_t                          encodeInstancesTotalCount)
 {
-    uint32_t instanceIndex;
-
     ResourceCoordinationContext_t *context_ptr;
     EB_MALLOC(ResourceCoordinationContext_t*, context_ptr, sizeof(ResourceCoordinationContext_t), EB_N_PTR);
 
@@ -195,35 +231,10 @@ EbErrorType ResourceCoordinationContextCtor(
     // Allocate SequenceControlSetActiveArray
     EB_MALLOC(EbObjectWrapper_t**, context_ptr->sequenceControlSetActiveArray, sizeof(EbObjectWrapper_t*) * context_ptr->encodeInstancesTotalCount, EB_N_PTR);
 
-    for (instanceIndex = 0; instanceIndex < context_ptr->encodeInstancesTotalCount; ++instanceIndex) {
-        context_ptr->sequenceControlSetActiveArray[instanceIndex] = 0;
-    }
-
     // Picture Stats
     EB_MALLOC(uint64_t*, context_ptr->pictureNumberArray, sizeof(uint64_t) * context_ptr->encodeInstancesTotalCount, EB_N_PTR);
 
-    for (instanceIndex = 0; instanceIndex < context_ptr->encodeInstancesTotalCount; ++instanceIndex) {
-        context_ptr->pictureNumberArray[instanceIndex] = 0;
-    }
-
-    context_ptr->averageEncMod = 0;
-    context_ptr->prevEncMod = 0;
-    context_ptr->prevEncModeDelta = 0;
-    context_ptr->curSpeed = 0; // speed x 1000
-    context_ptr->previousModeChangeBuffer = 0;
-    context_ptr->firstInPicArrivedTimeSeconds = 0;
-    context_ptr->firstInPicArrivedTimeuSeconds = 0;
-    context_ptr->previousFrameInCheck1 = 0;
-    context_ptr->previousFrameInCheck2 = 0;
-    context_ptr->previousFrameInCheck3 = 0;
-    context_ptr->previousModeChangeFrameIn = 0;
-    context_ptr->prevsTimeSeconds = 0;
-    context_ptr->prevsTimeuSeconds = 0;
-    context_ptr->prevFrameOut = 0;
-    context_ptr->startFlag = EB_FALSE;
-
-    context_ptr->previousBufferCheck1 = 0;
-    context_ptr->prevChangeCond = 0;
+    ResourceCoordinationContextReset(context_ptr);
 
     return EB_ErrorNone;
 }
@@ -642,6 +653,7 @@ void ResetPcsAv1(
     picture_control_set_ptr->error_resilient_mode = 0;
     picture_control_set_ptr->uniform_tile_spacing_flag = 1;
     picture_control_set_ptr->large_scale_tile = 0;
+    av1_set_tile_info(picture_control_set_ptr);
     picture_control_set_ptr->film_grain_params_present = 0;
     picture_control_set_ptr->cdef_pri_damping = 0;
     picture_control_set_ptr->cdef_sec_damping = 0;
@@ -699,7 +711,6 @@ void* ResourceCoordinationKernel(void *input_ptr)
     uint32_t                         aspectRatio;
 
     uint32_t                         input_size = 0;
-    EbObjectWrapper_t               *prevPictureControlSetWrapperPtr = 0;
 #if !ME_HME_OQ
     uint16_t                         hmeRegionIndex = 0;
 #endif
@@ -925,7 +936,7 @@ void* ResourceCoordinationKernel(void *input_ptr)
 #endif
         // Rate Control
         // Set the ME Distortion and OIS Historgrams to zero
-        if (sequence_control_set_ptr->static_config.rate_control_mode) {
+        if (sequence_control_set_ptr->static_config.rate_control_mode == 1) {
             EB_MEMSET(picture_control_set_ptr->me_distortion_histogram, 0, NUMBER_OF_SAD_INTERVALS * sizeof(uint16_t));
             EB_MEMSET(picture_control_set_ptr->ois_distortion_histogram, 0, NUMBER_OF_INTRA_SAD_INTERVALS * sizeof(uint16_t));
         }
@@ -969,19 +980,21 @@ void* ResourceCoordinationKernel(void *input_ptr)
     
         ((EbPaReferenceObject_t*)picture_control_set_ptr->pa_reference_picture_wrapper_ptr->objectPtr)->inputPaddedPicturePtr->bufferY = picture_control_set_ptr->enhanced_picture_ptr->bufferY;
         // Get Empty Output Results Object
-        if (picture_control_set_ptr->picture_number > 0 && (prevPictureControlSetWrapperPtr != NULL))
+        if (picture_control_set_ptr->picture_number > 0 && (context_ptr->prevPictureControlSetWrapperPtr != NULL))
         {
-            ((PictureParentControlSet_t       *)prevPictureControlSetWrapperPtr->objectPtr)->end_of_sequence_flag = end_of_sequence_flag;
+            ((PictureParentControlSet_t       *)context_ptr->prevPictureControlSetWrapperPtr->objectPtr)->end_of_sequence_flag = end_of_sequence_flag;
             EbGetEmptyObject(
                 context_ptr->resourceCoordinationResultsOutputFifoPtr,
                 &outputWrapperPtr);
             outputResultsPtr = (ResourceCoordinationResults_t*)outputWrapperPtr->objectPtr;
-            outputResultsPtr->pictureControlSetWrapperPtr = prevPictureControlSetWrapperPtr;
+            outputResultsPtr->pictureControlSetWrapperPtr = context_ptr->prevPictureControlSetWrapperPtr;
 
             // Post the finished Results Object
             EbPostFullObject(outputWrapperPtr);
         }
-        prevPictureControlSetWrapperPtr = pictureControlSetWrapperPtr;
+        context_ptr->prevPictureControlSetWrapperPtr = pictureControlSetWrapperPtr;
+
+        EB_ATOMIC_STORE_RELEASE(&context_ptr->processedInputCount, context_ptr->processedInputCount + 1);
     }
 
     return EB_NULL;
@@ -55,7 +55,10 @@ extern "C" {
         uint64_t                               firstInPicArrivedTimeuSeconds;
         EbBool                              startFlag;
 
-
+        // Picture held until the next one tells whether it ends the sequence
+        EbObjectWrapper_t                  *prevPictureControlSetWrapperPtr;
+        // Input buffers fully processed by the kernel, read by eb_svt_enc_reset
+        uint32_t                             processedInputCount;
 
     } ResourceCoordinationContext_t;
 
@@ -73,6 +76,9 @@ extern "C" {
         uint32_t                            *computeSegmentsTotalCountArray,
         uint32_t                             encodeInstancesTotalCount);
 
+    extern void ResourceCoordinationContextReset(
+        ResourceCoordinationContext_t       *context_ptr);
+
     extern void* ResourceCoordinationKernel(void *input_ptr);
 #ifdef __cplusplus
 }
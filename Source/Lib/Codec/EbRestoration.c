@@ -1398,6 +1398,7 @@ static void foreach_rest_unit_in_tile(const AV1PixelRect *tile_rect,
     int32_t tile_row, int32_t tile_col, int32_t tile_cols,
     int32_t hunits_per_tile, int32_t units_per_tile,
     int32_t unit_size, int32_t ss_y,
+    int32_t row_start, int32_t row_end,
     rest_unit_visitor_t on_rest_unit,
     void *priv) {
     const int32_t tile_w = tile_rect->right - tile_rect->left;
@@ -1408,10 +1409,16 @@ static void foreach_rest_unit_in_tile(const AV1PixelRect *tile_rect,
     const int32_t unit_idx0 = tile_idx * units_per_tile;
 
     int32_t y0 = 0, i = 0;
-    while (y0 < tile_h) {
+    while (y0 < tile_h && i < row_end) {
         int32_t remaining_h = tile_h - y0;
         int32_t h = (remaining_h < ext_size) ? remaining_h : unit_size;
 
+        if (i < row_start) {
+            y0 += h;
+            ++i;
+            continue;
+        }
+
         RestorationTileLimits limits;
         limits.v_start = tile_rect->top + y0;
         limits.v_end = tile_rect->top + y0 + h;
@@ -1457,7 +1464,25 @@ void av1_foreach_rest_unit_in_frame(Av1Common *cm, int32_t plane,
 
     foreach_rest_unit_in_tile(&tile_rect, 0, 0, 1, rsi->horz_units_per_tile,
         rsi->units_per_tile, rsi->restoration_unit_size,
-        ss_y, on_rest_unit, priv);
+        ss_y, 0, rsi->vert_units_per_tile, on_rest_unit, priv);
+}
+
+// Visits the restoration units of rows [row_start, row_end) of the frame,
+// so that the unit searches of a plane can be split across threads.
+void av1_foreach_rest_unit_in_rows(Av1Common *cm, int32_t plane,
+    int32_t row_start, int32_t row_end,
+    rest_unit_visitor_t on_rest_unit,
+    void *priv) {
+    const int32_t is_uv = plane > 0;
+    const int32_t ss_y = is_uv && cm->subsampling_y;
+
+    const RestorationInfo *rsi = &cm->rst_info[plane];
+
+    const AV1PixelRect tile_rect = whole_frame_rect(cm, is_uv);
+
+    foreach_rest_unit_in_tile(&tile_rect, 0, 0, 1, rsi->horz_units_per_tile,
+        rsi->units_per_tile, rsi->restoration_unit_size,
+        ss_y, row_start, row_end, on_rest_unit, priv);
 }
 
 int32_t av1_loop_restoration_corners_in_sb(Av1Common *cm, int32_t plane,
@@ -265,6 +265,19 @@ extern "C" {
         int32_t h_start, h_end, v_start, v_end;
     } RestorationTileLimits;
 
+    typedef struct {
+        // The best coefficients for Wiener or Sgrproj restoration
+        WienerInfo wiener;
+        SgrprojInfo sgrproj;
+
+        // The sum of squared errors for this rtype.
+        int64_t sse[RESTORE_SWITCHABLE_TYPES];
+
+        // The rtype to use for this unit given a frame rtype as
+        // index. Indices: WIENER, SGRPROJ, SWITCHABLE.
+        RestorationType best_rtype[RESTORE_TYPES - 1];
+    } RestUnitSearchInfo;
+
     extern const sgr_params_type sgr_params[SGRPROJ_PARAMS];
     extern int32_t sgrproj_mtable[SGRPROJ_PARAMS][2];
     extern const int32_t x_by_xplus1[256];
@@ -27,6 +27,10 @@ void av1_foreach_rest_unit_in_frame(Av1Common *cm, int32_t plane,
     rest_tile_start_visitor_t on_tile,
     rest_unit_visitor_t on_rest_unit,
     void *priv);
+void av1_foreach_rest_unit_in_rows(Av1Common *cm, int32_t plane,
+    int32_t row_start, int32_t row_end,
+    rest_unit_visitor_t on_rest_unit,
+    void *priv);
 
 
 // When set to RESTORE_WIENER or RESTORE_SGRPROJ only those are allowed.
@@ -59,19 +63,6 @@ static int64_t sse_restoration_unit(const RestorationTileLimits *limits,
         limits->v_start, limits->v_end - limits->v_start);
 }
 
-typedef struct {
-    // The best coefficients for Wiener or Sgrproj restoration
-    WienerInfo wiener;
-    SgrprojInfo sgrproj;
-
-    // The sum of squared errors for this rtype.
-    int64_t sse[RESTORE_SWITCHABLE_TYPES];
-
-    // The rtype to use for this unit given a frame rtype as
-    // index. Indices: WIENER, SGRPROJ, SWITCHABLE.
-    RestorationType best_rtype[RESTORE_TYPES - 1];
-} RestUnitSearchInfo;
-
 typedef struct {
     const Yv12BufferConfig *src;
     Yv12BufferConfig *dst;
@@ -88,6 +79,9 @@ typedef struct {
     const uint8_t *src_buffer;
     int32_t src_stride;
 
+    // scratch buffer of the thread running the unit searches
+    int32_t *tmpbuf;
+
     // sse and bits are initialised by reset_rsc in search_rest_type
     int64_t sse;
     int64_t bits;
@@ -117,9 +111,10 @@ static void reset_rsc(RestSearchCtxt *rsc) {
 
 static void init_rsc(const Yv12BufferConfig *src, Av1Common *cm,
     const Macroblock *x, int32_t plane, RestUnitSearchInfo *rusi,
-    Yv12BufferConfig *dst, RestSearchCtxt *rsc) {
+    Yv12BufferConfig *dst, int32_t *tmpbuf, RestSearchCtxt *rsc) {
     rsc->src = src;
     rsc->dst = dst;
+    rsc->tmpbuf = tmpbuf;
     rsc->cm = cm;
     rsc->x = x;
     rsc->plane = plane;
@@ -159,7 +154,7 @@ static int64_t try_restoration_unit(const RestSearchCtxt *rsc,
         limits, rui, &rsi->boundaries, &rlbs, tile_rect, rsc->tile_stripe0,
         is_uv && cm->subsampling_x, is_uv && cm->subsampling_y, highbd, bit_depth,
         fts->buffers[plane], fts->strides[is_uv], rsc->dst->buffers[plane],
-        rsc->dst->strides[is_uv], cm->rst_tmpbuf, optimized_lr);
+        rsc->dst->strides[is_uv], rsc->tmpbuf, optimized_lr);
 
     return sse_restoration_unit(limits, rsc->src, rsc->dst, plane, highbd);
 }
@@ -606,13 +601,9 @@ static int32_t count_sgrproj_bits(SgrprojInfo *sgrproj_info,
     return bits;
 }
 
-static void search_sgrproj(const RestorationTileLimits *limits,
-    const AV1PixelRect *tile, int32_t rest_unit_idx,
-    void *priv) {
-    RestSearchCtxt *rsc = (RestSearchCtxt *)priv;
-    RestUnitSearchInfo *rusi = &rsc->rusi[rest_unit_idx];
-
-    const Macroblock *const x = rsc->x;
+static void search_sgrproj_unit(const RestorationTileLimits *limits,
+    const AV1PixelRect *tile, RestSearchCtxt *rsc,
+    RestUnitSearchInfo *rusi) {
     const Av1Common *const cm = rsc->cm;
     const int32_t highbd = cm->use_highbitdepth;
     const int32_t bit_depth = cm->bit_depth;
@@ -632,13 +623,24 @@ static void search_sgrproj(const RestorationTileLimits *limits,
         dgd_start, limits->h_end - limits->h_start,
         limits->v_end - limits->v_start, rsc->dgd_stride, src_start,
         rsc->src_stride, highbd, bit_depth, procunit_width, procunit_height,
-        cm->rst_tmpbuf);
+        rsc->tmpbuf);
 
     RestorationUnitInfo rui;
     rui.restoration_type = RESTORE_SGRPROJ;
     rui.sgrproj_info = rusi->sgrproj;
 
     rusi->sse[RESTORE_SGRPROJ] = try_restoration_unit(rsc, limits, tile, &rui);
+}
+
+static void search_sgrproj(const RestorationTileLimits *limits,
+    const AV1PixelRect *tile, int32_t rest_unit_idx,
+    void *priv) {
+    (void)limits;
+    (void)tile;
+    RestSearchCtxt *rsc = (RestSearchCtxt *)priv;
+    RestUnitSearchInfo *rusi = &rsc->rusi[rest_unit_idx];
+
+    const Macroblock *const x = rsc->x;
 
     const int64_t bits_none = x->sgrproj_restore_cost[0];
     const int64_t bits_sgr = x->sgrproj_restore_cost[1] +
@@ -1173,12 +1175,9 @@ static int64_t finer_tile_search_wiener(const RestSearchCtxt *rsc,
     return err;
 }
 
-static void search_wiener(const RestorationTileLimits *limits,
-    const AV1PixelRect *tile_rect, int32_t rest_unit_idx,
-    void *priv) {
-    RestSearchCtxt *rsc = (RestSearchCtxt *)priv;
-    RestUnitSearchInfo *rusi = &rsc->rusi[rest_unit_idx];
-
+static void search_wiener_unit(const RestorationTileLimits *limits,
+    const AV1PixelRect *tile_rect, RestSearchCtxt *rsc,
+    RestUnitSearchInfo *rusi) {
     const int32_t wiener_win =
         (rsc->plane == AOM_PLANE_Y) ? WIENER_WIN : WIENER_WIN_CHROMA;
     int64_t M[WIENER_WIN2];
@@ -1215,13 +1214,7 @@ static void search_wiener(const RestorationTileLimits *limits,
 
     }
 
-    const Macroblock *const x = rsc->x;
-    const int64_t bits_none = x->wiener_restore_cost[0];
-
     if (!wiener_decompose_sep_sym(wiener_win, M, H, vfilterd, hfilterd)) {
-        rsc->bits += bits_none;
-        rsc->sse += rusi->sse[RESTORE_NONE];
-        rusi->best_rtype[RESTORE_WIENER - 1] = RESTORE_NONE;
         rusi->sse[RESTORE_WIENER] = INT64_MAX;
         return;
     }
@@ -1237,9 +1230,6 @@ static void search_wiener(const RestorationTileLimits *limits,
     // reduction in the function, the filter is reverted back to identity
     if (compute_score(wiener_win, M, H, rui.wiener_info.vfilter,
         rui.wiener_info.hfilter) > 0) {
-        rsc->bits += bits_none;
-        rsc->sse += rusi->sse[RESTORE_NONE];
-        rusi->best_rtype[RESTORE_WIENER - 1] = RESTORE_NONE;
         rusi->sse[RESTORE_WIENER] = INT64_MAX;
         return;
     }
@@ -1256,6 +1246,29 @@ static void search_wiener(const RestorationTileLimits *limits,
         assert(rui.wiener_info.hfilter[0] == 0 &&
             rui.wiener_info.hfilter[WIENER_WIN - 1] == 0);
     }
+}
+
+static void search_wiener(const RestorationTileLimits *limits,
+    const AV1PixelRect *tile_rect, int32_t rest_unit_idx,
+    void *priv) {
+    (void)limits;
+    (void)tile_rect;
+    RestSearchCtxt *rsc = (RestSearchCtxt *)priv;
+    RestUnitSearchInfo *rusi = &rsc->rusi[rest_unit_idx];
+
+    const int32_t wiener_win =
+        (rsc->plane == AOM_PLANE_Y) ? WIENER_WIN : WIENER_WIN_CHROMA;
+
+    const Macroblock *const x = rsc->x;
+    const int64_t bits_none = x->wiener_restore_cost[0];
+
+    // The unit search found no filter better than the identity filter
+    if (rusi->sse[RESTORE_WIENER] == INT64_MAX) {
+        rsc->bits += bits_none;
+        rsc->sse += rusi->sse[RESTORE_NONE];
+        rusi->best_rtype[RESTORE_WIENER - 1] = RESTORE_NONE;
+        return;
+    }
 
     const int64_t bits_wiener =
         x->wiener_restore_cost[1] +
@@ -1279,16 +1292,31 @@ static void search_wiener(const RestorationTileLimits *limits,
 static void search_norestore(const RestorationTileLimits *limits,
     const AV1PixelRect *tile_rect, int32_t rest_unit_idx,
     void *priv) {
+    (void)limits;
     (void)tile_rect;
 
     RestSearchCtxt *rsc = (RestSearchCtxt *)priv;
     RestUnitSearchInfo *rusi = &rsc->rusi[rest_unit_idx];
 
+    rsc->sse += rusi->sse[RESTORE_NONE];
+}
+
+// Runs the searches of all the restoration types for one unit. The results
+// only depend on the unit, so the units can be searched in any order; the
+// rate decisions, which depend on the previously coded unit, are made by
+// search_rest_type() afterwards.
+static void search_rest_unit(const RestorationTileLimits *limits,
+    const AV1PixelRect *tile_rect, int32_t rest_unit_idx,
+    void *priv) {
+    RestSearchCtxt *rsc = (RestSearchCtxt *)priv;
+    RestUnitSearchInfo *rusi = &rsc->rusi[rest_unit_idx];
+
     const int32_t highbd = rsc->cm->use_highbitdepth;
     rusi->sse[RESTORE_NONE] = sse_restoration_unit(
         limits, rsc->src, rsc->cm->frame_to_show, rsc->plane, highbd);
 
-    rsc->sse += rusi->sse[RESTORE_NONE];
+    search_wiener_unit(limits, tile_rect, rsc, rusi);
+    search_sgrproj_unit(limits, tile_rect, rsc, rusi);
 }
 
 static void search_switchable(const RestorationTileLimits *limits,
@@ -1384,10 +1412,46 @@ static int32_t rest_tiles_in_plane(const Av1Common *cm, int32_t plane) {
     return rsi->units_per_tile;
 }
 
-void *aom_memalign(size_t align, size_t size);
-void aom_free(void *memblk);
+// Extends the borders of the deblocked and CDEF filtered frame and clears the
+// search results, before the restoration unit rows are searched.
+void av1_pick_filter_restoration_init(Av1Common *const cm, RestUnitSearchInfo **rusi) {
+
+    const int32_t num_planes = 3;// av1_num_planes(cm);
+    const Yv12BufferConfig *dgd = cm->frame_to_show;
+    const int32_t highbd = cm->use_highbitdepth;
+
+    for (int32_t plane = AOM_PLANE_Y; plane < num_planes; ++plane) {
+        const int32_t is_uv = plane != AOM_PLANE_Y;
+
+        extend_frame(dgd->buffers[plane], dgd->crop_widths[is_uv], dgd->crop_heights[is_uv],
+            dgd->strides[is_uv], RESTORATION_BORDER, RESTORATION_BORDER,
+            highbd);
+
+        // If the restoration unit dimensions are not multiples of
+        // rsi->restoration_unit_size then some elements of the rusi array may be
+        // left uninitialised when we reach copy_unit_info(...). This is not a
+        // problem, as these elements are ignored later, but in order to quiet
+        // Valgrind's warnings we initialise the array below.
+        memset(rusi[plane], 0, sizeof(*rusi[plane]) * rest_tiles_in_plane(cm, plane));
+    }
+}
+
+// Searches the restoration units of rows [row_start, row_end) of one plane.
+// trial_frame_rst and rst_tmpbuf belong to the calling thread.
+void av1_pick_filter_restoration_rows(const Yv12BufferConfig *src, Yv12BufferConfig *trial_frame_rst,
+    int32_t *rst_tmpbuf, Macroblock *x, Av1Common *const cm, RestUnitSearchInfo *rusi,
+    int32_t plane, int32_t row_start, int32_t row_end) {
+
+    RestSearchCtxt rsc;
+    init_rsc(src, cm, x, plane, rusi, trial_frame_rst, rst_tmpbuf, &rsc);
+    rsc_on_tile(0, 0, &rsc);
+
+    av1_foreach_rest_unit_in_rows(cm, plane, row_start, row_end, search_rest_unit, &rsc);
+}
 
-void av1_pick_filter_restoration(const Yv12BufferConfig *src, Yv12BufferConfig * trial_frame_rst /*AV1_COMP *cpi*/, Macroblock *x, Av1Common *const cm) {
+// Picks the frame restoration type of each plane once all the unit rows have
+// been searched.
+void av1_pick_filter_restoration_finish(const Yv12BufferConfig *src, Macroblock *x, Av1Common *const cm, RestUnitSearchInfo **rusi) {
 
     //CHKN Av1Common *const cm = &cpi->common;
     const int32_t num_planes = 3;// av1_num_planes(cm);
@@ -1398,22 +1462,13 @@ void av1_pick_filter_restoration(const Yv12BufferConfig *src, Yv12BufferConfig *
         ntiles[is_uv] = rest_tiles_in_plane(cm, is_uv);
 
     assert(ntiles[1] <= ntiles[0]);
-    RestUnitSearchInfo *rusi =
-        (RestUnitSearchInfo *)aom_memalign(16, sizeof(*rusi) * ntiles[0]);
-
-    // If the restoration unit dimensions are not multiples of
-    // rsi->restoration_unit_size then some elements of the rusi array may be
-    // left uninitialised when we reach copy_unit_info(...). This is not a
-    // problem, as these elements are ignored later, but in order to quiet
-    // Valgrind's warnings we initialise the array below.
-    memset(rusi, 0, sizeof(*rusi) * ntiles[0]);
 
     RestSearchCtxt rsc;
     const int32_t plane_start = AOM_PLANE_Y;
     const int32_t plane_end = num_planes > 1 ? AOM_PLANE_V : AOM_PLANE_Y;
     for (int32_t plane = plane_start; plane <= plane_end; ++plane) {
         //CHKN  init_rsc(src, cpi->common, &cpi->td.mb, plane, rusi, &cpi->trial_frame_rst,&rsc);
-        init_rsc(src, cm, x, plane, rusi, trial_frame_rst, &rsc);
+        init_rsc(src, cm, x, plane, rusi[plane], NULL, NULL, &rsc);
 
         const int32_t plane_ntiles = ntiles[plane > 0];
         const RestorationType num_rtypes =
@@ -1422,15 +1477,6 @@ void av1_pick_filter_restoration(const Yv12BufferConfig *src, Yv12BufferConfig *
         double best_cost = 0;
         RestorationType best_rtype = RESTORE_NONE;
 
-        const int32_t highbd = rsc.cm->use_highbitdepth;
-
-
-
-
-        extend_frame(rsc.dgd_buffer, rsc.plane_width, rsc.plane_height,
-            rsc.dgd_stride, RESTORATION_BORDER, RESTORATION_BORDER,
-            highbd);
-
         //CHKN  for (RestorationType r = 0; r < num_rtypes; ++r) {
         for (int32_t restType = 0; restType < num_rtypes; ++restType) {
 
@@ -1461,13 +1507,9 @@ void av1_pick_filter_restoration(const Yv12BufferConfig *src, Yv12BufferConfig *
         if (best_rtype != RESTORE_NONE) {
             for (int32_t u = 0; u < plane_ntiles; ++u) {
 
-                copy_unit_info(best_rtype, &rusi[u], &cm->rst_info[plane].unit_info[u]);
+                copy_unit_info(best_rtype, &rusi[plane][u], &cm->rst_info[plane].unit_info[u]);
 
             }
         }
     }
-
-    aom_free(rusi);
 }
-
-
@@ -281,6 +281,7 @@ EbErrorType copy_sequence_control_set(
     dst->film_grain_denoise_strength = src->film_grain_denoise_strength;          writeCount += sizeof(int32_t);
     dst->film_grain_params_present = src->film_grain_params_present;              writeCount += sizeof(int32_t);
     dst->film_grain_params_present = src->film_grain_params_present;              writeCount += sizeof(int32_t);
+    dst->enable_restoration = src->enable_restoration;                      writeCount += sizeof(int32_t);
     dst->picture_control_set_pool_init_count = src->picture_control_set_pool_init_count;            writeCount += sizeof(int32_t);
     dst->picture_control_set_pool_init_count_child = src->picture_control_set_pool_init_count_child; writeCount += sizeof(int32_t);
     dst->pa_reference_picture_buffer_init_count = src->pa_reference_picture_buffer_init_count; writeCount += sizeof(int32_t);
@@ -298,12 +299,14 @@ EbErrorType copy_sequence_control_set(
     dst->rate_control_fifo_init_count = src->rate_control_fifo_init_count; writeCount += sizeof(int32_t);
     dst->mode_decision_configuration_fifo_init_count = src->mode_decision_configuration_fifo_init_count; writeCount += sizeof(int32_t);
     dst->enc_dec_fifo_init_count = src->enc_dec_fifo_init_count; writeCount += sizeof(int32_t);
+    dst->filter_fifo_init_count = src->filter_fifo_init_count; writeCount += sizeof(int32_t);
     dst->entropy_coding_fifo_init_count = src->entropy_coding_fifo_init_count; writeCount += sizeof(int32_t);
     dst->picture_analysis_process_init_count = src->picture_analysis_process_init_count; writeCount += sizeof(int32_t);
     dst->motion_estimation_process_init_count = src->motion_estimation_process_init_count; writeCount += sizeof(int32_t);
     dst->source_based_operations_process_init_count = src->source_based_operations_process_init_count; writeCount += sizeof(int32_t);
     dst->mode_decision_configuration_process_init_count = src->mode_decision_configuration_process_init_count; writeCount += sizeof(int32_t);
     dst->enc_dec_process_init_count = src->enc_dec_process_init_count; writeCount += sizeof(int32_t);
+    dst->filter_process_init_count = src->filter_process_init_count; writeCount += sizeof(int32_t);
     dst->entropy_coding_process_init_count = src->entropy_coding_process_init_count; writeCount += sizeof(int32_t);
     dst->total_process_init_count = src->total_process_init_count; writeCount += sizeof(int32_t);
     dst->left_padding = src->left_padding; writeCount += sizeof(int16_t);
@@ -373,7 +376,8 @@ extern EbErrorType sb_params_ctor(
 
     EbErrorType return_error = EB_ErrorNone;
 
-    EB_MALLOC(SbParams_t*, sequence_control_set_ptr->sb_params_array, sizeof(SbParams_t) * ((MAX_PICTURE_WIDTH_SIZE + sequence_control_set_ptr->sb_sz - 1) / sequence_control_set_ptr->sb_sz) * ((MAX_PICTURE_HEIGHT_SIZE + sequence_control_set_ptr->sb_sz - 1) / sequence_control_set_ptr->sb_sz), EB_N_PTR);
+    // Allocated by sb_params_init once the input resolution is known
+    sequence_control_set_ptr->sb_params_array = (SbParams_t*)EB_NULL;
     return return_error;
 }
 
@@ -148,12 +148,14 @@ extern "C" {
         uint32_t                                rate_control_fifo_init_count;
         uint32_t                                mode_decision_configuration_fifo_init_count;
         uint32_t                                enc_dec_fifo_init_count;
+        uint32_t                                filter_fifo_init_count;
         uint32_t                                entropy_coding_fifo_init_count;
         uint32_t                                picture_analysis_process_init_count;
         uint32_t                                motion_estimation_process_init_count;
         uint32_t                                source_based_operations_process_init_count;
         uint32_t                                mode_decision_configuration_process_init_count;
         uint32_t                                enc_dec_process_init_count;
+        uint32_t                                filter_process_init_count;
         uint32_t                                entropy_coding_process_init_count;
         uint32_t                                total_process_init_count;
         
@@ -3,9 +3,47 @@
 * SPDX - License - Identifier: BSD - 2 - Clause - Patent
 */
 
+#include <stdio.h>
 #include <stdlib.h>
 
 #include "EbSystemResourceManager.h"
+#include "EbThreadPool.h"
+
+#if LOCK_FREE_FIFO
+#define EB_RING_SPIN_COUNT              128     // attempts on the ring count before blocking
+#endif
+
+// Fifo of the process the calling thread runs, the one it took its last
+// full object from. A thread pool task only changes of worker while waiting
+// in EbGetFullObject, which sets it again.
+static EB_THREAD_LOCAL EbFifo_t *current_process_fifo_ptr = (EbFifo_t*)EB_NULL;
+
+/**************************************
+ * EbOutputWaitStart, EbOutputWaitEnd
+ *   Time the process of the calling thread waits for an empty object
+ **************************************/
+static uint64_t EbOutputWaitStart(
+    EbFifo_t           *processFifoPtr)
+{
+    uint64_t waitStartTime = 0;
+
+    if (processFifoPtr) {
+        waitStartTime = EbGetMonotonicTime();
+        EB_ATOMIC_STORE64(&processFifoPtr->outputWaitStartTime, waitStartTime);
+    }
+
+    return waitStartTime;
+}
+
+static void EbOutputWaitEnd(
+    EbFifo_t           *processFifoPtr,
+    uint64_t            waitStartTime)
+{
+    if (processFifoPtr) {
+        EB_ATOMIC_ADD64(&processFifoPtr->queuePtr->stats.outputWaitTime, EbGetMonotonicTime() - waitStartTime);
+        EB_ATOMIC_STORE64(&processFifoPtr->outputWaitStartTime, 0);
+    }
+}
 
 /**************************************
  * EbFifoCtor
@@ -18,11 +56,19 @@ static EbErrorType EbFifoCtor(
     EbObjectWrapper_t  *lastWrapperPtr,
     EbMuxingQueue_t    *queuePtr)
 {
+#if LOCK_FREE_FIFO
+    // The processes wait on the ring of the Muxing Queue
+    (void)initialCount;
+    (void)maxCount;
+    fifoPtr->countingSemaphore = (EbHandle)EB_NULL;
+    fifoPtr->lockoutMutex = (EbHandle)EB_NULL;
+#else
     // Create Counting Semaphore
     EB_CREATESEMAPHORE(EbHandle, fifoPtr->countingSemaphore, sizeof(EbHandle), EB_SEMAPHORE, initialCount, maxCount);
 
     // Create Buffer Pool Mutex
     EB_CREATEMUTEX(EbHandle, fifoPtr->lockoutMutex, sizeof(EbHandle), EB_MUTEX);
+#endif
 
     // Initialize Fifo First & Last ptrs
     fifoPtr->firstPtr = firstWrapperPtr;
@@ -31,10 +77,260 @@ static EbErrorType EbFifoCtor(
     // Copy the Muxing Queue ptr this Fifo belongs to
     fifoPtr->queuePtr = queuePtr;
 
+    fifoPtr->taskPtr = (EbTask_t*)EB_NULL;
+    fifoPtr->taskWaiting = EB_FALSE;
+    fifoPtr->busyStartTime = 0;
+    fifoPtr->waitStartTime = 0;
+    fifoPtr->outputWaitStartTime = 0;
+
     return EB_ErrorNone;
 }
 
+#if LOCK_FREE_FIFO
+/**************************************
+ * EbRingCtor
+ **************************************/
+static EbErrorType EbRingCtor(
+    EbRing_t           *ringPtr,
+    uint32_t            objectTotalCount)
+{
+    uint32_t cellTotalCount = 1;
+    uint32_t cellIndex;
+
+    // Power of two number of cells, the positions wrap with a mask
+    while (cellTotalCount < objectTotalCount)
+        cellTotalCount <<= 1;
+
+    EB_MALLOC(EbRingCell_t*, ringPtr->cellArray, sizeof(EbRingCell_t) * cellTotalCount, EB_N_PTR);
+
+    for (cellIndex = 0; cellIndex < cellTotalCount; ++cellIndex) {
+        ringPtr->cellArray[cellIndex].sequence = cellIndex;
+        ringPtr->cellArray[cellIndex].wrapperPtr = (EbObjectWrapper_t*)EB_NULL;
+    }
+
+    ringPtr->mask = cellTotalCount - 1;
+    ringPtr->enqueuePos = 0;
+    ringPtr->dequeuePos = 0;
+
+    return EB_ErrorNone;
+}
 
+/**************************************
+ * EbRingPushBack
+ *   A queue never holds more than its objectTotalCount objects, so the
+ *   ring is never full: a producer only waits for a consumer finishing
+ *   its read of the cell.
+ **************************************/
+static void EbRingPushBack(
+    EbRing_t           *ringPtr,
+    EbObjectWrapper_t  *wrapper_ptr)
+{
+    EbRingCell_t *cellPtr;
+    uint32_t      position = EB_ATOMIC_LOAD_ACQUIRE(&ringPtr->enqueuePos);
+
+    for (;;) {
+        cellPtr = &ringPtr->cellArray[position & ringPtr->mask];
+        int32_t difference = (int32_t)(EB_ATOMIC_LOAD_ACQUIRE(&cellPtr->sequence) - position);
+        if (difference == 0) {
+            if (EB_ATOMIC_CAS(&ringPtr->enqueuePos, position, position + 1))
+                break;
+        }
+        else if (difference < 0)
+            EB_CPU_PAUSE();
+        position = EB_ATOMIC_LOAD_ACQUIRE(&ringPtr->enqueuePos);
+    }
+
+    cellPtr->wrapperPtr = wrapper_ptr;
+    EB_ATOMIC_STORE_RELEASE(&cellPtr->sequence, position + 1);
+}
+
+/**************************************
+ * EbRingPopFront
+ *   Called once the countingSemaphore of the queue is taken, an object is
+ *   then available: a consumer only waits for a producer finishing its
+ *   write of the cell.
+ **************************************/
+static EbObjectWrapper_t* EbRingPopFront(
+    EbRing_t           *ringPtr)
+{
+    EbObjectWrapper_t *wrapper_ptr;
+    EbRingCell_t      *cellPtr;
+    uint32_t           position = EB_ATOMIC_LOAD_ACQUIRE(&ringPtr->dequeuePos);
+
+    for (;;) {
+        cellPtr = &ringPtr->cellArray[position & ringPtr->mask];
+        int32_t difference = (int32_t)(EB_ATOMIC_LOAD_ACQUIRE(&cellPtr->sequence) - (position + 1));
+        if (difference == 0) {
+            if (EB_ATOMIC_CAS(&ringPtr->dequeuePos, position, position + 1))
+                break;
+        }
+        else if (difference < 0)
+            EB_CPU_PAUSE();
+        position = EB_ATOMIC_LOAD_ACQUIRE(&ringPtr->dequeuePos);
+    }
+
+    wrapper_ptr = cellPtr->wrapperPtr;
+    EB_ATOMIC_STORE_RELEASE(&cellPtr->sequence, position + ringPtr->mask + 1);
+
+    return wrapper_ptr;
+}
+
+/**************************************
+ * EbStackCtor
+ **************************************/
+static EbErrorType EbStackCtor(
+    EbStack_t          *stackPtr,
+    EbObjectWrapper_t **wrapperArray,
+    uint32_t            objectTotalCount)
+{
+    EB_MALLOC(uint32_t*, stackPtr->nextArray, sizeof(uint32_t) * objectTotalCount, EB_N_PTR);
+    stackPtr->wrapperArray = wrapperArray;
+    stackPtr->head = 0;
+
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * EbStackPush
+ **************************************/
+static void EbStackPush(
+    EbStack_t          *stackPtr,
+    EbObjectWrapper_t  *wrapper_ptr)
+{
+    uint64_t head = EB_ATOMIC_LOAD64_ACQUIRE(&stackPtr->head);
+    uint64_t newHead;
+
+    do {
+        stackPtr->nextArray[wrapper_ptr->poolIndex] = (uint32_t)head;
+        newHead = (((head >> 32) + 1) << 32) | (wrapper_ptr->poolIndex + 1);
+        if (EB_ATOMIC_CAS64(&stackPtr->head, head, newHead))
+            break;
+        head = EB_ATOMIC_LOAD64_ACQUIRE(&stackPtr->head);
+    } while (1);
+}
+
+/**************************************
+ * EbStackPop
+ *   Called once the countingSemaphore of the queue is taken, the stack
+ *   then holds an object for the caller.
+ **************************************/
+static EbObjectWrapper_t* EbStackPop(
+    EbStack_t          *stackPtr)
+{
+    uint64_t head;
+    uint32_t topIndex;
+
+    for (;;) {
+        head = EB_ATOMIC_LOAD64_ACQUIRE(&stackPtr->head);
+        topIndex = (uint32_t)head;
+        if (topIndex) {
+            uint64_t newHead = (head & ~(uint64_t)0xFFFFFFFF) | ((volatile uint32_t*)stackPtr->nextArray)[topIndex - 1];
+            if (EB_ATOMIC_CAS64(&stackPtr->head, head, newHead))
+                return stackPtr->wrapperArray[topIndex - 1];
+        }
+        EB_CPU_PAUSE();
+    }
+}
+
+/**************************************
+ * EbMuxingQueuePush, EbMuxingQueuePop
+ *   Ring of the full queues, stack of the empty queues
+ **************************************/
+static void EbMuxingQueuePush(
+    EbMuxingQueue_t    *queuePtr,
+    EbObjectWrapper_t  *wrapper_ptr)
+{
+    if (queuePtr->stack.wrapperArray)
+        EbStackPush(&queuePtr->stack, wrapper_ptr);
+    else
+        EbRingPushBack(&queuePtr->ring, wrapper_ptr);
+}
+
+static EbObjectWrapper_t* EbMuxingQueuePop(
+    EbMuxingQueue_t    *queuePtr)
+{
+    return queuePtr->stack.wrapperArray ?
+        EbStackPop(&queuePtr->stack) :
+        EbRingPopFront(&queuePtr->ring);
+}
+
+/**************************************
+ * EbMuxingQueueObjectPost
+ **************************************/
+static void EbMuxingQueueObjectPost(
+    EbMuxingQueue_t    *queuePtr,
+    EbObjectWrapper_t  *wrapper_ptr)
+{
+    EbTask_t *taskPtr = (EbTask_t*)EB_NULL;
+
+    EbMuxingQueuePush(
+        queuePtr,
+        wrapper_ptr);
+
+    EbPostSemaphore(queuePtr->countingSemaphore);
+
+    // Wake a parked task, it competes for the object with the other processes. The fence
+    // pairs with the one of EbMuxingQueueObjectGet: either the waiter sees the post, or
+    // the poster sees the waiter.
+    EB_ATOMIC_FENCE();
+    if (EB_ATOMIC_LOAD_ACQUIRE(&queuePtr->taskWaiterCount)) {
+        EbBlockOnMutex(queuePtr->lockoutMutex);
+        if (queuePtr->taskWaiterCount)
+            taskPtr = queuePtr->taskWaiterArray[--queuePtr->taskWaiterCount];
+        EbReleaseMutex(queuePtr->lockoutMutex);
+        if (taskPtr)
+            eb_task_schedule(taskPtr);
+    }
+}
+
+/**************************************
+ * EbMuxingQueueObjectGet
+ *   Spins briefly on the object count, then blocks on it. Thread pool
+ *   tasks park instead when parkTask is set, leaving their worker to the
+ *   other tasks.
+ **************************************/
+static EbObjectWrapper_t* EbMuxingQueueObjectGet(
+    EbMuxingQueue_t    *queuePtr,
+    EbBool              parkTask)
+{
+    EbTask_t *taskPtr = (parkTask == EB_TRUE) ? eb_task_self() : (EbTask_t*)EB_NULL;
+    uint32_t  spinIndex;
+    uint32_t  waiterIndex;
+
+    for (spinIndex = 0; spinIndex < EB_RING_SPIN_COUNT; ++spinIndex) {
+        if (EbTryBlockOnSemaphore(queuePtr->countingSemaphore) == EB_TRUE)
+            return EbMuxingQueuePop(queuePtr);
+        EB_CPU_PAUSE();
+    }
+
+    while (taskPtr) {
+        EbBlockOnMutex(queuePtr->lockoutMutex);
+        if (queuePtr->taskWaiterCount == queuePtr->processTotalCount) {
+            EbReleaseMutex(queuePtr->lockoutMutex);
+            break;
+        }
+        queuePtr->taskWaiterArray[queuePtr->taskWaiterCount] = taskPtr;
+        EB_ATOMIC_STORE_RELEASE(&queuePtr->taskWaiterCount, queuePtr->taskWaiterCount + 1);
+        EB_ATOMIC_FENCE();
+
+        // Check the count once registered, a post from now on wakes a task
+        if (EbTryBlockOnSemaphore(queuePtr->countingSemaphore) == EB_TRUE) {
+            for (waiterIndex = 0; queuePtr->taskWaiterArray[waiterIndex] != taskPtr; ++waiterIndex);
+            queuePtr->taskWaiterArray[waiterIndex] = queuePtr->taskWaiterArray[--queuePtr->taskWaiterCount];
+            EbReleaseMutex(queuePtr->lockoutMutex);
+            return EbMuxingQueuePop(queuePtr);
+        }
+        eb_task_park(taskPtr, queuePtr->lockoutMutex);
+
+        if (EbTryBlockOnSemaphore(queuePtr->countingSemaphore) == EB_TRUE)
+            return EbMuxingQueuePop(queuePtr);
+    }
+
+    EbBlockOnSemaphore(queuePtr->countingSemaphore);
+
+    return EbMuxingQueuePop(queuePtr);
+}
+#else
 /**************************************
  * EbFifoPushBack
  **************************************/
@@ -184,15 +480,19 @@ static EbErrorType EbCircularBufferPushFront(
 
     return return_error;
 }
+#endif
 
 /**************************************
  * EbMuxingQueueCtor
+ *   wrapperArray - the wrappers of the SystemResource for an empty queue,
+ *   kept in a stack, NULL for a full queue.
  **************************************/
 static EbErrorType EbMuxingQueueCtor(
     EbMuxingQueue_t   **queueDblPtr,
     uint32_t              objectTotalCount,
     uint32_t              processTotalCount,
-    EbFifo_t         ***processFifoPtrArrayPtr)
+    EbFifo_t         ***processFifoPtrArrayPtr,
+    EbObjectWrapper_t **wrapperArray)
 {
     EbMuxingQueue_t *queuePtr;
     uint32_t processIndex;
@@ -206,6 +506,26 @@ static EbErrorType EbMuxingQueueCtor(
     // Lockout Mutex
     EB_CREATEMUTEX(EbHandle, queuePtr->lockoutMutex, sizeof(EbHandle), EB_MUTEX);
 
+#if LOCK_FREE_FIFO
+    // Construct the Object Stack or Ring
+    queuePtr->stack.wrapperArray = (EbObjectWrapper_t**)EB_NULL;
+    if (wrapperArray)
+        return_error = EbStackCtor(
+            &queuePtr->stack,
+            wrapperArray,
+            objectTotalCount);
+    else
+        return_error = EbRingCtor(
+            &queuePtr->ring,
+            objectTotalCount);
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+    EB_CREATESEMAPHORE(EbHandle, queuePtr->countingSemaphore, sizeof(EbHandle), EB_SEMAPHORE, 0, objectTotalCount);
+    EB_MALLOC(EbTask_t**, queuePtr->taskWaiterArray, sizeof(EbTask_t*) * queuePtr->processTotalCount, EB_N_PTR);
+    queuePtr->taskWaiterCount = 0;
+#else
+    (void)wrapperArray;
     // Construct Object Circular Buffer
     return_error = EbCircularBufferCtor(
         &queuePtr->objectQueue,
@@ -220,6 +540,7 @@ static EbErrorType EbMuxingQueueCtor(
     if (return_error == EB_ErrorInsufficientResources) {
         return EB_ErrorInsufficientResources;
     }
+#endif
     // Construct the Process Fifos
     EB_MALLOC(EbFifo_t**, queuePtr->processFifoPtrArray, sizeof(EbFifo_t*) * queuePtr->processTotalCount, EB_N_PTR);
 
@@ -239,9 +560,78 @@ static EbErrorType EbMuxingQueueCtor(
 
     *processFifoPtrArrayPtr = queuePtr->processFifoPtrArray;
 
+    queuePtr->spareWrapperArray = (EbObjectWrapper_t**)EB_NULL;
+    queuePtr->spareWrapperCount = 0;
+
+    EB_MEMSET(&queuePtr->stats, 0, sizeof(EbQueueStats_t));
+
     return return_error;
 }
 
+/**************************************
+ * EbQueueStatsPost
+ *   Counts an object posted to a full queue, before it is pushed so that
+ *   the count never goes below zero
+ **************************************/
+static void EbQueueStatsPost(
+    EbQueueStats_t     *statsPtr)
+{
+    uint32_t objectCount = EB_ATOMIC_ADD(&statsPtr->objectCount, 1);
+    uint32_t objectCountMax = EB_ATOMIC_LOAD_ACQUIRE(&statsPtr->objectCountMax);
+
+    while (objectCount > objectCountMax && !EB_ATOMIC_CAS(&statsPtr->objectCountMax, objectCountMax, objectCount))
+        objectCountMax = EB_ATOMIC_LOAD_ACQUIRE(&statsPtr->objectCountMax);
+
+    EB_ATOMIC_ADD64(&statsPtr->objectCountSum, objectCount);
+    EB_ATOMIC_ADD64(&statsPtr->postCount, 1);
+}
+
+/**************************************
+ * EbMuxingQueueSpareGet
+ *   Takes a spare wrapper and constructs its object, in the memory
+ *   context of the SystemResource. Returns NULL if none is left.
+ **************************************/
+static EbObjectWrapper_t* EbMuxingQueueSpareGet(
+    EbMuxingQueue_t   *queuePtr)
+{
+    EbObjectWrapper_t  *wrapper_ptr = (EbObjectWrapper_t*)EB_NULL;
+    EbSystemResource_t *resourcePtr;
+    EbMemoryContext    *callerContextPtr;
+    EbErrorType         return_error;
+
+    if (EB_ATOMIC_LOAD_ACQUIRE(&queuePtr->spareWrapperCount) == 0)
+        return wrapper_ptr;
+
+    EbBlockOnMutex(queuePtr->lockoutMutex);
+    if (queuePtr->spareWrapperCount)
+        wrapper_ptr = queuePtr->spareWrapperArray[--queuePtr->spareWrapperCount];
+    EbReleaseMutex(queuePtr->lockoutMutex);
+
+    if (wrapper_ptr == (EbObjectWrapper_t*)EB_NULL)
+        return wrapper_ptr;
+
+    resourcePtr = wrapper_ptr->systemResourcePtr;
+    callerContextPtr = eb_get_memory_context();
+    eb_set_memory_context(resourcePtr->memoryContextPtr);
+    return_error = resourcePtr->objectCtor(
+        &wrapper_ptr->objectPtr,
+        resourcePtr->objectInitDataPtr);
+    eb_set_memory_context(callerContextPtr);
+
+    if (return_error != EB_ErrorNone) {
+        // Carry on with the objects built so far
+        SVT_LOG("SVT [WARNING]: object construction failed, the pool is capped at its current size\n");
+        EbBlockOnMutex(queuePtr->lockoutMutex);
+        queuePtr->spareWrapperCount = 0;
+        EbReleaseMutex(queuePtr->lockoutMutex);
+        wrapper_ptr->objectPtr = EB_NULL;
+        wrapper_ptr = (EbObjectWrapper_t*)EB_NULL;
+    }
+
+    return wrapper_ptr;
+}
+
+#if !LOCK_FREE_FIFO
 /**************************************
  * EbMuxingQueueAssignation
  **************************************/
@@ -251,6 +641,8 @@ static EbErrorType EbMuxingQueueAssignation(
     EbErrorType return_error = EB_ErrorNone;
     EbFifo_t *processFifoPtr;
     EbObjectWrapper_t *wrapper_ptr;
+    EbTask_t *taskPtr;
+    EbTask_t *wakeTaskPtr;
 
     // while loop
     while ((EbCircularBufferEmptyCheck(queuePtr->objectQueue) == EB_FALSE) &&
@@ -273,11 +665,22 @@ static EbErrorType EbMuxingQueueAssignation(
             processFifoPtr,
             wrapper_ptr);
 
+        // Take the parked task of the fifo
+        taskPtr = processFifoPtr->taskPtr;
+        wakeTaskPtr = (EbTask_t*)EB_NULL;
+        if (taskPtr && processFifoPtr->taskWaiting) {
+            processFifoPtr->taskWaiting = EB_FALSE;
+            wakeTaskPtr = taskPtr;
+        }
+
         // Release the Process Fifo's Mutex
         EbReleaseMutex(processFifoPtr->lockoutMutex);
 
-        // Post the semaphore
-        EbPostSemaphore(processFifoPtr->countingSemaphore);
+        // Wake the task or post the semaphore
+        if (wakeTaskPtr)
+            eb_task_schedule(wakeTaskPtr);
+        else if (taskPtr == (EbTask_t*)EB_NULL)
+            EbPostSemaphore(processFifoPtr->countingSemaphore);
     }
 
     return return_error;
@@ -318,6 +721,7 @@ static EbErrorType EbMuxingQueueObjectPushFront(
 
     return return_error;
 }
+#endif
 
 /*********************************************************************
  * EbObjectReleaseEnable
@@ -441,9 +845,11 @@ EbErrorType EbSystemResourceCtor(
     EbFifo_t          ***consumerFifoPtrArrayPtr,
     EbBool              fullFifoEnabled,
     EB_CTOR              ObjectCtor,
-    EbPtr               object_init_data_ptr)
+    EbPtr               object_init_data_ptr,
+    uint32_t              objectInitDataSize)
 {
     uint32_t wrapperIndex;
+    uint32_t builtCount;
     EbErrorType return_error = EB_ErrorNone;
     // Allocate the System Resource
     EbSystemResource_t *resourcePtr;
@@ -452,6 +858,21 @@ EbErrorType EbSystemResourceCtor(
     *resourceDblPtr = resourcePtr;
 
     resourcePtr->objectTotalCount = objectTotalCount;
+    resourcePtr->objectRelease = (EB_RELEASE)EB_NULL;
+    resourcePtr->objectCtor = ObjectCtor;
+    resourcePtr->objectInitDataPtr = object_init_data_ptr;
+    resourcePtr->memoryContextPtr = eb_get_memory_context();
+    resourcePtr->inFlightCountPtr = (uint32_t*)EB_NULL;
+
+    // The init data of the later constructions
+    if (ObjectCtor && objectInitDataSize) {
+        EB_MALLOC(EbPtr, resourcePtr->objectInitDataPtr, objectInitDataSize, EB_N_PTR);
+        EB_MEMCPY(resourcePtr->objectInitDataPtr, object_init_data_ptr, objectInitDataSize);
+    }
+
+    // The first object is built here so that a failing construction is
+    // reported by the init, the others on first demand
+    builtCount = (ObjectCtor && resourcePtr->objectTotalCount) ? 1 : resourcePtr->objectTotalCount;
 
     // Allocate array for wrapper pointers
     EB_MALLOC(EbObjectWrapper_t**, resourcePtr->wrapperPtrPool, sizeof(EbObjectWrapper_t*) * resourcePtr->objectTotalCount, EB_N_PTR);
@@ -462,9 +883,11 @@ EbErrorType EbSystemResourceCtor(
         resourcePtr->wrapperPtrPool[wrapperIndex]->liveCount = 0;
         resourcePtr->wrapperPtrPool[wrapperIndex]->releaseEnable = EB_TRUE;
         resourcePtr->wrapperPtrPool[wrapperIndex]->systemResourcePtr = resourcePtr;
+        resourcePtr->wrapperPtrPool[wrapperIndex]->objectPtr = EB_NULL;
+        resourcePtr->wrapperPtrPool[wrapperIndex]->poolIndex = wrapperIndex;
 
-        // Call the Constructor for each element
-        if (ObjectCtor) {
+        // Call the Constructor for the first elements
+        if (ObjectCtor && wrapperIndex < builtCount) {
             return_error = ObjectCtor(
                 &resourcePtr->wrapperPtrPool[wrapperIndex]->objectPtr,
                 object_init_data_ptr);
@@ -479,15 +902,24 @@ EbErrorType EbSystemResourceCtor(
         &resourcePtr->emptyQueue,
         resourcePtr->objectTotalCount,
         producerProcessTotalCount,
-        producerFifoPtrArrayPtr);
+        producerFifoPtrArrayPtr,
+        resourcePtr->wrapperPtrPool);
     if (return_error == EB_ErrorInsufficientResources) {
         return EB_ErrorInsufficientResources;
     }
-    // Fill the Empty Fifo with every ObjectWrapper
-    for (wrapperIndex = 0; wrapperIndex < resourcePtr->objectTotalCount; ++wrapperIndex) {
+    // Fill the Empty Fifo with the built ObjectWrappers, the others are spares
+    resourcePtr->emptyQueue->spareWrapperArray = resourcePtr->wrapperPtrPool + builtCount;
+    resourcePtr->emptyQueue->spareWrapperCount = resourcePtr->objectTotalCount - builtCount;
+    for (wrapperIndex = 0; wrapperIndex < builtCount; ++wrapperIndex) {
+#if LOCK_FREE_FIFO
+        EbMuxingQueueObjectPost(
+            resourcePtr->emptyQueue,
+            resourcePtr->wrapperPtrPool[wrapperIndex]);
+#else
         EbMuxingQueueObjectPushBack(
             resourcePtr->emptyQueue,
             resourcePtr->wrapperPtrPool[wrapperIndex]);
+#endif
     }
 
     // Initialize the Full Queue
@@ -496,7 +928,8 @@ EbErrorType EbSystemResourceCtor(
             &resourcePtr->fullQueue,
             resourcePtr->objectTotalCount,
             consumerProcessTotalCount,
-            consumerFifoPtrArrayPtr);
+            consumerFifoPtrArrayPtr,
+            (EbObjectWrapper_t**)EB_NULL);
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -509,8 +942,80 @@ EbErrorType EbSystemResourceCtor(
     return return_error;
 }
 
+/**************************************
+ * EbMuxingQueueFlush
+ *   Empties the queue of an idle SystemResource. markReleased flags the
+ *   removed wrappers as released.
+ **************************************/
+static void EbMuxingQueueFlush(
+    EbMuxingQueue_t   *queuePtr,
+    EbBool             markReleased)
+{
+    EbObjectWrapper_t *wrapper_ptr;
+
+#if LOCK_FREE_FIFO
+    while (EbTryBlockOnSemaphore(queuePtr->countingSemaphore) == EB_TRUE) {
+        wrapper_ptr = EbMuxingQueuePop(queuePtr);
+        if (markReleased)
+            wrapper_ptr->liveCount = EB_ObjectWrapperReleasedValue;
+    }
+    EB_ATOMIC_STORE_RELEASE(&queuePtr->stats.objectCount, 0);
+#else
+    EbBlockOnMutex(queuePtr->lockoutMutex);
+    while (EbCircularBufferEmptyCheck(queuePtr->objectQueue) == EB_FALSE) {
+        EbCircularBufferPopFront(
+            queuePtr->objectQueue,
+            (EbPtr*)&wrapper_ptr);
+        if (markReleased)
+            wrapper_ptr->liveCount = EB_ObjectWrapperReleasedValue;
+    }
+    EB_ATOMIC_STORE_RELEASE(&queuePtr->stats.objectCount, 0);
+    EbReleaseMutex(queuePtr->lockoutMutex);
+#endif
+}
+
+/*********************************************************************
+ * EbSystemResourceReset
+ *********************************************************************/
+void EbSystemResourceReset(
+    EbSystemResource_t  *resourcePtr)
+{
+    uint32_t           wrapperIndex;
+    EbObjectWrapper_t *wrapper_ptr;
+
+    if (resourcePtr->fullQueue)
+        EbMuxingQueueFlush(resourcePtr->fullQueue, EB_FALSE);
+    EbMuxingQueueFlush(resourcePtr->emptyQueue, EB_TRUE);
+
+    for (wrapperIndex = 0; wrapperIndex < resourcePtr->objectTotalCount; ++wrapperIndex) {
+        wrapper_ptr = resourcePtr->wrapperPtrPool[wrapperIndex];
+
+        // Spare wrappers are not in any queue
+        if (resourcePtr->objectCtor && wrapper_ptr->objectPtr == EB_NULL)
+            continue;
+
+        if (wrapper_ptr->liveCount != EB_ObjectWrapperReleasedValue && resourcePtr->objectRelease)
+            resourcePtr->objectRelease(wrapper_ptr->objectPtr);
+
+        wrapper_ptr->liveCount = EB_ObjectWrapperReleasedValue;
+        wrapper_ptr->releaseEnable = EB_TRUE;
+#if LOCK_FREE_FIFO
+        EbMuxingQueueObjectPost(
+            resourcePtr->emptyQueue,
+            wrapper_ptr);
+#else
+        EbBlockOnMutex(resourcePtr->emptyQueue->lockoutMutex);
+        EbMuxingQueueObjectPushBack(
+            resourcePtr->emptyQueue,
+            wrapper_ptr);
+        EbReleaseMutex(resourcePtr->emptyQueue->lockoutMutex);
+#endif
+    }
+}
+
 
 
+#if !LOCK_FREE_FIFO
 /*********************************************************************
  * EbSystemResourceReleaseProcess
  *********************************************************************/
@@ -531,6 +1036,7 @@ static EbErrorType EbReleaseProcess(
 
     return return_error;
 }
+#endif
 
 /*********************************************************************
  * EbSystemResourcePostObject
@@ -551,6 +1057,13 @@ EbErrorType EbPostFullObject(
 {
     EbErrorType return_error = EB_ErrorNone;
 
+    EbQueueStatsPost(&objectPtr->systemResourcePtr->fullQueue->stats);
+
+#if LOCK_FREE_FIFO
+    EbMuxingQueueObjectPost(
+        objectPtr->systemResourcePtr->fullQueue,
+        objectPtr);
+#else
     EbBlockOnMutex(objectPtr->systemResourcePtr->fullQueue->lockoutMutex);
 
     EbMuxingQueueObjectPushBack(
@@ -558,6 +1071,7 @@ EbErrorType EbPostFullObject(
         objectPtr);
 
     EbReleaseMutex(objectPtr->systemResourcePtr->fullQueue->lockoutMutex);
+#endif
 
     return return_error;
 }
@@ -576,6 +1090,7 @@ EbErrorType EbReleaseObject(
     EbObjectWrapper_t   *objectPtr)
 {
     EbErrorType return_error = EB_ErrorNone;
+    EbBool      released = EB_FALSE;
 
     EbBlockOnMutex(objectPtr->systemResourcePtr->emptyQueue->lockoutMutex);
 
@@ -587,13 +1102,35 @@ EbErrorType EbReleaseObject(
         // Set liveCount to EB_ObjectWrapperReleasedValue
         objectPtr->liveCount = EB_ObjectWrapperReleasedValue;
 
+        released = EB_TRUE;
+    }
+
+    EbReleaseMutex(objectPtr->systemResourcePtr->emptyQueue->lockoutMutex);
+
+    if (released == EB_TRUE) {
+
+        if (objectPtr->systemResourcePtr->objectRelease)
+            objectPtr->systemResourcePtr->objectRelease(objectPtr->objectPtr);
+
+#if LOCK_FREE_FIFO
+        // The mutex only protects the wrapper state, the ring takes the object
+        EbMuxingQueueObjectPost(
+            objectPtr->systemResourcePtr->emptyQueue,
+            objectPtr);
+#else
+        EbBlockOnMutex(objectPtr->systemResourcePtr->emptyQueue->lockoutMutex);
+
         EbMuxingQueueObjectPushFront(
             objectPtr->systemResourcePtr->emptyQueue,
             objectPtr);
 
-    }
+        EbReleaseMutex(objectPtr->systemResourcePtr->emptyQueue->lockoutMutex);
+#endif
 
-    EbReleaseMutex(objectPtr->systemResourcePtr->emptyQueue->lockoutMutex);
+        // Only counted out once back in the empty queue
+        if (objectPtr->systemResourcePtr->inFlightCountPtr)
+            EB_ATOMIC_SUB(objectPtr->systemResourcePtr->inFlightCountPtr, 1);
+    }
 
     return return_error;
 }
@@ -619,11 +1156,46 @@ EbErrorType EbGetEmptyObject(
 {
     EbErrorType return_error = EB_ErrorNone;
 
+#if LOCK_FREE_FIFO
+    // The object is owned by the caller once out of the ring
+    // A free object first, then a spare one, then wait for a release
+    // Some processes hold a mutex over the wait, it stays an OS level wait
+    // Only the wait is timed, the stage is blocked on its output
+    *wrapperDblPtr = (EbObjectWrapper_t*)EB_NULL;
+    if (EbTryBlockOnSemaphore(emptyFifoPtr->queuePtr->countingSemaphore) == EB_TRUE)
+        *wrapperDblPtr = EbMuxingQueuePop(emptyFifoPtr->queuePtr);
+    else
+        *wrapperDblPtr = EbMuxingQueueSpareGet(emptyFifoPtr->queuePtr);
+    if (*wrapperDblPtr == (EbObjectWrapper_t*)EB_NULL) {
+        EbFifo_t *processFifoPtr = current_process_fifo_ptr;
+        uint64_t  waitStartTime = EbOutputWaitStart(processFifoPtr);
+        *wrapperDblPtr = EbMuxingQueueObjectGet(emptyFifoPtr->queuePtr, EB_FALSE);
+        EbOutputWaitEnd(processFifoPtr, waitStartTime);
+    }
+    (*wrapperDblPtr)->liveCount = 0;
+    (*wrapperDblPtr)->releaseEnable = EB_TRUE;
+#else
+    // A spare object when none is free, queued as if it had been released
+    if (emptyFifoPtr->firstPtr == (EbObjectWrapper_t*)EB_NULL &&
+        EbCircularBufferEmptyCheck(emptyFifoPtr->queuePtr->objectQueue) == EB_TRUE) {
+        EbObjectWrapper_t *sparePtr = EbMuxingQueueSpareGet(emptyFifoPtr->queuePtr);
+        if (sparePtr) {
+            EbBlockOnMutex(emptyFifoPtr->queuePtr->lockoutMutex);
+            EbMuxingQueueObjectPushFront(emptyFifoPtr->queuePtr, sparePtr);
+            EbReleaseMutex(emptyFifoPtr->queuePtr->lockoutMutex);
+        }
+    }
+
     // Queue the Fifo requesting the empty fifo
     EbReleaseProcess(emptyFifoPtr);
 
     // Block on the counting Semaphore until an empty buffer is available
-    EbBlockOnSemaphore(emptyFifoPtr->countingSemaphore);
+    if (EbTryBlockOnSemaphore(emptyFifoPtr->countingSemaphore) == EB_FALSE) {
+        EbFifo_t *processFifoPtr = current_process_fifo_ptr;
+        uint64_t  waitStartTime = EbOutputWaitStart(processFifoPtr);
+        EbBlockOnSemaphore(emptyFifoPtr->countingSemaphore);
+        EbOutputWaitEnd(processFifoPtr, waitStartTime);
+    }
 
     // Acquire lockout Mutex
     EbBlockOnMutex(emptyFifoPtr->lockoutMutex);
@@ -641,6 +1213,11 @@ EbErrorType EbGetEmptyObject(
 
     // Release Mutex
     EbReleaseMutex(emptyFifoPtr->lockoutMutex);
+#endif
+
+    // Counted in before the object can be posted
+    if ((*wrapperDblPtr)->systemResourcePtr->inFlightCountPtr)
+        EB_ATOMIC_ADD((*wrapperDblPtr)->systemResourcePtr->inFlightCountPtr, 1);
 
     return return_error;
 }
@@ -664,16 +1241,44 @@ EbErrorType EbGetFullObject(
     EbFifo_t   *fullFifoPtr,
     EbObjectWrapper_t **wrapperDblPtr)
 {
-    EbErrorType return_error = EB_ErrorNone;
+    EbErrorType     return_error = EB_ErrorNone;
+    EbQueueStats_t *statsPtr = &fullFifoPtr->queuePtr->stats;
+    uint64_t        waitStartTime = EbGetMonotonicTime();
+    uint64_t        busyStartTime;
+
+    // The process is done with its previous object
+    EB_ATOMIC_STORE64(&fullFifoPtr->waitStartTime, waitStartTime);
+    if (fullFifoPtr->busyStartTime) {
+        EB_ATOMIC_ADD64(&statsPtr->busyTime, waitStartTime - fullFifoPtr->busyStartTime);
+        EB_ATOMIC_STORE64(&fullFifoPtr->busyStartTime, 0);
+    }
+
+#if LOCK_FREE_FIFO
+    *wrapperDblPtr = EbMuxingQueueObjectGet(fullFifoPtr->queuePtr, EB_TRUE);
+#else
+    EbTask_t *taskPtr = eb_task_self();
 
     // Queue the Fifo requesting the full fifo
     EbReleaseProcess(fullFifoPtr);
 
-    // Block on the counting Semaphore until an empty buffer is available
-    EbBlockOnSemaphore(fullFifoPtr->countingSemaphore);
+    if (taskPtr == (EbTask_t*)EB_NULL) {
+        // Block on the counting Semaphore until an empty buffer is available
+        EbBlockOnSemaphore(fullFifoPtr->countingSemaphore);
 
-    // Acquire lockout Mutex
-    EbBlockOnMutex(fullFifoPtr->lockoutMutex);
+        // Acquire lockout Mutex
+        EbBlockOnMutex(fullFifoPtr->lockoutMutex);
+    }
+    else {
+        // Thread pool tasks park until the fifo is filled, the worker is
+        // left to the other tasks meanwhile
+        EbBlockOnMutex(fullFifoPtr->lockoutMutex);
+        fullFifoPtr->taskPtr = taskPtr;
+        while (fullFifoPtr->firstPtr == (EbObjectWrapper_t*)EB_NULL) {
+            fullFifoPtr->taskWaiting = EB_TRUE;
+            eb_task_park(taskPtr, fullFifoPtr->lockoutMutex);
+            EbBlockOnMutex(fullFifoPtr->lockoutMutex);
+        }
+    }
 
     EbFifoPopFront(
         fullFifoPtr,
@@ -681,10 +1286,20 @@ EbErrorType EbGetFullObject(
 
     // Release Mutex
     EbReleaseMutex(fullFifoPtr->lockoutMutex);
+#endif
+
+    busyStartTime = EbGetMonotonicTime();
+    EB_ATOMIC_SUB(&statsPtr->objectCount, 1);
+    EB_ATOMIC_ADD64(&statsPtr->getCount, 1);
+    EB_ATOMIC_ADD64(&statsPtr->inputWaitTime, busyStartTime - waitStartTime);
+    EB_ATOMIC_STORE64(&fullFifoPtr->waitStartTime, 0);
+    EB_ATOMIC_STORE64(&fullFifoPtr->busyStartTime, busyStartTime);
+    current_process_fifo_ptr = fullFifoPtr;
 
     return return_error;
 }
 
+#if !LOCK_FREE_FIFO
 /**************************************
 * EbFifoPopFront
 **************************************/
@@ -700,6 +1315,7 @@ static EbBool EbFifoPeakFront(
         return EB_FALSE;
     }
 }
+#endif
 
 
 EbErrorType EbGetFullObjectNonBlocking(
@@ -707,6 +1323,14 @@ EbErrorType EbGetFullObjectNonBlocking(
     EbObjectWrapper_t **wrapperDblPtr)
 {
     EbErrorType return_error = EB_ErrorNone;
+#if LOCK_FREE_FIFO
+    if (EbTryBlockOnSemaphore(fullFifoPtr->queuePtr->countingSemaphore) == EB_TRUE) {
+        *wrapperDblPtr = EbRingPopFront(&fullFifoPtr->queuePtr->ring);
+        EB_ATOMIC_SUB(&fullFifoPtr->queuePtr->stats.objectCount, 1);
+    }
+    else
+        *wrapperDblPtr = (EbObjectWrapper_t*)EB_NULL;
+#else
     EbBool      fifoEmpty;
     // Queue the Fifo requesting the full fifo
     EbReleaseProcess(fullFifoPtr);
@@ -726,6 +1350,92 @@ EbErrorType EbGetFullObjectNonBlocking(
             wrapperDblPtr);
     else
         *wrapperDblPtr = (EbObjectWrapper_t*)EB_NULL;
+#endif
 
     return return_error;
-}
\ No newline at end of file
+}
+/*********************************************************************
+ * EbGetFullObjectTimeout
+ *   Dequeues a full EbObjectWrapper, waiting at most timeout
+ *   milliseconds for one. wrapperDblPtr is set to NULL on timeout. Like
+ *   EbGetFullObjectNonBlocking, meant for a fifo with a single consumer.
+ *********************************************************************/
+EbErrorType EbGetFullObjectTimeout(
+    EbFifo_t            *fullFifoPtr,
+    EbObjectWrapper_t  **wrapperDblPtr,
+    uint32_t             timeout)
+{
+    EbErrorType return_error = EB_ErrorNone;
+#if LOCK_FREE_FIFO
+    if (EbBlockOnSemaphoreTimeout(fullFifoPtr->queuePtr->countingSemaphore, timeout) == EB_ErrorNone)
+        *wrapperDblPtr = EbRingPopFront(&fullFifoPtr->queuePtr->ring);
+    else
+        *wrapperDblPtr = (EbObjectWrapper_t*)EB_NULL;
+#else
+    // Queue the Fifo requesting the full fifo
+    EbReleaseProcess(fullFifoPtr);
+
+    if (EbBlockOnSemaphoreTimeout(fullFifoPtr->countingSemaphore, timeout) == EB_ErrorNone) {
+        EbBlockOnMutex(fullFifoPtr->lockoutMutex);
+
+        EbFifoPopFront(
+            fullFifoPtr,
+            wrapperDblPtr);
+
+        EbReleaseMutex(fullFifoPtr->lockoutMutex);
+    }
+    else
+        *wrapperDblPtr = (EbObjectWrapper_t*)EB_NULL;
+#endif
+    if (*wrapperDblPtr)
+        EB_ATOMIC_SUB(&fullFifoPtr->queuePtr->stats.objectCount, 1);
+
+    return return_error;
+}
+
+/*********************************************************************
+ * EbSystemResourceGetStats
+ *********************************************************************/
+void EbSystemResourceGetStats(
+    EbSystemResource_t  *resourcePtr,
+    EbQueueStats_t      *statsPtr,
+    uint32_t            *processCount)
+{
+    EbMuxingQueue_t *queuePtr = resourcePtr->fullQueue;
+    uint64_t         now = EbGetMonotonicTime();
+    uint64_t         startTime;
+    uint32_t         processIndex;
+
+    EB_MEMSET(statsPtr, 0, sizeof(EbQueueStats_t));
+    *processCount = 0;
+    if (queuePtr == (EbMuxingQueue_t*)EB_NULL)
+        return;
+
+    *processCount = queuePtr->processTotalCount;
+    statsPtr->objectCount = EB_ATOMIC_LOAD_ACQUIRE(&queuePtr->stats.objectCount);
+    statsPtr->objectCountMax = EB_ATOMIC_LOAD_ACQUIRE(&queuePtr->stats.objectCountMax);
+    statsPtr->objectCountSum = EB_ATOMIC_LOAD64(&queuePtr->stats.objectCountSum);
+    statsPtr->postCount = EB_ATOMIC_LOAD64(&queuePtr->stats.postCount);
+    statsPtr->getCount = EB_ATOMIC_LOAD64(&queuePtr->stats.getCount);
+    statsPtr->busyTime = EB_ATOMIC_LOAD64(&queuePtr->stats.busyTime);
+    statsPtr->inputWaitTime = EB_ATOMIC_LOAD64(&queuePtr->stats.inputWaitTime);
+    statsPtr->outputWaitTime = EB_ATOMIC_LOAD64(&queuePtr->stats.outputWaitTime);
+
+    // An object taken while flushing the queue
+    if ((int32_t)statsPtr->objectCount < 0)
+        statsPtr->objectCount = 0;
+
+    // The intervals in progress, so that a long wait is spread over the reads
+    for (processIndex = 0; processIndex < queuePtr->processTotalCount; ++processIndex) {
+        EbFifo_t *fifoPtr = queuePtr->processFifoPtrArray[processIndex];
+        startTime = EB_ATOMIC_LOAD64(&fifoPtr->waitStartTime);
+        if (startTime && startTime < now)
+            statsPtr->inputWaitTime += now - startTime;
+        startTime = EB_ATOMIC_LOAD64(&fifoPtr->busyStartTime);
+        if (startTime && startTime < now)
+            statsPtr->busyTime += now - startTime;
+        startTime = EB_ATOMIC_LOAD64(&fifoPtr->outputWaitStartTime);
+        if (startTime && startTime < now)
+            statsPtr->outputWaitTime += now - startTime;
+    }
+}
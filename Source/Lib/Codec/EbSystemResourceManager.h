@@ -44,8 +44,39 @@ extern "C" {
         //   only in the implemenation of a single-linked Fifo.
         struct EbObjectWrapper_s *nextPtr;
 
+        // poolIndex - index of the wrapper in the wrapperPtrPool of its
+        //   SystemResource.
+        uint32_t                  poolIndex;
+
     } EbObjectWrapper_t;
 
+    /*********************************************************************
+     * QueueStats
+     *   Counters of a full queue, profiling the stage consuming it. Times
+     *   are in microseconds and summed over the processes of the stage.
+     *   The counters are updated atomically and never reset.
+     *********************************************************************/
+    typedef struct EbQueueStats_s {
+        // objectCount - objects in the queue. objectCountMax and
+        //   objectCountSum (taken on each post) give its peak and mean.
+        uint32_t            objectCount;
+        uint32_t            objectCountMax;
+        uint64_t            objectCountSum;
+        uint64_t            postCount;
+        uint64_t            getCount;
+
+        // busyTime - from an object taken to the next get of the process
+        uint64_t            busyTime;
+
+        // inputWaitTime - processes blocked on the queue
+        uint64_t            inputWaitTime;
+
+        // outputWaitTime - processes blocked on an empty object, after
+        //   taking an object from the queue. Part of busyTime.
+        uint64_t            outputWaitTime;
+
+    } EbQueueStats_t;
+
     /*********************************************************************
      * Fifo
      *   Defines a static (i.e. no dynamic memory allocation) single
@@ -74,6 +105,23 @@ extern "C" {
         //   associated with.
         struct EbMuxingQueue_s *queuePtr;
 
+        // taskPtr - thread pool task consuming the EbFifo. Set on the
+        //   first wait of the task, the countingSemaphore is no longer
+        //   posted from then on and the task parks on an empty EbFifo.
+        struct EbTask_s *taskPtr;
+
+        // taskWaiting - the task is parked until an object is pushed.
+        EbBool taskWaiting;
+
+        // busyStartTime - when the process took its last full object,
+        //   waitStartTime - when it started waiting for the next one,
+        //   outputWaitStartTime - when it started waiting for an empty
+        //   object. 0 out of these states. Read by EbSystemResourceGetStats
+        //   to count the intervals in progress.
+        uint64_t busyStartTime;
+        uint64_t waitStartTime;
+        uint64_t outputWaitStartTime;
+
     } EbFifo_t;
 
     /*********************************************************************
@@ -88,16 +136,83 @@ extern "C" {
 
     } EbCircularBuffer_t;
 
+#if LOCK_FREE_FIFO
+    /*********************************************************************
+     * Ring
+     *   Bounded multi-producer multi-consumer queue of EbObjectWrappers.
+     *   The sequence of a cell tells whether it is ready to be written or
+     *   read at a given position, so producers and consumers only contend
+     *   on the atomic position counters, kept on separate cache lines.
+     *********************************************************************/
+    typedef struct EbRingCell_s {
+        uint32_t            sequence;
+        EbObjectWrapper_t  *wrapperPtr;
+    } EbRingCell_t;
+
+    typedef struct EbRing_s {
+        EbRingCell_t       *cellArray;
+        uint32_t            mask;
+        uint8_t             pad0[EB_CACHE_LINE_SIZE];
+        uint32_t            enqueuePos;
+        uint8_t             pad1[EB_CACHE_LINE_SIZE];
+        uint32_t            dequeuePos;
+        uint8_t             pad2[EB_CACHE_LINE_SIZE];
+    } EbRing_t;
+
+    /*********************************************************************
+     * Stack
+     *   Multi-producer multi-consumer stack of the EbObjectWrappers of a
+     *   SystemResource, linked by their poolIndex. The head holds the
+     *   poolIndex + 1 of the top wrapper (0 when empty) in its low 32 bits
+     *   and a count of the pushes in its high 32 bits, so that a pop racing
+     *   with a pop and a push of the same wrapper fails its compare-and-swap.
+     *********************************************************************/
+    typedef struct EbStack_s {
+        EbObjectWrapper_t **wrapperArray;
+        uint32_t           *nextArray;          // poolIndex + 1 of the wrapper below
+        uint8_t             pad0[EB_CACHE_LINE_SIZE];
+        uint64_t            head;
+        uint8_t             pad1[EB_CACHE_LINE_SIZE];
+    } EbStack_t;
+#endif
+
     /*********************************************************************
      * MuxingQueue
      *********************************************************************/
     typedef struct EbMuxingQueue_s {
         EbHandle           lockoutMutex;
+#if LOCK_FREE_FIFO
+        // ring - the objects of the queue, handed to any requesting process.
+        //   stack - used instead by the empty queues, the object released
+        //   last, still in the caches, is handed out first.
+        EbRing_t            ring;
+        EbStack_t           stack;
+
+        // countingSemaphore - counts the objects of the ring. Processes
+        //   spin on it before blocking. lockoutMutex protects the
+        //   EbObjectWrapper states and the parked tasks.
+        EbHandle            countingSemaphore;
+
+        // taskWaiterArray - thread pool tasks parked until an object is
+        //   posted, at most one per process.
+        struct EbTask_s   **taskWaiterArray;
+        uint32_t            taskWaiterCount;
+#else
         EbCircularBuffer_t *objectQueue;
         EbCircularBuffer_t *processQueue;
+#endif
         uint32_t              processTotalCount;
         EbFifo_t          **processFifoPtrArray;
 
+        // spareWrapperArray - wrappers whose object is not built yet. One
+        //   is built and handed out when the queue runs dry, up to the
+        //   objectTotalCount of the SystemResource. Protected by lockoutMutex.
+        EbObjectWrapper_t **spareWrapperArray;
+        uint32_t            spareWrapperCount;
+
+        // stats - profiling counters of the full queue
+        EbQueueStats_t      stats;
+
     } EbMuxingQueue_t;
 
     /*********************************************************************
@@ -126,6 +241,23 @@ extern "C" {
         //EbFifo_t           *fullFifo;
         EbMuxingQueue_t     *fullQueue;
 
+        // objectRelease - optional hook called on each object released by
+        //   EbReleaseObject, before it returns to the empty queue. Called
+        //   without any lock held.
+        EB_RELEASE           objectRelease;
+
+        // objectCtor, objectInitDataPtr - used to build the spare objects on
+        //   first demand. memoryContextPtr is the context they are
+        //   registered in, whichever thread builds them.
+        EB_CTOR              objectCtor;
+        EbPtr                objectInitDataPtr;
+        EbMemoryContext     *memoryContextPtr;
+
+        // inFlightCountPtr - optional count shared by several resources, of
+        //   their objects taken from the empty queue and not yet released.
+        //   Updated atomically, NULL when not shared.
+        uint32_t             *inFlightCountPtr;
+
     } EbSystemResource_t;
 
     /*********************************************************************
@@ -203,12 +335,19 @@ extern "C" {
      *   ObjectCtor
      *     Function pointer to the constructor of the object managed by
      *     SystemResource referenced by resourcePtr. No object level
-     *     construction is performed if ObjectCtor is NULL.
+     *     construction is performed if ObjectCtor is NULL. Only the first
+     *     object is constructed here, the others are constructed by
+     *     EbGetEmptyObject when no constructed object is free.
      *
      *   object_init_data_ptr
      *     Pointer to data block to be used during the construction of
      *     the object. object_init_data_ptr is passed to ObjectCtor when
      *     ObjectCtor is called.
+     *
+     *   objectInitDataSize
+     *     Size of the data block, which is copied for the later
+     *     constructions. 0 keeps object_init_data_ptr itself, which must
+     *     then outlive the SystemResource.
      *********************************************************************/
     extern EbErrorType EbSystemResourceCtor(
         EbSystemResource_t **resourceDblPtr,
@@ -219,7 +358,8 @@ extern "C" {
         EbFifo_t          ***consumerFifoPtrArrayPtr,
         EbBool              fullFifoEnabled,
         EB_CTOR              ObjectCtor,
-        EbPtr               object_init_data_ptr);
+        EbPtr               object_init_data_ptr,
+        uint32_t              objectInitDataSize);
 
     /*********************************************************************
      * EbSystemResourceDtor
@@ -239,13 +379,47 @@ extern "C" {
         EbSystemResource_t  *resourcePtr,
         EB_DTOR              ObjectDtor);
 
+    /*********************************************************************
+     * EbSystemResourceReset
+     *   Returns every constructed object to the empty queue, whoever holds
+     *   it, and empties the full queue. The objectRelease hook is called
+     *   on the objects that were not released. Only valid while no
+     *   process uses the SystemResource.
+     *
+     *   resourcePtr
+     *     Pointer to the SystemResource to be reset.
+     *********************************************************************/
+    extern void EbSystemResourceReset(
+        EbSystemResource_t  *resourcePtr);
+
+    /*********************************************************************
+     * EbSystemResourceGetStats
+     *   Reads the profiling counters of the stage consuming the full queue
+     *   of a SystemResource. The counters are zero without a full queue.
+     *
+     *   resourcePtr
+     *     Pointer to the SystemResource.
+     *
+     *   statsPtr
+     *     Filled with the counters.
+     *
+     *   processCount
+     *     Filled with the number of processes consuming the full queue.
+     *********************************************************************/
+    extern void EbSystemResourceGetStats(
+        EbSystemResource_t  *resourcePtr,
+        EbQueueStats_t      *statsPtr,
+        uint32_t            *processCount);
+
     /*********************************************************************
      * EbSystemResourceGetEmptyObject
      *   Dequeues an empty EbObjectWrapper from the SystemResource.  The
      *   new EbObjectWrapper will be populated with the contents of the
-     *   wrapperCopyPtr if wrapperCopyPtr is not NULL. This function blocks
-     *   on the SystemResource emptyFifo countingSemaphore. This function
-     *   is write protected by the SystemResource emptyFifo lockoutMutex.
+     *   wrapperCopyPtr if wrapperCopyPtr is not NULL. When no object is
+     *   free, the next spare object is constructed; once all are, this
+     *   function blocks on the SystemResource emptyFifo countingSemaphore.
+     *   This function is write protected by the SystemResource emptyFifo
+     *   lockoutMutex.
      *
      *   resourcePtr
      *      Pointer to the SystemResource that provides the empty
@@ -295,6 +469,11 @@ extern "C" {
         EbFifo_t   *fullFifoPtr,
         EbObjectWrapper_t **wrapperDblPtr);
 
+    extern EbErrorType EbGetFullObjectTimeout(
+        EbFifo_t            *fullFifoPtr,
+        EbObjectWrapper_t  **wrapperDblPtr,
+        uint32_t             timeout);
+
     extern EbErrorType EbGetFullObjectNonBlocking(
         EbFifo_t   *fullFifoPtr,
         EbObjectWrapper_t **wrapperDblPtr);
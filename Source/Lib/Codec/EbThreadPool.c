@@ -0,0 +1,706 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// Summary:
+// EbThreadPool runs the encoder kernels as tasks on a set of worker
+// threads shared by every encoder instance of the process. A task is a
+// kernel running on its own stack (a fiber on Windows, a ucontext
+// elsewhere), so the kernels keep their blocking EbGetFullObject loop:
+// the wait switches the task out instead of blocking its worker.
+
+#if defined(__APPLE__)
+#define _XOPEN_SOURCE 600
+#endif
+
+/****************************************
+ * Universal Includes
+ ****************************************/
+#include <stdlib.h>
+#include "EbThreadPool.h"
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__) || defined(__APPLE__)
+#include <limits.h>
+#include <pthread.h>
+#include <ucontext.h>
+#else
+#error OS/Platform not supported.
+#endif // _WIN32
+
+#define EB_THREAD_POOL_MAX_WORKER_COUNT 1024
+#define EB_THREAD_POOL_MAX_TASK_COUNT   (1 << 20)   // bound of the cancelSemaphore posts
+#define EB_TASK_DEFAULT_STACK_SIZE      (8 << 20)   // when the default thread stack size is not available
+
+typedef enum EbTaskState {
+    EB_TASK_RUNNABLE  = 0,                  // on a worker deque
+    EB_TASK_RUNNING   = 1,
+    EB_TASK_PARKED    = 2,                  // waiting on a fifo
+    EB_TASK_DONE      = 3,                  // the task function returned
+    EB_TASK_CANCELLED = 4                   // stopped for good, see eb_thread_pool_cancel_tasks
+} EbTaskState;
+
+struct EbTask_s {
+    void                    *(*taskFunction)(void *);
+    void                    *taskContext;
+    EbThreadPool_t          *poolPtr;
+    EbMemoryContext         *memoryContextPtr;  // memory context of the creating encoder instance
+    struct EbWorker_s       *workerPtr;         // worker currently running the task
+    EbHandle                 parkMutex;         // released by the worker once the task is switched out
+    EbHandle                 blockingSemaphore; // semaphore of the OS level wait of the task
+    EbTaskState              state;             // pool mutex
+    EbBool                   cancelled;         // pool mutex
+    struct EbTask_s         *prevPtr;           // worker deque links
+    struct EbTask_s         *nextPtr;
+    struct EbTask_s         *listPrevPtr;       // links of the tasks of the pool
+    struct EbTask_s         *listNextPtr;
+#ifdef _WIN32
+    LPVOID                   fiber;
+#else
+    ucontext_t               context;
+    void                    *stackPtr;
+#endif
+};
+
+typedef struct EbWorker_s {
+    EbThreadPool_t          *poolPtr;
+    EbHandle                 threadHandle;
+    EbHandle                 dequeMutex;
+    EbTask_t                *headPtr;           // oldest task, stolen by the other workers
+    EbTask_t                *tailPtr;           // newest task, run next by the owner
+#ifdef _WIN32
+    LPVOID                   fiber;
+#else
+    ucontext_t               context;
+#endif
+} EbWorker_t;
+
+struct EbThreadPool_s {
+    // mutex - protects the counters below
+    EbHandle                 mutex;
+    EbHandle                 wakeSemaphore;
+    uint32_t                 referenceCount;
+    // targetCount - number of workers allowed to run tasks at once. More
+    //   workers are spawned while some are blocked in an OS level wait.
+    uint32_t                 targetCount;
+    int32_t                  runningCount;      // workers neither sleeping nor blocked
+    uint32_t                 sleepingCount;
+    int32_t                  queuedCount;       // tasks on the worker deques
+    uint32_t                 nextWorker;        // deque receiving the tasks scheduled from outside the pool
+    EbBool                   shutdown;
+    volatile uint32_t        workerCount;
+    EbWorker_t              *workerPtrArray[EB_THREAD_POOL_MAX_WORKER_COUNT];
+    EbTask_t                *taskListPtr;       // every task of the pool
+    // cancelMutex - serializes eb_thread_pool_cancel_tasks, which waits on
+    //   cancelSemaphore for its tasks to be switched out
+    EbHandle                 cancelMutex;
+    EbHandle                 cancelSemaphore;
+    size_t                   taskStackSize;
+};
+
+static EB_THREAD_LOCAL EbWorker_t *current_worker_ptr = (EbWorker_t*)EB_NULL;
+static EB_THREAD_LOCAL EbTask_t   *current_task_ptr = (EbTask_t*)EB_NULL;
+
+static EbThreadPool_t *process_pool_ptr = (EbThreadPool_t*)EB_NULL;
+#ifdef _WIN32
+static SRWLOCK process_pool_lock = SRWLOCK_INIT;
+#define EB_LOCK_PROCESS_POOL()      AcquireSRWLockExclusive(&process_pool_lock)
+#define EB_UNLOCK_PROCESS_POOL()    ReleaseSRWLockExclusive(&process_pool_lock)
+#else
+static pthread_mutex_t process_pool_lock = PTHREAD_MUTEX_INITIALIZER;
+#define EB_LOCK_PROCESS_POOL()      pthread_mutex_lock(&process_pool_lock)
+#define EB_UNLOCK_PROCESS_POOL()    pthread_mutex_unlock(&process_pool_lock)
+#endif
+
+/**************************************
+ * Worker deque
+ **************************************/
+static void eb_deque_push_tail(
+    EbWorker_t *workerPtr,
+    EbTask_t   *taskPtr)
+{
+    EbBlockOnMutex(workerPtr->dequeMutex);
+    taskPtr->nextPtr = (EbTask_t*)EB_NULL;
+    taskPtr->prevPtr = workerPtr->tailPtr;
+    if (workerPtr->tailPtr)
+        workerPtr->tailPtr->nextPtr = taskPtr;
+    else
+        workerPtr->headPtr = taskPtr;
+    workerPtr->tailPtr = taskPtr;
+    EbReleaseMutex(workerPtr->dequeMutex);
+}
+
+static EbTask_t* eb_deque_pop(
+    EbWorker_t *workerPtr,
+    EbBool      fromTail)
+{
+    EbTask_t *taskPtr;
+
+    EbBlockOnMutex(workerPtr->dequeMutex);
+    taskPtr = fromTail ? workerPtr->tailPtr : workerPtr->headPtr;
+    if (taskPtr) {
+        if (taskPtr->prevPtr)
+            taskPtr->prevPtr->nextPtr = taskPtr->nextPtr;
+        else
+            workerPtr->headPtr = taskPtr->nextPtr;
+        if (taskPtr->nextPtr)
+            taskPtr->nextPtr->prevPtr = taskPtr->prevPtr;
+        else
+            workerPtr->tailPtr = taskPtr->prevPtr;
+        taskPtr->prevPtr = taskPtr->nextPtr = (EbTask_t*)EB_NULL;
+    }
+    EbReleaseMutex(workerPtr->dequeMutex);
+
+    return taskPtr;
+}
+
+/**************************************
+ * Workers
+ **************************************/
+static void* eb_worker_kernel(void *input_ptr);
+
+// Spawns a worker, called with the pool mutex held
+static EbErrorType eb_thread_pool_add_worker(
+    EbThreadPool_t *poolPtr)
+{
+    EbWorker_t *workerPtr;
+
+    if (poolPtr->workerCount == EB_THREAD_POOL_MAX_WORKER_COUNT)
+        return EB_ErrorInsufficientResources;
+
+    workerPtr = (EbWorker_t*)calloc(1, sizeof(EbWorker_t));
+    if (workerPtr == (EbWorker_t*)EB_NULL)
+        return EB_ErrorInsufficientResources;
+    workerPtr->poolPtr = poolPtr;
+    workerPtr->dequeMutex = EbCreateMutex();
+    if (workerPtr->dequeMutex == (EbHandle)EB_NULL) {
+        free(workerPtr);
+        return EB_ErrorInsufficientResources;
+    }
+
+    // Publish the deque before the thread starts stealing from the others
+    poolPtr->workerPtrArray[poolPtr->workerCount] = workerPtr;
+    workerPtr->threadHandle = EbCreateThread(eb_worker_kernel, workerPtr);
+    if (workerPtr->threadHandle == (EbHandle)EB_NULL) {
+        poolPtr->workerPtrArray[poolPtr->workerCount] = (EbWorker_t*)EB_NULL;
+        EbDestroyMutex(workerPtr->dequeMutex);
+        free(workerPtr);
+        return EB_ErrorInsufficientResources;
+    }
+    poolPtr->workerCount++;
+    poolPtr->runningCount++;
+
+    return EB_ErrorNone;
+}
+
+// Wakes or spawns a worker when tasks are queued and fewer workers than
+// the target are running. Called with the pool mutex held.
+static void eb_thread_pool_balance(
+    EbThreadPool_t *poolPtr)
+{
+    if (poolPtr->queuedCount <= 0 || poolPtr->runningCount >= (int32_t)poolPtr->targetCount)
+        return;
+
+    if (poolPtr->sleepingCount) {
+        poolPtr->sleepingCount--;
+        poolPtr->runningCount++;
+        EbPostSemaphore(poolPtr->wakeSemaphore);
+    }
+    else
+        eb_thread_pool_add_worker(poolPtr);
+}
+
+// Own deque newest first, then the oldest task of the other workers
+static EbTask_t* eb_worker_find_task(
+    EbWorker_t *workerPtr)
+{
+    EbThreadPool_t *poolPtr = workerPtr->poolPtr;
+    EbTask_t       *taskPtr = eb_deque_pop(workerPtr, EB_TRUE);
+    uint32_t        workerCount = poolPtr->workerCount;
+    uint32_t        workerIndex;
+
+    for (workerIndex = 0; taskPtr == (EbTask_t*)EB_NULL && workerIndex < workerCount; ++workerIndex) {
+        EbWorker_t *victimPtr = poolPtr->workerPtrArray[workerIndex];
+        if (victimPtr != workerPtr && victimPtr->headPtr)
+            taskPtr = eb_deque_pop(victimPtr, EB_FALSE);
+    }
+
+    return taskPtr;
+}
+
+// Returns the next task to run, NULL once the pool shuts down
+static EbTask_t* eb_worker_next_task(
+    EbWorker_t *workerPtr)
+{
+    EbThreadPool_t *poolPtr = workerPtr->poolPtr;
+
+    for (;;) {
+        EbTask_t *taskPtr = eb_worker_find_task(workerPtr);
+
+        EbBlockOnMutex(poolPtr->mutex);
+        if (taskPtr) {
+            poolPtr->queuedCount--;
+            // Cancelled between the pop and now
+            if (taskPtr->cancelled) {
+                taskPtr->state = EB_TASK_CANCELLED;
+                EbPostSemaphore(poolPtr->cancelSemaphore);
+                EbReleaseMutex(poolPtr->mutex);
+                continue;
+            }
+            taskPtr->state = EB_TASK_RUNNING;
+            EbReleaseMutex(poolPtr->mutex);
+            return taskPtr;
+        }
+        if (poolPtr->shutdown) {
+            EbReleaseMutex(poolPtr->mutex);
+            return (EbTask_t*)EB_NULL;
+        }
+        if (poolPtr->queuedCount > 0) {
+            // A task was queued after the search started
+            EbReleaseMutex(poolPtr->mutex);
+            continue;
+        }
+        poolPtr->runningCount--;
+        poolPtr->sleepingCount++;
+        EbReleaseMutex(poolPtr->mutex);
+
+        EbBlockOnSemaphore(poolPtr->wakeSemaphore);
+    }
+}
+
+static void eb_worker_run_task(
+    EbWorker_t *workerPtr,
+    EbTask_t   *taskPtr)
+{
+    EbThreadPool_t *poolPtr = workerPtr->poolPtr;
+    EbHandle        parkMutex;
+
+    taskPtr->workerPtr = workerPtr;
+    current_task_ptr = taskPtr;
+    eb_set_memory_context(taskPtr->memoryContextPtr);
+
+#ifdef _WIN32
+    SwitchToFiber(taskPtr->fiber);
+#else
+    swapcontext(&workerPtr->context, &taskPtr->context);
+#endif
+
+    current_task_ptr = (EbTask_t*)EB_NULL;
+    eb_set_memory_context((EbMemoryContext*)EB_NULL);
+
+    // The task parked itself on a fifo, or was cancelled
+    parkMutex = taskPtr->parkMutex;
+    taskPtr->parkMutex = (EbHandle)EB_NULL;
+    EbBlockOnMutex(poolPtr->mutex);
+    if (taskPtr->cancelled) {
+        taskPtr->state = EB_TASK_CANCELLED;
+        EbPostSemaphore(poolPtr->cancelSemaphore);
+    }
+    else if (parkMutex)
+        taskPtr->state = EB_TASK_PARKED;
+    EbReleaseMutex(poolPtr->mutex);
+    if (parkMutex)
+        EbReleaseMutex(parkMutex);
+}
+
+static void* eb_worker_kernel(void *input_ptr)
+{
+    EbWorker_t     *workerPtr = (EbWorker_t*)input_ptr;
+    EbThreadPool_t *poolPtr = workerPtr->poolPtr;
+    EbTask_t       *taskPtr;
+
+    current_worker_ptr = workerPtr;
+#ifdef _WIN32
+    workerPtr->fiber = ConvertThreadToFiber(NULL);
+#endif
+
+    while ((taskPtr = eb_worker_next_task(workerPtr)) != (EbTask_t*)EB_NULL) {
+        eb_worker_run_task(workerPtr, taskPtr);
+
+        // Give the worker up when more workers than the target are running,
+        // e.g. after the OS level wait of a task returned
+        EbBlockOnMutex(poolPtr->mutex);
+        if (poolPtr->runningCount > (int32_t)poolPtr->targetCount && !poolPtr->shutdown) {
+            poolPtr->runningCount--;
+            poolPtr->sleepingCount++;
+            EbReleaseMutex(poolPtr->mutex);
+            EbBlockOnSemaphore(poolPtr->wakeSemaphore);
+        }
+        else
+            EbReleaseMutex(poolPtr->mutex);
+    }
+
+#ifdef _WIN32
+    ConvertFiberToThread();
+#endif
+    current_worker_ptr = (EbWorker_t*)EB_NULL;
+    return EB_NULL;
+}
+
+/**************************************
+ * Thread Pool
+ **************************************/
+// Stack size of the threads created with the default attributes, the one
+// the kernels get when they run on dedicated threads. 0 on Windows, where
+// CreateFiber then uses the stack size of the executable as CreateThread.
+static size_t eb_thread_stack_size(void)
+{
+    size_t stackSize = 0;
+#ifndef _WIN32
+    pthread_attr_t attr;
+
+    if (pthread_attr_init(&attr) == 0) {
+        if (pthread_attr_getstacksize(&attr, &stackSize))
+            stackSize = 0;
+        pthread_attr_destroy(&attr);
+    }
+    if (stackSize < PTHREAD_STACK_MIN)
+        stackSize = EB_TASK_DEFAULT_STACK_SIZE;
+#endif
+    return stackSize;
+}
+
+static void eb_thread_pool_free(
+    EbThreadPool_t *poolPtr)
+{
+    if (poolPtr->cancelSemaphore)
+        EbDestroySemaphore(poolPtr->cancelSemaphore);
+    if (poolPtr->cancelMutex)
+        EbDestroyMutex(poolPtr->cancelMutex);
+    if (poolPtr->wakeSemaphore)
+        EbDestroySemaphore(poolPtr->wakeSemaphore);
+    if (poolPtr->mutex)
+        EbDestroyMutex(poolPtr->mutex);
+    free(poolPtr);
+}
+
+EbThreadPool_t* eb_thread_pool_acquire(
+    uint32_t workerCount)
+{
+    EbThreadPool_t *poolPtr;
+    uint32_t        workerIndex;
+
+    EB_LOCK_PROCESS_POOL();
+    if (process_pool_ptr == (EbThreadPool_t*)EB_NULL) {
+        poolPtr = (EbThreadPool_t*)calloc(1, sizeof(EbThreadPool_t));
+        if (poolPtr == (EbThreadPool_t*)EB_NULL) {
+            EB_UNLOCK_PROCESS_POOL();
+            return (EbThreadPool_t*)EB_NULL;
+        }
+        poolPtr->mutex = EbCreateMutex();
+        poolPtr->wakeSemaphore = EbCreateSemaphore(0, EB_THREAD_POOL_MAX_WORKER_COUNT);
+        poolPtr->cancelMutex = EbCreateMutex();
+        poolPtr->cancelSemaphore = EbCreateSemaphore(0, EB_THREAD_POOL_MAX_TASK_COUNT);
+        poolPtr->targetCount = (workerCount == 0) ? 1 : (workerCount > EB_THREAD_POOL_MAX_WORKER_COUNT) ? EB_THREAD_POOL_MAX_WORKER_COUNT : workerCount;
+        poolPtr->taskStackSize = eb_thread_stack_size();
+        if (poolPtr->mutex == (EbHandle)EB_NULL || poolPtr->wakeSemaphore == (EbHandle)EB_NULL ||
+            poolPtr->cancelMutex == (EbHandle)EB_NULL || poolPtr->cancelSemaphore == (EbHandle)EB_NULL) {
+            eb_thread_pool_free(poolPtr);
+            EB_UNLOCK_PROCESS_POOL();
+            return (EbThreadPool_t*)EB_NULL;
+        }
+
+        EbBlockOnMutex(poolPtr->mutex);
+        for (workerIndex = 0; workerIndex < poolPtr->targetCount; ++workerIndex)
+            eb_thread_pool_add_worker(poolPtr);
+        EbReleaseMutex(poolPtr->mutex);
+
+        if (poolPtr->workerCount == 0) {
+            eb_thread_pool_free(poolPtr);
+            EB_UNLOCK_PROCESS_POOL();
+            return (EbThreadPool_t*)EB_NULL;
+        }
+        process_pool_ptr = poolPtr;
+    }
+    poolPtr = process_pool_ptr;
+    poolPtr->referenceCount++;
+    EB_UNLOCK_PROCESS_POOL();
+
+    return poolPtr;
+}
+
+void eb_thread_pool_release(
+    EbThreadPool_t *poolPtr)
+{
+    uint32_t workerIndex;
+
+    EB_LOCK_PROCESS_POOL();
+    if (--poolPtr->referenceCount == 0) {
+        EbBlockOnMutex(poolPtr->mutex);
+        poolPtr->shutdown = EB_TRUE;
+        EbReleaseMutex(poolPtr->mutex);
+
+        for (workerIndex = 0; workerIndex < poolPtr->workerCount; ++workerIndex)
+            EbPostSemaphore(poolPtr->wakeSemaphore);
+        for (workerIndex = 0; workerIndex < poolPtr->workerCount; ++workerIndex) {
+            EbWorker_t *workerPtr = poolPtr->workerPtrArray[workerIndex];
+            EbJoinThread(workerPtr->threadHandle);
+            EbDestroyMutex(workerPtr->dequeMutex);
+            free(workerPtr);
+        }
+        eb_thread_pool_free(poolPtr);
+        process_pool_ptr = (EbThreadPool_t*)EB_NULL;
+    }
+    EB_UNLOCK_PROCESS_POOL();
+}
+
+static void eb_task_switch_out(
+    EbTask_t *taskPtr);
+
+void eb_thread_pool_block_begin(
+    EbTask_t *taskPtr,
+    EbHandle  semaphoreHandle)
+{
+    EbThreadPool_t *poolPtr = taskPtr->poolPtr;
+    EbBool          cancelled;
+
+    EbBlockOnMutex(poolPtr->mutex);
+    cancelled = taskPtr->cancelled;
+    if (cancelled == EB_FALSE) {
+        taskPtr->blockingSemaphore = semaphoreHandle;
+        poolPtr->runningCount--;
+        eb_thread_pool_balance(poolPtr);
+    }
+    EbReleaseMutex(poolPtr->mutex);
+
+    // A cancelled task is not resumed
+    if (cancelled)
+        eb_task_switch_out(taskPtr);
+}
+
+void eb_thread_pool_block_end(
+    EbTask_t *taskPtr)
+{
+    EbThreadPool_t *poolPtr = taskPtr->poolPtr;
+    EbBool          cancelled;
+
+    EbBlockOnMutex(poolPtr->mutex);
+    taskPtr->blockingSemaphore = (EbHandle)EB_NULL;
+    poolPtr->runningCount++;
+    cancelled = taskPtr->cancelled;
+    EbReleaseMutex(poolPtr->mutex);
+
+    // The wait was ended by eb_thread_pool_cancel_tasks, the task is not resumed
+    if (cancelled)
+        eb_task_switch_out(taskPtr);
+}
+
+void eb_thread_pool_cancel_tasks(
+    EbThreadPool_t  *poolPtr,
+    EbMemoryContext *memoryContextPtr)
+{
+    EbTask_t *taskPtr;
+    uint32_t  workerIndex;
+    uint32_t  pendingCount;
+
+    EbBlockOnMutex(poolPtr->cancelMutex);
+
+    // From now on the tasks are no longer scheduled, drop the queued ones
+    EbBlockOnMutex(poolPtr->mutex);
+    for (taskPtr = poolPtr->taskListPtr; taskPtr; taskPtr = taskPtr->listNextPtr) {
+        if (taskPtr->memoryContextPtr == memoryContextPtr)
+            taskPtr->cancelled = EB_TRUE;
+    }
+    for (workerIndex = 0; workerIndex < poolPtr->workerCount; ++workerIndex) {
+        EbWorker_t *workerPtr = poolPtr->workerPtrArray[workerIndex];
+        EbTask_t   *nextPtr;
+
+        EbBlockOnMutex(workerPtr->dequeMutex);
+        for (taskPtr = workerPtr->headPtr; taskPtr; taskPtr = nextPtr) {
+            nextPtr = taskPtr->nextPtr;
+            if (taskPtr->cancelled == EB_FALSE)
+                continue;
+            if (taskPtr->prevPtr)
+                taskPtr->prevPtr->nextPtr = nextPtr;
+            else
+                workerPtr->headPtr = nextPtr;
+            if (nextPtr)
+                nextPtr->prevPtr = taskPtr->prevPtr;
+            else
+                workerPtr->tailPtr = taskPtr->prevPtr;
+            taskPtr->prevPtr = taskPtr->nextPtr = (EbTask_t*)EB_NULL;
+            taskPtr->state = EB_TASK_CANCELLED;
+            poolPtr->queuedCount--;
+        }
+        EbReleaseMutex(workerPtr->dequeMutex);
+    }
+    EbReleaseMutex(poolPtr->mutex);
+
+    // Wait for the running tasks to park or to wait on a semaphore. The
+    // semaphores are posted to end the waits: they belong to the cancelled
+    // instance, so their other waiters are cancelled tasks as well.
+    do {
+        pendingCount = 0;
+        EbBlockOnMutex(poolPtr->mutex);
+        for (taskPtr = poolPtr->taskListPtr; taskPtr; taskPtr = taskPtr->listNextPtr) {
+            if (taskPtr->memoryContextPtr != memoryContextPtr ||
+                (taskPtr->state != EB_TASK_RUNNABLE && taskPtr->state != EB_TASK_RUNNING))
+                continue;
+            if (taskPtr->blockingSemaphore)
+                EbPostSemaphore(taskPtr->blockingSemaphore);
+            pendingCount++;
+        }
+        EbReleaseMutex(poolPtr->mutex);
+
+        if (pendingCount)
+            EbBlockOnSemaphore(poolPtr->cancelSemaphore);
+    } while (pendingCount);
+
+    EbReleaseMutex(poolPtr->cancelMutex);
+}
+
+/**************************************
+ * Tasks
+ **************************************/
+static void eb_task_switch_out(
+    EbTask_t *taskPtr)
+{
+#ifdef _WIN32
+    SwitchToFiber(taskPtr->workerPtr->fiber);
+#else
+    swapcontext(&taskPtr->context, &taskPtr->workerPtr->context);
+#endif
+}
+
+static void eb_task_run(
+    EbTask_t *taskPtr)
+{
+    taskPtr->taskFunction(taskPtr->taskContext);
+    EbBlockOnMutex(taskPtr->poolPtr->mutex);
+    taskPtr->state = EB_TASK_DONE;
+    EbReleaseMutex(taskPtr->poolPtr->mutex);
+    eb_task_switch_out(taskPtr);
+}
+
+#ifdef _WIN32
+static VOID WINAPI eb_task_entry(LPVOID task_ptr)
+{
+    eb_task_run((EbTask_t*)task_ptr);
+}
+#else
+static void eb_task_entry(void)
+{
+    eb_task_run(current_task_ptr);
+}
+
+static EbErrorType eb_task_make_context(
+    EbTask_t *taskPtr)
+{
+    taskPtr->stackPtr = malloc(taskPtr->poolPtr->taskStackSize);
+    if (taskPtr->stackPtr == EB_NULL)
+        return EB_ErrorInsufficientResources;
+    if (getcontext(&taskPtr->context)) {
+        free(taskPtr->stackPtr);
+        return EB_ErrorInsufficientResources;
+    }
+    taskPtr->context.uc_stack.ss_sp = taskPtr->stackPtr;
+    taskPtr->context.uc_stack.ss_size = taskPtr->poolPtr->taskStackSize;
+    taskPtr->context.uc_link = NULL;
+    makecontext(&taskPtr->context, eb_task_entry, 0);
+
+    return EB_ErrorNone;
+}
+#endif
+
+EbHandle eb_create_task(
+    EbThreadPool_t *poolPtr,
+    void *taskFunction(void *),
+    void *taskContext)
+{
+    EbTask_t *taskPtr = (EbTask_t*)calloc(1, sizeof(EbTask_t));
+
+    if (taskPtr == (EbTask_t*)EB_NULL)
+        return (EbHandle)EB_NULL;
+    taskPtr->taskFunction = taskFunction;
+    taskPtr->taskContext = taskContext;
+    taskPtr->poolPtr = poolPtr;
+    taskPtr->memoryContextPtr = eb_get_memory_context();
+
+#ifdef _WIN32
+    taskPtr->fiber = CreateFiber(taskPtr->poolPtr->taskStackSize, eb_task_entry, taskPtr);
+    if (taskPtr->fiber == NULL) {
+        free(taskPtr);
+        return (EbHandle)EB_NULL;
+    }
+#else
+    if (eb_task_make_context(taskPtr) != EB_ErrorNone) {
+        free(taskPtr);
+        return (EbHandle)EB_NULL;
+    }
+#endif
+
+    EbBlockOnMutex(poolPtr->mutex);
+    taskPtr->listNextPtr = poolPtr->taskListPtr;
+    if (poolPtr->taskListPtr)
+        poolPtr->taskListPtr->listPrevPtr = taskPtr;
+    poolPtr->taskListPtr = taskPtr;
+    EbReleaseMutex(poolPtr->mutex);
+
+    eb_task_schedule(taskPtr);
+
+    return (EbHandle)taskPtr;
+}
+
+// Frees the task. The tasks of the instance must have been stopped with
+// eb_thread_pool_cancel_tasks, so that none of them runs or schedules it.
+EbErrorType eb_destroy_task(
+    EbHandle taskHandle)
+{
+    EbTask_t       *taskPtr = (EbTask_t*)taskHandle;
+    EbThreadPool_t *poolPtr = taskPtr->poolPtr;
+
+    EbBlockOnMutex(poolPtr->mutex);
+    if (taskPtr->listPrevPtr)
+        taskPtr->listPrevPtr->listNextPtr = taskPtr->listNextPtr;
+    else
+        poolPtr->taskListPtr = taskPtr->listNextPtr;
+    if (taskPtr->listNextPtr)
+        taskPtr->listNextPtr->listPrevPtr = taskPtr->listPrevPtr;
+    EbReleaseMutex(poolPtr->mutex);
+
+#ifdef _WIN32
+    DeleteFiber(taskPtr->fiber);
+#else
+    free(taskPtr->stackPtr);
+#endif
+    free(taskPtr);
+
+    return EB_ErrorNone;
+}
+
+EbTask_t* eb_task_self(void)
+{
+    return current_task_ptr;
+}
+
+void eb_task_park(
+    EbTask_t *taskPtr,
+    EbHandle  lockedMutex)
+{
+    taskPtr->parkMutex = lockedMutex;
+    eb_task_switch_out(taskPtr);
+}
+
+void eb_task_schedule(
+    EbTask_t *taskPtr)
+{
+    EbThreadPool_t *poolPtr = taskPtr->poolPtr;
+    EbWorker_t     *workerPtr = current_worker_ptr;
+
+    // The task is queued under the pool mutex, eb_thread_pool_cancel_tasks
+    // either sees it on the deque or keeps it from being queued
+    EbBlockOnMutex(poolPtr->mutex);
+    if (taskPtr->cancelled) {
+        EbReleaseMutex(poolPtr->mutex);
+        return;
+    }
+    // Tasks woken from outside the pool are spread over the workers
+    if (workerPtr == (EbWorker_t*)EB_NULL || workerPtr->poolPtr != poolPtr)
+        workerPtr = poolPtr->workerPtrArray[poolPtr->nextWorker++ % poolPtr->workerCount];
+    taskPtr->state = EB_TASK_RUNNABLE;
+    eb_deque_push_tail(workerPtr, taskPtr);
+    poolPtr->queuedCount++;
+    eb_thread_pool_balance(poolPtr);
+    EbReleaseMutex(poolPtr->mutex);
+}
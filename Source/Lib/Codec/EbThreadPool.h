@@ -0,0 +1,85 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbThreadPool_h
+#define EbThreadPool_h
+
+#include "EbDefinitions.h"
+#include "EbThreads.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /**************************************
+     * Thread Pool
+     *   Worker threads shared by all the encoder instances of the
+     *   process. The kernels run on the workers as tasks: a task waiting
+     *   on an empty fifo is switched out and its worker moves on to
+     *   another task. Each worker owns a deque of runnable tasks, runs
+     *   the newest one first and steals the oldest one of another worker
+     *   when its own deque is empty.
+     **************************************/
+    typedef struct EbTask_s       EbTask_t;
+    typedef struct EbThreadPool_s EbThreadPool_t;
+
+    // Returns the process wide pool, created with workerCount workers by
+    // its first user. Each call must be paired with eb_thread_pool_release.
+    extern EbThreadPool_t* eb_thread_pool_acquire(
+        uint32_t workerCount);
+    extern void eb_thread_pool_release(
+        EbThreadPool_t *poolPtr);
+
+    // Stops the tasks created in the memory context of an encoder instance,
+    // the counterpart of cancelling its kernel threads: the queued tasks are
+    // dropped, the parked ones are no longer scheduled and the ones waiting
+    // on a semaphore are switched out for good. Returns once none of them
+    // runs, so that they can be destroyed.
+    extern void eb_thread_pool_cancel_tasks(
+        EbThreadPool_t  *poolPtr,
+        EbMemoryContext *memoryContextPtr);
+
+    /**************************************
+     * Tasks
+     **************************************/
+    extern EbHandle eb_create_task(
+        EbThreadPool_t *poolPtr,
+        void *taskFunction(void *),
+        void *taskContext);
+    extern EbErrorType eb_destroy_task(
+        EbHandle taskHandle);
+
+    // Task running on the calling thread, NULL outside of the pool
+    extern EbTask_t* eb_task_self(void);
+
+    // Switches the calling task out. lockedMutex is released by the worker
+    // once the task is off its stack, so that an eb_task_schedule issued
+    // under the same mutex cannot resume the task before it is parked.
+    extern void eb_task_park(
+        EbTask_t *taskPtr,
+        EbHandle  lockedMutex);
+    extern void eb_task_schedule(
+        EbTask_t *taskPtr);
+
+    // Brackets an OS level wait of the calling task on semaphoreHandle; the
+    // pool lets another worker run in the meantime.
+    extern void eb_thread_pool_block_begin(
+        EbTask_t *taskPtr,
+        EbHandle  semaphoreHandle);
+    extern void eb_thread_pool_block_end(
+        EbTask_t *taskPtr);
+
+#define EB_CREATETASK(type, pointer, nElements, pointerClass, poolPtr, taskFunction, taskContext) \
+    pointer = eb_create_task(poolPtr, taskFunction, taskContext); \
+    if (pointer == (type)EB_NULL) { \
+        return EB_ErrorInsufficientResources; \
+    } \
+    if (eb_add_mem_entry(pointer, pointerClass, nElements) != EB_ErrorNone) { \
+        return EB_ErrorInsufficientResources; \
+    }
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbThreadPool_h
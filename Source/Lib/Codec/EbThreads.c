@@ -9,12 +9,17 @@
 // and mutexs.  The goal is to eliminiate platform #define
 // in the code.
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE     // CPU sets
+#endif
+
 /****************************************
  * Universal Includes
  ****************************************/
 #include <stdlib.h>
 #include "EbDefinitions.h"
 #include "EbThreads.h"
+#include "EbThreadPool.h"
  /****************************************
   * Win32 Includes
   ****************************************/
@@ -28,6 +33,10 @@
 #include <semaphore.h>
 #include <time.h>
 #include <unistd.h>
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
 #else
 #error OS/Platform not supported.
 #endif // _WIN32
@@ -45,6 +54,35 @@ void printfTime(const char *fmt, ...)
 #endif
 #endif
 
+// Memory context of the encoder instance the calling thread works for.
+// Kernel threads inherit the context of the thread that created them.
+static EB_THREAD_LOCAL EbMemoryContext *memory_context_ptr = (EbMemoryContext*)EB_NULL;
+
+typedef struct EbThreadStart
+{
+    void                    *(*threadFunction)(void *);
+    void                    *threadContext;
+    EbMemoryContext         *memoryContextPtr;
+} EbThreadStart;
+
+static void *EbThreadEntry(void *start_ptr)
+{
+    EbThreadStart threadStart = *(EbThreadStart*)start_ptr;
+    free(start_ptr);
+
+    memory_context_ptr = threadStart.memoryContextPtr;
+
+    return threadStart.threadFunction(threadStart.threadContext);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI EbThreadEntryWin32(LPVOID start_ptr)
+{
+    EbThreadEntry(start_ptr);
+    return 0;
+}
+#endif
+
 /****************************************
  * EbCreateThread
  ****************************************/
@@ -53,16 +91,24 @@ EbHandle EbCreateThread(
     void *threadContext)
 {
     EbHandle threadHandle = NULL;
+    EbThreadStart *threadStart = (EbThreadStart*)malloc(sizeof(EbThreadStart));
+    if (threadStart == (EbThreadStart*)EB_NULL)
+        return NULL;
+    threadStart->threadFunction = threadFunction;
+    threadStart->threadContext = threadContext;
+    threadStart->memoryContextPtr = memory_context_ptr;
 
 #ifdef _WIN32
 
     threadHandle = (EbHandle)CreateThread(
         NULL,                           // default security attributes
         0,                              // default stack size
-        (LPTHREAD_START_ROUTINE)threadFunction, // function to be tied to the new thread
-        threadContext,                  // context to be tied to the new thread
+        EbThreadEntryWin32,             // function to be tied to the new thread
+        threadStart,                    // context to be tied to the new thread
         0,                              // thread active when created
         NULL);                          // new thread ID
+    if (threadHandle == NULL)
+        free(threadStart);
 
 #elif defined(__linux__) || defined(__APPLE__)
 
@@ -80,8 +126,8 @@ EbHandle EbCreateThread(
     int32_t ret = pthread_create(
         (pthread_t*)threadHandle,      // Thread handle
         &attr,                       // attributes
-        threadFunction,                 // function to be run by new thread
-        threadContext);
+        EbThreadEntry,                  // function to be run by new thread
+        threadStart);
 
     if (ret != 0)
         if (ret == EPERM) {
@@ -92,12 +138,14 @@ EbHandle EbCreateThread(
 
             threadHandle = (pthread_t*)malloc(sizeof(pthread_t));
 
-            pthread_create(
+            ret = pthread_create(
                 (pthread_t*)threadHandle,      // Thread handle
                 (const pthread_attr_t*)EB_NULL,                        // attributes
-                threadFunction,                 // function to be run by new thread
-                threadContext);
+                EbThreadEntry,                  // function to be run by new thread
+                threadStart);
         }
+    if (ret != 0)
+        free(threadStart);
 
 #endif // _WIN32
 
@@ -169,6 +217,26 @@ EbErrorType EbDestroyThread(
 
     return error_return;
 }
+
+/***************************************
+ * EbJoinThread
+ *   Waits for the thread to return and releases its handle
+ ***************************************/
+EbErrorType EbJoinThread(
+    EbHandle threadHandle)
+{
+    EbErrorType error_return = EB_ErrorNone;
+
+#ifdef _WIN32
+    error_return = (WaitForSingleObject((HANDLE)threadHandle, INFINITE) == WAIT_OBJECT_0) ? EB_ErrorNone : EB_ErrorDestroyThreadFailed;
+    CloseHandle((HANDLE)threadHandle);
+#elif defined(__linux__) || defined(__APPLE__)
+    error_return = pthread_join(*((pthread_t*)threadHandle), NULL) ? EB_ErrorDestroyThreadFailed : EB_ErrorNone;
+    free(threadHandle);
+#endif // _WIN32
+
+    return error_return;
+}
 #if defined(__APPLE__)
 static int32_t semaphore_id(void)
 {
@@ -246,6 +314,15 @@ EbErrorType EbBlockOnSemaphore(
     EbHandle semaphoreHandle)
 {
     EbErrorType return_error = EB_ErrorNone;
+    EbTask_t   *taskPtr = eb_task_self();
+
+    // A thread pool task about to block its worker lets the pool run
+    // another worker meanwhile
+    if (taskPtr) {
+        if (EbTryBlockOnSemaphore(semaphoreHandle) == EB_TRUE)
+            return EB_ErrorNone;
+        eb_thread_pool_block_begin(taskPtr, semaphoreHandle);
+    }
 
 #ifdef _WIN32
     return_error = WaitForSingleObject((HANDLE)semaphoreHandle, INFINITE) ? EB_ErrorSemaphoreUnresponsive : EB_ErrorNone;
@@ -253,9 +330,69 @@ EbErrorType EbBlockOnSemaphore(
     return_error = sem_wait((sem_t*)semaphoreHandle) ? EB_ErrorSemaphoreUnresponsive : EB_ErrorNone;
 #endif // _WIN32
 
+    if (taskPtr)
+        eb_thread_pool_block_end(taskPtr);
+
     return return_error;
 }
 
+/***************************************
+ * EbBlockOnSemaphoreTimeout
+ *   Returns EB_NoErrorEmptyQueue when the semaphore is not available
+ *   within timeout milliseconds
+ ***************************************/
+EbErrorType EbBlockOnSemaphoreTimeout(
+    EbHandle semaphoreHandle,
+    uint32_t timeout)
+{
+#ifdef _WIN32
+    DWORD waitStatus = WaitForSingleObject((HANDLE)semaphoreHandle, timeout);
+
+    return (waitStatus == WAIT_OBJECT_0) ? EB_ErrorNone : (waitStatus == WAIT_TIMEOUT) ? EB_NoErrorEmptyQueue : EB_ErrorSemaphoreUnresponsive;
+#elif defined(__linux__)
+    struct timespec deadline;
+    int32_t         waitStatus;
+
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += timeout / 1000;
+    deadline.tv_nsec += (long)(timeout % 1000) * 1000000;
+    if (deadline.tv_nsec >= 1000000000) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+    do {
+        waitStatus = sem_timedwait((sem_t*)semaphoreHandle, &deadline);
+    } while (waitStatus && errno == EINTR);
+
+    return (waitStatus == 0) ? EB_ErrorNone : (errno == ETIMEDOUT) ? EB_NoErrorEmptyQueue : EB_ErrorSemaphoreUnresponsive;
+#elif defined(__APPLE__)
+    // No timed wait on the named semaphores, poll every millisecond
+    uint32_t elapsed;
+
+    for (elapsed = 0; elapsed < timeout; ++elapsed) {
+        if (sem_trywait((sem_t*)semaphoreHandle) == 0)
+            return EB_ErrorNone;
+        usleep(1000);
+    }
+    return (sem_trywait((sem_t*)semaphoreHandle) == 0) ? EB_ErrorNone : EB_NoErrorEmptyQueue;
+#endif // _WIN32
+}
+
+/***************************************
+ * EbTryBlockOnSemaphore
+ *   Takes the semaphore when available, returns EB_FALSE instead of
+ *   blocking otherwise
+ ***************************************/
+EbBool EbTryBlockOnSemaphore(
+    EbHandle semaphoreHandle)
+{
+#ifdef _WIN32
+    return (WaitForSingleObject((HANDLE)semaphoreHandle, 0) == WAIT_OBJECT_0) ? EB_TRUE : EB_FALSE;
+#else
+    return sem_trywait((sem_t*)semaphoreHandle) ? EB_FALSE : EB_TRUE;
+#endif // _WIN32
+}
+
 /***************************************
  * EbDestroySemaphore
  ***************************************/
@@ -371,3 +508,392 @@ EbErrorType EbDestroyMutex(
 
     return return_error;
 }
+
+/***************************************
+ * EbGetMonotonicTime
+ ***************************************/
+uint64_t EbGetMonotonicTime(
+    void)
+{
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER        counter;
+
+    if (frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+
+    return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000 +
+        (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+#endif
+}
+
+/***************************************
+ * Placement
+ ***************************************/
+#if defined(__linux__)
+#define EB_NUMA_PAGE_BATCH      256
+
+// Affinity of the calling thread before EbSetThreadPlacement
+static EB_THREAD_LOCAL cpu_set_t savedAffinity;
+static EB_THREAD_LOCAL EbBool    savedAffinityValid = EB_FALSE;
+
+// Adds the CPUs of a list of ranges such as "0-7,16-23" to cpuSet
+static EbBool EbParseCpuList(
+    const char *cpuList,
+    cpu_set_t  *cpuSet)
+{
+    const char *cursor = cpuList;
+
+    while (*cursor) {
+        char *end;
+        unsigned long first = strtoul(cursor, &end, 10);
+        unsigned long last = first;
+        if (end == cursor)
+            return EB_FALSE;
+        cursor = end;
+        if (*cursor == '-') {
+            last = strtoul(++cursor, &end, 10);
+            if (end == cursor || last < first)
+                return EB_FALSE;
+            cursor = end;
+        }
+        if (last >= CPU_SETSIZE)
+            return EB_FALSE;
+        for (; first <= last; ++first)
+            CPU_SET(first, cpuSet);
+        while (*cursor == ',' || *cursor == ' ' || *cursor == '\n')
+            ++cursor;
+    }
+    return CPU_COUNT(cpuSet) ? EB_TRUE : EB_FALSE;
+}
+
+static EbBool EbGetNodeCpus(
+    uint32_t   node,
+    cpu_set_t *cpuSet)
+{
+    char   path[64];
+    char   cpuList[1024];
+    FILE  *file;
+    EbBool valid;
+
+    sprintf(path, "/sys/devices/system/node/node%u/cpulist", node);
+    file = fopen(path, "r");
+    if (file == NULL)
+        return EB_FALSE;
+    valid = fgets(cpuList, sizeof(cpuList), file) ? EbParseCpuList(cpuList, cpuSet) : EB_FALSE;
+    fclose(file);
+    return valid;
+}
+#endif
+
+/***************************************
+ * EbGetNumaNodeCount
+ *   1 when the system exposes no NUMA topology
+ ***************************************/
+uint32_t EbGetNumaNodeCount(void)
+{
+    uint32_t nodeCount = 1;
+#if defined(__linux__)
+    char path[64];
+
+    while (nodeCount < EB_MAX_NUMA_NODES) {
+        sprintf(path, "/sys/devices/system/node/node%u", nodeCount);
+        if (access(path, F_OK))
+            break;
+        ++nodeCount;
+    }
+#endif
+    return nodeCount;
+}
+
+/***************************************
+ * EbSetThreadPlacement
+ *   Pins the calling thread to the CPUs of cpuList, or of NUMA node
+ *   numaNode when cpuList is NULL. The threads it creates inherit the
+ *   placement, and the pages it touches first come from its nodes. Nothing
+ *   is done for a numaNode of -1 without cpuList. nodeMask receives the
+ *   nodes the thread can run on.
+ ***************************************/
+EbErrorType EbSetThreadPlacement(
+    int32_t      numaNode,
+    const char  *cpuList,
+    uint64_t    *nodeMask)
+{
+#if defined(__linux__)
+    uint32_t  nodeCount = EbGetNumaNodeCount();
+    uint32_t  node;
+    cpu_set_t cpuSet;
+
+    *nodeMask = (nodeCount < 64) ? ((uint64_t)1 << nodeCount) - 1 : ~(uint64_t)0;
+    if (cpuList == NULL && numaNode == -1)
+        return EB_ErrorNone;
+
+    CPU_ZERO(&cpuSet);
+    if (cpuList) {
+        if (EbParseCpuList(cpuList, &cpuSet) == EB_FALSE)
+            return EB_ErrorBadParameter;
+    }
+    else if (numaNode < 0 || (uint32_t)numaNode >= nodeCount || EbGetNodeCpus(numaNode, &cpuSet) == EB_FALSE)
+        return EB_ErrorBadParameter;
+
+    // Nodes sharing CPUs with the set
+    *nodeMask = 0;
+    for (node = 0; node < nodeCount; ++node) {
+        cpu_set_t nodeCpus;
+        CPU_ZERO(&nodeCpus);
+        if (EbGetNodeCpus(node, &nodeCpus)) {
+            CPU_AND(&nodeCpus, &nodeCpus, &cpuSet);
+            if (CPU_COUNT(&nodeCpus))
+                *nodeMask |= (uint64_t)1 << node;
+        }
+    }
+
+    if (savedAffinityValid == EB_FALSE) {
+        if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &savedAffinity))
+            return EB_ErrorBadParameter;
+        savedAffinityValid = EB_TRUE;
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) ? EB_ErrorBadParameter : EB_ErrorNone;
+#else
+    (void)numaNode;
+    (void)cpuList;
+    *nodeMask = 1;
+    return EB_ErrorNone;
+#endif
+}
+
+/***************************************
+ * EbRestoreThreadPlacement
+ *   Gives the calling thread back the CPUs it had before
+ *   EbSetThreadPlacement
+ ***************************************/
+void EbRestoreThreadPlacement(void)
+{
+#if defined(__linux__)
+    if (savedAffinityValid) {
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &savedAffinity);
+        savedAffinityValid = EB_FALSE;
+    }
+#endif
+}
+
+/***************************************
+ * EbGetNumaResidency
+ *   Adds the resident bytes of [ptr, ptr + size) to localBytes when their
+ *   node is in nodeMask, to remoteBytes otherwise. Pages never touched
+ *   are not counted.
+ ***************************************/
+void EbGetNumaResidency(
+    const void  *ptr,
+    uint64_t     size,
+    uint64_t     nodeMask,
+    uint64_t    *localBytes,
+    uint64_t    *remoteBytes)
+{
+#if defined(__linux__)
+    void     *pages[EB_NUMA_PAGE_BATCH];
+    int       status[EB_NUMA_PAGE_BATCH];
+    uint64_t  pageSize = (uint64_t)sysconf(_SC_PAGESIZE);
+    uintptr_t address = (uintptr_t)ptr & ~(uintptr_t)(pageSize - 1);
+    uintptr_t end = (uintptr_t)ptr + size;
+
+    while (address < end) {
+        unsigned long count = 0;
+        unsigned long index;
+        while (count < EB_NUMA_PAGE_BATCH && address < end) {
+            pages[count++] = (void*)address;
+            address += pageSize;
+        }
+        // Without target nodes, move_pages only reports where the pages are
+        if (syscall(SYS_move_pages, 0, count, pages, NULL, status, 0))
+            return;
+        for (index = 0; index < count; ++index) {
+            if (status[index] < 0)
+                continue;
+            if (status[index] < 64 && ((nodeMask >> status[index]) & 1))
+                *localBytes += pageSize;
+            else
+                *remoteBytes += pageSize;
+        }
+    }
+#else
+    (void)ptr;
+    (void)size;
+    (void)nodeMask;
+    (void)localBytes;
+    (void)remoteBytes;
+#endif
+}
+
+/***************************************
+ * Memory Context
+ ***************************************/
+EbErrorType eb_memory_context_ctor(
+    EbMemoryContext *context_ptr)
+{
+    context_ptr->block = (EbMemoryMapBlock*)EB_NULL;
+    context_ptr->total_lib_memory = 0;
+    context_ptr->malloc_count = 0;
+    context_ptr->thread_count = 0;
+    context_ptr->semaphore_count = 0;
+    context_ptr->mutex_count = 0;
+
+    context_ptr->mutex = EbCreateMutex();
+    if (context_ptr->mutex == (EbHandle)EB_NULL)
+        return EB_ErrorInsufficientResources;
+
+    return EB_ErrorNone;
+}
+
+void eb_set_memory_context(
+    EbMemoryContext *context_ptr)
+{
+    memory_context_ptr = context_ptr;
+}
+
+EbMemoryContext* eb_get_memory_context(void)
+{
+    return memory_context_ptr;
+}
+
+static EbErrorType eb_release_mem_entry(
+    EbMemoryMapEntry *memoryEntry)
+{
+    EbErrorType return_error = EB_ErrorNone;
+
+    switch (memoryEntry->ptrType) {
+    case EB_N_PTR:
+        free(memoryEntry->ptr);
+        break;
+    case EB_A_PTR:
+#ifdef _WIN32
+        _aligned_free(memoryEntry->ptr);
+#else
+        free(memoryEntry->ptr);
+#endif
+        break;
+    case EB_SEMAPHORE:
+        EbDestroySemaphore(memoryEntry->ptr);
+        break;
+    case EB_THREAD:
+        EbDestroyThread(memoryEntry->ptr);
+        break;
+    case EB_TASK:
+        eb_destroy_task(memoryEntry->ptr);
+        break;
+    case EB_MUTEX:
+        EbDestroyMutex(memoryEntry->ptr);
+        break;
+    default:
+        return_error = EB_ErrorMax;
+        break;
+    }
+
+    return return_error;
+}
+
+/***************************************
+ * eb_add_mem_entry
+ *   Registers an allocation in the memory context of the calling thread.
+ *   The object is released right away when it cannot be registered.
+ ***************************************/
+EbErrorType eb_add_mem_entry(
+    EbPtr                    ptr,
+    EbPtrType                ptrType,
+    uint64_t                 size)
+{
+    EbMemoryContext  *context_ptr = memory_context_ptr;
+    EbMemoryMapBlock *block_ptr;
+    EbMemoryMapEntry  memoryEntry;
+
+    memoryEntry.ptr = ptr;
+    memoryEntry.ptrType = ptrType;
+    memoryEntry.size = size;
+
+    if (context_ptr == (EbMemoryContext*)EB_NULL) {
+        eb_release_mem_entry(&memoryEntry);
+        return EB_ErrorInsufficientResources;
+    }
+
+    EbBlockOnMutex(context_ptr->mutex);
+
+    block_ptr = context_ptr->block;
+    if (block_ptr == (EbMemoryMapBlock*)EB_NULL || block_ptr->count == EB_MEMORY_MAP_BLOCK_SIZE) {
+        block_ptr = (EbMemoryMapBlock*)malloc(sizeof(EbMemoryMapBlock));
+        if (block_ptr == (EbMemoryMapBlock*)EB_NULL) {
+            EbReleaseMutex(context_ptr->mutex);
+            eb_release_mem_entry(&memoryEntry);
+            return EB_ErrorInsufficientResources;
+        }
+        block_ptr->prev = context_ptr->block;
+        block_ptr->count = 0;
+        context_ptr->block = block_ptr;
+        context_ptr->total_lib_memory += sizeof(EbMemoryMapBlock);
+    }
+    block_ptr->entries[block_ptr->count++] = memoryEntry;
+
+    context_ptr->total_lib_memory += (size % 8 == 0) ? size : size + (8 - (size % 8));
+
+    switch (ptrType) {
+    case EB_N_PTR:
+    case EB_A_PTR:
+        context_ptr->malloc_count++;
+        break;
+    case EB_SEMAPHORE:
+        context_ptr->semaphore_count++;
+        break;
+    case EB_THREAD:
+        context_ptr->thread_count++;
+        break;
+    case EB_MUTEX:
+        context_ptr->mutex_count++;
+        break;
+    default:
+        break;
+    }
+
+    EbReleaseMutex(context_ptr->mutex);
+
+    return EB_ErrorNone;
+}
+
+/***************************************
+ * eb_memory_context_release
+ *   Frees every registered object, newest first, so that the threads are
+ *   destroyed before the objects they use. Only the instance's own lock is
+ *   involved.
+ ***************************************/
+EbErrorType eb_memory_context_release(
+    EbMemoryContext *context_ptr)
+{
+    EbErrorType       return_error = EB_ErrorNone;
+    EbMemoryMapBlock *block_ptr = context_ptr->block;
+
+    while (block_ptr != (EbMemoryMapBlock*)EB_NULL) {
+        EbMemoryMapBlock *prev_ptr = block_ptr->prev;
+        while (block_ptr->count) {
+            if (eb_release_mem_entry(&block_ptr->entries[--block_ptr->count]) != EB_ErrorNone)
+                return_error = EB_ErrorMax;
+        }
+        free(block_ptr);
+        block_ptr = prev_ptr;
+    }
+    context_ptr->block = (EbMemoryMapBlock*)EB_NULL;
+
+    if (context_ptr->mutex != (EbHandle)EB_NULL) {
+        EbDestroyMutex(context_ptr->mutex);
+        context_ptr->mutex = (EbHandle)EB_NULL;
+    }
+
+    if (memory_context_ptr == context_ptr)
+        memory_context_ptr = (EbMemoryContext*)EB_NULL;
+
+    return return_error;
+}
@@ -11,6 +11,44 @@
 #ifdef _MSC_VER
 #include <Windows.h>
 #endif
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#define EB_THREAD_LOCAL __declspec(thread)
+#else
+#define EB_THREAD_LOCAL __thread
+#endif
+
+    /**************************************
+     * Atomics on 32 bit words, and relaxed counters on 64 bit words.
+     * EB_ATOMIC_FENCE orders a store before a later load.
+     **************************************/
+#ifdef _MSC_VER
+#define EB_ATOMIC_LOAD_ACQUIRE(ptr)             (*(volatile uint32_t*)(ptr))
+#define EB_ATOMIC_STORE_RELEASE(ptr, value)     (*(volatile uint32_t*)(ptr) = (value))
+#define EB_ATOMIC_CAS(ptr, expected, desired)   ((uint32_t)InterlockedCompareExchange((volatile LONG*)(ptr), (LONG)(desired), (LONG)(expected)) == (uint32_t)(expected))
+#define EB_ATOMIC_ADD(ptr, value)               ((uint32_t)InterlockedExchangeAdd((volatile LONG*)(ptr), (LONG)(value)) + (uint32_t)(value))
+#define EB_ATOMIC_SUB(ptr, value)               ((uint32_t)InterlockedExchangeAdd((volatile LONG*)(ptr), -(LONG)(value)) - (uint32_t)(value))
+#define EB_ATOMIC_LOAD64(ptr)                   ((uint64_t)InterlockedCompareExchange64((volatile LONG64*)(ptr), 0, 0))
+#define EB_ATOMIC_STORE64(ptr, value)           InterlockedExchange64((volatile LONG64*)(ptr), (LONG64)(value))
+#define EB_ATOMIC_ADD64(ptr, value)             ((uint64_t)InterlockedExchangeAdd64((volatile LONG64*)(ptr), (LONG64)(value)) + (uint64_t)(value))
+#define EB_ATOMIC_LOAD64_ACQUIRE(ptr)           ((uint64_t)InterlockedCompareExchange64((volatile LONG64*)(ptr), 0, 0))
+#define EB_ATOMIC_CAS64(ptr, expected, desired) ((uint64_t)InterlockedCompareExchange64((volatile LONG64*)(ptr), (LONG64)(desired), (LONG64)(expected)) == (uint64_t)(expected))
+#define EB_ATOMIC_FENCE()                       MemoryBarrier()
+#else
+#define EB_ATOMIC_LOAD_ACQUIRE(ptr)             __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define EB_ATOMIC_STORE_RELEASE(ptr, value)     __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#define EB_ATOMIC_CAS(ptr, expected, desired)   __sync_bool_compare_and_swap((ptr), (expected), (desired))
+#define EB_ATOMIC_ADD(ptr, value)               __atomic_add_fetch((ptr), (value), __ATOMIC_ACQ_REL)
+#define EB_ATOMIC_SUB(ptr, value)               __atomic_sub_fetch((ptr), (value), __ATOMIC_ACQ_REL)
+#define EB_ATOMIC_LOAD64(ptr)                   __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#define EB_ATOMIC_STORE64(ptr, value)           __atomic_store_n((ptr), (value), __ATOMIC_RELAXED)
+#define EB_ATOMIC_ADD64(ptr, value)             __atomic_add_fetch((ptr), (value), __ATOMIC_RELAXED)
+#define EB_ATOMIC_LOAD64_ACQUIRE(ptr)           __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define EB_ATOMIC_CAS64(ptr, expected, desired) __sync_bool_compare_and_swap((ptr), (expected), (desired))
+#define EB_ATOMIC_FENCE()                       __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+#define EB_CPU_PAUSE()                          _mm_pause()
 
 #ifdef __cplusplus
 extern "C" {
@@ -31,6 +69,8 @@ extern "C" {
         EbHandle threadHandle);
     extern EbErrorType EbDestroyThread(
         EbHandle threadHandle);
+    extern EbErrorType EbJoinThread(
+        EbHandle threadHandle);
 
     /**************************************
      * Semaphores
@@ -42,6 +82,11 @@ extern "C" {
         EbHandle semaphoreHandle);
     extern EbErrorType EbBlockOnSemaphore(
         EbHandle semaphoreHandle);
+    extern EbBool EbTryBlockOnSemaphore(
+        EbHandle semaphoreHandle);
+    extern EbErrorType EbBlockOnSemaphoreTimeout(
+        EbHandle semaphoreHandle,
+        uint32_t timeout);
     extern EbErrorType EbDestroySemaphore(
         EbHandle semaphoreHandle);
     /**************************************
@@ -59,9 +104,33 @@ extern "C" {
     extern EbErrorType EbDestroyMutex(
         EbHandle mutexHandle);
 
-    extern    EbMemoryMapEntry        *memoryMap;               // library Memory table
-    extern    uint32_t                  *memoryMapIndex;          // library memory index
-    extern    uint64_t                  *totalLibMemory;          // library Memory malloc'd
+    /**************************************
+     * Clock
+     *   Monotonic time in microseconds, from an arbitrary origin
+     **************************************/
+    extern uint64_t EbGetMonotonicTime(
+        void);
+
+    /**************************************
+     * Placement
+     *   NUMA nodes and CPU sets, Linux only. The other platforms keep the
+     *   processor groups below and treat these calls as no-ops.
+     **************************************/
+#define EB_MAX_NUMA_NODES       64
+    extern uint32_t EbGetNumaNodeCount(
+        void);
+    extern EbErrorType EbSetThreadPlacement(
+        int32_t      numaNode,
+        const char  *cpuList,
+        uint64_t    *nodeMask);
+    extern void EbRestoreThreadPlacement(
+        void);
+    extern void EbGetNumaResidency(
+        const void  *ptr,
+        uint64_t     size,
+        uint64_t     nodeMask,
+        uint64_t    *localBytes,
+        uint64_t    *remoteBytes);
 
 #ifdef _MSC_VER
     extern    GROUP_AFFINITY           groupAffinity;
@@ -72,47 +141,25 @@ extern "C" {
     if (pointer == (type)EB_NULL) { \
         return EB_ErrorInsufficientResources; \
     } \
-    else { \
-        memoryMap[*(memoryMapIndex)].ptrType = pointerClass; \
-        memoryMap[(*(memoryMapIndex))++].ptr = pointer; \
-        if (nElements % 8 == 0) { \
-            *totalLibMemory += (nElements); \
-        } \
-        else { \
-            *totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
-        } \
-        if (numGroups == 2 && alternateGroups){ \
-            groupAffinity.Group = 1 - groupAffinity.Group; \
-            SetThreadGroupAffinity(pointer,&groupAffinity,NULL); \
-        } \
-        else if (numGroups == 2 && !alternateGroups){ \
-            SetThreadGroupAffinity(pointer,&groupAffinity,NULL); \
-        } \
+    if (numGroups == 2 && alternateGroups){ \
+        groupAffinity.Group = 1 - groupAffinity.Group; \
+        SetThreadGroupAffinity(pointer,&groupAffinity,NULL); \
     } \
-    if (*(memoryMapIndex) >= MAX_NUM_PTR) { \
-        return EB_ErrorInsufficientResources; \
+    else if (numGroups == 2 && !alternateGroups){ \
+        SetThreadGroupAffinity(pointer,&groupAffinity,NULL); \
     } \
-    libThreadCount++;
+    if (eb_add_mem_entry(pointer, pointerClass, nElements) != EB_ErrorNone) { \
+        return EB_ErrorInsufficientResources; \
+    }
 #else
 #define EB_CREATETHREAD(type, pointer, nElements, pointerClass, threadFunction, threadContext) \
     pointer = EbCreateThread(threadFunction, threadContext); \
     if (pointer == (type)EB_NULL) { \
         return EB_ErrorInsufficientResources; \
     } \
-    else { \
-        memoryMap[*(memoryMapIndex)].ptrType = pointerClass; \
-        memoryMap[(*(memoryMapIndex))++].ptr = pointer; \
-        if (nElements % 8 == 0) { \
-            *totalLibMemory += (nElements); \
-        } \
-        else { \
-            *totalLibMemory += ((nElements) + (8 - ((nElements) % 8))); \
-        } \
-    } \
-    if (*(memoryMapIndex) >= MAX_NUM_PTR) { \
+    if (eb_add_mem_entry(pointer, pointerClass, nElements) != EB_ErrorNone) { \
         return EB_ErrorInsufficientResources; \
-    } \
-    libThreadCount++;
+    }
 #endif
 
 
@@ -4693,32 +4693,56 @@ EbErrorType Av1EstimateTransform(
 
     case TX_16X16:
 
-        av1_fwd_txfm2d_16x16(
-            residual_buffer,
-            coeffBuffer,
-            residualStride,
-            transform_type,
-            bit_depth);
+        if (bit_depth == EB_8BIT)
+            av1_lowbd_fwd_txfm2d_16x16(
+                residual_buffer,
+                coeffBuffer,
+                residualStride,
+                transform_type,
+                bit_depth);
+        else
+            av1_fwd_txfm2d_16x16(
+                residual_buffer,
+                coeffBuffer,
+                residualStride,
+                transform_type,
+                bit_depth);
 
         break;
     case TX_8X8:
 
-        av1_fwd_txfm2d_8x8(
-            residual_buffer,
-            coeffBuffer,
-            residualStride,
-            transform_type,
-            bit_depth);
+        if (bit_depth == EB_8BIT)
+            av1_lowbd_fwd_txfm2d_8x8(
+                residual_buffer,
+                coeffBuffer,
+                residualStride,
+                transform_type,
+                bit_depth);
+        else
+            av1_fwd_txfm2d_8x8(
+                residual_buffer,
+                coeffBuffer,
+                residualStride,
+                transform_type,
+                bit_depth);
 
         break;
     case TX_4X4:
 
-        av1_fwd_txfm2d_4x4(
-            residual_buffer,
-            coeffBuffer,
-            residualStride,
-            transform_type,
-            bit_depth);
+        if (bit_depth == EB_8BIT)
+            av1_lowbd_fwd_txfm2d_4x4(
+                residual_buffer,
+                coeffBuffer,
+                residualStride,
+                transform_type,
+                bit_depth);
+        else
+            av1_fwd_txfm2d_4x4(
+                residual_buffer,
+                coeffBuffer,
+                residualStride,
+                transform_type,
+                bit_depth);
 
         break;
     default: assert(0); break;
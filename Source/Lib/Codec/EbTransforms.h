@@ -4084,6 +4084,8 @@ extern "C" {
     static EB_MAT_OUT_MUL_TYPE FUNC_TABLE MatMulOut_funcPtrArray[ASM_TYPE_TOTAL] = {
           MatMultOut,
           MatMult4x4_OutBuff_AVX2_INTRIN,
+          // AVX512
+          MatMult4x4_OutBuff_AVX2_INTRIN,
     };
 
     typedef void(*EB_TRANSFORM_FUNC)(
@@ -4123,6 +4125,15 @@ extern "C" {
             /*4 32x32 */     QuantizeInvQuantizeNxN_AVX2_INTRIN,
 
         },
+        // AVX512
+        {
+            /*0 4x4   */    QuantizeInvQuantize4x4_SSE3,
+            /*1 8x8   */     QuantizeInvQuantize8x8_AVX2_INTRIN,
+            /*2 16x16 */     QuantizeInvQuantizeNxN_AVX2_INTRIN,
+            /*3       */    (EB_QIQ_TYPE)QiQVoidFunc,
+            /*4 32x32 */     QuantizeInvQuantizeNxN_AVX2_INTRIN,
+
+        },
     };
     static EB_MAT_MUL_TYPE FUNC_TABLE MatMul_funcPtrArray[ASM_TYPE_TOTAL][5] = {
         // NON_AVX2
@@ -4141,6 +4152,14 @@ extern "C" {
             /*3 16x16 */     MatMultNxN_AVX2_INTRIN,
             /*4 32x32 */     MatMultNxN_AVX2_INTRIN
         },
+        // AVX512
+        {
+            /*0 4x4   */     MatMult4x4_AVX2_INTRIN,
+            /*1 8x8   */     MatMult8x8_AVX2_INTRIN,
+            /*2 16x16 */     MatMultNxN_AVX2_INTRIN,
+            /*3 16x16 */     MatMultNxN_AVX2_INTRIN,
+            /*4 32x32 */     MatMultNxN_AVX2_INTRIN
+        },
 
 
     };
@@ -4161,6 +4180,14 @@ extern "C" {
             Transform4x4_SSE2_INTRIN,
             DstTransform4x4_SSE2_INTRIN
         },
+        // AVX512
+        {
+            lowPrecisionTransform32x32_AVX2_INTRIN,
+            lowPrecisionTransform16x16_AVX2_INTRIN,
+            Transform8x8_SSE4_1_INTRIN,
+            Transform4x4_SSE2_INTRIN,
+            DstTransform4x4_SSE2_INTRIN
+        },
     };
     static const EB_TRANSFORM_FUNC PfreqN2TransformTable[ASM_TYPE_TOTAL][5] = {
         // NON_AVX2
@@ -4173,6 +4200,14 @@ extern "C" {
 
         },
         // AVX2
+        {
+            PfreqTransform32x32_AVX2_INTRIN,
+            PfreqTransform16x16_SSE2,
+            PfreqTransform8x8_SSE4_1_INTRIN,
+            Transform4x4_SSE2_INTRIN,
+            DstTransform4x4_SSE2_INTRIN
+        },
+        // AVX512
         {
             PfreqTransform32x32_AVX2_INTRIN,
             PfreqTransform16x16_SSE2,
@@ -4191,6 +4226,14 @@ extern "C" {
             DstTransform4x4_SSE2_INTRIN
         },
         // AVX2
+        {
+            PfreqN4Transform32x32_AVX2_INTRIN,
+            PfreqN4Transform16x16_SSE2,
+            PfreqN4Transform8x8_SSE4_1_INTRIN,
+            Transform4x4_SSE2_INTRIN,
+            DstTransform4x4_SSE2_INTRIN
+        },
+        // AVX512
         {
             PfreqN4Transform32x32_AVX2_INTRIN,
             PfreqN4Transform16x16_SSE2,
@@ -4216,6 +4259,14 @@ extern "C" {
             Transform4x4_SSE2_INTRIN,
             DstTransform4x4_SSE2_INTRIN
         },
+        // AVX512
+        {
+            Transform32x32_SSE2,
+            Transform16x16_SSE2,
+            Transform8x8_SSE4_1_INTRIN,
+            Transform4x4_SSE2_INTRIN,
+            DstTransform4x4_SSE2_INTRIN
+        },
     };
     static const EB_INVTRANSFORM_FUNC invTransformFunctionTableEstimate[ASM_TYPE_TOTAL][5] = {
         // NON_AVX2
@@ -4234,6 +4285,14 @@ extern "C" {
             InvTransform4x4_SSE2_INTRIN,
             InvDstTransform4x4_SSE2_INTRIN
         },
+        // AVX512
+        {
+            EstimateInvTransform32x32_SSE2,
+            EstimateInvTransform16x16_SSE2,
+            InvTransform8x8_SSE2_INTRIN,
+            InvTransform4x4_SSE2_INTRIN,
+            InvDstTransform4x4_SSE2_INTRIN
+        },
     };
     static const EB_INVTRANSFORM_FUNC invTransformFunctionTableEncode[ASM_TYPE_TOTAL][5] = {
         // NON_AVX2
@@ -4252,6 +4311,14 @@ extern "C" {
             InvTransform4x4_SSE2_INTRIN,
             InvDstTransform4x4_SSE2_INTRIN
         },
+        // AVX512
+        {
+            PFinvTransform32x32_SSSE3,
+            PFinvTransform16x16_SSSE3,
+            InvTransform8x8_SSE2_INTRIN,
+            InvTransform4x4_SSE2_INTRIN,
+            InvDstTransform4x4_SSE2_INTRIN
+        },
     };
     void ConstructPmTransCoeffShaping(SequenceControlSet_t  *sequence_control_set_ptr);
 
@@ -552,6 +552,23 @@ void EbComputeOverallElapsedTimeMs(uint64_t Startseconds, uint64_t Startuseconds
 
 }
 
+void EbComputeOverallElapsedTimeUs(uint64_t Startseconds, uint64_t Startuseconds, uint64_t Finishseconds, uint64_t Finishuseconds, uint64_t *duration)
+{
+#if defined(__linux__) || defined(__APPLE__) //(LINUX_ENCODER_TIMING || LINUX_DECODER_TIMING)
+    *duration = (Finishseconds - Startseconds) * 1000000 + Finishuseconds - Startuseconds;
+#elif _WIN32 //(WIN_ENCODER_TIMING || WIN_DECODER_TIMING)
+    *duration = (Finishseconds - Startseconds) * 1000000 / CLOCKS_PER_SEC;
+    (void)(Startuseconds);
+    (void)(Finishuseconds);
+#else
+    (void)(Startuseconds);
+    (void)(Startseconds);
+    (void)(Finishuseconds);
+    (void)(Finishseconds);
+    *duration = 0;
+#endif
+}
+
 
 uint32_t ns_quarter_off_mult[9/*Up to 9 part*/][2/*x+y*/][4/*Up to 4 ns blocks per part*/] =
 {
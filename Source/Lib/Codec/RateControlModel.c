@@ -194,3 +194,157 @@ uint32_t get_gop_size_in_bytes(EbRateControlModel *model_ptr) {
 
     return gop_size + 1;
 }
+
+/*
+ * @private
+ * @function cbr_predicted_bits. Size in bits of a frame at the given QP,
+ * scaled from the reference clip to the current resolution and corrected
+ * by the feedback
+ * @param {EbRateControlModel*} model_ptr.
+ * @param {uint32_t} qp.
+ * @param {EbBool} intra.
+ * @param {uint32_t} temporal_layer.
+ * @return {uint64_t}.
+ */
+static uint64_t cbr_predicted_bits(EbRateControlModel *model_ptr, uint32_t qp, EbBool intra, uint32_t temporal_layer) {
+    double  size = intra ?
+        model_ptr->intra_size_predictions[qp] * model_ptr->intra_size_correction :
+        model_ptr->inter_size_predictions[qp] * model_ptr->inter_size_correction[temporal_layer];
+
+    return (uint64_t)(size / (1920 * 1080) * model_ptr->pixels) + 1;
+}
+
+EbErrorType rate_control_cbr_init(EbRateControlModel *model_ptr, SequenceControlSet_t *sequence_control_set_ptr, const uint8_t *layer_qp_offsets) {
+    EbSvtAv1EncConfiguration    *config = &sequence_control_set_ptr->static_config;
+    uint32_t                    layer;
+
+    model_ptr->desired_bitrate = config->target_bit_rate;
+    model_ptr->frame_rate = sequence_control_set_ptr->frame_rate >> 16;
+    model_ptr->width = sequence_control_set_ptr->luma_width;
+    model_ptr->height = sequence_control_set_ptr->luma_height;
+    model_ptr->pixels = model_ptr->width * model_ptr->height;
+    model_ptr->intra_period = sequence_control_set_ptr->intra_period_length;
+
+    model_ptr->bits_per_frame = ((uint64_t)config->target_bit_rate << 16) / sequence_control_set_ptr->frame_rate;
+    model_ptr->buffer_size = config->vbv_buffer_size;
+    model_ptr->buffer_level = (int64_t)(model_ptr->buffer_size * config->vbv_initial_fullness / 100);
+    model_ptr->target_level = model_ptr->buffer_level;
+    model_ptr->in_flight_bits = 0;
+    model_ptr->in_flight_count = 0;
+    model_ptr->base_qp = (uint32_t)~0;
+    model_ptr->intra_size_correction = 1.0;
+    for (layer = 0; layer < MAX_TEMPORAL_LAYERS; ++layer)
+        model_ptr->inter_size_correction[layer] = 1.0;
+    model_ptr->layer_qp_offsets = layer_qp_offsets;
+    EB_MEMSET(model_ptr->cbr_frames, 0, sizeof(model_ptr->cbr_frames));
+
+    return EB_ErrorNone;
+}
+
+uint8_t rate_control_cbr_get_quantizer(EbRateControlModel *model_ptr, PictureParentControlSet_t *picture_ptr) {
+    SequenceControlSet_t    *sequence_control_set_ptr = (SequenceControlSet_t*)picture_ptr->sequence_control_set_wrapper_ptr->objectPtr;
+    EbRateControlCbrFrame   *frame = &model_ptr->cbr_frames[picture_ptr->picture_number % CBR_FRAME_QUEUE_DEPTH];
+    const EbBool            intra = (EbBool)(picture_ptr->slice_type == I_SLICE);
+    const uint32_t          temporal_layer = picture_ptr->temporal_layer_index;
+    const uint32_t          min_qp = sequence_control_set_ptr->static_config.min_qp_allowed;
+    const uint32_t          max_qp = sequence_control_set_ptr->static_config.max_qp_allowed;
+    int64_t                 buffer_level;
+    int64_t                 max_frame_bits;
+    uint32_t                qp;
+
+    // Buffer level when the frame is decoded: the frames in the pipeline are removed
+    // first, and each adds one frame of channel bits
+    buffer_level = model_ptr->buffer_level - (int64_t)model_ptr->in_flight_bits + (int64_t)(model_ptr->in_flight_count * model_ptr->bits_per_frame);
+    buffer_level = MIN(buffer_level, (int64_t)model_ptr->buffer_size);
+
+    // The base QP is decided with the first picture of each mini GOP in decode order,
+    // the one whose predicted mini GOP size fits the budget steering the buffer back
+    // to its target level
+    if (temporal_layer == 0 || model_ptr->base_qp == (uint32_t)~0) {
+        const uint32_t  mini_gop_size = 1 << picture_ptr->hierarchical_levels;
+        const uint32_t  recovery_frames = MAX(mini_gop_size, model_ptr->frame_rate);
+        int64_t         budget;
+        uint32_t        base_qp;
+        uint32_t        layer;
+
+        budget = (int64_t)(mini_gop_size * model_ptr->bits_per_frame) + (buffer_level - model_ptr->target_level) * (int64_t)mini_gop_size / (int64_t)recovery_frames;
+        budget = MAX(budget, (int64_t)(mini_gop_size * model_ptr->bits_per_frame) / 4);
+
+        for (base_qp = min_qp; base_qp < max_qp; ++base_qp) {
+            uint64_t gop_bits = cbr_predicted_bits(model_ptr, MIN(base_qp + model_ptr->layer_qp_offsets[0], max_qp), EB_FALSE, 0);
+
+            for (layer = 1; layer <= picture_ptr->hierarchical_levels; ++layer)
+                gop_bits += ((uint64_t)1 << (layer - 1)) * cbr_predicted_bits(model_ptr, MIN(base_qp + model_ptr->layer_qp_offsets[layer], max_qp), EB_FALSE, layer);
+            if ((int64_t)gop_bits <= budget)
+                break;
+        }
+
+        // Smooth the base QP, the frame size constraint below is not smoothed
+        if (model_ptr->base_qp != (uint32_t)~0)
+            base_qp = CLIP3(MAX(model_ptr->base_qp, min_qp + 4) - 4, MIN(model_ptr->base_qp + 4, max_qp), base_qp);
+        model_ptr->base_qp = base_qp;
+    }
+
+    qp = intra ? model_ptr->base_qp : MIN(model_ptr->base_qp + model_ptr->layer_qp_offsets[temporal_layer], max_qp);
+
+    // The frame must fit in the buffer, with a margin for the prediction error
+    max_frame_bits = buffer_level - (int64_t)(model_ptr->buffer_size >> 3);
+    while (qp < max_qp && (int64_t)cbr_predicted_bits(model_ptr, qp, intra, temporal_layer) > max_frame_bits)
+        ++qp;
+
+    frame->picture_number = picture_ptr->picture_number;
+    frame->in_flight = EB_TRUE;
+    frame->intra = intra;
+    frame->temporal_layer = temporal_layer;
+    frame->qp = qp;
+    frame->predicted_bits = cbr_predicted_bits(model_ptr, qp, intra, temporal_layer);
+    frame->estimated_bits = frame->predicted_bits;
+    frame->coded_bits = 0;
+    frame->coded_rows = 0;
+    frame->total_rows = sequence_control_set_ptr->picture_height_in_sb * picture_ptr->av1_cm->tile_cols;
+
+    model_ptr->in_flight_bits += frame->estimated_bits;
+    model_ptr->in_flight_count++;
+
+    return (uint8_t)qp;
+}
+
+void rate_control_cbr_update_row(EbRateControlModel *model_ptr, uint64_t picture_number, uint32_t bits) {
+    EbRateControlCbrFrame   *frame = &model_ptr->cbr_frames[picture_number % CBR_FRAME_QUEUE_DEPTH];
+    uint64_t                estimated_bits;
+
+    if (!frame->in_flight || frame->picture_number != picture_number)
+        return;
+
+    frame->coded_bits += bits;
+    frame->coded_rows = MIN(frame->coded_rows + 1, frame->total_rows);
+
+    estimated_bits = frame->coded_bits + frame->predicted_bits * (frame->total_rows - frame->coded_rows) / frame->total_rows;
+    model_ptr->in_flight_bits = model_ptr->in_flight_bits - frame->estimated_bits + estimated_bits;
+    frame->estimated_bits = estimated_bits;
+}
+
+EbErrorType rate_control_cbr_update(EbRateControlModel *model_ptr, PictureParentControlSet_t *picture_ptr) {
+    EbRateControlCbrFrame   *frame = &model_ptr->cbr_frames[picture_ptr->picture_number % CBR_FRAME_QUEUE_DEPTH];
+    uint64_t                size = picture_ptr->total_num_bits;
+    double                  ratio;
+
+    if (!frame->in_flight || frame->picture_number != picture_ptr->picture_number)
+        return EB_ErrorNone;
+
+    frame->in_flight = EB_FALSE;
+    model_ptr->in_flight_bits -= frame->estimated_bits;
+    model_ptr->in_flight_count--;
+
+    model_ptr->buffer_level = MIN(model_ptr->buffer_level - (int64_t)size + (int64_t)model_ptr->bits_per_frame, (int64_t)model_ptr->buffer_size);
+
+    // Size corrections, the intra frames being rare they adapt faster
+    ratio = (double)size / frame->predicted_bits;
+    ratio = CLIP3(0.05, 20.0, ratio);
+    if (frame->intra)
+        model_ptr->intra_size_correction = model_ptr->intra_size_correction * (1 + ratio) / 2;
+    else
+        model_ptr->inter_size_correction[frame->temporal_layer] = model_ptr->inter_size_correction[frame->temporal_layer] * (3 + ratio) / 4;
+
+    return EB_ErrorNone;
+}
@@ -9,6 +9,65 @@
 #include "EbSequenceControlSet.h"
 #include "RateControlGopInfo.h"
 
+/*
+ * Number of pictures tracked by the constant bitrate mode between their QP
+ * decision and the feedback of their size. Indexed by picture number.
+ */
+#define CBR_FRAME_QUEUE_DEPTH   2048
+
+/*
+ * @struct Holds the constant bitrate state of a picture in the pipeline
+ */
+typedef struct    RateControlCbrFrame_s {
+    /*
+     * @variable uint64_t. Picture number of the entry.
+     */
+    uint64_t    picture_number;
+
+    /*
+     * @variable EbBool. Set from the QP decision until the size of the picture is known.
+     */
+    EbBool      in_flight;
+
+    /*
+     * @variable EbBool. Set for an intra picture, predicted with the intra sizes.
+     */
+    EbBool      intra;
+
+    /*
+     * @variable uint32_t. Temporal layer, selects the inter size correction.
+     */
+    uint32_t    temporal_layer;
+
+    /*
+     * @variable uint32_t. Assigned QP.
+     */
+    uint32_t    qp;
+
+    /*
+     * @variable uint64_t. Size in bits predicted by the model at the assigned QP.
+     */
+    uint64_t    predicted_bits;
+
+    /*
+     * @variable uint64_t. Current estimate of the size in bits: the coded SB rows
+     * plus the prediction for the rows left.
+     */
+    uint64_t    estimated_bits;
+
+    /*
+     * @variable uint64_t. Bits of the SB rows coded so far.
+     */
+    uint64_t    coded_bits;
+
+    /*
+     * @variable uint32_t. Number of SB rows coded so far, out of total_rows
+     * (SB rows times tile columns).
+     */
+    uint32_t    coded_rows;
+    uint32_t    total_rows;
+} EbRateControlCbrFrame;
+
 /*
  * @struct Holds a prediction model for a sequence
  */
@@ -83,6 +142,63 @@ typedef struct    RateControlModel_s {
      * Indexed by pictureNumber.
      */
     EbRateControlGopInfo    *gop_infos;
+
+    /*
+     * @variable uint64_t. Size in bits of the decoder buffer (VBV) of the
+     * constant bitrate mode.
+     */
+    uint64_t    buffer_size;
+
+    /*
+     * @variable int64_t. Decoder buffer level in bits once all the pictures
+     * whose size is known are removed. Negative after an underflow.
+     */
+    int64_t     buffer_level;
+
+    /*
+     * @variable int64_t. Level the buffer is steered to, its initial level.
+     */
+    int64_t     target_level;
+
+    /*
+     * @variable uint64_t. Bits entering the decoder buffer per frame.
+     */
+    uint64_t    bits_per_frame;
+
+    /*
+     * @variable uint64_t. Sum of the estimated sizes of the pictures in the pipeline.
+     */
+    uint64_t    in_flight_bits;
+
+    /*
+     * @variable uint32_t. Number of pictures in the pipeline.
+     */
+    uint32_t    in_flight_count;
+
+    /*
+     * @variable uint32_t. Base QP of the current mini GOP, decided with its
+     * first picture in decode order.
+     */
+    uint32_t    base_qp;
+
+    /*
+     * @variable double. Ratio of the actual size of the intra pictures, and of the
+     * inter pictures of each temporal layer, to the size predictions. Learned from
+     * the feedback.
+     */
+    double      intra_size_correction;
+    double      inter_size_correction[MAX_TEMPORAL_LAYERS];
+
+    /*
+     * @variable const uint8_t*. QP offset of each temporal layer from the base QP.
+     */
+    const uint8_t   *layer_qp_offsets;
+
+    /*
+     * @variable EbRateControlCbrFrame[]. Pictures between their QP decision and
+     * their feedback. Indexed by pictureNumber % CBR_FRAME_QUEUE_DEPTH.
+     */
+    EbRateControlCbrFrame   cbr_frames[CBR_FRAME_QUEUE_DEPTH];
 } EbRateControlModel;
 
 /*
@@ -130,4 +246,51 @@ uint8_t	rate_control_get_quantizer(EbRateControlModel *model_ptr,
  */
 uint32_t  get_gop_size_in_bytes(EbRateControlModel *model_ptr);
 
+/*
+ * @function rate_control_cbr_init. Initialize the decoder buffer model of the
+ * constant bitrate mode. Must be called before the other rate_control_cbr functions.
+ * @param {EbRateControlModel*} model_ptr.
+ * @param {SequenceControlSet_t*} sequence_control_set_ptr.
+ * @param {const uint8_t*} layer_qp_offsets. QP offset of each temporal layer.
+ * @return {EbErrorType}.
+ */
+EbErrorType rate_control_cbr_init(EbRateControlModel *model_ptr,
+                                  SequenceControlSet_t *sequence_control_set_ptr,
+                                  const uint8_t *layer_qp_offsets);
+
+/*
+ * @function rate_control_cbr_get_quantizer. Return the QP of the given frame in
+ * the constant bitrate mode, and account for its predicted size until its feedback.
+ * The base QP is the one whose predicted mini GOP size fits the bitrate, corrected
+ * by the distance of the buffer to its target level. The frame QP is then raised
+ * until its predicted size fits in the buffer.
+ * @param {EbRateControlModel*} model_ptr.
+ * @param {PictureParentControlSet_t*} picture_ptr. Frame to be encoded.
+ * @return {uint8_t}. QP of the frame
+ */
+uint8_t rate_control_cbr_get_quantizer(EbRateControlModel *model_ptr,
+                                       PictureParentControlSet_t *picture_ptr);
+
+/*
+ * @function rate_control_cbr_update_row. Refine the size estimate of a frame in
+ * the pipeline with the bits of one of its coded SB rows.
+ * @param {EbRateControlModel*} model_ptr.
+ * @param {uint64_t} picture_number.
+ * @param {uint32_t} bits. Bits of one SB row of one tile.
+ * @return {void}.
+ */
+void rate_control_cbr_update_row(EbRateControlModel *model_ptr,
+                                 uint64_t picture_number,
+                                 uint32_t bits);
+
+/*
+ * @function rate_control_cbr_update. Remove an encoded frame from the decoder
+ * buffer and update the size corrections.
+ * @param {EbRateControlModel*} model_ptr.
+ * @param {PictureParentControlSet_t*} picture_ptr. Encoded frame.
+ * @return {EbErrorType}.
+ */
+EbErrorType rate_control_cbr_update(EbRateControlModel *model_ptr,
+                                    PictureParentControlSet_t *picture_ptr);
+
 #endif // RateControlModel_h
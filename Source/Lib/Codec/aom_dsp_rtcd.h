@@ -40,6 +40,7 @@
 #define HAS_AVX 0x40
 #define HAS_AVX2 0x80
 #define HAS_SSE4_2 0x100
+#define HAS_AVX512 0x200
 
 
 #ifdef __cplusplus
@@ -85,6 +86,135 @@ extern "C" {
     void cdef_filter_block_avx2(uint8_t *dst8, uint16_t *dst16, int32_t dstride, const uint16_t *in, int32_t pri_strength, int32_t sec_strength, int32_t dir, int32_t pri_damping, int32_t sec_damping, int32_t bsize, int32_t max, int32_t coeff_shift);
     RTCD_EXTERN void(*cdef_filter_block)(uint8_t *dst8, uint16_t *dst16, int32_t dstride, const uint16_t *in, int32_t pri_strength, int32_t sec_strength, int32_t dir, int32_t pri_damping, int32_t sec_damping, int32_t bsize, int32_t max, int32_t coeff_shift);
 
+    // Loop filter of a 4 sample edge segment, and of 4 adjacent segments sharing the filter level
+    void aom_lpf_horizontal_4_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_horizontal_4_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    RTCD_EXTERN void(*aom_lpf_horizontal_4)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_horizontal_4_quad_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_horizontal_4_quad_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_horizontal_4_quad_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    RTCD_EXTERN void(*aom_lpf_horizontal_4_quad)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+
+    void aom_lpf_horizontal_6_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_horizontal_6_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    RTCD_EXTERN void(*aom_lpf_horizontal_6)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_horizontal_6_quad_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_horizontal_6_quad_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_horizontal_6_quad_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    RTCD_EXTERN void(*aom_lpf_horizontal_6_quad)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+
+    void aom_lpf_horizontal_8_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_horizontal_8_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    RTCD_EXTERN void(*aom_lpf_horizontal_8)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_horizontal_8_quad_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_horizontal_8_quad_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_horizontal_8_quad_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    RTCD_EXTERN void(*aom_lpf_horizontal_8_quad)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+
+    void aom_lpf_horizontal_14_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_horizontal_14_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    RTCD_EXTERN void(*aom_lpf_horizontal_14)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_horizontal_14_quad_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_horizontal_14_quad_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_horizontal_14_quad_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    RTCD_EXTERN void(*aom_lpf_horizontal_14_quad)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+
+    void aom_lpf_vertical_4_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_vertical_4_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    RTCD_EXTERN void(*aom_lpf_vertical_4)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_vertical_4_quad_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_vertical_4_quad_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_vertical_4_quad_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    RTCD_EXTERN void(*aom_lpf_vertical_4_quad)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+
+    void aom_lpf_vertical_6_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_vertical_6_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    RTCD_EXTERN void(*aom_lpf_vertical_6)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_vertical_6_quad_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_vertical_6_quad_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_vertical_6_quad_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    RTCD_EXTERN void(*aom_lpf_vertical_6_quad)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+
+    void aom_lpf_vertical_8_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_vertical_8_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    RTCD_EXTERN void(*aom_lpf_vertical_8)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_vertical_8_quad_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_vertical_8_quad_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_vertical_8_quad_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    RTCD_EXTERN void(*aom_lpf_vertical_8_quad)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+
+    void aom_lpf_vertical_14_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_vertical_14_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    RTCD_EXTERN void(*aom_lpf_vertical_14)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_vertical_14_quad_c(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_vertical_14_quad_sse2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    void aom_lpf_vertical_14_quad_avx2(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+    RTCD_EXTERN void(*aom_lpf_vertical_14_quad)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+
+    void aom_highbd_lpf_horizontal_4_c(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_horizontal_4_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_horizontal_4)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_horizontal_4_quad_c(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_horizontal_4_quad_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_horizontal_4_quad_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_horizontal_4_quad)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+
+    void aom_highbd_lpf_horizontal_6_c(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_horizontal_6_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_horizontal_6)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_horizontal_6_quad_c(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_horizontal_6_quad_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_horizontal_6_quad_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_horizontal_6_quad)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+
+    void aom_highbd_lpf_horizontal_8_c(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_horizontal_8_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_horizontal_8)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_horizontal_8_quad_c(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_horizontal_8_quad_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_horizontal_8_quad_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_horizontal_8_quad)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+
+    void aom_highbd_lpf_horizontal_14_c(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_horizontal_14_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_horizontal_14)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_horizontal_14_quad_c(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_horizontal_14_quad_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_horizontal_14_quad_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_horizontal_14_quad)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+
+    void aom_highbd_lpf_vertical_4_c(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_vertical_4_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_vertical_4)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_vertical_4_quad_c(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_vertical_4_quad_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_vertical_4_quad_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_vertical_4_quad)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+
+    void aom_highbd_lpf_vertical_6_c(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_vertical_6_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_vertical_6)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_vertical_6_quad_c(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_vertical_6_quad_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_vertical_6_quad_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_vertical_6_quad)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+
+    void aom_highbd_lpf_vertical_8_c(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_vertical_8_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_vertical_8)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_vertical_8_quad_c(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_vertical_8_quad_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_vertical_8_quad_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_vertical_8_quad)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+
+    void aom_highbd_lpf_vertical_14_c(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_vertical_14_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_vertical_14)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_vertical_14_quad_c(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_vertical_14_quad_sse2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    void aom_highbd_lpf_vertical_14_quad_avx2(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+    RTCD_EXTERN void(*aom_highbd_lpf_vertical_14_quad)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+
     void copy_rect8_8bit_to_16bit_c(uint16_t *dst, int32_t dstride, const uint8_t *src, int32_t sstride, int32_t v, int32_t h);
     void copy_rect8_8bit_to_16bit_avx2(uint16_t *dst, int32_t dstride, const uint8_t *src, int32_t sstride, int32_t v, int32_t h);
     RTCD_EXTERN void(*copy_rect8_8bit_to_16bit)(uint16_t *dst, int32_t dstride, const uint8_t *src, int32_t sstride, int32_t v, int32_t h);
@@ -241,6 +371,14 @@ extern "C" {
     void av1_fwd_txfm2d_4x4_sse4_1(int16_t *input, int32_t *output, uint32_t inputStride, TxType transform_type, uint8_t  bit_depth);
     RTCD_EXTERN void(*av1_fwd_txfm2d_4x4)(int16_t *input, int32_t *output, uint32_t inputStride, TxType transform_type, uint8_t  bit_depth);
 
+    // 8 bit residuals, 16 bit intermediates
+    void av1_lowbd_fwd_txfm2d_16x16_avx2(int16_t *input, int32_t *output, uint32_t inputStride, TxType transform_type, uint8_t  bit_depth);
+    RTCD_EXTERN void(*av1_lowbd_fwd_txfm2d_16x16)(int16_t *input, int32_t *output, uint32_t inputStride, TxType transform_type, uint8_t  bit_depth);
+    void av1_lowbd_fwd_txfm2d_8x8_avx2(int16_t *input, int32_t *output, uint32_t inputStride, TxType transform_type, uint8_t  bit_depth);
+    RTCD_EXTERN void(*av1_lowbd_fwd_txfm2d_8x8)(int16_t *input, int32_t *output, uint32_t inputStride, TxType transform_type, uint8_t  bit_depth);
+    void av1_lowbd_fwd_txfm2d_4x4_avx2(int16_t *input, int32_t *output, uint32_t inputStride, TxType transform_type, uint8_t  bit_depth);
+    RTCD_EXTERN void(*av1_lowbd_fwd_txfm2d_4x4)(int16_t *input, int32_t *output, uint32_t inputStride, TxType transform_type, uint8_t  bit_depth);
+
     void smooth_v_predictor_c(uint8_t *dst, ptrdiff_t stride, int32_t bw, int32_t bh, const uint8_t *above, const uint8_t *left);
     void eb_smooth_v_predictor_all_ssse3(uint8_t *dst, ptrdiff_t stride, int32_t bw, int32_t bh, const uint8_t *above, const uint8_t *left);
     RTCD_EXTERN void(*eb_smooth_v_predictor)(uint8_t *dst, ptrdiff_t stride, int32_t bw, int32_t bh, const uint8_t *above, const uint8_t *left);
@@ -278,6 +416,7 @@ extern "C" {
 
     void av1_convolve_2d_sr_c(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
     void av1_convolve_2d_sr_avx2(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
+    void av1_convolve_2d_sr_avx512(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
     RTCD_EXTERN void(*av1_convolve_2d_sr)(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
 
     void av1_jnt_convolve_2d_copy_c(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
@@ -303,20 +442,24 @@ extern "C" {
 
     void av1_jnt_convolve_2d_c(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
     void av1_jnt_convolve_2d_avx2(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
+    void av1_jnt_convolve_2d_avx512(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
     RTCD_EXTERN void(*av1_jnt_convolve_2d)(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
 
 
     void aom_quantize_b_c_II(const tran_low_t *coeff_ptr, intptr_t n_coeffs, int32_t skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan);
     void aom_highbd_quantize_b_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs, int32_t skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan);
+    void aom_quantize_b_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs, int32_t skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan);
     RTCD_EXTERN void(*aom_quantize_b)(const tran_low_t *coeff_ptr, intptr_t n_coeffs, int32_t skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan);
 
 
     void aom_quantize_b_32x32_c_II(const tran_low_t *coeff_ptr, intptr_t n_coeffs, int32_t skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan);
     void aom_highbd_quantize_b_32x32_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs, int skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan);
+    void aom_quantize_b_32x32_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs, int32_t skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan);
     RTCD_EXTERN void(*aom_quantize_b_32x32)(const tran_low_t *coeff_ptr, intptr_t n_coeffs, int32_t skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan);
 
     void aom_quantize_b_64x64_c_II(const tran_low_t *coeff_ptr, intptr_t n_coeffs, int32_t skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan);
     void aom_highbd_quantize_b_64x64_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs, int32_t skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan);
+    void aom_quantize_b_64x64_avx2(const tran_low_t *coeff_ptr, intptr_t n_coeffs, int32_t skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan);
     RTCD_EXTERN void(*aom_quantize_b_64x64)(const tran_low_t *coeff_ptr, intptr_t n_coeffs, int32_t skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan);
 
 #if QT_10BIT_SUPPORT
@@ -1987,8 +2130,13 @@ RTCD_EXTERN void(*av1_txb_init_levels)(const tran_low_t *const coeff, const int3
     {
         int32_t flags = HAS_MMX | HAS_SSE | HAS_SSE2 | HAS_SSE3 | HAS_SSSE3 | HAS_SSE4_1 | HAS_SSE4_2 | HAS_AVX;
 
-        if (asm_type == ASM_AVX2)
+        if (asm_type >= ASM_AVX2)
             flags |= HAS_AVX2;
+        // Only the kernels with a 512-bit version get an HAS_AVX512 row (the
+        // 2D convolutions); the transforms and cdef_filter_block have none and
+        // keep their AVX2 selection on the AVX-512 tier.
+        if (asm_type >= ASM_AVX512)
+            flags |= HAS_AVX512;
         //if (asm_type == ASM_NON_AVX2)
         //    flags = ~HAS_AVX2;
 
@@ -2013,6 +2161,87 @@ RTCD_EXTERN void(*av1_txb_init_levels)(const tran_low_t *const coeff, const int3
         cdef_filter_block = cdef_filter_block_c;
         if (flags & HAS_AVX2) cdef_filter_block = cdef_filter_block_avx2;
 
+        aom_lpf_horizontal_4 = aom_lpf_horizontal_4_c;
+        if (flags & HAS_SSE2) aom_lpf_horizontal_4 = aom_lpf_horizontal_4_sse2;
+        aom_lpf_horizontal_4_quad = aom_lpf_horizontal_4_quad_c;
+        if (flags & HAS_SSE2) aom_lpf_horizontal_4_quad = aom_lpf_horizontal_4_quad_sse2;
+        if (flags & HAS_AVX2) aom_lpf_horizontal_4_quad = aom_lpf_horizontal_4_quad_avx2;
+        aom_lpf_horizontal_6 = aom_lpf_horizontal_6_c;
+        if (flags & HAS_SSE2) aom_lpf_horizontal_6 = aom_lpf_horizontal_6_sse2;
+        aom_lpf_horizontal_6_quad = aom_lpf_horizontal_6_quad_c;
+        if (flags & HAS_SSE2) aom_lpf_horizontal_6_quad = aom_lpf_horizontal_6_quad_sse2;
+        if (flags & HAS_AVX2) aom_lpf_horizontal_6_quad = aom_lpf_horizontal_6_quad_avx2;
+        aom_lpf_horizontal_8 = aom_lpf_horizontal_8_c;
+        if (flags & HAS_SSE2) aom_lpf_horizontal_8 = aom_lpf_horizontal_8_sse2;
+        aom_lpf_horizontal_8_quad = aom_lpf_horizontal_8_quad_c;
+        if (flags & HAS_SSE2) aom_lpf_horizontal_8_quad = aom_lpf_horizontal_8_quad_sse2;
+        if (flags & HAS_AVX2) aom_lpf_horizontal_8_quad = aom_lpf_horizontal_8_quad_avx2;
+        aom_lpf_horizontal_14 = aom_lpf_horizontal_14_c;
+        if (flags & HAS_SSE2) aom_lpf_horizontal_14 = aom_lpf_horizontal_14_sse2;
+        aom_lpf_horizontal_14_quad = aom_lpf_horizontal_14_quad_c;
+        if (flags & HAS_SSE2) aom_lpf_horizontal_14_quad = aom_lpf_horizontal_14_quad_sse2;
+        if (flags & HAS_AVX2) aom_lpf_horizontal_14_quad = aom_lpf_horizontal_14_quad_avx2;
+        aom_lpf_vertical_4 = aom_lpf_vertical_4_c;
+        if (flags & HAS_SSE2) aom_lpf_vertical_4 = aom_lpf_vertical_4_sse2;
+        aom_lpf_vertical_4_quad = aom_lpf_vertical_4_quad_c;
+        if (flags & HAS_SSE2) aom_lpf_vertical_4_quad = aom_lpf_vertical_4_quad_sse2;
+        if (flags & HAS_AVX2) aom_lpf_vertical_4_quad = aom_lpf_vertical_4_quad_avx2;
+        aom_lpf_vertical_6 = aom_lpf_vertical_6_c;
+        if (flags & HAS_SSE2) aom_lpf_vertical_6 = aom_lpf_vertical_6_sse2;
+        aom_lpf_vertical_6_quad = aom_lpf_vertical_6_quad_c;
+        if (flags & HAS_SSE2) aom_lpf_vertical_6_quad = aom_lpf_vertical_6_quad_sse2;
+        if (flags & HAS_AVX2) aom_lpf_vertical_6_quad = aom_lpf_vertical_6_quad_avx2;
+        aom_lpf_vertical_8 = aom_lpf_vertical_8_c;
+        if (flags & HAS_SSE2) aom_lpf_vertical_8 = aom_lpf_vertical_8_sse2;
+        aom_lpf_vertical_8_quad = aom_lpf_vertical_8_quad_c;
+        if (flags & HAS_SSE2) aom_lpf_vertical_8_quad = aom_lpf_vertical_8_quad_sse2;
+        if (flags & HAS_AVX2) aom_lpf_vertical_8_quad = aom_lpf_vertical_8_quad_avx2;
+        aom_lpf_vertical_14 = aom_lpf_vertical_14_c;
+        if (flags & HAS_SSE2) aom_lpf_vertical_14 = aom_lpf_vertical_14_sse2;
+        aom_lpf_vertical_14_quad = aom_lpf_vertical_14_quad_c;
+        if (flags & HAS_SSE2) aom_lpf_vertical_14_quad = aom_lpf_vertical_14_quad_sse2;
+        if (flags & HAS_AVX2) aom_lpf_vertical_14_quad = aom_lpf_vertical_14_quad_avx2;
+        aom_highbd_lpf_horizontal_4 = aom_highbd_lpf_horizontal_4_c;
+        if (flags & HAS_SSE2) aom_highbd_lpf_horizontal_4 = aom_highbd_lpf_horizontal_4_sse2;
+        aom_highbd_lpf_horizontal_4_quad = aom_highbd_lpf_horizontal_4_quad_c;
+        if (flags & HAS_SSE2) aom_highbd_lpf_horizontal_4_quad = aom_highbd_lpf_horizontal_4_quad_sse2;
+        if (flags & HAS_AVX2) aom_highbd_lpf_horizontal_4_quad = aom_highbd_lpf_horizontal_4_quad_avx2;
+        aom_highbd_lpf_horizontal_6 = aom_highbd_lpf_horizontal_6_c;
+        if (flags & HAS_SSE2) aom_highbd_lpf_horizontal_6 = aom_highbd_lpf_horizontal_6_sse2;
+        aom_highbd_lpf_horizontal_6_quad = aom_highbd_lpf_horizontal_6_quad_c;
+        if (flags & HAS_SSE2) aom_highbd_lpf_horizontal_6_quad = aom_highbd_lpf_horizontal_6_quad_sse2;
+        if (flags & HAS_AVX2) aom_highbd_lpf_horizontal_6_quad = aom_highbd_lpf_horizontal_6_quad_avx2;
+        aom_highbd_lpf_horizontal_8 = aom_highbd_lpf_horizontal_8_c;
+        if (flags & HAS_SSE2) aom_highbd_lpf_horizontal_8 = aom_highbd_lpf_horizontal_8_sse2;
+        aom_highbd_lpf_horizontal_8_quad = aom_highbd_lpf_horizontal_8_quad_c;
+        if (flags & HAS_SSE2) aom_highbd_lpf_horizontal_8_quad = aom_highbd_lpf_horizontal_8_quad_sse2;
+        if (flags & HAS_AVX2) aom_highbd_lpf_horizontal_8_quad = aom_highbd_lpf_horizontal_8_quad_avx2;
+        aom_highbd_lpf_horizontal_14 = aom_highbd_lpf_horizontal_14_c;
+        if (flags & HAS_SSE2) aom_highbd_lpf_horizontal_14 = aom_highbd_lpf_horizontal_14_sse2;
+        aom_highbd_lpf_horizontal_14_quad = aom_highbd_lpf_horizontal_14_quad_c;
+        if (flags & HAS_SSE2) aom_highbd_lpf_horizontal_14_quad = aom_highbd_lpf_horizontal_14_quad_sse2;
+        if (flags & HAS_AVX2) aom_highbd_lpf_horizontal_14_quad = aom_highbd_lpf_horizontal_14_quad_avx2;
+        aom_highbd_lpf_vertical_4 = aom_highbd_lpf_vertical_4_c;
+        if (flags & HAS_SSE2) aom_highbd_lpf_vertical_4 = aom_highbd_lpf_vertical_4_sse2;
+        aom_highbd_lpf_vertical_4_quad = aom_highbd_lpf_vertical_4_quad_c;
+        if (flags & HAS_SSE2) aom_highbd_lpf_vertical_4_quad = aom_highbd_lpf_vertical_4_quad_sse2;
+        if (flags & HAS_AVX2) aom_highbd_lpf_vertical_4_quad = aom_highbd_lpf_vertical_4_quad_avx2;
+        aom_highbd_lpf_vertical_6 = aom_highbd_lpf_vertical_6_c;
+        if (flags & HAS_SSE2) aom_highbd_lpf_vertical_6 = aom_highbd_lpf_vertical_6_sse2;
+        aom_highbd_lpf_vertical_6_quad = aom_highbd_lpf_vertical_6_quad_c;
+        if (flags & HAS_SSE2) aom_highbd_lpf_vertical_6_quad = aom_highbd_lpf_vertical_6_quad_sse2;
+        if (flags & HAS_AVX2) aom_highbd_lpf_vertical_6_quad = aom_highbd_lpf_vertical_6_quad_avx2;
+        aom_highbd_lpf_vertical_8 = aom_highbd_lpf_vertical_8_c;
+        if (flags & HAS_SSE2) aom_highbd_lpf_vertical_8 = aom_highbd_lpf_vertical_8_sse2;
+        aom_highbd_lpf_vertical_8_quad = aom_highbd_lpf_vertical_8_quad_c;
+        if (flags & HAS_SSE2) aom_highbd_lpf_vertical_8_quad = aom_highbd_lpf_vertical_8_quad_sse2;
+        if (flags & HAS_AVX2) aom_highbd_lpf_vertical_8_quad = aom_highbd_lpf_vertical_8_quad_avx2;
+        aom_highbd_lpf_vertical_14 = aom_highbd_lpf_vertical_14_c;
+        if (flags & HAS_SSE2) aom_highbd_lpf_vertical_14 = aom_highbd_lpf_vertical_14_sse2;
+        aom_highbd_lpf_vertical_14_quad = aom_highbd_lpf_vertical_14_quad_c;
+        if (flags & HAS_SSE2) aom_highbd_lpf_vertical_14_quad = aom_highbd_lpf_vertical_14_quad_sse2;
+        if (flags & HAS_AVX2) aom_highbd_lpf_vertical_14_quad = aom_highbd_lpf_vertical_14_quad_avx2;
+
         copy_rect8_8bit_to_16bit = copy_rect8_8bit_to_16bit_c;
         if (flags & HAS_AVX2) copy_rect8_8bit_to_16bit = copy_rect8_8bit_to_16bit_avx2;
 
@@ -2080,6 +2309,7 @@ RTCD_EXTERN void(*av1_txb_init_levels)(const tran_low_t *const coeff, const int3
 
         av1_convolve_2d_sr = av1_convolve_2d_sr_c;
         if (flags & HAS_AVX2) av1_convolve_2d_sr = av1_convolve_2d_sr_avx2;
+        if (flags & HAS_AVX512) av1_convolve_2d_sr = av1_convolve_2d_sr_avx512;
 
         av1_jnt_convolve_2d_copy = av1_jnt_convolve_2d_copy_c;
         if (flags & HAS_AVX2) av1_jnt_convolve_2d_copy = av1_jnt_convolve_2d_copy_avx2;
@@ -2096,12 +2326,13 @@ RTCD_EXTERN void(*av1_txb_init_levels)(const tran_low_t *const coeff, const int3
 
         av1_jnt_convolve_2d = av1_jnt_convolve_2d_c;
         if (flags & HAS_AVX2) av1_jnt_convolve_2d = av1_jnt_convolve_2d_avx2;
+        if (flags & HAS_AVX512) av1_jnt_convolve_2d = av1_jnt_convolve_2d_avx512;
 
         aom_quantize_b = aom_quantize_b_c_II;
-        if (flags & HAS_AVX2) aom_quantize_b = aom_highbd_quantize_b_avx2;
+        if (flags & HAS_AVX2) aom_quantize_b = aom_quantize_b_avx2;
 
         aom_quantize_b_32x32 = aom_quantize_b_32x32_c_II;
-        if (flags & HAS_AVX2) aom_quantize_b_32x32 = aom_highbd_quantize_b_32x32_avx2;
+        if (flags & HAS_AVX2) aom_quantize_b_32x32 = aom_quantize_b_32x32_avx2;
 
         aom_highbd_quantize_b_32x32 = aom_highbd_quantize_b_32x32_c;
         if (flags & HAS_AVX2) aom_highbd_quantize_b_32x32 = aom_highbd_quantize_b_32x32_avx2;
@@ -2843,7 +3074,7 @@ RTCD_EXTERN void(*av1_txb_init_levels)(const tran_low_t *const coeff, const int3
         //QIQ
 #if INTRINSIC_OPT_2
         aom_quantize_b_64x64 = aom_quantize_b_64x64_c_II;
-        if (flags & HAS_AVX2) aom_quantize_b_64x64 = aom_highbd_quantize_b_64x64_avx2;
+        if (flags & HAS_AVX2) aom_quantize_b_64x64 = aom_quantize_b_64x64_avx2;
 
         aom_highbd_quantize_b_64x64 = aom_highbd_quantize_b_64x64_c;
         if (flags & HAS_AVX2) aom_highbd_quantize_b_64x64 = aom_highbd_quantize_b_64x64_avx2;
@@ -2905,6 +3136,13 @@ RTCD_EXTERN void(*av1_txb_init_levels)(const tran_low_t *const coeff, const int3
         if (flags & HAS_AVX2) av1_fwd_txfm2d_8x8 = av1_fwd_txfm2d_8x8_avx2;
         av1_fwd_txfm2d_4x4 = Av1TransformTwoD_4x4_c;
         if (flags & HAS_SSE4_1) av1_fwd_txfm2d_4x4 = av1_fwd_txfm2d_4x4_sse4_1;
+        av1_lowbd_fwd_txfm2d_16x16 = Av1TransformTwoD_16x16_c;
+        if (flags & HAS_AVX2) av1_lowbd_fwd_txfm2d_16x16 = av1_lowbd_fwd_txfm2d_16x16_avx2;
+        av1_lowbd_fwd_txfm2d_8x8 = Av1TransformTwoD_8x8_c;
+        if (flags & HAS_AVX2) av1_lowbd_fwd_txfm2d_8x8 = av1_lowbd_fwd_txfm2d_8x8_avx2;
+        av1_lowbd_fwd_txfm2d_4x4 = Av1TransformTwoD_4x4_c;
+        if (flags & HAS_SSE4_1) av1_lowbd_fwd_txfm2d_4x4 = av1_fwd_txfm2d_4x4_sse4_1;
+        if (flags & HAS_AVX2) av1_lowbd_fwd_txfm2d_4x4 = av1_lowbd_fwd_txfm2d_4x4_avx2;
 
         // aom_highbd_h_predictor
         aom_highbd_h_predictor_16x4 = aom_highbd_h_predictor_16x4_c;
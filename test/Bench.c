@@ -0,0 +1,48 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// SvtAv1Bench
+//  -Times the SIMD kernels of an asm level, the highest one of the CPU
+//   unless given with -asm, against their reference
+//  -Prints the cycles per call of both for each kernel and block size
+
+#include <stdio.h>
+
+#include "KernelCheck.h"
+
+static void PrintKernelReport(
+    void                    *report_ctx,
+    const KernelReport_t    *report)
+{
+    (void)report_ctx;
+    printf("%-50s %3ux%-3u %6u calls %6u mismatches %10.1f %10.1f cycles x%.2f\n",
+        report->kernel_name,
+        report->width,
+        report->height,
+        report->call_count,
+        report->mismatch_count,
+        report->ref_cycles,
+        report->opt_cycles,
+        report->opt_cycles > 0 ? report->ref_cycles / report->opt_cycles : 0);
+}
+
+int32_t main(int32_t argc, char *argv[])
+{
+    EbAsm       asmType = GetCpuAsmType();
+    uint32_t    iterations = 0;
+    EbErrorType return_error;
+
+    if (KernelCheckOptions(argc, argv, &asmType, &iterations) != EB_ErrorNone)
+        return 1;
+
+    printf("\n%-50s %7s %12s %17s %10s %10s\n", "KERNEL", "SIZE", "", "", "REFERENCE", "SIMD");
+    return_error = KernelCheck(asmType, iterations, PrintKernelReport, NULL);
+    if (return_error == EB_ErrorUndefined)
+        printf("Error: SIMD kernels differ from their reference\n");
+    else if (return_error != EB_ErrorNone)
+        printf("Error: kernel check failed with 0x%x\n", return_error);
+
+    return (return_error == EB_ErrorNone) ? 0 : 1;
+}
@@ -0,0 +1,1158 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef _WIN32
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#include "KernelCheck.h"
+#include "EbUtility.h"
+#include "EbComputeSAD.h"
+#include "EbCdef.h"
+#include "EbInterPrediction.h"
+#include "EbPictureControlSet.h"
+#include "EbTransforms.h"
+#include "convolve.h"
+#include "aom_dsp_rtcd.h"
+
+/**************************************
+ * Defines
+ **************************************/
+#define KC_STRIDE               256                                 // stride of the sample buffers
+#define KC_ROWS                 256
+#define KC_BORDER               8                                   // margin left for the filter taps
+#define KC_OFFSET_MASK          63                                  // random block offsets within the buffers
+#define KC_OUT_SIZE             (128 * 128 * 4)
+#define KC_COEFF_SETS           16                                  // coefficient blocks of the inverse transforms
+#define KC_SAD16_COUNT          4096
+#define KC_LPF_SETS             64                                  // 16x16 blocks across a loop filter edge
+#define KC_ALIGN(x)             (((x) + 63) & ~63)
+
+typedef void(*EbKernelFunc)(void);
+
+/**************************************
+ * Kernel Check Context
+ **************************************/
+typedef struct KernelCheckContext_s
+{
+    EbAsm                    asm_type;
+    uint32_t                 iterations;
+    KernelReportCallback     callback;
+    void                    *report_ctx;
+    uint32_t                 mismatch_total;
+
+    // Case being checked
+    uint32_t                 width;
+    uint32_t                 height;
+    int32_t                  param;             // kernel specific: stride scale, search area, table entry...
+
+    // Inputs
+    uint8_t                 *src;               // random samples
+    uint8_t                 *near_ref;          // src plus a small noise
+    uint8_t                 *far_ref;           // random samples unrelated to src
+    uint8_t                 *flat_low;          // all 0
+    uint8_t                 *flat_high;         // all 255
+    uint16_t                *src16;             // random 10 bit samples
+    int16_t                 *residual;          // extreme block at the top, random residuals below
+    uint16_t                *conv_buf;          // random compound predictions
+    uint16_t                *sad16x16;          // 16x16 SADs of the eight point search
+    uint16_t                *cdef_buf;          // random samples, left border set to CDEF_VERY_LARGE
+    int32_t                 *qcoeff;            // random quantized coefficients
+    int32_t                 *coeff;             // KC_COEFF_SETS forward transformed blocks, then quantizer inputs
+    Quants                  *quants;            // 8 bit quantizer tables
+    Dequants                *dequants;
+    uint8_t                 *lpf_buf;           // KC_LPF_SETS blocks across a horizontal then a vertical edge
+    uint16_t                *lpf_buf16;         // the same blocks in 10 bit
+    loop_filter_thresh      *lpf_thr;           // thresholds of the filter levels, sharpness 0
+
+    // Outputs
+    uint8_t                 *out_ref;
+    uint8_t                 *out_opt;
+} KernelCheckContext_t;
+
+void av1_build_quantizer(
+    aom_bit_depth_t bit_depth,
+    int32_t y_dc_delta_q,
+    int32_t u_dc_delta_q,
+    int32_t u_ac_delta_q,
+    int32_t v_dc_delta_q,
+    int32_t v_ac_delta_q,
+    Quants *const quants,
+    Dequants *const deq);
+
+typedef void(*KernelCheckCall)(
+    KernelCheckContext_t    *context_ptr,
+    EbKernelFunc             kernel,
+    uint32_t                 iteration,
+    uint8_t                 *out);
+
+/**************************************
+ * Helpers
+ **************************************/
+static uint32_t KernelCheckHash(uint32_t value)
+{
+    value ^= value >> 16;
+    value *= 0x7feb352d;
+    value ^= value >> 15;
+    value *= 0x846ca68b;
+    value ^= value >> 16;
+    return value;
+}
+
+// 64 byte aligned, as the picture buffers
+static void *KernelCheckMalloc(size_t size)
+{
+#ifdef _WIN32
+    return _aligned_malloc(size, 64);
+#else
+    void *pointer;
+    return posix_memalign(&pointer, 64, size) ? NULL : pointer;
+#endif
+}
+
+static void KernelCheckFree(void *pointer)
+{
+#ifdef _WIN32
+    _aligned_free(pointer);
+#else
+    free(pointer);
+#endif
+}
+
+static void KernelCheckFill(uint8_t *buffer, uint32_t size, uint32_t seed)
+{
+    for (uint32_t i = 0; i < size; ++i)
+        buffer[i] = (uint8_t)(KernelCheckHash(seed + i) >> 8);
+}
+
+// Mirrors setup_rtcd_internal: the version used at asm_type among the C,
+// AVX2 and AVX-512 versions of a kernel, NULL for the missing ones.
+static EbKernelFunc KernelCheckSelect(
+    EbAsm           asm_type,
+    EbKernelFunc    c_func,
+    EbKernelFunc    avx2_func,
+    EbKernelFunc    avx512_func)
+{
+    if (asm_type >= ASM_AVX512 && avx512_func)
+        return avx512_func;
+    if (asm_type >= ASM_AVX2 && avx2_func)
+        return avx2_func;
+    return c_func;
+}
+
+// Iteration 0 pairs the all 0 and the all 255 buffers (largest sums), iteration 1
+// two all 255 buffers (ties everywhere); the others take a random source block
+// and a reference block close to it or unrelated to it.
+static void KernelCheckBlocks(
+    KernelCheckContext_t    *context_ptr,
+    uint32_t                 iteration,
+    uint8_t                **src,
+    uint8_t                **ref)
+{
+    uint32_t hash = KernelCheckHash(iteration + 1);
+    uint32_t srcOffset = (KC_BORDER + (hash & KC_OFFSET_MASK)) * KC_STRIDE + KC_BORDER + ((hash >> 6) & KC_OFFSET_MASK);
+    uint32_t refOffset = (KC_BORDER + ((hash >> 12) & KC_OFFSET_MASK)) * KC_STRIDE + KC_BORDER + ((hash >> 18) & KC_OFFSET_MASK);
+
+    if (iteration == 0) {
+        *src = context_ptr->flat_low + srcOffset;
+        *ref = context_ptr->flat_high + refOffset;
+    }
+    else if (iteration == 1) {
+        *src = context_ptr->flat_high + srcOffset;
+        *ref = context_ptr->flat_high + refOffset;
+    }
+    else if (iteration & 1) {
+        *src = context_ptr->src + srcOffset;
+        *ref = context_ptr->near_ref + srcOffset;
+    }
+    else {
+        *src = context_ptr->src + srcOffset;
+        *ref = context_ptr->far_ref + refOffset;
+    }
+}
+
+/**************************************
+ * Runs kernel and reference over the iterations, compares the first out_size
+ * bytes of their outputs then times each of them over the same inputs
+ **************************************/
+static void KernelCheckRun(
+    KernelCheckContext_t    *context_ptr,
+    const char              *kernel_name,
+    KernelCheckCall          call,
+    EbKernelFunc             ref_kernel,
+    EbKernelFunc             opt_kernel,
+    uint32_t                 out_size,
+    uint32_t                 iterations)
+{
+    KernelReport_t report;
+    uint64_t startCycles;
+    uint32_t iteration;
+
+    if (opt_kernel == ref_kernel || opt_kernel == (EbKernelFunc)EB_NULL)
+        return;
+
+    report.kernel_name = kernel_name;
+    report.width = context_ptr->width;
+    report.height = context_ptr->height;
+    report.call_count = iterations;
+    report.mismatch_count = 0;
+
+    for (iteration = 0; iteration < iterations; ++iteration) {
+        memset(context_ptr->out_ref, 0, out_size);
+        memset(context_ptr->out_opt, 0, out_size);
+        call(context_ptr, ref_kernel, iteration, context_ptr->out_ref);
+        call(context_ptr, opt_kernel, iteration, context_ptr->out_opt);
+        if (memcmp(context_ptr->out_ref, context_ptr->out_opt, out_size))
+            report.mismatch_count++;
+    }
+
+    startCycles = __rdtsc();
+    for (iteration = 0; iteration < iterations; ++iteration)
+        call(context_ptr, ref_kernel, iteration, context_ptr->out_ref);
+    report.ref_cycles = (double)(__rdtsc() - startCycles) / iterations;
+
+    startCycles = __rdtsc();
+    for (iteration = 0; iteration < iterations; ++iteration)
+        call(context_ptr, opt_kernel, iteration, context_ptr->out_opt);
+    report.opt_cycles = (double)(__rdtsc() - startCycles) / iterations;
+
+    context_ptr->mismatch_total += report.mismatch_count;
+    if (context_ptr->callback)
+        context_ptr->callback(context_ptr->report_ctx, &report);
+}
+
+/**************************************
+ * SAD
+ **************************************/
+static const uint32_t sadWidths[] = { 4, 8, 16, 24, 32, 48, 64 };
+static const uint32_t sadHeights[] = { 4, 8, 16, 32, 64 };
+
+// param is the row step: 2 for the sub-sampled kernels
+static void KernelCheckSadCall(
+    KernelCheckContext_t    *context_ptr,
+    EbKernelFunc             kernel,
+    uint32_t                 iteration,
+    uint8_t                 *out)
+{
+    uint8_t *src, *ref;
+    KernelCheckBlocks(context_ptr, iteration, &src, &ref);
+    *(uint32_t*)out = ((EB_SADKERNELNxM_TYPE)kernel)(
+        src, KC_STRIDE * context_ptr->param,
+        ref, KC_STRIDE * context_ptr->param,
+        context_ptr->height / context_ptr->param,
+        context_ptr->width);
+}
+
+static void KernelCheckAveragingSadCall(
+    KernelCheckContext_t    *context_ptr,
+    EbKernelFunc             kernel,
+    uint32_t                 iteration,
+    uint8_t                 *out)
+{
+    uint8_t *src, *ref1, *ref2, *unused;
+    KernelCheckBlocks(context_ptr, iteration, &src, &ref1);
+    KernelCheckBlocks(context_ptr, iteration + context_ptr->iterations, &unused, &ref2);
+    *(uint32_t*)out = ((EB_SADAVGKERNELNxM_TYPE)kernel)(
+        src, KC_STRIDE,
+        ref1, KC_STRIDE,
+        ref2, KC_STRIDE,
+        context_ptr->height,
+        context_ptr->width);
+}
+
+typedef struct SadLoopResult_s
+{
+    uint64_t    best_sad;
+    int16_t     x_best;
+    int16_t     y_best;
+} SadLoopResult_t;
+
+// param is the search area, width in the low 16 bits
+static void KernelCheckSadLoopCall(
+    KernelCheckContext_t    *context_ptr,
+    EbKernelFunc             kernel,
+    uint32_t                 iteration,
+    uint8_t                 *out)
+{
+    SadLoopResult_t *result = (SadLoopResult_t*)out;
+    uint8_t *src, *ref;
+    KernelCheckBlocks(context_ptr, iteration, &src, &ref);
+    ((EB_SADLOOPKERNELNxM_TYPE)kernel)(
+        src, KC_STRIDE,
+        ref, KC_STRIDE,
+        context_ptr->height, context_ptr->width,
+        &result->best_sad, &result->x_best, &result->y_best,
+        KC_STRIDE,
+        (int16_t)(context_ptr->param & 0xFFFF),
+        (int16_t)(context_ptr->param >> 16));
+}
+
+typedef struct EightPoint16x16Result_s
+{
+    uint16_t    sad16x16[8];                // stored aligned
+    uint32_t    best_sad8x8[4];
+    uint32_t    best_mv8x8[4];
+    uint32_t    best_sad16x16;
+    uint32_t    best_mv16x16;
+} EightPoint16x16Result_t;
+
+static void KernelCheckEightPoint16x16Call(
+    KernelCheckContext_t    *context_ptr,
+    EbKernelFunc             kernel,
+    uint32_t                 iteration,
+    uint8_t                 *out)
+{
+    EightPoint16x16Result_t *result = (EightPoint16x16Result_t*)out;
+    uint32_t hash = KernelCheckHash(~iteration);
+    uint32_t bestSad = (iteration & 1) ? hash & 0x3FFF : 0xFFFFFFFF;
+    uint8_t *src, *ref;
+
+    KernelCheckBlocks(context_ptr, iteration, &src, &ref);
+    result->best_sad8x8[0] = result->best_sad8x8[1] = result->best_sad8x8[2] = result->best_sad8x8[3] = bestSad >> 2;
+    result->best_sad16x16 = bestSad;
+    ((EB_GETEIGHTSAD8x8)kernel)(
+        src, KC_STRIDE,
+        ref, KC_STRIDE,
+        result->best_sad8x8, result->best_mv8x8,
+        &result->best_sad16x16, &result->best_mv16x16,
+        hash,
+        result->sad16x16);
+}
+
+typedef struct EightPoint64x64Result_s
+{
+    uint32_t    best_sad32x32[4];
+    uint32_t    best_sad64x64;
+    uint32_t    best_mv32x32[4];
+    uint32_t    best_mv64x64;
+} EightPoint64x64Result_t;
+
+// Iteration 0 reads the largest 16x16 SADs, iteration 1 equal ones
+static void KernelCheckEightPoint64x64Call(
+    KernelCheckContext_t    *context_ptr,
+    EbKernelFunc             kernel,
+    uint32_t                 iteration,
+    uint8_t                 *out)
+{
+    EightPoint64x64Result_t *result = (EightPoint64x64Result_t*)out;
+    uint32_t hash = KernelCheckHash(~iteration);
+    uint32_t bestSad = (iteration & 1) ? hash & 0x3FFFF : 0xFFFFFFFF;
+    uint16_t *sad16x16 = context_ptr->sad16x16 + (iteration < 2 ? iteration * 128 : 256 + hash % (KC_SAD16_COUNT - 384));
+
+    result->best_sad32x32[0] = result->best_sad32x32[1] = result->best_sad32x32[2] = result->best_sad32x32[3] = bestSad >> 2;
+    result->best_sad64x64 = bestSad;
+    ((EB_GETEIGHTSAD32x32)kernel)(
+        sad16x16,
+        result->best_sad32x32, &result->best_sad64x64,
+        result->best_mv32x32, &result->best_mv64x64,
+        hash);
+}
+
+static void KernelCheckSad(KernelCheckContext_t *context_ptr)
+{
+    EbAsm asm_type = context_ptr->asm_type;
+    uint32_t widthIndex, heightIndex;
+
+    for (widthIndex = 0; widthIndex < sizeof(sadWidths) / sizeof(sadWidths[0]); ++widthIndex) {
+        for (heightIndex = 0; heightIndex < sizeof(sadHeights) / sizeof(sadHeights[0]); ++heightIndex) {
+            context_ptr->width = sadWidths[widthIndex];
+            context_ptr->height = sadHeights[heightIndex];
+
+            context_ptr->param = 1;
+            KernelCheckRun(context_ptr, "NxMSadKernel", KernelCheckSadCall,
+                (EbKernelFunc)FastLoop_NxMSadKernel,
+                (EbKernelFunc)NxMSadKernel_funcPtrArray[asm_type][context_ptr->width >> 3],
+                sizeof(uint32_t), context_ptr->iterations);
+
+            // The SIMD kernels handle 4 rows at a time
+            context_ptr->param = 2;
+            if (context_ptr->height / context_ptr->param >= 4)
+                KernelCheckRun(context_ptr, "NxMSadKernelSubSampled", KernelCheckSadCall,
+                    (EbKernelFunc)FastLoop_NxMSadKernel,
+                    (EbKernelFunc)NxMSadKernelSubSampled_funcPtrArray[asm_type][context_ptr->width >> 3],
+                    sizeof(uint32_t), context_ptr->iterations);
+
+            KernelCheckRun(context_ptr, "NxMSadAveragingKernel", KernelCheckAveragingSadCall,
+                (EbKernelFunc)CombinedAveragingSAD,
+                (EbKernelFunc)NxMSadAveragingKernel_funcPtrArray[asm_type][context_ptr->width >> 3],
+                sizeof(uint32_t), context_ptr->iterations);
+        }
+    }
+
+    // The C loop is slow enough to run it on fewer inputs
+    for (widthIndex = 8; widthIndex <= 64; widthIndex <<= 1) {
+        for (heightIndex = 1; heightIndex < 4; ++heightIndex) {
+            context_ptr->width = widthIndex;
+            context_ptr->height = sadHeights[heightIndex];
+            context_ptr->param = (16 << 16) | 32;
+            KernelCheckRun(context_ptr, "NxMSadLoopKernel", KernelCheckSadLoopCall,
+                (EbKernelFunc)SadLoopKernel,
+                (EbKernelFunc)NxMSadLoopKernel_funcPtrArray[asm_type],
+                sizeof(SadLoopResult_t), MAX(context_ptr->iterations >> 3, 2));
+        }
+    }
+
+    // No C version, checked against the tier below. The 32x32 search point
+    // selection of the AVX2 kernel differs from the SSE4.1 one on GCC builds,
+    // as its source notes, and is the reference of the AVX-512 one
+    context_ptr->width = context_ptr->height = 16;
+    KernelCheckRun(context_ptr, "GetEightHorizontalSearchPointResults_8x8_16x16", KernelCheckEightPoint16x16Call,
+        (EbKernelFunc)GetEightHorizontalSearchPointResults_8x8_16x16_funcPtrArray[asm_type > ASM_NON_AVX2 ? asm_type - 1 : asm_type],
+        (EbKernelFunc)GetEightHorizontalSearchPointResults_8x8_16x16_funcPtrArray[asm_type],
+        sizeof(EightPoint16x16Result_t), context_ptr->iterations);
+    context_ptr->width = context_ptr->height = 64;
+    if (asm_type >= ASM_AVX512)
+        KernelCheckRun(context_ptr, "GetEightHorizontalSearchPointResults_32x32_64x64", KernelCheckEightPoint64x64Call,
+            (EbKernelFunc)GetEightHorizontalSearchPointResults_32x32_64x64_funcPtrArray[asm_type - 1],
+            (EbKernelFunc)GetEightHorizontalSearchPointResults_32x32_64x64_funcPtrArray[asm_type],
+            sizeof(EightPoint64x64Result_t), context_ptr->iterations);
+}
+
+/**************************************
+ * Convolution
+ **************************************/
+typedef void(*ConvolveFunc)(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
+typedef void(*HighbdConvolveFunc)(const uint16_t *src, int32_t src_stride, uint16_t *dst, int32_t dst_stride, int32_t w, int32_t h, const InterpFilterParams *filter_params_x, const InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params, int32_t bd);
+
+#define CONVOLVE_SUBPEL_X       1
+#define CONVOLVE_SUBPEL_Y       2
+#define CONVOLVE_COMPOUND       4
+#define CONVOLVE_HIGHBD         8
+
+typedef struct ConvolveKernel_s
+{
+    const char     *name;
+    EbKernelFunc    c_func;
+    EbKernelFunc    avx2_func;
+    EbKernelFunc    avx512_func;
+    uint32_t        flags;
+} ConvolveKernel_t;
+
+static const ConvolveKernel_t convolveKernels[] = {
+    { "av1_convolve_2d_copy_sr", (EbKernelFunc)av1_convolve_2d_copy_sr_c, (EbKernelFunc)av1_convolve_2d_copy_sr_avx2, NULL, 0 },
+    { "av1_convolve_x_sr", (EbKernelFunc)av1_convolve_x_sr_c, (EbKernelFunc)av1_convolve_x_sr_avx2, NULL, CONVOLVE_SUBPEL_X },
+    { "av1_convolve_y_sr", (EbKernelFunc)av1_convolve_y_sr_c, (EbKernelFunc)av1_convolve_y_sr_avx2, NULL, CONVOLVE_SUBPEL_Y },
+    { "av1_convolve_2d_sr", (EbKernelFunc)av1_convolve_2d_sr_c, (EbKernelFunc)av1_convolve_2d_sr_avx2, (EbKernelFunc)av1_convolve_2d_sr_avx512, CONVOLVE_SUBPEL_X | CONVOLVE_SUBPEL_Y },
+    { "av1_jnt_convolve_2d_copy", (EbKernelFunc)av1_jnt_convolve_2d_copy_c, (EbKernelFunc)av1_jnt_convolve_2d_copy_avx2, NULL, CONVOLVE_COMPOUND },
+    { "av1_jnt_convolve_x", (EbKernelFunc)av1_jnt_convolve_x_c, (EbKernelFunc)av1_jnt_convolve_x_avx2, NULL, CONVOLVE_COMPOUND | CONVOLVE_SUBPEL_X },
+    { "av1_jnt_convolve_y", (EbKernelFunc)av1_jnt_convolve_y_c, (EbKernelFunc)av1_jnt_convolve_y_avx2, NULL, CONVOLVE_COMPOUND | CONVOLVE_SUBPEL_Y },
+    { "av1_jnt_convolve_2d", (EbKernelFunc)av1_jnt_convolve_2d_c, (EbKernelFunc)av1_jnt_convolve_2d_avx2, (EbKernelFunc)av1_jnt_convolve_2d_avx512, CONVOLVE_COMPOUND | CONVOLVE_SUBPEL_X | CONVOLVE_SUBPEL_Y },
+    { "av1_highbd_convolve_2d_copy_sr", (EbKernelFunc)av1_highbd_convolve_2d_copy_sr_c, (EbKernelFunc)av1_highbd_convolve_2d_copy_sr_avx2, NULL, CONVOLVE_HIGHBD },
+    { "av1_highbd_convolve_x_sr", (EbKernelFunc)av1_highbd_convolve_x_sr_c, (EbKernelFunc)av1_highbd_convolve_x_sr_avx2, NULL, CONVOLVE_HIGHBD | CONVOLVE_SUBPEL_X },
+    { "av1_highbd_convolve_y_sr", (EbKernelFunc)av1_highbd_convolve_y_sr_c, (EbKernelFunc)av1_highbd_convolve_y_sr_avx2, NULL, CONVOLVE_HIGHBD | CONVOLVE_SUBPEL_Y },
+    { "av1_highbd_convolve_2d_sr", (EbKernelFunc)av1_highbd_convolve_2d_sr_c, (EbKernelFunc)av1_highbd_convolve_2d_sr_avx2, NULL, CONVOLVE_HIGHBD | CONVOLVE_SUBPEL_X | CONVOLVE_SUBPEL_Y },
+    { "av1_highbd_jnt_convolve_2d_copy", (EbKernelFunc)av1_highbd_jnt_convolve_2d_copy_c, (EbKernelFunc)av1_highbd_jnt_convolve_2d_copy_avx2, NULL, CONVOLVE_HIGHBD | CONVOLVE_COMPOUND },
+    { "av1_highbd_jnt_convolve_x", (EbKernelFunc)av1_highbd_jnt_convolve_x_c, (EbKernelFunc)av1_highbd_jnt_convolve_x_avx2, NULL, CONVOLVE_HIGHBD | CONVOLVE_COMPOUND | CONVOLVE_SUBPEL_X },
+    { "av1_highbd_jnt_convolve_y", (EbKernelFunc)av1_highbd_jnt_convolve_y_c, (EbKernelFunc)av1_highbd_jnt_convolve_y_avx2, NULL, CONVOLVE_HIGHBD | CONVOLVE_COMPOUND | CONVOLVE_SUBPEL_Y },
+    { "av1_highbd_jnt_convolve_2d", (EbKernelFunc)av1_highbd_jnt_convolve_2d_c, (EbKernelFunc)av1_highbd_jnt_convolve_2d_avx2, NULL, CONVOLVE_HIGHBD | CONVOLVE_COMPOUND | CONVOLVE_SUBPEL_X | CONVOLVE_SUBPEL_Y },
+};
+
+static const uint8_t convolveSizes[][2] = {
+    { 2, 4 }, { 4, 4 }, { 4, 8 }, { 8, 4 }, { 8, 8 }, { 8, 16 }, { 16, 8 }, { 16, 16 },
+    { 16, 64 }, { 32, 32 }, { 64, 16 }, { 64, 64 }, { 128, 128 }
+};
+
+// Output layout: the w x h prediction, then the w x h compound buffer.
+// Even iterations write the compound buffer, odd ones average it into the
+// prediction. The encoder does not use the distance weights.
+static void KernelCheckConvolveCall(
+    KernelCheckContext_t    *context_ptr,
+    EbKernelFunc             kernel,
+    uint32_t                 iteration,
+    uint8_t                 *out)
+{
+    const uint32_t flags = (uint32_t)context_ptr->param;
+    const int32_t width = context_ptr->width;
+    const int32_t height = context_ptr->height;
+    const int32_t bd = (flags & CONVOLVE_HIGHBD) ? 10 : 8;
+    uint32_t hash = KernelCheckHash(iteration + 1);
+    uint32_t srcOffset = (KC_BORDER + (hash & KC_OFFSET_MASK)) * KC_STRIDE + KC_BORDER + ((hash >> 6) & KC_OFFSET_MASK);
+    InterpFilter filter = (InterpFilter)((hash >> 12) % 3);
+    InterpFilterParams filterParamsX = av1_get_interp_filter_params_with_block_size(filter, width);
+    InterpFilterParams filterParamsY = av1_get_interp_filter_params_with_block_size(filter, height);
+    int32_t subpelX = (flags & CONVOLVE_SUBPEL_X) ? (hash >> 16) & SUBPEL_MASK : 0;
+    int32_t subpelY = (flags & CONVOLVE_SUBPEL_Y) ? (hash >> 20) & SUBPEL_MASK : 0;
+    uint32_t dstSize = KC_ALIGN(width * height * ((flags & CONVOLVE_HIGHBD) ? 2 : 1));
+    CONV_BUF_TYPE *convDst = (CONV_BUF_TYPE*)(out + dstSize);
+    ConvolveParams convParams;
+
+    if (flags & CONVOLVE_COMPOUND) {
+        int32_t doAverage = iteration & 1;
+        if (doAverage)
+            memcpy(convDst, context_ptr->conv_buf + (hash & 0xFFF), width * height * sizeof(CONV_BUF_TYPE));
+        convParams = get_conv_params_no_round(0, doAverage, 0, convDst, width, 1, bd);
+    }
+    else
+        convParams = get_conv_params_no_round(0, 0, 0, NULL, 0, 0, bd);
+
+    if (flags & CONVOLVE_HIGHBD)
+        ((HighbdConvolveFunc)kernel)(context_ptr->src16 + srcOffset, KC_STRIDE, (uint16_t*)out, width, width, height,
+            &filterParamsX, &filterParamsY, subpelX, subpelY, &convParams, bd);
+    else
+        ((ConvolveFunc)kernel)(context_ptr->src + srcOffset, KC_STRIDE, out, width, width, height,
+            &filterParamsX, &filterParamsY, subpelX, subpelY, &convParams);
+}
+
+static void KernelCheckConvolve(KernelCheckContext_t *context_ptr)
+{
+    uint32_t kernelIndex, sizeIndex;
+
+    for (kernelIndex = 0; kernelIndex < sizeof(convolveKernels) / sizeof(convolveKernels[0]); ++kernelIndex) {
+        const ConvolveKernel_t *kernel = &convolveKernels[kernelIndex];
+        for (sizeIndex = 0; sizeIndex < sizeof(convolveSizes) / sizeof(convolveSizes[0]); ++sizeIndex) {
+            uint32_t dstSize;
+            // Compound prediction needs 8x8 luma blocks
+            if ((kernel->flags & CONVOLVE_COMPOUND) && convolveSizes[sizeIndex][0] < 4)
+                continue;
+            context_ptr->width = convolveSizes[sizeIndex][0];
+            context_ptr->height = convolveSizes[sizeIndex][1];
+            context_ptr->param = (int32_t)kernel->flags;
+            dstSize = KC_ALIGN(context_ptr->width * context_ptr->height * ((kernel->flags & CONVOLVE_HIGHBD) ? 2 : 1));
+            KernelCheckRun(context_ptr, kernel->name, KernelCheckConvolveCall,
+                kernel->c_func,
+                KernelCheckSelect(context_ptr->asm_type, kernel->c_func, kernel->avx2_func, kernel->avx512_func),
+                dstSize + context_ptr->width * context_ptr->height * sizeof(CONV_BUF_TYPE),
+                context_ptr->iterations);
+        }
+    }
+}
+
+/**************************************
+ * Transforms
+ **************************************/
+typedef void(*FwdTxfmFunc)(int16_t *input, int32_t *output, uint32_t inputStride, TxType transform_type, uint8_t bit_depth);
+typedef void(*InvTxfmFunc)(const int32_t *input, uint16_t *output, int32_t stride, TxType tx_type, int32_t bd);
+
+typedef struct TxfmKernel_s
+{
+    uint8_t         width;
+    uint8_t         height;
+    EbKernelFunc    c_func;
+    EbKernelFunc    avx2_func;
+} TxfmKernel_t;
+
+static const TxfmKernel_t fwdTxfmKernels[] = {
+    { 8, 8, (EbKernelFunc)Av1TransformTwoD_8x8_c, (EbKernelFunc)av1_fwd_txfm2d_8x8_avx2 },
+    { 16, 16, (EbKernelFunc)Av1TransformTwoD_16x16_c, (EbKernelFunc)av1_fwd_txfm2d_16x16_avx2 },
+    { 32, 32, (EbKernelFunc)Av1TransformTwoD_32x32_c, (EbKernelFunc)av1_fwd_txfm2d_32x32_avx2 },
+    { 64, 64, (EbKernelFunc)Av1TransformTwoD_64x64_c, (EbKernelFunc)av1_fwd_txfm2d_64x64_avx2 },
+    { 8, 16, (EbKernelFunc)av1_fwd_txfm2d_8x16_c, (EbKernelFunc)av1_fwd_txfm2d_8x16_avx2 },
+    { 16, 8, (EbKernelFunc)av1_fwd_txfm2d_16x8_c, (EbKernelFunc)av1_fwd_txfm2d_16x8_avx2 },
+    { 8, 32, (EbKernelFunc)av1_fwd_txfm2d_8x32_c, (EbKernelFunc)av1_fwd_txfm2d_8x32_avx2 },
+    { 32, 8, (EbKernelFunc)av1_fwd_txfm2d_32x8_c, (EbKernelFunc)av1_fwd_txfm2d_32x8_avx2 },
+    { 16, 32, (EbKernelFunc)av1_fwd_txfm2d_16x32_c, (EbKernelFunc)av1_fwd_txfm2d_16x32_avx2 },
+    { 32, 16, (EbKernelFunc)av1_fwd_txfm2d_32x16_c, (EbKernelFunc)av1_fwd_txfm2d_32x16_avx2 },
+    { 16, 64, (EbKernelFunc)av1_fwd_txfm2d_16x64_c, (EbKernelFunc)av1_fwd_txfm2d_16x64_avx2 },
+    { 64, 16, (EbKernelFunc)av1_fwd_txfm2d_64x16_c, (EbKernelFunc)av1_fwd_txfm2d_64x16_avx2 },
+    { 32, 64, (EbKernelFunc)av1_fwd_txfm2d_32x64_c, (EbKernelFunc)av1_fwd_txfm2d_32x64_avx2 },
+    { 64, 32, (EbKernelFunc)av1_fwd_txfm2d_64x32_c, (EbKernelFunc)av1_fwd_txfm2d_64x32_avx2 },
+};
+
+// 8 bit DCT_DCT kernels against the 32 bit ones they replace
+static const TxfmKernel_t lowbdFwdTxfmKernels[] = {
+    { 4, 4, (EbKernelFunc)av1_fwd_txfm2d_4x4_sse4_1, (EbKernelFunc)av1_lowbd_fwd_txfm2d_4x4_avx2 },
+    { 8, 8, (EbKernelFunc)av1_fwd_txfm2d_8x8_avx2, (EbKernelFunc)av1_lowbd_fwd_txfm2d_8x8_avx2 },
+    { 16, 16, (EbKernelFunc)av1_fwd_txfm2d_16x16_avx2, (EbKernelFunc)av1_lowbd_fwd_txfm2d_16x16_avx2 },
+};
+
+static const TxfmKernel_t invTxfmKernels[] = {
+    { 4, 4, (EbKernelFunc)av1_inv_txfm2d_add_4x4_c, (EbKernelFunc)av1_inv_txfm2d_add_4x4_avx2 },
+    { 8, 8, (EbKernelFunc)av1_inv_txfm2d_add_8x8_c, (EbKernelFunc)av1_inv_txfm2d_add_8x8_avx2 },
+    { 16, 16, (EbKernelFunc)av1_inv_txfm2d_add_16x16_c, (EbKernelFunc)av1_inv_txfm2d_add_16x16_avx2 },
+    { 32, 32, (EbKernelFunc)av1_inv_txfm2d_add_32x32_c, (EbKernelFunc)av1_inv_txfm2d_add_32x32_avx2 },
+};
+
+// Transform types allowed for the size: all of them up to 16x16, DCT and
+// identity up to 32x32, DCT only beyond
+static TxType KernelCheckTxType(uint32_t width, uint32_t height, uint32_t index)
+{
+    uint32_t maxSize = MAX(width, height);
+    if (maxSize == 64)
+        return DCT_DCT;
+    if (maxSize == 32)
+        return (index & 1) ? IDTX : DCT_DCT;
+    return (TxType)(index % TX_TYPES);
+}
+
+// Iteration 0 reads the extreme residual block at the top of the buffer. The
+// SIMD kernels load 32 byte aligned rows.
+static void KernelCheckFwdTxfmCall(
+    KernelCheckContext_t    *context_ptr,
+    EbKernelFunc             kernel,
+    uint32_t                 iteration,
+    uint8_t                 *out)
+{
+    uint32_t hash = KernelCheckHash(iteration + 1);
+    int16_t *residual = context_ptr->residual;
+    if (iteration)
+        residual += (64 + (hash & KC_OFFSET_MASK)) * KC_STRIDE + ((hash >> 6) & 7) * 16;
+    ((FwdTxfmFunc)kernel)(residual, (int32_t*)out, KC_STRIDE,
+        KernelCheckTxType(context_ptr->width, context_ptr->height, iteration), 8);
+}
+
+static void KernelCheckLowbdFwdTxfmCall(
+    KernelCheckContext_t    *context_ptr,
+    EbKernelFunc             kernel,
+    uint32_t                 iteration,
+    uint8_t                 *out)
+{
+    uint32_t hash = KernelCheckHash(iteration + 1);
+    int16_t *residual = context_ptr->residual;
+    if (iteration)
+        residual += (64 + (hash & KC_OFFSET_MASK)) * KC_STRIDE + ((hash >> 6) & 7) * 16;
+    ((FwdTxfmFunc)kernel)(residual, (int32_t*)out, KC_STRIDE, DCT_DCT, 8);
+}
+
+// The prediction is added to a forward transformed random residual
+static void KernelCheckInvTxfmCall(
+    KernelCheckContext_t    *context_ptr,
+    EbKernelFunc             kernel,
+    uint32_t                 iteration,
+    uint8_t                 *out)
+{
+    uint32_t set = iteration % KC_COEFF_SETS;
+    uint32_t size = context_ptr->width * context_ptr->height;
+    uint32_t i;
+    for (i = 0; i < size; ++i)
+        ((uint16_t*)out)[i] = context_ptr->src[iteration + i];
+    ((InvTxfmFunc)kernel)(context_ptr->coeff + set * size, (uint16_t*)out, context_ptr->width,
+        KernelCheckTxType(context_ptr->width, context_ptr->height, set), 8);
+}
+
+typedef void(*ResidualFunc)(uint8_t *input, uint32_t inputStride, uint8_t *pred, uint32_t predStride, int16_t *residual, uint32_t residualStride, uint32_t areaWidth, uint32_t areaHeight);
+typedef void(*TxbInitLevelsFunc)(const tran_low_t *const coeff, const int32_t width, const int32_t height, uint8_t *const levels);
+
+static void KernelCheckResidualCall(
+    KernelCheckContext_t    *context_ptr,
+    EbKernelFunc             kernel,
+    uint32_t                 iteration,
+    uint8_t                 *out)
+{
+    uint8_t *src, *ref;
+    KernelCheckBlocks(context_ptr, iteration, &src, &ref);
+    ((ResidualFunc)kernel)(src, KC_STRIDE, ref, KC_STRIDE, (int16_t*)out, context_ptr->width,
+        context_ptr->width, context_ptr->height);
+}
+
+static void KernelCheckTxbInitLevelsCall(
+    KernelCheckContext_t    *context_ptr,
+    EbKernelFunc             kernel,
+    uint32_t                 iteration,
+    uint8_t                 *out)
+{
+    uint32_t hash = KernelCheckHash(iteration + 1);
+    ((TxbInitLevelsFunc)kernel)(context_ptr->qcoeff + (hash & 0xFFF), context_ptr->width, context_ptr->height,
+        out + TX_PAD_TOP * (context_ptr->width + TX_PAD_HOR));
+}
+
+static void KernelCheckTransforms(KernelCheckContext_t *context_ptr)
+{
+    EbAsm asm_type = context_ptr->asm_type;
+    uint32_t kernelIndex, set, size;
+
+    for (kernelIndex = 0; kernelIndex < sizeof(fwdTxfmKernels) / sizeof(fwdTxfmKernels[0]); ++kernelIndex) {
+        const TxfmKernel_t *kernel = &fwdTxfmKernels[kernelIndex];
+        context_ptr->width = kernel->width;
+        context_ptr->height = kernel->height;
+        KernelCheckRun(context_ptr, "av1_fwd_txfm2d", KernelCheckFwdTxfmCall,
+            kernel->c_func,
+            KernelCheckSelect(asm_type, kernel->c_func, kernel->avx2_func, NULL),
+            kernel->width * kernel->height * sizeof(int32_t),
+            context_ptr->iterations);
+    }
+
+    for (kernelIndex = 0; kernelIndex < sizeof(lowbdFwdTxfmKernels) / sizeof(lowbdFwdTxfmKernels[0]); ++kernelIndex) {
+        const TxfmKernel_t *kernel = &lowbdFwdTxfmKernels[kernelIndex];
+        context_ptr->width = kernel->width;
+        context_ptr->height = kernel->height;
+        KernelCheckRun(context_ptr, "av1_lowbd_fwd_txfm2d (DCT_DCT)", KernelCheckLowbdFwdTxfmCall,
+            kernel->c_func,
+            KernelCheckSelect(asm_type, kernel->c_func, kernel->avx2_func, NULL),
+            kernel->width * kernel->height * sizeof(int32_t),
+            context_ptr->iterations);
+    }
+
+    for (kernelIndex = 0; kernelIndex < sizeof(invTxfmKernels) / sizeof(invTxfmKernels[0]); ++kernelIndex) {
+        const TxfmKernel_t *kernel = &invTxfmKernels[kernelIndex];
+        context_ptr->width = kernel->width;
+        context_ptr->height = kernel->height;
+        size = kernel->width * kernel->height;
+
+        // Coefficients of the size, from the C forward transform
+        for (set = 0; set < KC_COEFF_SETS; ++set) {
+            int16_t *residual = context_ptr->residual + (64 + set) * KC_STRIDE + (set & 7) * 16;
+            TxType txType = KernelCheckTxType(kernel->width, kernel->height, set);
+            switch (kernel->width) {
+            case 4:  Av1TransformTwoD_4x4_c(residual, context_ptr->coeff + set * size, KC_STRIDE, txType, 8); break;
+            case 8:  Av1TransformTwoD_8x8_c(residual, context_ptr->coeff + set * size, KC_STRIDE, txType, 8); break;
+            case 16: Av1TransformTwoD_16x16_c(residual, context_ptr->coeff + set * size, KC_STRIDE, txType, 8); break;
+            default: Av1TransformTwoD_32x32_c(residual, context_ptr->coeff + set * size, KC_STRIDE, txType, 8); break;
+            }
+        }
+
+        KernelCheckRun(context_ptr, "av1_inv_txfm2d_add", KernelCheckInvTxfmCall,
+            kernel->c_func,
+            KernelCheckSelect(asm_type, kernel->c_func, kernel->avx2_func, NULL),
+            size * sizeof(uint16_t),
+            context_ptr->iterations);
+    }
+
+    for (size = 4; size <= 128; size <<= 1) {
+        context_ptr->width = context_ptr->height = size;
+        KernelCheckRun(context_ptr, "ResidualKernel", KernelCheckResidualCall,
+            (EbKernelFunc)ResidualKernel_c,
+            KernelCheckSelect(asm_type, (EbKernelFunc)ResidualKernel_c, (EbKernelFunc)ResidualKernel_avx2, NULL),
+            size * size * sizeof(int16_t),
+            context_ptr->iterations);
+    }
+
+    for (size = 4; size <= 32; size <<= 1) {
+        context_ptr->width = context_ptr->height = size;
+        KernelCheckRun(context_ptr, "av1_txb_init_levels", KernelCheckTxbInitLevelsCall,
+            (EbKernelFunc)av1_txb_init_levels_c,
+            KernelCheckSelect(asm_type, (EbKernelFunc)av1_txb_init_levels_c, (EbKernelFunc)av1_txb_init_levels_avx2, NULL),
+            TX_PAD_2D,
+            context_ptr->iterations);
+    }
+}
+
+/**************************************
+ * Quantizer
+ **************************************/
+typedef void(*QuantizeFunc)(const tran_low_t *coeff_ptr, intptr_t n_coeffs, int32_t skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan);
+
+typedef struct QuantizeKernel_s
+{
+    TxSize          tx_size;
+    EbKernelFunc    ref_func;
+    EbKernelFunc    avx2_func;
+} QuantizeKernel_t;
+
+// 8 bit kernels against the 32 bit ones they replace
+static const QuantizeKernel_t quantizeKernels[] = {
+    { TX_4X4, (EbKernelFunc)aom_highbd_quantize_b_avx2, (EbKernelFunc)aom_quantize_b_avx2 },
+    { TX_8X8, (EbKernelFunc)aom_highbd_quantize_b_avx2, (EbKernelFunc)aom_quantize_b_avx2 },
+    { TX_16X16, (EbKernelFunc)aom_highbd_quantize_b_avx2, (EbKernelFunc)aom_quantize_b_avx2 },
+    { TX_32X32, (EbKernelFunc)aom_highbd_quantize_b_32x32_avx2, (EbKernelFunc)aom_quantize_b_32x32_avx2 },
+    { TX_64X64, (EbKernelFunc)aom_highbd_quantize_b_64x64_avx2, (EbKernelFunc)aom_quantize_b_64x64_avx2 },
+};
+
+// Iteration 0 takes the coefficients out of the 16 bit range at qindex 0,
+// iteration 1 the small ones at qindex 255; param is the TxSize
+static void KernelCheckQuantizeCall(
+    KernelCheckContext_t    *context_ptr,
+    EbKernelFunc             kernel,
+    uint32_t                 iteration,
+    uint8_t                 *out)
+{
+    const uint32_t count = MIN(context_ptr->width * context_ptr->height, 32 * 32);
+    const int16_t *iscan = av1_scan_orders[context_ptr->param][DCT_DCT].iscan;
+    const Quants *quants = context_ptr->quants;
+    uint32_t hash = KernelCheckHash(iteration + 1);
+    uint32_t qindex = iteration == 0 ? 0 : iteration == 1 ? QINDEX_RANGE - 1 : hash % QINDEX_RANGE;
+    int32_t *qcoeff = (int32_t*)out;
+    int32_t *dqcoeff = qcoeff + count;
+
+    ((QuantizeFunc)kernel)(context_ptr->coeff + (iteration % KC_COEFF_SETS) * 32 * 32, count, 0,
+        quants->y_zbin[qindex], quants->y_round[qindex], quants->y_quant[qindex], quants->y_quant_shift[qindex],
+        qcoeff, dqcoeff, context_ptr->dequants->y_dequant_QTX[qindex], (uint16_t*)(dqcoeff + count),
+        NULL, iscan);
+}
+
+static void KernelCheckQuantize(KernelCheckContext_t *context_ptr)
+{
+    uint32_t kernelIndex, i;
+
+    // Set 0 alternates +-(2^15 + 1000), the others decay from 12 bit values
+    for (i = 0; i < KC_COEFF_SETS * 32 * 32; ++i) {
+        uint32_t hash = KernelCheckHash(0x8000000 + i);
+        int32_t level = (i < 32 * 32) ? 32768 + 1000 : (int32_t)((hash >> 20) >> ((i & 1023) >> 7));
+        context_ptr->coeff[i] = (hash & 1) ? -level : level;
+    }
+
+    for (kernelIndex = 0; kernelIndex < sizeof(quantizeKernels) / sizeof(quantizeKernels[0]); ++kernelIndex) {
+        const QuantizeKernel_t *kernel = &quantizeKernels[kernelIndex];
+        context_ptr->width = tx_size_wide[kernel->tx_size];
+        context_ptr->height = tx_size_high[kernel->tx_size];
+        context_ptr->param = kernel->tx_size;
+        KernelCheckRun(context_ptr, "aom_quantize_b", KernelCheckQuantizeCall,
+            kernel->ref_func,
+            KernelCheckSelect(context_ptr->asm_type, kernel->ref_func, kernel->avx2_func, NULL),
+            MIN(context_ptr->width * context_ptr->height, 32 * 32) * 2 * sizeof(int32_t) + sizeof(uint16_t),
+            context_ptr->iterations);
+    }
+}
+
+/**************************************
+ * CDEF
+ **************************************/
+typedef void(*CdefFilterFunc)(uint8_t *dst8, uint16_t *dst16, int32_t dstride, const uint16_t *in, int32_t pri_strength, int32_t sec_strength, int32_t dir, int32_t pri_damping, int32_t sec_damping, int32_t bsize, int32_t max, int32_t coeff_shift);
+typedef int32_t(*CdefFindDirFunc)(const uint16_t *img, int32_t stride, int32_t *var, int32_t coeff_shift);
+
+// Blocks sit on 8 sample columns, as in the filter process
+static const uint16_t *KernelCheckCdefBlock(KernelCheckContext_t *context_ptr, uint32_t hash)
+{
+    return context_ptr->cdef_buf + (CDEF_VBORDER + (hash & 63) % 57) * CDEF_BSTRIDE + CDEF_HBORDER + ((hash >> 6) & 7) * 8;
+}
+
+// param is the block size, the output is 16 bit when the width is given negative
+static void KernelCheckCdefFilterCall(
+    KernelCheckContext_t    *context_ptr,
+    EbKernelFunc             kernel,
+    uint32_t                 iteration,
+    uint8_t                 *out)
+{
+    static const int32_t secStrengths[4] = { 0, 1, 2, 4 };
+    uint32_t hash = KernelCheckHash(iteration + 1);
+    int32_t priStrength = (hash >> 12) & 15;
+    int32_t dstride = (int32_t)context_ptr->width;
+    ((CdefFilterFunc)kernel)(
+        context_ptr->param >= 0 ? out : NULL,
+        context_ptr->param >= 0 ? NULL : (uint16_t*)out,
+        dstride,
+        KernelCheckCdefBlock(context_ptr, hash),
+        priStrength,
+        secStrengths[(hash >> 16) & 3],
+        priStrength ? (hash >> 18) & 7 : 0,
+        3 + ((hash >> 21) & 3),
+        3 + ((hash >> 23) & 3),
+        context_ptr->param >= 0 ? context_ptr->param : ~context_ptr->param,
+        255,
+        0);
+}
+
+static void KernelCheckCdefFindDirCall(
+    KernelCheckContext_t    *context_ptr,
+    EbKernelFunc             kernel,
+    uint32_t                 iteration,
+    uint8_t                 *out)
+{
+    int32_t *result = (int32_t*)out;
+    result[0] = ((CdefFindDirFunc)kernel)(KernelCheckCdefBlock(context_ptr, KernelCheckHash(iteration + 1)),
+        CDEF_BSTRIDE, &result[1], 0);
+}
+
+static void KernelCheckCdef(KernelCheckContext_t *context_ptr)
+{
+    static const uint8_t cdefSizes[][3] = {
+        { 8, 8, BLOCK_8X8 }, { 4, 8, BLOCK_4X8 }, { 8, 4, BLOCK_8X4 }, { 4, 4, BLOCK_4X4 }
+    };
+    EbKernelFunc filter = KernelCheckSelect(context_ptr->asm_type, (EbKernelFunc)cdef_filter_block_c, (EbKernelFunc)cdef_filter_block_avx2, NULL);
+    uint32_t sizeIndex;
+
+    for (sizeIndex = 0; sizeIndex < sizeof(cdefSizes) / sizeof(cdefSizes[0]); ++sizeIndex) {
+        context_ptr->width = cdefSizes[sizeIndex][0];
+        context_ptr->height = cdefSizes[sizeIndex][1];
+        context_ptr->param = cdefSizes[sizeIndex][2];
+        KernelCheckRun(context_ptr, "cdef_filter_block", KernelCheckCdefFilterCall,
+            (EbKernelFunc)cdef_filter_block_c, filter,
+            context_ptr->width * context_ptr->height, context_ptr->iterations);
+        context_ptr->param = ~context_ptr->param;
+        KernelCheckRun(context_ptr, "cdef_filter_block (16 bit output)", KernelCheckCdefFilterCall,
+            (EbKernelFunc)cdef_filter_block_c, filter,
+            context_ptr->width * context_ptr->height * sizeof(uint16_t), context_ptr->iterations);
+    }
+
+    context_ptr->width = context_ptr->height = 8;
+    KernelCheckRun(context_ptr, "cdef_find_dir", KernelCheckCdefFindDirCall,
+        (EbKernelFunc)cdef_find_dir_c,
+        KernelCheckSelect(context_ptr->asm_type, (EbKernelFunc)cdef_find_dir_c, (EbKernelFunc)cdef_find_dir_avx2, NULL),
+        2 * sizeof(int32_t), context_ptr->iterations);
+}
+
+/**************************************
+ * Loop filter
+ **************************************/
+typedef void(*LpfFunc)(uint8_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh);
+typedef void(*HighbdLpfFunc)(uint16_t *s, int32_t pitch, const uint8_t *blimit, const uint8_t *limit, const uint8_t *thresh, int32_t bd);
+
+typedef struct LpfKernel_s
+{
+    const char     *name;
+    const char     *quad_sse2_name;
+    const char     *quad_avx2_name;
+    uint8_t         length;
+    uint8_t         vertical;
+    uint8_t         highbd;
+    EbKernelFunc    c_func;
+    EbKernelFunc    sse2_func;
+    EbKernelFunc    quad_c_func;
+    EbKernelFunc    quad_sse2_func;
+    EbKernelFunc    quad_avx2_func;
+} LpfKernel_t;
+
+#define LPF_KERNEL(name, length, vertical, highbd) \
+    { #name "_sse2", #name "_quad_sse2", #name "_quad_avx2", length, vertical, highbd, \
+      (EbKernelFunc)name##_c, (EbKernelFunc)name##_sse2, \
+      (EbKernelFunc)name##_quad_c, (EbKernelFunc)name##_quad_sse2, (EbKernelFunc)name##_quad_avx2 }
+
+static const LpfKernel_t lpfKernels[] = {
+    LPF_KERNEL(aom_lpf_horizontal_4, 4, 0, 0),
+    LPF_KERNEL(aom_lpf_horizontal_6, 6, 0, 0),
+    LPF_KERNEL(aom_lpf_horizontal_8, 8, 0, 0),
+    LPF_KERNEL(aom_lpf_horizontal_14, 14, 0, 0),
+    LPF_KERNEL(aom_lpf_vertical_4, 4, 1, 0),
+    LPF_KERNEL(aom_lpf_vertical_6, 6, 1, 0),
+    LPF_KERNEL(aom_lpf_vertical_8, 8, 1, 0),
+    LPF_KERNEL(aom_lpf_vertical_14, 14, 1, 0),
+    LPF_KERNEL(aom_highbd_lpf_horizontal_4, 4, 0, 1),
+    LPF_KERNEL(aom_highbd_lpf_horizontal_6, 6, 0, 1),
+    LPF_KERNEL(aom_highbd_lpf_horizontal_8, 8, 0, 1),
+    LPF_KERNEL(aom_highbd_lpf_horizontal_14, 14, 0, 1),
+    LPF_KERNEL(aom_highbd_lpf_vertical_4, 4, 1, 1),
+    LPF_KERNEL(aom_highbd_lpf_vertical_6, 6, 1, 1),
+    LPF_KERNEL(aom_highbd_lpf_vertical_8, 8, 1, 1),
+    LPF_KERNEL(aom_highbd_lpf_vertical_14, 14, 1, 1),
+};
+
+// The block is copied to the output and filtered in place at its middle edge,
+// the single kernels covering the first 4 samples along it. Iteration 0 takes
+// the strongest level; param is the table entry.
+static void KernelCheckLpfCall(
+    KernelCheckContext_t    *context_ptr,
+    EbKernelFunc             kernel,
+    uint32_t                 iteration,
+    uint8_t                 *out)
+{
+    const LpfKernel_t *entry = &lpfKernels[context_ptr->param];
+    uint32_t hash = KernelCheckHash(iteration + 1);
+    uint32_t block = ((hash % KC_LPF_SETS) * 2 + entry->vertical) * 16 * 16;
+    uint32_t edge = entry->vertical ? 8 : 8 * 16;
+    const loop_filter_thresh *thr = context_ptr->lpf_thr +
+        (iteration == 0 ? MAX_LOOP_FILTER : (hash >> 8) % (MAX_LOOP_FILTER + 1));
+
+    if (entry->highbd) {
+        memcpy(out, context_ptr->lpf_buf16 + block, 16 * 16 * sizeof(uint16_t));
+        ((HighbdLpfFunc)kernel)((uint16_t*)out + edge, 16, thr->mblim, thr->lim, thr->hev_thr, 10);
+    }
+    else {
+        memcpy(out, context_ptr->lpf_buf + block, 16 * 16);
+        ((LpfFunc)kernel)(out + edge, 16, thr->mblim, thr->lim, thr->hev_thr);
+    }
+}
+
+static void KernelCheckLoopFilter(KernelCheckContext_t *context_ptr)
+{
+    uint32_t kernelIndex;
+
+    for (kernelIndex = 0; kernelIndex < sizeof(lpfKernels) / sizeof(lpfKernels[0]); ++kernelIndex) {
+        const LpfKernel_t *kernel = &lpfKernels[kernelIndex];
+        uint32_t outSize = 16 * 16 * (kernel->highbd ? sizeof(uint16_t) : 1);
+        context_ptr->param = kernelIndex;
+
+        context_ptr->width = kernel->vertical ? kernel->length : 4;
+        context_ptr->height = kernel->vertical ? 4 : kernel->length;
+        KernelCheckRun(context_ptr, kernel->name, KernelCheckLpfCall,
+            kernel->c_func, kernel->sse2_func, outSize, context_ptr->iterations);
+
+        context_ptr->width = kernel->vertical ? kernel->length : 16;
+        context_ptr->height = kernel->vertical ? 16 : kernel->length;
+        KernelCheckRun(context_ptr, kernel->quad_sse2_name, KernelCheckLpfCall,
+            kernel->quad_c_func, kernel->quad_sse2_func, outSize, context_ptr->iterations);
+        KernelCheckRun(context_ptr, kernel->quad_avx2_name, KernelCheckLpfCall,
+            kernel->quad_c_func,
+            KernelCheckSelect(context_ptr->asm_type, kernel->quad_c_func, kernel->quad_avx2_func, NULL),
+            outSize, context_ptr->iterations);
+    }
+}
+
+/**************************************
+ * Context
+ **************************************/
+static void KernelCheckContextDtor(KernelCheckContext_t *context_ptr)
+{
+    KernelCheckFree(context_ptr->src);
+    KernelCheckFree(context_ptr->near_ref);
+    KernelCheckFree(context_ptr->far_ref);
+    KernelCheckFree(context_ptr->flat_low);
+    KernelCheckFree(context_ptr->flat_high);
+    KernelCheckFree(context_ptr->src16);
+    KernelCheckFree(context_ptr->residual);
+    KernelCheckFree(context_ptr->conv_buf);
+    KernelCheckFree(context_ptr->sad16x16);
+    KernelCheckFree(context_ptr->cdef_buf);
+    KernelCheckFree(context_ptr->qcoeff);
+    KernelCheckFree(context_ptr->coeff);
+    KernelCheckFree(context_ptr->quants);
+    KernelCheckFree(context_ptr->dequants);
+    KernelCheckFree(context_ptr->lpf_buf);
+    KernelCheckFree(context_ptr->lpf_buf16);
+    KernelCheckFree(context_ptr->lpf_thr);
+    KernelCheckFree(context_ptr->out_ref);
+    KernelCheckFree(context_ptr->out_opt);
+}
+
+static EbErrorType KernelCheckContextCtor(KernelCheckContext_t *context_ptr)
+{
+    const uint32_t samples = KC_STRIDE * KC_ROWS;
+    uint32_t i;
+
+    context_ptr->src = (uint8_t*)KernelCheckMalloc(samples);
+    context_ptr->near_ref = (uint8_t*)KernelCheckMalloc(samples);
+    context_ptr->far_ref = (uint8_t*)KernelCheckMalloc(samples);
+    context_ptr->flat_low = (uint8_t*)KernelCheckMalloc(samples);
+    context_ptr->flat_high = (uint8_t*)KernelCheckMalloc(samples);
+    context_ptr->src16 = (uint16_t*)KernelCheckMalloc(samples * sizeof(uint16_t));
+    context_ptr->residual = (int16_t*)KernelCheckMalloc(samples * sizeof(int16_t));
+    context_ptr->conv_buf = (uint16_t*)KernelCheckMalloc((0x1000 + 128 * 128) * sizeof(uint16_t));
+    context_ptr->sad16x16 = (uint16_t*)KernelCheckMalloc(KC_SAD16_COUNT * sizeof(uint16_t));
+    context_ptr->cdef_buf = (uint16_t*)KernelCheckMalloc(CDEF_INBUF_SIZE * sizeof(uint16_t));
+    context_ptr->qcoeff = (int32_t*)KernelCheckMalloc((0x1000 + 32 * 32) * sizeof(int32_t));
+    context_ptr->coeff = (int32_t*)KernelCheckMalloc(KC_COEFF_SETS * 32 * 32 * sizeof(int32_t));
+    context_ptr->quants = (Quants*)KernelCheckMalloc(sizeof(Quants));
+    context_ptr->dequants = (Dequants*)KernelCheckMalloc(sizeof(Dequants));
+    context_ptr->lpf_buf = (uint8_t*)KernelCheckMalloc(KC_LPF_SETS * 2 * 16 * 16);
+    context_ptr->lpf_buf16 = (uint16_t*)KernelCheckMalloc(KC_LPF_SETS * 2 * 16 * 16 * sizeof(uint16_t));
+    context_ptr->lpf_thr = (loop_filter_thresh*)KernelCheckMalloc((MAX_LOOP_FILTER + 1) * sizeof(loop_filter_thresh));
+    context_ptr->out_ref = (uint8_t*)KernelCheckMalloc(KC_OUT_SIZE);
+    context_ptr->out_opt = (uint8_t*)KernelCheckMalloc(KC_OUT_SIZE);
+    if (!context_ptr->src || !context_ptr->near_ref || !context_ptr->far_ref || !context_ptr->flat_low ||
+        !context_ptr->flat_high || !context_ptr->src16 || !context_ptr->residual || !context_ptr->conv_buf ||
+        !context_ptr->sad16x16 || !context_ptr->cdef_buf || !context_ptr->qcoeff || !context_ptr->coeff ||
+        !context_ptr->quants || !context_ptr->dequants || !context_ptr->lpf_buf || !context_ptr->lpf_buf16 ||
+        !context_ptr->lpf_thr || !context_ptr->out_ref || !context_ptr->out_opt)
+        return EB_ErrorInsufficientResources;
+
+    KernelCheckFill(context_ptr->src, samples, 0x1000000);
+    KernelCheckFill(context_ptr->far_ref, samples, 0x2000000);
+    memset(context_ptr->flat_low, 0, samples);
+    memset(context_ptr->flat_high, 255, samples);
+    for (i = 0; i < samples; ++i) {
+        uint32_t hash = KernelCheckHash(0x3000000 + i);
+        context_ptr->near_ref[i] = (uint8_t)CLIP3(0, 255, (int32_t)context_ptr->src[i] + (int32_t)(hash & 7) - 3);
+        context_ptr->src16[i] = (uint16_t)((hash >> 8) & 1023);
+        // Alternating +-255 in the top rows, the largest transform inputs
+        context_ptr->residual[i] = (i < 64 * KC_STRIDE) ?
+            (int16_t)((((i / KC_STRIDE) ^ i) & 1) ? 255 : -255) :
+            (int16_t)(context_ptr->src[i] - context_ptr->far_ref[i]);
+    }
+    for (i = 0; i < 0x1000 + 128 * 128; ++i)
+        context_ptr->conv_buf[i] = (uint16_t)(KernelCheckHash(0x4000000 + i) & 0x3FFF);
+    for (i = 0; i < KC_SAD16_COUNT; ++i)
+        context_ptr->sad16x16[i] = (uint16_t)(i < 128 ? 0x7FFF : i < 256 ? 1000 : KernelCheckHash(0x5000000 + i) & 0x7FFF);
+    for (i = 0; i < CDEF_INBUF_SIZE; ++i)
+        context_ptr->cdef_buf[i] = (uint16_t)((i % CDEF_BSTRIDE) < CDEF_HBORDER ? CDEF_VERY_LARGE : KernelCheckHash(0x6000000 + i) & 255);
+    for (i = 0; i < 0x1000 + 32 * 32; ++i) {
+        uint32_t hash = KernelCheckHash(0x7000000 + i);
+        context_ptr->qcoeff[i] = (hash & 3) ? 0 : (int32_t)((hash >> 8) % 81) - 40;
+    }
+    // Loop filter blocks: a step at the edge over a slope, with a noise of
+    // a random amplitude for each 4 samples along the edge, mostly below the
+    // flatness threshold
+    for (i = 0; i < KC_LPF_SETS; ++i) {
+        static const int32_t noiseAmplitudes[8] = { 0, 0, 0, 1, 2, 4, 16, 300 };
+        uint32_t hash = KernelCheckHash(0x9000000 + i);
+        int32_t base = 64 + (int32_t)(hash & 511);
+        int32_t step = (int32_t)((hash >> 9) % 401) - 200;
+        int32_t slope = ((hash >> 18) & 3) ? 0 : (int32_t)((hash >> 20) & 7) - 3;
+        uint32_t across, along;
+        for (along = 0; along < 16; ++along) {
+            int32_t amplitude = noiseAmplitudes[KernelCheckHash(0xA000000 + i * 4 + along / 4) & 7];
+            for (across = 0; across < 16; ++across) {
+                uint32_t noise = KernelCheckHash(0xB000000 + (i * 16 + along) * 16 + across);
+                int32_t value = base + step * (across >= 8) + slope * ((int32_t)across - 8) +
+                    (amplitude ? (int32_t)(noise % (2 * amplitude + 1)) - amplitude : 0);
+                value = CLIP3(0, 1023, value);
+                // horizontal edge, rows across it, then vertical edge
+                context_ptr->lpf_buf16[(i * 2 + 0) * 256 + across * 16 + along] = (uint16_t)value;
+                context_ptr->lpf_buf16[(i * 2 + 1) * 256 + along * 16 + across] = (uint16_t)value;
+                context_ptr->lpf_buf[(i * 2 + 0) * 256 + across * 16 + along] = (uint8_t)(value >> 2);
+                context_ptr->lpf_buf[(i * 2 + 1) * 256 + along * 16 + across] = (uint8_t)(value >> 2);
+            }
+        }
+    }
+    for (i = 0; i <= MAX_LOOP_FILTER; ++i) {
+        const int32_t limit = MAX((int32_t)i, 1);
+        memset(context_ptr->lpf_thr[i].lim, limit, SIMD_WIDTH);
+        memset(context_ptr->lpf_thr[i].mblim, 2 * (i + 2) + limit, SIMD_WIDTH);
+        memset(context_ptr->lpf_thr[i].hev_thr, i >> 4, SIMD_WIDTH);
+    }
+    av1_build_quantizer(AOM_BITS_8, 0, 0, 0, 0, 0, context_ptr->quants, context_ptr->dequants);
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * Kernel Check
+ **************************************/
+EbErrorType KernelCheck(
+    EbAsm                    asm_type,
+    uint32_t                 iterations,
+    KernelReportCallback     callback,
+    void                    *report_ctx)
+{
+    KernelCheckContext_t context;
+    EbErrorType return_error;
+
+    memset(&context, 0, sizeof(context));
+    context.asm_type = asm_type;
+    context.iterations = MAX(iterations ? iterations : KERNEL_CHECK_DEFAULT_ITERATIONS, 2);
+    context.callback = callback;
+    context.report_ctx = report_ctx;
+
+    return_error = KernelCheckContextCtor(&context);
+    if (return_error == EB_ErrorNone) {
+        KernelCheckSad(&context);
+        KernelCheckConvolve(&context);
+        KernelCheckTransforms(&context);
+        KernelCheckQuantize(&context);
+        KernelCheckCdef(&context);
+        KernelCheckLoopFilter(&context);
+        if (context.mismatch_total)
+            return_error = EB_ErrorUndefined;
+    }
+    KernelCheckContextDtor(&context);
+
+    return return_error;
+}
+
+/**************************************
+ * Options
+ **************************************/
+EbErrorType KernelCheckOptions(
+    int32_t                  argc,
+    char                    *argv[],
+    EbAsm                   *asm_type,
+    uint32_t                *iterations)
+{
+    int32_t argIndex;
+
+    for (argIndex = 1; argIndex < argc; argIndex += 2) {
+        char *end;
+        unsigned long value;
+
+        if (argIndex + 1 == argc) {
+            printf("Error: missing value of %s\n", argv[argIndex]);
+            return EB_ErrorBadParameter;
+        }
+        value = strtoul(argv[argIndex + 1], &end, 0);
+        if (*end != '\0') {
+            printf("Error: invalid value %s of %s\n", argv[argIndex + 1], argv[argIndex]);
+            return EB_ErrorBadParameter;
+        }
+
+        if (!strcmp(argv[argIndex], "-asm")) {
+            if (value > (unsigned long)GetCpuAsmType()) {
+                printf("Error: asm level %lu is not supported by this CPU, the highest one is %u\n", value, (uint32_t)GetCpuAsmType());
+                return EB_ErrorBadParameter;
+            }
+            *asm_type = (EbAsm)value;
+        }
+        else if (!strcmp(argv[argIndex], "-n"))
+            *iterations = (uint32_t)value;
+        else {
+            printf("Error: unknown option %s\n", argv[argIndex]);
+            printf("Usage: %s [-asm <0: C and SSE4.1, 1: AVX2, 2: AVX-512>] [-n <inputs per kernel, 0: %u>]\n",
+                argv[0], KERNEL_CHECK_DEFAULT_ITERATIONS);
+            return EB_ErrorBadParameter;
+        }
+    }
+
+    return EB_ErrorNone;
+}
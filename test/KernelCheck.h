@@ -0,0 +1,62 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef KernelCheck_h
+#define KernelCheck_h
+
+#include "EbDefinitions.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define KERNEL_CHECK_DEFAULT_ITERATIONS     256
+
+    // Result of one kernel and block size
+    typedef struct KernelReport_s
+    {
+        const char *kernel_name;
+        uint32_t    width;              // block width, 0 for the kernels without a block size
+        uint32_t    height;
+        uint32_t    call_count;         // calls of each implementation
+        uint32_t    mismatch_count;     // calls whose output differs from the reference
+        double      ref_cycles;         // cycles per call of the reference implementation
+        double      opt_cycles;         // cycles per call of the implementation selected for the asm type
+    } KernelReport_t;
+
+    typedef void(*KernelReportCallback)(
+        void                    *report_ctx,
+        const KernelReport_t    *report);
+
+    // Highest kernel tier of the CPU, from the encoder library
+    extern EbAsm GetCpuAsmType();
+
+    /**************************************
+     * Kernel Check
+     *   Runs each kernel of the asm_type tier and its reference on the same
+     *   inputs, compares the outputs bit for bit and reports the cycles per
+     *   call of both. The reference is the C code, or the kernel of the tier
+     *   below for the eight-point search kernels, which have no C version.
+     *   Kernels whose tier entry is the reference itself are not reported.
+     *   Returns EB_ErrorUndefined when an output differs from its reference.
+     **************************************/
+    extern EbErrorType KernelCheck(
+        EbAsm                    asm_type,
+        uint32_t                 iterations,
+        KernelReportCallback     callback,
+        void                    *report_ctx);
+
+    // Reads the -asm <level> and -n <iterations> options shared by the test
+    // programs, level is left untouched without -asm
+    extern EbErrorType KernelCheckOptions(
+        int32_t                  argc,
+        char                    *argv[],
+        EbAsm                   *asm_type,
+        uint32_t                *iterations);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // KernelCheck_h
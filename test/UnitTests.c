@@ -0,0 +1,72 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// SvtAv1UnitTests
+//  -Checks the SIMD kernels of each asm level supported by the CPU, or of
+//   the level given with -asm, against their reference bit for bit
+//  -Returns 1 when an output differs
+
+#include <stdio.h>
+
+#include "KernelCheck.h"
+
+static const char *asmLevelNames[ASM_TYPE_TOTAL] = { "C and SSE4.1", "AVX2", "AVX-512" };
+
+typedef struct UnitTestsContext_s
+{
+    uint32_t    case_count;
+    uint32_t    mismatch_case_count;
+} UnitTestsContext_t;
+
+static void ReportMismatches(
+    void                    *report_ctx,
+    const KernelReport_t    *report)
+{
+    UnitTestsContext_t *context_ptr = (UnitTestsContext_t*)report_ctx;
+
+    context_ptr->case_count++;
+    if (report->mismatch_count) {
+        context_ptr->mismatch_case_count++;
+        printf("  FAILED %s %ux%u: %u of %u outputs differ\n",
+            report->kernel_name,
+            report->width,
+            report->height,
+            report->mismatch_count,
+            report->call_count);
+    }
+}
+
+int32_t main(int32_t argc, char *argv[])
+{
+    EbAsm       cpuAsmType = GetCpuAsmType();
+    EbAsm       asmType = ASM_TYPE_TOTAL;
+    EbAsm       level;
+    uint32_t    iterations = 0;
+    int32_t     failed = 0;
+
+    if (KernelCheckOptions(argc, argv, &asmType, &iterations) != EB_ErrorNone)
+        return 1;
+
+    for (level = ASM_NON_AVX2; level <= cpuAsmType; ++level) {
+        UnitTestsContext_t context = { 0, 0 };
+        EbErrorType return_error;
+
+        if (asmType != ASM_TYPE_TOTAL && level != asmType)
+            continue;
+
+        printf("asm level %u (%s)\n", (uint32_t)level, asmLevelNames[level]);
+        return_error = KernelCheck(level, iterations, ReportMismatches, &context);
+        if (return_error != EB_ErrorNone && return_error != EB_ErrorUndefined) {
+            printf("  Error: kernel check failed with 0x%x\n", return_error);
+            failed = 1;
+            continue;
+        }
+        printf("  %u kernels and sizes checked, %u failed\n", context.case_count, context.mismatch_case_count);
+        if (context.mismatch_case_count)
+            failed = 1;
+    }
+
+    return failed;
+}